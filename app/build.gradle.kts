@@ -49,6 +49,10 @@ android {
         externalNativeBuild {
             cmake {
                 arguments("-DANDROID_STL=c++_static")
+                // -PwalletStub links the simulated libwallet for the instrumented tests
+                if (project.hasProperty("walletStub")) {
+                    arguments("-DNATIVE_WALLET_STUB=ON")
+                }
             }
         }
 
@@ -33,7 +33,10 @@
 package com.tari.android.wallet
 
 import com.tari.android.wallet.ffi.FFIByteVector
+import com.tari.android.wallet.ffi.FFIHex
 import org.junit.Assert.assertArrayEquals
+import org.junit.Assert.assertEquals
+import org.junit.Assert.assertNull
 import org.junit.Test
 
 /**
@@ -50,4 +53,49 @@ class FFIByteVectorTests {
         assertArrayEquals(byteArray, byteVector.byteArray())
         byteVector.destroy()
     }
+
+    @Test
+    fun byteArray_assertThatTheArrayHoldsTheBytesReadOneByOne() {
+        val byteArray = ByteArray(100) { (it * 37).toByte() }
+        val byteVector = FFIByteVector(byteArray)
+        val read = byteVector.byteArray()
+        assertEquals(byteVector.getLength(), read.size)
+        read.forEachIndexed { index, byte -> assertEquals(byteVector.getAt(index), byte.toInt() and 0xFF) }
+        byteVector.destroy()
+    }
+
+    @Test
+    fun hex_assertThatTheBytesAreEncodedInUpperCase() {
+        // longer than a vector register, so the wide kernels and the tail are both used
+        val byteArray = ByteArray(77) { (it * 29 + 3).toByte() }
+        val byteVector = FFIByteVector(byteArray)
+        assertEquals(byteArray.toUpperHex(), byteVector.hex())
+        assertEquals(byteVector.hex(), byteVector.toString())
+        byteVector.destroy()
+    }
+
+    @Test
+    fun encode_assertThatEveryByteValueIsEncoded() {
+        val byteArray = ByteArray(256) { it.toByte() }
+        assertEquals(byteArray.toUpperHex(), FFIHex.encode(byteArray))
+        assertEquals(byteArray.toUpperHex().lowercase(), FFIHex.encode(byteArray, lowercase = true))
+        assertEquals("", FFIHex.encode(ByteArray(0)))
+    }
+
+    @Test
+    fun decode_assertThatBothCasesDecodeToTheEncodedBytes() {
+        val byteArray = ByteArray(256) { it.toByte() }
+        assertArrayEquals(byteArray, FFIHex.decode(FFIHex.encode(byteArray)))
+        assertArrayEquals(byteArray, FFIHex.decode(FFIHex.encode(byteArray, lowercase = true)))
+    }
+
+    @Test
+    fun decode_assertThatInvalidHexIsRejected() {
+        assertNull(FFIHex.decode("ABC"))
+        assertNull(FFIHex.decode("0G"))
+        // the invalid character past the first vector register
+        assertNull(FFIHex.decode("00".repeat(40) + "zz"))
+    }
+
+    private fun ByteArray.toUpperHex(): String = joinToString("") { "%02X".format(it) }
 }
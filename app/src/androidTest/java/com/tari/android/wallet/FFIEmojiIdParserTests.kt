@@ -0,0 +1,89 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet
+
+import com.tari.android.wallet.ffi.Base58String
+import com.tari.android.wallet.ffi.FFIEmojiIdParser
+import com.tari.android.wallet.ffi.FFIEmojiSet
+import com.tari.android.wallet.ffi.FFITariWalletAddress
+import com.tari.android.wallet.ffi.runWithDestroy
+import org.junit.Assert.assertArrayEquals
+import org.junit.Assert.assertEquals
+import org.junit.Assert.assertNull
+import org.junit.Test
+
+/**
+ * Native emoji id parser tests.
+ *
+ * @author The Tari Development Team
+ */
+class FFIEmojiIdParserTests {
+
+    @Test
+    fun getAll_assertThatEmojiSetMatchesSingleGetters() {
+        val emojiSet = FFIEmojiSet()
+        val emojis = (0 until emojiSet.getLength()).map { index -> emojiSet.getAt(index).runWithDestroy { String(it.byteArray()) } }
+        assertEquals(emojis, emojiSet.getAll())
+        emojiSet.destroy()
+    }
+
+    @Test
+    fun decode_assertThatEveryEmojiOfTheSetDecodesToItsIndex() {
+        val emojiSet = FFIEmojiSet()
+        val emojis = emojiSet.getAll()
+        emojiSet.destroy()
+        assertEquals(256, emojis.size)
+        emojis.forEachIndexed { index, emoji ->
+            assertArrayEquals("emoji $index", byteArrayOf(index.toByte()), FFIEmojiIdParser.decode(emoji))
+        }
+    }
+
+    @Test
+    fun decode_assertThatBytesMatchLibWallet() {
+        val ffiTariWalletAddress = FFITariWalletAddress(Base58String(FFITestUtil.WALLET_ADDRESS_HEX_STRING))
+        val emojiId = ffiTariWalletAddress.getEmojiId()
+        assertArrayEquals(ffiTariWalletAddress.getByteVector().byteArray(), FFIEmojiIdParser.decode(emojiId))
+        assertEquals(FFIEmojiIdParser.Status.Valid, FFIEmojiIdParser.validate(emojiId))
+        ffiTariWalletAddress.destroy()
+    }
+
+    @Test
+    fun validate_assertThatMalformedEmojiIdsAreRejected() {
+        val emojiSet = FFIEmojiSet()
+        val emoji = emojiSet.getAll().first()
+        emojiSet.destroy()
+        assertEquals(FFIEmojiIdParser.Status.InvalidEmoji, FFIEmojiIdParser.validate("${emoji}a"))
+        assertNull(FFIEmojiIdParser.decode("${emoji}a"))
+        assertEquals(FFIEmojiIdParser.Status.InvalidLength, FFIEmojiIdParser.validate(emoji.repeat(10)))
+    }
+}
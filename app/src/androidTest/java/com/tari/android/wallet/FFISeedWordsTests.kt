@@ -0,0 +1,123 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet
+
+import com.tari.android.wallet.ffi.FFISeedWordTrie
+import com.tari.android.wallet.ffi.FFISeedWords
+import com.tari.android.wallet.model.seedPhrase.SeedWordsWordPushResult
+import org.junit.Assert.assertEquals
+import org.junit.Assert.assertFalse
+import org.junit.Assert.assertTrue
+import org.junit.Test
+
+/**
+ * FFI seed words and seed word trie tests.
+ *
+ * @author The Tari Development Team
+ */
+class FFISeedWordsTests {
+
+    private fun englishWords(): List<String> {
+        val wordList = FFISeedWords.getMnemonicWordList(FFISeedWords.Language.English)
+        val words = wordList.getAll()
+        wordList.destroy()
+        return words
+    }
+
+    /**
+     * Pushes the words one by one until a push doesn't succeed, like SeedPhrase.create did before pushWords.
+     */
+    private fun pushEach(seedWords: FFISeedWords, words: List<String>): SeedWordsWordPushResult {
+        var result = SeedWordsWordPushResult.SuccessfulPush
+        for (word in words) {
+            result = seedWords.pushWord(word)
+            if (result != SeedWordsWordPushResult.SuccessfulPush) break
+        }
+        return result
+    }
+
+    @Test
+    fun getAll_assertThatTheWordsAreTheOnesReadOneByOne() {
+        val wordList = FFISeedWords.getMnemonicWordList(FFISeedWords.Language.English)
+        val words = wordList.getAll()
+        assertEquals(wordList.getLength(), words.size)
+        words.forEachIndexed { index, word -> assertEquals(wordList.getAt(index), word) }
+        wordList.destroy()
+    }
+
+    @Test
+    fun pushWords_assertThatTheResultIsTheOneOfPushingEachWord() {
+        val words = englishWords().take(24)
+        val batch = FFISeedWords()
+        val each = FFISeedWords()
+        assertEquals(pushEach(each, words), batch.pushWords(words))
+        assertEquals(each.getAll(), batch.getAll())
+        batch.destroy()
+        each.destroy()
+    }
+
+    @Test
+    fun pushWords_assertThatItStopsAtTheFirstInvalidWord() {
+        val words = englishWords().take(4).toMutableList().apply { set(2, "notaseedword") }
+        val batch = FFISeedWords()
+        val each = FFISeedWords()
+        assertEquals(SeedWordsWordPushResult.InvalidSeedWord, batch.pushWords(words))
+        pushEach(each, words)
+        assertEquals(each.getLength(), batch.getLength())
+        batch.destroy()
+        each.destroy()
+    }
+
+    @Test
+    fun contains_assertThatOnlyWordsOfTheListAreFound() {
+        val words = englishWords()
+        assertTrue(FFISeedWordTrie.contains(FFISeedWords.Language.English, words.first()))
+        assertTrue(FFISeedWordTrie.contains(FFISeedWords.Language.English, words.last()))
+        assertFalse(FFISeedWordTrie.contains(FFISeedWords.Language.English, "notaseedword"))
+    }
+
+    @Test
+    fun complete_assertThatTheWordsWithThePrefixAreReturnedInOrder() {
+        val prefix = englishWords().first().take(2)
+        val expected = englishWords().filter { it.startsWith(prefix) }.sorted()
+        assertEquals(expected, FFISeedWordTrie.complete(FFISeedWords.Language.English, prefix))
+        assertEquals(expected.take(1), FFISeedWordTrie.complete(FFISeedWords.Language.English, prefix, limit = 1))
+    }
+
+    @Test
+    fun suggest_assertThatAWordOneEditAwayIsSuggested() {
+        val word = englishWords()[100]
+        val misspelled = word.dropLast(1) + if (word.last() == 'z') 'y' else 'z'
+        assertTrue(FFISeedWordTrie.suggest(FFISeedWords.Language.English, misspelled).contains(word))
+    }
+}
@@ -43,6 +43,8 @@ import org.junit.runners.Suite
 @RunWith(Suite::class)
 @Suite.SuiteClasses(
     FFIByteVectorTests::class,
+    FFIEmojiIdParserTests::class,
+    FFISeedWordsTests::class,
     FFITariContactTests::class,
     FFIWalletAddressTests::class,
     HexStringTests::class,
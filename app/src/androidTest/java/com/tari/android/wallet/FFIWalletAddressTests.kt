@@ -33,8 +33,10 @@
 package com.tari.android.wallet
 
 import com.tari.android.wallet.ffi.Base58String
+import com.tari.android.wallet.ffi.FFIContact
 import com.tari.android.wallet.ffi.FFITariWalletAddress
 import com.tari.android.wallet.ffi.nullptr
+import org.junit.Assert.assertArrayEquals
 import org.junit.Assert.assertEquals
 import org.junit.Assert.assertNotEquals
 import org.junit.Test
@@ -71,4 +73,43 @@ class FFIWalletAddressTests {
         origin.destroy()
     }
 
+    @Test
+    fun getMetadata_assertThatMetadataMatchesSingleGetters() {
+        val ffiTariWalletAddress = FFITariWalletAddress(Base58String(FFITestUtil.WALLET_ADDRESS_HEX_STRING))
+        val metadata = ffiTariWalletAddress.getMetadata()
+        assertEquals(ffiTariWalletAddress.getNetwork(), metadata.network)
+        assertEquals(ffiTariWalletAddress.getFeatures(), metadata.features)
+        assertEquals(ffiTariWalletAddress.getChecksum(), metadata.checksum)
+        assertEquals(ffiTariWalletAddress.getEmojiId(), metadata.emojiId)
+        assertArrayEquals(ffiTariWalletAddress.getByteVector().byteArray(), metadata.bytes)
+        ffiTariWalletAddress.destroy()
+    }
+
+    @Test
+    fun getWalletAddress_assertThatTheSameCounterpartyReturnsTheSameNativeHandle() {
+        val ffiTariWalletAddress = FFITariWalletAddress(Base58String(FFITestUtil.WALLET_ADDRESS_HEX_STRING))
+        val contact = FFIContact(FFITestUtil.generateRandomAlphanumericString(16), ffiTariWalletAddress)
+        val first = contact.getWalletAddress()
+        val second = contact.getWalletAddress()
+        assertEquals(first.pointer, second.pointer)
+        second.destroy()
+        first.destroy()
+        contact.destroy()
+        ffiTariWalletAddress.destroy()
+    }
+
+    @Test
+    fun destroy_assertThatTheOtherWrapperOfAnInternedAddressStaysUsable() {
+        val ffiTariWalletAddress = FFITariWalletAddress(Base58String(FFITestUtil.WALLET_ADDRESS_HEX_STRING))
+        val contact = FFIContact(FFITestUtil.generateRandomAlphanumericString(16), ffiTariWalletAddress)
+        val first = contact.getWalletAddress()
+        val second = contact.getWalletAddress()
+        first.destroy()
+        assertEquals(FFITestUtil.WALLET_ADDRESS_HEX_STRING, second.toString())
+        assertEquals(ffiTariWalletAddress.getEmojiId(), second.getMetadata().emojiId)
+        second.destroy()
+        contact.destroy()
+        ffiTariWalletAddress.destroy()
+    }
+
 }
@@ -0,0 +1,200 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef BATCH_SEND_TRACKER_CPP
+#define BATCH_SEND_TRACKER_CPP
+
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// status of the items that failed to send or got no direct send result in time
+constexpr int32_t BATCH_SEND_NO_RESULT = -1;
+// one-sided sends may never get a direct send result, their batch completes without it
+constexpr int64_t BATCH_SEND_RESULT_TIMEOUT_NANOS = 60LL * 1000 * 1000 * 1000;
+// results of txs not known yet, a result can beat wallet_send_transaction returning the tx id
+constexpr size_t BATCH_SEND_MAX_EARLY_RESULTS = 1024;
+
+/**
+ * The tx id and direct send status of every item of a batch, in the order of the batch.
+ */
+struct BatchSendCompletion {
+    uint64_t batchId;
+    std::vector<uint64_t> txIds;
+    std::vector<int32_t> sendStatuses;
+};
+
+/**
+ * Correlates the direct send results of the txs of batch sends with their batch. A batch completes once every tx it
+ * sent has its result, or BATCH_SEND_RESULT_TIMEOUT_NANOS after its last send with the results it got by then.
+ */
+class BatchSendTracker {
+public:
+    bool isTracking() const {
+        return batchCount_.load(std::memory_order_relaxed) > 0;
+    }
+
+    uint64_t start(size_t itemCount) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        uint64_t batchId = nextBatchId_++;
+        Batch &batch = batches_[batchId];
+        batch.txIds.resize(itemCount, 0);
+        batch.sendStatuses.resize(itemCount, BATCH_SEND_NO_RESULT);
+        batchCount_.store(batches_.size(), std::memory_order_relaxed);
+        return batchId;
+    }
+
+    /**
+     * Called for every item once its send returned, from any thread.
+     */
+    void onSent(uint64_t batchId, size_t index, uint64_t txId, int errorCode) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Batch &batch = batches_.at(batchId);
+        if (errorCode != 0) {
+            return;
+        }
+        batch.txIds[index] = txId;
+        auto early = earlyResults_.find(txId);
+        if (early != earlyResults_.end()) {
+            batch.sendStatuses[index] = early->second;
+            earlyResults_.erase(early);
+            return;
+        }
+        awaiting_[txId] = ItemRef{batchId, index};
+        batch.awaitingCount++;
+    }
+
+    /**
+     * Called once all the items of the batch were sent, the batch may complete right away.
+     */
+    void onAllSent(uint64_t batchId, int64_t nowNanos, std::vector<BatchSendCompletion> &completed) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto batch = batches_.find(batchId);
+        batch->second.allSent = true;
+        batch->second.deadlineNanos = nowNanos + BATCH_SEND_RESULT_TIMEOUT_NANOS;
+        if (batch->second.awaitingCount == 0) {
+            complete(batch, completed);
+        }
+        if (sendingCount() == 0) {
+            earlyResults_.clear();
+        }
+    }
+
+    /**
+     * @return false if the tx isn't part of a batch
+     */
+    bool onDirectSendResult(uint64_t txId, int32_t sendStatus, std::vector<BatchSendCompletion> &completed) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto item = awaiting_.find(txId);
+        if (item == awaiting_.end()) {
+            // only a batch still sending can be waiting for the tx id of the result
+            if (sendingCount() > 0 && earlyResults_.size() < BATCH_SEND_MAX_EARLY_RESULTS) {
+                earlyResults_[txId] = sendStatus;
+            }
+            return false;
+        }
+        ItemRef ref = item->second;
+        awaiting_.erase(item);
+        auto batch = batches_.find(ref.batchId);
+        batch->second.sendStatuses[ref.index] = sendStatus;
+        batch->second.awaitingCount--;
+        if (batch->second.allSent && batch->second.awaitingCount == 0) {
+            complete(batch, completed);
+        }
+        return true;
+    }
+
+    /**
+     * Completes the batches past their deadline, the items still waiting keep BATCH_SEND_NO_RESULT.
+     */
+    void expire(int64_t nowNanos, std::vector<BatchSendCompletion> &completed) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto batch = batches_.begin(); batch != batches_.end();) {
+            auto next = std::next(batch);
+            if (batch->second.allSent && batch->second.deadlineNanos <= nowNanos) {
+                for (size_t i = 0; i < batch->second.txIds.size(); i++) {
+                    if (batch->second.sendStatuses[i] == BATCH_SEND_NO_RESULT && batch->second.txIds[i] != 0) {
+                        awaiting_.erase(batch->second.txIds[i]);
+                    }
+                }
+                complete(batch, completed);
+            }
+            batch = next;
+        }
+    }
+
+private:
+    struct Batch {
+        std::vector<uint64_t> txIds;
+        std::vector<int32_t> sendStatuses;
+        size_t awaitingCount = 0;
+        bool allSent = false;
+        int64_t deadlineNanos = 0;
+    };
+
+    struct ItemRef {
+        uint64_t batchId;
+        size_t index;
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<uint64_t, Batch> batches_;
+    std::unordered_map<uint64_t, ItemRef> awaiting_;
+    std::unordered_map<uint64_t, int32_t> earlyResults_;
+    uint64_t nextBatchId_ = 1;
+    std::atomic<size_t> batchCount_{0};
+
+    size_t sendingCount() const {
+        size_t count = 0;
+        for (const auto &batch : batches_) {
+            count += batch.second.allSent ? 0 : 1;
+        }
+        return count;
+    }
+
+    void complete(std::unordered_map<uint64_t, Batch>::iterator batch, std::vector<BatchSendCompletion> &completed) {
+        completed.push_back(BatchSendCompletion{batch->first, std::move(batch->second.txIds),
+                                                std::move(batch->second.sendStatuses)});
+        batches_.erase(batch);
+        batchCount_.store(batches_.size(), std::memory_order_relaxed);
+    }
+};
+
+inline BatchSendTracker &GetBatchSendTracker() {
+    static BatchSendTracker tracker;
+    return tracker;
+}
+
+#endif // BATCH_SEND_TRACKER_CPP
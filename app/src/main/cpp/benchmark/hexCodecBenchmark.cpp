@@ -0,0 +1,125 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "../hexCodec.cpp"
+
+/**
+ * Hex codec benchmarks. Sizes are a key or commitment (32 bytes), a signature (64 bytes) and a bulk column (4096 bytes).
+ *
+ * The "string" benchmarks stand for the current path: a "%02X" format per byte, which is what HexString did, and
+ * a character by character parse of the hex string.
+ */
+
+static std::vector<uint8_t> RandomBytes(size_t size) {
+    std::mt19937 random(42);
+    std::vector<uint8_t> bytes(size);
+    for (auto &byte : bytes) {
+        byte = static_cast<uint8_t>(random());
+    }
+    return bytes;
+}
+
+static void BM_HexEncodeString(benchmark::State &state) {
+    std::vector<uint8_t> bytes = RandomBytes(static_cast<size_t>(state.range(0)));
+    for (auto _ : state) {
+        std::string hex;
+        char digits[3];
+        for (uint8_t byte : bytes) {
+            snprintf(digits, sizeof(digits), "%02X", byte);
+            hex += digits;
+        }
+        benchmark::DoNotOptimize(hex);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_HexDecodeString(benchmark::State &state) {
+    std::vector<uint8_t> bytes = RandomBytes(static_cast<size_t>(state.range(0)));
+    std::string hex(2 * bytes.size(), '\0');
+    HexEncodeScalar(bytes.data(), bytes.size(), &hex[0], true);
+    for (auto _ : state) {
+        std::vector<uint8_t> decoded;
+        for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+            unsigned int byte;
+            sscanf(hex.c_str() + i, "%2x", &byte);
+            decoded.push_back(static_cast<uint8_t>(byte));
+        }
+        benchmark::DoNotOptimize(decoded);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_HexEncode(benchmark::State &state, HexCodec codec) {
+    std::vector<uint8_t> bytes = RandomBytes(static_cast<size_t>(state.range(0)));
+    std::string hex(2 * bytes.size(), '\0');
+    for (auto _ : state) {
+        codec.encode(bytes.data(), bytes.size(), &hex[0], true);
+        benchmark::DoNotOptimize(hex.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+static void BM_HexDecode(benchmark::State &state, HexCodec codec) {
+    std::vector<uint8_t> bytes = RandomBytes(static_cast<size_t>(state.range(0)));
+    std::string hex(2 * bytes.size(), '\0');
+    HexEncodeScalar(bytes.data(), bytes.size(), &hex[0], true);
+    std::vector<uint8_t> decoded(bytes.size());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(codec.decode(hex.data(), hex.size(), decoded.data()));
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+BENCHMARK(BM_HexEncodeString)->Arg(32)->Arg(64)->Arg(4096);
+BENCHMARK(BM_HexDecodeString)->Arg(32)->Arg(64)->Arg(4096);
+
+int main(int argc, char **argv) {
+    for (const HexCodec &codec : GetSupportedHexCodecs()) {
+        benchmark::RegisterBenchmark((std::string("BM_HexEncode/") + codec.name).c_str(), BM_HexEncode, codec)->Arg(32)->Arg(64)->Arg(4096);
+        benchmark::RegisterBenchmark((std::string("BM_HexDecode/") + codec.name).c_str(), BM_HexDecode, codec)->Arg(32)->Arg(64)->Arg(4096);
+    }
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
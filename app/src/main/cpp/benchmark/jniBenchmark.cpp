@@ -0,0 +1,1101 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <benchmark/benchmark.h>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <jni.h>
+#include <walletStub.h>
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "jniFixture.cpp"
+
+/**
+ * Benchmarks of the JNI entry points of native-lib, built for the host against the fake JVM of host/fakeJni.cpp
+ * and the stub libminotari_wallet_ffi. The library is loaded and its entry points are looked up by their mangled name,
+ * the way System.loadLibrary and the JVM bind them.
+ *
+ * Every benchmark reports allocs/op next to the time. The allocations of the stub libwallet behind a call are counted,
+ * those of the fake JVM and of what stands in for the Kotlin side (destroying returned and delivered objects, creating
+ * the payloads of fired callbacks) aren't. Pointer results are destroyed through the jniDestroy of their class within
+ * the op, like the Kotlin wrappers do.
+ *
+ * Callbacks are fired through the callbacks the stub wallet was created with and timed until they're delivered
+ * to the fake callback handler, async entry points until their onJobCompleted delivery.
+ *
+ * The CallbackStorm benchmarks load the delivery path with the stub's event generator instead: every callback from
+ * txReceived to baseNodeStatus fired from several native threads at a fixed rate, each event timestamped when it's
+ * injected and when it arrives at the handler. They report the delivered events/s, the p50, p99 and p99.9 delivery
+ * latency, the threads attached to deliver them and the events that never arrived.
+ */
+
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *pointer, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *pointer);
+}
+
+static std::atomic<uint64_t> g_allocationCount(0);
+
+static void CountAllocation() {
+    if (!IsInFakeJvm()) {
+        g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+extern "C" void *malloc(size_t size) {
+    CountAllocation();
+    return __libc_malloc(size);
+}
+
+extern "C" void *calloc(size_t count, size_t size) {
+    CountAllocation();
+    return __libc_calloc(count, size);
+}
+
+extern "C" void *realloc(void *pointer, size_t size) {
+    CountAllocation();
+    return __libc_realloc(pointer, size);
+}
+
+extern "C" void *aligned_alloc(size_t alignment, size_t size) {
+    CountAllocation();
+    return __libc_memalign(alignment, size);
+}
+
+extern "C" int posix_memalign(void **pPointer, size_t alignment, size_t size) {
+    CountAllocation();
+    *pPointer = __libc_memalign(alignment, size);
+    return *pPointer != nullptr ? 0 : ENOMEM;
+}
+
+extern "C" void free(void *pointer) {
+    __libc_free(pointer);
+}
+
+/**
+ * Reports the allocations made between construction and destruction as allocs/op, create it right before the loop.
+ */
+class AllocationCounter {
+public:
+    explicit AllocationCounter(benchmark::State &state, int opsPerIteration = 1)
+            : state_(state), opsPerIteration_(opsPerIteration), start_(g_allocationCount.load()) {}
+
+    ~AllocationCounter() {
+        auto count = static_cast<double>(g_allocationCount.load() - start_) / opsPerIteration_;
+        state_.counters["allocs/op"] = benchmark::Counter(count, benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    benchmark::State &state_;
+    int opsPerIteration_;
+    uint64_t start_;
+};
+
+/**
+ * Callbacks are fired in batches, each batch waits for its deliveries.
+ */
+static const int CALLBACK_BATCH_SIZE = 64;
+static const uint64_t FIRST_CALLBACK_TX_ID = 1000000;
+
+/**
+ * Set when deliveries didn't arrive in time, the running benchmark is then skipped with an error.
+ */
+static std::atomic<bool> g_deliveryTimedOut(false);
+
+static benchmark::internal::Benchmark *AddBenchmark(const std::string &name, std::function<void()> op) {
+    return benchmark::RegisterBenchmark(name.c_str(), [op](benchmark::State &state) {
+        FakeJvm &jvm = FakeJvm::get();
+        {
+            AllocationCounter counter(state);
+            for (auto _ : state) {
+                op();
+                jvm.releaseLocals();
+                if (g_deliveryTimedOut.load()) {
+                    state.SkipWithError("Timed out waiting for a delivery");
+                    break;
+                }
+            }
+        }
+        // ops are set up to succeed, an error code means the benchmark doesn't measure what it claims to
+        int errorCode = static_cast<int>(FakeJvm::getField(g_fixture.error, "code"));
+        if (errorCode != 0 && !g_deliveryTimedOut.load()) {
+            state.SkipWithError(("Entry point failed with error " + std::to_string(errorCode)).c_str());
+        }
+        g_deliveryTimedOut = false;
+        jvm.env()->SetIntField(g_fixture.error, jvm.env()->GetFieldID(jvm.env()->GetObjectClass(g_fixture.error), "code", "I"), 0);
+    });
+}
+
+/**
+ * Adds a benchmark of one call of the entry point, the result is handed to onResult.
+ */
+template <typename R, typename... A, typename F>
+static void AddCall(const std::string &name, jobject receiver, F onResult, A... args) {
+    auto function = FindEntryPoint<R, A...>(name);
+    AddBenchmark(name, [=] {
+        if constexpr (std::is_void_v<R>) {
+            function(g_fixture.jEnv, receiver, args...);
+            onResult();
+        } else {
+            onResult(function(g_fixture.jEnv, receiver, args...));
+        }
+    });
+}
+
+template <typename... A>
+static void AddGetter(const GetterCase &getter, A... args) {
+    jobject receiver = g_fixture.receiver(ClassOf(getter.name));
+    switch (getter.kind) {
+        case ResultKind::VOID:
+            AddCall<void>(getter.name, receiver, IGNORE_RESULT, args...);
+            break;
+        case ResultKind::BOOLEAN:
+            AddCall<jboolean>(getter.name, receiver, IGNORE_RESULT, args...);
+            break;
+        case ResultKind::INT:
+            AddCall<jint>(getter.name, receiver, IGNORE_RESULT, args...);
+            break;
+        case ResultKind::LONG:
+            if (getter.resultClass != nullptr) {
+                AddCall<jlong>(getter.name, receiver, JniDestroy(getter.resultClass), args...);
+            } else {
+                AddCall<jlong>(getter.name, receiver, IGNORE_RESULT, args...);
+            }
+            break;
+        case ResultKind::OBJECT:
+            AddCall<jobject>(getter.name, receiver, IGNORE_RESULT, args...);
+            break;
+    }
+}
+
+
+static std::vector<std::string> UtxoCommitments(size_t count) {
+    int error = 0;
+    TariVector *pUtxos = wallet_get_all_utxos(g_fixture.pWallet, &error);
+    std::vector<std::string> commitments;
+    auto pItems = reinterpret_cast<TariUtxo *>(pUtxos->ptr);
+    for (size_t i = 0; i < count && i < pUtxos->len; i++) {
+        commitments.emplace_back(pItems[i].commitment);
+    }
+    destroy_tari_vector(pUtxos);
+    return commitments;
+}
+
+static void AddGetters() {
+    jobject error = g_fixture.error;
+    for (const GetterCase &getter : GETTERS) {
+        AddGetter(getter, error);
+    }
+    for (const GetterCase &getter : COLLECTION_GETTERS) {
+        if (strstr(getter.name, "GetAt") != nullptr) {
+            AddGetter(getter, static_cast<jint>(0), error);
+        } else {
+            AddGetter(getter, error);
+        }
+    }
+    for (const GetterCase &getter : PLAIN_GETTERS) {
+        AddGetter(getter);
+    }
+    AddCall<jint>("FFIError_jniGetLastCode", g_fixture.receiver("FFIError"), IGNORE_RESULT);
+    AddCall<jlong>("FFITariVector_jniGetItemAt", g_fixture.receiver("FFITariVector"), IGNORE_RESULT, static_cast<jint>(0));
+
+    jobject wallet = g_fixture.wallet;
+    AddCall<jlong>("FFIWallet_jniGetAllUtxos", wallet, NativeDestroy(destroy_tari_vector), error);
+    // the vector to destroy is taken within the op
+    auto destroyUtxos = FindEntryPoint<void, jlong>("FFIWallet_jniDestroyUtxos");
+    AddBenchmark("FFIWallet_jniDestroyUtxos", [wallet, destroyUtxos] {
+        int errorCode = 0;
+        destroyUtxos(g_fixture.jEnv, wallet, reinterpret_cast<jlong>(wallet_get_all_utxos(g_fixture.pWallet, &errorCode)));
+    });
+    AddCall<jlong>("FFIWallet_jniGetUtxos", wallet, NativeDestroy(destroy_tari_vector), static_cast<jint>(0), static_cast<jint>(20),
+                   static_cast<jint>(0), static_cast<jlong>(0), error);
+    AddCall<jlong>("FFIWallet_jniWalletGetFeePerGramStats", wallet, JniDestroy("FFIFeePerGramStats"), static_cast<jint>(3), error);
+    AddCall<jobject>("FFIWallet_jniGetCallStatsValues", wallet, IGNORE_RESULT, static_cast<jint>(16));
+
+    int errorCode = 0;
+    TariVector *pUtxos = wallet_get_all_utxos(g_fixture.pWallet, &errorCode);
+    auto count = static_cast<jsize>(pUtxos->len);
+    destroy_tari_vector(pUtxos);
+    AddCall<jobject>("FFITariVector_jniGetUtxoColumns", g_fixture.receiver("FFITariVector"), IGNORE_RESULT,
+                     NewGlobalArray(&JNIEnv::NewLongArray, count), NewGlobalArray(&JNIEnv::NewLongArray, count),
+                     NewGlobalArray(&JNIEnv::NewLongArray, count), NewGlobalArray(&JNIEnv::NewLongArray, count),
+                     NewGlobalArray(&JNIEnv::NewByteArray, count), NewGlobalArray(&JNIEnv::NewIntArray, count + 1));
+    AddCall<jobject>("FFIEmojiSet_jniGetAllBytes", g_fixture.receiver("FFIEmojiSet"), IGNORE_RESULT,
+                     NewGlobalArray(&JNIEnv::NewIntArray, 257), error);
+    AddCall<void>("FFITariWalletAddress_jniLoadMetadata", g_fixture.receiver("FFITariWalletAddress"), IGNORE_RESULT,
+                  FakeJvm::get().newGlobalObject("com/tari/android/wallet/model/TariWalletAddress$Metadata"), error);
+}
+
+/**
+ * One batch send of count txs to the same destination, with up to maxConcurrency sends at a time.
+ */
+static void AddSendTxBatch(jsize count, jint maxConcurrency) {
+    JNIEnv *jEnv = g_fixture.jEnv;
+    jobjectArray localDestinations = jEnv->NewObjectArray(count, jEnv->GetObjectClass(g_fixture.receiver("FFITariWalletAddress")),
+                                                          nullptr);
+    for (jsize i = 0; i < count; i++) {
+        jEnv->SetObjectArrayElement(localDestinations, i, g_fixture.receiver("FFITariWalletAddress"));
+    }
+    auto destinations = static_cast<jobjectArray>(jEnv->NewGlobalRef(localDestinations));
+    jlongArray amounts = NewGlobalArray(&JNIEnv::NewLongArray, count);
+    std::vector<jlong> amountValues(static_cast<size_t>(count), 100000);
+    jEnv->SetLongArrayRegion(amounts, 0, count, amountValues.data());
+    jobjectArray paymentIds = NewGlobalStrings(std::vector<std::string>(static_cast<size_t>(count), "benchmark batch payment"));
+    jlongArray txIds = NewGlobalArray(&JNIEnv::NewLongArray, count);
+    jintArray errorCodes = NewGlobalArray(&JNIEnv::NewIntArray, count);
+    FakeJvm::get().releaseLocals();
+    static const auto sendTxBatch =
+            FindEntryPoint<jlong, jobjectArray, jlongArray, jlong, jobjectArray, jint, jlongArray, jintArray, jobject>(
+                    "FFIWallet_jniSendTxBatch");
+    AddBenchmark("FFIWallet_jniSendTxBatch/items:" + std::to_string(count) + "/concurrency:" + std::to_string(maxConcurrency), [=] {
+        sendTxBatch(g_fixture.jEnv, g_fixture.wallet, destinations, amounts, 5, paymentIds, maxConcurrency, txIds, errorCodes,
+                    g_fixture.error);
+    });
+}
+
+/**
+ * A create entry point called on an object of its own, destroyed again through jniDestroy within the op.
+ */
+template <typename... A>
+static void AddCreate(const std::string &name, A... args) {
+    std::string className = ClassOf(name);
+    jobject object = FakeJvm::get().newGlobalObject(FFI_PACKAGE + className);
+    auto destroy = FindEntryPoint<void>(className + "_jniDestroy");
+    AddCall<void>(name, object, [object, destroy] { destroy(g_fixture.jEnv, object); }, args...);
+}
+
+static void AddCreates() {
+    FakeJvm &jvm = FakeJvm::get();
+    jobject error = g_fixture.error;
+    int errorCode = 0;
+    std::vector<uint8_t> keyBytes(32, 7);
+    TariWalletAddress *pAddress = wallet_get_tari_one_sided_address(g_fixture.pWallet, &errorCode);
+    std::string base58 = TakeString(wallet_stub_address_to_base58(pAddress, &errorCode));
+    std::string emojiId = TakeString(tari_address_to_emoji_id(pAddress, &errorCode));
+    ByteVector *pAddressBytes = tari_address_get_bytes(pAddress, &errorCode);
+    jobject addressBytes = jvm.newPointerObject(std::string(FFI_PACKAGE) + "FFIByteVector", pAddressBytes);
+    tari_address_destroy(pAddress);
+    std::string json = TakeString(tari_unblinded_output_to_json(
+            reinterpret_cast<TariUnblindedOutput *>(FakeJvm::getField(g_fixture.receiver("FFITariUnblindedOutput"), "pointer")),
+            &errorCode));
+
+    AddCreate("FFIByteVector_jniCreate", NewGlobalBytes(keyBytes), error);
+    AddCreate("FFICommsConfig_jniCreate", jvm.newGlobalString("wallet"), jvm.newGlobalString(g_fixture.directory), error);
+    AddCreate("FFIContact_jniCreate", jvm.newGlobalString("Alice"), static_cast<jboolean>(JNI_TRUE),
+              g_fixture.receiver("FFITariWalletAddress"), error);
+    AddCreate("FFIEmojiSet_jniCreate");
+    AddCreate("FFIOutputFeatures_jniCreate", static_cast<jchar>(0), static_cast<jlong>(0), g_fixture.receiver("FFIByteVector"), error);
+    AddCreate("FFIPrivateKey_jniCreate", g_fixture.receiver("FFIByteVector"), error);
+    AddCreate("FFIPrivateKey_jniGenerate");
+    AddCreate("FFIPrivateKey_jniFromHex", jvm.newGlobalString(std::string(64, 'a')), error);
+    AddCreate("FFIPublicKey_jniCreate", g_fixture.receiver("FFIByteVector"), error);
+    AddCreate("FFIPublicKey_jniFromHex", jvm.newGlobalString(std::string(64, 'b')), error);
+    AddCreate("FFIPublicKey_jniFromPrivateKey", g_fixture.receiver("FFIPrivateKey"), error);
+    AddCreate("FFISeedWords_jniCreate");
+    AddCreate("FFISeedWords_jniFromBase58", jvm.newGlobalString("3GDgkpMnHR6bBs8aeZ5ih8XpqBBv8DAvXw"),
+              jvm.newGlobalString("passphrase"), error);
+    AddCreate("FFISeedWords_jniGetMnemonicWordListForLanguage", jvm.newGlobalString("English"), error);
+    AddCreate("FFITariUnblindedOutput_jniFromJson", jvm.newGlobalString(json), error);
+    AddCreate("FFITariWalletAddress_jniCreate", addressBytes, error);
+    AddCreate("FFITariWalletAddress_jniFromBase58", jvm.newGlobalString(base58), error);
+    AddCreate("FFITariWalletAddress_jniFromEmojiId", jvm.newGlobalString(emojiId), error);
+
+    // words are pushed to a new set every op, a full set refuses more
+    auto seedWordsCreate = FindEntryPoint<void>("FFISeedWords_jniCreate");
+    auto seedWordsDestroy = FindEntryPoint<void>("FFISeedWords_jniDestroy");
+    jobject seedWords = jvm.newGlobalObject(std::string(FFI_PACKAGE) + "FFISeedWords");
+    auto recreateSeedWords = [seedWords, seedWordsCreate, seedWordsDestroy](auto...) {
+        seedWordsDestroy(g_fixture.jEnv, seedWords);
+        seedWordsCreate(g_fixture.jEnv, seedWords);
+    };
+    seedWordsCreate(g_fixture.jEnv, seedWords);
+    TariSeedWords *pWords = wallet_get_seed_words(g_fixture.pWallet, &errorCode);
+    std::vector<std::string> words;
+    for (unsigned int i = 0; i < seed_words_get_length(pWords, &errorCode); i++) {
+        words.push_back(TakeString(seed_words_get_at(pWords, i, &errorCode)));
+    }
+    seed_words_destroy(pWords);
+    AddCall<jint>("FFISeedWords_jniPushWord", seedWords, recreateSeedWords, jvm.newGlobalString(words[0]), error);
+    AddCall<jint>("FFISeedWords_jniPushWords", seedWords, recreateSeedWords, NewGlobalStrings(words), error);
+}
+
+static void AddStringMarshalling() {
+    FakeJvm &jvm = FakeJvm::get();
+    jobject error = g_fixture.error;
+    jobject wallet = g_fixture.wallet;
+    int errorCode = 0;
+
+    std::vector<uint8_t> bytes(32);
+    for (size_t i = 0; i < bytes.size(); i++) {
+        bytes[i] = static_cast<uint8_t>(i * 13);
+    }
+    AddCall<jstring>("FFIHex_jniEncode", g_fixture.receiver("FFIHex"), IGNORE_RESULT, NewGlobalBytes(bytes),
+                     static_cast<jboolean>(JNI_TRUE));
+    AddCall<jbyteArray>("FFIHex_jniDecode", g_fixture.receiver("FFIHex"), IGNORE_RESULT,
+                        jvm.newGlobalString("00112233445566778899aabbccddeeff00112233445566778899aabbccddeeff"));
+
+    TariWalletAddress *pAddress = wallet_get_tari_one_sided_address(g_fixture.pWallet, &errorCode);
+    jstring emojiId = jvm.newGlobalString(TakeString(tari_address_to_emoji_id(pAddress, &errorCode)));
+    tari_address_destroy(pAddress);
+    AddCall<jint>("FFIEmojiIdParser_jniValidate", g_fixture.receiver("FFIEmojiIdParser"), IGNORE_RESULT, emojiId);
+    AddCall<jbyteArray>("FFIEmojiIdParser_jniDecode", g_fixture.receiver("FFIEmojiIdParser"), IGNORE_RESULT, emojiId);
+
+    jobject trie = g_fixture.receiver("FFISeedWordTrie");
+    jstring english = jvm.newGlobalString("English");
+    AddCall<jboolean>("FFISeedWordTrie_jniContains", trie, IGNORE_RESULT, english, jvm.newGlobalString("abac"), error);
+    AddCall<jobjectArray>("FFISeedWordTrie_jniComplete", trie, IGNORE_RESULT, english, jvm.newGlobalString("ab"),
+                          static_cast<jint>(8), error);
+    AddCall<jobjectArray>("FFISeedWordTrie_jniSuggest", trie, IGNORE_RESULT, english, jvm.newGlobalString("abqc"),
+                          static_cast<jint>(1), static_cast<jint>(8), error);
+
+    TariCompletedTransaction *pCompletedTx = reinterpret_cast<TariCompletedTransaction *>(
+            FakeJvm::getField(g_fixture.receiver("FFICompletedTx"), "pointer"));
+    jstring completedTxId = jvm.newGlobalString(std::to_string(completed_transaction_get_transaction_id(pCompletedTx, &errorCode)));
+    TariCompletedTransactions *pCancelledTxs = wallet_get_cancelled_transactions(g_fixture.pWallet, 0, &errorCode);
+    TariCompletedTransaction *pCancelledTx = completed_transactions_get_at(pCancelledTxs, 0, &errorCode);
+    jstring cancelledTxId = jvm.newGlobalString(std::to_string(completed_transaction_get_transaction_id(pCancelledTx, &errorCode)));
+    completed_transaction_destroy(pCancelledTx);
+    completed_transactions_destroy(pCancelledTxs);
+    auto pInboundTx = reinterpret_cast<TariPendingInboundTransaction *>(FakeJvm::getField(g_fixture.receiver("FFIPendingInboundTx"), "pointer"));
+    jstring inboundTxId = jvm.newGlobalString(std::to_string(pending_inbound_transaction_get_transaction_id(pInboundTx, &errorCode)));
+    auto pOutboundTx = reinterpret_cast<TariPendingOutboundTransaction *>(FakeJvm::getField(g_fixture.receiver("FFIPendingOutboundTx"), "pointer"));
+    jstring outboundTxId = jvm.newGlobalString(std::to_string(pending_outbound_transaction_get_transaction_id(pOutboundTx, &errorCode)));
+    AddCall<jlong>("FFIWallet_jniGetCompletedTxById", wallet, JniDestroy("FFICompletedTx"), completedTxId, error);
+    AddCall<jlong>("FFIWallet_jniGetCancelledTxById", wallet, JniDestroy("FFICompletedTx"), cancelledTxId, error);
+    AddCall<jlong>("FFIWallet_jniGetPendingInboundTxById", wallet, JniDestroy("FFIPendingInboundTx"), inboundTxId, error);
+    AddCall<jlong>("FFIWallet_jniGetPendingOutboundTxById", wallet, JniDestroy("FFIPendingOutboundTx"), outboundTxId, error);
+    AddCall<jlong>("FFIWallet_jniGetTxPayRefs", wallet, JniDestroy("FFITariPaymentRecords"), completedTxId, error);
+
+    jstring key = jvm.newGlobalString("benchmark key");
+    jstring value = jvm.newGlobalString("benchmark value");
+    auto setKeyValue = FindEntryPoint<jboolean, jstring, jstring, jobject>("FFIWallet_jniSetKeyValue");
+    AddCall<jboolean>("FFIWallet_jniSetKeyValue", wallet, IGNORE_RESULT, key, value, error);
+    AddCall<jstring>("FFIWallet_jniGetKeyValue", wallet, IGNORE_RESULT, key, error);
+    AddCall<jboolean>("FFIWallet_jniRemoveKeyValue", wallet, [=](jboolean) { setKeyValue(g_fixture.jEnv, wallet, key, value, error); },
+                      key, error);
+    AddCall<void>("FFIWallet_jniSetConfirmations", wallet, IGNORE_RESULT, jvm.newGlobalString("3"), error);
+    AddCall<void>("FFIWallet_jniLogMessage", wallet, IGNORE_RESULT, jvm.newGlobalString("benchmark log message"), error);
+
+    jstring amount = jvm.newGlobalString("100000");
+    jstring feePerGram = jvm.newGlobalString("5");
+    AddCall<jbyteArray>("FFIWallet_jniEstimateTxFee", wallet, IGNORE_RESULT, amount, feePerGram, jvm.newGlobalString("1"),
+                        jvm.newGlobalString("2"), error);
+    jobjectArray commitments = NewGlobalStrings(UtxoCommitments(4));
+    jstring splitCount = jvm.newGlobalString("3");
+    AddCall<jlong>("FFIWallet_jniPreviewJoinUtxos", wallet, IGNORE_RESULT, commitments, feePerGram, error);
+    AddCall<jlong>("FFIWallet_jniPreviewSplitUtxos", wallet, IGNORE_RESULT, commitments, splitCount, feePerGram, error);
+    AddCall<jlong>("FFIWallet_jniJoinUtxos", wallet, IGNORE_RESULT, commitments, feePerGram, error);
+    AddCall<jlong>("FFIWallet_jniSplitUtxos", wallet, IGNORE_RESULT, commitments, splitCount, feePerGram, error);
+    AddCall<jbyteArray>("FFIWallet_jniSendTx", wallet, IGNORE_RESULT, g_fixture.receiver("FFITariWalletAddress"), amount,
+                        feePerGram, jvm.newGlobalString("benchmark payment"), error);
+    AddSendTxBatch(16, 1);
+    AddSendTxBatch(16, 4);
+    AddCall<jbyteArray>("FFIWallet_jniImportExternalUtxoAsNonRewindable", wallet, IGNORE_RESULT,
+                        g_fixture.receiver("FFITariUnblindedOutput"), g_fixture.receiver("FFITariWalletAddress"),
+                        jvm.newGlobalString("imported"), error);
+
+    jstring message = jvm.newGlobalString("benchmark message");
+    std::string signature = TakeString(wallet_sign_message(g_fixture.pWallet, "benchmark message", &errorCode));
+    AddCall<jstring>("FFIWallet_jniSignMessage", wallet, IGNORE_RESULT, message, error);
+    AddCall<jboolean>("FFIWallet_jniVerifyMessageSignature", wallet, IGNORE_RESULT, g_fixture.receiver("FFIPublicKey"), message,
+                      jvm.newGlobalString(signature), error);
+
+    // a tx is sent before every cancel, outside the allocation count
+    auto cancelPendingTx = FindEntryPoint<jboolean, jstring, jobject>("FFIWallet_jniCancelPendingTx");
+    auto pDestination = reinterpret_cast<TariWalletAddress *>(FakeJvm::getField(g_fixture.receiver("FFITariWalletAddress"), "pointer"));
+    AddBenchmark("FFIWallet_jniCancelPendingTx", [=] {
+        jstring txId;
+        {
+            FakeJvmScope scope;
+            int sendError = 0;
+            uint64_t id = wallet_send_transaction(g_fixture.pWallet, pDestination, 1000, nullptr, 5, false, "cancelled", &sendError);
+            txId = g_fixture.jEnv->NewStringUTF(std::to_string(id).c_str());
+        }
+        cancelPendingTx(g_fixture.jEnv, wallet, txId, error);
+    });
+
+    // the contact is added back after every removal
+    auto addUpdateContact = FindEntryPoint<jboolean, jobject, jobject>("FFIWallet_jniAddUpdateContact");
+    jobject contact = g_fixture.receiver("FFIContact");
+    AddCall<jboolean>("FFIWallet_jniAddUpdateContact", wallet, IGNORE_RESULT, contact, error);
+    AddCall<jboolean>("FFIWallet_jniRemoveContact", wallet, [=](jboolean) { addUpdateContact(g_fixture.jEnv, wallet, contact, error); },
+                      contact, error);
+
+    jstring directory = jvm.newGlobalString(g_fixture.directory);
+    AddCall<jboolean>("FFIWallet_jniWriteWarmStartSnapshot", wallet, IGNORE_RESULT, directory, static_cast<jint>(100),
+                      static_cast<jlong>(STUB_TIP_HEIGHT), error);
+    auto unmap = FindEntryPoint<void>("FFIWarmStartSnapshot_jniUnmap");
+    jobject snapshot = g_fixture.receiver("FFIWarmStartSnapshot");
+    AddCall<jobject>("FFIWarmStartSnapshot_jniMap", snapshot, [=](jobject) { unmap(g_fixture.jEnv, snapshot); }, directory);
+    AddCall<jboolean>("FFITrace_jniWriteJson", g_fixture.receiver("FFITrace"), IGNORE_RESULT,
+                      jvm.newGlobalString(g_fixture.directory + "/trace.json"));
+}
+
+static void AddSettings() {
+    AddCall<void>("FFICallbackDedup_jniSetEnabled", g_fixture.receiver("FFICallbackDedup"), IGNORE_RESULT,
+                  static_cast<jboolean>(JNI_TRUE));
+    AddCall<void>("FFICallbackDedup_jniClear", g_fixture.receiver("FFICallbackDedup"), IGNORE_RESULT);
+    AddCall<jboolean>("FFICallbackLanes_jniSetLane", g_fixture.receiver("FFICallbackLanes"), IGNORE_RESULT, static_cast<jint>(12),
+                      static_cast<jint>(1));
+    AddCall<void>("FFICallbackLanes_jniResetLaneStats", g_fixture.receiver("FFICallbackLanes"), IGNORE_RESULT);
+    // every type and no tx id filter, what the callback benchmarks need
+    AddCall<void>("FFICallbackSubscriptions_jniSubscribe", g_fixture.receiver("FFICallbackSubscriptions"), IGNORE_RESULT,
+                  static_cast<jint>(-1), NewGlobalArray(&JNIEnv::NewLongArray, 0), static_cast<jint>(0));
+    AddCall<void>("FFITrace_jniSetEnabled", g_fixture.receiver("FFITrace"), IGNORE_RESULT, static_cast<jboolean>(JNI_FALSE));
+    AddCall<void>("FFITrace_jniClear", g_fixture.receiver("FFITrace"), IGNORE_RESULT);
+    AddCall<void>("FFITxLifecycle_jniClear", g_fixture.receiver("FFITxLifecycle"), IGNORE_RESULT);
+    AddCall<void>("FFIWallet_jniResetCallStats", g_fixture.wallet, IGNORE_RESULT);
+    AddCall<jboolean>("FFIWallet_jniCancelCreate", g_fixture.wallet, IGNORE_RESULT, static_cast<jlong>(-1));
+}
+
+/**
+ * The completed txs of the wallet and every tx in them, released by one scope close, kept out of the scope and
+ * destroyed after it, or destroyed one by one like the finalizers of their wrappers do.
+ */
+static void AddHandleScopes() {
+    jobject wallet = g_fixture.wallet;
+    jobject error = g_fixture.error;
+    jobject scopes = g_fixture.receiver("FFIHandleScope");
+    auto getCompletedTxs = FindEntryPoint<jlong, jobject>("FFIWallet_jniGetCompletedTxs");
+    auto getLength = FindEntryPoint<jint, jobject>("FFICompletedTxs_jniGetLength");
+    auto getAt = FindEntryPoint<jlong, jint, jobject>("FFICompletedTxs_jniGetAt");
+    auto open = FindEntryPoint<jlong>("FFIHandleScope_jniOpen");
+    auto close = FindEntryPoint<jlongArray, jlong>("FFIHandleScope_jniClose");
+    auto keep = FindEntryPoint<jboolean, jlong>("FFIHandleScope_jniKeep");
+    jobject completedTxs = FakeJvm::get().newPointerObject(std::string(FFI_PACKAGE) + "FFICompletedTxs", nullptr);
+    auto getAll = [=](const std::function<void(jlong)> &onTx) {
+        JNIEnv *jEnv = g_fixture.jEnv;
+        jlong pCompletedTxs = getCompletedTxs(jEnv, wallet, error);
+        jEnv->SetLongField(completedTxs, jEnv->GetFieldID(jEnv->GetObjectClass(completedTxs), "pointer", "J"), pCompletedTxs);
+        jint length = getLength(jEnv, completedTxs, error);
+        for (jint i = 0; i < length; i++) {
+            onTx(getAt(jEnv, completedTxs, i, error));
+        }
+        return pCompletedTxs;
+    };
+
+    AddBenchmark("HandleScope/CompletedTxs", [=] {
+        jlong scope = open(g_fixture.jEnv, scopes);
+        getAll([](jlong) {});
+        close(g_fixture.jEnv, scopes, scope);
+    });
+    ResultDestroy destroyTx = JniDestroy("FFICompletedTx");
+    ResultDestroy destroyTxs = JniDestroy("FFICompletedTxs");
+    AddBenchmark("HandleScope/CompletedTxsKept", [=] {
+        JNIEnv *jEnv = g_fixture.jEnv;
+        jlong scope = open(jEnv, scopes);
+        std::vector<jlong> txs;
+        jlong pCompletedTxs = getAll([&txs](jlong pTx) { txs.push_back(pTx); });
+        for (jlong pTx : txs) {
+            keep(jEnv, scopes, pTx);
+        }
+        keep(jEnv, scopes, pCompletedTxs);
+        close(jEnv, scopes, scope);
+        for (jlong pTx : txs) {
+            destroyTx(pTx);
+        }
+        destroyTxs(pCompletedTxs);
+    });
+    AddBenchmark("HandleScope/CompletedTxsDestroyedEach", [=] {
+        destroyTxs(getAll(destroyTx));
+    });
+}
+
+/**
+ * A query filter laid out like FFITxHistoryQuery.toFilter: kinds, statuses, direction, min and max amount, from and to
+ * timestamp, order, limit and offset.
+ */
+static jlongArray NewGlobalTxHistoryFilter(const std::vector<jlong> &filter) {
+    jlongArray jFilter = NewGlobalArray(&JNIEnv::NewLongArray, static_cast<jsize>(filter.size()));
+    g_fixture.jEnv->SetLongArrayRegion(jFilter, 0, static_cast<jsize>(filter.size()), filter.data());
+    return jFilter;
+}
+
+/**
+ * The history index of the fixture wallet, synced once up front. The pages are what a history screen asks for, the
+ * sync is the full rebuild run when a wallet starts.
+ */
+static void AddTxHistoryIndex() {
+    JNIEnv *jEnv = g_fixture.jEnv;
+    jobject wallet = g_fixture.wallet;
+    jobject error = g_fixture.error;
+    jobject index = g_fixture.receiver("FFITxHistoryIndex");
+    FindEntryPoint<jboolean, jstring>("FFITxHistoryIndex_jniOpen")(jEnv, index, FakeJvm::get().newGlobalString(g_fixture.directory));
+    auto sync = FindEntryPoint<jint, jobject>("FFIWallet_jniSyncTxHistoryIndex");
+    sync(jEnv, wallet, error);
+    AddBenchmark("FFIWallet_jniSyncTxHistoryIndex", [=] {
+        sync(g_fixture.jEnv, wallet, error);
+    });
+
+    constexpr jsize PAGE_SIZE = 50;
+    jlongArray ids = NewGlobalArray(&JNIEnv::NewLongArray, PAGE_SIZE);
+    jlongArray amounts = NewGlobalArray(&JNIEnv::NewLongArray, PAGE_SIZE);
+    jlongArray fees = NewGlobalArray(&JNIEnv::NewLongArray, PAGE_SIZE);
+    jlongArray timestamps = NewGlobalArray(&JNIEnv::NewLongArray, PAGE_SIZE);
+    jintArray statuses = NewGlobalArray(&JNIEnv::NewIntArray, PAGE_SIZE);
+    jbyteArray flags = NewGlobalArray(&JNIEnv::NewByteArray, PAGE_SIZE);
+    auto queryIds = FindEntryPoint<jint, jlongArray, jbyteArray, jstring, jlongArray, jobject>("FFITxHistoryIndex_jniQueryIds");
+    auto queryColumns = FindEntryPoint<jint, jlongArray, jbyteArray, jstring, jlongArray, jlongArray, jlongArray, jlongArray,
+            jintArray, jbyteArray, jobject>("FFITxHistoryIndex_jniQueryColumns");
+    auto addQuery = [=](const std::string &name, jlongArray filter, jstring text, bool withColumns) {
+        AddBenchmark("TxHistoryIndex/" + name, [=] {
+            jint count = withColumns
+                         ? queryColumns(g_fixture.jEnv, index, filter, nullptr, text, ids, amounts, fees, timestamps, statuses, flags, error)
+                         : queryIds(g_fixture.jEnv, index, filter, nullptr, text, ids, error);
+            benchmark::DoNotOptimize(count);
+        });
+    };
+    jlongArray newestFirst = NewGlobalTxHistoryFilter({0, 0, 0, -1, -1, -1, -1, 0, -1, 0});
+    addQuery("NewestIds", newestFirst, nullptr, false);
+    addQuery("NewestColumns", newestFirst, nullptr, true);
+    addQuery("LargestOutboundColumns", NewGlobalTxHistoryFilter({0, 0, 2, 1, -1, -1, -1, 2, -1, 0}), nullptr,
+             true);
+    addQuery("SearchIds", newestFirst, FakeJvm::get().newGlobalString("payment 1"), false);
+    AddCall<jlong>("FFITxHistoryIndex_jniCount", index, IGNORE_RESULT, newestFirst, static_cast<jbyteArray>(nullptr),
+                   static_cast<jstring>(nullptr), error);
+
+    // an alias for the counterparty of each of the first completed txs
+    constexpr unsigned int ALIAS_COUNT = 50;
+    int errorCode = 0;
+    TariCompletedTransactions *pCompletedTxs = wallet_get_completed_transactions(g_fixture.pWallet, 0, &errorCode);
+    unsigned int aliasCount = std::min(ALIAS_COUNT, completed_transactions_get_length(pCompletedTxs, &errorCode));
+    jobjectArray localAddresses = jEnv->NewObjectArray(static_cast<jsize>(aliasCount), jEnv->FindClass("[B"), nullptr);
+    std::vector<std::string> aliasNames;
+    for (unsigned int i = 0; i < aliasCount; i++) {
+        TariCompletedTransaction *pTx = completed_transactions_get_at(pCompletedTxs, i, &errorCode);
+        TariWalletAddress *pAddress = completed_transaction_is_outbound(pTx, &errorCode)
+                                      ? completed_transaction_get_destination_tari_address(pTx, &errorCode)
+                                      : completed_transaction_get_source_tari_address(pTx, &errorCode);
+        ByteVector *pBytes = tari_address_get_bytes(pAddress, &errorCode);
+        std::vector<uint8_t> bytes(byte_vector_get_length(pBytes, &errorCode));
+        for (unsigned int j = 0; j < bytes.size(); j++) {
+            bytes[j] = byte_vector_get_at(pBytes, j, &errorCode);
+        }
+        auto jBytes = static_cast<jbyteArray>(jEnv->NewByteArray(static_cast<jsize>(bytes.size())));
+        jEnv->SetByteArrayRegion(jBytes, 0, static_cast<jsize>(bytes.size()), reinterpret_cast<const jbyte *>(bytes.data()));
+        jEnv->SetObjectArrayElement(localAddresses, static_cast<jsize>(i), jBytes);
+        aliasNames.push_back("Contact " + std::to_string(i));
+        byte_vector_destroy(pBytes);
+        tari_address_destroy(pAddress);
+        completed_transaction_destroy(pTx);
+    }
+    completed_transactions_destroy(pCompletedTxs);
+    auto addresses = static_cast<jobjectArray>(jEnv->NewGlobalRef(localAddresses));
+    FakeJvm::get().releaseLocals();
+    AddCall<jboolean>("FFITxHistoryIndex_jniSetAliases", index, IGNORE_RESULT, addresses, NewGlobalStrings(aliasNames), error);
+
+    // both leave the index as they found it, a clear is followed by a sync and a close by an open
+    auto clear = FindEntryPoint<jboolean>("FFITxHistoryIndex_jniClear");
+    AddBenchmark("FFITxHistoryIndex_jniClear/resync", [=] {
+        clear(g_fixture.jEnv, index);
+        sync(g_fixture.jEnv, wallet, error);
+    });
+    auto open = FindEntryPoint<jboolean, jstring>("FFITxHistoryIndex_jniOpen");
+    auto close = FindEntryPoint<void>("FFITxHistoryIndex_jniClose");
+    jstring directory = FakeJvm::get().newGlobalString(g_fixture.directory);
+    AddBenchmark("FFITxHistoryIndex_jniClose/reopen", [=] {
+        close(g_fixture.jEnv, index);
+        open(g_fixture.jEnv, index, directory);
+    });
+}
+
+/**
+ * A column snapshot of the completed txs of the fixture wallet and the aggregations of a month of hourly buckets over
+ * it, the stub txs are a minute apart from STUB_TX_EPOCH on.
+ */
+static void AddTxColumnSnapshot() {
+    JNIEnv *jEnv = g_fixture.jEnv;
+    jobject wallet = g_fixture.wallet;
+    jobject error = g_fixture.error;
+    auto getSnapshot = FindEntryPoint<jlong, jobject>("FFIWallet_jniGetTxColumnSnapshot");
+    ResultDestroy destroySnapshot = JniDestroy("FFITxColumnSnapshot");
+    AddBenchmark("FFIWallet_jniGetTxColumnSnapshot", [=] {
+        destroySnapshot(getSnapshot(g_fixture.jEnv, wallet, error));
+    });
+
+    constexpr jlong STUB_TX_EPOCH = 1700000000;
+    constexpr jlong HOUR = 3600;
+    constexpr jsize BUCKET_COUNT = 24 * 30;
+    jobject snapshot = FakeJvm::get().newPointerObject(std::string(FFI_PACKAGE) + "FFITxColumnSnapshot",
+                                                       reinterpret_cast<void *>(getSnapshot(jEnv, wallet, error)));
+    auto counterpartyCount = FindEntryPoint<jint>("FFITxColumnSnapshot_jniGetCounterpartyCount")(jEnv, snapshot);
+    jsize totalsSize = std::max<jsize>(BUCKET_COUNT, counterpartyCount);
+    jlongArray sent = NewGlobalArray(&JNIEnv::NewLongArray, totalsSize);
+    jlongArray received = NewGlobalArray(&JNIEnv::NewLongArray, totalsSize);
+    jlongArray fees = NewGlobalArray(&JNIEnv::NewLongArray, totalsSize);
+    jintArray counts = NewGlobalArray(&JNIEnv::NewIntArray, totalsSize);
+    jlong from = STUB_TX_EPOCH;
+    jlong to = STUB_TX_EPOCH + BUCKET_COUNT * HOUR;
+    AddCall<jint>("FFITxColumnSnapshot_jniGetVolumes", snapshot, IGNORE_RESULT, from, to, HOUR, sent, received, fees, counts, error);
+    AddCall<jint>("FFITxColumnSnapshot_jniGetRunningBalances", snapshot, IGNORE_RESULT, from, to, HOUR, sent, error);
+    AddCall<jint>("FFITxColumnSnapshot_jniGetCounterpartyTotals", snapshot, IGNORE_RESULT, from, to, sent, received, fees, counts,
+                  error);
+    AddCall<jint>("FFITxColumnSnapshot_jniGetSize", snapshot, IGNORE_RESULT);
+    AddCall<jint>("FFITxColumnSnapshot_jniGetCounterpartyCount", snapshot, IGNORE_RESULT);
+    AddCall<jbyteArray>("FFITxColumnSnapshot_jniGetCounterparty", snapshot, IGNORE_RESULT, static_cast<jint>(counterpartyCount / 2));
+}
+
+/**
+ * Exports of the whole dataset to /dev/null, formatting and buffering without the storage.
+ */
+static void AddTxHistoryExport() {
+    constexpr jint FORMAT_CSV = 0;
+    constexpr jint FORMAT_JSON = 1;
+    jint fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    jobject listener = nullptr;
+    auto exportTxHistory = FindEntryPoint<jlong, jint, jint, jobject, jobject>("FFIWallet_jniExportTxHistory");
+    jobject wallet = g_fixture.wallet;
+    jobject error = g_fixture.error;
+    for (jint format : {FORMAT_CSV, FORMAT_JSON}) {
+        AddBenchmark(std::string("FFIWallet_jniExportTxHistory/") + (format == FORMAT_CSV ? "csv" : "json"), [=] {
+            exportTxHistory(g_fixture.jEnv, wallet, fd, format, listener, error);
+        });
+    }
+}
+
+static std::atomic<uint64_t> g_nextCallbackTxId(FIRST_CALLBACK_TX_ID);
+
+/**
+ * Fires one callback, the payload is created outside the allocation count.
+ */
+using CallbackFire = std::function<void(const WalletStubCallbacks &callbacks, uint64_t txId)>;
+
+static void AddCallback(const std::string &method, CallbackFire fire) {
+    benchmark::RegisterBenchmark(("Callback/" + method).c_str(), [method, fire](benchmark::State &state) {
+        const WalletStubCallbacks &callbacks = *g_fixture.pCallbacks;
+        uint64_t delivered = g_pCallbackRecorder->deliveries(method);
+        {
+            AllocationCounter counter(state, CALLBACK_BATCH_SIZE);
+            for (auto _ : state) {
+                for (int i = 0; i < CALLBACK_BATCH_SIZE; i++) {
+                    fire(callbacks, g_nextCallbackTxId.fetch_add(1));
+                }
+                delivered += CALLBACK_BATCH_SIZE;
+                if (!g_pCallbackRecorder->awaitDeliveries(method, delivered)) {
+                    state.SkipWithError("Timed out waiting for deliveries");
+                    break;
+                }
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * CALLBACK_BATCH_SIZE);
+    })->UseRealTime();
+}
+
+static TariCompletedTransaction *NewCompletedTx(uint64_t txId, int status) {
+    FakeJvmScope scope;
+    return wallet_stub_completed_transaction_create(txId, status, true);
+}
+
+static void AddCallbacks() {
+    AddCallback("onTxReceived", [](const WalletStubCallbacks &c, uint64_t txId) {
+        TariPendingInboundTransaction *pTx;
+        {
+            FakeJvmScope scope;
+            pTx = wallet_stub_pending_inbound_transaction_create(txId);
+        }
+        c.txReceived(c.context, pTx);
+    });
+    AddCallback("onTxReplyReceived", [](const WalletStubCallbacks &c, uint64_t txId) {
+        c.txReplyReceived(c.context, NewCompletedTx(txId, 1));
+    });
+    AddCallback("onTxFinalized", [](const WalletStubCallbacks &c, uint64_t txId) {
+        c.txFinalized(c.context, NewCompletedTx(txId, 2));
+    });
+    AddCallback("onTxBroadcast", [](const WalletStubCallbacks &c, uint64_t txId) {
+        c.txBroadcast(c.context, NewCompletedTx(txId, 0));
+    });
+    AddCallback("onTxMined", [](const WalletStubCallbacks &c, uint64_t txId) {
+        c.txMined(c.context, NewCompletedTx(txId, 6));
+    });
+    AddCallback("onTxMinedUnconfirmed", [](const WalletStubCallbacks &c, uint64_t txId) {
+        c.txMinedUnconfirmed(c.context, NewCompletedTx(txId, 5), 1);
+    });
+    AddCallback("onTxFauxConfirmed", [](const WalletStubCallbacks &c, uint64_t txId) {
+        c.txFauxConfirmed(c.context, NewCompletedTx(txId, 8));
+    });
+    AddCallback("onTxFauxUnconfirmed", [](const WalletStubCallbacks &c, uint64_t txId) {
+        c.txFauxUnconfirmed(c.context, NewCompletedTx(txId, 7), 1);
+    });
+    AddCallback("onDirectSendResult", [](const WalletStubCallbacks &c, uint64_t txId) {
+        TariTransactionSendStatus *pStatus;
+        {
+            FakeJvmScope scope;
+            pStatus = wallet_stub_transaction_send_status_create(1);
+        }
+        c.txDirectSendResult(c.context, txId, pStatus);
+    });
+    AddCallback("onTxCancelled", [](const WalletStubCallbacks &c, uint64_t txId) {
+        c.txCancellation(c.context, NewCompletedTx(txId, 9), 1);
+    });
+    AddCallback("onTXOValidationComplete", [](const WalletStubCallbacks &c, uint64_t txId) {
+        c.txoValidationComplete(c.context, txId, 0);
+    });
+    AddCallback("onContactLivenessDataUpdated", [](const WalletStubCallbacks &c, uint64_t) {
+        TariContactsLivenessData *pData;
+        {
+            FakeJvmScope scope;
+            pData = wallet_stub_liveness_data_create();
+        }
+        c.contactsLivenessDataUpdated(c.context, pData);
+    });
+    AddCallback("onBalanceUpdated", [](const WalletStubCallbacks &c, uint64_t txId) {
+        TariBalance *pBalance;
+        {
+            FakeJvmScope scope;
+            pBalance = wallet_stub_balance_create(txId, 1000, 2000, 0);
+        }
+        c.balanceUpdated(c.context, pBalance);
+    });
+    AddCallback("onTxValidationComplete", [](const WalletStubCallbacks &c, uint64_t txId) {
+        c.transactionValidationComplete(c.context, txId, 0);
+    });
+    AddCallback("onConnectivityStatus", [](const WalletStubCallbacks &c, uint64_t txId) {
+        c.connectivityStatus(c.context, txId % 3);
+    });
+    AddCallback("onWalletScannedHeight", [](const WalletStubCallbacks &c, uint64_t txId) {
+        c.walletScannedHeight(c.context, txId);
+    });
+    AddCallback("onBaseNodeStatus", [](const WalletStubCallbacks &c, uint64_t) {
+        TariBaseNodeState *pState;
+        {
+            FakeJvmScope scope;
+            pState = wallet_stub_base_node_state_create(STUB_TIP_HEIGHT);
+        }
+        c.baseNodeStatus(c.context, pState);
+    });
+    // a tx mined at the tip is tracked, the tip then moves back and forth so its count changes on every one
+    AddCallback("onConfirmationsChanged", [](const WalletStubCallbacks &c, uint64_t) {
+        static uint64_t tip = [&c] {
+            c.txMinedUnconfirmed(c.context, NewCompletedTx(5 * FIRST_CALLBACK_TX_ID, 5), 0);
+            return STUB_TIP_HEIGHT;
+        }();
+        tip = tip == STUB_TIP_HEIGHT ? STUB_TIP_HEIGHT + 1 : STUB_TIP_HEIGHT;
+        TariBaseNodeState *pState;
+        {
+            FakeJvmScope scope;
+            pState = wallet_stub_base_node_state_create(tip);
+        }
+        c.baseNodeStatus(c.context, pState);
+    });
+}
+
+/**
+ * Injection and arrival times of the events of a storm, keyed by the sequence number each event carries
+ * (WALLET_STUB_EVENTS_CALLBACK_STORM). Arrivals are recorded on the delivery thread.
+ */
+class CallbackStorm {
+public:
+    static int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // the generator's observer
+    static void onInjected(void *pStorm, unsigned long long sequence) {
+        auto &injectedAt = static_cast<CallbackStorm *>(pStorm)->injectedAt_;
+        if (sequence < injectedAt.size()) {
+            injectedAt[sequence].store(nowNanos(), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Called before the generator starts, arrivals outside a run are ignored.
+     */
+    void start(uint64_t eventCount) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        injectedAt_ = std::vector<std::atomic<int64_t>>(eventCount);
+        latencies_.clear();
+        latencies_.reserve(eventCount);
+        lastArrivalAt_ = 0;
+        running_ = true;
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+
+    void onArrival(const FakeJavaMethod &method, const std::vector<jobject> &arrays, const std::vector<jlong> &longs) {
+        int64_t arrivedAt = nowNanos();
+        uint64_t sequence;
+        if (!readSequence(method.name, arrays, longs, sequence)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_ || sequence >= injectedAt_.size()) {
+            return;
+        }
+        latencies_.push_back(arrivedAt - injectedAt_[sequence].load(std::memory_order_relaxed));
+        lastArrivalAt_ = arrivedAt;
+        arrivalCount_.store(latencies_.size(), std::memory_order_release);
+    }
+
+    /**
+     * @return false if they didn't all arrive, the wait ends once nothing arrived for the delivery timeout
+     */
+    bool awaitArrivals(uint64_t count) {
+        uint64_t arrived = arrivalCount_.load(std::memory_order_acquire);
+        auto deadline = std::chrono::steady_clock::now() + DELIVERY_TIMEOUT;
+        while (arrived < count) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            uint64_t now = arrivalCount_.load(std::memory_order_acquire);
+            if (now != arrived) {
+                arrived = now;
+                deadline = std::chrono::steady_clock::now() + DELIVERY_TIMEOUT;
+            } else if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Sorted delivery latencies and the time of the last arrival, once the run is stopped.
+     */
+    std::vector<int64_t> takeLatencies(int64_t &lastArrivalAt) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::sort(latencies_.begin(), latencies_.end());
+        lastArrivalAt = lastArrivalAt_;
+        arrivalCount_.store(0, std::memory_order_relaxed);
+        return std::move(latencies_);
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<std::atomic<int64_t>> injectedAt_;
+    std::vector<int64_t> latencies_;
+    int64_t lastArrivalAt_ = 0;
+    bool running_ = false;
+    std::atomic<uint64_t> arrivalCount_{0};
+
+    // the key of each storm callback, see WALLET_STUB_EVENT_TX_ID_BASE
+    static bool readSequence(const std::string &method, const std::vector<jobject> &arrays,
+                             const std::vector<jlong> &longs, uint64_t &sequence) {
+        int error = 0;
+        if (method == "onTxReceived") {
+            auto pTx = reinterpret_cast<TariPendingInboundTransaction *>(longs.at(0));
+            sequence = pending_inbound_transaction_get_transaction_id(pTx, &error) - WALLET_STUB_EVENT_TX_ID_BASE;
+        } else if (method == "onTxReplyReceived" || method == "onTxFinalized" || method == "onTxBroadcast" ||
+                   method == "onTxMined" || method == "onTxMinedUnconfirmed" || method == "onTxFauxConfirmed" ||
+                   method == "onTxFauxUnconfirmed" || method == "onTxCancelled") {
+            auto pTx = reinterpret_cast<TariCompletedTransaction *>(longs.at(0));
+            sequence = completed_transaction_get_transaction_id(pTx, &error) - WALLET_STUB_EVENT_TX_ID_BASE;
+        } else if (method == "onDirectSendResult") {
+            sequence = ReadUnsignedBytes(arrays.at(1)) - WALLET_STUB_EVENT_TX_ID_BASE;
+        } else if (method == "onTXOValidationComplete" || method == "onTxValidationComplete" ||
+                   method == "onConnectivityStatus" || method == "onWalletScannedHeight") {
+            sequence = ReadUnsignedBytes(arrays.at(1));
+        } else if (method == "onBalanceUpdated") {
+            sequence = balance_get_available(reinterpret_cast<TariBalance *>(longs.at(0)), &error);
+        } else if (method == "onBaseNodeStatus") {
+            auto pState = reinterpret_cast<TariBaseNodeState *>(longs.at(0));
+            sequence = basenode_state_get_height_of_the_longest_chain(pState, &error) - WALLET_STUB_TIP_HEIGHT;
+        } else {
+            return false;
+        }
+        return error == 0;
+    }
+};
+
+static CallbackStorm g_callbackStorm;
+
+static const int STORM_SECONDS = 1;
+
+static double Percentile(const std::vector<int64_t> &sorted, double percentile) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    auto index = static_cast<size_t>(percentile / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+    return static_cast<double>(sorted[index]);
+}
+
+static void AddCallbackStorm(unsigned int eventsPerSecond, unsigned int threadCount) {
+    std::string name = "CallbackStorm/rate:" + std::to_string(eventsPerSecond) + "/threads:" + std::to_string(threadCount);
+    benchmark::RegisterBenchmark(name.c_str(), [eventsPerSecond, threadCount](benchmark::State &state) {
+        static const auto clearDedup = FindEntryPoint<void>("FFICallbackDedup_jniClear");
+        uint64_t eventCount = static_cast<uint64_t>(eventsPerSecond) * STORM_SECONDS;
+        for (auto _ : state) {
+            // every storm starts its sequence numbers, and so its tx ids, from 0
+            clearDedup(g_fixture.jEnv, g_fixture.receiver("FFICallbackDedup"));
+            std::pair<jlong, jlong> countersBefore = DeliveryCounters();
+            uint64_t firedBefore = wallet_stub_get_fired_event_count(g_fixture.pWallet);
+            g_callbackStorm.start(eventCount);
+            WalletStubEvents events{WALLET_STUB_EVENTS_CALLBACK_STORM, threadCount, eventsPerSecond, 0, eventCount,
+                                    CallbackStorm::onInjected, &g_callbackStorm};
+            int64_t startedAt = CallbackStorm::nowNanos();
+            int error = 0;
+            if (!wallet_stub_start_events(g_fixture.pWallet, &events, &error)) {
+                state.SkipWithError(("Couldn't start the events, error " + std::to_string(error)).c_str());
+                break;
+            }
+            wallet_stub_stop_events(g_fixture.pWallet, true);
+            uint64_t fired = wallet_stub_get_fired_event_count(g_fixture.pWallet) - firedBefore;
+            g_callbackStorm.awaitArrivals(fired);
+            g_callbackStorm.stop();
+            int64_t lastArrivalAt;
+            std::vector<int64_t> latencies = g_callbackStorm.takeLatencies(lastArrivalAt);
+            std::pair<jlong, jlong> countersAfter = DeliveryCounters();
+
+            double seconds = static_cast<double>(std::max(lastArrivalAt, startedAt + 1) - startedAt) / 1e9;
+            state.SetIterationTime(seconds);
+            state.counters["events/s"] = static_cast<double>(latencies.size()) / seconds;
+            state.counters["p50_us"] = Percentile(latencies, 50) / 1e3;
+            state.counters["p99_us"] = Percentile(latencies, 99) / 1e3;
+            state.counters["p999_us"] = Percentile(latencies, 99.9) / 1e3;
+            state.counters["attaches"] = static_cast<double>(countersAfter.first - countersBefore.first);
+            state.counters["dropped"] = static_cast<double>(fired - latencies.size());
+            state.counters["native_dropped"] = static_cast<double>(countersAfter.second - countersBefore.second);
+        }
+    })->Iterations(1)->UseManualTime()->Unit(benchmark::kMillisecond);
+}
+
+/**
+ * 10 to 100k events/s from one to many threads, each for STORM_SECONDS.
+ */
+static void AddCallbackStorms() {
+    static const CallbackRecorder::ArrivalListener listener = [](const FakeJavaMethod &method,
+                                                                 const std::vector<jobject> &arrays,
+                                                                 const std::vector<jlong> &longs) {
+        g_callbackStorm.onArrival(method, arrays, longs);
+    };
+    g_pCallbackRecorder->setArrivalListener(&listener);
+    for (unsigned int eventsPerSecond : {10u, 1000u, 10000u, 100000u}) {
+        for (unsigned int threadCount : {1u, 4u, 16u}) {
+            AddCallbackStorm(eventsPerSecond, threadCount);
+        }
+    }
+}
+
+static void AddRecovery() {
+    FakeJvm &jvm = FakeJvm::get();
+    jstring callback = jvm.newGlobalString(RECOVERY_CALLBACK);
+    jstring signature = jvm.newGlobalString(RECOVERY_CALLBACK_SIGNATURE);
+    AddCall<jboolean>("FFIWallet_jniStartRecovery", g_fixture.wallet, IGNORE_RESULT, g_fixture.callbacks, callback, signature,
+                      g_fixture.error);
+    AddCallback(RECOVERY_CALLBACK, [](const WalletStubCallbacks &c, uint64_t txId) {
+        c.recoveryProgress(c.context, 3, txId, 2 * txId);
+    });
+}
+
+/**
+ * An async entry point, timed until the completion of its job is delivered.
+ */
+template <typename... A>
+static void AddAsync(const std::string &name, ResultDestroy resultDestroy, A... args) {
+    auto function = FindEntryPoint<jlong, A...>(name);
+    jobject wallet = g_fixture.wallet;
+    auto pResultDestroy = resultDestroy ? std::make_shared<ResultDestroy>(std::move(resultDestroy)) : nullptr;
+    AddBenchmark(name, [=] {
+        g_pCallbackRecorder->setJobResultDestroy(pResultDestroy.get());
+        uint64_t completed = g_pCallbackRecorder->deliveries("onJobCompleted");
+        function(g_fixture.jEnv, wallet, args...);
+        if (!g_pCallbackRecorder->awaitDeliveries("onJobCompleted", completed + 1)) {
+            g_deliveryTimedOut = true;
+        }
+    })->UseRealTime();
+}
+
+static void AddAsyncs() {
+    FakeJvm &jvm = FakeJvm::get();
+    jobjectArray commitments = NewGlobalStrings(UtxoCommitments(4));
+    jstring feePerGram = jvm.newGlobalString("5");
+    AddAsync("FFIWallet_jniJoinUtxosAsync", nullptr, commitments, feePerGram);
+    AddAsync("FFIWallet_jniSplitUtxosAsync", nullptr, commitments, jvm.newGlobalString("3"), feePerGram);
+    AddAsync("FFIWallet_jniSendTxAsync", nullptr, g_fixture.receiver("FFITariWalletAddress"), jvm.newGlobalString("100000"),
+             feePerGram, jvm.newGlobalString("benchmark payment"));
+    AddAsync("FFIWallet_jniStartRecoveryAsync", nullptr, g_fixture.callbacks, jvm.newGlobalString(RECOVERY_CALLBACK),
+             jvm.newGlobalString(RECOVERY_CALLBACK_SIGNATURE));
+    AddAsync("FFIWallet_jniImportExternalUtxoAsNonRewindableAsync", nullptr, g_fixture.receiver("FFITariUnblindedOutput"),
+             g_fixture.receiver("FFITariWalletAddress"), jvm.newGlobalString("imported"));
+    AddAsync("FFIWallet_jniGetAllUtxosAsync", NativeDestroy(destroy_tari_vector));
+}
+
+/**
+ * Only one wallet at a time gets the callbacks, so the fixture wallet is destroyed before the first creation
+ * and this runs after everything that needs it.
+ */
+static void AddWalletLifecycle() {
+    jobject wallet = FakeJvm::get().newGlobalObject(std::string(FFI_PACKAGE) + "FFIWallet");
+    auto destroy = FindEntryPoint<void>("FFIWallet_jniDestroy");
+    AddBenchmark("FFIWallet_jniCreate", [wallet, destroy] {
+        static const bool fixtureDestroyed = [destroy] {
+            destroy(g_fixture.jEnv, g_fixture.wallet);
+            g_fixture.pWallet = nullptr;
+            return true;
+        }();
+        (void) fixtureDestroyed;
+        CreateWallet(wallet);
+        destroy(g_fixture.jEnv, wallet);
+    });
+}
+
+int main(int argc, char **argv) {
+    SetUpFixture("jniBenchmark");
+    AddGetters();
+    AddCreates();
+    AddStringMarshalling();
+    AddSettings();
+    AddHandleScopes();
+    AddTxHistoryIndex();
+    AddTxColumnSnapshot();
+    AddTxHistoryExport();
+    AddCallbacks();
+    AddCallbackStorms();
+    AddRecovery();
+    AddAsyncs();
+    AddWalletLifecycle();
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
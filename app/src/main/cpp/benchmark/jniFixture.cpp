@@ -0,0 +1,632 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef JNI_FIXTURE_CPP
+#define JNI_FIXTURE_CPP
+
+#include <dlfcn.h>
+#include <jni.h>
+#include <walletStub.h>
+#include <atomic>
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "../host/fakeJni.cpp"
+
+/**
+ * What the host programs driving the JNI entry points of native-lib share: native-lib loaded from NATIVE_LIB_PATH and
+ * its entry points looked up by their mangled name, the way System.loadLibrary and the JVM bind them, and a stub
+ * wallet created through FFIWallet.jniCreate with the objects the entry points are called on.
+ */
+
+static const char *const FFI_PACKAGE = "com/tari/android/wallet/ffi/";
+static const char *const WALLET_CALLBACKS_CLASS = "com/tari/android/wallet/application/walletManager/WalletCallbacks";
+static const char *const STRING_CLASS = "java/lang/String";
+
+static const auto DELIVERY_TIMEOUT = std::chrono::seconds(10);
+static const uint64_t STUB_TIP_HEIGHT = WALLET_STUB_TIP_HEIGHT;
+
+template <typename R, typename... A>
+using EntryPoint = R (*)(JNIEnv *, jobject, A...);
+
+inline void *g_pNativeLib = nullptr;
+
+template <typename R, typename... A>
+inline EntryPoint<R, A...> FindEntryPoint(const std::string &name) {
+    std::string symbol = "Java_com_tari_android_wallet_ffi_" + name;
+    void *pSymbol = dlsym(g_pNativeLib, symbol.c_str());
+    if (pSymbol == nullptr) {
+        fprintf(stderr, "Missing entry point %s\n", symbol.c_str());
+        exit(1);
+    }
+    return reinterpret_cast<EntryPoint<R, A...>>(pSymbol);
+}
+
+/**
+ * The wallet, the objects the entry points are called on and the arguments they take, set up before the benchmarks run.
+ */
+struct Fixture {
+    JNIEnv *jEnv = nullptr;
+    jobject error = nullptr;
+    jobject callbacks = nullptr;
+    jobject commsConfig = nullptr;
+    jobject wallet = nullptr;
+    TariWallet *pWallet = nullptr;
+    const WalletStubCallbacks *pCallbacks = nullptr;
+    std::map<std::string, jobject> receivers;
+    std::string directory;
+
+    /**
+     * The object an entry point of the class is called on, a plain one for the classes without a native object.
+     */
+    jobject receiver(const std::string &className) {
+        jobject &receiver = receivers[className];
+        if (receiver == nullptr) {
+            receiver = FakeJvm::get().newGlobalObject(FFI_PACKAGE + className);
+        }
+        return receiver;
+    }
+
+    void addReceiver(const std::string &className, const void *pointer) {
+        receivers[className] = FakeJvm::get().newPointerObject(FFI_PACKAGE + className, pointer);
+    }
+};
+
+inline Fixture g_fixture;
+
+inline std::string ClassOf(const std::string &entryPoint) {
+    return entryPoint.substr(0, entryPoint.find('_'));
+}
+
+inline jbyteArray NewGlobalBytes(const std::vector<uint8_t> &bytes) {
+    JNIEnv *jEnv = g_fixture.jEnv;
+    auto size = static_cast<jsize>(bytes.size());
+    jbyteArray local = jEnv->NewByteArray(size);
+    jEnv->SetByteArrayRegion(local, 0, size, reinterpret_cast<const jbyte *>(bytes.data()));
+    auto global = static_cast<jbyteArray>(jEnv->NewGlobalRef(local));
+    jEnv->DeleteLocalRef(local);
+    return global;
+}
+
+inline jobjectArray NewGlobalStrings(const std::vector<std::string> &strings) {
+    JNIEnv *jEnv = g_fixture.jEnv;
+    jobjectArray local = jEnv->NewObjectArray(static_cast<jsize>(strings.size()), jEnv->FindClass(STRING_CLASS), nullptr);
+    for (size_t i = 0; i < strings.size(); i++) {
+        jEnv->SetObjectArrayElement(local, static_cast<jsize>(i), jEnv->NewStringUTF(strings[i].c_str()));
+    }
+    auto global = static_cast<jobjectArray>(jEnv->NewGlobalRef(local));
+    FakeJvm::get().releaseLocals();
+    return global;
+}
+
+template <typename A>
+inline A NewGlobalArray(A (JNIEnv::*newArray)(jsize), jsize length) {
+    JNIEnv *jEnv = g_fixture.jEnv;
+    A local = (jEnv->*newArray)(length);
+    auto global = static_cast<A>(jEnv->NewGlobalRef(local));
+    jEnv->DeleteLocalRef(local);
+    return global;
+}
+
+inline std::string TakeString(char *pString) {
+    std::string result = pString != nullptr ? pString : "";
+    string_destroy(pString);
+    return result;
+}
+
+/**
+ * The value of a byte array of getBytesFromUnsignedLongLong, like a tx id.
+ */
+inline uint64_t ReadUnsignedBytes(jobject array) {
+    uint64_t value = 0;
+    for (uint8_t byte : FakeJvm::getArrayData(static_cast<jarray>(array))) {
+        value = value << 8 | byte;
+    }
+    return value;
+}
+
+static const auto IGNORE_RESULT = [](auto...) {};
+
+using ResultDestroy = std::function<void(jlong)>;
+
+/**
+ * Destroys a returned native object through the jniDestroy of its class, called on an object of its own.
+ * Use it from one thread at a time.
+ */
+inline ResultDestroy JniDestroy(const std::string &className) {
+    auto destroy = FindEntryPoint<void>(className + "_jniDestroy");
+    jobject object = FakeJvm::get().newPointerObject(FFI_PACKAGE + className, nullptr);
+    JNIEnv *jEnv = FakeJvm::get().env();
+    jfieldID pointerField = jEnv->GetFieldID(jEnv->GetObjectClass(object), "pointer", "J");
+    return [destroy, object, pointerField](jlong pointer) {
+        JNIEnv *jEnv = FakeJvm::get().env();
+        jEnv->SetLongField(object, pointerField, pointer);
+        destroy(jEnv, object);
+    };
+}
+
+/**
+ * For the native objects without a jniDestroy.
+ */
+template <typename T>
+inline ResultDestroy NativeDestroy(void (*destroy)(T *)) {
+    return [destroy](jlong pointer) {
+        FakeJvmScope scope;
+        destroy(reinterpret_cast<T *>(pointer));
+    };
+}
+
+enum class ResultKind {
+    VOID,
+    BOOLEAN,
+    INT,
+    LONG,
+    OBJECT,
+};
+
+struct GetterCase {
+    const char *name;
+    ResultKind kind;
+    // FFI class of a returned native object, destroyed through its jniDestroy
+    const char *resultClass;
+};
+
+
+/**
+ * Entry points that take the error object only.
+ */
+static const GetterCase GETTERS[] = {
+        {"FFIBalance_jniGetAvailable", ResultKind::OBJECT, nullptr},
+        {"FFIBalance_jniGetIncoming", ResultKind::OBJECT, nullptr},
+        {"FFIBalance_jniGetOutgoing", ResultKind::OBJECT, nullptr},
+        {"FFIBalance_jniGetTimeLocked", ResultKind::OBJECT, nullptr},
+        {"FFIByteVector_jniGetLength", ResultKind::INT, nullptr},
+        {"FFIByteVector_jniGetBytes", ResultKind::OBJECT, nullptr},
+        {"FFIByteVector_jniGetHex", ResultKind::OBJECT, nullptr},
+        {"FFICommsConfig_jniGetLastVersion", ResultKind::OBJECT, nullptr},
+        {"FFICompletedTx_jniGetId", ResultKind::OBJECT, nullptr},
+        {"FFICompletedTx_jniGetDestinationPublicKey", ResultKind::LONG, "FFITariWalletAddress"},
+        {"FFICompletedTx_jniGetSourcePublicKey", ResultKind::LONG, "FFITariWalletAddress"},
+        {"FFICompletedTx_jniGetTransactionKernel", ResultKind::LONG, "FFICompletedTxKernel"},
+        {"FFICompletedTx_jniGetAmount", ResultKind::OBJECT, nullptr},
+        {"FFICompletedTx_jniGetFee", ResultKind::OBJECT, nullptr},
+        {"FFICompletedTx_jniGetTimestamp", ResultKind::OBJECT, nullptr},
+        {"FFICompletedTx_jniGetMinedTimestamp", ResultKind::OBJECT, nullptr},
+        {"FFICompletedTx_jniGetMinedHeight", ResultKind::OBJECT, nullptr},
+        {"FFICompletedTx_jniGetPaymentId", ResultKind::OBJECT, nullptr},
+        {"FFICompletedTx_jniGetPaymentIdBytes", ResultKind::LONG, "FFIByteVector"},
+        {"FFICompletedTx_jniGetPaymentIdUserBytes", ResultKind::LONG, "FFIByteVector"},
+        {"FFICompletedTx_jniGetStatus", ResultKind::INT, nullptr},
+        {"FFICompletedTx_jniIsOutbound", ResultKind::BOOLEAN, nullptr},
+        {"FFICompletedTx_jniGetCancellationReason", ResultKind::INT, nullptr},
+        {"FFICompletedTxKernel_jniGetExcess", ResultKind::OBJECT, nullptr},
+        {"FFICompletedTxKernel_jniGetExcessPublicNonce", ResultKind::OBJECT, nullptr},
+        {"FFICompletedTxKernel_jniGetExcessSignature", ResultKind::OBJECT, nullptr},
+        {"FFIContact_jniGetAlias", ResultKind::OBJECT, nullptr},
+        {"FFIContact_jniGetIsFavorite", ResultKind::BOOLEAN, nullptr},
+        {"FFIContact_jniGetTariWalletAddress", ResultKind::LONG, "FFITariWalletAddress"},
+        {"FFIEmojiSet_jniGetLength", ResultKind::INT, nullptr},
+        {"FFIPendingInboundTx_jniGetId", ResultKind::OBJECT, nullptr},
+        {"FFIPendingInboundTx_jniGetSourcePublicKey", ResultKind::LONG, "FFITariWalletAddress"},
+        {"FFIPendingInboundTx_jniGetAmount", ResultKind::OBJECT, nullptr},
+        {"FFIPendingInboundTx_jniGetPaymentId", ResultKind::OBJECT, nullptr},
+        {"FFIPendingInboundTx_jniGetPaymentIdBytes", ResultKind::LONG, "FFIByteVector"},
+        {"FFIPendingInboundTx_jniGetPaymentIdUserBytes", ResultKind::LONG, "FFIByteVector"},
+        {"FFIPendingInboundTx_jniGetTimestamp", ResultKind::OBJECT, nullptr},
+        {"FFIPendingInboundTx_jniGetStatus", ResultKind::INT, nullptr},
+        {"FFIPendingOutboundTx_jniGetId", ResultKind::OBJECT, nullptr},
+        {"FFIPendingOutboundTx_jniGetDestinationPublicKey", ResultKind::LONG, "FFITariWalletAddress"},
+        {"FFIPendingOutboundTx_jniGetAmount", ResultKind::OBJECT, nullptr},
+        {"FFIPendingOutboundTx_jniGetFee", ResultKind::OBJECT, nullptr},
+        {"FFIPendingOutboundTx_jniGetPaymentId", ResultKind::OBJECT, nullptr},
+        {"FFIPendingOutboundTx_jniGetPaymentIdBytes", ResultKind::LONG, "FFIByteVector"},
+        {"FFIPendingOutboundTx_jniGetPaymentIdUserBytes", ResultKind::LONG, "FFIByteVector"},
+        {"FFIPendingOutboundTx_jniGetTimestamp", ResultKind::OBJECT, nullptr},
+        {"FFIPendingOutboundTx_jniGetStatus", ResultKind::INT, nullptr},
+        {"FFIPrivateKey_jniGetBytes", ResultKind::LONG, "FFIByteVector"},
+        {"FFIPublicKey_jniGetBytes", ResultKind::LONG, "FFIByteVector"},
+        {"FFIPublicKey_jniGetEmojiId", ResultKind::OBJECT, nullptr},
+        {"FFISeedWords_jniGetLength", ResultKind::INT, nullptr},
+        {"FFISeedWords_jniGetAll", ResultKind::OBJECT, nullptr},
+        {"FFITariBaseNodeState_jniGetHeightOfLongestChain", ResultKind::OBJECT, nullptr},
+        {"FFIFeePerGramStat_jniGetOrder", ResultKind::OBJECT, nullptr},
+        {"FFIFeePerGramStat_jniGetMin", ResultKind::OBJECT, nullptr},
+        {"FFIFeePerGramStat_jniGetMax", ResultKind::OBJECT, nullptr},
+        {"FFIFeePerGramStat_jniGetAverage", ResultKind::OBJECT, nullptr},
+        {"FFITariUnblindedOutput_jniToJson", ResultKind::OBJECT, nullptr},
+        {"FFITariWalletAddress_jniGetEmojiId", ResultKind::OBJECT, nullptr},
+        {"FFITariWalletAddress_jniGetBytes", ResultKind::LONG, "FFIByteVector"},
+        {"FFITariWalletAddress_jniGetNetwork", ResultKind::INT, nullptr},
+        {"FFITariWalletAddress_jniGetFeatures", ResultKind::INT, nullptr},
+        {"FFITariWalletAddress_jniGetViewKey", ResultKind::LONG, "FFIPublicKey"},
+        {"FFITariWalletAddress_jniGetSpendKey", ResultKind::LONG, "FFIPublicKey"},
+        {"FFITariWalletAddress_jniGetChecksum", ResultKind::INT, nullptr},
+        {"FFITransactionSendStatus_jniTransactionSendStatusDecode", ResultKind::INT, nullptr},
+        {"FFIWallet_jniGetBalance", ResultKind::LONG, "FFIBalance"},
+        {"FFIWallet_jniGetWalletAddress", ResultKind::LONG, "FFITariWalletAddress"},
+        {"FFIWallet_jniGetContacts", ResultKind::LONG, "FFIContacts"},
+        {"FFIWallet_jniGetCompletedTxs", ResultKind::LONG, "FFICompletedTxs"},
+        {"FFIWallet_jniGetCancelledTxs", ResultKind::LONG, "FFICompletedTxs"},
+        {"FFIWallet_jniGetPendingOutboundTxs", ResultKind::LONG, "FFIPendingOutboundTxs"},
+        {"FFIWallet_jniGetPendingInboundTxs", ResultKind::LONG, "FFIPendingInboundTxs"},
+        {"FFIWallet_jniGetSeedWords", ResultKind::LONG, "FFISeedWords"},
+        {"FFIWallet_jniGetConfirmations", ResultKind::OBJECT, nullptr},
+        {"FFIWallet_jniWalletGetUnspentOutputs", ResultKind::LONG, "FFITariUnblindedOutputs"},
+        {"FFIWallet_jniGetBaseNodePeers", ResultKind::LONG, "FFIPublicKeys"},
+        {"FFIWallet_jniGetPrivateViewKey", ResultKind::LONG, "FFIPrivateKey"},
+        {"FFIWallet_jniStartTxValidation", ResultKind::OBJECT, nullptr},
+        {"FFIWallet_jniRestartTxBroadcast", ResultKind::OBJECT, nullptr},
+        {"FFIWallet_jniStartTXOValidation", ResultKind::OBJECT, nullptr},
+        {"FFIWallet_jniPowerModeNormal", ResultKind::VOID, nullptr},
+        {"FFIWallet_jniPowerModeLow", ResultKind::VOID, nullptr},
+};
+
+/**
+ * Entry points of collections, GetAt takes an index too.
+ */
+static const GetterCase COLLECTION_GETTERS[] = {
+        {"FFIContacts_jniGetLength", ResultKind::INT, nullptr},
+        {"FFIContacts_jniGetAt", ResultKind::LONG, "FFIContact"},
+        {"FFICompletedTxs_jniGetLength", ResultKind::INT, nullptr},
+        {"FFICompletedTxs_jniGetAt", ResultKind::LONG, "FFICompletedTx"},
+        {"FFIPendingInboundTxs_jniGetLength", ResultKind::INT, nullptr},
+        {"FFIPendingInboundTxs_jniGetAt", ResultKind::LONG, "FFIPendingInboundTx"},
+        {"FFIPendingOutboundTxs_jniGetLength", ResultKind::INT, nullptr},
+        {"FFIPendingOutboundTxs_jniGetAt", ResultKind::LONG, "FFIPendingOutboundTx"},
+        {"FFITariUnblindedOutputs_jniGetLength", ResultKind::INT, nullptr},
+        {"FFITariUnblindedOutputs_jniGetAt", ResultKind::LONG, "FFITariUnblindedOutput"},
+        // the records stay owned by their collection
+        {"FFITariPaymentRecords_jniGetLength", ResultKind::INT, nullptr},
+        {"FFITariPaymentRecords_jniGetAt", ResultKind::LONG, nullptr},
+        {"FFIPublicKeys_jniGetLength", ResultKind::INT, nullptr},
+        {"FFIPublicKeys_jniGetAt", ResultKind::LONG, "FFIPublicKey"},
+        {"FFIFeePerGramStats_jniFeePerGramStatsGetLength", ResultKind::INT, nullptr},
+        // the stats stay owned by their collection
+        {"FFIFeePerGramStats_jniGetAt", ResultKind::LONG, nullptr},
+        {"FFIByteVector_jniGetLength", ResultKind::INT, nullptr},
+        {"FFIByteVector_jniGetAt", ResultKind::INT, nullptr},
+        {"FFIEmojiSet_jniGetAt", ResultKind::LONG, "FFIByteVector"},
+        {"FFISeedWords_jniGetAt", ResultKind::OBJECT, nullptr},
+};
+
+/**
+ * Entry points that take nothing, mostly the native settings and stats.
+ */
+static const GetterCase PLAIN_GETTERS[] = {
+        {"FFICallbackDedup_jniIsEnabled", ResultKind::BOOLEAN, nullptr},
+        {"FFICallbackDedup_jniGetSuppressedCount", ResultKind::LONG, nullptr},
+        {"FFICallbackLanes_jniGetLaneStatsValues", ResultKind::OBJECT, nullptr},
+        {"FFICallbackSubscriptions_jniGetFilteredCount", ResultKind::LONG, nullptr},
+        {"FFIHandleScope_jniGetTypeNames", ResultKind::OBJECT, nullptr},
+        {"FFIHandleScope_jniGetTypeStatsValues", ResultKind::OBJECT, nullptr},
+        {"FFIHex_jniGetImplementationName", ResultKind::OBJECT, nullptr},
+        {"FFITrace_jniIsEnabled", ResultKind::BOOLEAN, nullptr},
+        {"FFITxLifecycle_jniGetSnapshot", ResultKind::OBJECT, nullptr},
+        {"FFIWallet_jniGetCallStatsNames", ResultKind::OBJECT, nullptr},
+        {"FFIWallet_jniGetDroppedCallbackCount", ResultKind::LONG, nullptr},
+        {"FFITariUtxo_jniLoadData", ResultKind::VOID, nullptr},
+        {"FFITariVector_jniLoadData", ResultKind::VOID, nullptr},
+        {"FFITariCoinPreview_jniLoadData", ResultKind::VOID, nullptr},
+        {"FFITariPaymentRecord_jniLoadData", ResultKind::VOID, nullptr},
+};
+
+/**
+ * Counts the deliveries of each callback method and destroys the native objects they pass, like WalletCallbacks.
+ */
+class CallbackRecorder {
+public:
+    explicit CallbackRecorder(const std::vector<std::string> &methods) {
+        for (const std::string &method : methods) {
+            deliveries_[method];
+        }
+        payloadDestroys_["onTxReceived"] = JniDestroy("FFIPendingInboundTx");
+        for (const char *method : {"onTxReplyReceived", "onTxFinalized", "onTxBroadcast", "onTxMined", "onTxMinedUnconfirmed",
+                                   "onTxFauxConfirmed", "onTxFauxUnconfirmed", "onTxCancelled"}) {
+            payloadDestroys_[method] = JniDestroy("FFICompletedTx");
+        }
+        payloadDestroys_["onDirectSendResult"] = JniDestroy("FFITransactionSendStatus");
+        payloadDestroys_["onContactLivenessDataUpdated"] = NativeDestroy(liveness_data_destroy);
+        payloadDestroys_["onBalanceUpdated"] = JniDestroy("FFIBalance");
+        payloadDestroys_["onBaseNodeStatus"] = NativeDestroy(basenode_state_destroy);
+    }
+
+    /**
+     * For the results of the jobs submitted next, null for jobs whose result isn't a native object.
+     */
+    void setJobResultDestroy(const ResultDestroy *pDestroy) {
+        pJobResultDestroy_.store(pDestroy);
+    }
+
+    using ArrivalListener = std::function<void(const FakeJavaMethod &method, const std::vector<jobject> &arrays,
+                                               const std::vector<jlong> &longs)>;
+
+    /**
+     * Sees the arguments of every callback before its payload is destroyed, null for none.
+     */
+    void setArrivalListener(const ArrivalListener *pListener) {
+        pArrivalListener_.store(pListener);
+    }
+
+    void onCallback(const FakeJavaMethod &method, va_list args) {
+        // the native object is the first long argument, the result in onJobCompleted(context, jobId, result, error)
+        std::vector<jobject> arrays;
+        std::vector<jlong> longs;
+        for (size_t i = 1; i < method.signature.size() && method.signature[i] != ')'; i++) {
+            char type = method.signature[i];
+            if (type == '[') {
+                i++;
+                arrays.push_back(va_arg(args, jobject));
+            } else if (type == 'J') {
+                longs.push_back(va_arg(args, jlong));
+            } else {
+                va_arg(args, jint);
+            }
+        }
+        const ArrivalListener *pListener = pArrivalListener_.load();
+        if (pListener != nullptr) {
+            (*pListener)(method, arrays, longs);
+        }
+        if (method.name == "onJobCompleted") {
+            const ResultDestroy *pDestroy = pJobResultDestroy_.load();
+            if (pDestroy != nullptr && longs.size() > 1 && longs[1] != 0) {
+                (*pDestroy)(longs[1]);
+            }
+        } else {
+            auto destroy = payloadDestroys_.find(method.name);
+            if (destroy != payloadDestroys_.end() && !longs.empty()) {
+                destroy->second(longs[0]);
+            }
+        }
+        auto deliveries = deliveries_.find(method.name);
+        if (deliveries != deliveries_.end()) {
+            deliveries->second.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    uint64_t deliveries(const std::string &method) {
+        return deliveries_.at(method).load(std::memory_order_acquire);
+    }
+
+    /**
+     * @return false if the method wasn't delivered that many times before the timeout
+     */
+    bool awaitDeliveries(const std::string &method, uint64_t count) {
+        std::atomic<uint64_t> &deliveries = deliveries_.at(method);
+        auto deadline = std::chrono::steady_clock::now() + DELIVERY_TIMEOUT;
+        while (deliveries.load(std::memory_order_acquire) < count) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+private:
+    std::unordered_map<std::string, std::atomic<uint64_t>> deliveries_;
+    std::unordered_map<std::string, ResultDestroy> payloadDestroys_;
+    std::atomic<const ResultDestroy *> pJobResultDestroy_{nullptr};
+    std::atomic<const ArrivalListener *> pArrivalListener_{nullptr};
+};
+
+static const std::vector<std::pair<std::string, std::string>> WALLET_CALLBACKS = {
+        {"onTxReceived", "([BJ)V"},
+        {"onTxReplyReceived", "([BJ)V"},
+        {"onTxFinalized", "([BJ)V"},
+        {"onTxBroadcast", "([BJ)V"},
+        {"onTxMined", "([BJ)V"},
+        {"onTxMinedUnconfirmed", "([BJ[B)V"},
+        {"onTxFauxConfirmed", "([BJ)V"},
+        {"onTxFauxUnconfirmed", "([BJ[B)V"},
+        {"onDirectSendResult", "([B[BJ)V"},
+        {"onTxCancelled", "([BJ[B)V"},
+        {"onTXOValidationComplete", "([B[B[B)V"},
+        {"onContactLivenessDataUpdated", "([BJ)V"},
+        {"onBalanceUpdated", "([BJ)V"},
+        {"onTxValidationComplete", "([B[B[B)V"},
+        {"onConnectivityStatus", "([B[B)V"},
+        {"onWalletScannedHeight", "([B[B)V"},
+        {"onBaseNodeStatus", "([BJ)V"},
+        {"onWalletCreateProgress", "([BII)V"},
+        {"onJobCompleted", "([BJJI)V"},
+        {"onConfirmationsChanged", "([B[J[J)V"},
+        {"onBatchSendCompleted", "([BJ[J[I)V"},
+};
+
+static const char *const RECOVERY_CALLBACK = "onWalletRecovery";
+static const char *const RECOVERY_CALLBACK_SIGNATURE = "([BI[B[B)V";
+
+inline CallbackRecorder *g_pCallbackRecorder = nullptr;
+
+using WalletCreate = EntryPoint<jlong, jint, jobject, jstring, jint, jint, jint, jstring, jstring, jobject, jstring, jboolean,
+                                jstring, jint, jobject,
+                                jstring, jstring, jstring, jstring, jstring, jstring, jstring, jstring,
+                                jstring, jstring, jstring, jstring, jstring, jstring, jstring, jstring,
+                                jstring, jstring, jstring, jstring, jstring, jstring, jstring, jstring,
+                                jstring, jstring, jstring, jstring, jstring, jstring, jstring, jstring,
+                                jstring, jstring, jstring, jstring, jstring, jstring, jstring, jstring,
+                                jstring, jstring,
+                                jboolean, jobject>;
+
+/**
+ * Creates the stub wallet through FFIWallet.jniCreate, the way FFIWallet does.
+ *
+ * @param commsConfig the fixture's for null
+ * @return the id of an async creation
+ */
+inline jlong CreateWallet(jobject wallet, jobject commsConfig = nullptr, jboolean createAsync = JNI_FALSE) {
+    static const std::vector<jstring> callbackStrings = [] {
+        std::vector<jstring> strings;
+        for (const auto &callback : WALLET_CALLBACKS) {
+            strings.push_back(FakeJvm::get().newGlobalString(callback.first));
+            strings.push_back(FakeJvm::get().newGlobalString(callback.second));
+        }
+        return strings;
+    }();
+    static const jstring logPath = FakeJvm::get().newGlobalString(g_fixture.directory + "/wallet.log");
+    static const jstring passphrase = FakeJvm::get().newGlobalString("passphrase");
+    static const jstring network = FakeJvm::get().newGlobalString("mainnet");
+    static const jstring dnsPeer = FakeJvm::get().newGlobalString("seeds.tari.com");
+    static const jstring httpBaseNode = FakeJvm::get().newGlobalString("https://rpc.tari.com");
+    static const auto create = reinterpret_cast<WalletCreate>(FindEntryPoint<jlong>("FFIWallet_jniCreate"));
+    const std::vector<jstring> &s = callbackStrings;
+    if (commsConfig == nullptr) {
+        commsConfig = g_fixture.commsConfig;
+    }
+    return create(g_fixture.jEnv, wallet, 1, commsConfig, logPath, 0, 0, 0, passphrase, network, nullptr, dnsPeer, JNI_FALSE,
+                  httpBaseNode, 0, g_fixture.callbacks,
+                  s[0], s[1], s[2], s[3], s[4], s[5], s[6], s[7],
+                  s[8], s[9], s[10], s[11], s[12], s[13], s[14], s[15],
+                  s[16], s[17], s[18], s[19], s[20], s[21], s[22], s[23],
+                  s[24], s[25], s[26], s[27], s[28], s[29], s[30], s[31],
+                  s[32], s[33], s[34], s[35], s[36], s[37], s[38], s[39],
+                  s[40], s[41],
+                  createAsync, g_fixture.error);
+}
+
+inline void SetUpFixture(const std::string &name) {
+    FakeJvm &jvm = FakeJvm::get();
+    g_pNativeLib = dlopen(NATIVE_LIB_PATH, RTLD_NOW);
+    if (g_pNativeLib == nullptr) {
+        fprintf(stderr, "Couldn't load %s: %s\n", NATIVE_LIB_PATH, dlerror());
+        exit(1);
+    }
+    auto onLoad = reinterpret_cast<jint (*)(JavaVM *, void *)>(dlsym(g_pNativeLib, "JNI_OnLoad"));
+    if (onLoad != nullptr) {
+        onLoad(jvm.vm(), nullptr);
+    }
+    g_fixture.jEnv = jvm.env();
+    std::string directory = "/tmp/" + name + "XXXXXX";
+    g_fixture.directory = mkdtemp(&directory[0]);
+    g_fixture.error = jvm.newGlobalObject(std::string(FFI_PACKAGE) + "FFIError");
+
+    std::vector<std::string> methods;
+    for (const auto &callback : WALLET_CALLBACKS) {
+        methods.push_back(callback.first);
+    }
+    methods.emplace_back(RECOVERY_CALLBACK);
+    g_pCallbackRecorder = new CallbackRecorder(methods);
+    jvm.setHandler(WALLET_CALLBACKS_CLASS, [](jobject, const FakeJavaMethod &method, va_list args) {
+        g_pCallbackRecorder->onCallback(method, args);
+    });
+    g_fixture.callbacks = jvm.newGlobalObject(WALLET_CALLBACKS_CLASS);
+
+    g_fixture.commsConfig = g_fixture.receiver("FFICommsConfig");
+    FindEntryPoint<void, jstring, jstring, jobject>("FFICommsConfig_jniCreate")(
+            g_fixture.jEnv, g_fixture.commsConfig, jvm.newGlobalString("wallet"), jvm.newGlobalString(g_fixture.directory),
+            g_fixture.error);
+    g_fixture.wallet = g_fixture.receiver("FFIWallet");
+    CreateWallet(g_fixture.wallet);
+    g_fixture.pWallet = reinterpret_cast<TariWallet *>(FakeJvm::getField(g_fixture.wallet, "pointer"));
+    g_fixture.pCallbacks = wallet_stub_get_callbacks(g_fixture.pWallet);
+    if (g_fixture.pWallet == nullptr || g_fixture.pCallbacks == nullptr) {
+        fprintf(stderr, "Couldn't create the wallet\n");
+        exit(1);
+    }
+
+    TariWallet *pWallet = g_fixture.pWallet;
+    int error = 0;
+    std::vector<uint8_t> keyBytes(32);
+    for (size_t i = 0; i < keyBytes.size(); i++) {
+        keyBytes[i] = static_cast<uint8_t>(i * 7 + 1);
+    }
+    g_fixture.addReceiver("FFIBalance", wallet_get_balance(pWallet, &error));
+    g_fixture.addReceiver("FFIByteVector", byte_vector_create(keyBytes.data(), static_cast<unsigned int>(keyBytes.size()), &error));
+    TariCompletedTransactions *pCompletedTxs = wallet_get_completed_transactions(pWallet, 0, &error);
+    TariCompletedTransaction *pCompletedTx = completed_transactions_get_at(pCompletedTxs, 0, &error);
+    g_fixture.addReceiver("FFICompletedTxs", pCompletedTxs);
+    g_fixture.addReceiver("FFICompletedTx", pCompletedTx);
+    g_fixture.addReceiver("FFICompletedTxKernel", completed_transaction_get_transaction_kernel(pCompletedTx, &error));
+    TariContacts *pContacts = wallet_get_contacts(pWallet, &error);
+    g_fixture.addReceiver("FFIContacts", pContacts);
+    g_fixture.addReceiver("FFIContact", contacts_get_at(pContacts, 0, &error));
+    TariPendingInboundTransactions *pInboundTxs = wallet_get_pending_inbound_transactions(pWallet, 0, &error);
+    g_fixture.addReceiver("FFIPendingInboundTxs", pInboundTxs);
+    g_fixture.addReceiver("FFIPendingInboundTx", pending_inbound_transactions_get_at(pInboundTxs, 0, &error));
+    TariPendingOutboundTransactions *pOutboundTxs = wallet_get_pending_outbound_transactions(pWallet, 0, &error);
+    g_fixture.addReceiver("FFIPendingOutboundTxs", pOutboundTxs);
+    g_fixture.addReceiver("FFIPendingOutboundTx", pending_outbound_transactions_get_at(pOutboundTxs, 0, &error));
+    g_fixture.addReceiver("FFIEmojiSet", get_emoji_set());
+    TariPrivateKey *pPrivateKey = private_key_generate();
+    g_fixture.addReceiver("FFIPrivateKey", pPrivateKey);
+    g_fixture.addReceiver("FFIPublicKey", public_key_from_private_key(pPrivateKey, &error));
+    g_fixture.addReceiver("FFIPublicKeys", wallet_get_seed_peers(pWallet, &error));
+    g_fixture.addReceiver("FFISeedWords", wallet_get_seed_words(pWallet, &error));
+    g_fixture.addReceiver("FFITariBaseNodeState", wallet_stub_base_node_state_create(STUB_TIP_HEIGHT));
+    TariFeePerGramStats *pFeePerGramStats = wallet_get_fee_per_gram_stats(pWallet, 3, &error);
+    g_fixture.addReceiver("FFIFeePerGramStats", pFeePerGramStats);
+    g_fixture.addReceiver("FFIFeePerGramStat", fee_per_gram_stats_get_at(pFeePerGramStats, 0, &error));
+    TariUnblindedOutputs *pOutputs = wallet_get_unspent_outputs(pWallet, &error);
+    g_fixture.addReceiver("FFITariUnblindedOutputs", pOutputs);
+    g_fixture.addReceiver("FFITariUnblindedOutput", unblinded_outputs_get_at(pOutputs, 0, &error));
+    g_fixture.addReceiver("FFITariWalletAddress", wallet_get_tari_one_sided_address(pWallet, &error));
+    g_fixture.addReceiver("FFITransactionSendStatus", wallet_stub_transaction_send_status_create(1));
+    TariVector *pUtxos = wallet_get_all_utxos(pWallet, &error);
+    g_fixture.addReceiver("FFITariVector", pUtxos);
+    g_fixture.addReceiver("FFITariUtxo", pUtxos->ptr);
+    uint64_t completedTxId = completed_transaction_get_transaction_id(pCompletedTx, &error);
+    TariPaymentRecords *pPaymentRecords = wallet_get_transaction_payrefs(pWallet, completedTxId, &error);
+    g_fixture.addReceiver("FFITariPaymentRecords", pPaymentRecords);
+    g_fixture.addReceiver("FFITariPaymentRecord", payment_records_get_at(pPaymentRecords, 0, &error));
+    TariVector *pCommitments = create_tari_vector(Text);
+    tari_vector_push_string(pCommitments, reinterpret_cast<TariUtxo *>(pUtxos->ptr)[0].commitment, &error);
+    g_fixture.addReceiver("FFITariCoinPreview", wallet_preview_coin_join(pWallet, pCommitments, 5, &error));
+    destroy_tari_vector(pCommitments);
+    if (error != 0) {
+        fprintf(stderr, "Couldn't set up the fixture, error %d\n", error);
+        exit(1);
+    }
+}
+
+/**
+ * Callback thread attaches and dropped deliveries of the library so far, see FFICallbackLanes.getDeliveryCounters
+ * and FFIWallet.getDroppedCallbackCount.
+ */
+inline std::pair<jlong, jlong> DeliveryCounters() {
+    static const auto getCounters = FindEntryPoint<jlongArray>("FFICallbackLanes_jniGetDeliveryCounters");
+    static const auto getGateDropped = FindEntryPoint<jlong>("FFIWallet_jniGetDroppedCallbackCount");
+    jlong counters[2];
+    g_fixture.jEnv->GetLongArrayRegion(getCounters(g_fixture.jEnv, g_fixture.receiver("FFICallbackLanes")), 0, 2, counters);
+    jlong gateDropped = getGateDropped(g_fixture.jEnv, g_fixture.wallet);
+    FakeJvm::get().releaseLocals();
+    return {counters[0], counters[1] + gateDropped};
+}
+
+#endif // JNI_FIXTURE_CPP
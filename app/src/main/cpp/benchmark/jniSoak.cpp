@@ -0,0 +1,723 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <fcntl.h>
+#include <jni.h>
+#include <signal.h>
+#include <unistd.h>
+#include <walletStub.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "jniFixture.cpp"
+
+#ifdef __SANITIZE_ADDRESS__
+#include <sanitizer/lsan_interface.h>
+#endif
+
+/**
+ * Soak test of the JNI entry points of native-lib, built for the host against the fake JVM and the stub
+ * libminotari_wallet_ffi like jniBenchmark. Worker threads call a randomised, weighted mix of what the app calls from
+ * its coroutines - balance polling, history refreshes, sends, key value reads and writes - on the one wallet, while
+ * the stub's event generator fires a steady trickle of tx callbacks at it.
+ *
+ * Every interval it prints the calls/s, the p50, p99, p99.9 and max latency and the errors of each op over the
+ * interval, the callbacks delivered and dropped and the resident memory, then the same over the whole run.
+ * Latencies climbing from one interval to the next point at lock contention, memory climbing at a leak. Configure the
+ * build with -DNATIVE_SANITIZER=thread or address to run it under ThreadSanitizer or AddressSanitizer.
+ *
+ * jniSoak [--duration=seconds] [--threads=count] [--interval=seconds] [--seed=number] [--event-rate=events/s]
+ *         [--mix=op:weight,...]
+ *
+ * A duration of 0 runs until interrupted. The txs of the send op are cancelled right away, so the cancelled txs of
+ * the stub wallet are the one thing that grows over a run. Exits with 1 if a call failed or a callback was dropped.
+ */
+
+struct SoakOptions {
+    long durationSeconds = 60;
+    unsigned int threadCount = 8;
+    long intervalSeconds = 10;
+    uint64_t seed = 1;
+    unsigned int eventsPerSecond = 100;
+    std::string mix;
+};
+
+/**
+ * Latencies in log-linear buckets, 16 to a power of two, so a histogram is the same size however long the soak runs
+ * and a percentile is at most 1/16 above the latency it stands for.
+ */
+class LatencyHistogram {
+public:
+    void record(uint64_t nanos) {
+        counts_[bucketOf(nanos)]++;
+        count_++;
+        max_ = std::max(max_, nanos);
+    }
+
+    void add(const LatencyHistogram &other) {
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            counts_[i] += other.counts_[i];
+        }
+        count_ += other.count_;
+        max_ = std::max(max_, other.max_);
+    }
+
+    void clear() {
+        counts_.fill(0);
+        count_ = 0;
+        max_ = 0;
+    }
+
+    uint64_t count() const {
+        return count_;
+    }
+
+    uint64_t max() const {
+        return max_;
+    }
+
+    uint64_t percentile(double percentile) const {
+        auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100 * static_cast<double>(count_))));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; i++) {
+            seen += counts_[i];
+            if (seen >= rank) {
+                return std::min(upperBoundOf(i), max_);
+            }
+        }
+        return max_;
+    }
+
+private:
+    static const int SUB_BUCKET_BITS = 4;
+    static const size_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const size_t BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    static size_t bucketOf(uint64_t nanos) {
+        if (nanos < SUB_BUCKET_COUNT) {
+            return nanos;
+        }
+        int exponent = 63 - __builtin_clzll(nanos);
+        size_t subBucket = (nanos >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+        return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + subBucket;
+    }
+
+    static uint64_t upperBoundOf(size_t bucket) {
+        if (bucket < SUB_BUCKET_COUNT) {
+            return bucket;
+        }
+        size_t exponent = bucket / SUB_BUCKET_COUNT + SUB_BUCKET_BITS - 1;
+        uint64_t subBucket = bucket % SUB_BUCKET_COUNT;
+        return ((SUB_BUCKET_COUNT + subBucket + 1) << (exponent - SUB_BUCKET_BITS)) - 1;
+    }
+
+    std::array<uint64_t, BUCKET_COUNT> counts_{};
+    uint64_t count_ = 0;
+    uint64_t max_ = 0;
+};
+
+struct OpStats {
+    LatencyHistogram latencies;
+    uint64_t errors = 0;
+
+    void add(const OpStats &other) {
+        latencies.add(other.latencies);
+        errors += other.errors;
+    }
+
+    void clear() {
+        latencies.clear();
+        errors = 0;
+    }
+};
+
+using SoakOp = std::function<void(JNIEnv *jEnv)>;
+
+/**
+ * A worker thread with the objects its ops are called with. The stats of its ops since the last report are taken
+ * under its mutex, it's only ever contended by the reporting thread.
+ */
+struct SoakWorker {
+    unsigned int index = 0;
+    std::mt19937_64 random;
+    jobject error = nullptr;
+    jfieldID errorCode = nullptr;
+    std::vector<jstring> keys;
+    jstring value = nullptr;
+    // deleted with the worker, so the sanitizers don't count them as leaks
+    std::vector<jobject> objects;
+    std::vector<SoakOp> ops;
+    std::vector<OpStats> stats;
+    std::mutex statsMutex;
+    std::thread thread;
+
+    jobject newObject(const std::string &className) {
+        objects.push_back(FakeJvm::get().newGlobalObject(FFI_PACKAGE + className));
+        return objects.back();
+    }
+
+    jstring newString(const std::string &utf8) {
+        objects.push_back(FakeJvm::get().newGlobalString(utf8));
+        return static_cast<jstring>(objects.back());
+    }
+
+    bool failed(JNIEnv *jEnv) const {
+        return jEnv->GetIntField(error, errorCode) != 0;
+    }
+
+    ~SoakWorker() {
+        for (jobject object : objects) {
+            FakeJvm::get().deleteGlobalRef(object);
+        }
+    }
+};
+
+/**
+ * A native object returned to a worker, held by an FFI object of the worker until it's destroyed through the
+ * jniDestroy of its class, like the Kotlin wrappers do.
+ */
+class NativeObject {
+public:
+    NativeObject(SoakWorker &worker, const std::string &className)
+            : destroy_(FindEntryPoint<void>(className + "_jniDestroy")), object_(worker.newObject(className)) {
+        JNIEnv *jEnv = g_fixture.jEnv;
+        pointerField_ = jEnv->GetFieldID(jEnv->GetObjectClass(object_), "pointer", "J");
+    }
+
+    jobject wrap(JNIEnv *jEnv, jlong pointer) const {
+        jEnv->SetLongField(object_, pointerField_, pointer);
+        return object_;
+    }
+
+    void destroy(JNIEnv *jEnv) const {
+        if (jEnv->GetLongField(object_, pointerField_) != 0) {
+            destroy_(jEnv, object_);
+        }
+    }
+
+private:
+    EntryPoint<void> destroy_;
+    jobject object_;
+    jfieldID pointerField_ = nullptr;
+};
+
+/**
+ * Gets a list from the wallet and reads every item of it, the way a history or contacts refresh of the app does.
+ */
+static SoakOp ListRefresh(SoakWorker &worker, const std::string &getter, const std::string &listClass,
+                          const std::string &itemClass, const std::vector<std::string> &itemGetters) {
+    auto getList = FindEntryPoint<jlong, jobject>(getter);
+    auto getLength = FindEntryPoint<jint, jobject>(listClass + "_jniGetLength");
+    auto getAt = FindEntryPoint<jlong, jint, jobject>(listClass + "_jniGetAt");
+    std::vector<EntryPoint<jobject, jobject>> readItem;
+    for (const std::string &itemGetter : itemGetters) {
+        readItem.push_back(FindEntryPoint<jobject, jobject>(itemClass + "_" + itemGetter));
+    }
+    NativeObject list(worker, listClass);
+    NativeObject item(worker, itemClass);
+    return [&worker, getList, getLength, getAt, readItem, list, item](JNIEnv *jEnv) {
+        jobject wallet = g_fixture.wallet;
+        jobject error = worker.error;
+        jobject items = list.wrap(jEnv, getList(jEnv, wallet, error));
+        if (worker.failed(jEnv)) {
+            return;
+        }
+        jint length = getLength(jEnv, items, error);
+        for (jint i = 0; i < length && !worker.failed(jEnv); i++) {
+            jobject pItem = item.wrap(jEnv, getAt(jEnv, items, i, error));
+            for (auto read : readItem) {
+                jEnv->DeleteLocalRef(read(jEnv, pItem, error));
+            }
+            item.destroy(jEnv);
+        }
+        list.destroy(jEnv);
+    };
+}
+
+struct SoakOpCase {
+    const char *name;
+    unsigned int weight;
+    // called on the main thread before the workers start
+    std::function<SoakOp(SoakWorker &worker)> create;
+};
+
+/**
+ * The mix by default, roughly what the wallet screens of the app call while they're open.
+ */
+static const SoakOpCase SOAK_OPS[] = {
+        {"balance", 30, [](SoakWorker &worker) -> SoakOp {
+            auto getBalance = FindEntryPoint<jlong, jobject>("FFIWallet_jniGetBalance");
+            std::vector<EntryPoint<jobject, jobject>> readBalance;
+            for (const char *getter : {"FFIBalance_jniGetAvailable", "FFIBalance_jniGetIncoming", "FFIBalance_jniGetOutgoing",
+                                       "FFIBalance_jniGetTimeLocked"}) {
+                readBalance.push_back(FindEntryPoint<jobject, jobject>(getter));
+            }
+            NativeObject balance(worker, "FFIBalance");
+            return [&worker, getBalance, readBalance, balance](JNIEnv *jEnv) {
+                jobject pBalance = balance.wrap(jEnv, getBalance(jEnv, g_fixture.wallet, worker.error));
+                if (!worker.failed(jEnv)) {
+                    for (auto read : readBalance) {
+                        jEnv->DeleteLocalRef(read(jEnv, pBalance, worker.error));
+                    }
+                    balance.destroy(jEnv);
+                }
+            };
+        }},
+        {"history", 10, [](SoakWorker &worker) -> SoakOp {
+            SoakOp completed = ListRefresh(worker, "FFIWallet_jniGetCompletedTxs", "FFICompletedTxs", "FFICompletedTx",
+                                           {"jniGetId", "jniGetAmount", "jniGetFee", "jniGetTimestamp", "jniGetPaymentId"});
+            SoakOp inbound = ListRefresh(worker, "FFIWallet_jniGetPendingInboundTxs", "FFIPendingInboundTxs", "FFIPendingInboundTx",
+                                         {"jniGetId", "jniGetAmount", "jniGetTimestamp", "jniGetPaymentId"});
+            SoakOp outbound = ListRefresh(worker, "FFIWallet_jniGetPendingOutboundTxs", "FFIPendingOutboundTxs", "FFIPendingOutboundTx",
+                                          {"jniGetId", "jniGetAmount", "jniGetFee", "jniGetTimestamp", "jniGetPaymentId"});
+            return [completed, inbound, outbound](JNIEnv *jEnv) {
+                completed(jEnv);
+                inbound(jEnv);
+                outbound(jEnv);
+            };
+        }},
+        {"contacts", 5, [](SoakWorker &worker) -> SoakOp {
+            return ListRefresh(worker, "FFIWallet_jniGetContacts", "FFIContacts", "FFIContact", {"jniGetAlias"});
+        }},
+        {"send", 2, [](SoakWorker &worker) -> SoakOp {
+            auto sendTx = FindEntryPoint<jbyteArray, jobject, jstring, jstring, jstring, jobject>("FFIWallet_jniSendTx");
+            auto cancelPendingTx = FindEntryPoint<jboolean, jstring, jobject>("FFIWallet_jniCancelPendingTx");
+            jobject destination = g_fixture.receiver("FFITariWalletAddress");
+            jstring amount = worker.newString("100000");
+            jstring feePerGram = worker.newString("5");
+            jstring paymentId = worker.newString("soak payment " + std::to_string(worker.index));
+            return [&worker, sendTx, cancelPendingTx, destination, amount, feePerGram, paymentId](JNIEnv *jEnv) {
+                jbyteArray txId = sendTx(jEnv, g_fixture.wallet, destination, amount, feePerGram, paymentId, worker.error);
+                if (!worker.failed(jEnv)) {
+                    jstring id = jEnv->NewStringUTF(std::to_string(ReadUnsignedBytes(txId)).c_str());
+                    cancelPendingTx(jEnv, g_fixture.wallet, id, worker.error);
+                }
+            };
+        }},
+        {"sendBatch", 1, [](SoakWorker &worker) -> SoakOp {
+            auto sendTxBatch = FindEntryPoint<jlong, jobjectArray, jlongArray, jlong, jobjectArray, jint, jlongArray, jintArray,
+                                              jobject>("FFIWallet_jniSendTxBatch");
+            auto cancelPendingTx = FindEntryPoint<jboolean, jstring, jobject>("FFIWallet_jniCancelPendingTx");
+            jobject destination = g_fixture.receiver("FFITariWalletAddress");
+            jstring paymentId = worker.newString("soak batch payment " + std::to_string(worker.index));
+            return [&worker, sendTxBatch, cancelPendingTx, destination, paymentId](JNIEnv *jEnv) {
+                const jsize count = 4;
+                jobjectArray destinations = jEnv->NewObjectArray(count, jEnv->GetObjectClass(destination), destination);
+                jobjectArray paymentIds = jEnv->NewObjectArray(count, jEnv->GetObjectClass(paymentId), paymentId);
+                jlong amounts[count] = {100000, 200000, 300000, 400000};
+                jlongArray jAmounts = jEnv->NewLongArray(count);
+                jEnv->SetLongArrayRegion(jAmounts, 0, count, amounts);
+                jlongArray jTxIds = jEnv->NewLongArray(count);
+                jintArray jErrorCodes = jEnv->NewIntArray(count);
+                sendTxBatch(jEnv, g_fixture.wallet, destinations, jAmounts, 5, paymentIds, 2, jTxIds, jErrorCodes, worker.error);
+                if (worker.failed(jEnv)) {
+                    return;
+                }
+                jlong txIds[count];
+                jEnv->GetLongArrayRegion(jTxIds, 0, count, txIds);
+                for (jlong txId : txIds) {
+                    if (txId != 0) {
+                        jstring id = jEnv->NewStringUTF(std::to_string(static_cast<uint64_t>(txId)).c_str());
+                        cancelPendingTx(jEnv, g_fixture.wallet, id, worker.error);
+                    }
+                }
+            };
+        }},
+        {"historyIndex", 5, [](SoakWorker &worker) -> SoakOp {
+            auto queryColumns = FindEntryPoint<jint, jlongArray, jbyteArray, jstring, jlongArray, jlongArray, jlongArray, jlongArray,
+                                               jintArray, jbyteArray, jobject>("FFITxHistoryIndex_jniQueryColumns");
+            auto count = FindEntryPoint<jlong, jlongArray, jbyteArray, jstring, jobject>("FFITxHistoryIndex_jniCount");
+            jobject index = g_fixture.receiver("FFITxHistoryIndex");
+            return [&worker, queryColumns, count, index](JNIEnv *jEnv) {
+                // newest first, the first page
+                const jsize pageSize = 20;
+                jlong filter[] = {0, 0, 0, -1, -1, -1, -1, 0, pageSize, 0};
+                jlongArray jFilter = jEnv->NewLongArray(10);
+                jEnv->SetLongArrayRegion(jFilter, 0, 10, filter);
+                queryColumns(jEnv, index, jFilter, nullptr, nullptr, jEnv->NewLongArray(pageSize), jEnv->NewLongArray(pageSize),
+                             jEnv->NewLongArray(pageSize), jEnv->NewLongArray(pageSize), jEnv->NewIntArray(pageSize),
+                             jEnv->NewByteArray(pageSize), worker.error);
+                if (!worker.failed(jEnv)) {
+                    count(jEnv, index, jFilter, nullptr, nullptr, worker.error);
+                }
+            };
+        }},
+        {"aggregations", 2, [](SoakWorker &worker) -> SoakOp {
+            auto getSnapshot = FindEntryPoint<jlong, jobject>("FFIWallet_jniGetTxColumnSnapshot");
+            auto getVolumes = FindEntryPoint<jint, jlong, jlong, jlong, jlongArray, jlongArray, jlongArray, jintArray, jobject>(
+                    "FFITxColumnSnapshot_jniGetVolumes");
+            auto getRunningBalances = FindEntryPoint<jint, jlong, jlong, jlong, jlongArray, jobject>(
+                    "FFITxColumnSnapshot_jniGetRunningBalances");
+            auto destroy = FindEntryPoint<void>("FFITxColumnSnapshot_jniDestroy");
+            jobject snapshot = worker.newObject("FFITxColumnSnapshot");
+            return [&worker, getSnapshot, getVolumes, getRunningBalances, destroy, snapshot](JNIEnv *jEnv) {
+                jlong pSnapshot = getSnapshot(jEnv, g_fixture.wallet, worker.error);
+                if (worker.failed(jEnv)) {
+                    return;
+                }
+                jEnv->SetLongField(snapshot, jEnv->GetFieldID(jEnv->GetObjectClass(snapshot), "pointer", "J"), pSnapshot);
+                // daily buckets over a month of the stub txs
+                const jsize days = 30;
+                const jlong from = 1700000000;
+                const jlong to = from + days * 86400;
+                jlongArray sent = jEnv->NewLongArray(days);
+                getVolumes(jEnv, snapshot, from, to, 86400, sent, jEnv->NewLongArray(days), jEnv->NewLongArray(days),
+                           jEnv->NewIntArray(days), worker.error);
+                if (!worker.failed(jEnv)) {
+                    getRunningBalances(jEnv, snapshot, from, to, 86400, sent, worker.error);
+                }
+                destroy(jEnv, snapshot);
+            };
+        }},
+        {"export", 1, [](SoakWorker &worker) -> SoakOp {
+            auto exportTxHistory = FindEntryPoint<jlong, jint, jint, jobject, jobject>("FFIWallet_jniExportTxHistory");
+            return [&worker, exportTxHistory](JNIEnv *jEnv) {
+                int fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+                exportTxHistory(jEnv, g_fixture.wallet, fd, static_cast<jint>(worker.random() % 2), nullptr, worker.error);
+                close(fd);
+            };
+        }},
+        {"keyValueWrite", 5, [](SoakWorker &worker) -> SoakOp {
+            auto setKeyValue = FindEntryPoint<jboolean, jstring, jstring, jobject>("FFIWallet_jniSetKeyValue");
+            return [&worker, setKeyValue](JNIEnv *jEnv) {
+                jstring key = worker.keys[worker.random() % worker.keys.size()];
+                setKeyValue(jEnv, g_fixture.wallet, key, worker.value, worker.error);
+            };
+        }},
+        {"keyValueRead", 10, [](SoakWorker &worker) -> SoakOp {
+            auto getKeyValue = FindEntryPoint<jstring, jstring, jobject>("FFIWallet_jniGetKeyValue");
+            return [&worker, getKeyValue](JNIEnv *jEnv) {
+                jstring key = worker.keys[worker.random() % worker.keys.size()];
+                getKeyValue(jEnv, g_fixture.wallet, key, worker.error);
+            };
+        }},
+        {"utxos", 5, [](SoakWorker &worker) -> SoakOp {
+            auto getUtxos = FindEntryPoint<jlong, jint, jint, jint, jlong, jobject>("FFIWallet_jniGetUtxos");
+            return [&worker, getUtxos](JNIEnv *jEnv) {
+                jlong pUtxos = getUtxos(jEnv, g_fixture.wallet, 0, 20, 0, 0, worker.error);
+                if (pUtxos != 0) {
+                    destroy_tari_vector(reinterpret_cast<TariVector *>(pUtxos));
+                }
+            };
+        }},
+        {"feeEstimate", 3, [](SoakWorker &worker) -> SoakOp {
+            auto estimateTxFee = FindEntryPoint<jbyteArray, jstring, jstring, jstring, jstring, jobject>("FFIWallet_jniEstimateTxFee");
+            jstring amount = worker.newString("100000");
+            jstring feePerGram = worker.newString("5");
+            jstring kernelCount = worker.newString("1");
+            jstring outputCount = worker.newString("2");
+            return [&worker, estimateTxFee, amount, feePerGram, kernelCount, outputCount](JNIEnv *jEnv) {
+                estimateTxFee(jEnv, g_fixture.wallet, amount, feePerGram, kernelCount, outputCount, worker.error);
+            };
+        }},
+        {"validation", 1, [](SoakWorker &worker) -> SoakOp {
+            auto startTxValidation = FindEntryPoint<jbyteArray, jobject>("FFIWallet_jniStartTxValidation");
+            auto startTxoValidation = FindEntryPoint<jbyteArray, jobject>("FFIWallet_jniStartTXOValidation");
+            return [&worker, startTxValidation, startTxoValidation](JNIEnv *jEnv) {
+                startTxValidation(jEnv, g_fixture.wallet, worker.error);
+                startTxoValidation(jEnv, g_fixture.wallet, worker.error);
+            };
+        }},
+        {"stats", 2, [](SoakWorker &) -> SoakOp {
+            auto getCallStats = FindEntryPoint<jobject, jint>("FFIWallet_jniGetCallStatsValues");
+            auto getLaneStats = FindEntryPoint<jobject>("FFICallbackLanes_jniGetLaneStatsValues");
+            jobject lanes = g_fixture.receiver("FFICallbackLanes");
+            return [getCallStats, getLaneStats, lanes](JNIEnv *jEnv) {
+                getCallStats(jEnv, g_fixture.wallet, 16);
+                getLaneStats(jEnv, lanes);
+            };
+        }},
+};
+
+static const size_t SOAK_OP_COUNT = sizeof(SOAK_OPS) / sizeof(SOAK_OPS[0]);
+
+static const unsigned int KEYS_PER_WORKER = 16;
+
+static std::atomic<bool> g_stopped(false);
+
+static void OnStopSignal(int) {
+    g_stopped = true;
+}
+
+static void RunWorker(SoakWorker &worker, const std::vector<unsigned int> &weights) {
+    FakeJvm &jvm = FakeJvm::get();
+    JNIEnv *jEnv = jvm.env();
+    std::discrete_distribution<size_t> pick(weights.begin(), weights.end());
+    while (!g_stopped.load(std::memory_order_relaxed)) {
+        size_t op = pick(worker.random);
+        auto start = std::chrono::steady_clock::now();
+        worker.ops[op](jEnv);
+        auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        bool failed = worker.failed(jEnv);
+        if (failed) {
+            jEnv->SetIntField(worker.error, worker.errorCode, 0);
+        }
+        jvm.releaseLocals();
+        std::lock_guard<std::mutex> lock(worker.statsMutex);
+        worker.stats[op].latencies.record(static_cast<uint64_t>(nanos));
+        worker.stats[op].errors += failed ? 1 : 0;
+    }
+}
+
+static uint64_t ResidentBytes() {
+    long pages = 0;
+    FILE *pFile = fopen("/proc/self/statm", "r");
+    if (pFile != nullptr) {
+        if (fscanf(pFile, "%*s %ld", &pages) != 1) {
+            pages = 0;
+        }
+        fclose(pFile);
+    }
+    return static_cast<uint64_t>(pages) * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+}
+
+static uint64_t DeliveredCallbackCount() {
+    uint64_t count = 0;
+    for (const auto &callback : WALLET_CALLBACKS) {
+        count += g_pCallbackRecorder->deliveries(callback.first);
+    }
+    return count;
+}
+
+/**
+ * Prints the stats of the ops taken over the last seconds up to elapsed seconds into the run, the ops with no calls
+ * are left out.
+ */
+static void PrintStats(const char *title, double elapsed, double seconds, const std::vector<OpStats> &stats) {
+    std::pair<jlong, jlong> counters = DeliveryCounters();
+    printf("%s at %.1fs over %.1fs, rss %.1f MiB, callbacks %llu delivered, %lld dropped, %lld attaches\n", title, elapsed, seconds,
+           static_cast<double>(ResidentBytes()) / (1024 * 1024), static_cast<unsigned long long>(DeliveredCallbackCount()),
+           static_cast<long long>(counters.second), static_cast<long long>(counters.first));
+    printf("  %-16s %12s %10s %10s %10s %10s %8s\n", "op", "calls/s", "p50 us", "p99 us", "p99.9 us", "max us", "errors");
+    for (size_t i = 0; i < SOAK_OP_COUNT; i++) {
+        const LatencyHistogram &latencies = stats[i].latencies;
+        if (latencies.count() == 0) {
+            continue;
+        }
+        printf("  %-16s %12.0f %10.1f %10.1f %10.1f %10.1f %8llu\n", SOAK_OPS[i].name,
+               static_cast<double>(latencies.count()) / seconds, latencies.percentile(50) / 1e3,
+               latencies.percentile(99) / 1e3, latencies.percentile(99.9) / 1e3, latencies.max() / 1e3,
+               static_cast<unsigned long long>(stats[i].errors));
+    }
+    fflush(stdout);
+}
+
+static bool ParseMix(const std::string &mix, std::vector<unsigned int> &weights) {
+    size_t start = 0;
+    while (start < mix.size()) {
+        size_t end = mix.find(',', start);
+        std::string entry = mix.substr(start, end == std::string::npos ? std::string::npos : end - start);
+        size_t colon = entry.find(':');
+        std::string name = entry.substr(0, colon);
+        auto op = std::find_if(std::begin(SOAK_OPS), std::end(SOAK_OPS), [&name](const SoakOpCase &op) { return name == op.name; });
+        if (colon == std::string::npos || op == std::end(SOAK_OPS)) {
+            fprintf(stderr, "Unknown op weight %s\n", entry.c_str());
+            return false;
+        }
+        weights[op - std::begin(SOAK_OPS)] = static_cast<unsigned int>(strtoul(entry.c_str() + colon + 1, nullptr, 10));
+        start = end == std::string::npos ? mix.size() : end + 1;
+    }
+    return true;
+}
+
+static bool ParseOptions(int argc, char **argv, SoakOptions &options) {
+    for (int i = 1; i < argc; i++) {
+        const char *pArg = argv[i];
+        const char *pValue = strchr(pArg, '=');
+        if (pValue == nullptr) {
+            fprintf(stderr, "Unknown argument %s\n", pArg);
+            return false;
+        }
+        std::string name(pArg, pValue - pArg);
+        pValue++;
+        if (name == "--duration") {
+            options.durationSeconds = strtol(pValue, nullptr, 10);
+        } else if (name == "--threads") {
+            options.threadCount = static_cast<unsigned int>(strtoul(pValue, nullptr, 10));
+        } else if (name == "--interval") {
+            options.intervalSeconds = strtol(pValue, nullptr, 10);
+        } else if (name == "--seed") {
+            options.seed = strtoull(pValue, nullptr, 10);
+        } else if (name == "--event-rate") {
+            options.eventsPerSecond = static_cast<unsigned int>(strtoul(pValue, nullptr, 10));
+        } else if (name == "--mix") {
+            options.mix = pValue;
+        } else {
+            fprintf(stderr, "Unknown argument %s\n", pArg);
+            return false;
+        }
+    }
+    if (options.threadCount == 0 || options.intervalSeconds <= 0 || options.durationSeconds < 0) {
+        fprintf(stderr, "Needs a thread, an interval and a duration that isn't negative\n");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Creates the ops of a worker, and its keys with a value each so the reads find them.
+ */
+static std::unique_ptr<SoakWorker> CreateWorker(unsigned int index, uint64_t seed) {
+    auto pWorker = std::make_unique<SoakWorker>();
+    SoakWorker &worker = *pWorker;
+    JNIEnv *jEnv = g_fixture.jEnv;
+    worker.index = index;
+    worker.random.seed(seed + index);
+    worker.error = worker.newObject("FFIError");
+    worker.errorCode = jEnv->GetFieldID(jEnv->GetObjectClass(worker.error), "code", "I");
+    worker.value = worker.newString("soak value " + std::to_string(index));
+    auto setKeyValue = FindEntryPoint<jboolean, jstring, jstring, jobject>("FFIWallet_jniSetKeyValue");
+    for (unsigned int i = 0; i < KEYS_PER_WORKER; i++) {
+        worker.keys.push_back(worker.newString("soak key " + std::to_string(index) + " " + std::to_string(i)));
+        setKeyValue(jEnv, g_fixture.wallet, worker.keys.back(), worker.value, worker.error);
+    }
+    for (const SoakOpCase &op : SOAK_OPS) {
+        worker.ops.push_back(op.create(worker));
+    }
+    worker.stats.resize(SOAK_OP_COUNT);
+    FakeJvm::get().releaseLocals();
+    return pWorker;
+}
+
+/**
+ * Moves the stats the workers took since the last call to interval and adds them to total.
+ */
+static void TakeStats(std::vector<std::unique_ptr<SoakWorker>> &workers, std::vector<OpStats> &interval,
+                      std::vector<OpStats> &total) {
+    for (OpStats &stats : interval) {
+        stats.clear();
+    }
+    for (auto &pWorker : workers) {
+        std::lock_guard<std::mutex> lock(pWorker->statsMutex);
+        for (size_t i = 0; i < SOAK_OP_COUNT; i++) {
+            interval[i].add(pWorker->stats[i]);
+            pWorker->stats[i].clear();
+        }
+    }
+    for (size_t i = 0; i < SOAK_OP_COUNT; i++) {
+        total[i].add(interval[i]);
+    }
+}
+
+int main(int argc, char **argv) {
+    SoakOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 1;
+    }
+    std::vector<unsigned int> weights;
+    for (const SoakOpCase &op : SOAK_OPS) {
+        weights.push_back(op.weight);
+    }
+    if (!ParseMix(options.mix, weights) || std::all_of(weights.begin(), weights.end(), [](unsigned int weight) { return weight == 0; })) {
+        fprintf(stderr, "Needs an op with a weight\n");
+        return 1;
+    }
+    std::vector<std::unique_ptr<SoakWorker>> workers;
+    {
+#ifdef __SANITIZE_ADDRESS__
+        // the fixture lives until the process exits, only what leaks while the ops run is reported
+        __lsan::ScopedDisabler disabler;
+#endif
+        SetUpFixture("jniSoak");
+        // the app syncs the history index once when the wallet starts, the callbacks and sends keep it up to date
+        FindEntryPoint<jboolean, jstring>("FFITxHistoryIndex_jniOpen")(
+                g_fixture.jEnv, g_fixture.receiver("FFITxHistoryIndex"), FakeJvm::get().newGlobalString(g_fixture.directory));
+        FindEntryPoint<jint, jobject>("FFIWallet_jniSyncTxHistoryIndex")(g_fixture.jEnv, g_fixture.wallet, g_fixture.error);
+        for (unsigned int i = 0; i < options.threadCount; i++) {
+            workers.push_back(CreateWorker(i, options.seed));
+        }
+    }
+    signal(SIGINT, OnStopSignal);
+    signal(SIGTERM, OnStopSignal);
+    int error = 0;
+    WalletStubEvents events = {WALLET_STUB_EVENTS_STEADY_TRICKLE, 1, options.eventsPerSecond, 0, 0, nullptr, nullptr};
+    if (options.eventsPerSecond > 0 && !wallet_stub_start_events(g_fixture.pWallet, &events, &error)) {
+        fprintf(stderr, "Couldn't start the events, error %d\n", error);
+        return 1;
+    }
+    printf("%u threads, %ld s intervals, seed %llu, %u events/s\n", options.threadCount, options.intervalSeconds,
+           static_cast<unsigned long long>(options.seed), options.eventsPerSecond);
+    for (auto &pWorker : workers) {
+        SoakWorker &worker = *pWorker;
+        worker.thread = std::thread([&worker, &weights] { RunWorker(worker, weights); });
+    }
+
+    std::vector<OpStats> interval(SOAK_OP_COUNT);
+    std::vector<OpStats> total(SOAK_OP_COUNT);
+    auto started = std::chrono::steady_clock::now();
+    auto deadline = options.durationSeconds > 0 ? started + std::chrono::seconds(options.durationSeconds)
+                                                : std::chrono::steady_clock::time_point::max();
+    auto intervalStarted = started;
+    while (!g_stopped.load()) {
+        auto intervalEnd = std::min(intervalStarted + std::chrono::seconds(options.intervalSeconds), deadline);
+        while (!g_stopped.load() && std::chrono::steady_clock::now() < intervalEnd) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        if (std::chrono::steady_clock::now() >= deadline) {
+            g_stopped = true;
+        }
+        if (g_stopped.load()) {
+            for (auto &pWorker : workers) {
+                pWorker->thread.join();
+            }
+        }
+        auto now = std::chrono::steady_clock::now();
+        TakeStats(workers, interval, total);
+        PrintStats("interval", std::chrono::duration<double>(now - started).count(),
+                   std::chrono::duration<double>(now - intervalStarted).count(), interval);
+        intervalStarted = now;
+    }
+    wallet_stub_stop_events(g_fixture.pWallet, false);
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    PrintStats("total", elapsed, elapsed, total);
+
+    uint64_t errorCount = 0;
+    for (const OpStats &stats : total) {
+        errorCount += stats.errors;
+    }
+    jlong droppedCount = DeliveryCounters().second;
+    workers.clear();
+    FindEntryPoint<void>("FFIWallet_jniDestroy")(g_fixture.jEnv, g_fixture.wallet);
+    return errorCount == 0 && droppedCount == 0 ? 0 : 1;
+}
@@ -0,0 +1,171 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include "jniFixture.cpp"
+
+#ifdef __SANITIZE_ADDRESS__
+#include <sanitizer/lsan_interface.h>
+#endif
+
+/**
+ * Only one wallet at a time gets the callbacks: whatever way a creation ends without a wallet, the next one isn't
+ * refused.
+ */
+class WalletCreateTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+#ifdef __SANITIZE_ADDRESS__
+        // the fixture lives until the process exits, only what the tests leak is reported
+        __lsan::ScopedDisabler disabler;
+#endif
+        SetUpFixture("walletCreateTest");
+        destroy_ = FindEntryPoint<void>("FFIWallet_jniDestroy");
+        cancelCreate_ = FindEntryPoint<jboolean, jlong>("FFIWallet_jniCancelCreate");
+        // the tests create wallets of their own
+        destroy_(g_fixture.jEnv, g_fixture.wallet);
+        g_fixture.pWallet = nullptr;
+    }
+
+    /**
+     * Objects of the FFI class, deleted again by TearDown.
+     */
+    jobject newObject(const std::string &className) {
+        jobject object = FakeJvm::get().newGlobalObject(FFI_PACKAGE + className);
+        objects_.push_back(object);
+        return object;
+    }
+
+    jobject newWallet() {
+        return newObject("FFIWallet");
+    }
+
+    void TearDown() override {
+        for (jobject object : objects_) {
+            g_fixture.jEnv->DeleteGlobalRef(object);
+        }
+        FakeJvm::get().releaseLocals();
+    }
+
+    /**
+     * @return the error code of the last call, reset for the next one the way runWithError does
+     */
+    static jint takeErrorCode() {
+        JNIEnv *jEnv = g_fixture.jEnv;
+        jclass errorClass = jEnv->GetObjectClass(g_fixture.error);
+        jfieldID codeField = jEnv->GetFieldID(errorClass, "code", "I");
+        jint code = jEnv->GetIntField(g_fixture.error, codeField);
+        jEnv->SetIntField(g_fixture.error, codeField, 0);
+        return code;
+    }
+
+    static void expectCreated(jobject wallet) {
+        CreateWallet(wallet);
+        EXPECT_EQ(0, takeErrorCode());
+        EXPECT_NE(0, FakeJvm::getField(wallet, "pointer"));
+    }
+
+    static EntryPoint<void> destroy_;
+    static EntryPoint<jboolean, jlong> cancelCreate_;
+
+private:
+    std::vector<jobject> objects_;
+};
+
+EntryPoint<void> WalletCreateTest::destroy_ = nullptr;
+EntryPoint<jboolean, jlong> WalletCreateTest::cancelCreate_ = nullptr;
+
+static const jint NATIVE_ERROR_WALLET_ALREADY_RUNNING = -1000;
+
+TEST_F(WalletCreateTest, SecondWalletIsRefusedUntilTheFirstIsDestroyed) {
+    jobject first = newWallet();
+    jobject second = newWallet();
+    expectCreated(first);
+
+    CreateWallet(second);
+    EXPECT_EQ(NATIVE_ERROR_WALLET_ALREADY_RUNNING, takeErrorCode());
+    EXPECT_EQ(0, FakeJvm::getField(second, "pointer"));
+
+    destroy_(g_fixture.jEnv, first);
+    expectCreated(second);
+    destroy_(g_fixture.jEnv, second);
+}
+
+TEST_F(WalletCreateTest, FailedCreationDoesNotBlockTheNextOne) {
+    // the stub fails wallet_create without a comms config
+    jobject emptyConfig = newObject("FFICommsConfig");
+    jobject wallet = newWallet();
+    CreateWallet(wallet, emptyConfig);
+    EXPECT_NE(0, takeErrorCode());
+    EXPECT_EQ(0, FakeJvm::getField(wallet, "pointer"));
+
+    expectCreated(wallet);
+    destroy_(g_fixture.jEnv, wallet);
+}
+
+TEST_F(WalletCreateTest, FailedAsyncCreationDoesNotBlockTheNextOne) {
+    jobject emptyConfig = newObject("FFICommsConfig");
+    jobject wallet = newWallet();
+    uint64_t progressBefore = g_pCallbackRecorder->deliveries("onWalletCreateProgress");
+    CreateWallet(wallet, emptyConfig, JNI_TRUE);
+    EXPECT_EQ(0, takeErrorCode());
+    // config parsed, then failed
+    ASSERT_TRUE(g_pCallbackRecorder->awaitDeliveries("onWalletCreateProgress", progressBefore + 2));
+
+    expectCreated(wallet);
+    destroy_(g_fixture.jEnv, wallet);
+}
+
+TEST_F(WalletCreateTest, CancelledCreationDoesNotBlockTheNextOne) {
+    jobject cancelled = newWallet();
+    jlong creationId = CreateWallet(cancelled, nullptr, JNI_TRUE);
+    EXPECT_EQ(0, takeErrorCode());
+    if (!cancelCreate_(g_fixture.jEnv, cancelled, creationId)) {
+        // already created
+        destroy_(g_fixture.jEnv, cancelled);
+    }
+
+    jobject next = newWallet();
+    expectCreated(next);
+    destroy_(g_fixture.jEnv, next);
+}
+
+TEST_F(WalletCreateTest, WalletDestroyedWhileCreatingDoesNotBlockTheNextOne) {
+    jobject destroyed = newWallet();
+    CreateWallet(destroyed, nullptr, JNI_TRUE);
+    EXPECT_EQ(0, takeErrorCode());
+    destroy_(g_fixture.jEnv, destroyed);
+
+    jobject next = newWallet();
+    expectCreated(next);
+    destroy_(g_fixture.jEnv, next);
+}
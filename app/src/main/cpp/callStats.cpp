@@ -0,0 +1,218 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CALL_STATS_CPP
+#define CALL_STATS_CPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Latency statistics per native entry point: call count, total time, max time and a log-linear histogram.
+ *
+ * The histogram works like HdrHistogram with 3 significant bits: every power of two range of microseconds is split
+ * into 8 equal buckets, so a recorded value is off by at most 12.5%. Values from 0 up to about an hour fit.
+ * Everything is updated with relaxed atomics, recording never locks.
+ */
+
+constexpr int CALL_STATS_SUB_BUCKET_BITS = 3;
+constexpr int CALL_STATS_SUB_BUCKETS = 1 << CALL_STATS_SUB_BUCKET_BITS;
+constexpr int CALL_STATS_MAX_VALUE_BITS = 32;
+constexpr int CALL_STATS_BUCKETS = (CALL_STATS_MAX_VALUE_BITS - CALL_STATS_SUB_BUCKET_BITS + 1) * CALL_STATS_SUB_BUCKETS;
+
+inline int CallStatsBucket(uint64_t micros) {
+    if (micros >= (uint64_t(1) << CALL_STATS_MAX_VALUE_BITS)) {
+        return CALL_STATS_BUCKETS - 1;
+    }
+    if (micros < CALL_STATS_SUB_BUCKETS) {
+        return static_cast<int>(micros);
+    }
+    int msb = 63 - __builtin_clzll(micros);
+    int group = msb - CALL_STATS_SUB_BUCKET_BITS + 1;
+    int subBucket = static_cast<int>(micros >> (msb - CALL_STATS_SUB_BUCKET_BITS)) - CALL_STATS_SUB_BUCKETS;
+    return group * CALL_STATS_SUB_BUCKETS + subBucket;
+}
+
+// highest value that falls into the bucket
+inline uint64_t CallStatsBucketUpperBound(int bucket) {
+    int group = bucket / CALL_STATS_SUB_BUCKETS;
+    uint64_t subBucket = static_cast<uint64_t>(bucket % CALL_STATS_SUB_BUCKETS);
+    if (group == 0) {
+        return subBucket;
+    }
+    int shift = group - 1;
+    return ((CALL_STATS_SUB_BUCKETS + subBucket + 1) << shift) - 1;
+}
+
+class CallStats {
+public:
+    explicit CallStats(const char *name) : name(name) {
+        reset();
+    }
+
+    void record(int64_t nanos) {
+        auto value = static_cast<uint64_t>(nanos < 0 ? 0 : nanos);
+        count.fetch_add(1, std::memory_order_relaxed);
+        totalNanos.fetch_add(value, std::memory_order_relaxed);
+        uint64_t currentMax = maxNanos.load(std::memory_order_relaxed);
+        while (value > currentMax && !maxNanos.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) {}
+        buckets[CallStatsBucket(value / 1000)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void reset() {
+        count.store(0, std::memory_order_relaxed);
+        totalNanos.store(0, std::memory_order_relaxed);
+        maxNanos.store(0, std::memory_order_relaxed);
+        for (auto &bucket : buckets) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t getCount() const {
+        return count.load(std::memory_order_relaxed);
+    }
+
+    uint64_t getTotalNanos() const {
+        return totalNanos.load(std::memory_order_relaxed);
+    }
+
+    uint64_t getMaxNanos() const {
+        return maxNanos.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @param percentiles ascending, between 0 and 100
+     * @return upper bound in nanoseconds of the bucket holding each percentile, 0 if nothing was recorded
+     */
+    std::vector<uint64_t> getPercentileNanos(const std::vector<double> &percentiles) const {
+        std::vector<uint64_t> counts(CALL_STATS_BUCKETS);
+        uint64_t total = 0;
+        for (int i = 0; i < CALL_STATS_BUCKETS; i++) {
+            counts[i] = buckets[i].load(std::memory_order_relaxed);
+            total += counts[i];
+        }
+        std::vector<uint64_t> result(percentiles.size(), 0);
+        uint64_t max = getMaxNanos();
+        uint64_t seen = 0;
+        size_t next = 0;
+        for (int i = 0; i < CALL_STATS_BUCKETS && next < percentiles.size() && total > 0; i++) {
+            seen += counts[i];
+            while (next < percentiles.size() && static_cast<double>(seen) >= percentiles[next] / 100.0 * static_cast<double>(total)) {
+                result[next++] = std::min((CallStatsBucketUpperBound(i) + 1) * 1000, max);
+            }
+        }
+        return result;
+    }
+
+    const char *const name;
+
+private:
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> totalNanos;
+    std::atomic<uint64_t> maxNanos;
+    std::atomic<uint32_t> buckets[CALL_STATS_BUCKETS];
+};
+
+/**
+ * All entry points that were called at least once, in order of their first call. Entries are never removed,
+ * so an index into all() stays valid.
+ */
+class CallStatsRegistry {
+public:
+    CallStats *create(const char *name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.emplace_back(new CallStats(name));
+        return stats.back().get();
+    }
+
+    std::vector<CallStats *> all() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<CallStats *> result;
+        result.reserve(stats.size());
+        for (auto &item : stats) {
+            result.push_back(item.get());
+        }
+        return result;
+    }
+
+    void reset() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto &item : stats) {
+            item->reset();
+        }
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<std::unique_ptr<CallStats>> stats;
+};
+
+inline CallStatsRegistry &GetCallStatsRegistry() {
+    static CallStatsRegistry registry;
+    return registry;
+}
+
+/**
+ * Records the lifetime of the scope into the stats.
+ */
+class CallStatsScope {
+public:
+    explicit CallStatsScope(CallStats *pStats) : pStats(pStats), start(std::chrono::steady_clock::now()) {}
+
+    ~CallStatsScope() {
+        pStats->record(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    CallStatsScope(const CallStatsScope &) = delete;
+
+    CallStatsScope &operator=(const CallStatsScope &) = delete;
+
+private:
+    CallStats *const pStats;
+    const std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Every expansion owns a static stats slot, so the lookup happens once per entry point and not once per call.
+ */
+#define CALL_STATS_ENTRY() \
+    static CallStats *const pCallStats = GetCallStatsRegistry().create(__func__); \
+    CallStatsScope callStatsScope(pCallStats)
+
+#endif // CALL_STATS_CPP
@@ -0,0 +1,146 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef CALLBACK_DEDUP_CPP
+#define CALLBACK_DEDUP_CPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// 16 bytes per slot, the table stays at 64 KiB however many txs the wallet has
+constexpr size_t CALLBACK_DEDUP_SLOTS = 4096;
+
+/**
+ * Last state delivered per tx id, the callback type and its detail (confirmations or rejection reason). A tx callback
+ * with exactly the state that was last delivered for the tx is a duplicate and isn't delivered again.
+ *
+ * Tx ids are hashed into a fixed number of slots and a tx takes over the slot of any tx it collides with. An evicted
+ * tx can then get a duplicate through, but a callback that changes the state is never suppressed.
+ */
+class CallbackDedup {
+public:
+    bool isEnabled() const {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * While disabled every callback is delivered and nothing is recorded.
+     */
+    void setEnabled(bool enabled) {
+        if (!enabled) {
+            clear();
+        }
+        enabled_.store(enabled, std::memory_order_relaxed);
+    }
+
+    /**
+     * Records the state as delivered, the caller takes it back with forget if the delivery is dropped.
+     *
+     * @return false if it's the state that was last delivered for the tx
+     */
+    bool isNewState(uint64_t txId, int callbackType, uint64_t detail) {
+        if (!isEnabled()) {
+            return true;
+        }
+        uint64_t state = packState(callbackType, detail);
+        Slot &slot = slots_[slotOf(txId)];
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (slot.state == state && slot.txId == txId) {
+            suppressedCount_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        slot.txId = txId;
+        slot.state = state;
+        return true;
+    }
+
+    /**
+     * Takes back a state recorded by isNewState whose callback was dropped before it reached Java, so its next repeat
+     * is delivered. A state recorded for the tx since is kept.
+     */
+    void forget(uint64_t txId, int callbackType, uint64_t detail) {
+        if (!isEnabled()) {
+            return;
+        }
+        uint64_t state = packState(callbackType, detail);
+        Slot &slot = slots_[slotOf(txId)];
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (slot.state == state && slot.txId == txId) {
+            slot = Slot();
+        }
+    }
+
+    /**
+     * Forgets the delivered states, the next callback of every tx is delivered.
+     */
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (Slot &slot : slots_) {
+            slot = Slot();
+        }
+    }
+
+    uint64_t suppressedCount() const {
+        return suppressedCount_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Slot {
+        uint64_t txId = 0;
+        // 0 while the slot is empty
+        uint64_t state = 0;
+    };
+
+    std::mutex mutex_;
+    Slot slots_[CALLBACK_DEDUP_SLOTS];
+    std::atomic<bool> enabled_{true};
+    std::atomic<uint64_t> suppressedCount_{0};
+
+    // the top bit marks the slot as used, the type takes the next 7 bits and the detail the rest
+    static uint64_t packState(int callbackType, uint64_t detail) {
+        return (uint64_t(1) << 63) | (static_cast<uint64_t>(callbackType & 0x7F) << 56) | (detail & ((uint64_t(1) << 56) - 1));
+    }
+
+    static size_t slotOf(uint64_t txId) {
+        // tx ids are random but don't rely on it, spread all bits over the slot index
+        uint64_t hash = (txId ^ (txId >> 32)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(hash >> 52) & (CALLBACK_DEDUP_SLOTS - 1);
+    }
+};
+
+inline CallbackDedup &GetCallbackDedup() {
+    static CallbackDedup dedup;
+    return dedup;
+}
+
+#endif // CALLBACK_DEDUP_CPP
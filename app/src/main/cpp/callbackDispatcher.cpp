@@ -0,0 +1,231 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef CALLBACK_DISPATCHER_CPP
+#define CALLBACK_DISPATCHER_CPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "callStats.cpp"
+
+/**
+ * Wallet callbacks are queued into priority lanes and delivered from a single thread, always from the highest
+ * lane that has something queued. Within a lane the order of the callbacks is kept.
+ */
+constexpr int CALLBACK_LANE_HIGH = 0;
+constexpr int CALLBACK_LANE_NORMAL = 1;
+constexpr int CALLBACK_LANE_LOW = 2;
+constexpr int CALLBACK_LANE_COUNT = 3;
+
+/**
+ * Callback types, the lane of each one can be changed at runtime. The tx callbacks share a lane by default,
+ * moving only some of them to another lane can reorder the status updates of a tx.
+ */
+constexpr int CALLBACK_TYPE_TX_RECEIVED = 0;
+constexpr int CALLBACK_TYPE_TX_REPLY_RECEIVED = 1;
+constexpr int CALLBACK_TYPE_TX_FINALIZED = 2;
+constexpr int CALLBACK_TYPE_TX_BROADCAST = 3;
+constexpr int CALLBACK_TYPE_TX_MINED = 4;
+constexpr int CALLBACK_TYPE_TX_MINED_UNCONFIRMED = 5;
+constexpr int CALLBACK_TYPE_TX_FAUX_CONFIRMED = 6;
+constexpr int CALLBACK_TYPE_TX_FAUX_UNCONFIRMED = 7;
+constexpr int CALLBACK_TYPE_DIRECT_SEND_RESULT = 8;
+constexpr int CALLBACK_TYPE_TX_CANCELLED = 9;
+constexpr int CALLBACK_TYPE_TXO_VALIDATION_COMPLETE = 10;
+constexpr int CALLBACK_TYPE_CONTACTS_LIVENESS_DATA_UPDATED = 11;
+constexpr int CALLBACK_TYPE_BALANCE_UPDATED = 12;
+constexpr int CALLBACK_TYPE_TX_VALIDATION_COMPLETE = 13;
+constexpr int CALLBACK_TYPE_CONNECTIVITY_STATUS = 14;
+constexpr int CALLBACK_TYPE_WALLET_SCANNED_HEIGHT = 15;
+constexpr int CALLBACK_TYPE_BASE_NODE_STATUS = 16;
+constexpr int CALLBACK_TYPE_RECOVERY_PROGRESS = 17;
+constexpr int CALLBACK_TYPE_CONFIRMATIONS_CHANGED = 18;
+constexpr int CALLBACK_TYPE_BATCH_SEND_COMPLETED = 19;
+constexpr int CALLBACK_TYPE_COUNT = 20;
+
+inline std::atomic<int> g_callbackLanes[CALLBACK_TYPE_COUNT] = {
+        CALLBACK_LANE_HIGH,
+        CALLBACK_LANE_HIGH,
+        CALLBACK_LANE_HIGH,
+        CALLBACK_LANE_HIGH,
+        CALLBACK_LANE_HIGH,
+        CALLBACK_LANE_HIGH,
+        CALLBACK_LANE_HIGH,
+        CALLBACK_LANE_HIGH,
+        CALLBACK_LANE_HIGH,
+        CALLBACK_LANE_HIGH,
+        CALLBACK_LANE_NORMAL,
+        CALLBACK_LANE_LOW,
+        CALLBACK_LANE_NORMAL,
+        CALLBACK_LANE_NORMAL,
+        CALLBACK_LANE_LOW,
+        CALLBACK_LANE_LOW,
+        CALLBACK_LANE_NORMAL,
+        CALLBACK_LANE_NORMAL,
+        CALLBACK_LANE_HIGH,
+        CALLBACK_LANE_HIGH,
+};
+
+inline int GetCallbackLane(int callbackType) {
+    return g_callbackLanes[callbackType].load(std::memory_order_relaxed);
+}
+
+/**
+ * @return false if the type or the lane is out of range
+ */
+inline bool SetCallbackLane(int callbackType, int lane) {
+    if (callbackType < 0 || callbackType >= CALLBACK_TYPE_COUNT || lane < 0 || lane >= CALLBACK_LANE_COUNT) {
+        return false;
+    }
+    g_callbackLanes[callbackType].store(lane, std::memory_order_relaxed);
+    return true;
+}
+
+/**
+ * Time from queueing a callback until it was delivered, per lane.
+ */
+inline CallStats g_callbackLaneStats[CALLBACK_LANE_COUNT] = {
+        CallStats("high"),
+        CallStats("normal"),
+        CallStats("low"),
+};
+
+/**
+ * Queued deliveries a lane holds at most. A full lane drops its oldest delivery to make room, so a callback storm
+ * can't grow the queue without limit.
+ */
+constexpr size_t CALLBACK_LANE_CAPACITY = 4096;
+
+/**
+ * Threads attached to the VM to deliver a callback, and deliveries dropped because the thread couldn't get a JNIEnv
+ * or their lane was full, since the library was loaded. Those dropped by a closed callback gate are counted by the gate.
+ */
+inline std::atomic<uint64_t> g_callbackAttachCount(0);
+inline std::atomic<uint64_t> g_callbackDroppedCount(0);
+
+class CallbackDispatcher {
+public:
+    using Delivery = std::function<void()>;
+
+    explicit CallbackDispatcher(std::function<void()> onThreadExit = nullptr)
+            : onThreadExit_(std::move(onThreadExit)), thread_(&CallbackDispatcher::run, this) {}
+
+    CallbackDispatcher(const CallbackDispatcher &) = delete;
+    CallbackDispatcher &operator=(const CallbackDispatcher &) = delete;
+
+    /**
+     * Delivers the queued callbacks before it returns.
+     */
+    ~CallbackDispatcher() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wakeUp_.notify_one();
+        thread_.join();
+    }
+
+    /**
+     * @param drop runs instead of the delivery if it's pushed out of a full lane
+     */
+    void post(int callbackType, Delivery delivery, Delivery drop) {
+        int lane = GetCallbackLane(callbackType);
+        Pending overflow;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (lanes_[lane].size() >= CALLBACK_LANE_CAPACITY) {
+                overflow = std::move(lanes_[lane].front());
+                lanes_[lane].pop_front();
+            }
+            lanes_[lane].push_back(Pending{std::chrono::steady_clock::now(), std::move(delivery), std::move(drop)});
+        }
+        wakeUp_.notify_one();
+        if (overflow.delivery) {
+            g_callbackDroppedCount.fetch_add(1, std::memory_order_relaxed);
+            overflow.drop();
+        }
+    }
+
+private:
+    struct Pending {
+        std::chrono::steady_clock::time_point queuedAt;
+        Delivery delivery;
+        Delivery drop;
+    };
+
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::deque<Pending> lanes_[CALLBACK_LANE_COUNT];
+    bool stopping_ = false;
+    std::function<void()> onThreadExit_;
+    std::thread thread_;
+
+    // called with the mutex held
+    bool popHighest(Pending &pending, int &lane) {
+        for (lane = 0; lane < CALLBACK_LANE_COUNT; lane++) {
+            if (!lanes_[lane].empty()) {
+                pending = std::move(lanes_[lane].front());
+                lanes_[lane].pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run() {
+        while (true) {
+            Pending pending;
+            int lane;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wakeUp_.wait(lock, [this, &pending, &lane] { return popHighest(pending, lane) || stopping_; });
+                if (!pending.delivery) {
+                    break;
+                }
+            }
+            pending.delivery();
+            g_callbackLaneStats[lane].record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - pending.queuedAt).count());
+        }
+        if (onThreadExit_) {
+            onThreadExit_();
+        }
+    }
+};
+
+#endif // CALLBACK_DISPATCHER_CPP
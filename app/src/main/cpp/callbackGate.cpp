@@ -0,0 +1,133 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef CALLBACK_GATE_CPP
+#define CALLBACK_GATE_CPP
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+/**
+ * Reference count guarding the callback handler and the callback method ids while the wallet is torn down.
+ *
+ * The owner holds one reference from open() until close(), callbacks take one for the time they use the handler.
+ * Once closed no new references are handed out, the callbacks are dropped and counted instead, and whoever
+ * releases the last reference gets to free the handler. Closing never waits for the callbacks in flight.
+ */
+class CallbackGate {
+public:
+    /**
+     * Must only be called while the gate is released, see waitUntilReleased.
+     */
+    void open() {
+        generation_.fetch_add(1, std::memory_order_relaxed);
+        state_.store(OPEN | 1, std::memory_order_release);
+    }
+
+    /**
+     * Drops the owner reference.
+     *
+     * @return true if there was no callback in flight, the caller frees the handler then
+     */
+    bool close() {
+        uint64_t state = state_.load(std::memory_order_relaxed);
+        do {
+            if ((state & OPEN) == 0) {
+                return false;
+            }
+        } while (!state_.compare_exchange_weak(state, (state & ~OPEN) - 1, std::memory_order_acq_rel));
+        return state == (OPEN | 1);
+    }
+
+    /**
+     * @return false if the gate is closed, the callback must not touch the handler then
+     */
+    bool tryEnter() {
+        uint64_t state = state_.load(std::memory_order_relaxed);
+        do {
+            if ((state & OPEN) == 0) {
+                droppedCount_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } while (!state_.compare_exchange_weak(state, state + 1, std::memory_order_acquire));
+        return true;
+    }
+
+    /**
+     * @return true if this was the last reference of a closed gate, the caller frees the handler then
+     */
+    bool leave() {
+        return state_.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    /**
+     * Callbacks still in flight after a close finish quickly, a new wallet waits for them before it reuses the globals.
+     */
+    void waitUntilReleased() const {
+        while (state_.load(std::memory_order_acquire) != 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    bool isOpen() const {
+        return (state_.load(std::memory_order_acquire) & OPEN) != 0;
+    }
+
+    /**
+     * Counts the opens, a callback queued under one generation must not reach the handler of the next. Stable while
+     * a reference is held, the gate can't be reopened before it's released.
+     */
+    uint64_t generation() const {
+        return generation_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Counts a callback dropped after it entered, because it was queued for an earlier generation.
+     */
+    void countDropped() {
+        droppedCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t droppedCount() const {
+        return droppedCount_.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr uint64_t OPEN = uint64_t(1) << 63;
+
+    std::atomic<uint64_t> state_{0};
+    std::atomic<uint64_t> droppedCount_{0};
+    std::atomic<uint64_t> generation_{0};
+};
+
+#endif // CALLBACK_GATE_CPP
@@ -0,0 +1,120 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef CALLBACK_SUBSCRIPTIONS_CPP
+#define CALLBACK_SUBSCRIPTIONS_CPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Which wallet callbacks Kotlin wants, checked by the callbacks before they cross into Java.
+ *
+ * Callback types are a bit mask indexed by the CALLBACK_TYPE_* constants. The types in the tx id mask are
+ * additionally only wanted for the tx ids in the set. Reads never lock: the tx id set is kept twice and
+ * readers use the side that isn't being written, updates wait for the last reader of the side they rewrite.
+ */
+class CallbackSubscriptions {
+public:
+    static constexpr uint32_t ALL_TYPES = ~uint32_t(0);
+
+    bool wants(int callbackType) const {
+        return (typeMask_.load(std::memory_order_acquire) >> callbackType) & 1;
+    }
+
+    bool filtersTxIds(int callbackType) const {
+        return (txIdTypeMask_.load(std::memory_order_acquire) >> callbackType) & 1;
+    }
+
+    bool containsTxId(uint64_t txId) {
+        while (true) {
+            int side = activeSide_.load();
+            sides_[side].readers.fetch_add(1);
+            if (activeSide_.load() == side) {
+                const std::vector<uint64_t> &txIds = sides_[side].txIds;
+                bool found = std::binary_search(txIds.begin(), txIds.end(), txId);
+                sides_[side].readers.fetch_sub(1);
+                return found;
+            }
+            // the sides were swapped in between, the one we got may be rewritten now
+            sides_[side].readers.fetch_sub(1);
+        }
+    }
+
+    /**
+     * Some callbacks may still go by the previous subscription while this runs.
+     */
+    void update(uint32_t typeMask, std::vector<uint64_t> txIds, uint32_t txIdTypeMask) {
+        std::sort(txIds.begin(), txIds.end());
+        std::lock_guard<std::mutex> lock(updateMutex_);
+        int inactive = 1 - activeSide_.load();
+        while (sides_[inactive].readers.load() != 0) {
+            std::this_thread::yield();
+        }
+        sides_[inactive].txIds = std::move(txIds);
+        activeSide_.store(inactive);
+        txIdTypeMask_.store(txIdTypeMask, std::memory_order_release);
+        typeMask_.store(typeMask, std::memory_order_release);
+    }
+
+    void recordFiltered() {
+        filteredCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    uint64_t filteredCount() const {
+        return filteredCount_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Side {
+        std::vector<uint64_t> txIds;
+        std::atomic<uint32_t> readers{0};
+    };
+
+    std::atomic<uint32_t> typeMask_{ALL_TYPES};
+    std::atomic<uint32_t> txIdTypeMask_{0};
+    Side sides_[2];
+    std::atomic<int> activeSide_{0};
+    std::mutex updateMutex_;
+    std::atomic<uint64_t> filteredCount_{0};
+};
+
+inline CallbackSubscriptions &GetCallbackSubscriptions() {
+    static CallbackSubscriptions subscriptions;
+    return subscriptions;
+}
+
+#endif // CALLBACK_SUBSCRIPTIONS_CPP
@@ -0,0 +1,182 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef CONFIRMATION_TRACKER_CPP
+#define CONFIRMATION_TRACKER_CPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// libwallet's default until the wallet reports its own
+constexpr uint64_t DEFAULT_REQUIRED_CONFIRMATIONS = 3;
+
+/**
+ * Mined height of every tx that is mined but doesn't have the required confirmations yet. The txs are kept as
+ * parallel arrays so a new tip updates all of them in one pass, only the txs whose count changed are reported.
+ * Txs are dropped once they have the required confirmations, or when libwallet confirms or cancels them.
+ *
+ * Confirmations are counted as tip - mined height, the count libwallet reports with the mined unconfirmed callback.
+ */
+class ConfirmationTracker {
+public:
+    bool isTracking() const {
+        return trackedCount_.load(std::memory_order_relaxed) > 0;
+    }
+
+    uint64_t required() const {
+        return required_.load(std::memory_order_relaxed);
+    }
+
+    void setRequired(uint64_t required) {
+        required_.store(required, std::memory_order_relaxed);
+    }
+
+    /**
+     * @param confirmations the count libwallet reported, it isn't reported again until the next tip changes it
+     */
+    void track(uint64_t txId, uint64_t minedHeight, uint64_t confirmations) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t index = indexOf(txId);
+        if (confirmations >= required()) {
+            if (index < txIds_.size()) {
+                removeAt(index);
+            }
+            return;
+        }
+        if (index == txIds_.size()) {
+            txIds_.push_back(txId);
+            minedHeights_.push_back(minedHeight);
+            confirmations_.push_back(confirmations);
+        } else {
+            minedHeights_[index] = minedHeight;
+            confirmations_[index] = confirmations;
+        }
+        trackedCount_.store(txIds_.size(), std::memory_order_relaxed);
+    }
+
+    void forget(uint64_t txId) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t index = indexOf(txId);
+        if (index < txIds_.size()) {
+            removeAt(index);
+        }
+    }
+
+    /**
+     * Recounts the confirmations of all tracked txs against the new tip.
+     *
+     * @return false if no count changed, otherwise the changed txs and their new counts are appended
+     */
+    bool onTip(uint64_t tip, std::vector<uint64_t> &changedTxIds, std::vector<uint64_t> &changedConfirmations) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tip == tip_ || txIds_.empty()) {
+            tip_ = tip;
+            return false;
+        }
+        tip_ = tip;
+        const size_t count = txIds_.size();
+        next_.resize(count);
+        const uint64_t *pMined = minedHeights_.data();
+        uint64_t *pNext = next_.data();
+        // branchless so the compiler can vectorise it, a reorg below the mined height counts as 0
+        for (size_t i = 0; i < count; i++) {
+            uint64_t mined = pMined[i];
+            pNext[i] = (tip - mined) & (0 - static_cast<uint64_t>(tip > mined));
+        }
+        const uint64_t required = this->required();
+        size_t kept = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (next_[i] != confirmations_[i]) {
+                changedTxIds.push_back(txIds_[i]);
+                changedConfirmations.push_back(next_[i]);
+            }
+            if (next_[i] < required) {
+                txIds_[kept] = txIds_[i];
+                minedHeights_[kept] = minedHeights_[i];
+                confirmations_[kept] = next_[i];
+                kept++;
+            }
+        }
+        txIds_.resize(kept);
+        minedHeights_.resize(kept);
+        confirmations_.resize(kept);
+        trackedCount_.store(kept, std::memory_order_relaxed);
+        return !changedTxIds.empty();
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        txIds_.clear();
+        minedHeights_.clear();
+        confirmations_.clear();
+        tip_ = 0;
+        trackedCount_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<uint64_t> txIds_;
+    std::vector<uint64_t> minedHeights_;
+    std::vector<uint64_t> confirmations_;
+    std::vector<uint64_t> next_;
+    uint64_t tip_ = 0;
+    std::atomic<uint64_t> required_{DEFAULT_REQUIRED_CONFIRMATIONS};
+    std::atomic<size_t> trackedCount_{0};
+
+    size_t indexOf(uint64_t txId) const {
+        size_t index = 0;
+        while (index < txIds_.size() && txIds_[index] != txId) {
+            index++;
+        }
+        return index;
+    }
+
+    // order doesn't matter, the last tx takes the place of the removed one
+    void removeAt(size_t index) {
+        txIds_[index] = txIds_.back();
+        minedHeights_[index] = minedHeights_.back();
+        confirmations_[index] = confirmations_.back();
+        txIds_.pop_back();
+        minedHeights_.pop_back();
+        confirmations_.pop_back();
+        trackedCount_.store(txIds_.size(), std::memory_order_relaxed);
+    }
+};
+
+inline ConfirmationTracker &GetConfirmationTracker() {
+    static ConfirmationTracker tracker;
+    return tracker;
+}
+
+#endif // CONFIRMATION_TRACKER_CPP
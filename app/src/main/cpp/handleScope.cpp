@@ -0,0 +1,209 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef HANDLE_SCOPE_CPP
+#define HANDLE_SCOPE_CPP
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * How the native objects of one type are destroyed and sized.
+ */
+struct HandleTypeInfo {
+    const char *name;
+    void (*destroy)(void *pointer);
+    // an estimate, libwallet doesn't report the memory behind its objects
+    size_t (*sizeOf)(void *pointer);
+};
+
+/**
+ * Live objects and their estimated bytes of one type, and all the objects of the type handed out so far.
+ */
+struct HandleTypeStats {
+    int64_t liveCount = 0;
+    int64_t liveBytes = 0;
+    int64_t createdCount = 0;
+};
+
+/**
+ * Native objects handed to Java, counted per type from the moment they're handed out until they're destroyed.
+ *
+ * A thread can open scopes, the objects handed out on the thread while a scope is open are registered in its innermost
+ * scope. Closing the scope destroys every object of it that wasn't destroyed or kept yet, in one call instead of one
+ * finalizer each. Scopes close innermost first, on the thread that opened them.
+ *
+ * An object handed out twice (pooled wallet addresses) is registered twice and destroyed twice, once per handout.
+ */
+class HandleScopes {
+public:
+    explicit HandleScopes(std::vector<HandleTypeInfo> types) : types_(std::move(types)), stats_(types_.size()) {}
+
+    uint64_t open() {
+        uint64_t scope = nextScope_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            scopes_[scope];
+        }
+        openScopeCount_.fetch_add(1, std::memory_order_relaxed);
+        threadScopes().push_back(scope);
+        return scope;
+    }
+
+    /**
+     * Destroys the objects left in the scope, their pointers are added to released.
+     *
+     * @return false if the scope isn't the innermost open scope of this thread
+     */
+    bool close(uint64_t scope, std::vector<void *> &released) {
+        std::vector<uint64_t> &open = threadScopes();
+        if (open.empty() || open.back() != scope) {
+            return false;
+        }
+        open.pop_back();
+        std::unordered_multimap<void *, int> handles;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto entry = scopes_.find(scope);
+            handles = std::move(entry->second);
+            scopes_.erase(entry);
+        }
+        openScopeCount_.fetch_sub(1, std::memory_order_relaxed);
+        released.reserve(released.size() + handles.size());
+        for (const auto &handle : handles) {
+            count(handle.second, handle.first, -1);
+            types_[handle.second].destroy(handle.first);
+            released.push_back(handle.first);
+        }
+        return true;
+    }
+
+    /**
+     * Counts an object handed out and registers it in the innermost scope of this thread, if there's one.
+     */
+    void onHandedOut(int type, void *pointer) {
+        count(type, pointer, 1);
+        std::vector<uint64_t> &open = threadScopes();
+        if (!open.empty()) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            scopes_[open.back()].emplace(pointer, type);
+        }
+    }
+
+    /**
+     * Destroys an object of Java, dropping one registration of it from the scope it's in.
+     */
+    void destroy(int type, void *pointer) {
+        if (openScopeCount_.load(std::memory_order_relaxed) > 0) {
+            forget(type, pointer);
+        }
+        count(type, pointer, -1);
+        types_[type].destroy(pointer);
+    }
+
+    /**
+     * Takes one registration of the object out of its scope, Java destroys the object itself.
+     *
+     * @return false if it isn't in a scope
+     */
+    bool keep(void *pointer) {
+        return forget(ANY_TYPE, pointer);
+    }
+
+    size_t typeCount() const {
+        return types_.size();
+    }
+
+    const char *typeName(size_t type) const {
+        return types_[type].name;
+    }
+
+    HandleTypeStats stats(size_t type) const {
+        const AtomicStats &stats = stats_[type];
+        HandleTypeStats result;
+        result.liveCount = stats.liveCount.load(std::memory_order_relaxed);
+        result.liveBytes = stats.liveBytes.load(std::memory_order_relaxed);
+        result.createdCount = stats.createdCount.load(std::memory_order_relaxed);
+        return result;
+    }
+
+private:
+    struct AtomicStats {
+        std::atomic<int64_t> liveCount{0};
+        std::atomic<int64_t> liveBytes{0};
+        std::atomic<int64_t> createdCount{0};
+    };
+
+    static constexpr int ANY_TYPE = -1;
+
+    const std::vector<HandleTypeInfo> types_;
+    std::vector<AtomicStats> stats_;
+    std::mutex mutex_;
+    // the objects of every open scope by pointer, with their type
+    std::unordered_map<uint64_t, std::unordered_multimap<void *, int>> scopes_;
+    std::atomic<uint64_t> nextScope_{1};
+    std::atomic<int> openScopeCount_{0};
+
+    // open scopes of the calling thread, innermost last
+    static std::vector<uint64_t> &threadScopes() {
+        static thread_local std::vector<uint64_t> scopes;
+        return scopes;
+    }
+
+    void count(int type, void *pointer, int64_t delta) {
+        AtomicStats &stats = stats_[type];
+        stats.liveCount.fetch_add(delta, std::memory_order_relaxed);
+        stats.liveBytes.fetch_add(delta * static_cast<int64_t>(types_[type].sizeOf(pointer)), std::memory_order_relaxed);
+        if (delta > 0) {
+            stats.createdCount.fetch_add(delta, std::memory_order_relaxed);
+        }
+    }
+
+    bool forget(int type, void *pointer) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto &scope : scopes_) {
+            auto range = scope.second.equal_range(pointer);
+            for (auto handle = range.first; handle != range.second; ++handle) {
+                if (type == ANY_TYPE || handle->second == type) {
+                    scope.second.erase(handle);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+};
+
+#endif // HANDLE_SCOPE_CPP
@@ -0,0 +1,289 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HEX_CODEC_CPP
+#define HEX_CODEC_CPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define HEX_CODEC_X86
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define HEX_CODEC_NEON
+#endif
+
+/**
+ * Hex encoding and decoding of byte buffers. Kept free of JNI so it can be benchmarked on the host.
+ *
+ * Every implementation has the same contract:
+ * - encode writes exactly 2 * length characters, without a terminating zero
+ * - decode reads length characters (length must be even), writes length / 2 bytes and returns false
+ *   on the first character that is not a hex digit, in which case the output content is unspecified
+ */
+typedef void (*HexEncodeFunction)(const uint8_t *pIn, size_t length, char *pOut, bool lowercase);
+
+typedef bool (*HexDecodeFunction)(const char *pIn, size_t length, uint8_t *pOut);
+
+struct HexCodec {
+    const char *name;
+    HexEncodeFunction encode;
+    HexDecodeFunction decode;
+};
+
+constexpr char HEX_DIGITS_LOWER[] = "0123456789abcdef";
+constexpr char HEX_DIGITS_UPPER[] = "0123456789ABCDEF";
+
+inline int8_t HexDigitValue(char c) {
+    if (c >= '0' && c <= '9') return static_cast<int8_t>(c - '0');
+    if (c >= 'a' && c <= 'f') return static_cast<int8_t>(c - 'a' + 10);
+    if (c >= 'A' && c <= 'F') return static_cast<int8_t>(c - 'A' + 10);
+    return -1;
+}
+
+inline void HexEncodeScalar(const uint8_t *pIn, size_t length, char *pOut, bool lowercase) {
+    const char *pDigits = lowercase ? HEX_DIGITS_LOWER : HEX_DIGITS_UPPER;
+    for (size_t i = 0; i < length; i++) {
+        pOut[2 * i] = pDigits[pIn[i] >> 4];
+        pOut[2 * i + 1] = pDigits[pIn[i] & 0x0F];
+    }
+}
+
+inline bool HexDecodeScalar(const char *pIn, size_t length, uint8_t *pOut) {
+    if (length % 2 != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < length / 2; i++) {
+        int8_t high = HexDigitValue(pIn[2 * i]);
+        int8_t low = HexDigitValue(pIn[2 * i + 1]);
+        if (high < 0 || low < 0) {
+            return false;
+        }
+        pOut[i] = static_cast<uint8_t>((high << 4) | low);
+    }
+    return true;
+}
+
+#ifdef HEX_CODEC_X86
+
+__attribute__((target("ssse3")))
+inline void HexEncodeSsse3(const uint8_t *pIn, size_t length, char *pOut, bool lowercase) {
+    const __m128i digits = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lowercase ? HEX_DIGITS_LOWER : HEX_DIGITS_UPPER));
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pIn + i));
+        __m128i high = _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), nibbleMask));
+        __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, nibbleMask));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pOut + 2 * i), _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pOut + 2 * i + 16), _mm_unpackhi_epi8(high, low));
+    }
+    HexEncodeScalar(pIn + i, length - i, pOut + 2 * i, lowercase);
+}
+
+// maps 16 characters to their nibble values, sets the bits of invalid characters in the returned mask
+__attribute__((target("ssse3")))
+inline __m128i HexNibblesSsse3(__m128i chars, int &invalidMask) {
+    const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+    const __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    invalidMask |= ~_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) & 0xFFFF;
+    return _mm_or_si128(_mm_and_si128(isDigit, digit), _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+__attribute__((target("ssse3")))
+inline bool HexDecodeSsse3(const char *pIn, size_t length, uint8_t *pOut) {
+    if (length % 2 != 0) {
+        return false;
+    }
+    // multiplies the high nibble of every pair by 16 and adds the low one
+    const __m128i weights = _mm_set1_epi16(0x0110);
+    int invalidMask = 0;
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m128i first = HexNibblesSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pIn + i)), invalidMask);
+        __m128i second = HexNibblesSsse3(_mm_loadu_si128(reinterpret_cast<const __m128i *>(pIn + i + 16)), invalidMask);
+        __m128i bytes = _mm_packus_epi16(_mm_maddubs_epi16(first, weights), _mm_maddubs_epi16(second, weights));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(pOut + i / 2), bytes);
+    }
+    return invalidMask == 0 && HexDecodeScalar(pIn + i, length - i, pOut + i / 2);
+}
+
+__attribute__((target("avx2")))
+inline void HexEncodeAvx2(const uint8_t *pIn, size_t length, char *pOut, bool lowercase) {
+    const __m256i digits = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(lowercase ? HEX_DIGITS_LOWER : HEX_DIGITS_UPPER)));
+    const __m256i nibbleMask = _mm256_set1_epi8(0x0F);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pIn + i));
+        __m256i high = _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), nibbleMask));
+        __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(bytes, nibbleMask));
+        // unpacking works per 128 bit lane, the permutes put the lanes back in input order
+        __m256i interleavedLow = _mm256_unpacklo_epi8(high, low);
+        __m256i interleavedHigh = _mm256_unpackhi_epi8(high, low);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pOut + 2 * i), _mm256_permute2x128_si256(interleavedLow, interleavedHigh, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pOut + 2 * i + 32), _mm256_permute2x128_si256(interleavedLow, interleavedHigh, 0x31));
+    }
+    HexEncodeSsse3(pIn + i, length - i, pOut + 2 * i, lowercase);
+}
+
+__attribute__((target("avx2")))
+inline __m256i HexNibblesAvx2(__m256i chars, uint32_t &invalidMask) {
+    const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+    const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    const __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+    invalidMask |= ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(isDigit, isLetter)));
+    return _mm256_or_si256(_mm256_and_si256(isDigit, digit), _mm256_and_si256(isLetter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+}
+
+__attribute__((target("avx2")))
+inline bool HexDecodeAvx2(const char *pIn, size_t length, uint8_t *pOut) {
+    if (length % 2 != 0) {
+        return false;
+    }
+    const __m256i weights = _mm256_set1_epi16(0x0110);
+    uint32_t invalidMask = 0;
+    size_t i = 0;
+    for (; i + 64 <= length; i += 64) {
+        __m256i first = HexNibblesAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(pIn + i)), invalidMask);
+        __m256i second = HexNibblesAvx2(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(pIn + i + 32)), invalidMask);
+        __m256i packed = _mm256_packus_epi16(_mm256_maddubs_epi16(first, weights), _mm256_maddubs_epi16(second, weights));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(pOut + i / 2), _mm256_permute4x64_epi64(packed, 0xD8));
+    }
+    return invalidMask == 0 && HexDecodeSsse3(pIn + i, length - i, pOut + i / 2);
+}
+
+#endif // HEX_CODEC_X86
+
+#ifdef HEX_CODEC_NEON
+
+inline void HexEncodeNeon(const uint8_t *pIn, size_t length, char *pOut, bool lowercase) {
+    const uint8x16_t digits = vld1q_u8(reinterpret_cast<const uint8_t *>(lowercase ? HEX_DIGITS_LOWER : HEX_DIGITS_UPPER));
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t bytes = vld1q_u8(pIn + i);
+        uint8x16x2_t chars;
+#ifdef __aarch64__
+        chars.val[0] = vqtbl1q_u8(digits, vshrq_n_u8(bytes, 4));
+        chars.val[1] = vqtbl1q_u8(digits, vandq_u8(bytes, vdupq_n_u8(0x0F)));
+#else
+        uint8x8x2_t table = {{vget_low_u8(digits), vget_high_u8(digits)}};
+        uint8x16_t high = vshrq_n_u8(bytes, 4);
+        uint8x16_t low = vandq_u8(bytes, vdupq_n_u8(0x0F));
+        chars.val[0] = vcombine_u8(vtbl2_u8(table, vget_low_u8(high)), vtbl2_u8(table, vget_high_u8(high)));
+        chars.val[1] = vcombine_u8(vtbl2_u8(table, vget_low_u8(low)), vtbl2_u8(table, vget_high_u8(low)));
+#endif
+        // interleaving store writes high and low digits in alternation
+        vst2q_u8(reinterpret_cast<uint8_t *>(pOut + 2 * i), chars);
+    }
+    HexEncodeScalar(pIn + i, length - i, pOut + 2 * i, lowercase);
+}
+
+inline uint8x16_t HexNibblesNeon(uint8x16_t chars, uint8x16_t &valid) {
+    uint8x16_t digit = vsubq_u8(chars, vdupq_n_u8('0'));
+    uint8x16_t letter = vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    uint8x16_t isDigit = vcltq_u8(digit, vdupq_n_u8(10));
+    uint8x16_t isLetter = vcltq_u8(letter, vdupq_n_u8(6));
+    valid = vandq_u8(valid, vorrq_u8(isDigit, isLetter));
+    return vorrq_u8(vandq_u8(isDigit, digit), vandq_u8(isLetter, vaddq_u8(letter, vdupq_n_u8(10))));
+}
+
+inline bool HexDecodeNeon(const char *pIn, size_t length, uint8_t *pOut) {
+    if (length % 2 != 0) {
+        return false;
+    }
+    uint8x16_t valid = vdupq_n_u8(0xFF);
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        // de-interleaving load splits high and low digits
+        uint8x16x2_t chars = vld2q_u8(reinterpret_cast<const uint8_t *>(pIn + i));
+        uint8x16_t high = HexNibblesNeon(chars.val[0], valid);
+        uint8x16_t low = HexNibblesNeon(chars.val[1], valid);
+        vst1q_u8(pOut + i / 2, vorrq_u8(vshlq_n_u8(high, 4), low));
+    }
+#ifdef __aarch64__
+    bool allValid = vminvq_u8(valid) == 0xFF;
+#else
+    uint8x8_t folded = vand_u8(vget_low_u8(valid), vget_high_u8(valid));
+    bool allValid = vget_lane_u64(vreinterpret_u64_u8(folded), 0) == UINT64_MAX;
+#endif
+    return allValid && HexDecodeScalar(pIn + i, length - i, pOut + i / 2);
+}
+
+#endif // HEX_CODEC_NEON
+
+/**
+ * @return every implementation the current CPU can run, the scalar one first and the fastest one last
+ */
+inline std::vector<HexCodec> GetSupportedHexCodecs() {
+    std::vector<HexCodec> codecs;
+    codecs.push_back({"scalar", HexEncodeScalar, HexDecodeScalar});
+#ifdef HEX_CODEC_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("ssse3")) {
+        codecs.push_back({"ssse3", HexEncodeSsse3, HexDecodeSsse3});
+        if (__builtin_cpu_supports("avx2")) {
+            codecs.push_back({"avx2", HexEncodeAvx2, HexDecodeAvx2});
+        }
+    }
+#endif
+#ifdef HEX_CODEC_NEON
+    // NEON is part of the arm64-v8a ABI and the NDK enables it for armeabi-v7a builds
+    codecs.push_back({"neon", HexEncodeNeon, HexDecodeNeon});
+#endif
+    return codecs;
+}
+
+/**
+ * @return the fastest implementation for the current CPU, chosen once
+ */
+inline const HexCodec &GetHexCodec() {
+    static const HexCodec codec = GetSupportedHexCodecs().back();
+    return codec;
+}
+
+inline void HexEncode(const uint8_t *pIn, size_t length, char *pOut, bool lowercase) {
+    GetHexCodec().encode(pIn, length, pOut, lowercase);
+}
+
+inline bool HexDecode(const char *pIn, size_t length, uint8_t *pOut) {
+    return GetHexCodec().decode(pIn, length, pOut);
+}
+
+#endif // HEX_CODEC_CPP
@@ -0,0 +1,700 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef HOST_FAKE_JNI_CPP
+#define HOST_FAKE_JNI_CPP
+
+#include <jni.h>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * In-process fake of the JVM side of JNI for the host build, enough to call the entry points of the native library
+ * and receive its callbacks without a JVM.
+ *
+ * Objects are reference counted: local refs, global refs and the object arrays and object fields holding an object
+ * each count once. Local refs are dropped by DeleteLocalRef, PopLocalFrame and by FakeJvm::releaseLocals(), which
+ * stands for the native call returning to Java. Classes are created on first use and never freed. Instance fields
+ * are created by GetFieldID, so any object has any field a native function asks for.
+ *
+ * Method calls on an object go to the handler of its class, if it has one.
+ */
+
+/**
+ * Set while the fake JVM itself runs, its allocations aren't part of what the benchmarks measure.
+ */
+inline thread_local int g_fakeJvmDepth = 0;
+
+struct FakeJvmScope {
+    FakeJvmScope() { g_fakeJvmDepth++; }
+    ~FakeJvmScope() { g_fakeJvmDepth--; }
+};
+
+inline bool IsInFakeJvm() {
+    return g_fakeJvmDepth > 0;
+}
+
+struct FakeJavaField {
+    std::string name;
+    std::string signature;
+    size_t index = 0;
+};
+
+struct FakeJavaMethod {
+    std::string name;
+    std::string signature;
+};
+
+struct FakeJavaObject;
+
+/**
+ * Receives the calls on the objects of a class, the arguments are read from the va_list by the method signature.
+ */
+using FakeMethodHandler = std::function<void(jobject object, const FakeJavaMethod &method, va_list args)>;
+
+struct FakeJavaClass {
+    std::string name;
+    FakeJavaObject *pObject = nullptr;
+    std::mutex mutex;
+    std::deque<FakeJavaField> fields;
+    std::deque<FakeJavaMethod> methods;
+    FakeMethodHandler handler;
+
+    ~FakeJavaClass();
+};
+
+enum class FakeJavaKind {
+    CLASS,
+    INSTANCE,
+    STRING,
+    PRIMITIVE_ARRAY,
+    OBJECT_ARRAY,
+    DIRECT_BUFFER,
+};
+
+struct FakeJavaObject {
+    FakeJavaKind kind = FakeJavaKind::INSTANCE;
+    FakeJavaClass *pClass = nullptr;
+    std::atomic<int> references{0};
+    // instance fields by FakeJavaField::index, object fields hold the object pointer
+    std::vector<int64_t> fields;
+    std::vector<bool> objectFields;
+    // modified UTF-8 of a string
+    std::string utf8;
+    std::vector<uint8_t> data;
+    size_t elementSize = 1;
+    std::vector<FakeJavaObject *> elements;
+    void *address = nullptr;
+    jlong capacity = 0;
+};
+
+inline FakeJavaClass::~FakeJavaClass() {
+    delete pObject;
+}
+
+inline FakeJavaObject *ToFakeObject(jobject object) {
+    return reinterpret_cast<FakeJavaObject *>(object);
+}
+
+template <typename T = jobject>
+inline T ToHandle(FakeJavaObject *pObject) {
+    return reinterpret_cast<T>(pObject);
+}
+
+inline void RetainFakeObject(FakeJavaObject *pObject) {
+    if (pObject != nullptr) {
+        pObject->references.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+inline void ReleaseFakeObject(FakeJavaObject *pObject) {
+    if (pObject == nullptr || pObject->kind == FakeJavaKind::CLASS) {
+        return;
+    }
+    if (pObject->references.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+        return;
+    }
+    for (FakeJavaObject *pElement : pObject->elements) {
+        ReleaseFakeObject(pElement);
+    }
+    for (size_t i = 0; i < pObject->fields.size(); i++) {
+        if (pObject->objectFields[i]) {
+            ReleaseFakeObject(reinterpret_cast<FakeJavaObject *>(pObject->fields[i]));
+        }
+    }
+    delete pObject;
+}
+
+/**
+ * The JNIEnv of one attached thread.
+ */
+struct FakeJniEnv : JNIEnv {
+    std::vector<FakeJavaObject *> locals;
+    std::vector<size_t> frames;
+    bool exceptionPending = false;
+    std::string exceptionMessage;
+
+    jobject addLocal(FakeJavaObject *pObject) {
+        if (pObject == nullptr) {
+            return nullptr;
+        }
+        RetainFakeObject(pObject);
+        locals.push_back(pObject);
+        return ToHandle(pObject);
+    }
+
+    void releaseLocalsFrom(size_t start) {
+        for (size_t i = start; i < locals.size(); i++) {
+            ReleaseFakeObject(locals[i]);
+        }
+        locals.resize(start);
+    }
+};
+
+inline FakeJniEnv *ToFakeEnv(JNIEnv *jEnv) {
+    return static_cast<FakeJniEnv *>(jEnv);
+}
+
+class FakeJvm {
+public:
+    static FakeJvm &get() {
+        static FakeJvm jvm;
+        return jvm;
+    }
+
+    JavaVM *vm() {
+        return &vm_;
+    }
+
+    /**
+     * The env of the calling thread, attached on first use.
+     */
+    JNIEnv *env() {
+        JNIEnv *jEnv = nullptr;
+        vm_.AttachCurrentThread(&jEnv, nullptr);
+        return jEnv;
+    }
+
+    FakeJavaClass *findClass(const std::string &name) {
+        std::lock_guard<std::mutex> lock(classesMutex_);
+        std::unique_ptr<FakeJavaClass> &pClass = classes_[name];
+        if (pClass == nullptr) {
+            pClass = std::make_unique<FakeJavaClass>();
+            pClass->name = name;
+            pClass->pObject = new FakeJavaObject();
+            pClass->pObject->kind = FakeJavaKind::CLASS;
+            pClass->pObject->pClass = pClass.get();
+        }
+        return pClass.get();
+    }
+
+    void setHandler(const std::string &className, FakeMethodHandler handler) {
+        FakeJavaClass *pClass = findClass(className);
+        std::lock_guard<std::mutex> lock(pClass->mutex);
+        pClass->handler = std::move(handler);
+    }
+
+    /**
+     * A new object held by one global ref, give it back with deleteGlobalRef().
+     */
+    jobject newGlobalObject(const std::string &className) {
+        FakeJvmScope scope;
+        auto pObject = new FakeJavaObject();
+        pObject->pClass = findClass(className);
+        RetainFakeObject(pObject);
+        return ToHandle(pObject);
+    }
+
+    /**
+     * An object with its "pointer" field set, the way the FFI wrapper classes hold their native object.
+     */
+    jobject newPointerObject(const std::string &className, const void *pointer) {
+        jobject object = newGlobalObject(className);
+        JNIEnv *jEnv = env();
+        jfieldID field = jEnv->GetFieldID(jEnv->GetObjectClass(object), "pointer", "J");
+        jEnv->SetLongField(object, field, reinterpret_cast<jlong>(pointer));
+        return object;
+    }
+
+    jstring newGlobalString(const std::string &utf8) {
+        JNIEnv *jEnv = env();
+        jstring local = jEnv->NewStringUTF(utf8.c_str());
+        auto global = static_cast<jstring>(jEnv->NewGlobalRef(local));
+        jEnv->DeleteLocalRef(local);
+        return global;
+    }
+
+    void deleteGlobalRef(jobject object) {
+        ReleaseFakeObject(ToFakeObject(object));
+    }
+
+    /**
+     * Drops the local refs of the calling thread, what the JVM does when a native call returns.
+     */
+    void releaseLocals() {
+        FakeJvmScope scope;
+        FakeJniEnv *pEnv = ToFakeEnv(env());
+        pEnv->releaseLocalsFrom(0);
+        pEnv->frames.clear();
+    }
+
+    static int64_t getField(jobject object, const char *name) {
+        FakeJavaObject *pObject = ToFakeObject(object);
+        std::lock_guard<std::mutex> lock(pObject->pClass->mutex);
+        for (const FakeJavaField &field : pObject->pClass->fields) {
+            if (field.name == name) {
+                return field.index < pObject->fields.size() ? pObject->fields[field.index] : 0;
+            }
+        }
+        return 0;
+    }
+
+    static std::string getString(jstring string) {
+        return string != nullptr ? ToFakeObject(string)->utf8 : std::string();
+    }
+
+    static const std::vector<uint8_t> &getArrayData(jarray array) {
+        return ToFakeObject(array)->data;
+    }
+
+private:
+    JNIInvokeInterface invokeFunctions_;
+    JavaVM vm_;
+    JNINativeInterface functions_;
+    std::mutex classesMutex_;
+    std::unordered_map<std::string, std::unique_ptr<FakeJavaClass>> classes_;
+
+    FakeJvm();
+
+    static thread_local std::unique_ptr<FakeJniEnv> threadEnv_;
+
+    static FakeJavaClass *classOf(jclass cls) {
+        return ToFakeObject(cls)->pClass;
+    }
+
+    static FakeJavaObject *newObject(FakeJavaKind kind, const char *className) {
+        auto pObject = new FakeJavaObject();
+        pObject->kind = kind;
+        pObject->pClass = get().findClass(className);
+        return pObject;
+    }
+
+    static FakeJavaObject *newPrimitiveArray(const char *className, jsize length, size_t elementSize) {
+        FakeJavaObject *pArray = newObject(FakeJavaKind::PRIMITIVE_ARRAY, className);
+        pArray->elementSize = elementSize;
+        pArray->data.assign(static_cast<size_t>(length) * elementSize, 0);
+        return pArray;
+    }
+
+    template <typename T>
+    static void getRegion(jarray array, jsize start, jsize length, T *buffer) {
+        FakeJvmScope scope;
+        memcpy(buffer, ToFakeObject(array)->data.data() + start * sizeof(T), length * sizeof(T));
+    }
+
+    template <typename T>
+    static void setRegion(jarray array, jsize start, jsize length, const T *buffer) {
+        FakeJvmScope scope;
+        memcpy(ToFakeObject(array)->data.data() + start * sizeof(T), buffer, length * sizeof(T));
+    }
+
+    static int64_t *fieldSlot(jobject object, jfieldID field) {
+        FakeJavaObject *pObject = ToFakeObject(object);
+        auto index = reinterpret_cast<FakeJavaField *>(field)->index;
+        if (pObject->fields.size() <= index) {
+            pObject->fields.resize(index + 1, 0);
+            pObject->objectFields.resize(index + 1, false);
+        }
+        return &pObject->fields[index];
+    }
+
+    static void setObjectField(jobject object, jfieldID field, jobject value) {
+        FakeJvmScope scope;
+        int64_t *pSlot = fieldSlot(object, field);
+        FakeJavaObject *pOld = ToFakeObject(object)->objectFields[reinterpret_cast<FakeJavaField *>(field)->index]
+                               ? reinterpret_cast<FakeJavaObject *>(*pSlot) : nullptr;
+        RetainFakeObject(ToFakeObject(value));
+        *pSlot = reinterpret_cast<int64_t>(value);
+        ToFakeObject(object)->objectFields[reinterpret_cast<FakeJavaField *>(field)->index] = true;
+        ReleaseFakeObject(pOld);
+    }
+
+    // UTF-16 from modified UTF-8, surrogate pairs are encoded as two 3 byte sequences
+    static std::vector<jchar> toUtf16(const std::string &utf8) {
+        std::vector<jchar> result;
+        for (size_t i = 0; i < utf8.size();) {
+            auto byte = static_cast<uint8_t>(utf8[i]);
+            if (byte < 0x80) {
+                result.push_back(byte);
+                i += 1;
+            } else if ((byte & 0xE0) == 0xC0 && i + 1 < utf8.size()) {
+                result.push_back(static_cast<jchar>(((byte & 0x1F) << 6) | (utf8[i + 1] & 0x3F)));
+                i += 2;
+            } else if ((byte & 0xF0) == 0xE0 && i + 2 < utf8.size()) {
+                result.push_back(static_cast<jchar>(((byte & 0x0F) << 12) | ((utf8[i + 1] & 0x3F) << 6) | (utf8[i + 2] & 0x3F)));
+                i += 3;
+            } else if ((byte & 0xF8) == 0xF0 && i + 3 < utf8.size()) {
+                // standard UTF-8 4 byte sequence, accepted as well since test strings are written in plain UTF-8
+                uint32_t codePoint = ((byte & 0x07) << 18) | ((utf8[i + 1] & 0x3F) << 12) | ((utf8[i + 2] & 0x3F) << 6) | (utf8[i + 3] & 0x3F);
+                codePoint -= 0x10000;
+                result.push_back(static_cast<jchar>(0xD800 + (codePoint >> 10)));
+                result.push_back(static_cast<jchar>(0xDC00 + (codePoint & 0x3FF)));
+                i += 4;
+            } else {
+                result.push_back(0xFFFD);
+                i += 1;
+            }
+        }
+        return result;
+    }
+
+    static std::string toUtf8(const jchar *pChars, jsize length) {
+        std::string result;
+        for (jsize i = 0; i < length; i++) {
+            jchar c = pChars[i];
+            if (c > 0 && c < 0x80) {
+                result.push_back(static_cast<char>(c));
+            } else if (c < 0x800) {
+                result.push_back(static_cast<char>(0xC0 | (c >> 6)));
+                result.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+            } else {
+                result.push_back(static_cast<char>(0xE0 | (c >> 12)));
+                result.push_back(static_cast<char>(0x80 | ((c >> 6) & 0x3F)));
+                result.push_back(static_cast<char>(0x80 | (c & 0x3F)));
+            }
+        }
+        return result;
+    }
+
+    static JNINativeInterface newFunctions();
+    static JNIInvokeInterface newInvokeFunctions();
+};
+
+inline thread_local std::unique_ptr<FakeJniEnv> FakeJvm::threadEnv_;
+
+inline FakeJvm::FakeJvm() : invokeFunctions_(newInvokeFunctions()), functions_(newFunctions()) {
+    vm_.functions = &invokeFunctions_;
+}
+
+inline JNIInvokeInterface FakeJvm::newInvokeFunctions() {
+    JNIInvokeInterface functions{};
+    functions.GetEnv = [](JavaVM *, void **env, jint) -> jint {
+        *env = threadEnv_.get();
+        return threadEnv_ != nullptr ? JNI_OK : JNI_EDETACHED;
+    };
+    functions.AttachCurrentThread = [](JavaVM *, JNIEnv **env, void *) -> jint {
+        if (threadEnv_ == nullptr) {
+            FakeJvmScope scope;
+            threadEnv_ = std::make_unique<FakeJniEnv>();
+            threadEnv_->functions = &get().functions_;
+        }
+        *env = threadEnv_.get();
+        return JNI_OK;
+    };
+    functions.AttachCurrentThreadAsDaemon = functions.AttachCurrentThread;
+    functions.DetachCurrentThread = [](JavaVM *) -> jint {
+        if (threadEnv_ != nullptr) {
+            FakeJvmScope scope;
+            threadEnv_->releaseLocalsFrom(0);
+            threadEnv_.reset();
+        }
+        return JNI_OK;
+    };
+    return functions;
+}
+
+inline JNINativeInterface FakeJvm::newFunctions() {
+    JNINativeInterface functions{};
+
+    functions.FindClass = [](JNIEnv *, const char *name) -> jclass {
+        FakeJvmScope scope;
+        return ToHandle<jclass>(get().findClass(name)->pObject);
+    };
+    functions.GetObjectClass = [](JNIEnv *, jobject object) -> jclass {
+        return ToHandle<jclass>(ToFakeObject(object)->pClass->pObject);
+    };
+
+    functions.ThrowNew = [](JNIEnv *jEnv, jclass, const char *message) -> jint {
+        FakeJvmScope scope;
+        ToFakeEnv(jEnv)->exceptionPending = true;
+        ToFakeEnv(jEnv)->exceptionMessage = message != nullptr ? message : "";
+        return JNI_OK;
+    };
+    functions.ExceptionCheck = [](JNIEnv *jEnv) -> jboolean {
+        return ToFakeEnv(jEnv)->exceptionPending ? JNI_TRUE : JNI_FALSE;
+    };
+    functions.ExceptionClear = [](JNIEnv *jEnv) {
+        ToFakeEnv(jEnv)->exceptionPending = false;
+    };
+
+    functions.PushLocalFrame = [](JNIEnv *jEnv, jint) -> jint {
+        FakeJvmScope scope;
+        ToFakeEnv(jEnv)->frames.push_back(ToFakeEnv(jEnv)->locals.size());
+        return JNI_OK;
+    };
+    functions.PopLocalFrame = [](JNIEnv *jEnv, jobject result) -> jobject {
+        FakeJvmScope scope;
+        FakeJniEnv *pEnv = ToFakeEnv(jEnv);
+        if (pEnv->frames.empty()) {
+            return nullptr;
+        }
+        RetainFakeObject(ToFakeObject(result));
+        pEnv->releaseLocalsFrom(pEnv->frames.back());
+        pEnv->frames.pop_back();
+        jobject outer = pEnv->addLocal(ToFakeObject(result));
+        ReleaseFakeObject(ToFakeObject(result));
+        return outer;
+    };
+    functions.NewGlobalRef = [](JNIEnv *, jobject object) -> jobject {
+        RetainFakeObject(ToFakeObject(object));
+        return object;
+    };
+    functions.DeleteGlobalRef = [](JNIEnv *, jobject object) {
+        FakeJvmScope scope;
+        ReleaseFakeObject(ToFakeObject(object));
+    };
+    // weak refs keep the object like global ones, the fake objects are only ever compared through them
+    functions.NewWeakGlobalRef = [](JNIEnv *, jobject object) -> jweak {
+        RetainFakeObject(ToFakeObject(object));
+        return object;
+    };
+    functions.DeleteWeakGlobalRef = [](JNIEnv *, jweak object) {
+        FakeJvmScope scope;
+        ReleaseFakeObject(ToFakeObject(object));
+    };
+    functions.IsSameObject = [](JNIEnv *, jobject first, jobject second) -> jboolean {
+        return first == second ? JNI_TRUE : JNI_FALSE;
+    };
+    functions.DeleteLocalRef = [](JNIEnv *jEnv, jobject object) {
+        FakeJvmScope scope;
+        std::vector<FakeJavaObject *> &locals = ToFakeEnv(jEnv)->locals;
+        for (size_t i = locals.size(); i > 0; i--) {
+            if (locals[i - 1] == ToFakeObject(object)) {
+                locals.erase(locals.begin() + static_cast<long>(i - 1));
+                ReleaseFakeObject(ToFakeObject(object));
+                return;
+            }
+        }
+    };
+
+    functions.GetFieldID = [](JNIEnv *, jclass cls, const char *name, const char *signature) -> jfieldID {
+        FakeJvmScope scope;
+        FakeJavaClass *pClass = classOf(cls);
+        std::lock_guard<std::mutex> lock(pClass->mutex);
+        for (FakeJavaField &field : pClass->fields) {
+            if (field.name == name) {
+                return reinterpret_cast<jfieldID>(&field);
+            }
+        }
+        pClass->fields.push_back({name, signature, pClass->fields.size()});
+        return reinterpret_cast<jfieldID>(&pClass->fields.back());
+    };
+    functions.GetIntField = [](JNIEnv *, jobject object, jfieldID field) -> jint {
+        FakeJvmScope scope;
+        return static_cast<jint>(*fieldSlot(object, field));
+    };
+    functions.GetLongField = [](JNIEnv *, jobject object, jfieldID field) -> jlong {
+        FakeJvmScope scope;
+        return *fieldSlot(object, field);
+    };
+    functions.SetByteField = [](JNIEnv *, jobject object, jfieldID field, jbyte value) {
+        FakeJvmScope scope;
+        *fieldSlot(object, field) = value;
+    };
+    functions.SetIntField = [](JNIEnv *, jobject object, jfieldID field, jint value) {
+        FakeJvmScope scope;
+        *fieldSlot(object, field) = value;
+    };
+    functions.SetLongField = [](JNIEnv *, jobject object, jfieldID field, jlong value) {
+        FakeJvmScope scope;
+        *fieldSlot(object, field) = value;
+    };
+    functions.SetObjectField = [](JNIEnv *, jobject object, jfieldID field, jobject value) {
+        setObjectField(object, field, value);
+    };
+
+    functions.GetMethodID = [](JNIEnv *, jclass cls, const char *name, const char *signature) -> jmethodID {
+        FakeJvmScope scope;
+        FakeJavaClass *pClass = classOf(cls);
+        std::lock_guard<std::mutex> lock(pClass->mutex);
+        for (FakeJavaMethod &method : pClass->methods) {
+            if (method.name == name && method.signature == signature) {
+                return reinterpret_cast<jmethodID>(&method);
+            }
+        }
+        pClass->methods.push_back({name, signature});
+        return reinterpret_cast<jmethodID>(&pClass->methods.back());
+    };
+    functions.CallVoidMethodV = [](JNIEnv *, jobject object, jmethodID method, va_list args) {
+        FakeJvmScope scope;
+        FakeJavaClass *pClass = ToFakeObject(object)->pClass;
+        FakeMethodHandler handler;
+        {
+            std::lock_guard<std::mutex> lock(pClass->mutex);
+            handler = pClass->handler;
+        }
+        if (handler) {
+            handler(object, *reinterpret_cast<FakeJavaMethod *>(method), args);
+        }
+    };
+
+    functions.NewString = [](JNIEnv *jEnv, const jchar *pChars, jsize length) -> jstring {
+        FakeJvmScope scope;
+        FakeJavaObject *pString = newObject(FakeJavaKind::STRING, "java/lang/String");
+        pString->utf8 = toUtf8(pChars, length);
+        return static_cast<jstring>(ToFakeEnv(jEnv)->addLocal(pString));
+    };
+    functions.GetStringLength = [](JNIEnv *, jstring string) -> jsize {
+        FakeJvmScope scope;
+        return static_cast<jsize>(toUtf16(ToFakeObject(string)->utf8).size());
+    };
+    functions.GetStringRegion = [](JNIEnv *, jstring string, jsize start, jsize length, jchar *buffer) {
+        FakeJvmScope scope;
+        std::vector<jchar> chars = toUtf16(ToFakeObject(string)->utf8);
+        memcpy(buffer, chars.data() + start, static_cast<size_t>(length) * sizeof(jchar));
+    };
+    functions.NewStringUTF = [](JNIEnv *jEnv, const char *pChars) -> jstring {
+        FakeJvmScope scope;
+        if (pChars == nullptr) {
+            return nullptr;
+        }
+        FakeJavaObject *pString = newObject(FakeJavaKind::STRING, "java/lang/String");
+        pString->utf8 = pChars;
+        return static_cast<jstring>(ToFakeEnv(jEnv)->addLocal(pString));
+    };
+    functions.GetStringUTFLength = [](JNIEnv *, jstring string) -> jsize {
+        return static_cast<jsize>(ToFakeObject(string)->utf8.size());
+    };
+    functions.GetStringUTFChars = [](JNIEnv *, jstring string, jboolean *isCopy) -> const char * {
+        if (isCopy != nullptr) {
+            *isCopy = JNI_FALSE;
+        }
+        return ToFakeObject(string)->utf8.c_str();
+    };
+    functions.ReleaseStringUTFChars = [](JNIEnv *, jstring, const char *) {};
+
+    functions.GetArrayLength = [](JNIEnv *, jarray array) -> jsize {
+        FakeJavaObject *pArray = ToFakeObject(array);
+        return static_cast<jsize>(pArray->kind == FakeJavaKind::OBJECT_ARRAY ? pArray->elements.size()
+                                                                              : pArray->data.size() / pArray->elementSize);
+    };
+    functions.NewObjectArray = [](JNIEnv *jEnv, jsize length, jclass, jobject initial) -> jobjectArray {
+        FakeJvmScope scope;
+        FakeJavaObject *pArray = newObject(FakeJavaKind::OBJECT_ARRAY, "[Ljava/lang/Object;");
+        pArray->elements.assign(static_cast<size_t>(length), ToFakeObject(initial));
+        for (jsize i = 0; i < length; i++) {
+            RetainFakeObject(ToFakeObject(initial));
+        }
+        return static_cast<jobjectArray>(ToFakeEnv(jEnv)->addLocal(pArray));
+    };
+    functions.GetObjectArrayElement = [](JNIEnv *jEnv, jobjectArray array, jsize index) -> jobject {
+        FakeJvmScope scope;
+        return ToFakeEnv(jEnv)->addLocal(ToFakeObject(array)->elements[static_cast<size_t>(index)]);
+    };
+    functions.SetObjectArrayElement = [](JNIEnv *, jobjectArray array, jsize index, jobject value) {
+        FakeJvmScope scope;
+        FakeJavaObject *&pElement = ToFakeObject(array)->elements[static_cast<size_t>(index)];
+        RetainFakeObject(ToFakeObject(value));
+        ReleaseFakeObject(pElement);
+        pElement = ToFakeObject(value);
+    };
+    functions.NewByteArray = [](JNIEnv *jEnv, jsize length) -> jbyteArray {
+        FakeJvmScope scope;
+        return static_cast<jbyteArray>(ToFakeEnv(jEnv)->addLocal(newPrimitiveArray("[B", length, sizeof(jbyte))));
+    };
+    functions.NewIntArray = [](JNIEnv *jEnv, jsize length) -> jintArray {
+        FakeJvmScope scope;
+        return static_cast<jintArray>(ToFakeEnv(jEnv)->addLocal(newPrimitiveArray("[I", length, sizeof(jint))));
+    };
+    functions.NewLongArray = [](JNIEnv *jEnv, jsize length) -> jlongArray {
+        FakeJvmScope scope;
+        return static_cast<jlongArray>(ToFakeEnv(jEnv)->addLocal(newPrimitiveArray("[J", length, sizeof(jlong))));
+    };
+    // elements are handed out in place, like a non-moving JVM would
+    functions.GetByteArrayElements = [](JNIEnv *, jbyteArray array, jboolean *isCopy) -> jbyte * {
+        if (isCopy != nullptr) {
+            *isCopy = JNI_FALSE;
+        }
+        return reinterpret_cast<jbyte *>(ToFakeObject(array)->data.data());
+    };
+    functions.GetLongArrayElements = [](JNIEnv *, jlongArray array, jboolean *isCopy) -> jlong * {
+        if (isCopy != nullptr) {
+            *isCopy = JNI_FALSE;
+        }
+        return reinterpret_cast<jlong *>(ToFakeObject(array)->data.data());
+    };
+    functions.ReleaseByteArrayElements = [](JNIEnv *, jbyteArray, jbyte *, jint) {};
+    functions.ReleaseLongArrayElements = [](JNIEnv *, jlongArray, jlong *, jint) {};
+    functions.GetByteArrayRegion = [](JNIEnv *, jbyteArray array, jsize start, jsize length, jbyte *buffer) {
+        getRegion(array, start, length, buffer);
+    };
+    functions.GetIntArrayRegion = [](JNIEnv *, jintArray array, jsize start, jsize length, jint *buffer) {
+        getRegion(array, start, length, buffer);
+    };
+    functions.GetLongArrayRegion = [](JNIEnv *, jlongArray array, jsize start, jsize length, jlong *buffer) {
+        getRegion(array, start, length, buffer);
+    };
+    functions.SetByteArrayRegion = [](JNIEnv *, jbyteArray array, jsize start, jsize length, const jbyte *buffer) {
+        setRegion(array, start, length, buffer);
+    };
+    functions.SetIntArrayRegion = [](JNIEnv *, jintArray array, jsize start, jsize length, const jint *buffer) {
+        setRegion(array, start, length, buffer);
+    };
+    functions.SetLongArrayRegion = [](JNIEnv *, jlongArray array, jsize start, jsize length, const jlong *buffer) {
+        setRegion(array, start, length, buffer);
+    };
+
+    functions.NewDirectByteBuffer = [](JNIEnv *jEnv, void *address, jlong capacity) -> jobject {
+        FakeJvmScope scope;
+        FakeJavaObject *pBuffer = newObject(FakeJavaKind::DIRECT_BUFFER, "java/nio/DirectByteBuffer");
+        pBuffer->address = address;
+        pBuffer->capacity = capacity;
+        return ToFakeEnv(jEnv)->addLocal(pBuffer);
+    };
+    functions.GetDirectBufferAddress = [](JNIEnv *, jobject buffer) -> void * {
+        return ToFakeObject(buffer)->address;
+    };
+    functions.GetDirectBufferCapacity = [](JNIEnv *, jobject buffer) -> jlong {
+        return ToFakeObject(buffer)->capacity;
+    };
+
+    return functions;
+}
+
+#endif // HOST_FAKE_JNI_CPP
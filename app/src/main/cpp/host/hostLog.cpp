@@ -0,0 +1,60 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <android/log.h>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+static int LogLevel() {
+    static const int level = [] {
+        const char *pLevel = getenv("HOST_LOG_LEVEL");
+        return pLevel != nullptr ? atoi(pLevel) : static_cast<int>(ANDROID_LOG_WARN);
+    }();
+    return level;
+}
+
+extern "C" int __android_log_print(int priority, const char *tag, const char *format, ...) {
+    if (priority < LogLevel()) {
+        return 0;
+    }
+    static const char PRIORITY_LETTERS[] = "??VDIWEFS";
+    char letter = priority >= 0 && priority <= ANDROID_LOG_SILENT ? PRIORITY_LETTERS[priority] : '?';
+    va_list args;
+    va_start(args, format);
+    fprintf(stderr, "%c/%s: ", letter, tag);
+    int written = vfprintf(stderr, format, args);
+    fputc('\n', stderr);
+    va_end(args);
+    return written;
+}
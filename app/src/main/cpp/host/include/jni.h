@@ -0,0 +1,277 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef HOST_FAKE_JNI_H
+#define HOST_FAKE_JNI_H
+
+/**
+ * Host stand-in for <jni.h>, only used by the host build (see ../CMakeLists.txt).
+ *
+ * It declares the subset of JNI the native library uses with the same layout as the real header: JNIEnv and JavaVM
+ * are thin C++ wrappers around a function table, so every call pays the same indirection as on the device.
+ * The table is filled in by fakeJni.cpp.
+ */
+
+#include <cstdarg>
+#include <cstdint>
+
+typedef uint8_t jboolean;
+typedef int8_t jbyte;
+typedef uint16_t jchar;
+typedef int16_t jshort;
+typedef int32_t jint;
+typedef int64_t jlong;
+typedef float jfloat;
+typedef double jdouble;
+typedef jint jsize;
+
+class _jobject {};
+class _jclass : public _jobject {};
+class _jstring : public _jobject {};
+class _jthrowable : public _jobject {};
+class _jarray : public _jobject {};
+class _jobjectArray : public _jarray {};
+class _jbyteArray : public _jarray {};
+class _jintArray : public _jarray {};
+class _jlongArray : public _jarray {};
+
+typedef _jobject *jobject;
+typedef _jclass *jclass;
+typedef _jstring *jstring;
+typedef _jthrowable *jthrowable;
+typedef _jarray *jarray;
+typedef _jobjectArray *jobjectArray;
+typedef _jbyteArray *jbyteArray;
+typedef _jintArray *jintArray;
+typedef _jlongArray *jlongArray;
+typedef jobject jweak;
+
+struct _jfieldID;
+typedef struct _jfieldID *jfieldID;
+struct _jmethodID;
+typedef struct _jmethodID *jmethodID;
+
+#define JNI_FALSE 0
+#define JNI_TRUE 1
+
+#define JNI_OK 0
+#define JNI_ERR (-1)
+#define JNI_EDETACHED (-2)
+#define JNI_EVERSION (-3)
+
+#define JNI_COMMIT 1
+#define JNI_ABORT 2
+
+#define JNI_VERSION_1_6 0x00010006
+
+#define JNIEXPORT __attribute__ ((visibility ("default")))
+#define JNICALL
+
+struct _JNIEnv;
+struct _JavaVM;
+typedef _JNIEnv JNIEnv;
+typedef _JavaVM JavaVM;
+
+struct JNINativeInterface {
+    jclass (*FindClass)(JNIEnv *, const char *);
+    jclass (*GetObjectClass)(JNIEnv *, jobject);
+
+    jint (*ThrowNew)(JNIEnv *, jclass, const char *);
+    jboolean (*ExceptionCheck)(JNIEnv *);
+    void (*ExceptionClear)(JNIEnv *);
+
+    jint (*PushLocalFrame)(JNIEnv *, jint);
+    jobject (*PopLocalFrame)(JNIEnv *, jobject);
+    jobject (*NewGlobalRef)(JNIEnv *, jobject);
+    void (*DeleteGlobalRef)(JNIEnv *, jobject);
+    jweak (*NewWeakGlobalRef)(JNIEnv *, jobject);
+    void (*DeleteWeakGlobalRef)(JNIEnv *, jweak);
+    jboolean (*IsSameObject)(JNIEnv *, jobject, jobject);
+    void (*DeleteLocalRef)(JNIEnv *, jobject);
+
+    jfieldID (*GetFieldID)(JNIEnv *, jclass, const char *, const char *);
+    jint (*GetIntField)(JNIEnv *, jobject, jfieldID);
+    jlong (*GetLongField)(JNIEnv *, jobject, jfieldID);
+    void (*SetByteField)(JNIEnv *, jobject, jfieldID, jbyte);
+    void (*SetIntField)(JNIEnv *, jobject, jfieldID, jint);
+    void (*SetLongField)(JNIEnv *, jobject, jfieldID, jlong);
+    void (*SetObjectField)(JNIEnv *, jobject, jfieldID, jobject);
+
+    jmethodID (*GetMethodID)(JNIEnv *, jclass, const char *, const char *);
+    void (*CallVoidMethodV)(JNIEnv *, jobject, jmethodID, va_list);
+
+    jstring (*NewString)(JNIEnv *, const jchar *, jsize);
+    jsize (*GetStringLength)(JNIEnv *, jstring);
+    void (*GetStringRegion)(JNIEnv *, jstring, jsize, jsize, jchar *);
+    jstring (*NewStringUTF)(JNIEnv *, const char *);
+    jsize (*GetStringUTFLength)(JNIEnv *, jstring);
+    const char *(*GetStringUTFChars)(JNIEnv *, jstring, jboolean *);
+    void (*ReleaseStringUTFChars)(JNIEnv *, jstring, const char *);
+
+    jsize (*GetArrayLength)(JNIEnv *, jarray);
+    jobjectArray (*NewObjectArray)(JNIEnv *, jsize, jclass, jobject);
+    jobject (*GetObjectArrayElement)(JNIEnv *, jobjectArray, jsize);
+    void (*SetObjectArrayElement)(JNIEnv *, jobjectArray, jsize, jobject);
+    jbyteArray (*NewByteArray)(JNIEnv *, jsize);
+    jintArray (*NewIntArray)(JNIEnv *, jsize);
+    jlongArray (*NewLongArray)(JNIEnv *, jsize);
+    jbyte *(*GetByteArrayElements)(JNIEnv *, jbyteArray, jboolean *);
+    jlong *(*GetLongArrayElements)(JNIEnv *, jlongArray, jboolean *);
+    void (*ReleaseByteArrayElements)(JNIEnv *, jbyteArray, jbyte *, jint);
+    void (*ReleaseLongArrayElements)(JNIEnv *, jlongArray, jlong *, jint);
+    void (*GetByteArrayRegion)(JNIEnv *, jbyteArray, jsize, jsize, jbyte *);
+    void (*GetIntArrayRegion)(JNIEnv *, jintArray, jsize, jsize, jint *);
+    void (*GetLongArrayRegion)(JNIEnv *, jlongArray, jsize, jsize, jlong *);
+    void (*SetByteArrayRegion)(JNIEnv *, jbyteArray, jsize, jsize, const jbyte *);
+    void (*SetIntArrayRegion)(JNIEnv *, jintArray, jsize, jsize, const jint *);
+    void (*SetLongArrayRegion)(JNIEnv *, jlongArray, jsize, jsize, const jlong *);
+
+    jobject (*NewDirectByteBuffer)(JNIEnv *, void *, jlong);
+    void *(*GetDirectBufferAddress)(JNIEnv *, jobject);
+    jlong (*GetDirectBufferCapacity)(JNIEnv *, jobject);
+};
+
+struct _JNIEnv {
+    const JNINativeInterface *functions;
+
+    jclass FindClass(const char *name) { return functions->FindClass(this, name); }
+    jclass GetObjectClass(jobject object) { return functions->GetObjectClass(this, object); }
+
+    jint ThrowNew(jclass cls, const char *message) { return functions->ThrowNew(this, cls, message); }
+    jboolean ExceptionCheck() { return functions->ExceptionCheck(this); }
+    void ExceptionClear() { functions->ExceptionClear(this); }
+
+    jint PushLocalFrame(jint capacity) { return functions->PushLocalFrame(this, capacity); }
+    jobject PopLocalFrame(jobject result) { return functions->PopLocalFrame(this, result); }
+    jobject NewGlobalRef(jobject object) { return functions->NewGlobalRef(this, object); }
+    void DeleteGlobalRef(jobject object) { functions->DeleteGlobalRef(this, object); }
+    jweak NewWeakGlobalRef(jobject object) { return functions->NewWeakGlobalRef(this, object); }
+    void DeleteWeakGlobalRef(jweak object) { functions->DeleteWeakGlobalRef(this, object); }
+    jboolean IsSameObject(jobject first, jobject second) { return functions->IsSameObject(this, first, second); }
+    void DeleteLocalRef(jobject object) { functions->DeleteLocalRef(this, object); }
+
+    jfieldID GetFieldID(jclass cls, const char *name, const char *signature) {
+        return functions->GetFieldID(this, cls, name, signature);
+    }
+    jint GetIntField(jobject object, jfieldID field) { return functions->GetIntField(this, object, field); }
+    jlong GetLongField(jobject object, jfieldID field) { return functions->GetLongField(this, object, field); }
+    void SetByteField(jobject object, jfieldID field, jbyte value) { functions->SetByteField(this, object, field, value); }
+    void SetIntField(jobject object, jfieldID field, jint value) { functions->SetIntField(this, object, field, value); }
+    void SetLongField(jobject object, jfieldID field, jlong value) { functions->SetLongField(this, object, field, value); }
+    void SetObjectField(jobject object, jfieldID field, jobject value) { functions->SetObjectField(this, object, field, value); }
+
+    jmethodID GetMethodID(jclass cls, const char *name, const char *signature) {
+        return functions->GetMethodID(this, cls, name, signature);
+    }
+    void CallVoidMethod(jobject object, jmethodID method, ...) {
+        va_list args;
+        va_start(args, method);
+        functions->CallVoidMethodV(this, object, method, args);
+        va_end(args);
+    }
+
+    jstring NewString(const jchar *chars, jsize length) { return functions->NewString(this, chars, length); }
+    jsize GetStringLength(jstring string) { return functions->GetStringLength(this, string); }
+    void GetStringRegion(jstring string, jsize start, jsize length, jchar *buffer) {
+        functions->GetStringRegion(this, string, start, length, buffer);
+    }
+    jstring NewStringUTF(const char *chars) { return functions->NewStringUTF(this, chars); }
+    jsize GetStringUTFLength(jstring string) { return functions->GetStringUTFLength(this, string); }
+    const char *GetStringUTFChars(jstring string, jboolean *isCopy) { return functions->GetStringUTFChars(this, string, isCopy); }
+    void ReleaseStringUTFChars(jstring string, const char *chars) { functions->ReleaseStringUTFChars(this, string, chars); }
+
+    jsize GetArrayLength(jarray array) { return functions->GetArrayLength(this, array); }
+    jobjectArray NewObjectArray(jsize length, jclass cls, jobject initial) {
+        return functions->NewObjectArray(this, length, cls, initial);
+    }
+    jobject GetObjectArrayElement(jobjectArray array, jsize index) { return functions->GetObjectArrayElement(this, array, index); }
+    void SetObjectArrayElement(jobjectArray array, jsize index, jobject value) {
+        functions->SetObjectArrayElement(this, array, index, value);
+    }
+    jbyteArray NewByteArray(jsize length) { return functions->NewByteArray(this, length); }
+    jintArray NewIntArray(jsize length) { return functions->NewIntArray(this, length); }
+    jlongArray NewLongArray(jsize length) { return functions->NewLongArray(this, length); }
+    jbyte *GetByteArrayElements(jbyteArray array, jboolean *isCopy) { return functions->GetByteArrayElements(this, array, isCopy); }
+    jlong *GetLongArrayElements(jlongArray array, jboolean *isCopy) { return functions->GetLongArrayElements(this, array, isCopy); }
+    void ReleaseByteArrayElements(jbyteArray array, jbyte *elements, jint mode) {
+        functions->ReleaseByteArrayElements(this, array, elements, mode);
+    }
+    void ReleaseLongArrayElements(jlongArray array, jlong *elements, jint mode) {
+        functions->ReleaseLongArrayElements(this, array, elements, mode);
+    }
+    void GetByteArrayRegion(jbyteArray array, jsize start, jsize length, jbyte *buffer) {
+        functions->GetByteArrayRegion(this, array, start, length, buffer);
+    }
+    void GetIntArrayRegion(jintArray array, jsize start, jsize length, jint *buffer) {
+        functions->GetIntArrayRegion(this, array, start, length, buffer);
+    }
+    void GetLongArrayRegion(jlongArray array, jsize start, jsize length, jlong *buffer) {
+        functions->GetLongArrayRegion(this, array, start, length, buffer);
+    }
+    void SetByteArrayRegion(jbyteArray array, jsize start, jsize length, const jbyte *buffer) {
+        functions->SetByteArrayRegion(this, array, start, length, buffer);
+    }
+    void SetIntArrayRegion(jintArray array, jsize start, jsize length, const jint *buffer) {
+        functions->SetIntArrayRegion(this, array, start, length, buffer);
+    }
+    void SetLongArrayRegion(jlongArray array, jsize start, jsize length, const jlong *buffer) {
+        functions->SetLongArrayRegion(this, array, start, length, buffer);
+    }
+
+    jobject NewDirectByteBuffer(void *address, jlong capacity) { return functions->NewDirectByteBuffer(this, address, capacity); }
+    void *GetDirectBufferAddress(jobject buffer) { return functions->GetDirectBufferAddress(this, buffer); }
+    jlong GetDirectBufferCapacity(jobject buffer) { return functions->GetDirectBufferCapacity(this, buffer); }
+};
+
+struct JNIInvokeInterface {
+    jint (*GetEnv)(JavaVM *, void **, jint);
+    jint (*AttachCurrentThread)(JavaVM *, JNIEnv **, void *);
+    jint (*AttachCurrentThreadAsDaemon)(JavaVM *, JNIEnv **, void *);
+    jint (*DetachCurrentThread)(JavaVM *);
+};
+
+struct _JavaVM {
+    const JNIInvokeInterface *functions;
+
+    jint GetEnv(void **env, jint version) { return functions->GetEnv(this, env, version); }
+    jint AttachCurrentThread(JNIEnv **env, void *args) { return functions->AttachCurrentThread(this, env, args); }
+    jint AttachCurrentThreadAsDaemon(JNIEnv **env, void *args) { return functions->AttachCurrentThreadAsDaemon(this, env, args); }
+    jint DetachCurrentThread() { return functions->DetachCurrentThread(this); }
+};
+
+// declared with C linkage like in the NDK header, the definition in the library then isn't mangled
+extern "C" {
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved);
+JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved);
+}
+
+#endif // HOST_FAKE_JNI_H
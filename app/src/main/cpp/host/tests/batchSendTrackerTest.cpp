@@ -0,0 +1,110 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "batchSendTracker.cpp"
+
+TEST(BatchSendTrackerTest, CompletesWhenEveryResultArrived) {
+    BatchSendTracker tracker;
+    std::vector<BatchSendCompletion> completed;
+    uint64_t batchId = tracker.start(2);
+    tracker.onSent(batchId, 0, 10, 0);
+    tracker.onSent(batchId, 1, 11, 0);
+    tracker.onAllSent(batchId, 0, completed);
+    EXPECT_TRUE(completed.empty());
+
+    EXPECT_TRUE(tracker.onDirectSendResult(11, 3, completed));
+    EXPECT_TRUE(completed.empty());
+    EXPECT_TRUE(tracker.onDirectSendResult(10, 2, completed));
+    ASSERT_EQ(1u, completed.size());
+    EXPECT_EQ(batchId, completed[0].batchId);
+    EXPECT_EQ(std::vector<uint64_t>({10, 11}), completed[0].txIds);
+    EXPECT_EQ(std::vector<int32_t>({2, 3}), completed[0].sendStatuses);
+    EXPECT_FALSE(tracker.isTracking());
+}
+
+TEST(BatchSendTrackerTest, AFailedSendHasNoResult) {
+    BatchSendTracker tracker;
+    std::vector<BatchSendCompletion> completed;
+    uint64_t batchId = tracker.start(2);
+    tracker.onSent(batchId, 0, 0, 101);
+    tracker.onSent(batchId, 1, 11, 0);
+    tracker.onDirectSendResult(11, 1, completed);
+    tracker.onAllSent(batchId, 0, completed);
+    ASSERT_EQ(1u, completed.size());
+    EXPECT_EQ(std::vector<uint64_t>({0, 11}), completed[0].txIds);
+    EXPECT_EQ(std::vector<int32_t>({BATCH_SEND_NO_RESULT, 1}), completed[0].sendStatuses);
+}
+
+TEST(BatchSendTrackerTest, KeepsAResultThatBeatTheTxId) {
+    BatchSendTracker tracker;
+    std::vector<BatchSendCompletion> completed;
+    uint64_t batchId = tracker.start(1);
+    EXPECT_FALSE(tracker.onDirectSendResult(10, 4, completed));
+    tracker.onSent(batchId, 0, 10, 0);
+    tracker.onAllSent(batchId, 0, completed);
+    ASSERT_EQ(1u, completed.size());
+    EXPECT_EQ(std::vector<int32_t>({4}), completed[0].sendStatuses);
+}
+
+TEST(BatchSendTrackerTest, IgnoresResultsWithNoBatchSending) {
+    BatchSendTracker tracker;
+    std::vector<BatchSendCompletion> completed;
+    EXPECT_FALSE(tracker.onDirectSendResult(10, 4, completed));
+    // not kept for a batch started later, it waits for a result of its own
+    uint64_t batchId = tracker.start(1);
+    tracker.onSent(batchId, 0, 10, 0);
+    tracker.onAllSent(batchId, 0, completed);
+    EXPECT_TRUE(completed.empty());
+    EXPECT_TRUE(tracker.isTracking());
+}
+
+TEST(BatchSendTrackerTest, ExpiresTheResultsThatNeverCame) {
+    BatchSendTracker tracker;
+    std::vector<BatchSendCompletion> completed;
+    uint64_t batchId = tracker.start(2);
+    tracker.onSent(batchId, 0, 10, 0);
+    tracker.onSent(batchId, 1, 11, 0);
+    tracker.onDirectSendResult(10, 2, completed);
+    tracker.onAllSent(batchId, 1000, completed);
+
+    tracker.expire(1000 + BATCH_SEND_RESULT_TIMEOUT_NANOS - 1, completed);
+    EXPECT_TRUE(completed.empty());
+    tracker.expire(1000 + BATCH_SEND_RESULT_TIMEOUT_NANOS, completed);
+    ASSERT_EQ(1u, completed.size());
+    EXPECT_EQ(std::vector<int32_t>({2, BATCH_SEND_NO_RESULT}), completed[0].sendStatuses);
+    EXPECT_FALSE(tracker.isTracking());
+    // the late result belongs to no batch anymore
+    EXPECT_FALSE(tracker.onDirectSendResult(11, 2, completed));
+    EXPECT_EQ(1u, completed.size());
+}
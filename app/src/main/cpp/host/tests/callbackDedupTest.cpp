@@ -0,0 +1,103 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <cstdint>
+#include "callbackDedup.cpp"
+#include "callbackDispatcher.cpp"
+
+TEST(CallbackDedupTest, SuppressesTheStateLastDelivered) {
+    CallbackDedup dedup;
+    EXPECT_TRUE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 1));
+    EXPECT_FALSE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 1));
+    EXPECT_EQ(1u, dedup.suppressedCount());
+}
+
+TEST(CallbackDedupTest, DeliversEveryChangeOfState) {
+    CallbackDedup dedup;
+    EXPECT_TRUE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 1));
+    EXPECT_TRUE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 2));
+    EXPECT_TRUE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED, 2));
+    // back to an earlier state is a change too, only the last one counts
+    EXPECT_TRUE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 2));
+    EXPECT_TRUE(dedup.isNewState(8, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 2));
+    EXPECT_EQ(0u, dedup.suppressedCount());
+}
+
+TEST(CallbackDedupTest, ACollidingTxEvictsTheSlot) {
+    CallbackDedup dedup;
+    ASSERT_TRUE(dedup.isNewState(1, CALLBACK_TYPE_TX_MINED, 0));
+    // the first tx whose state takes over the slot of tx 1 lets the duplicate of tx 1 through
+    uint64_t colliding = 0;
+    for (uint64_t txId = 2; txId < 2 + CALLBACK_DEDUP_SLOTS * 64 && colliding == 0; txId++) {
+        ASSERT_TRUE(dedup.isNewState(txId, CALLBACK_TYPE_TX_MINED, 0));
+        if (dedup.isNewState(1, CALLBACK_TYPE_TX_MINED, 0)) {
+            colliding = txId;
+        }
+    }
+    ASSERT_NE(0u, colliding);
+    // and tx 1 evicted it in turn
+    EXPECT_TRUE(dedup.isNewState(colliding, CALLBACK_TYPE_TX_MINED, 0));
+}
+
+TEST(CallbackDedupTest, ClearAndDisableForgetTheStates) {
+    CallbackDedup dedup;
+    dedup.isNewState(7, CALLBACK_TYPE_TX_MINED, 0);
+    dedup.clear();
+    EXPECT_TRUE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED, 0));
+
+    dedup.setEnabled(false);
+    EXPECT_TRUE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED, 0));
+    EXPECT_TRUE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED, 0));
+    dedup.setEnabled(true);
+    EXPECT_TRUE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED, 0));
+    EXPECT_FALSE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED, 0));
+}
+
+TEST(CallbackDedupTest, ADroppedStateDoesNotSuppressItsRepeat) {
+    CallbackDedup dedup;
+    ASSERT_TRUE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 1));
+    dedup.forget(7, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 1);
+    EXPECT_TRUE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 1));
+    EXPECT_FALSE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 1));
+}
+
+TEST(CallbackDedupTest, ForgetKeepsAStateRecordedSince) {
+    CallbackDedup dedup;
+    ASSERT_TRUE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 1));
+    ASSERT_TRUE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 2));
+    // the delivery of the first state was dropped after the second was recorded
+    dedup.forget(7, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 1);
+    EXPECT_FALSE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 2));
+    dedup.forget(8, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 2);
+    EXPECT_FALSE(dedup.isNewState(7, CALLBACK_TYPE_TX_MINED_UNCONFIRMED, 2));
+}
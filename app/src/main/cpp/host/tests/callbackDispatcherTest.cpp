@@ -0,0 +1,128 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "callbackDispatcher.cpp"
+
+namespace {
+
+/**
+ * Holds the dispatcher thread in the first delivery until released, so the next posts queue up.
+ */
+class Blocker {
+public:
+    void block() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        blocking_ = true;
+        changed_.notify_all();
+        changed_.wait(lock, [this] { return released_; });
+    }
+
+    void awaitBlocking() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [this] { return blocking_; });
+    }
+
+    void release() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        released_ = true;
+        changed_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    bool blocking_ = false;
+    bool released_ = false;
+};
+
+}
+
+TEST(CallbackDispatcherTest, DeliversTheHighestLaneFirstInPostOrder) {
+    std::string delivered;
+    {
+        Blocker blocker;
+        CallbackDispatcher dispatcher;
+        dispatcher.post(CALLBACK_TYPE_TX_RECEIVED, [&blocker] { blocker.block(); }, [] {});
+        blocker.awaitBlocking();
+        dispatcher.post(CALLBACK_TYPE_CONNECTIVITY_STATUS, [&delivered] { delivered += "l"; }, [] {});
+        dispatcher.post(CALLBACK_TYPE_BALANCE_UPDATED, [&delivered] { delivered += "n"; }, [] {});
+        dispatcher.post(CALLBACK_TYPE_TX_MINED, [&delivered] { delivered += "1"; }, [] {});
+        dispatcher.post(CALLBACK_TYPE_TX_BROADCAST, [&delivered] { delivered += "2"; }, [] {});
+        blocker.release();
+        // the queued callbacks are delivered before the dispatcher stops
+    }
+    EXPECT_EQ("12nl", delivered);
+}
+
+TEST(CallbackDispatcherTest, AFullLaneDropsItsOldestCallback) {
+    uint64_t droppedBefore = g_callbackDroppedCount.load();
+    size_t deliveredCount = 0;
+    size_t firstDelivered = 0;
+    std::vector<size_t> dropped;
+    {
+        Blocker blocker;
+        CallbackDispatcher dispatcher;
+        dispatcher.post(CALLBACK_TYPE_TX_RECEIVED, [&blocker] { blocker.block(); }, [] {});
+        blocker.awaitBlocking();
+        for (size_t i = 0; i < CALLBACK_LANE_CAPACITY + 2; i++) {
+            dispatcher.post(CALLBACK_TYPE_TX_MINED, [&, i] {
+                if (deliveredCount++ == 0) {
+                    firstDelivered = i;
+                }
+            }, [&dropped, i] { dropped.push_back(i); });
+        }
+        // the other lanes keep their room
+        dispatcher.post(CALLBACK_TYPE_BALANCE_UPDATED, [&deliveredCount] { deliveredCount++; }, [] {});
+        blocker.release();
+    }
+    EXPECT_EQ(std::vector<size_t>({0, 1}), dropped);
+    EXPECT_EQ(2u, g_callbackDroppedCount.load() - droppedBefore);
+    EXPECT_EQ(CALLBACK_LANE_CAPACITY + 1, deliveredCount);
+    EXPECT_EQ(2u, firstDelivered);
+}
+
+TEST(CallbackDispatcherTest, RunsTheExitHookOnItsThread) {
+    std::thread::id hookThread;
+    std::thread::id deliveryThread;
+    {
+        CallbackDispatcher dispatcher([&hookThread] { hookThread = std::this_thread::get_id(); });
+        dispatcher.post(CALLBACK_TYPE_TX_RECEIVED, [&deliveryThread] { deliveryThread = std::this_thread::get_id(); }, [] {});
+    }
+    EXPECT_EQ(deliveryThread, hookThread);
+    EXPECT_NE(std::this_thread::get_id(), hookThread);
+}
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "callbackGate.cpp"
+
+TEST(CallbackGateTest, StartsClosed) {
+    CallbackGate gate;
+    EXPECT_FALSE(gate.isOpen());
+    EXPECT_FALSE(gate.tryEnter());
+    EXPECT_EQ(1u, gate.droppedCount());
+    EXPECT_FALSE(gate.close());
+}
+
+TEST(CallbackGateTest, TheOwnerFreesTheHandlerWithNothingInFlight) {
+    CallbackGate gate;
+    gate.open();
+    EXPECT_TRUE(gate.isOpen());
+    ASSERT_TRUE(gate.tryEnter());
+    EXPECT_FALSE(gate.leave());
+    EXPECT_TRUE(gate.close());
+    EXPECT_FALSE(gate.isOpen());
+    gate.waitUntilReleased();
+}
+
+TEST(CallbackGateTest, TheLastCallbackInFlightFreesTheHandler) {
+    CallbackGate gate;
+    gate.open();
+    ASSERT_TRUE(gate.tryEnter());
+    ASSERT_TRUE(gate.tryEnter());
+    EXPECT_FALSE(gate.close());
+    // closed, new callbacks are dropped while the ones in flight finish
+    EXPECT_FALSE(gate.tryEnter());
+    EXPECT_EQ(1u, gate.droppedCount());
+    EXPECT_FALSE(gate.leave());
+    EXPECT_TRUE(gate.leave());
+    gate.waitUntilReleased();
+}
+
+TEST(CallbackGateTest, EveryOpenIsANewGeneration) {
+    CallbackGate gate;
+    gate.open();
+    uint64_t first = gate.generation();
+    EXPECT_TRUE(gate.close());
+    gate.open();
+    EXPECT_NE(first, gate.generation());
+    EXPECT_TRUE(gate.close());
+}
+
+TEST(CallbackGateTest, ExactlyOneReleaseFreesTheHandler) {
+    constexpr int THREAD_COUNT = 8;
+    constexpr int ENTRIES_PER_THREAD = 10000;
+    for (int round = 0; round < 20; round++) {
+        CallbackGate gate;
+        gate.open();
+        std::atomic<int> freed{0};
+        std::vector<std::thread> threads;
+        for (int i = 0; i < THREAD_COUNT; i++) {
+            threads.emplace_back([&gate, &freed] {
+                for (int j = 0; j < ENTRIES_PER_THREAD; j++) {
+                    if (gate.tryEnter() && gate.leave()) {
+                        freed++;
+                    }
+                }
+            });
+        }
+        if (gate.close()) {
+            freed++;
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        gate.waitUntilReleased();
+        EXPECT_EQ(1, freed.load());
+    }
+}
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "callbackSubscriptions.cpp"
+
+TEST(CallbackSubscriptionsTest, WantsEveryTypeUntilUpdated) {
+    CallbackSubscriptions subscriptions;
+    EXPECT_TRUE(subscriptions.wants(0));
+    EXPECT_TRUE(subscriptions.wants(31));
+    EXPECT_FALSE(subscriptions.filtersTxIds(0));
+    EXPECT_FALSE(subscriptions.containsTxId(1));
+}
+
+TEST(CallbackSubscriptionsTest, TheMasksSelectTheTypes) {
+    CallbackSubscriptions subscriptions;
+    subscriptions.update(0b0101, {}, 0b0100);
+    EXPECT_TRUE(subscriptions.wants(0));
+    EXPECT_FALSE(subscriptions.wants(1));
+    EXPECT_TRUE(subscriptions.wants(2));
+    EXPECT_FALSE(subscriptions.filtersTxIds(0));
+    EXPECT_TRUE(subscriptions.filtersTxIds(2));
+}
+
+TEST(CallbackSubscriptionsTest, FindsTheTxIdsInAnyOrder) {
+    CallbackSubscriptions subscriptions;
+    subscriptions.update(CallbackSubscriptions::ALL_TYPES, {30, 10, 20}, 1);
+    EXPECT_TRUE(subscriptions.containsTxId(10));
+    EXPECT_TRUE(subscriptions.containsTxId(20));
+    EXPECT_TRUE(subscriptions.containsTxId(30));
+    EXPECT_FALSE(subscriptions.containsTxId(15));
+
+    subscriptions.update(CallbackSubscriptions::ALL_TYPES, {15}, 1);
+    EXPECT_TRUE(subscriptions.containsTxId(15));
+    EXPECT_FALSE(subscriptions.containsTxId(10));
+}
+
+TEST(CallbackSubscriptionsTest, CountsTheFilteredCallbacks) {
+    CallbackSubscriptions subscriptions;
+    subscriptions.recordFiltered();
+    subscriptions.recordFiltered();
+    EXPECT_EQ(2u, subscriptions.filteredCount());
+}
+
+TEST(CallbackSubscriptionsTest, ReadersNeverSeeASetBeingRewritten) {
+    // every set holds tx 42, a reader of a half written set would miss it
+    CallbackSubscriptions subscriptions;
+    subscriptions.update(CallbackSubscriptions::ALL_TYPES, {42}, 1);
+    std::atomic<bool> done{false};
+    std::atomic<int> missed{0};
+    std::thread reader([&] {
+        while (!done) {
+            if (!subscriptions.containsTxId(42)) {
+                missed++;
+            }
+        }
+    });
+    for (uint64_t round = 1; round < 2000; round++) {
+        std::vector<uint64_t> txIds;
+        for (uint64_t txId = 0; txId < round % 64; txId++) {
+            txIds.push_back(txId * 1000 + round);
+        }
+        txIds.push_back(42);
+        subscriptions.update(CallbackSubscriptions::ALL_TYPES, std::move(txIds), 1);
+    }
+    done = true;
+    reader.join();
+    EXPECT_EQ(0, missed.load());
+}
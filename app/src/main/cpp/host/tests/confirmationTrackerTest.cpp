@@ -0,0 +1,106 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+#include "confirmationTracker.cpp"
+
+TEST(ConfirmationTrackerTest, ReportsTheTxsWhoseConfirmationsChanged) {
+    ConfirmationTracker tracker;
+    tracker.track(1, 100, 0);
+    tracker.track(2, 101, 0);
+    EXPECT_TRUE(tracker.isTracking());
+
+    std::vector<uint64_t> txIds;
+    std::vector<uint64_t> confirmations;
+    ASSERT_TRUE(tracker.onTip(101, txIds, confirmations));
+    EXPECT_EQ(std::vector<uint64_t>({1}), txIds);
+    EXPECT_EQ(std::vector<uint64_t>({1}), confirmations);
+
+    txIds.clear();
+    confirmations.clear();
+    EXPECT_FALSE(tracker.onTip(101, txIds, confirmations));
+    EXPECT_TRUE(txIds.empty());
+}
+
+TEST(ConfirmationTrackerTest, StopsTrackingAtTheRequiredConfirmations) {
+    ConfirmationTracker tracker;
+    tracker.track(1, 100, 0);
+    std::vector<uint64_t> txIds;
+    std::vector<uint64_t> confirmations;
+    ASSERT_TRUE(tracker.onTip(100 + DEFAULT_REQUIRED_CONFIRMATIONS, txIds, confirmations));
+    // the last change is still reported
+    EXPECT_EQ(std::vector<uint64_t>({1}), txIds);
+    EXPECT_EQ(std::vector<uint64_t>({DEFAULT_REQUIRED_CONFIRMATIONS}), confirmations);
+    EXPECT_FALSE(tracker.isTracking());
+}
+
+TEST(ConfirmationTrackerTest, ATxConfirmedEnoughIsNotTracked) {
+    ConfirmationTracker tracker;
+    tracker.setRequired(5);
+    tracker.track(1, 100, 5);
+    EXPECT_FALSE(tracker.isTracking());
+    tracker.track(1, 100, 4);
+    EXPECT_TRUE(tracker.isTracking());
+    tracker.track(1, 100, 5);
+    EXPECT_FALSE(tracker.isTracking());
+}
+
+TEST(ConfirmationTrackerTest, AReorgBelowTheMinedHeightCountsAsNoConfirmation) {
+    ConfirmationTracker tracker;
+    tracker.track(1, 100, 2);
+    std::vector<uint64_t> txIds;
+    std::vector<uint64_t> confirmations;
+    ASSERT_TRUE(tracker.onTip(90, txIds, confirmations));
+    EXPECT_EQ(std::vector<uint64_t>({1}), txIds);
+    EXPECT_EQ(std::vector<uint64_t>({0}), confirmations);
+    EXPECT_TRUE(tracker.isTracking());
+}
+
+TEST(ConfirmationTrackerTest, ForgetAndClearDropTheTxs) {
+    ConfirmationTracker tracker;
+    tracker.track(1, 100, 0);
+    tracker.track(2, 100, 0);
+    tracker.track(3, 100, 0);
+    tracker.forget(1);
+    std::vector<uint64_t> txIds;
+    std::vector<uint64_t> confirmations;
+    ASSERT_TRUE(tracker.onTip(101, txIds, confirmations));
+    std::sort(txIds.begin(), txIds.end());
+    EXPECT_EQ(std::vector<uint64_t>({2, 3}), txIds);
+
+    tracker.clear();
+    EXPECT_FALSE(tracker.isTracking());
+    txIds.clear();
+    EXPECT_FALSE(tracker.onTip(102, txIds, confirmations));
+}
@@ -0,0 +1,159 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+#include "handleScope.cpp"
+
+namespace {
+
+constexpr int SMALL = 0;
+constexpr int LARGE = 1;
+
+int g_destroyedCount = 0;
+
+void DestroyInt(void *pointer) {
+    delete static_cast<int *>(pointer);
+    g_destroyedCount++;
+}
+
+/**
+ * Scopes of a small and a large type of heap ints, counting what was destroyed.
+ */
+class HandleScopeTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        g_destroyedCount = 0;
+    }
+
+    HandleScopes scopes_{{
+            HandleTypeInfo{"Small", DestroyInt, [](void *) -> size_t { return 8; }},
+            HandleTypeInfo{"Large", DestroyInt, [](void *) -> size_t { return 100; }},
+    }};
+
+    void *handOut(int type) {
+        void *pointer = new int(0);
+        scopes_.onHandedOut(type, pointer);
+        return pointer;
+    }
+};
+
+}
+
+TEST_F(HandleScopeTest, CountsTheLiveHandlesOfEveryType) {
+    EXPECT_EQ(2u, scopes_.typeCount());
+    EXPECT_STREQ("Large", scopes_.typeName(LARGE));
+    void *pSmall = handOut(SMALL);
+    void *pLarge = handOut(LARGE);
+    void *pOtherLarge = handOut(LARGE);
+    EXPECT_EQ(1, scopes_.stats(SMALL).liveCount);
+    EXPECT_EQ(8, scopes_.stats(SMALL).liveBytes);
+    EXPECT_EQ(2, scopes_.stats(LARGE).liveCount);
+    EXPECT_EQ(200, scopes_.stats(LARGE).liveBytes);
+
+    scopes_.destroy(SMALL, pSmall);
+    scopes_.destroy(LARGE, pLarge);
+    EXPECT_EQ(0, scopes_.stats(SMALL).liveCount);
+    EXPECT_EQ(1, scopes_.stats(SMALL).createdCount);
+    EXPECT_EQ(1, scopes_.stats(LARGE).liveCount);
+    EXPECT_EQ(100, scopes_.stats(LARGE).liveBytes);
+    EXPECT_EQ(2, scopes_.stats(LARGE).createdCount);
+    EXPECT_EQ(2, g_destroyedCount);
+    scopes_.destroy(LARGE, pOtherLarge);
+}
+
+TEST_F(HandleScopeTest, ClosingAScopeDestroysWhatItHandedOut) {
+    void *pOutside = handOut(SMALL);
+    uint64_t scope = scopes_.open();
+    void *pFirst = handOut(SMALL);
+    void *pSecond = handOut(LARGE);
+    std::vector<void *> released;
+    ASSERT_TRUE(scopes_.close(scope, released));
+    std::sort(released.begin(), released.end());
+    std::vector<void *> expected = {pFirst, pSecond};
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(expected, released);
+    EXPECT_EQ(2, g_destroyedCount);
+    EXPECT_EQ(1, scopes_.stats(SMALL).liveCount);
+    EXPECT_EQ(0, scopes_.stats(LARGE).liveCount);
+    scopes_.destroy(SMALL, pOutside);
+}
+
+TEST_F(HandleScopeTest, AHandleDestroyedOrKeptLeavesTheScope) {
+    uint64_t scope = scopes_.open();
+    void *pDestroyed = handOut(SMALL);
+    void *pKept = handOut(SMALL);
+    scopes_.destroy(SMALL, pDestroyed);
+    EXPECT_TRUE(scopes_.keep(pKept));
+    EXPECT_FALSE(scopes_.keep(pKept));
+    std::vector<void *> released;
+    ASSERT_TRUE(scopes_.close(scope, released));
+    EXPECT_TRUE(released.empty());
+    EXPECT_EQ(1, scopes_.stats(SMALL).liveCount);
+    scopes_.destroy(SMALL, pKept);
+}
+
+TEST_F(HandleScopeTest, OnlyTheInnermostScopeCloses) {
+    uint64_t outer = scopes_.open();
+    void *pOuter = handOut(SMALL);
+    uint64_t inner = scopes_.open();
+    void *pInner = handOut(SMALL);
+    std::vector<void *> released;
+    EXPECT_FALSE(scopes_.close(outer, released));
+    ASSERT_TRUE(scopes_.close(inner, released));
+    EXPECT_EQ(std::vector<void *>({pInner}), released);
+    released.clear();
+    ASSERT_TRUE(scopes_.close(outer, released));
+    EXPECT_EQ(std::vector<void *>({pOuter}), released);
+    EXPECT_FALSE(scopes_.close(outer, released));
+}
+
+TEST_F(HandleScopeTest, AScopeBelongsToTheThreadThatOpenedIt) {
+    uint64_t scope = scopes_.open();
+    void *pOtherThread = nullptr;
+    bool closedOnOtherThread = true;
+    std::thread other([&] {
+        // no scope open on this thread, the handle is left to its owner
+        pOtherThread = handOut(SMALL);
+        std::vector<void *> released;
+        closedOnOtherThread = scopes_.close(scope, released);
+    });
+    other.join();
+    EXPECT_FALSE(closedOnOtherThread);
+    std::vector<void *> released;
+    ASSERT_TRUE(scopes_.close(scope, released));
+    EXPECT_TRUE(released.empty());
+    scopes_.destroy(SMALL, pOtherThread);
+    EXPECT_EQ(1, g_destroyedCount);
+}
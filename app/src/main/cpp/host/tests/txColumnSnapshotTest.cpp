@@ -0,0 +1,111 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "txColumnSnapshot.cpp"
+
+namespace {
+
+TxColumnRow MakeRow(int64_t timestamp, uint64_t amount, uint64_t fee, bool isOutbound, uint8_t counterparty) {
+    TxColumnRow row;
+    row.timestamp = timestamp;
+    row.amount = amount;
+    row.fee = fee;
+    row.isOutbound = isOutbound;
+    row.counterparty = {counterparty};
+    return row;
+}
+
+// received 100 at 5, sent 30 + 1 at 15, received 50 at 12, sent 10 + 2 at 25, out of timestamp order on purpose
+TxColumnSnapshot MakeSnapshot() {
+    return TxColumnSnapshot({
+            MakeRow(5, 100, 0, false, 1),
+            MakeRow(15, 30, 1, true, 2),
+            MakeRow(12, 50, 0, false, 1),
+            MakeRow(25, 10, 2, true, 3),
+    });
+}
+
+}
+
+TEST(TxColumnSnapshotTest, InternsTheCounterparties) {
+    TxColumnSnapshot snapshot = MakeSnapshot();
+    EXPECT_EQ(4u, snapshot.size());
+    ASSERT_EQ(3u, snapshot.counterpartyCount());
+    EXPECT_EQ(std::vector<uint8_t>({1}), snapshot.counterparty(0));
+    EXPECT_EQ(std::vector<uint8_t>({3}), snapshot.counterparty(2));
+}
+
+TEST(TxColumnSnapshotTest, CountsTheBuckets) {
+    EXPECT_EQ(3u, TxColumnSnapshot::bucketCount(0, 30, 10));
+    EXPECT_EQ(4u, TxColumnSnapshot::bucketCount(0, 31, 10));
+    EXPECT_EQ(1u, TxColumnSnapshot::bucketCount(0, 1, 10));
+    EXPECT_EQ(0u, TxColumnSnapshot::bucketCount(10, 10, 10));
+    EXPECT_EQ(0u, TxColumnSnapshot::bucketCount(0, 30, 0));
+}
+
+TEST(TxColumnSnapshotTest, SumsTheVolumesOfEveryBucket) {
+    TxColumnSnapshot snapshot = MakeSnapshot();
+    std::vector<TxTotals> totals(TxColumnSnapshot::bucketCount(0, 30, 10));
+    snapshot.volumes(0, 30, 10, totals.data());
+    EXPECT_EQ(100u, totals[0].received);
+    EXPECT_EQ(1u, totals[0].count);
+    EXPECT_EQ(50u, totals[1].received);
+    EXPECT_EQ(30u, totals[1].sent);
+    EXPECT_EQ(1u, totals[1].fees);
+    EXPECT_EQ(2u, totals[1].count);
+    EXPECT_EQ(10u, totals[2].sent);
+    EXPECT_EQ(2u, totals[2].fees);
+}
+
+TEST(TxColumnSnapshotTest, RunningBalancesStartFromTheTxsBeforeTheRange) {
+    TxColumnSnapshot snapshot = MakeSnapshot();
+    std::vector<int64_t> balances(TxColumnSnapshot::bucketCount(10, 40, 10));
+    snapshot.runningBalances(10, 40, 10, balances.data());
+    EXPECT_EQ(std::vector<int64_t>({100 + 50 - 31, 119 - 12, 107}), balances);
+
+    // the last bucket is cut at the end of the range
+    std::vector<int64_t> cut(TxColumnSnapshot::bucketCount(0, 13, 10));
+    snapshot.runningBalances(0, 13, 10, cut.data());
+    EXPECT_EQ(std::vector<int64_t>({100, 150}), cut);
+}
+
+TEST(TxColumnSnapshotTest, SumsTheTotalsOfEveryCounterparty) {
+    TxColumnSnapshot snapshot = MakeSnapshot();
+    std::vector<TxTotals> totals(snapshot.counterpartyCount());
+    snapshot.counterpartyTotals(0, 20, totals.data());
+    EXPECT_EQ(150u, totals[0].received);
+    EXPECT_EQ(2u, totals[0].count);
+    EXPECT_EQ(30u, totals[1].sent);
+    EXPECT_EQ(0u, totals[2].count);
+}
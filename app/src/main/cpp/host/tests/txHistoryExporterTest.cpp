@@ -0,0 +1,149 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "txHistoryExporter.cpp"
+
+namespace {
+
+TxExportRecord MakeRecord() {
+    TxExportRecord record;
+    record.kind = "completed";
+    record.id = 18446744073709551615ULL;
+    record.status = 6;
+    record.isOutbound = true;
+    record.amount = 1000;
+    record.fee = 25;
+    record.timestamp = 1700000000;
+    record.minedTimestamp = 1700000060;
+    record.minedHeight = 4321;
+    record.sourceAddress = "src";
+    record.destinationAddress = "dst";
+    record.paymentId = "lunch";
+    record.kernelExcess = "abcd";
+    record.paymentReferences = std::string(TX_EXPORT_PAYMENT_REFERENCE_HEX_SIZE, 'a') + std::string(TX_EXPORT_PAYMENT_REFERENCE_HEX_SIZE, 'b');
+    return record;
+}
+
+/**
+ * Writes the records to a temporary file and reads back what was written.
+ */
+std::string Export(int format, const std::vector<TxExportRecord> &records) {
+    FILE *pFile = tmpfile();
+    EXPECT_NE(nullptr, pFile);
+    TxHistoryExportWriter writer(fileno(pFile), format);
+    EXPECT_TRUE(writer.begin());
+    for (const TxExportRecord &record : records) {
+        EXPECT_TRUE(writer.write(record));
+    }
+    EXPECT_TRUE(writer.finish());
+    EXPECT_EQ(records.size(), writer.rowCount());
+    std::string text;
+    rewind(pFile);
+    char chunk[4096];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), pFile)) > 0) {
+        text.append(chunk, read);
+    }
+    fclose(pFile);
+    return text;
+}
+
+const std::string CSV_HEADER = "kind,id,status,direction,amount,fee,timestamp,mined_timestamp,mined_height,source_address,"
+                               "destination_address,payment_id,kernel_excess,payment_references\r\n";
+
+}
+
+TEST(TxHistoryExporterTest, WritesCsvRows) {
+    std::string references = std::string(TX_EXPORT_PAYMENT_REFERENCE_HEX_SIZE, 'a') + " " + std::string(TX_EXPORT_PAYMENT_REFERENCE_HEX_SIZE, 'b');
+    EXPECT_EQ(CSV_HEADER +
+              "completed,18446744073709551615,mined_confirmed,outbound,1000,25,2023-11-14T22:13:20Z,2023-11-14T22:14:20Z,4321,"
+              "src,dst,lunch,abcd," + references + "\r\n",
+              Export(TX_EXPORT_FORMAT_CSV, {MakeRecord()}));
+}
+
+TEST(TxHistoryExporterTest, LeavesTheMiningOfAnUnminedTxEmpty) {
+    TxExportRecord record;
+    record.kind = "pending_inbound";
+    record.status = 4;
+    EXPECT_EQ(CSV_HEADER + "pending_inbound,0,pending,inbound,0,0,,,,,,,,\r\n", Export(TX_EXPORT_FORMAT_CSV, {record}));
+}
+
+TEST(TxHistoryExporterTest, QuotesCsvTextAndDefusesFormulas) {
+    TxExportRecord record = MakeRecord();
+    record.paymentReferences.clear();
+    record.paymentId = "a,\"b\"";
+    std::string quoted = Export(TX_EXPORT_FORMAT_CSV, {record});
+    EXPECT_NE(std::string::npos, quoted.find(",\"a,\"\"b\"\"\",abcd,\r\n"));
+
+    record.paymentId = "=SUM(A1)";
+    std::string formula = Export(TX_EXPORT_FORMAT_CSV, {record});
+    EXPECT_NE(std::string::npos, formula.find(",\"'=SUM(A1)\",abcd,\r\n"));
+}
+
+TEST(TxHistoryExporterTest, NamesUnknownStatuses) {
+    TxExportRecord record;
+    record.status = 99;
+    EXPECT_NE(std::string::npos, Export(TX_EXPORT_FORMAT_CSV, {record}).find(",0,unknown,"));
+    record.status = -2;
+    EXPECT_NE(std::string::npos, Export(TX_EXPORT_FORMAT_CSV, {record}).find(",0,unknown,"));
+}
+
+TEST(TxHistoryExporterTest, WritesJsonObjects) {
+    TxExportRecord unmined;
+    unmined.kind = "cancelled";
+    unmined.id = 7;
+    unmined.paymentId = "a\"b\\c\n";
+    EXPECT_EQ("[\n{\"kind\":\"completed\",\"id\":\"18446744073709551615\",\"status\":\"mined_confirmed\",\"direction\":\"outbound\","
+              "\"amount\":1000,\"fee\":25,\"timestamp\":\"2023-11-14T22:13:20Z\",\"mined_timestamp\":\"2023-11-14T22:14:20Z\","
+              "\"mined_height\":4321,\"source_address\":\"src\",\"destination_address\":\"dst\",\"payment_id\":\"lunch\","
+              "\"kernel_excess\":\"abcd\",\"payment_references\":[\"" + std::string(TX_EXPORT_PAYMENT_REFERENCE_HEX_SIZE, 'a') +
+              "\",\"" + std::string(TX_EXPORT_PAYMENT_REFERENCE_HEX_SIZE, 'b') + "\"]},\n"
+              "{\"kind\":\"cancelled\",\"id\":\"7\",\"status\":\"null_error\",\"direction\":\"inbound\",\"amount\":0,\"fee\":0,"
+              "\"timestamp\":null,\"mined_timestamp\":null,\"mined_height\":null,\"source_address\":\"\",\"destination_address\":\"\","
+              "\"payment_id\":\"a\\\"b\\\\c\\u000a\",\"kernel_excess\":\"\",\"payment_references\":[]}\n]\n",
+              Export(TX_EXPORT_FORMAT_JSON, {MakeRecord(), unmined}));
+}
+
+TEST(TxHistoryExporterTest, WritesAnEmptyJsonArray) {
+    EXPECT_EQ("[]\n", Export(TX_EXPORT_FORMAT_JSON, {}));
+}
+
+TEST(TxHistoryExporterTest, ReportsTheWriteError) {
+    TxHistoryExportWriter writer(-1, TX_EXPORT_FORMAT_CSV);
+    writer.begin();
+    EXPECT_FALSE(writer.finish());
+    EXPECT_EQ(EBADF, writer.writeError());
+}
@@ -0,0 +1,186 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+#include "txHistoryIndex.cpp"
+
+namespace {
+
+TxHistoryRow MakeRow(uint64_t id, uint64_t amount, uint64_t timestamp, bool isOutbound, uint8_t counterparty, const std::string &paymentId) {
+    TxHistoryRow row;
+    row.id = id;
+    row.amount = amount;
+    row.fee = id;
+    row.timestamp = timestamp;
+    row.isOutbound = isOutbound;
+    row.counterparty = {counterparty, 0xAB};
+    row.paymentId = paymentId;
+    return row;
+}
+
+std::vector<int64_t> QueryIds(TxHistoryIndex &index, const TxHistoryQuery &query) {
+    TxHistoryColumns columns;
+    EXPECT_TRUE(index.query(query, false, columns)) << index.lastError();
+    return columns.ids;
+}
+
+/**
+ * An index in a database file of its own, removed with the test.
+ */
+class TxHistoryIndexTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char path[] = "/tmp/txHistoryIndexTestXXXXXX";
+        int fd = mkstemp(path);
+        ASSERT_NE(-1, fd);
+        ::close(fd);
+        path_ = path;
+        ASSERT_TRUE(index_.open(path_)) << index_.lastError();
+    }
+
+    void TearDown() override {
+        index_.close();
+        for (const char *suffix : {"", "-wal", "-shm"}) {
+            std::remove((path_ + suffix).c_str());
+        }
+    }
+
+    std::string path_;
+    TxHistoryIndex index_;
+};
+
+}
+
+TEST_F(TxHistoryIndexTest, AsksForOneFlushUntilItRan) {
+    EXPECT_TRUE(index_.enqueue(MakeRow(1, 100, 10, false, 1, "")));
+    EXPECT_FALSE(index_.enqueue(MakeRow(2, 200, 20, false, 1, "")));
+    EXPECT_TRUE(index_.flush());
+    EXPECT_TRUE(index_.enqueue(MakeRow(3, 300, 30, false, 1, "")));
+}
+
+TEST_F(TxHistoryIndexTest, AQuerySeesTheQueuedRows) {
+    index_.enqueue(MakeRow(1, 100, 10, false, 1, ""));
+    index_.enqueue(MakeRow(2, 200, 20, true, 1, ""));
+    EXPECT_EQ(std::vector<int64_t>({2, 1}), QueryIds(index_, TxHistoryQuery()));
+    EXPECT_EQ(2, index_.count(TxHistoryQuery()));
+}
+
+TEST_F(TxHistoryIndexTest, ALaterRowOfATxReplacesItsRow) {
+    index_.enqueue(MakeRow(1, 100, 10, false, 1, ""));
+    TxHistoryRow mined = MakeRow(1, 100, 10, false, 1, "");
+    mined.status = 6;
+    index_.enqueue(mined);
+    TxHistoryColumns columns;
+    ASSERT_TRUE(index_.query(TxHistoryQuery(), true, columns));
+    ASSERT_EQ(1u, columns.ids.size());
+    EXPECT_EQ(6, columns.statuses[0]);
+    EXPECT_EQ(100, columns.amounts[0]);
+    EXPECT_EQ(1, columns.fees[0]);
+    EXPECT_EQ(10, columns.timestamps[0]);
+}
+
+TEST_F(TxHistoryIndexTest, FiltersAndOrders) {
+    std::vector<TxHistoryRow> rows;
+    for (uint64_t id = 1; id <= 10; id++) {
+        rows.push_back(MakeRow(id, (11 - id) * 100, id * 10, id % 2 == 0, static_cast<uint8_t>(id % 3), ""));
+    }
+    ASSERT_TRUE(index_.replaceAll(rows));
+
+    TxHistoryQuery outbound;
+    outbound.filter[TX_HISTORY_FILTER_DIRECTION] = TX_HISTORY_DIRECTION_OUTBOUND;
+    EXPECT_EQ(std::vector<int64_t>({10, 8, 6, 4, 2}), QueryIds(index_, outbound));
+
+    TxHistoryQuery amounts;
+    amounts.filter[TX_HISTORY_FILTER_MIN_AMOUNT] = 300;
+    amounts.filter[TX_HISTORY_FILTER_MAX_AMOUNT] = 500;
+    amounts.filter[TX_HISTORY_FILTER_ORDER] = TX_HISTORY_ORDER_SMALLEST_FIRST;
+    EXPECT_EQ(std::vector<int64_t>({8, 7, 6}), QueryIds(index_, amounts));
+
+    TxHistoryQuery period;
+    period.filter[TX_HISTORY_FILTER_FROM_TIMESTAMP] = 30;
+    period.filter[TX_HISTORY_FILTER_TO_TIMESTAMP] = 60;
+    period.filter[TX_HISTORY_FILTER_ORDER] = TX_HISTORY_ORDER_OLDEST_FIRST;
+    EXPECT_EQ(std::vector<int64_t>({3, 4, 5}), QueryIds(index_, period));
+
+    TxHistoryQuery counterparty;
+    counterparty.counterparty = {0, 0xAB};
+    EXPECT_EQ(std::vector<int64_t>({9, 6, 3}), QueryIds(index_, counterparty));
+
+    TxHistoryQuery page;
+    page.filter[TX_HISTORY_FILTER_LIMIT] = 3;
+    page.filter[TX_HISTORY_FILTER_OFFSET] = 2;
+    EXPECT_EQ(std::vector<int64_t>({8, 7, 6}), QueryIds(index_, page));
+    EXPECT_EQ(10, index_.count(page));
+}
+
+TEST_F(TxHistoryIndexTest, SearchesPaymentIdsAndAliases) {
+    index_.enqueue(MakeRow(1, 100, 10, false, 1, "coffee beans"));
+    index_.enqueue(MakeRow(2, 100, 20, false, 2, "rent"));
+    index_.enqueue(MakeRow(3, 100, 30, false, 3, "100%_off"));
+    ASSERT_TRUE(index_.setAliases({{{2, 0xAB}, "Alice"}}));
+
+    TxHistoryQuery query;
+    query.text = "cof";
+    EXPECT_EQ(std::vector<int64_t>({1}), QueryIds(index_, query));
+    query.text = "ali";
+    EXPECT_EQ(std::vector<int64_t>({2}), QueryIds(index_, query));
+    query.text = "rent ali";
+    EXPECT_EQ(std::vector<int64_t>({2}), QueryIds(index_, query));
+    query.text = "rent coffee";
+    EXPECT_TRUE(QueryIds(index_, query).empty());
+    // wildcards of LIKE match only themselves
+    query.text = "100%_";
+    EXPECT_EQ(std::vector<int64_t>({3}), QueryIds(index_, query));
+}
+
+TEST_F(TxHistoryIndexTest, ClearDropsTheRowsAndTheQueue) {
+    ASSERT_TRUE(index_.replaceAll({MakeRow(1, 100, 10, false, 1, "")}));
+    index_.enqueue(MakeRow(2, 100, 20, false, 1, ""));
+    ASSERT_TRUE(index_.clear());
+    EXPECT_EQ(0, index_.count(TxHistoryQuery()));
+}
+
+TEST_F(TxHistoryIndexTest, KeepsTheRowsWhenReopened) {
+    index_.enqueue(MakeRow(1, 100, 10, false, 1, "coffee"));
+    ASSERT_TRUE(index_.flush());
+    index_.close();
+    EXPECT_FALSE(index_.isOpen());
+    EXPECT_EQ(-1, index_.count(TxHistoryQuery()));
+
+    ASSERT_TRUE(index_.open(path_));
+    TxHistoryQuery query;
+    query.text = "coffee";
+    EXPECT_EQ(std::vector<int64_t>({1}), QueryIds(index_, query));
+}
@@ -0,0 +1,135 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <vector>
+#include "txLifecycleTracker.cpp"
+
+namespace {
+
+// values of a transition in the snapshot: count, total, max, p50, p90, p99, p99.9
+constexpr size_t TRANSITION_VALUE_COUNT = 7;
+
+int64_t TransitionValue(const std::vector<int64_t> &values, int stage, size_t field) {
+    return values[(stage - 1) * TRANSITION_VALUE_COUNT + field];
+}
+
+}
+
+TEST(TxLifecycleTrackerTest, TimesEveryStageFromTheLatestEarlierOne) {
+    TxLifecycleTracker tracker;
+    int64_t sent = TxLifecycleTracker::nowNanos();
+    tracker.startTracking(1, sent);
+    tracker.record(1, TX_STAGE_REPLY_RECEIVED, sent + 100);
+    tracker.record(1, TX_STAGE_FINALIZED, sent + 300);
+    // broadcast was skipped, mined is timed from finalized
+    tracker.record(1, TX_STAGE_MINED, sent + 1000);
+
+    std::vector<TxLifecycle> lifecycles;
+    std::vector<int64_t> values;
+    tracker.snapshot(lifecycles, values);
+    ASSERT_EQ(1u, lifecycles.size());
+    EXPECT_EQ(1u, lifecycles[0].txId);
+    EXPECT_EQ(sent + 300, lifecycles[0].stageNanos[TX_STAGE_FINALIZED]);
+    EXPECT_EQ(-1, lifecycles[0].stageNanos[TX_STAGE_BROADCAST]);
+    ASSERT_EQ((TX_STAGE_COUNT - 1) * TRANSITION_VALUE_COUNT, values.size());
+    EXPECT_EQ(1, TransitionValue(values, TX_STAGE_REPLY_RECEIVED, 0));
+    EXPECT_EQ(100, TransitionValue(values, TX_STAGE_REPLY_RECEIVED, 1));
+    EXPECT_EQ(200, TransitionValue(values, TX_STAGE_FINALIZED, 1));
+    EXPECT_EQ(0, TransitionValue(values, TX_STAGE_BROADCAST, 0));
+    EXPECT_EQ(700, TransitionValue(values, TX_STAGE_MINED, 1));
+}
+
+TEST(TxLifecycleTrackerTest, OnlyTheFirstTimeAStageIsReachedCounts) {
+    TxLifecycleTracker tracker;
+    int64_t sent = TxLifecycleTracker::nowNanos();
+    tracker.startTracking(1, sent);
+    tracker.record(1, TX_STAGE_BROADCAST, sent + 100);
+    tracker.record(1, TX_STAGE_BROADCAST, sent + 500);
+
+    std::vector<TxLifecycle> lifecycles;
+    std::vector<int64_t> values;
+    tracker.snapshot(lifecycles, values);
+    EXPECT_EQ(sent + 100, lifecycles[0].stageNanos[TX_STAGE_BROADCAST]);
+    EXPECT_EQ(1, TransitionValue(values, TX_STAGE_BROADCAST, 0));
+}
+
+TEST(TxLifecycleTrackerTest, KeepsADirectSendResultReportedBeforeTheSendReturned) {
+    TxLifecycleTracker tracker;
+    int64_t sent = TxLifecycleTracker::nowNanos();
+    tracker.record(1, TX_STAGE_REPLY_RECEIVED, sent + 50);
+    EXPECT_FALSE(tracker.isTracking());
+    tracker.record(1, TX_STAGE_DIRECT_SEND_RESULT, sent + 50);
+    EXPECT_TRUE(tracker.isTracking());
+
+    std::vector<TxLifecycle> lifecycles;
+    std::vector<int64_t> values;
+    tracker.snapshot(lifecycles, values);
+    // not sent yet as far as the tracker knows
+    EXPECT_TRUE(lifecycles.empty());
+
+    tracker.startTracking(1, sent);
+    lifecycles.clear();
+    values.clear();
+    tracker.snapshot(lifecycles, values);
+    ASSERT_EQ(1u, lifecycles.size());
+    EXPECT_EQ(50, TransitionValue(values, TX_STAGE_DIRECT_SEND_RESULT, 1));
+}
+
+TEST(TxLifecycleTrackerTest, EvictsTheOldestTxAtCapacity) {
+    TxLifecycleTracker tracker;
+    int64_t sent = TxLifecycleTracker::nowNanos();
+    for (uint64_t txId = 0; txId <= TX_LIFECYCLE_CAPACITY; txId++) {
+        tracker.startTracking(txId, sent + static_cast<int64_t>(txId));
+    }
+    std::vector<TxLifecycle> lifecycles;
+    std::vector<int64_t> values;
+    tracker.snapshot(lifecycles, values);
+    ASSERT_EQ(TX_LIFECYCLE_CAPACITY, lifecycles.size());
+    EXPECT_EQ(1u, lifecycles.front().txId);
+    EXPECT_EQ(TX_LIFECYCLE_CAPACITY, lifecycles.back().txId);
+}
+
+TEST(TxLifecycleTrackerTest, ExpiresOldTxs) {
+    TxLifecycleTracker tracker;
+    int64_t now = TxLifecycleTracker::nowNanos();
+    tracker.startTracking(1, now - TX_LIFECYCLE_MAX_AGE_NANOS - 1000000000);
+    tracker.startTracking(2, now);
+    std::vector<TxLifecycle> lifecycles;
+    std::vector<int64_t> values;
+    tracker.snapshot(lifecycles, values);
+    ASSERT_EQ(1u, lifecycles.size());
+    EXPECT_EQ(2u, lifecycles[0].txId);
+
+    tracker.clear();
+    EXPECT_FALSE(tracker.isTracking());
+}
@@ -0,0 +1,149 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include "workerPool.cpp"
+
+namespace {
+
+/**
+ * Holds the jobs that wait on it until it's released.
+ */
+class Latch {
+public:
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        released_.wait(lock, [this] { return open_; });
+    }
+
+    void release() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            open_ = true;
+        }
+        released_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable released_;
+    bool open_ = false;
+};
+
+bool AwaitCount(const std::atomic<int> &count, int expected) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (count.load() < expected) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+}
+
+TEST(WorkerPoolTest, RunsEveryJobWithItsId) {
+    WorkerPool pool(4, 1000);
+    std::mutex mutex;
+    std::set<uint64_t> submitted;
+    std::set<uint64_t> ran;
+    std::atomic<int> done{0};
+    for (int i = 0; i < 500; i++) {
+        uint64_t jobId = pool.submit([&](uint64_t id) {
+            std::lock_guard<std::mutex> lock(mutex);
+            ran.insert(id);
+            done++;
+        });
+        ASSERT_NE(0u, jobId);
+        std::lock_guard<std::mutex> lock(mutex);
+        submitted.insert(jobId);
+    }
+    ASSERT_TRUE(AwaitCount(done, 500));
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(submitted, ran);
+}
+
+TEST(WorkerPoolTest, RefusesJobsAtCapacity) {
+    constexpr size_t CAPACITY = 6;
+    WorkerPool pool(2, CAPACITY);
+    Latch latch;
+    std::atomic<int> done{0};
+    for (size_t i = 0; i < CAPACITY; i++) {
+        ASSERT_NE(0u, pool.submit([&](uint64_t) { latch.wait(); done++; }));
+    }
+    EXPECT_EQ(CAPACITY, pool.pendingCount());
+    EXPECT_EQ(0u, pool.submit([](uint64_t) {}));
+
+    latch.release();
+    ASSERT_TRUE(AwaitCount(done, static_cast<int>(CAPACITY)));
+    // a job counts until it returned
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (pool.pendingCount() > 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(0u, pool.pendingCount());
+    EXPECT_NE(0u, pool.submit([](uint64_t) {}));
+}
+
+TEST(WorkerPoolTest, AnIdleWorkerStealsFromABusyOne) {
+    // round robin puts every other job on the queue of the blocked worker, the other worker has to take them
+    WorkerPool pool(2, 100);
+    Latch blocker;
+    std::atomic<bool> blocking{false};
+    std::atomic<int> done{0};
+    pool.submit([&](uint64_t) { blocking = true; blocker.wait(); });
+    while (!blocking) {
+        std::this_thread::yield();
+    }
+    constexpr int JOB_COUNT = 20;
+    for (int i = 0; i < JOB_COUNT; i++) {
+        ASSERT_NE(0u, pool.submit([&](uint64_t) { done++; }));
+    }
+    EXPECT_TRUE(AwaitCount(done, JOB_COUNT));
+    blocker.release();
+}
+
+TEST(WorkerPoolTest, RunsTheExitHookOnEveryWorker) {
+    std::atomic<int> exited{0};
+    {
+        WorkerPool pool(3, 10, [&exited] { exited++; });
+        EXPECT_EQ(3u, pool.threadCount());
+    }
+    EXPECT_EQ(3, exited.load());
+}
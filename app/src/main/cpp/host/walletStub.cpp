@@ -0,0 +1,2461 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <wallet.h>
+#include "walletStub.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../tariAddressCodec.cpp"
+#include "../hexCodec.cpp"
+
+/**
+ * Stub libminotari_wallet_ffi for the host build and instrumented tests: the wallet.h functions the bindings use,
+ * over an in-memory wallet of configurable size. There's no networking and no database; callbacks are fired through
+ * wallet_stub_get_callbacks(), or from native threads by the event generator of wallet_stub_start_events().
+ *
+ * Ownership follows libwallet: every getter returns a new object or string that the caller destroys.
+ * The opaque wallet.h types are backed by the Stub structs below.
+ */
+
+constexpr int STUB_ERROR_NULL_POINTER = 1;
+constexpr int STUB_ERROR_INDEX_OUT_OF_BOUNDS = 2;
+constexpr int STUB_ERROR_INVALID_ARGUMENT = 3;
+constexpr int STUB_ERROR_NOT_FOUND = 4;
+
+constexpr size_t STUB_KEY_SIZE = 32;
+constexpr int STUB_SEED_WORD_COUNT = 24;
+constexpr int STUB_MNEMONIC_WORD_COUNT = 2048;
+constexpr uint8_t STUB_NETWORK = 0x26;
+constexpr uint8_t STUB_FEATURES = 0x03;
+
+// size of the default dataset of a new wallet
+constexpr unsigned int STUB_COMPLETED_TX_COUNT = 50;
+constexpr unsigned int STUB_CANCELLED_TX_COUNT = 10;
+constexpr unsigned int STUB_PENDING_INBOUND_TX_COUNT = 10;
+constexpr unsigned int STUB_PENDING_OUTBOUND_TX_COUNT = 10;
+constexpr unsigned int STUB_UTXO_COUNT = 50;
+constexpr unsigned int STUB_CONTACT_COUNT = 20;
+constexpr uint64_t STUB_TIP_HEIGHT = WALLET_STUB_TIP_HEIGHT;
+
+// txs the generated events are about, above the ids of any dataset
+constexpr uint64_t STUB_EVENT_TX_ID_BASE = WALLET_STUB_EVENT_TX_ID_BASE;
+constexpr unsigned int STUB_DEFAULT_BURST_SIZE = 64;
+// the validation results and the balance update that end every burst
+constexpr unsigned int STUB_BURST_TAIL_SIZE = 3;
+// txReceived to baseNodeStatus without liveness and store and forward
+constexpr unsigned int STUB_STORM_CALLBACK_COUNT = 16;
+
+struct StubBytes {
+    std::vector<uint8_t> bytes;
+};
+
+using StubKey = std::array<uint8_t, STUB_KEY_SIZE>;
+
+struct StubAddress {
+    std::vector<uint8_t> bytes;
+};
+
+struct StubContact {
+    std::string alias;
+    StubAddress address;
+    bool favourite = false;
+};
+
+struct StubKernel {
+    std::string excess;
+    std::string publicNonce;
+    std::string signature;
+};
+
+struct StubCompletedTx {
+    uint64_t id = 0;
+    StubAddress source;
+    StubAddress destination;
+    uint64_t amount = 0;
+    uint64_t fee = 0;
+    uint64_t timestamp = 0;
+    uint64_t minedTimestamp = 0;
+    uint64_t minedHeight = 0;
+    std::string paymentId;
+    int status = 0;
+    bool outbound = false;
+    int cancellationReason = -1;
+};
+
+struct StubPendingInboundTx {
+    uint64_t id = 0;
+    StubAddress source;
+    uint64_t amount = 0;
+    uint64_t timestamp = 0;
+    std::string paymentId;
+    int status = 0;
+};
+
+struct StubPendingOutboundTx {
+    uint64_t id = 0;
+    StubAddress destination;
+    uint64_t amount = 0;
+    uint64_t fee = 0;
+    uint64_t timestamp = 0;
+    std::string paymentId;
+    int status = 0;
+};
+
+struct StubBalance {
+    uint64_t available = 0;
+    uint64_t pendingIncoming = 0;
+    uint64_t pendingOutgoing = 0;
+    uint64_t timeLocked = 0;
+};
+
+struct StubUtxo {
+    std::string commitment;
+    uint64_t value = 0;
+    uint64_t minedHeight = 0;
+    uint64_t minedTimestamp = 0;
+    uint64_t lockHeight = 0;
+    uint8_t status = 0;
+};
+
+struct StubSeedWords {
+    std::vector<std::string> words;
+};
+
+struct StubCommsConfig {
+    std::string publicAddress;
+    std::string listenerAddress;
+};
+
+struct StubFeePerGramStat {
+    uint64_t order = 0;
+    uint64_t min = 0;
+    uint64_t avg = 0;
+    uint64_t max = 0;
+};
+
+struct StubUnblindedOutput {
+    std::string json;
+};
+
+/**
+ * A TariVector with the storage its items point into, the vector is the first member so the two convert.
+ */
+struct StubVector {
+    TariVector vector;
+    std::vector<TariUtxo> utxos;
+    std::vector<std::string> strings;
+    std::vector<uint64_t> numbers;
+    std::vector<const char *> chars;
+};
+
+struct StubCoinPreview {
+    TariCoinPreview preview;
+    StubVector *pOutputs = nullptr;
+};
+
+template <typename T>
+struct StubList {
+    std::vector<T> items;
+};
+
+/**
+ * Threads firing the callbacks of a wallet, see wallet_stub_start_events.
+ */
+struct StubEventGenerator {
+    WalletStubEvents events{};
+    std::vector<uint64_t> completedTxIds;
+    std::vector<uint64_t> cancelledTxIds;
+    std::vector<std::thread> threads;
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    std::atomic<bool> stopped{false};
+    // copies taken when the generator starts, the threads don't touch the wallet
+    WalletStubCallbacks callbacks{};
+    StubAddress address;
+    std::atomic<uint64_t> reservedCount{0};
+    std::atomic<uint64_t> firedCount{0};
+    std::atomic<uint64_t> nextTxId{STUB_EVENT_TX_ID_BASE};
+    std::atomic<uint64_t> nextRequestId{1};
+    std::atomic<uint64_t> scannedHeight{0};
+    std::atomic<uint64_t> nextSequence{0};
+    std::chrono::steady_clock::time_point startedAt;
+};
+
+struct StubWallet {
+    WalletStubCallbacks callbacks{};
+    std::unique_ptr<StubEventGenerator> pEvents;
+    // fired event count of the generators that were stopped
+    uint64_t stoppedEventCount = 0;
+    std::mutex mutex;
+    StubAddress address;
+    StubKey privateViewKey{};
+    StubSeedWords seedWords;
+    std::vector<StubCompletedTx> completedTxs;
+    std::vector<StubCompletedTx> cancelledTxs;
+    std::vector<StubPendingInboundTx> pendingInboundTxs;
+    std::vector<StubPendingOutboundTx> pendingOutboundTxs;
+    std::vector<StubContact> contacts;
+    std::vector<StubUtxo> utxos;
+    std::map<std::string, std::string> values;
+    uint64_t confirmationsRequired = 3;
+    uint64_t nextTxId = 1;
+    uint64_t nextRequestId = 1;
+    uint64_t tipHeight = STUB_TIP_HEIGHT;
+};
+
+template <typename Ffi, typename Stub>
+static Ffi *ToFfi(Stub *pStub) {
+    return reinterpret_cast<Ffi *>(pStub);
+}
+
+template <typename Stub, typename Ffi>
+static Stub *ToStub(Ffi *pFfi) {
+    return reinterpret_cast<Stub *>(const_cast<std::remove_const_t<Ffi> *>(pFfi));
+}
+
+static void SetError(int *error, int value) {
+    if (error != nullptr) {
+        *error = value;
+    }
+}
+
+static bool CheckNotNull(const void *pointer, int *error) {
+    SetError(error, pointer == nullptr ? STUB_ERROR_NULL_POINTER : 0);
+    return pointer != nullptr;
+}
+
+static bool CheckIndex(size_t index, size_t size, int *error) {
+    SetError(error, index < size ? 0 : STUB_ERROR_INDEX_OUT_OF_BOUNDS);
+    return index < size;
+}
+
+static char *NewCString(const std::string &value) {
+    return strdup(value.c_str());
+}
+
+static ByteVector *NewByteVector(const uint8_t *pBytes, size_t length) {
+    return ToFfi<ByteVector>(new StubBytes{std::vector<uint8_t>(pBytes, pBytes + length)});
+}
+
+static std::string ToHex(const uint8_t *pBytes, size_t length) {
+    std::string result(length * 2, '\0');
+    HexEncode(pBytes, length, &result[0], false);
+    return result;
+}
+
+/**
+ * splitmix64, the stub data only has to look random and be the same on every run.
+ */
+static uint64_t StubRandom(uint64_t &state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static StubKey NewKey(uint64_t seed) {
+    StubKey key{};
+    for (size_t i = 0; i < key.size(); i += 8) {
+        uint64_t value = StubRandom(seed);
+        memcpy(key.data() + i, &value, 8);
+    }
+    return key;
+}
+
+static StubAddress NewAddress(const StubKey &spendKey) {
+    StubAddress address;
+    address.bytes.reserve(SINGLE_ADDRESS_SIZE);
+    address.bytes.push_back(STUB_NETWORK);
+    address.bytes.push_back(STUB_FEATURES);
+    address.bytes.insert(address.bytes.end(), spendKey.begin(), spendKey.end());
+    // the DammSum of the address including the checksum is zero when the checksum is the sum of the rest
+    address.bytes.push_back(ComputeDammSum(address.bytes));
+    return address;
+}
+
+static StubAddress NewAddress(uint64_t seed) {
+    return NewAddress(NewKey(seed));
+}
+
+static bool IsValidAddress(const std::vector<uint8_t> &bytes) {
+    return (bytes.size() == SINGLE_ADDRESS_SIZE || bytes.size() >= DUAL_ADDRESS_SIZE) && ComputeDammSum(bytes) == 0;
+}
+
+static std::string MnemonicWord(int index) {
+    // a bijection of [0, 26^4) scatters the words over the alphabet like a real word list
+    uint32_t value = static_cast<uint32_t>(index) * 7919u % (26u * 26u * 26u * 26u);
+    std::string word(4, 'a');
+    for (int i = 3; i >= 0; i--) {
+        word[i] = static_cast<char>('a' + value % 26);
+        value /= 26;
+    }
+    return word;
+}
+
+static const std::vector<std::string> &MnemonicWords() {
+    static const std::vector<std::string> words = [] {
+        std::vector<std::string> result;
+        result.reserve(STUB_MNEMONIC_WORD_COUNT);
+        for (int i = 0; i < STUB_MNEMONIC_WORD_COUNT; i++) {
+            result.push_back(MnemonicWord(i));
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }();
+    return words;
+}
+
+// base58 with the bitcoin alphabet of tariAddressCodec.cpp, quadratic but addresses are short
+static std::string EncodeBase58(const std::vector<uint8_t> &bytes) {
+    std::vector<uint8_t> digits;
+    for (uint8_t byte : bytes) {
+        uint32_t carry = byte;
+        for (uint8_t &digit : digits) {
+            carry += static_cast<uint32_t>(digit) << 8;
+            digit = static_cast<uint8_t>(carry % 58);
+            carry /= 58;
+        }
+        while (carry > 0) {
+            digits.push_back(static_cast<uint8_t>(carry % 58));
+            carry /= 58;
+        }
+    }
+    std::string result;
+    for (size_t i = 0; i < bytes.size() && bytes[i] == 0; i++) {
+        result.push_back('1');
+    }
+    for (auto it = digits.rbegin(); it != digits.rend(); ++it) {
+        result.push_back(BASE58_ALPHABET[*it]);
+    }
+    return result;
+}
+
+static bool DecodeBase58(const char *pText, std::vector<uint8_t> &bytes) {
+    bytes.clear();
+    std::vector<uint8_t> reversed;
+    size_t leadingZeros = 0;
+    for (const char *p = pText; *p == '1'; p++) {
+        leadingZeros++;
+    }
+    for (const char *p = pText; *p != '\0'; p++) {
+        const char *pDigit = strchr(BASE58_ALPHABET, *p);
+        if (pDigit == nullptr) {
+            return false;
+        }
+        uint32_t carry = static_cast<uint32_t>(pDigit - BASE58_ALPHABET);
+        for (uint8_t &byte : reversed) {
+            carry += static_cast<uint32_t>(byte) * 58;
+            byte = static_cast<uint8_t>(carry & 0xFF);
+            carry >>= 8;
+        }
+        while (carry > 0) {
+            reversed.push_back(static_cast<uint8_t>(carry & 0xFF));
+            carry >>= 8;
+        }
+    }
+    bytes.assign(leadingZeros, 0);
+    bytes.insert(bytes.end(), reversed.rbegin(), reversed.rend());
+    return true;
+}
+
+static void AppendUtf8(std::string &text, uint32_t codepoint) {
+    if (codepoint < 0x80) {
+        text.push_back(static_cast<char>(codepoint));
+    } else if (codepoint < 0x800) {
+        text.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+        text.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    } else if (codepoint < 0x10000) {
+        text.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+        text.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+        text.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    } else {
+        text.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+        text.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+        text.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+        text.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+    }
+}
+
+static std::string EncodeEmojiId(const std::vector<uint8_t> &bytes) {
+    std::string result;
+    result.reserve(bytes.size() * 4);
+    for (uint8_t byte : bytes) {
+        AppendUtf8(result, EMOJI_CODEPOINTS[byte]);
+    }
+    return result;
+}
+
+static bool DecodeEmojiId(const char *pText, std::vector<uint8_t> &bytes) {
+    bytes.clear();
+    auto p = reinterpret_cast<const uint8_t *>(pText);
+    while (*p != 0) {
+        uint32_t codepoint;
+        int length;
+        if (*p < 0x80) {
+            codepoint = *p;
+            length = 1;
+        } else if ((*p & 0xE0) == 0xC0) {
+            codepoint = *p & 0x1F;
+            length = 2;
+        } else if ((*p & 0xF0) == 0xE0) {
+            codepoint = *p & 0x0F;
+            length = 3;
+        } else {
+            codepoint = *p & 0x07;
+            length = 4;
+        }
+        for (int i = 1; i < length; i++) {
+            if ((p[i] & 0xC0) != 0x80) {
+                return false;
+            }
+            codepoint = (codepoint << 6) | (p[i] & 0x3F);
+        }
+        p += length;
+        if (codepoint == 0xFE0F) {
+            continue;
+        }
+        const uint32_t *pEnd = EMOJI_CODEPOINTS + EMOJI_SET_SIZE;
+        const uint32_t *pFound = std::find(EMOJI_CODEPOINTS, pEnd, codepoint);
+        if (pFound == pEnd) {
+            return false;
+        }
+        bytes.push_back(static_cast<uint8_t>(pFound - EMOJI_CODEPOINTS));
+    }
+    return true;
+}
+
+static StubVector *NewStubVector(TariTypeTag tag) {
+    auto pVector = new StubVector();
+    pVector->vector.tag = tag;
+    return pVector;
+}
+
+static void SyncStubVector(StubVector *pVector) {
+    switch (pVector->vector.tag) {
+        case Utxo:
+            pVector->vector.len = pVector->utxos.size();
+            pVector->vector.cap = pVector->utxos.capacity();
+            pVector->vector.ptr = pVector->utxos.data();
+            break;
+        case U64:
+        case I64:
+            pVector->vector.len = pVector->numbers.size();
+            pVector->vector.cap = pVector->numbers.capacity();
+            pVector->vector.ptr = pVector->numbers.data();
+            break;
+        default:
+            pVector->chars.clear();
+            for (const std::string &text : pVector->strings) {
+                pVector->chars.push_back(text.c_str());
+            }
+            pVector->vector.len = pVector->chars.size();
+            pVector->vector.cap = pVector->chars.capacity();
+            pVector->vector.ptr = pVector->chars.data();
+            break;
+    }
+}
+
+static StubVector *NewUtxoVector(const std::vector<StubUtxo> &utxos) {
+    StubVector *pVector = NewStubVector(Utxo);
+    pVector->strings.reserve(utxos.size());
+    pVector->utxos.reserve(utxos.size());
+    for (const StubUtxo &utxo : utxos) {
+        pVector->strings.push_back(utxo.commitment);
+    }
+    for (size_t i = 0; i < utxos.size(); i++) {
+        const StubUtxo &utxo = utxos[i];
+        pVector->utxos.push_back({pVector->strings[i].c_str(), utxo.value, utxo.minedHeight, utxo.minedTimestamp,
+                                  utxo.lockHeight, utxo.status});
+    }
+    SyncStubVector(pVector);
+    return pVector;
+}
+
+static StubCompletedTx NewCompletedTx(uint64_t id, int status, bool outbound, const StubAddress &self) {
+    uint64_t seed = id;
+    StubCompletedTx tx;
+    tx.id = id;
+    tx.outbound = outbound;
+    StubAddress counterparty = NewAddress(StubRandom(seed));
+    tx.source = outbound ? self : counterparty;
+    tx.destination = outbound ? counterparty : self;
+    tx.amount = 1000 + StubRandom(seed) % 100000000;
+    tx.fee = outbound ? 25 + StubRandom(seed) % 10000 : 0;
+    tx.timestamp = 1700000000 + id * 60;
+    tx.minedTimestamp = tx.timestamp + 120;
+    tx.minedHeight = STUB_TIP_HEIGHT - std::min<uint64_t>(id % 1000, STUB_TIP_HEIGHT);
+    tx.paymentId = "payment " + std::to_string(id);
+    tx.status = status;
+    return tx;
+}
+
+static StubPendingInboundTx NewPendingInboundTx(uint64_t id) {
+    uint64_t seed = id;
+    StubPendingInboundTx tx;
+    tx.id = id;
+    tx.source = NewAddress(StubRandom(seed));
+    tx.amount = 1000 + StubRandom(seed) % 100000000;
+    tx.timestamp = 1700000000 + id * 60;
+    tx.paymentId = "payment " + std::to_string(id);
+    tx.status = 4;
+    return tx;
+}
+
+static StubPendingOutboundTx NewPendingOutboundTx(uint64_t id) {
+    uint64_t seed = id;
+    StubPendingOutboundTx tx;
+    tx.id = id;
+    tx.destination = NewAddress(StubRandom(seed));
+    tx.amount = 1000 + StubRandom(seed) % 100000000;
+    tx.fee = 25 + StubRandom(seed) % 10000;
+    tx.timestamp = 1700000000 + id * 60;
+    tx.paymentId = "payment " + std::to_string(id);
+    tx.status = 4;
+    return tx;
+}
+
+constexpr WalletStubDataset STUB_DEFAULT_DATASET = {
+        STUB_COMPLETED_TX_COUNT, STUB_CANCELLED_TX_COUNT, STUB_PENDING_INBOUND_TX_COUNT,
+        STUB_PENDING_OUTBOUND_TX_COUNT, STUB_UTXO_COUNT, STUB_CONTACT_COUNT};
+
+static std::mutex g_datasetMutex;
+static WalletStubDataset g_dataset = STUB_DEFAULT_DATASET;
+
+static WalletStubDataset GetDataset() {
+    std::lock_guard<std::mutex> lock(g_datasetMutex);
+    return g_dataset;
+}
+
+static void FillDataset(StubWallet &wallet, const WalletStubDataset &dataset) {
+    uint64_t seed = 42;
+    wallet.address = NewAddress(StubRandom(seed));
+    wallet.privateViewKey = NewKey(StubRandom(seed));
+    const std::vector<std::string> &words = MnemonicWords();
+    for (int i = 0; i < STUB_SEED_WORD_COUNT; i++) {
+        wallet.seedWords.words.push_back(words[StubRandom(seed) % words.size()]);
+    }
+    wallet.completedTxs.reserve(dataset.completedTxCount);
+    for (unsigned int i = 0; i < dataset.completedTxCount; i++) {
+        // mined and confirmed, every third one outbound
+        wallet.completedTxs.push_back(NewCompletedTx(wallet.nextTxId++, 6, i % 3 == 0, wallet.address));
+    }
+    wallet.cancelledTxs.reserve(dataset.cancelledTxCount);
+    for (unsigned int i = 0; i < dataset.cancelledTxCount; i++) {
+        StubCompletedTx tx = NewCompletedTx(wallet.nextTxId++, 7, i % 2 == 0, wallet.address);
+        tx.cancellationReason = 2;
+        wallet.cancelledTxs.push_back(tx);
+    }
+    wallet.pendingInboundTxs.reserve(dataset.pendingInboundTxCount);
+    for (unsigned int i = 0; i < dataset.pendingInboundTxCount; i++) {
+        wallet.pendingInboundTxs.push_back(NewPendingInboundTx(wallet.nextTxId++));
+    }
+    wallet.pendingOutboundTxs.reserve(dataset.pendingOutboundTxCount);
+    for (unsigned int i = 0; i < dataset.pendingOutboundTxCount; i++) {
+        wallet.pendingOutboundTxs.push_back(NewPendingOutboundTx(wallet.nextTxId++));
+    }
+    wallet.contacts.reserve(dataset.contactCount);
+    for (unsigned int i = 0; i < dataset.contactCount; i++) {
+        wallet.contacts.push_back({"contact " + std::to_string(i), NewAddress(StubRandom(seed)), i % 4 == 0});
+    }
+    wallet.utxos.reserve(dataset.utxoCount);
+    for (unsigned int i = 0; i < dataset.utxoCount; i++) {
+        StubKey commitment = NewKey(StubRandom(seed));
+        StubUtxo utxo;
+        utxo.commitment = ToHex(commitment.data(), commitment.size());
+        utxo.value = 1000 + StubRandom(seed) % 100000000;
+        utxo.minedHeight = STUB_TIP_HEIGHT - static_cast<uint64_t>(i % 1000) * 10;
+        utxo.minedTimestamp = 1700000000 + static_cast<uint64_t>(i) * 600;
+        utxo.status = 0;
+        wallet.utxos.push_back(utxo);
+    }
+}
+
+template <typename T, typename Id>
+static const T *FindById(const std::vector<T> &items, Id id) {
+    for (const T &item : items) {
+        if (item.id == id) {
+            return &item;
+        }
+    }
+    return nullptr;
+}
+
+template <typename Ffi, typename T>
+static Ffi *CopyById(StubWallet *pStub, std::vector<T> StubWallet::*items, unsigned long long id, int *error) {
+    if (pStub == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    const T *pItem = FindById(pStub->*items, id);
+    if (pItem == nullptr) {
+        SetError(error, STUB_ERROR_NOT_FOUND);
+        return nullptr;
+    }
+    return ToFfi<Ffi>(new T(*pItem));
+}
+
+// event generator
+
+struct StubEventThread {
+    uint64_t step = 0;
+    uint64_t txId = 0;
+    uint64_t scannedHeight = 0;
+    uint64_t datasetIndex = 0;
+};
+
+static TariCompletedTransaction *NewEventTx(const StubEventGenerator &generator, uint64_t txId, int status) {
+    return ToFfi<TariCompletedTransaction>(new StubCompletedTx(NewCompletedTx(txId, status, false, generator.address)));
+}
+
+static TariBalance *NewEventBalance(uint64_t step) {
+    return ToFfi<TariBalance>(new StubBalance{1000000000 + step, step % 1000000, 0, 0});
+}
+
+static uint64_t NextDatasetId(StubEventGenerator &generator, const std::vector<uint64_t> &ids, uint64_t index) {
+    return ids.empty() ? generator.nextTxId.fetch_add(1, std::memory_order_relaxed) : ids[index % ids.size()];
+}
+
+/**
+ * Fires the callback of the current step, false if the wallet doesn't have that callback.
+ */
+static bool FireSteadyTrickleEvent(StubEventGenerator &generator, StubEventThread &thread) {
+    const WalletStubCallbacks &callbacks = generator.callbacks;
+    void *context = callbacks.context;
+    uint64_t phase = thread.step++ % 8;
+    switch (phase) {
+        case 0:
+            thread.txId = generator.nextTxId.fetch_add(1, std::memory_order_relaxed);
+            if (callbacks.txReceived == nullptr) {
+                return false;
+            }
+            callbacks.txReceived(context, ToFfi<TariPendingInboundTransaction>(
+                    new StubPendingInboundTx(NewPendingInboundTx(thread.txId))));
+            return true;
+        case 1:
+            if (callbacks.txFinalized == nullptr) {
+                return false;
+            }
+            callbacks.txFinalized(context, NewEventTx(generator, thread.txId, 0));
+            return true;
+        case 2:
+            if (callbacks.txBroadcast == nullptr) {
+                return false;
+            }
+            callbacks.txBroadcast(context, NewEventTx(generator, thread.txId, 1));
+            return true;
+        case 3:
+        case 4:
+            if (callbacks.txMinedUnconfirmed == nullptr) {
+                return false;
+            }
+            callbacks.txMinedUnconfirmed(context, NewEventTx(generator, thread.txId, 2), phase - 2);
+            return true;
+        case 5:
+            if (callbacks.txMined == nullptr) {
+                return false;
+            }
+            callbacks.txMined(context, NewEventTx(generator, thread.txId, 6));
+            return true;
+        case 6:
+            if (callbacks.balanceUpdated == nullptr) {
+                return false;
+            }
+            callbacks.balanceUpdated(context, NewEventBalance(thread.step));
+            return true;
+        default:
+            if (callbacks.baseNodeStatus == nullptr) {
+                return false;
+            }
+            callbacks.baseNodeStatus(context, ToFfi<TariBaseNodeState>(new uint64_t(STUB_TIP_HEIGHT + thread.step / 8)));
+            return true;
+    }
+}
+
+static bool FireValidationBurstEvent(StubEventGenerator &generator, StubEventThread &thread) {
+    const WalletStubCallbacks &callbacks = generator.callbacks;
+    void *context = callbacks.context;
+    unsigned int burstSize = generator.events.burstSize;
+    uint64_t position = thread.step++ % burstSize;
+    if (position == burstSize - STUB_BURST_TAIL_SIZE) {
+        if (callbacks.txoValidationComplete == nullptr) {
+            return false;
+        }
+        callbacks.txoValidationComplete(context, generator.nextRequestId.fetch_add(1, std::memory_order_relaxed), 0);
+        return true;
+    }
+    if (position == burstSize - 2) {
+        if (callbacks.transactionValidationComplete == nullptr) {
+            return false;
+        }
+        callbacks.transactionValidationComplete(context, generator.nextRequestId.fetch_add(1, std::memory_order_relaxed), 0);
+        return true;
+    }
+    if (position == burstSize - 1) {
+        if (callbacks.balanceUpdated == nullptr) {
+            return false;
+        }
+        callbacks.balanceUpdated(context, NewEventBalance(thread.step));
+        return true;
+    }
+    uint64_t index = thread.datasetIndex++;
+    if (index % 8 == 7) {
+        if (callbacks.txCancellation == nullptr) {
+            return false;
+        }
+        uint64_t txId = NextDatasetId(generator, generator.cancelledTxIds, index / 8);
+        callbacks.txCancellation(context, NewEventTx(generator, txId, 7), 2);
+        return true;
+    }
+    uint64_t txId = NextDatasetId(generator, generator.completedTxIds, index);
+    if (index % 2 == 0) {
+        if (callbacks.txMined == nullptr) {
+            return false;
+        }
+        callbacks.txMined(context, NewEventTx(generator, txId, 6));
+        return true;
+    }
+    if (callbacks.txFauxConfirmed == nullptr) {
+        return false;
+    }
+    callbacks.txFauxConfirmed(context, NewEventTx(generator, txId, 9));
+    return true;
+}
+
+static bool FireRecoveryStormEvent(StubEventGenerator &generator, StubEventThread &thread) {
+    const WalletStubCallbacks &callbacks = generator.callbacks;
+    void *context = callbacks.context;
+    switch (thread.step++ % 4) {
+        case 0:
+            thread.scannedHeight = generator.scannedHeight.fetch_add(1, std::memory_order_relaxed) % (STUB_TIP_HEIGHT + 1);
+            if (callbacks.recoveryProgress == nullptr) {
+                return false;
+            }
+            // RecoveryEvent::Progress
+            callbacks.recoveryProgress(context, 3, thread.scannedHeight, STUB_TIP_HEIGHT);
+            return true;
+        case 1:
+            if (callbacks.walletScannedHeight == nullptr) {
+                return false;
+            }
+            callbacks.walletScannedHeight(context, thread.scannedHeight);
+            return true;
+        case 2:
+            if (callbacks.txFauxConfirmed == nullptr) {
+                return false;
+            }
+            // imported
+            callbacks.txFauxConfirmed(context, NewEventTx(generator, generator.nextTxId.fetch_add(1, std::memory_order_relaxed), 3));
+            return true;
+        default:
+            if (callbacks.balanceUpdated == nullptr) {
+                return false;
+            }
+            callbacks.balanceUpdated(context, NewEventBalance(thread.step));
+            return true;
+    }
+}
+
+static void ObserveEvent(const StubEventGenerator &generator, uint64_t sequence) {
+    if (generator.events.observer != nullptr) {
+        generator.events.observer(generator.events.observerContext, sequence);
+    }
+}
+
+// the payloads are created before the observer sees the event, so it's timestamped right before the callback
+
+static bool FireObservedTx(StubEventGenerator &generator, uint64_t sequence,
+                           void (*callback)(void *, TariCompletedTransaction *), int status) {
+    if (callback == nullptr) {
+        return false;
+    }
+    TariCompletedTransaction *pTx = NewEventTx(generator, STUB_EVENT_TX_ID_BASE + sequence, status);
+    ObserveEvent(generator, sequence);
+    callback(generator.callbacks.context, pTx);
+    return true;
+}
+
+static bool FireObservedTx(StubEventGenerator &generator, uint64_t sequence,
+                           void (*callback)(void *, TariCompletedTransaction *, uint64_t), int status, uint64_t detail) {
+    if (callback == nullptr) {
+        return false;
+    }
+    TariCompletedTransaction *pTx = NewEventTx(generator, STUB_EVENT_TX_ID_BASE + sequence, status);
+    ObserveEvent(generator, sequence);
+    callback(generator.callbacks.context, pTx, detail);
+    return true;
+}
+
+static bool FireObservedValue(StubEventGenerator &generator, uint64_t sequence, void (*callback)(void *, uint64_t)) {
+    if (callback == nullptr) {
+        return false;
+    }
+    ObserveEvent(generator, sequence);
+    callback(generator.callbacks.context, sequence);
+    return true;
+}
+
+static bool FireObservedValidation(StubEventGenerator &generator, uint64_t sequence,
+                                   void (*callback)(void *, uint64_t, uint64_t)) {
+    if (callback == nullptr) {
+        return false;
+    }
+    ObserveEvent(generator, sequence);
+    callback(generator.callbacks.context, sequence, 0);
+    return true;
+}
+
+static bool FireCallbackStormEvent(StubEventGenerator &generator) {
+    const WalletStubCallbacks &callbacks = generator.callbacks;
+    void *context = callbacks.context;
+    uint64_t sequence = generator.nextSequence.fetch_add(1, std::memory_order_relaxed);
+    switch (sequence % STUB_STORM_CALLBACK_COUNT) {
+        case 0: {
+            if (callbacks.txReceived == nullptr) {
+                return false;
+            }
+            auto pTx = ToFfi<TariPendingInboundTransaction>(
+                    new StubPendingInboundTx(NewPendingInboundTx(STUB_EVENT_TX_ID_BASE + sequence)));
+            ObserveEvent(generator, sequence);
+            callbacks.txReceived(context, pTx);
+            return true;
+        }
+        case 1:
+            return FireObservedTx(generator, sequence, callbacks.txReplyReceived, 0);
+        case 2:
+            return FireObservedTx(generator, sequence, callbacks.txFinalized, 0);
+        case 3:
+            return FireObservedTx(generator, sequence, callbacks.txBroadcast, 1);
+        case 4:
+            return FireObservedTx(generator, sequence, callbacks.txMined, 6);
+        case 5:
+            return FireObservedTx(generator, sequence, callbacks.txMinedUnconfirmed, 2, 1);
+        case 6:
+            return FireObservedTx(generator, sequence, callbacks.txFauxConfirmed, 9);
+        case 7:
+            return FireObservedTx(generator, sequence, callbacks.txFauxUnconfirmed, 8, 1);
+        case 8: {
+            if (callbacks.txDirectSendResult == nullptr) {
+                return false;
+            }
+            auto pStatus = ToFfi<TariTransactionSendStatus>(new unsigned int(1));
+            ObserveEvent(generator, sequence);
+            callbacks.txDirectSendResult(context, STUB_EVENT_TX_ID_BASE + sequence, pStatus);
+            return true;
+        }
+        case 9:
+            return FireObservedTx(generator, sequence, callbacks.txCancellation, 7, 2);
+        case 10:
+            return FireObservedValidation(generator, sequence, callbacks.txoValidationComplete);
+        case 11: {
+            if (callbacks.balanceUpdated == nullptr) {
+                return false;
+            }
+            auto pBalance = ToFfi<TariBalance>(new StubBalance{sequence, 0, 0, 0});
+            ObserveEvent(generator, sequence);
+            callbacks.balanceUpdated(context, pBalance);
+            return true;
+        }
+        case 12:
+            return FireObservedValidation(generator, sequence, callbacks.transactionValidationComplete);
+        case 13:
+            return FireObservedValue(generator, sequence, callbacks.connectivityStatus);
+        case 14:
+            return FireObservedValue(generator, sequence, callbacks.walletScannedHeight);
+        default: {
+            if (callbacks.baseNodeStatus == nullptr) {
+                return false;
+            }
+            auto pState = ToFfi<TariBaseNodeState>(new uint64_t(STUB_TIP_HEIGHT + sequence));
+            ObserveEvent(generator, sequence);
+            callbacks.baseNodeStatus(context, pState);
+            return true;
+        }
+    }
+}
+
+/**
+ * Fires the next callback the wallet has, false if it has none of the pattern.
+ */
+static bool FireNextEvent(StubEventGenerator &generator, StubEventThread &thread) {
+    unsigned int steps = generator.events.pattern == WALLET_STUB_EVENTS_VALIDATION_BURST
+                         ? generator.events.burstSize
+                         : STUB_STORM_CALLBACK_COUNT;
+    for (unsigned int i = 0; i < steps; i++) {
+        bool fired;
+        switch (generator.events.pattern) {
+            case WALLET_STUB_EVENTS_VALIDATION_BURST:
+                fired = FireValidationBurstEvent(generator, thread);
+                break;
+            case WALLET_STUB_EVENTS_RECOVERY_STORM:
+                fired = FireRecoveryStormEvent(generator, thread);
+                break;
+            case WALLET_STUB_EVENTS_CALLBACK_STORM:
+                fired = FireCallbackStormEvent(generator);
+                break;
+            default:
+                fired = FireSteadyTrickleEvent(generator, thread);
+                break;
+        }
+        if (fired) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void RunEventThread(StubEventGenerator *pGenerator, unsigned int threadIndex) {
+    StubEventGenerator &generator = *pGenerator;
+    const WalletStubEvents &events = generator.events;
+    unsigned int burstSize = events.pattern == WALLET_STUB_EVENTS_VALIDATION_BURST ? events.burstSize : 1;
+    // every thread fires its share of the rate, paced from the start so a slow callback doesn't lower it,
+    // the threads are spread over the interval so low rates don't fire in lockstep
+    std::chrono::nanoseconds interval(events.eventsPerSecond == 0
+                                      ? 0
+                                      : 1000000000ull * events.threadCount / events.eventsPerSecond);
+    std::chrono::steady_clock::time_point start = generator.startedAt + interval * threadIndex / events.threadCount;
+    StubEventThread thread;
+    uint64_t firedCount = 0;
+    while (!generator.stopped.load(std::memory_order_relaxed)) {
+        std::chrono::steady_clock::time_point deadline = start + interval * firedCount;
+        if (interval.count() > 0 && deadline > std::chrono::steady_clock::now()) {
+            std::unique_lock<std::mutex> lock(generator.mutex);
+            if (generator.wakeUp.wait_until(lock, deadline, [&generator]() {
+                return generator.stopped.load(std::memory_order_relaxed);
+            })) {
+                return;
+            }
+        }
+        for (unsigned int i = 0; i < burstSize; i++) {
+            if (events.eventCount != 0 &&
+                generator.reservedCount.fetch_add(1, std::memory_order_relaxed) >= events.eventCount) {
+                return;
+            }
+            if (!FireNextEvent(generator, thread)) {
+                return;
+            }
+            generator.firedCount.fetch_add(1, std::memory_order_relaxed);
+            firedCount++;
+        }
+    }
+}
+
+/**
+ * Joins the threads outside the wallet lock, a callback may be waiting on a thread that takes it.
+ */
+static void StopEvents(StubWallet *pStub, bool wait) {
+    std::unique_ptr<StubEventGenerator> pGenerator;
+    {
+        std::lock_guard<std::mutex> lock(pStub->mutex);
+        pGenerator = std::move(pStub->pEvents);
+    }
+    if (pGenerator == nullptr) {
+        return;
+    }
+    if (!wait || pGenerator->events.eventCount == 0) {
+        std::lock_guard<std::mutex> lock(pGenerator->mutex);
+        pGenerator->stopped.store(true, std::memory_order_relaxed);
+    }
+    pGenerator->wakeUp.notify_all();
+    for (std::thread &thread : pGenerator->threads) {
+        thread.join();
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    pStub->stoppedEventCount += pGenerator->firedCount.load(std::memory_order_relaxed);
+}
+
+extern "C" {
+
+void string_destroy(char *pString) {
+    free(pString);
+}
+
+// byte vectors
+
+ByteVector *byte_vector_create(const unsigned char *pBytes, unsigned int length, int *error) {
+    SetError(error, 0);
+    if (pBytes == nullptr && length > 0) {
+        SetError(error, STUB_ERROR_NULL_POINTER);
+        return nullptr;
+    }
+    return NewByteVector(pBytes, length);
+}
+
+unsigned char byte_vector_get_at(ByteVector *pBytes, unsigned int index, int *error) {
+    if (!CheckNotNull(pBytes, error) || !CheckIndex(index, ToStub<StubBytes>(pBytes)->bytes.size(), error)) {
+        return 0;
+    }
+    return ToStub<StubBytes>(pBytes)->bytes[index];
+}
+
+unsigned int byte_vector_get_length(const ByteVector *pBytes, int *error) {
+    if (!CheckNotNull(pBytes, error)) {
+        return 0;
+    }
+    return static_cast<unsigned int>(ToStub<StubBytes>(pBytes)->bytes.size());
+}
+
+void byte_vector_destroy(ByteVector *pBytes) {
+    delete ToStub<StubBytes>(pBytes);
+}
+
+// keys
+
+static TariPublicKey *NewPublicKey(const StubKey &key) {
+    return ToFfi<TariPublicKey>(new StubKey(key));
+}
+
+static bool KeyFromBytes(ByteVector *pBytes, StubKey &key, int *error) {
+    if (!CheckNotNull(pBytes, error)) {
+        return false;
+    }
+    const std::vector<uint8_t> &bytes = ToStub<StubBytes>(pBytes)->bytes;
+    if (bytes.size() != STUB_KEY_SIZE) {
+        SetError(error, STUB_ERROR_INVALID_ARGUMENT);
+        return false;
+    }
+    std::copy(bytes.begin(), bytes.end(), key.begin());
+    return true;
+}
+
+static bool KeyFromHex(const char *pHex, StubKey &key, int *error) {
+    if (!CheckNotNull(pHex, error)) {
+        return false;
+    }
+    if (strlen(pHex) != STUB_KEY_SIZE * 2 || !HexDecode(pHex, STUB_KEY_SIZE * 2, key.data())) {
+        SetError(error, STUB_ERROR_INVALID_ARGUMENT);
+        return false;
+    }
+    return true;
+}
+
+TariPublicKey *public_key_create(ByteVector *pBytes, int *error) {
+    StubKey key{};
+    return KeyFromBytes(pBytes, key, error) ? NewPublicKey(key) : nullptr;
+}
+
+ByteVector *public_key_get_bytes(TariPublicKey *pKey, int *error) {
+    if (!CheckNotNull(pKey, error)) {
+        return nullptr;
+    }
+    return NewByteVector(ToStub<StubKey>(pKey)->data(), STUB_KEY_SIZE);
+}
+
+TariPublicKey *public_key_from_private_key(TariPrivateKey *pKey, int *error) {
+    if (!CheckNotNull(pKey, error)) {
+        return nullptr;
+    }
+    StubKey key = *ToStub<StubKey>(pKey);
+    uint64_t seed;
+    memcpy(&seed, key.data(), sizeof(seed));
+    return NewPublicKey(NewKey(seed));
+}
+
+TariPublicKey *public_key_from_hex(const char *pHex, int *error) {
+    StubKey key{};
+    return KeyFromHex(pHex, key, error) ? NewPublicKey(key) : nullptr;
+}
+
+char *public_key_get_emoji_encoding(TariPublicKey *pKey, int *error) {
+    if (!CheckNotNull(pKey, error)) {
+        return nullptr;
+    }
+    StubKey &key = *ToStub<StubKey>(pKey);
+    return NewCString(EncodeEmojiId(std::vector<uint8_t>(key.begin(), key.end())));
+}
+
+void public_key_destroy(TariPublicKey *pKey) {
+    delete ToStub<StubKey>(pKey);
+}
+
+unsigned int public_keys_get_length(const TariPublicKeys *pKeys, int *error) {
+    if (!CheckNotNull(pKeys, error)) {
+        return 0;
+    }
+    return static_cast<unsigned int>(ToStub<StubList<StubKey>>(pKeys)->items.size());
+}
+
+TariPublicKey *public_keys_get_at(const TariPublicKeys *pKeys, unsigned int index, int *error) {
+    if (!CheckNotNull(pKeys, error)) {
+        return nullptr;
+    }
+    const std::vector<StubKey> &items = ToStub<StubList<StubKey>>(pKeys)->items;
+    return CheckIndex(index, items.size(), error) ? NewPublicKey(items[index]) : nullptr;
+}
+
+void public_keys_destroy(TariPublicKeys *pKeys) {
+    delete ToStub<StubList<StubKey>>(pKeys);
+}
+
+TariPrivateKey *private_key_create(ByteVector *pBytes, int *error) {
+    StubKey key{};
+    return KeyFromBytes(pBytes, key, error) ? ToFfi<TariPrivateKey>(new StubKey(key)) : nullptr;
+}
+
+TariPrivateKey *private_key_generate() {
+    static std::atomic<uint64_t> seed{1};
+    return ToFfi<TariPrivateKey>(new StubKey(NewKey(seed.fetch_add(1))));
+}
+
+TariPrivateKey *private_key_from_hex(const char *pHex, int *error) {
+    StubKey key{};
+    return KeyFromHex(pHex, key, error) ? ToFfi<TariPrivateKey>(new StubKey(key)) : nullptr;
+}
+
+ByteVector *private_key_get_bytes(TariPrivateKey *pKey, int *error) {
+    if (!CheckNotNull(pKey, error)) {
+        return nullptr;
+    }
+    return NewByteVector(ToStub<StubKey>(pKey)->data(), STUB_KEY_SIZE);
+}
+
+void private_key_destroy(TariPrivateKey *pKey) {
+    delete ToStub<StubKey>(pKey);
+}
+
+// addresses
+
+static TariWalletAddress *NewFfiAddress(const StubAddress &address) {
+    return ToFfi<TariWalletAddress>(new StubAddress(address));
+}
+
+static TariWalletAddress *NewValidAddress(std::vector<uint8_t> bytes, int *error) {
+    if (!IsValidAddress(bytes)) {
+        SetError(error, STUB_ERROR_INVALID_ARGUMENT);
+        return nullptr;
+    }
+    return ToFfi<TariWalletAddress>(new StubAddress{std::move(bytes)});
+}
+
+TariWalletAddress *tari_address_create(ByteVector *pBytes, int *error) {
+    if (!CheckNotNull(pBytes, error)) {
+        return nullptr;
+    }
+    return NewValidAddress(ToStub<StubBytes>(pBytes)->bytes, error);
+}
+
+TariWalletAddress *tari_address_from_base58(const char *pText, int *error) {
+    std::vector<uint8_t> bytes;
+    if (!CheckNotNull(pText, error)) {
+        return nullptr;
+    }
+    if (!DecodeBase58(pText, bytes)) {
+        SetError(error, STUB_ERROR_INVALID_ARGUMENT);
+        return nullptr;
+    }
+    return NewValidAddress(std::move(bytes), error);
+}
+
+TariWalletAddress *emoji_id_to_tari_address(const char *pEmojiId, int *error) {
+    std::vector<uint8_t> bytes;
+    if (!CheckNotNull(pEmojiId, error)) {
+        return nullptr;
+    }
+    if (!DecodeEmojiId(pEmojiId, bytes)) {
+        SetError(error, STUB_ERROR_INVALID_ARGUMENT);
+        return nullptr;
+    }
+    return NewValidAddress(std::move(bytes), error);
+}
+
+char *tari_address_to_emoji_id(TariWalletAddress *pAddress, int *error) {
+    if (!CheckNotNull(pAddress, error)) {
+        return nullptr;
+    }
+    return NewCString(EncodeEmojiId(ToStub<StubAddress>(pAddress)->bytes));
+}
+
+ByteVector *tari_address_get_bytes(TariWalletAddress *pAddress, int *error) {
+    if (!CheckNotNull(pAddress, error)) {
+        return nullptr;
+    }
+    const std::vector<uint8_t> &bytes = ToStub<StubAddress>(pAddress)->bytes;
+    return NewByteVector(bytes.data(), bytes.size());
+}
+
+uint8_t tari_address_network_u8(TariWalletAddress *pAddress, int *error) {
+    return CheckNotNull(pAddress, error) ? ToStub<StubAddress>(pAddress)->bytes.front() : 0;
+}
+
+uint8_t tari_address_features_u8(TariWalletAddress *pAddress, int *error) {
+    return CheckNotNull(pAddress, error) ? ToStub<StubAddress>(pAddress)->bytes[1] : 0;
+}
+
+uint8_t tari_address_checksum_u8(TariWalletAddress *pAddress, int *error) {
+    return CheckNotNull(pAddress, error) ? ToStub<StubAddress>(pAddress)->bytes.back() : 0;
+}
+
+static StubKey AddressKey(const StubAddress &address, size_t offset) {
+    StubKey key{};
+    if (offset + STUB_KEY_SIZE < address.bytes.size()) {
+        std::copy_n(address.bytes.begin() + static_cast<long>(offset), STUB_KEY_SIZE, key.begin());
+    }
+    return key;
+}
+
+TariPublicKey *tari_address_view_key(TariWalletAddress *pAddress, int *error) {
+    if (!CheckNotNull(pAddress, error)) {
+        return nullptr;
+    }
+    const StubAddress &address = *ToStub<StubAddress>(pAddress);
+    // single addresses have no view key
+    return address.bytes.size() >= DUAL_ADDRESS_SIZE ? NewPublicKey(AddressKey(address, 2)) : nullptr;
+}
+
+TariPublicKey *tari_address_spend_key(TariWalletAddress *pAddress, int *error) {
+    if (!CheckNotNull(pAddress, error)) {
+        return nullptr;
+    }
+    const StubAddress &address = *ToStub<StubAddress>(pAddress);
+    return NewPublicKey(AddressKey(address, address.bytes.size() >= DUAL_ADDRESS_SIZE ? 2 + STUB_KEY_SIZE : 2));
+}
+
+void tari_address_destroy(TariWalletAddress *pAddress) {
+    delete ToStub<StubAddress>(pAddress);
+}
+
+// emoji set
+
+EmojiSet *get_emoji_set() {
+    auto pSet = new StubList<StubBytes>();
+    pSet->items.reserve(EMOJI_SET_SIZE);
+    for (uint32_t codepoint : EMOJI_CODEPOINTS) {
+        std::string text;
+        AppendUtf8(text, codepoint);
+        pSet->items.push_back({std::vector<uint8_t>(text.begin(), text.end())});
+    }
+    return ToFfi<EmojiSet>(pSet);
+}
+
+int emoji_set_get_length(const EmojiSet *pSet, int *error) {
+    return CheckNotNull(pSet, error) ? static_cast<int>(ToStub<StubList<StubBytes>>(pSet)->items.size()) : 0;
+}
+
+ByteVector *emoji_set_get_at(const EmojiSet *pSet, unsigned int index, int *error) {
+    if (!CheckNotNull(pSet, error)) {
+        return nullptr;
+    }
+    const std::vector<StubBytes> &items = ToStub<StubList<StubBytes>>(pSet)->items;
+    return CheckIndex(index, items.size(), error) ? ToFfi<ByteVector>(new StubBytes(items[index])) : nullptr;
+}
+
+void emoji_set_destroy(EmojiSet *pSet) {
+    delete ToStub<StubList<StubBytes>>(pSet);
+}
+
+// seed words
+
+TariSeedWords *seed_words_create() {
+    return ToFfi<TariSeedWords>(new StubSeedWords());
+}
+
+TariSeedWords *seed_words_create_from_cipher(const char *pCipher, const char *pPassphrase, int *error) {
+    if (!CheckNotNull(pCipher, error)) {
+        return nullptr;
+    }
+    uint64_t seed = 0;
+    for (const char *p = pCipher; *p != '\0'; p++) {
+        seed = seed * 31 + static_cast<uint8_t>(*p);
+    }
+    auto pWords = new StubSeedWords();
+    const std::vector<std::string> &words = MnemonicWords();
+    for (int i = 0; i < STUB_SEED_WORD_COUNT; i++) {
+        pWords->words.push_back(words[StubRandom(seed) % words.size()]);
+    }
+    return ToFfi<TariSeedWords>(pWords);
+}
+
+TariSeedWords *seed_words_get_mnemonic_word_list_for_language(const char *pLanguage, int *error) {
+    if (!CheckNotNull(pLanguage, error)) {
+        return nullptr;
+    }
+    return ToFfi<TariSeedWords>(new StubSeedWords{MnemonicWords()});
+}
+
+unsigned int seed_words_get_length(const TariSeedWords *pWords, int *error) {
+    return CheckNotNull(pWords, error) ? static_cast<unsigned int>(ToStub<StubSeedWords>(pWords)->words.size()) : 0;
+}
+
+char *seed_words_get_at(TariSeedWords *pWords, unsigned int index, int *error) {
+    if (!CheckNotNull(pWords, error)) {
+        return nullptr;
+    }
+    const std::vector<std::string> &words = ToStub<StubSeedWords>(pWords)->words;
+    return CheckIndex(index, words.size(), error) ? NewCString(words[index]) : nullptr;
+}
+
+/**
+ * Same results as libwallet: 0 invalid word, 1 word added, 2 last word added and the seed is valid,
+ * 3 last word added and the seed is invalid.
+ */
+unsigned char seed_words_push_word(TariSeedWords *pWords, const char *pWord, const char *pPassphrase, int *error) {
+    if (!CheckNotNull(pWords, error) || !CheckNotNull(pWord, error)) {
+        return 0;
+    }
+    const std::vector<std::string> &mnemonicWords = MnemonicWords();
+    if (!std::binary_search(mnemonicWords.begin(), mnemonicWords.end(), std::string(pWord))) {
+        return 0;
+    }
+    std::vector<std::string> &words = ToStub<StubSeedWords>(pWords)->words;
+    if (words.size() >= STUB_SEED_WORD_COUNT) {
+        return 3;
+    }
+    words.emplace_back(pWord);
+    return words.size() == STUB_SEED_WORD_COUNT ? 2 : 1;
+}
+
+void seed_words_destroy(TariSeedWords *pWords) {
+    delete ToStub<StubSeedWords>(pWords);
+}
+
+// contacts
+
+TariContact *contact_create(const char *pAlias, TariWalletAddress *pAddress, bool favourite, int *error) {
+    if (!CheckNotNull(pAlias, error) || !CheckNotNull(pAddress, error)) {
+        return nullptr;
+    }
+    return ToFfi<TariContact>(new StubContact{pAlias, *ToStub<StubAddress>(pAddress), favourite});
+}
+
+char *contact_get_alias(TariContact *pContact, int *error) {
+    return CheckNotNull(pContact, error) ? NewCString(ToStub<StubContact>(pContact)->alias) : nullptr;
+}
+
+bool contact_get_favourite(TariContact *pContact, int *error) {
+    return CheckNotNull(pContact, error) && ToStub<StubContact>(pContact)->favourite;
+}
+
+TariWalletAddress *contact_get_tari_address(TariContact *pContact, int *error) {
+    return CheckNotNull(pContact, error) ? NewFfiAddress(ToStub<StubContact>(pContact)->address) : nullptr;
+}
+
+void contact_destroy(TariContact *pContact) {
+    delete ToStub<StubContact>(pContact);
+}
+
+unsigned int contacts_get_length(TariContacts *pContacts, int *error) {
+    return CheckNotNull(pContacts, error)
+           ? static_cast<unsigned int>(ToStub<StubList<StubContact>>(pContacts)->items.size()) : 0;
+}
+
+TariContact *contacts_get_at(TariContacts *pContacts, unsigned int index, int *error) {
+    if (!CheckNotNull(pContacts, error)) {
+        return nullptr;
+    }
+    const std::vector<StubContact> &items = ToStub<StubList<StubContact>>(pContacts)->items;
+    return CheckIndex(index, items.size(), error) ? ToFfi<TariContact>(new StubContact(items[index])) : nullptr;
+}
+
+void contacts_destroy(TariContacts *pContacts) {
+    delete ToStub<StubList<StubContact>>(pContacts);
+}
+
+// completed transactions
+
+static const StubCompletedTx *CompletedTx(TariCompletedTransaction *pTx, int *error) {
+    return CheckNotNull(pTx, error) ? ToStub<StubCompletedTx>(pTx) : nullptr;
+}
+
+unsigned long long completed_transaction_get_transaction_id(TariCompletedTransaction *pTx, int *error) {
+    const StubCompletedTx *pStub = CompletedTx(pTx, error);
+    return pStub != nullptr ? pStub->id : 0;
+}
+
+TariWalletAddress *completed_transaction_get_destination_tari_address(TariCompletedTransaction *pTx, int *error) {
+    const StubCompletedTx *pStub = CompletedTx(pTx, error);
+    return pStub != nullptr ? NewFfiAddress(pStub->destination) : nullptr;
+}
+
+TariWalletAddress *completed_transaction_get_source_tari_address(TariCompletedTransaction *pTx, int *error) {
+    const StubCompletedTx *pStub = CompletedTx(pTx, error);
+    return pStub != nullptr ? NewFfiAddress(pStub->source) : nullptr;
+}
+
+TariTransactionKernel *completed_transaction_get_transaction_kernel(TariCompletedTransaction *pTx, int *error) {
+    const StubCompletedTx *pStub = CompletedTx(pTx, error);
+    if (pStub == nullptr) {
+        return nullptr;
+    }
+    uint64_t seed = pStub->id;
+    StubKey excess = NewKey(StubRandom(seed));
+    StubKey nonce = NewKey(StubRandom(seed));
+    StubKey signature = NewKey(StubRandom(seed));
+    return ToFfi<TariTransactionKernel>(new StubKernel{ToHex(excess.data(), excess.size()),
+                                                       ToHex(nonce.data(), nonce.size()),
+                                                       ToHex(signature.data(), signature.size())});
+}
+
+unsigned long long completed_transaction_get_amount(TariCompletedTransaction *pTx, int *error) {
+    const StubCompletedTx *pStub = CompletedTx(pTx, error);
+    return pStub != nullptr ? pStub->amount : 0;
+}
+
+unsigned long long completed_transaction_get_fee(TariCompletedTransaction *pTx, int *error) {
+    const StubCompletedTx *pStub = CompletedTx(pTx, error);
+    return pStub != nullptr ? pStub->fee : 0;
+}
+
+unsigned long long completed_transaction_get_timestamp(TariCompletedTransaction *pTx, int *error) {
+    const StubCompletedTx *pStub = CompletedTx(pTx, error);
+    return pStub != nullptr ? pStub->timestamp : 0;
+}
+
+unsigned long long completed_transaction_get_mined_timestamp(TariCompletedTransaction *pTx, int *error) {
+    const StubCompletedTx *pStub = CompletedTx(pTx, error);
+    return pStub != nullptr ? pStub->minedTimestamp : 0;
+}
+
+unsigned long long completed_transaction_get_mined_height(TariCompletedTransaction *pTx, int *error) {
+    const StubCompletedTx *pStub = CompletedTx(pTx, error);
+    return pStub != nullptr ? pStub->minedHeight : 0;
+}
+
+char *completed_transaction_get_user_payment_id(TariCompletedTransaction *pTx, int *error) {
+    const StubCompletedTx *pStub = CompletedTx(pTx, error);
+    return pStub != nullptr ? NewCString(pStub->paymentId) : nullptr;
+}
+
+ByteVector *completed_transaction_get_payment_id_as_bytes(TariCompletedTransaction *pTx, int *error) {
+    const StubCompletedTx *pStub = CompletedTx(pTx, error);
+    return pStub != nullptr ? NewByteVector(reinterpret_cast<const uint8_t *>(pStub->paymentId.data()),
+                                            pStub->paymentId.size()) : nullptr;
+}
+
+ByteVector *completed_transaction_get_user_payment_id_as_bytes(TariCompletedTransaction *pTx, int *error) {
+    return completed_transaction_get_payment_id_as_bytes(pTx, error);
+}
+
+int completed_transaction_get_status(TariCompletedTransaction *pTx, int *error) {
+    const StubCompletedTx *pStub = CompletedTx(pTx, error);
+    return pStub != nullptr ? pStub->status : 0;
+}
+
+bool completed_transaction_is_outbound(TariCompletedTransaction *pTx, int *error) {
+    const StubCompletedTx *pStub = CompletedTx(pTx, error);
+    return pStub != nullptr && pStub->outbound;
+}
+
+int completed_transaction_get_cancellation_reason(TariCompletedTransaction *pTx, int *error) {
+    const StubCompletedTx *pStub = CompletedTx(pTx, error);
+    return pStub != nullptr ? pStub->cancellationReason : -1;
+}
+
+void completed_transaction_destroy(TariCompletedTransaction *pTx) {
+    delete ToStub<StubCompletedTx>(pTx);
+}
+
+unsigned int completed_transactions_get_length(TariCompletedTransactions *pTxs, int *error) {
+    return CheckNotNull(pTxs, error)
+           ? static_cast<unsigned int>(ToStub<StubList<StubCompletedTx>>(pTxs)->items.size()) : 0;
+}
+
+TariCompletedTransaction *completed_transactions_get_at(TariCompletedTransactions *pTxs, unsigned int index, int *error) {
+    if (!CheckNotNull(pTxs, error)) {
+        return nullptr;
+    }
+    const std::vector<StubCompletedTx> &items = ToStub<StubList<StubCompletedTx>>(pTxs)->items;
+    return CheckIndex(index, items.size(), error)
+           ? ToFfi<TariCompletedTransaction>(new StubCompletedTx(items[index])) : nullptr;
+}
+
+void completed_transactions_destroy(TariCompletedTransactions *pTxs) {
+    delete ToStub<StubList<StubCompletedTx>>(pTxs);
+}
+
+// pending inbound transactions
+
+static const StubPendingInboundTx *PendingInboundTx(TariPendingInboundTransaction *pTx, int *error) {
+    return CheckNotNull(pTx, error) ? ToStub<StubPendingInboundTx>(pTx) : nullptr;
+}
+
+unsigned long long pending_inbound_transaction_get_transaction_id(TariPendingInboundTransaction *pTx, int *error) {
+    const StubPendingInboundTx *pStub = PendingInboundTx(pTx, error);
+    return pStub != nullptr ? pStub->id : 0;
+}
+
+TariWalletAddress *pending_inbound_transaction_get_source_tari_address(TariPendingInboundTransaction *pTx, int *error) {
+    const StubPendingInboundTx *pStub = PendingInboundTx(pTx, error);
+    return pStub != nullptr ? NewFfiAddress(pStub->source) : nullptr;
+}
+
+unsigned long long pending_inbound_transaction_get_amount(TariPendingInboundTransaction *pTx, int *error) {
+    const StubPendingInboundTx *pStub = PendingInboundTx(pTx, error);
+    return pStub != nullptr ? pStub->amount : 0;
+}
+
+unsigned long long pending_inbound_transaction_get_timestamp(TariPendingInboundTransaction *pTx, int *error) {
+    const StubPendingInboundTx *pStub = PendingInboundTx(pTx, error);
+    return pStub != nullptr ? pStub->timestamp : 0;
+}
+
+char *pending_inbound_transaction_get_payment_id(TariPendingInboundTransaction *pTx, int *error) {
+    const StubPendingInboundTx *pStub = PendingInboundTx(pTx, error);
+    return pStub != nullptr ? NewCString(pStub->paymentId) : nullptr;
+}
+
+ByteVector *pending_inbound_transaction_get_payment_id_as_bytes(TariPendingInboundTransaction *pTx, int *error) {
+    const StubPendingInboundTx *pStub = PendingInboundTx(pTx, error);
+    return pStub != nullptr ? NewByteVector(reinterpret_cast<const uint8_t *>(pStub->paymentId.data()),
+                                            pStub->paymentId.size()) : nullptr;
+}
+
+ByteVector *pending_inbound_transaction_get_user_payment_id_as_bytes(TariPendingInboundTransaction *pTx, int *error) {
+    return pending_inbound_transaction_get_payment_id_as_bytes(pTx, error);
+}
+
+int pending_inbound_transaction_get_status(TariPendingInboundTransaction *pTx, int *error) {
+    const StubPendingInboundTx *pStub = PendingInboundTx(pTx, error);
+    return pStub != nullptr ? pStub->status : 0;
+}
+
+void pending_inbound_transaction_destroy(TariPendingInboundTransaction *pTx) {
+    delete ToStub<StubPendingInboundTx>(pTx);
+}
+
+unsigned int pending_inbound_transactions_get_length(TariPendingInboundTransactions *pTxs, int *error) {
+    return CheckNotNull(pTxs, error)
+           ? static_cast<unsigned int>(ToStub<StubList<StubPendingInboundTx>>(pTxs)->items.size()) : 0;
+}
+
+TariPendingInboundTransaction *pending_inbound_transactions_get_at(TariPendingInboundTransactions *pTxs,
+                                                                   unsigned int index, int *error) {
+    if (!CheckNotNull(pTxs, error)) {
+        return nullptr;
+    }
+    const std::vector<StubPendingInboundTx> &items = ToStub<StubList<StubPendingInboundTx>>(pTxs)->items;
+    return CheckIndex(index, items.size(), error)
+           ? ToFfi<TariPendingInboundTransaction>(new StubPendingInboundTx(items[index])) : nullptr;
+}
+
+void pending_inbound_transactions_destroy(TariPendingInboundTransactions *pTxs) {
+    delete ToStub<StubList<StubPendingInboundTx>>(pTxs);
+}
+
+// pending outbound transactions
+
+static const StubPendingOutboundTx *PendingOutboundTx(TariPendingOutboundTransaction *pTx, int *error) {
+    return CheckNotNull(pTx, error) ? ToStub<StubPendingOutboundTx>(pTx) : nullptr;
+}
+
+unsigned long long pending_outbound_transaction_get_transaction_id(TariPendingOutboundTransaction *pTx, int *error) {
+    const StubPendingOutboundTx *pStub = PendingOutboundTx(pTx, error);
+    return pStub != nullptr ? pStub->id : 0;
+}
+
+TariWalletAddress *pending_outbound_transaction_get_destination_tari_address(TariPendingOutboundTransaction *pTx,
+                                                                             int *error) {
+    const StubPendingOutboundTx *pStub = PendingOutboundTx(pTx, error);
+    return pStub != nullptr ? NewFfiAddress(pStub->destination) : nullptr;
+}
+
+unsigned long long pending_outbound_transaction_get_amount(TariPendingOutboundTransaction *pTx, int *error) {
+    const StubPendingOutboundTx *pStub = PendingOutboundTx(pTx, error);
+    return pStub != nullptr ? pStub->amount : 0;
+}
+
+unsigned long long pending_outbound_transaction_get_fee(TariPendingOutboundTransaction *pTx, int *error) {
+    const StubPendingOutboundTx *pStub = PendingOutboundTx(pTx, error);
+    return pStub != nullptr ? pStub->fee : 0;
+}
+
+unsigned long long pending_outbound_transaction_get_timestamp(TariPendingOutboundTransaction *pTx, int *error) {
+    const StubPendingOutboundTx *pStub = PendingOutboundTx(pTx, error);
+    return pStub != nullptr ? pStub->timestamp : 0;
+}
+
+char *pending_outbound_transaction_get_payment_id(TariPendingOutboundTransaction *pTx, int *error) {
+    const StubPendingOutboundTx *pStub = PendingOutboundTx(pTx, error);
+    return pStub != nullptr ? NewCString(pStub->paymentId) : nullptr;
+}
+
+ByteVector *pending_outbound_transaction_get_payment_id_as_bytes(TariPendingOutboundTransaction *pTx, int *error) {
+    const StubPendingOutboundTx *pStub = PendingOutboundTx(pTx, error);
+    return pStub != nullptr ? NewByteVector(reinterpret_cast<const uint8_t *>(pStub->paymentId.data()),
+                                            pStub->paymentId.size()) : nullptr;
+}
+
+ByteVector *pending_outbound_transaction_get_user_payment_id_as_bytes(TariPendingOutboundTransaction *pTx, int *error) {
+    return pending_outbound_transaction_get_payment_id_as_bytes(pTx, error);
+}
+
+int pending_outbound_transaction_get_status(TariPendingOutboundTransaction *pTx, int *error) {
+    const StubPendingOutboundTx *pStub = PendingOutboundTx(pTx, error);
+    return pStub != nullptr ? pStub->status : 0;
+}
+
+void pending_outbound_transaction_destroy(TariPendingOutboundTransaction *pTx) {
+    delete ToStub<StubPendingOutboundTx>(pTx);
+}
+
+unsigned int pending_outbound_transactions_get_length(TariPendingOutboundTransactions *pTxs, int *error) {
+    return CheckNotNull(pTxs, error)
+           ? static_cast<unsigned int>(ToStub<StubList<StubPendingOutboundTx>>(pTxs)->items.size()) : 0;
+}
+
+TariPendingOutboundTransaction *pending_outbound_transactions_get_at(TariPendingOutboundTransactions *pTxs,
+                                                                     unsigned int index, int *error) {
+    if (!CheckNotNull(pTxs, error)) {
+        return nullptr;
+    }
+    const std::vector<StubPendingOutboundTx> &items = ToStub<StubList<StubPendingOutboundTx>>(pTxs)->items;
+    return CheckIndex(index, items.size(), error)
+           ? ToFfi<TariPendingOutboundTransaction>(new StubPendingOutboundTx(items[index])) : nullptr;
+}
+
+void pending_outbound_transactions_destroy(TariPendingOutboundTransactions *pTxs) {
+    delete ToStub<StubList<StubPendingOutboundTx>>(pTxs);
+}
+
+// kernels, balances, base node state
+
+char *transaction_kernel_get_excess_hex(TariTransactionKernel *pKernel, int *error) {
+    return CheckNotNull(pKernel, error) ? NewCString(ToStub<StubKernel>(pKernel)->excess) : nullptr;
+}
+
+char *transaction_kernel_get_excess_public_nonce_hex(TariTransactionKernel *pKernel, int *error) {
+    return CheckNotNull(pKernel, error) ? NewCString(ToStub<StubKernel>(pKernel)->publicNonce) : nullptr;
+}
+
+char *transaction_kernel_get_excess_signature_hex(TariTransactionKernel *pKernel, int *error) {
+    return CheckNotNull(pKernel, error) ? NewCString(ToStub<StubKernel>(pKernel)->signature) : nullptr;
+}
+
+void transaction_kernel_destroy(TariTransactionKernel *pKernel) {
+    delete ToStub<StubKernel>(pKernel);
+}
+
+unsigned long long balance_get_available(TariBalance *pBalance, int *error) {
+    return CheckNotNull(pBalance, error) ? ToStub<StubBalance>(pBalance)->available : 0;
+}
+
+unsigned long long balance_get_pending_incoming(TariBalance *pBalance, int *error) {
+    return CheckNotNull(pBalance, error) ? ToStub<StubBalance>(pBalance)->pendingIncoming : 0;
+}
+
+unsigned long long balance_get_pending_outgoing(TariBalance *pBalance, int *error) {
+    return CheckNotNull(pBalance, error) ? ToStub<StubBalance>(pBalance)->pendingOutgoing : 0;
+}
+
+unsigned long long balance_get_time_locked(TariBalance *pBalance, int *error) {
+    return CheckNotNull(pBalance, error) ? ToStub<StubBalance>(pBalance)->timeLocked : 0;
+}
+
+void balance_destroy(TariBalance *pBalance) {
+    delete ToStub<StubBalance>(pBalance);
+}
+
+void liveness_data_destroy(TariContactsLivenessData *pData) {
+    delete ToStub<StubContact>(pData);
+}
+
+void basenode_state_destroy(TariBaseNodeState *pState) {
+    delete ToStub<uint64_t>(pState);
+}
+
+unsigned long long basenode_state_get_height_of_the_longest_chain(TariBaseNodeState *pState, int *error) {
+    return CheckNotNull(pState, error) ? *ToStub<uint64_t>(pState) : 0;
+}
+
+// comms config, send status, vectors
+
+TariCommsConfig *comms_config_create(const char *pPublicAddress, const char *pListenerAddress, int *error) {
+    if (!CheckNotNull(pPublicAddress, error) || !CheckNotNull(pListenerAddress, error)) {
+        return nullptr;
+    }
+    return ToFfi<TariCommsConfig>(new StubCommsConfig{pPublicAddress, pListenerAddress});
+}
+
+void comms_config_destroy(TariCommsConfig *pConfig) {
+    delete ToStub<StubCommsConfig>(pConfig);
+}
+
+char *wallet_get_last_version(TariCommsConfig *pConfig, int *error) {
+    return CheckNotNull(pConfig, error) ? NewCString("1.0.0") : nullptr;
+}
+
+unsigned int transaction_send_status_decode(TariTransactionSendStatus *pStatus, int *error) {
+    return CheckNotNull(pStatus, error) ? *ToStub<unsigned int>(pStatus) : 0;
+}
+
+void transaction_send_status_destroy(TariTransactionSendStatus *pStatus) {
+    delete ToStub<unsigned int>(pStatus);
+}
+
+TariVector *create_tari_vector(TariTypeTag tag) {
+    StubVector *pVector = NewStubVector(tag);
+    SyncStubVector(pVector);
+    return &pVector->vector;
+}
+
+void tari_vector_push_string(TariVector *pVector, const char *pString, int *error) {
+    if (!CheckNotNull(pVector, error) || !CheckNotNull(pString, error)) {
+        return;
+    }
+    auto pStub = reinterpret_cast<StubVector *>(pVector);
+    pStub->strings.emplace_back(pString);
+    SyncStubVector(pStub);
+}
+
+void destroy_tari_vector(TariVector *pVector) {
+    delete reinterpret_cast<StubVector *>(pVector);
+}
+
+unsigned int payment_records_get_length(TariPaymentRecords *pRecords, int *error) {
+    return CheckNotNull(pRecords, error)
+           ? static_cast<unsigned int>(ToStub<StubList<TariPaymentRecord>>(pRecords)->items.size()) : 0;
+}
+
+TariPaymentRecord *payment_records_get_at(TariPaymentRecords *pRecords, unsigned int index, int *error) {
+    if (!CheckNotNull(pRecords, error)) {
+        return nullptr;
+    }
+    std::vector<TariPaymentRecord> &items = ToStub<StubList<TariPaymentRecord>>(pRecords)->items;
+    // records point into the list, there's no destroy function for a single one
+    return CheckIndex(index, items.size(), error) ? &items[index] : nullptr;
+}
+
+void payment_records_destroy(TariPaymentRecords *pRecords) {
+    delete ToStub<StubList<TariPaymentRecord>>(pRecords);
+}
+
+// unblinded outputs, output features, fee stats
+
+unsigned int unblinded_outputs_get_length(TariUnblindedOutputs *pOutputs, int *error) {
+    return CheckNotNull(pOutputs, error)
+           ? static_cast<unsigned int>(ToStub<StubList<StubUnblindedOutput>>(pOutputs)->items.size()) : 0;
+}
+
+TariUnblindedOutput *unblinded_outputs_get_at(TariUnblindedOutputs *pOutputs, unsigned int index, int *error) {
+    if (!CheckNotNull(pOutputs, error)) {
+        return nullptr;
+    }
+    const std::vector<StubUnblindedOutput> &items = ToStub<StubList<StubUnblindedOutput>>(pOutputs)->items;
+    return CheckIndex(index, items.size(), error)
+           ? ToFfi<TariUnblindedOutput>(new StubUnblindedOutput(items[index])) : nullptr;
+}
+
+void unblinded_outputs_destroy(TariUnblindedOutputs *pOutputs) {
+    delete ToStub<StubList<StubUnblindedOutput>>(pOutputs);
+}
+
+TariUnblindedOutput *create_tari_unblinded_output_from_json(const char *pJson, int *error) {
+    return CheckNotNull(pJson, error) ? ToFfi<TariUnblindedOutput>(new StubUnblindedOutput{pJson}) : nullptr;
+}
+
+char *tari_unblinded_output_to_json(TariUnblindedOutput *pOutput, int *error) {
+    return CheckNotNull(pOutput, error) ? NewCString(ToStub<StubUnblindedOutput>(pOutput)->json) : nullptr;
+}
+
+void tari_unblinded_output_destroy(TariUnblindedOutput *pOutput) {
+    delete ToStub<StubUnblindedOutput>(pOutput);
+}
+
+TariOutputFeatures *output_features_create_from_bytes(unsigned short version, unsigned short outputType,
+                                                      unsigned long long maturity, ByteVector *pMetadata,
+                                                      unsigned short rangeProofType, int *error) {
+    SetError(error, 0);
+    return ToFfi<TariOutputFeatures>(new StubBytes(pMetadata != nullptr ? *ToStub<StubBytes>(pMetadata) : StubBytes()));
+}
+
+void output_features_destroy(TariOutputFeatures *pFeatures) {
+    delete ToStub<StubBytes>(pFeatures);
+}
+
+unsigned int fee_per_gram_stats_get_length(TariFeePerGramStats *pStats, int *error) {
+    return CheckNotNull(pStats, error)
+           ? static_cast<unsigned int>(ToStub<StubList<StubFeePerGramStat>>(pStats)->items.size()) : 0;
+}
+
+TariFeePerGramStat *fee_per_gram_stats_get_at(TariFeePerGramStats *pStats, unsigned int index, int *error) {
+    if (!CheckNotNull(pStats, error)) {
+        return nullptr;
+    }
+    const std::vector<StubFeePerGramStat> &items = ToStub<StubList<StubFeePerGramStat>>(pStats)->items;
+    return CheckIndex(index, items.size(), error)
+           ? ToFfi<TariFeePerGramStat>(new StubFeePerGramStat(items[index])) : nullptr;
+}
+
+void fee_per_gram_stats_destroy(TariFeePerGramStats *pStats) {
+    delete ToStub<StubList<StubFeePerGramStat>>(pStats);
+}
+
+unsigned long long fee_per_gram_stat_get_order(TariFeePerGramStat *pStat, int *error) {
+    return CheckNotNull(pStat, error) ? ToStub<StubFeePerGramStat>(pStat)->order : 0;
+}
+
+unsigned long long fee_per_gram_stat_get_min_fee_per_gram(TariFeePerGramStat *pStat, int *error) {
+    return CheckNotNull(pStat, error) ? ToStub<StubFeePerGramStat>(pStat)->min : 0;
+}
+
+unsigned long long fee_per_gram_stat_get_avg_fee_per_gram(TariFeePerGramStat *pStat, int *error) {
+    return CheckNotNull(pStat, error) ? ToStub<StubFeePerGramStat>(pStat)->avg : 0;
+}
+
+unsigned long long fee_per_gram_stat_get_max_fee_per_gram(TariFeePerGramStat *pStat, int *error) {
+    return CheckNotNull(pStat, error) ? ToStub<StubFeePerGramStat>(pStat)->max : 0;
+}
+
+void log_debug_message(const char *pMessage, int *error) {
+    CheckNotNull(pMessage, error);
+}
+
+// wallet
+
+TariWallet *wallet_create(void *context, TariCommsConfig *pConfig, const char *logPath, int logVerbosity,
+                          unsigned int numRollingLogFiles, unsigned int sizePerLogFileBytes, const char *passphrase,
+                          const char *seedPassphrase, const TariSeedWords *pSeedWords, const char *network,
+                          const char *peerSeed, const char *dnsSecServer, bool dnsSec, const char *httpBaseNode,
+                          unsigned long long birthdayOffset,
+                          void (*txReceived)(void *, TariPendingInboundTransaction *),
+                          void (*txReplyReceived)(void *, TariCompletedTransaction *),
+                          void (*txFinalized)(void *, TariCompletedTransaction *),
+                          void (*txBroadcast)(void *, TariCompletedTransaction *),
+                          void (*txMined)(void *, TariCompletedTransaction *),
+                          void (*txMinedUnconfirmed)(void *, TariCompletedTransaction *, uint64_t),
+                          void (*txFauxConfirmed)(void *, TariCompletedTransaction *),
+                          void (*txFauxUnconfirmed)(void *, TariCompletedTransaction *, uint64_t),
+                          void (*txDirectSendResult)(void *, unsigned long long, TariTransactionSendStatus *),
+                          void (*txCancellation)(void *, TariCompletedTransaction *, uint64_t),
+                          void (*txoValidationComplete)(void *, uint64_t, uint64_t),
+                          void (*contactsLivenessDataUpdated)(void *, TariContactsLivenessData *),
+                          void (*balanceUpdated)(void *, TariBalance *),
+                          void (*transactionValidationComplete)(void *, uint64_t, uint64_t),
+                          void (*storeAndForwardMessagesReceived)(void *),
+                          void (*connectivityStatus)(void *, uint64_t),
+                          void (*walletScannedHeight)(void *, uint64_t),
+                          void (*baseNodeStatus)(void *, TariBaseNodeState *),
+                          bool *recoveryInProgress, int *error) {
+    if (!CheckNotNull(pConfig, error)) {
+        return nullptr;
+    }
+    auto pWallet = new StubWallet();
+    pWallet->callbacks = {context, txReceived, txReplyReceived, txFinalized, txBroadcast, txMined, txMinedUnconfirmed,
+                          txFauxConfirmed, txFauxUnconfirmed, txDirectSendResult, txCancellation,
+                          txoValidationComplete, contactsLivenessDataUpdated, balanceUpdated,
+                          transactionValidationComplete, storeAndForwardMessagesReceived, connectivityStatus,
+                          walletScannedHeight, baseNodeStatus, nullptr};
+    FillDataset(*pWallet, GetDataset());
+    if (pSeedWords != nullptr) {
+        pWallet->seedWords = *ToStub<StubSeedWords>(pSeedWords);
+    }
+    if (recoveryInProgress != nullptr) {
+        *recoveryInProgress = false;
+    }
+    return ToFfi<TariWallet>(pWallet);
+}
+
+void wallet_destroy(TariWallet *pWallet) {
+    if (pWallet != nullptr) {
+        StopEvents(ToStub<StubWallet>(pWallet), false);
+    }
+    delete ToStub<StubWallet>(pWallet);
+}
+
+static StubWallet *Wallet(TariWallet *pWallet, int *error) {
+    return CheckNotNull(pWallet, error) ? ToStub<StubWallet>(pWallet) : nullptr;
+}
+
+TariBalance *wallet_get_balance(TariWallet *pWallet, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    auto pBalance = new StubBalance();
+    for (const StubUtxo &utxo : pStub->utxos) {
+        pBalance->available += utxo.value;
+    }
+    for (const StubPendingInboundTx &tx : pStub->pendingInboundTxs) {
+        pBalance->pendingIncoming += tx.amount;
+    }
+    for (const StubPendingOutboundTx &tx : pStub->pendingOutboundTxs) {
+        pBalance->pendingOutgoing += tx.amount + tx.fee;
+    }
+    return ToFfi<TariBalance>(pBalance);
+}
+
+TariVector *wallet_get_utxos(TariWallet *pWallet, uintptr_t page, uintptr_t pageSize, TariUtxoSort sort,
+                             TariVector *pStates, uint64_t dustThreshold, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return nullptr;
+    }
+    std::vector<StubUtxo> utxos;
+    {
+        std::lock_guard<std::mutex> lock(pStub->mutex);
+        for (const StubUtxo &utxo : pStub->utxos) {
+            if (utxo.value >= dustThreshold) {
+                utxos.push_back(utxo);
+            }
+        }
+    }
+    std::sort(utxos.begin(), utxos.end(), [sort](const StubUtxo &a, const StubUtxo &b) {
+        switch (sort) {
+            case ValueDesc:
+                return a.value > b.value;
+            case MinedHeightAsc:
+                return a.minedHeight < b.minedHeight;
+            case MinedHeightDesc:
+                return a.minedHeight > b.minedHeight;
+            default:
+                return a.value < b.value;
+        }
+    });
+    size_t start = std::min<size_t>(page * pageSize, utxos.size());
+    size_t end = std::min<size_t>(start + pageSize, utxos.size());
+    std::vector<StubUtxo> pageUtxos(utxos.begin() + static_cast<long>(start), utxos.begin() + static_cast<long>(end));
+    return &NewUtxoVector(pageUtxos)->vector;
+}
+
+TariVector *wallet_get_all_utxos(TariWallet *pWallet, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    return &NewUtxoVector(pStub->utxos)->vector;
+}
+
+TariWalletAddress *wallet_get_tari_one_sided_address(TariWallet *pWallet, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    return pStub != nullptr ? NewFfiAddress(pStub->address) : nullptr;
+}
+
+TariContacts *wallet_get_contacts(TariWallet *pWallet, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    return ToFfi<TariContacts>(new StubList<StubContact>{pStub->contacts});
+}
+
+bool wallet_upsert_contact(TariWallet *pWallet, TariContact *pContact, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr || !CheckNotNull(pContact, error)) {
+        return false;
+    }
+    const StubContact &contact = *ToStub<StubContact>(pContact);
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    for (StubContact &existing : pStub->contacts) {
+        if (existing.address.bytes == contact.address.bytes) {
+            existing = contact;
+            return true;
+        }
+    }
+    pStub->contacts.push_back(contact);
+    return true;
+}
+
+bool wallet_remove_contact(TariWallet *pWallet, TariContact *pContact, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr || !CheckNotNull(pContact, error)) {
+        return false;
+    }
+    const StubContact &contact = *ToStub<StubContact>(pContact);
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    auto it = std::find_if(pStub->contacts.begin(), pStub->contacts.end(), [&contact](const StubContact &existing) {
+        return existing.address.bytes == contact.address.bytes;
+    });
+    if (it == pStub->contacts.end()) {
+        return false;
+    }
+    pStub->contacts.erase(it);
+    return true;
+}
+
+TariCompletedTransactions *wallet_get_completed_transactions(TariWallet *pWallet, int, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    return ToFfi<TariCompletedTransactions>(new StubList<StubCompletedTx>{pStub->completedTxs});
+}
+
+TariCompletedTransactions *wallet_get_cancelled_transactions(TariWallet *pWallet, int, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    return ToFfi<TariCompletedTransactions>(new StubList<StubCompletedTx>{pStub->cancelledTxs});
+}
+
+TariCompletedTransaction *wallet_get_completed_transaction_by_id(TariWallet *pWallet, unsigned long long id, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    return CopyById<TariCompletedTransaction>(pStub, &StubWallet::completedTxs, id, error);
+}
+
+TariCompletedTransaction *wallet_get_cancelled_transaction_by_id(TariWallet *pWallet, unsigned long long id, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    return CopyById<TariCompletedTransaction>(pStub, &StubWallet::cancelledTxs, id, error);
+}
+
+TariPendingOutboundTransactions *wallet_get_pending_outbound_transactions(TariWallet *pWallet, int, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    return ToFfi<TariPendingOutboundTransactions>(new StubList<StubPendingOutboundTx>{pStub->pendingOutboundTxs});
+}
+
+TariPendingOutboundTransaction *wallet_get_pending_outbound_transaction_by_id(TariWallet *pWallet, unsigned long long id,
+                                                                              int, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    return CopyById<TariPendingOutboundTransaction>(pStub, &StubWallet::pendingOutboundTxs, id, error);
+}
+
+TariPendingInboundTransactions *wallet_get_pending_inbound_transactions(TariWallet *pWallet, int, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    return ToFfi<TariPendingInboundTransactions>(new StubList<StubPendingInboundTx>{pStub->pendingInboundTxs});
+}
+
+TariPendingInboundTransaction *wallet_get_pending_inbound_transaction_by_id(TariWallet *pWallet, unsigned long long id,
+                                                                            int, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    return CopyById<TariPendingInboundTransaction>(pStub, &StubWallet::pendingInboundTxs, id, error);
+}
+
+bool wallet_cancel_pending_transaction(TariWallet *pWallet, unsigned long long id, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    auto it = std::find_if(pStub->pendingOutboundTxs.begin(), pStub->pendingOutboundTxs.end(),
+                           [id](const StubPendingOutboundTx &tx) { return tx.id == id; });
+    if (it == pStub->pendingOutboundTxs.end()) {
+        SetError(error, STUB_ERROR_NOT_FOUND);
+        return false;
+    }
+    StubCompletedTx cancelled = NewCompletedTx(it->id, 7, true, pStub->address);
+    cancelled.cancellationReason = 1;
+    pStub->cancelledTxs.push_back(cancelled);
+    pStub->pendingOutboundTxs.erase(it);
+    return true;
+}
+
+unsigned long long wallet_get_fee_estimate(TariWallet *pWallet, unsigned long long amount, TariVector *pCommitments,
+                                           unsigned long long feePerGram, unsigned long long kernelCount,
+                                           unsigned long long outputCount, int *error) {
+    return Wallet(pWallet, error) != nullptr ? feePerGram * (kernelCount * 10 + outputCount * 20 + 100) : 0;
+}
+
+uint64_t wallet_coin_join(TariWallet *pWallet, TariVector *pCommitments, uint64_t feePerGram, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr || !CheckNotNull(pCommitments, error)) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    return pStub->nextTxId++;
+}
+
+uint64_t wallet_coin_split(TariWallet *pWallet, TariVector *pCommitments, uintptr_t splitCount, uint64_t feePerGram,
+                           int *error) {
+    return wallet_coin_join(pWallet, pCommitments, feePerGram, error);
+}
+
+static TariCoinPreview *NewCoinPreview(StubWallet *pStub, TariVector *pCommitments, size_t outputCount,
+                                       uint64_t feePerGram) {
+    std::vector<uint64_t> expected(outputCount, 0);
+    uint64_t total = 0;
+    {
+        std::lock_guard<std::mutex> lock(pStub->mutex);
+        auto pCommitmentsStub = reinterpret_cast<StubVector *>(pCommitments);
+        for (const StubUtxo &utxo : pStub->utxos) {
+            if (std::find(pCommitmentsStub->strings.begin(), pCommitmentsStub->strings.end(), utxo.commitment) !=
+                pCommitmentsStub->strings.end()) {
+                total += utxo.value;
+            }
+        }
+    }
+    auto pPreview = new StubCoinPreview();
+    pPreview->preview.fee = feePerGram * (100 + outputCount * 20);
+    pPreview->pOutputs = NewStubVector(U64);
+    uint64_t available = total > pPreview->preview.fee ? total - pPreview->preview.fee : 0;
+    for (size_t i = 0; i < outputCount; i++) {
+        pPreview->pOutputs->numbers.push_back(available / outputCount);
+    }
+    SyncStubVector(pPreview->pOutputs);
+    pPreview->preview.expected_outputs = &pPreview->pOutputs->vector;
+    return &pPreview->preview;
+}
+
+TariCoinPreview *wallet_preview_coin_join(TariWallet *pWallet, TariVector *pCommitments, uint64_t feePerGram,
+                                          int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr || !CheckNotNull(pCommitments, error)) {
+        return nullptr;
+    }
+    return NewCoinPreview(pStub, pCommitments, 1, feePerGram);
+}
+
+TariCoinPreview *wallet_preview_coin_split(TariWallet *pWallet, TariVector *pCommitments, uintptr_t splitCount,
+                                           uint64_t feePerGram, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr || !CheckNotNull(pCommitments, error)) {
+        return nullptr;
+    }
+    return NewCoinPreview(pStub, pCommitments, std::max<uintptr_t>(splitCount, 1), feePerGram);
+}
+
+static unsigned long long NextRequestId(TariWallet *pWallet, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    return pStub->nextRequestId++;
+}
+
+unsigned long long wallet_start_transaction_validation(TariWallet *pWallet, int *error) {
+    return NextRequestId(pWallet, error);
+}
+
+unsigned long long wallet_restart_transaction_broadcast(TariWallet *pWallet, int *error) {
+    return NextRequestId(pWallet, error);
+}
+
+unsigned long long wallet_start_txo_validation(TariWallet *pWallet, int *error) {
+    return NextRequestId(pWallet, error);
+}
+
+void wallet_set_normal_power_mode(TariWallet *pWallet, int *error) {
+    Wallet(pWallet, error);
+}
+
+void wallet_set_low_power_mode(TariWallet *pWallet, int *error) {
+    Wallet(pWallet, error);
+}
+
+TariSeedWords *wallet_get_seed_words(TariWallet *pWallet, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    return pStub != nullptr ? ToFfi<TariSeedWords>(new StubSeedWords(pStub->seedWords)) : nullptr;
+}
+
+bool wallet_set_key_value(TariWallet *pWallet, const char *pKey, const char *pValue, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr || !CheckNotNull(pKey, error) || !CheckNotNull(pValue, error)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    pStub->values[pKey] = pValue;
+    return true;
+}
+
+char *wallet_get_value(TariWallet *pWallet, const char *pKey, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr || !CheckNotNull(pKey, error)) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    auto it = pStub->values.find(pKey);
+    if (it == pStub->values.end()) {
+        SetError(error, STUB_ERROR_NOT_FOUND);
+        return nullptr;
+    }
+    return NewCString(it->second);
+}
+
+bool wallet_clear_value(TariWallet *pWallet, const char *pKey, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr || !CheckNotNull(pKey, error)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    return pStub->values.erase(pKey) > 0;
+}
+
+unsigned long long wallet_get_num_confirmations_required(TariWallet *pWallet, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    return pStub->confirmationsRequired;
+}
+
+void wallet_set_num_confirmations_required(TariWallet *pWallet, unsigned long long count, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    pStub->confirmationsRequired = count;
+}
+
+unsigned long long wallet_send_transaction(TariWallet *pWallet, TariWalletAddress *pDestination,
+                                           unsigned long long amount, TariVector *pCommitments,
+                                           unsigned long long feePerGram, bool oneSided, const char *pPaymentId,
+                                           int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr || !CheckNotNull(pDestination, error)) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    StubPendingOutboundTx tx;
+    tx.id = pStub->nextTxId++;
+    tx.destination = *ToStub<StubAddress>(pDestination);
+    tx.amount = amount;
+    tx.fee = feePerGram * 100;
+    tx.timestamp = 1700000000 + tx.id * 60;
+    tx.paymentId = pPaymentId != nullptr ? pPaymentId : "";
+    tx.status = 4;
+    pStub->pendingOutboundTxs.push_back(tx);
+    return tx.id;
+}
+
+bool wallet_start_recovery(TariWallet *pWallet, void (*recoveryProgress)(void *, uint8_t, uint64_t, uint64_t),
+                           int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    pStub->callbacks.recoveryProgress = recoveryProgress;
+    return true;
+}
+
+char *wallet_sign_message(TariWallet *pWallet, const char *pMessage, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr || !CheckNotNull(pMessage, error)) {
+        return nullptr;
+    }
+    uint64_t seed = std::hash<std::string>()(pMessage);
+    StubKey signature = NewKey(seed);
+    StubKey nonce = NewKey(seed + 1);
+    return NewCString(ToHex(signature.data(), signature.size()) + "|" + ToHex(nonce.data(), nonce.size()));
+}
+
+bool wallet_verify_message_signature(TariWallet *pWallet, TariPublicKey *pKey, const char *pSignatureNonce,
+                                     const char *pMessage, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr || !CheckNotNull(pKey, error) || !CheckNotNull(pSignatureNonce, error) ||
+        !CheckNotNull(pMessage, error)) {
+        return false;
+    }
+    char *pExpected = wallet_sign_message(pWallet, pMessage, error);
+    bool valid = strcmp(pExpected, pSignatureNonce) == 0;
+    string_destroy(pExpected);
+    return valid;
+}
+
+TariFeePerGramStats *wallet_get_fee_per_gram_stats(TariWallet *pWallet, unsigned int count, int *error) {
+    if (Wallet(pWallet, error) == nullptr) {
+        return nullptr;
+    }
+    auto pStats = new StubList<StubFeePerGramStat>();
+    for (unsigned int i = 0; i < count; i++) {
+        pStats->items.push_back({i, 5 + i, 10 + i * 2, 20 + i * 4});
+    }
+    return ToFfi<TariFeePerGramStats>(pStats);
+}
+
+TariUnblindedOutputs *wallet_get_unspent_outputs(TariWallet *pWallet, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    auto pOutputs = new StubList<StubUnblindedOutput>();
+    for (const StubUtxo &utxo : pStub->utxos) {
+        pOutputs->items.push_back({"{\"commitment\":\"" + utxo.commitment + "\",\"value\":" + std::to_string(utxo.value) + "}"});
+    }
+    return ToFfi<TariUnblindedOutputs>(pOutputs);
+}
+
+unsigned long long wallet_import_external_utxo_as_non_rewindable(TariWallet *pWallet, TariUnblindedOutput *pOutput,
+                                                                 TariWalletAddress *pSource, const char *pMessage,
+                                                                 int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr || !CheckNotNull(pOutput, error) || !CheckNotNull(pSource, error)) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    return pStub->nextTxId++;
+}
+
+TariPublicKeys *wallet_get_seed_peers(TariWallet *pWallet, int *error) {
+    if (Wallet(pWallet, error) == nullptr) {
+        return nullptr;
+    }
+    auto pKeys = new StubList<StubKey>();
+    for (uint64_t i = 0; i < 4; i++) {
+        pKeys->items.push_back(NewKey(1000 + i));
+    }
+    return ToFfi<TariPublicKeys>(pKeys);
+}
+
+TariPrivateKey *wallet_get_private_view_key(TariWallet *pWallet, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    return pStub != nullptr ? ToFfi<TariPrivateKey>(new StubKey(pStub->privateViewKey)) : nullptr;
+}
+
+TariPaymentRecords *wallet_get_transaction_payrefs(TariWallet *pWallet, unsigned long long id, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    const StubCompletedTx *pTx = FindById(pStub->completedTxs, id);
+    if (pTx == nullptr) {
+        SetError(error, STUB_ERROR_NOT_FOUND);
+        return nullptr;
+    }
+    auto pRecords = new StubList<TariPaymentRecord>();
+    TariPaymentRecord record{};
+    StubKey reference = NewKey(pTx->id);
+    std::copy(reference.begin(), reference.end(), record.payment_reference);
+    record.amount = pTx->amount;
+    record.block_height = pTx->minedHeight;
+    record.mined_timestamp = pTx->minedTimestamp;
+    record.direction = pTx->outbound ? 1 : 0;
+    pRecords->items.push_back(record);
+    return ToFfi<TariPaymentRecords>(pRecords);
+}
+
+// stub controls
+
+const WalletStubCallbacks *wallet_stub_get_callbacks(TariWallet *pWallet) {
+    return pWallet != nullptr ? &ToStub<StubWallet>(pWallet)->callbacks : nullptr;
+}
+
+TariCompletedTransaction *wallet_stub_completed_transaction_create(unsigned long long txId, int status, bool isOutbound) {
+    return ToFfi<TariCompletedTransaction>(new StubCompletedTx(NewCompletedTx(txId, status, isOutbound, NewAddress(42))));
+}
+
+TariPendingInboundTransaction *wallet_stub_pending_inbound_transaction_create(unsigned long long txId) {
+    return ToFfi<TariPendingInboundTransaction>(new StubPendingInboundTx(NewPendingInboundTx(txId)));
+}
+
+TariTransactionSendStatus *wallet_stub_transaction_send_status_create(unsigned int status) {
+    return ToFfi<TariTransactionSendStatus>(new unsigned int(status));
+}
+
+TariBalance *wallet_stub_balance_create(unsigned long long available, unsigned long long pendingIncoming,
+                                        unsigned long long pendingOutgoing, unsigned long long timeLocked) {
+    return ToFfi<TariBalance>(new StubBalance{available, pendingIncoming, pendingOutgoing, timeLocked});
+}
+
+TariBaseNodeState *wallet_stub_base_node_state_create(unsigned long long heightOfTheLongestChain) {
+    return ToFfi<TariBaseNodeState>(new uint64_t(heightOfTheLongestChain));
+}
+
+TariContactsLivenessData *wallet_stub_liveness_data_create() {
+    return ToFfi<TariContactsLivenessData>(new StubContact());
+}
+
+char *wallet_stub_address_to_base58(TariWalletAddress *pAddress, int *error) {
+    return CheckNotNull(pAddress, error) ? NewCString(EncodeBase58(ToStub<StubAddress>(pAddress)->bytes)) : nullptr;
+}
+
+void wallet_stub_set_dataset(const WalletStubDataset *pDataset) {
+    std::lock_guard<std::mutex> lock(g_datasetMutex);
+    g_dataset = pDataset != nullptr ? *pDataset : STUB_DEFAULT_DATASET;
+}
+
+void wallet_stub_get_dataset(WalletStubDataset *pDataset) {
+    if (pDataset != nullptr) {
+        *pDataset = GetDataset();
+    }
+}
+
+bool wallet_stub_start_events(TariWallet *pWallet, const WalletStubEvents *pEvents, int *error) {
+    StubWallet *pStub = Wallet(pWallet, error);
+    if (pStub == nullptr || !CheckNotNull(pEvents, error)) {
+        return false;
+    }
+    if (pEvents->pattern < WALLET_STUB_EVENTS_STEADY_TRICKLE || pEvents->pattern > WALLET_STUB_EVENTS_CALLBACK_STORM) {
+        SetError(error, STUB_ERROR_INVALID_ARGUMENT);
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    if (pStub->pEvents != nullptr) {
+        SetError(error, STUB_ERROR_INVALID_ARGUMENT);
+        return false;
+    }
+    auto pGenerator = std::make_unique<StubEventGenerator>();
+    pGenerator->events = *pEvents;
+    pGenerator->events.threadCount = std::max(1u, pEvents->threadCount);
+    pGenerator->events.burstSize = pEvents->burstSize == 0
+                                   ? STUB_DEFAULT_BURST_SIZE
+                                   : std::max(STUB_BURST_TAIL_SIZE + 1, pEvents->burstSize);
+    pGenerator->callbacks = pStub->callbacks;
+    pGenerator->address = pStub->address;
+    for (const StubCompletedTx &tx : pStub->completedTxs) {
+        pGenerator->completedTxIds.push_back(tx.id);
+    }
+    for (const StubCompletedTx &tx : pStub->cancelledTxs) {
+        pGenerator->cancelledTxIds.push_back(tx.id);
+    }
+    pGenerator->startedAt = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < pGenerator->events.threadCount; i++) {
+        pGenerator->threads.emplace_back(RunEventThread, pGenerator.get(), i);
+    }
+    pStub->pEvents = std::move(pGenerator);
+    return true;
+}
+
+void wallet_stub_stop_events(TariWallet *pWallet, bool wait) {
+    if (pWallet != nullptr) {
+        StopEvents(ToStub<StubWallet>(pWallet), wait);
+    }
+}
+
+unsigned long long wallet_stub_get_fired_event_count(TariWallet *pWallet) {
+    if (pWallet == nullptr) {
+        return 0;
+    }
+    StubWallet *pStub = ToStub<StubWallet>(pWallet);
+    std::lock_guard<std::mutex> lock(pStub->mutex);
+    uint64_t running = pStub->pEvents != nullptr ? pStub->pEvents->firedCount.load(std::memory_order_relaxed) : 0;
+    return pStub->stoppedEventCount + running;
+}
+
+} // extern "C"
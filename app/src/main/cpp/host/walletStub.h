@@ -0,0 +1,172 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef HOST_WALLET_STUB_H
+#define HOST_WALLET_STUB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <wallet.h>
+
+/**
+ * Controls of the stub libminotari_wallet_ffi of the host build and of NATIVE_WALLET_STUB Android builds, next to the
+ * wallet.h functions it implements.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * The callbacks a wallet was created with, in the order of the wallet_create parameters.
+ */
+struct WalletStubCallbacks {
+    void *context;
+    void (*txReceived)(void *, TariPendingInboundTransaction *);
+    void (*txReplyReceived)(void *, TariCompletedTransaction *);
+    void (*txFinalized)(void *, TariCompletedTransaction *);
+    void (*txBroadcast)(void *, TariCompletedTransaction *);
+    void (*txMined)(void *, TariCompletedTransaction *);
+    void (*txMinedUnconfirmed)(void *, TariCompletedTransaction *, uint64_t);
+    void (*txFauxConfirmed)(void *, TariCompletedTransaction *);
+    void (*txFauxUnconfirmed)(void *, TariCompletedTransaction *, uint64_t);
+    void (*txDirectSendResult)(void *, unsigned long long, TariTransactionSendStatus *);
+    void (*txCancellation)(void *, TariCompletedTransaction *, uint64_t);
+    void (*txoValidationComplete)(void *, uint64_t, uint64_t);
+    void (*contactsLivenessDataUpdated)(void *, TariContactsLivenessData *);
+    void (*balanceUpdated)(void *, TariBalance *);
+    void (*transactionValidationComplete)(void *, uint64_t, uint64_t);
+    void (*storeAndForwardMessagesReceived)(void *);
+    void (*connectivityStatus)(void *, uint64_t);
+    void (*walletScannedHeight)(void *, uint64_t);
+    void (*baseNodeStatus)(void *, TariBaseNodeState *);
+    // set by wallet_start_recovery
+    void (*recoveryProgress)(void *, uint8_t, uint64_t, uint64_t);
+};
+
+const struct WalletStubCallbacks *wallet_stub_get_callbacks(TariWallet *wallet);
+
+/**
+ * Callback arguments, the callbacks take ownership like they do of the objects libwallet passes them.
+ */
+TariCompletedTransaction *wallet_stub_completed_transaction_create(unsigned long long tx_id, int status, bool is_outbound);
+TariPendingInboundTransaction *wallet_stub_pending_inbound_transaction_create(unsigned long long tx_id);
+TariTransactionSendStatus *wallet_stub_transaction_send_status_create(unsigned int status);
+TariBalance *wallet_stub_balance_create(unsigned long long available, unsigned long long pending_incoming,
+                                        unsigned long long pending_outgoing, unsigned long long time_locked);
+TariBaseNodeState *wallet_stub_base_node_state_create(unsigned long long height_of_the_longest_chain);
+TariContactsLivenessData *wallet_stub_liveness_data_create(void);
+
+/**
+ * A valid base58 address, give it back with string_destroy.
+ */
+char *wallet_stub_address_to_base58(TariWalletAddress *address, int *error_out);
+
+/**
+ * Size of the data of the wallets created from now on. Null restores the default dataset.
+ */
+struct WalletStubDataset {
+    unsigned int completedTxCount;
+    unsigned int cancelledTxCount;
+    unsigned int pendingInboundTxCount;
+    unsigned int pendingOutboundTxCount;
+    unsigned int utxoCount;
+    unsigned int contactCount;
+};
+
+void wallet_stub_set_dataset(const struct WalletStubDataset *dataset);
+
+void wallet_stub_get_dataset(struct WalletStubDataset *dataset);
+
+/**
+ * How the event generator fires the callbacks of a wallet.
+ */
+enum WalletStubEventPattern {
+    // new txs through received, finalized, broadcast, mined unconfirmed, mined, then balance and base node status
+    WALLET_STUB_EVENTS_STEADY_TRICKLE = 0,
+    // bursts of mined, faux confirmed and cancelled callbacks for the txs of the dataset, each ending with the
+    // tx and txo validation results and a balance update
+    WALLET_STUB_EVENTS_VALIDATION_BURST = 1,
+    // recovery progress, scanned height, imported txs and balance updates, meant to run without a rate limit
+    WALLET_STUB_EVENTS_RECOVERY_STORM = 2,
+    // every callback from txReceived to baseNodeStatus in turn, each event carrying its sequence number as a key
+    // the receiver can read back, see WALLET_STUB_EVENT_TX_ID_BASE. Liveness and store and forward callbacks are
+    // left out, they have no such key.
+    WALLET_STUB_EVENTS_CALLBACK_STORM = 3,
+};
+
+/**
+ * Keys of CALLBACK_STORM event n: the tx id of a tx callback or a direct send result is WALLET_STUB_EVENT_TX_ID_BASE + n,
+ * the tip of a base node status WALLET_STUB_TIP_HEIGHT + n. Validation request ids, connectivity statuses, scanned
+ * heights and available balances are n.
+ */
+#define WALLET_STUB_EVENT_TX_ID_BASE (1ull << 40)
+#define WALLET_STUB_TIP_HEIGHT 100000ull
+
+struct WalletStubEvents {
+    int pattern;
+    // native threads firing concurrently, 0 is one
+    unsigned int threadCount;
+    // over all the threads, 0 fires as fast as the callbacks return
+    unsigned int eventsPerSecond;
+    // events fired back to back before the rate limit applies, VALIDATION_BURST only, 0 is 64
+    unsigned int burstSize;
+    // over all the threads, 0 fires until wallet_stub_stop_events
+    unsigned long long eventCount;
+    // CALLBACK_STORM only, called on the firing thread with the sequence number of every event right before its
+    // callback, e.g. to timestamp it. Null for none.
+    void (*observer)(void *observerContext, unsigned long long sequence);
+    void *observerContext;
+};
+
+/**
+ * Starts firing the callbacks of the wallet from threadCount native threads. Every fired callback counts as one
+ * event, callbacks the wallet doesn't have (recovery progress before wallet_start_recovery) are skipped.
+ * Fails with an invalid argument error until the events of the last start are stopped.
+ *
+ * The events don't change the data of the wallet, the txs they're about are new or taken from the dataset.
+ */
+bool wallet_stub_start_events(TariWallet *wallet, const struct WalletStubEvents *events, int *error_out);
+
+/**
+ * Stops the generator and joins its threads, after they fired eventCount events if wait is set and there's a count.
+ * wallet_destroy stops it as well.
+ */
+void wallet_stub_stop_events(TariWallet *wallet, bool wait);
+
+unsigned long long wallet_stub_get_fired_event_count(TariWallet *wallet);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HOST_WALLET_STUB_H
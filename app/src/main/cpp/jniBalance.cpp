@@ -39,6 +39,7 @@
 #include <android/log.h>
 #include <random>
 #include "jniCommon.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT jbyteArray JNICALL
@@ -46,6 +47,7 @@ Java_com_tari_android_wallet_ffi_FFIBalance_jniGetAvailable(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pBalance = GetPointerField<TariBalance *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, balance_get_available(pBalance, errorPointer));
@@ -58,6 +60,7 @@ Java_com_tari_android_wallet_ffi_FFIBalance_jniGetIncoming(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pBalance = GetPointerField<TariBalance *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, balance_get_pending_incoming(pBalance, errorPointer));
@@ -70,6 +73,7 @@ Java_com_tari_android_wallet_ffi_FFIBalance_jniGetOutgoing(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pBalance = GetPointerField<TariBalance *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, balance_get_pending_outgoing(pBalance, errorPointer));
@@ -82,6 +86,7 @@ Java_com_tari_android_wallet_ffi_FFIBalance_jniGetTimeLocked(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pBalance = GetPointerField<TariBalance *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, balance_get_time_locked(pBalance, errorPointer));
@@ -91,6 +96,6 @@ Java_com_tari_android_wallet_ffi_FFIBalance_jniGetTimeLocked(
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIBalance_jniDestroy(JNIEnv *jEnv, jobject jThis) {
-    balance_destroy(GetPointerField<TariBalance *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_BALANCE);
 }
@@ -35,9 +35,12 @@
 #include <android/log.h>
 #include <wallet.h>
 #include <string>
+#include <vector>
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "hexCodec.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT void JNICALL
@@ -46,6 +49,7 @@ Java_com_tari_android_wallet_ffi_FFIByteVector_jniCreate(
         jobject jThis,
         jbyteArray array,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         auto *buffer = reinterpret_cast<unsigned char *>(jEnv->GetByteArrayElements(array, JNI_FALSE));
         jsize size = jEnv->GetArrayLength(array);
@@ -54,7 +58,7 @@ Java_com_tari_android_wallet_ffi_FFIByteVector_jniCreate(
         }
         ByteVector *pByteVector = byte_vector_create(buffer, static_cast<unsigned int>(size), errorPointer);
         jEnv->ReleaseByteArrayElements(array, reinterpret_cast<jbyte *>(buffer), JNI_ABORT);
-        SetNullPointerField(jEnv, jThis, pByteVector);
+        SetPointerField(jEnv, jThis, NewHandle(HANDLE_TYPE_BYTE_VECTOR, pByteVector));
     });
 }
 
@@ -64,6 +68,7 @@ Java_com_tari_android_wallet_ffi_FFIByteVector_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pByteVector = GetPointerField<ByteVector *>(jEnv, jThis);
         return byte_vector_get_length(pByteVector, errorPointer);
@@ -77,17 +82,57 @@ Java_com_tari_android_wallet_ffi_FFIByteVector_jniGetAt(
         jobject jThis,
         jint index,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pByteVector = GetPointerField<ByteVector *>(jEnv, jThis);
         return byte_vector_get_at(pByteVector, static_cast<unsigned int>(index), errorPointer);
     });
 }
 
+extern "C"
+JNIEXPORT jbyteArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIByteVector_jniGetBytes(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) -> jbyteArray {
+        auto pByteVector = GetPointerField<ByteVector *>(jEnv, jThis);
+        std::vector<uint8_t> bytes = GetByteVectorBytes(pByteVector, errorPointer);
+        if (*errorPointer != 0) {
+            return nullptr;
+        }
+        auto size = static_cast<jsize>(bytes.size());
+        jbyteArray result = jEnv->NewByteArray(size);
+        jEnv->SetByteArrayRegion(result, 0, size, reinterpret_cast<const jbyte *>(bytes.data()));
+        return result;
+    });
+}
+
+extern "C"
+JNIEXPORT jstring JNICALL
+Java_com_tari_android_wallet_ffi_FFIByteVector_jniGetHex(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) -> jstring {
+        auto pByteVector = GetPointerField<ByteVector *>(jEnv, jThis);
+        std::vector<uint8_t> bytes = GetByteVectorBytes(pByteVector, errorPointer);
+        if (*errorPointer != 0) {
+            return nullptr;
+        }
+        std::string hex(2 * bytes.size(), '\0');
+        HexEncode(bytes.data(), bytes.size(), &hex[0], false);
+        return jEnv->NewStringUTF(hex.c_str());
+    });
+}
+
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIByteVector_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    byte_vector_destroy(GetPointerField<ByteVector *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_BYTE_VECTOR);
 }
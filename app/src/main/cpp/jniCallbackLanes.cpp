@@ -0,0 +1,95 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jni.h>
+#include <android/log.h>
+#include <wallet.h>
+#include <vector>
+#include "jniCommon.cpp"
+#include "callbackDispatcher.cpp"
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_tari_android_wallet_ffi_FFICallbackLanes_jniSetLane(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jint callbackType,
+        jint lane) {
+    JNI_ENTRY_POINT();
+    return SetCallbackLane(callbackType, lane) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Delivery latency of every lane, in lane order.
+ */
+extern "C"
+JNIEXPORT jlongArray JNICALL
+Java_com_tari_android_wallet_ffi_FFICallbackLanes_jniGetLaneStatsValues(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    std::vector<CallStats *> stats;
+    for (auto &laneStats : g_callbackLaneStats) {
+        stats.push_back(&laneStats);
+    }
+    return NewCallStatsValues(jEnv, stats);
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_tari_android_wallet_ffi_FFICallbackLanes_jniResetLaneStats(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    for (auto &laneStats : g_callbackLaneStats) {
+        laneStats.reset();
+    }
+}
+
+/**
+ * Callback thread attaches and dropped deliveries, see g_callbackAttachCount.
+ */
+extern "C"
+JNIEXPORT jlongArray JNICALL
+Java_com_tari_android_wallet_ffi_FFICallbackLanes_jniGetDeliveryCounters(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    jlong counters[] = {
+            static_cast<jlong>(g_callbackAttachCount.load(std::memory_order_relaxed)),
+            static_cast<jlong>(g_callbackDroppedCount.load(std::memory_order_relaxed)),
+    };
+    jlongArray result = jEnv->NewLongArray(2);
+    jEnv->SetLongArrayRegion(result, 0, 2, counters);
+    return result;
+}
@@ -0,0 +1,69 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jni.h>
+#include <android/log.h>
+#include <wallet.h>
+#include <vector>
+#include "jniCommon.cpp"
+#include "callbackSubscriptions.cpp"
+
+/**
+ * Replaces the subscription with one call. Tx ids are the u64 bits, null leaves the tx id set empty.
+ */
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_tari_android_wallet_ffi_FFICallbackSubscriptions_jniSubscribe(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jint typeMask,
+        jlongArray jTxIds,
+        jint txIdTypeMask) {
+    JNI_ENTRY_POINT();
+    std::vector<uint64_t> txIds;
+    if (jTxIds != nullptr) {
+        jsize length = jEnv->GetArrayLength(jTxIds);
+        txIds.resize(static_cast<size_t>(length));
+        jEnv->GetLongArrayRegion(jTxIds, 0, length, reinterpret_cast<jlong *>(txIds.data()));
+    }
+    GetCallbackSubscriptions().update(static_cast<uint32_t>(typeMask), std::move(txIds), static_cast<uint32_t>(txIdTypeMask));
+}
+
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFICallbackSubscriptions_jniGetFilteredCount(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    return static_cast<jlong>(GetCallbackSubscriptions().filteredCount());
+}
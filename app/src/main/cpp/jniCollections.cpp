@@ -38,6 +38,7 @@
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT jint JNICALL
@@ -45,6 +46,7 @@ Java_com_tari_android_wallet_ffi_FFIContacts_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pContacts = GetPointerField<TariContacts *>(jEnv, jThis);
         return contacts_get_length(pContacts, errorPointer);
@@ -58,7 +60,8 @@ Java_com_tari_android_wallet_ffi_FFIContacts_jniGetAt(
         jobject jThis,
         jint index,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariContact *>(jEnv, error, [&](int *errorPointer) -> TariContact * {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariContact *>(jEnv, error, HANDLE_TYPE_CONTACT, [&](int *errorPointer) -> TariContact * {
         auto pContacts = GetPointerField<TariContacts *>(jEnv, jThis);
         return contacts_get_at(pContacts, static_cast<unsigned int>(index), errorPointer);
     });
@@ -69,8 +72,8 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIContacts_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    contacts_destroy(GetPointerField<TariContacts *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_CONTACTS);
 }
 
 extern "C"
@@ -79,6 +82,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTxs_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pCompletedTransactions = GetPointerField<TariCompletedTransactions *>(jEnv, jThis);
         return completed_transactions_get_length(pCompletedTransactions, errorPointer);
@@ -92,7 +96,8 @@ Java_com_tari_android_wallet_ffi_FFICompletedTxs_jniGetAt(
         jobject jThis,
         jint index,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariCompletedTransaction *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariCompletedTransaction *>(jEnv, error, HANDLE_TYPE_COMPLETED_TX, [&](int *errorPointer) {
         auto pCompletedTransactions = GetPointerField<TariCompletedTransactions *>(jEnv, jThis);
         return completed_transactions_get_at(pCompletedTransactions, static_cast<unsigned int>(index), errorPointer);
     });
@@ -103,8 +108,8 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTxs_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    completed_transactions_destroy(GetPointerField<TariCompletedTransactions *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_COMPLETED_TXS);
 }
 
 extern "C"
@@ -113,6 +118,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTxs_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pInboundTxs = GetPointerField<TariPendingInboundTransactions *>(jEnv, jThis);
         return pending_inbound_transactions_get_length(pInboundTxs, errorPointer);
@@ -126,7 +132,8 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTxs_jniGetAt(
         jobject jThis,
         jint index,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariPendingInboundTransaction *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariPendingInboundTransaction *>(jEnv, error, HANDLE_TYPE_PENDING_INBOUND_TX, [&](int *errorPointer) {
         auto pInboundTxs = GetPointerField<TariPendingInboundTransactions *>(jEnv, jThis);
         return pending_inbound_transactions_get_at(pInboundTxs, static_cast<unsigned int>(index), errorPointer);
     });
@@ -137,8 +144,8 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingInboundTxs_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    pending_inbound_transactions_destroy(GetPointerField<TariPendingInboundTransactions *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_PENDING_INBOUND_TXS);
 }
 
 
@@ -148,6 +155,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTxs_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pOutboundTxs = GetPointerField<TariPendingOutboundTransactions *>(jEnv, jThis);
         return pending_outbound_transactions_get_length(pOutboundTxs, errorPointer);
@@ -161,7 +169,8 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTxs_jniGetAt(
         jobject jThis,
         jint index,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariPendingOutboundTransaction *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariPendingOutboundTransaction *>(jEnv, error, HANDLE_TYPE_PENDING_OUTBOUND_TX, [&](int *errorPointer) {
         auto pOutboundTxs = GetPointerField<TariPendingOutboundTransactions *>(jEnv, jThis);
         return pending_outbound_transactions_get_at(pOutboundTxs, static_cast<unsigned int>(index), errorPointer);
     });
@@ -172,8 +181,8 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingOutboundTxs_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    pending_outbound_transactions_destroy(GetPointerField<TariPendingOutboundTransactions *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_PENDING_OUTBOUND_TXS);
 }
 
 extern "C"
@@ -182,6 +191,7 @@ Java_com_tari_android_wallet_ffi_FFITariUnblindedOutputs_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pOutboundTxs = GetPointerField<TariUnblindedOutputs *>(jEnv, jThis);
         return unblinded_outputs_get_length(pOutboundTxs, errorPointer);
@@ -195,7 +205,8 @@ Java_com_tari_android_wallet_ffi_FFITariUnblindedOutputs_jniGetAt(
         jobject jThis,
         jint index,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariUnblindedOutput *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariUnblindedOutput *>(jEnv, error, HANDLE_TYPE_UNBLINDED_OUTPUT, [&](int *errorPointer) {
         auto pOutboundTxs = GetPointerField<TariUnblindedOutputs *>(jEnv, jThis);
         return unblinded_outputs_get_at(pOutboundTxs, static_cast<unsigned int>(index), errorPointer);
     });
@@ -206,8 +217,8 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariUnblindedOutputs_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    unblinded_outputs_destroy(GetPointerField<TariUnblindedOutputs *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_UNBLINDED_OUTPUTS);
 }
 
 extern "C"
@@ -216,6 +227,7 @@ Java_com_tari_android_wallet_ffi_FFITariPaymentRecords_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pPaymentRecords = GetPointerField<TariPaymentRecords *>(jEnv, jThis);
         return payment_records_get_length(pPaymentRecords, errorPointer);
@@ -229,6 +241,7 @@ Java_com_tari_android_wallet_ffi_FFITariPaymentRecords_jniGetAt(
         jobject jThis,
         jint index,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithErrorAndCast<TariPaymentRecord *>(jEnv, error, [&](int *errorPointer) {
         auto pPaymentRecords = GetPointerField<TariPaymentRecords *>(jEnv, jThis);
         return payment_records_get_at(pPaymentRecords, static_cast<unsigned int>(index), errorPointer);
@@ -240,6 +253,6 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariPaymentRecords_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    payment_records_destroy(GetPointerField<TariPaymentRecords *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_PAYMENT_RECORDS);
 }
\ No newline at end of file
@@ -30,12 +30,18 @@
  * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
+#ifndef JNI_COMMON_CPP
+#define JNI_COMMON_CPP
+
 #include <jni.h>
 #include <android/log.h>
 #include <string>
+#include <vector>
 #include <cmath>
-#include <functional>
+#include <utility>
 #include <android/log.h>
+#include "traceRecorder.cpp"
+#include "callStats.cpp"
 
 #define LOG_TAG "Tari Wallet"
 
@@ -52,6 +58,13 @@
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO,     LOG_TAG, __VA_ARGS__)
 #define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG,    LOG_TAG, __VA_ARGS__)
 
+/**
+ * Put at the top of every JNI entry point: records a trace span and the latency stats of the call.
+ */
+#define JNI_ENTRY_POINT() \
+    TRACE_JNI_ENTRY(); \
+    CALL_STATS_ENTRY()
+
 inline jlong GetPointerField(JNIEnv *jEnv, jobject jThis) {
     jclass cls = jEnv->GetObjectClass(jThis);
     jfieldID fid = jEnv->GetFieldID(cls, "pointer", "J");
@@ -97,33 +110,112 @@ inline jbyteArray getBytesFromUnsignedLongLong(JNIEnv *jEnv, unsigned long long
     return result;
 }
 
+inline jobjectArray NewStringArray(JNIEnv *jEnv, const std::vector<std::string> &strings) {
+    jclass stringClass = jEnv->FindClass("java/lang/String");
+    jobjectArray result = jEnv->NewObjectArray(static_cast<jsize>(strings.size()), stringClass, nullptr);
+    for (size_t i = 0; i < strings.size(); i++) {
+        jstring jString = jEnv->NewStringUTF(strings[i].c_str());
+        jEnv->SetObjectArrayElement(result, static_cast<jsize>(i), jString);
+        jEnv->DeleteLocalRef(jString);
+    }
+    jEnv->DeleteLocalRef(stringClass);
+    return result;
+}
+
+inline std::string GetStdString(JNIEnv *jEnv, jstring jString) {
+    const char *pChars = jEnv->GetStringUTFChars(jString, JNI_FALSE);
+    std::string result(pChars);
+    jEnv->ReleaseStringUTFChars(jString, pChars);
+    return result;
+}
+
+/**
+ * Count, total, max and the p50, p90, p99 and p99.9 of every stats entry, read by FFICallStats.fromValues.
+ */
+inline jlongArray NewCallStatsValues(JNIEnv *jEnv, const std::vector<CallStats *> &stats) {
+    const int CALL_STATS_FIELDS = 7;
+    std::vector<jlong> values;
+    values.reserve(stats.size() * CALL_STATS_FIELDS);
+    for (CallStats *pStats : stats) {
+        std::vector<uint64_t> percentiles = pStats->getPercentileNanos({50.0, 90.0, 99.0, 99.9});
+        values.push_back(static_cast<jlong>(pStats->getCount()));
+        values.push_back(static_cast<jlong>(pStats->getTotalNanos()));
+        values.push_back(static_cast<jlong>(pStats->getMaxNanos()));
+        for (uint64_t percentile : percentiles) {
+            values.push_back(static_cast<jlong>(percentile));
+        }
+    }
+    auto length = static_cast<jsize>(values.size());
+    jlongArray result = jEnv->NewLongArray(length);
+    jEnv->SetLongArrayRegion(result, 0, length, values.data());
+    return result;
+}
+
+/**
+ * Error codes of the failures the bindings detect themselves, mirrored by FFIError.kt. libwallet's codes are positive
+ * and -1 is the unknown error of the Kotlin side, these count down from -1000 so they can't be taken for either.
+ */
+// jniCreate while another wallet owns the callbacks
+constexpr int NATIVE_ERROR_WALLET_ALREADY_RUNNING = -1000;
+// the creation thread couldn't attach to the VM
+constexpr int NATIVE_ERROR_THREAD_NOT_ATTACHED = -1001;
+// a check the bindings make themselves failed, an argument they validate or a libwallet result missing without an error
+constexpr int NATIVE_ERROR_CHECK_FAILED = -1002;
+
+/**
+ * Error code of the last ExecuteWithError call on the current thread.
+ */
+inline thread_local int g_lastErrorCode = 0;
+
+inline int GetLastErrorCode() {
+    return g_lastErrorCode;
+}
+
 inline jboolean setErrorCode(JNIEnv *jEnv, jobject error, jint value) {
-    jclass errorClass = jEnv->GetObjectClass(error);
-    if (errorClass == nullptr)
-        return static_cast<jboolean>(false);
-    jfieldID errorField = jEnv->GetFieldID(errorClass, "code", "I");
+    // field ids stay valid as long as the class is loaded, FFIError is never unloaded
+    static const jfieldID errorField = [jEnv, error]() -> jfieldID {
+        jclass errorClass = jEnv->GetObjectClass(error);
+        if (errorClass == nullptr)
+            return nullptr;
+        jfieldID field = jEnv->GetFieldID(errorClass, "code", "I");
+        jEnv->DeleteLocalRef(errorClass);
+        return field;
+    }();
     if (errorField == nullptr)
         return static_cast<jboolean>(false);
     jEnv->SetIntField(error, errorField, value);
     return static_cast<jboolean>(true);
 }
 
-template <typename G>
-inline G ExecuteWithError(JNIEnv *jEnv, jobject error, std::function<G(int*)> fun) {
+/**
+ * The error object is reset to NoError by runWithError on the Kotlin side, so it's only written when the call fails.
+ */
+inline void PropagateErrorCode(JNIEnv *jEnv, jobject error, int errorCode) {
+    g_lastErrorCode = errorCode;
+    if (errorCode != 0) {
+        setErrorCode(jEnv, error, errorCode);
+    }
+}
+
+template <typename G, typename F>
+inline G ExecuteWithError(JNIEnv *jEnv, jobject error, F &&fun) {
     int errorCode = 0;
     G result = fun(&errorCode);
-    setErrorCode(jEnv, error, errorCode);
+    PropagateErrorCode(jEnv, error, errorCode);
     return result;
 }
 
-inline void ExecuteWithError(JNIEnv *jEnv, jobject error, std::function<void(int*)> fun) {
+template <typename F>
+inline void ExecuteWithError(JNIEnv *jEnv, jobject error, F &&fun) {
     int errorCode = 0;
     fun(&errorCode);
-    setErrorCode(jEnv, error, errorCode);
+    PropagateErrorCode(jEnv, error, errorCode);
 }
 
-template <typename G>
-inline jlong ExecuteWithErrorAndCast(JNIEnv *jEnv, jobject error, std::function<G(int*)> fun) {
-    G result = ExecuteWithError(jEnv, error, fun);
+template <typename G, typename F>
+inline jlong ExecuteWithErrorAndCast(JNIEnv *jEnv, jobject error, F &&fun) {
+    G result = ExecuteWithError<G>(jEnv, error, std::forward<F>(fun));
     return reinterpret_cast<jlong>(result);
-}
\ No newline at end of file
+}
+
+#endif // JNI_COMMON_CPP
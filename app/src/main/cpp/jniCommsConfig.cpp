@@ -34,6 +34,7 @@
 #include <jni.h>
 #include <wallet.h>
 #include "jniCommon.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT void JNICALL
@@ -43,6 +44,7 @@ Java_com_tari_android_wallet_ffi_FFICommsConfig_jniCreate(
         jstring jDatabaseName,
         jstring jDatastorePath,
         jobject error) {
+    JNI_ENTRY_POINT();
     const char *pDatabaseName = jEnv->GetStringUTFChars(jDatabaseName, JNI_FALSE);
     const char *pDatastorePath = jEnv->GetStringUTFChars(jDatastorePath, JNI_FALSE);
 
@@ -54,7 +56,7 @@ Java_com_tari_android_wallet_ffi_FFICommsConfig_jniCreate(
         );
         jEnv->ReleaseStringUTFChars(jDatabaseName, pDatabaseName);
         jEnv->ReleaseStringUTFChars(jDatastorePath, pDatastorePath);
-        SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pCommsConfig));
+        SetPointerField(jEnv, jThis, NewHandle(HANDLE_TYPE_COMMS_CONFIG, pCommsConfig));
     });
 }
 
@@ -64,6 +66,7 @@ Java_com_tari_android_wallet_ffi_FFICommsConfig_jniGetLastVersion(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariCommsConfig *>(jEnv, jThis);
         char *pSignature = wallet_get_last_version(pWallet, errorPointer);
@@ -80,6 +83,6 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFICommsConfig_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    comms_config_destroy(GetPointerField<TariCommsConfig *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_COMMS_CONFIG);
 }
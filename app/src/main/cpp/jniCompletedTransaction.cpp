@@ -38,6 +38,8 @@
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniTariWalletAddressPool.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT jbyteArray JNICALL
@@ -45,6 +47,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetId(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, completed_transaction_get_transaction_id(pCompletedTx, errorPointer));
@@ -57,9 +60,10 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetDestinationPublicKey(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariWalletAddress *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariWalletAddress *>(jEnv, error, HANDLE_TYPE_WALLET_ADDRESS, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
-        return completed_transaction_get_destination_tari_address(pCompletedTx, errorPointer);
+        return InternTariWalletAddress(completed_transaction_get_destination_tari_address(pCompletedTx, errorPointer), errorPointer);
     });
 }
 
@@ -69,9 +73,10 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetSourcePublicKey(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariWalletAddress *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariWalletAddress *>(jEnv, error, HANDLE_TYPE_WALLET_ADDRESS, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
-        return completed_transaction_get_source_tari_address(pCompletedTx, errorPointer);
+        return InternTariWalletAddress(completed_transaction_get_source_tari_address(pCompletedTx, errorPointer), errorPointer);
     });
 }
 
@@ -81,7 +86,8 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetTransactionKernel(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariTransactionKernel *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariTransactionKernel *>(jEnv, error, HANDLE_TYPE_COMPLETED_TX_KERNEL, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         return completed_transaction_get_transaction_kernel(pCompletedTx, errorPointer);
     });
@@ -93,6 +99,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetAmount(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, completed_transaction_get_amount(pCompletedTx, errorPointer));
@@ -105,6 +112,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetFee(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, completed_transaction_get_fee(pCompletedTx, errorPointer));
@@ -117,6 +125,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetTimestamp(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, completed_transaction_get_timestamp(pCompletedTx, errorPointer));
@@ -129,6 +138,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetMinedTimestamp(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, completed_transaction_get_mined_timestamp(pCompletedTx, errorPointer));
@@ -142,6 +152,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetMinedHeight(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, completed_transaction_get_mined_height(pCompletedTx, errorPointer));
@@ -154,6 +165,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetPaymentId(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         const char *pPaymentId = completed_transaction_get_user_payment_id(pCompletedTx, errorPointer);
@@ -169,7 +181,8 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetPaymentIdBytes(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<ByteVector *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<ByteVector *>(jEnv, error, HANDLE_TYPE_BYTE_VECTOR, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         return completed_transaction_get_payment_id_as_bytes(pCompletedTx, errorPointer);
     });
@@ -181,7 +194,8 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetPaymentIdUserBytes(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<ByteVector *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<ByteVector *>(jEnv, error, HANDLE_TYPE_BYTE_VECTOR, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         return completed_transaction_get_user_payment_id_as_bytes(pCompletedTx, errorPointer);
     });
@@ -193,6 +207,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetStatus(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         return reinterpret_cast<jint>(completed_transaction_get_status(pCompletedTx, errorPointer));
@@ -205,6 +220,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniIsOutbound(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         return static_cast<jboolean>(completed_transaction_is_outbound(pCompletedTx, errorPointer) != 0);
@@ -216,8 +232,8 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTx_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    completed_transaction_destroy(GetPointerField<TariCompletedTransaction *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_COMPLETED_TX);
 }
 
 extern "C"
@@ -226,6 +242,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTx_jniGetCancellationReason(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pCompletedTx = GetPointerField<TariCompletedTransaction *>(jEnv, jThis);
         return reinterpret_cast<jint>(completed_transaction_get_cancellation_reason(pCompletedTx, errorPointer));
@@ -38,6 +38,7 @@
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT jstring JNICALL
@@ -45,6 +46,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTxKernel_jniGetExcess(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pKernel = GetPointerField<TariTransactionKernel *>(jEnv, jThis);
         const char *pStr = transaction_kernel_get_excess_hex(pKernel, errorPointer);
@@ -60,6 +62,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTxKernel_jniGetExcessPublicNonce(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pKernel = GetPointerField<TariTransactionKernel *>(jEnv, jThis);
         const char *pStr = transaction_kernel_get_excess_public_nonce_hex(pKernel, errorPointer);
@@ -75,6 +78,7 @@ Java_com_tari_android_wallet_ffi_FFICompletedTxKernel_jniGetExcessSignature(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pKernel = GetPointerField<TariTransactionKernel *>(jEnv, jThis);
         const char *pStr = transaction_kernel_get_excess_signature_hex(pKernel, errorPointer);
@@ -89,6 +93,6 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFICompletedTxKernel_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    transaction_kernel_destroy(GetPointerField<TariTransactionKernel *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_COMPLETED_TX_KERNEL);
 }
\ No newline at end of file
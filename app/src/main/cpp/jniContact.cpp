@@ -38,6 +38,8 @@
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniTariWalletAddressPool.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT void JNICALL
@@ -48,12 +50,13 @@ Java_com_tari_android_wallet_ffi_FFIContact_jniCreate(
         jboolean jIsFavorite,
         jobject jPublicKey,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         const char *pAlias = jEnv->GetStringUTFChars(jAlias, JNI_FALSE);
         auto pTariWalletAddress = GetPointerField<TariWalletAddress *>(jEnv, jPublicKey);
         TariContact *pContact = contact_create(pAlias, pTariWalletAddress, jIsFavorite, errorPointer);
         jEnv->ReleaseStringUTFChars(jAlias, pAlias);
-        SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pContact));
+        SetPointerField(jEnv, jThis, NewHandle(HANDLE_TYPE_CONTACT, pContact));
     });
 }
 
@@ -63,6 +66,7 @@ Java_com_tari_android_wallet_ffi_FFIContact_jniGetAlias(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pContact = GetPointerField<TariContact *>(jEnv, jThis);
         const char *pAlias = contact_get_alias(pContact, errorPointer);
@@ -78,6 +82,7 @@ Java_com_tari_android_wallet_ffi_FFIContact_jniGetIsFavorite(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
         auto pContact = GetPointerField<TariContact *>(jEnv, jThis);
         bool isFavorite = contact_get_favourite(pContact, errorPointer);
@@ -91,9 +96,10 @@ Java_com_tari_android_wallet_ffi_FFIContact_jniGetTariWalletAddress(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariWalletAddress *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariWalletAddress *>(jEnv, error, HANDLE_TYPE_WALLET_ADDRESS, [&](int *errorPointer) {
         auto pContact = GetPointerField<TariContact *>(jEnv, jThis);
-        return contact_get_tari_address(pContact, errorPointer);
+        return InternTariWalletAddress(contact_get_tari_address(pContact, errorPointer), errorPointer);
     });
 }
 
@@ -102,6 +108,6 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIContact_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    contact_destroy(GetPointerField<TariContact *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_CONTACT);
 }
@@ -0,0 +1,239 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jni.h>
+#include <android/log.h>
+#include <wallet.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "jniCommon.cpp"
+#include "tariAddressCodec.cpp"
+
+/**
+ * Emoji id parsing without libwallet. Lookups go through a perfect hash table over the emoji set that is built and
+ * verified at compile time.
+ */
+
+// hash-and-displace: keys are spread over buckets, each bucket gets a displacement that places all of its keys in free slots
+constexpr int EMOJI_HASH_BUCKET_BITS = 6;
+constexpr int EMOJI_HASH_SLOT_BITS = 9;
+constexpr int EMOJI_HASH_BUCKETS = 1 << EMOJI_HASH_BUCKET_BITS;
+constexpr int EMOJI_HASH_SLOTS = 1 << EMOJI_HASH_SLOT_BITS;
+constexpr uint32_t EMOJI_HASH_MAX_DISPLACEMENT = 4096;
+
+constexpr uint32_t EmojiHashBucket(uint32_t codepoint) {
+    return (codepoint * 0x9E3779B1u) >> (32 - EMOJI_HASH_BUCKET_BITS);
+}
+
+constexpr uint32_t EmojiHashSlot(uint32_t codepoint, uint32_t displacement) {
+    return ((codepoint ^ (displacement * 0x27D4EB2Fu)) * 0x85EBCA6Bu) >> (32 - EMOJI_HASH_SLOT_BITS);
+}
+
+struct EmojiHashTable {
+    uint32_t keys[EMOJI_HASH_SLOTS] = {};
+    uint8_t values[EMOJI_HASH_SLOTS] = {};
+    uint16_t displacements[EMOJI_HASH_BUCKETS] = {};
+    bool complete = false;
+};
+
+constexpr EmojiHashTable BuildEmojiHashTable() {
+    EmojiHashTable table{};
+
+    // group emoji indices by bucket
+    int bucketSizes[EMOJI_HASH_BUCKETS] = {};
+    for (int i = 0; i < EMOJI_SET_SIZE; i++) {
+        bucketSizes[EmojiHashBucket(EMOJI_CODEPOINTS[i])]++;
+    }
+    int bucketStarts[EMOJI_HASH_BUCKETS + 1] = {};
+    for (int b = 0; b < EMOJI_HASH_BUCKETS; b++) {
+        bucketStarts[b + 1] = bucketStarts[b] + bucketSizes[b];
+    }
+    int members[EMOJI_SET_SIZE] = {};
+    int filled[EMOJI_HASH_BUCKETS] = {};
+    for (int i = 0; i < EMOJI_SET_SIZE; i++) {
+        uint32_t bucket = EmojiHashBucket(EMOJI_CODEPOINTS[i]);
+        members[bucketStarts[bucket] + filled[bucket]++] = i;
+    }
+
+    // place the largest buckets first while the table is still sparse
+    bool usedSlots[EMOJI_HASH_SLOTS] = {};
+    bool placedBuckets[EMOJI_HASH_BUCKETS] = {};
+    for (int pass = 0; pass < EMOJI_HASH_BUCKETS; pass++) {
+        int bucket = -1;
+        for (int b = 0; b < EMOJI_HASH_BUCKETS; b++) {
+            if (!placedBuckets[b] && (bucket < 0 || bucketSizes[b] > bucketSizes[bucket])) {
+                bucket = b;
+            }
+        }
+        placedBuckets[bucket] = true;
+        if (bucketSizes[bucket] == 0) {
+            continue;
+        }
+
+        bool placed = false;
+        for (uint32_t displacement = 0; displacement < EMOJI_HASH_MAX_DISPLACEMENT && !placed; displacement++) {
+            uint32_t slots[EMOJI_SET_SIZE] = {};
+            bool fits = true;
+            for (int m = 0; m < bucketSizes[bucket] && fits; m++) {
+                uint32_t slot = EmojiHashSlot(EMOJI_CODEPOINTS[members[bucketStarts[bucket] + m]], displacement);
+                fits = !usedSlots[slot];
+                for (int other = 0; other < m && fits; other++) {
+                    fits = slots[other] != slot;
+                }
+                slots[m] = slot;
+            }
+            if (!fits) {
+                continue;
+            }
+            for (int m = 0; m < bucketSizes[bucket]; m++) {
+                int index = members[bucketStarts[bucket] + m];
+                usedSlots[slots[m]] = true;
+                table.keys[slots[m]] = EMOJI_CODEPOINTS[index];
+                table.values[slots[m]] = static_cast<uint8_t>(index);
+            }
+            table.displacements[bucket] = static_cast<uint16_t>(displacement);
+            placed = true;
+        }
+        if (!placed) {
+            return table;
+        }
+    }
+    table.complete = true;
+    return table;
+}
+
+constexpr EmojiHashTable EMOJI_HASH_TABLE = BuildEmojiHashTable();
+
+static_assert(EMOJI_HASH_TABLE.complete, "Emoji set does not fit the perfect hash table, adjust the hash constants");
+
+constexpr bool VerifyEmojiHashTable() {
+    for (int i = 0; i < EMOJI_SET_SIZE; i++) {
+        uint32_t codepoint = EMOJI_CODEPOINTS[i];
+        uint32_t slot = EmojiHashSlot(codepoint, EMOJI_HASH_TABLE.displacements[EmojiHashBucket(codepoint)]);
+        if (EMOJI_HASH_TABLE.keys[slot] != codepoint || EMOJI_HASH_TABLE.values[slot] != i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(VerifyEmojiHashTable(), "Emoji perfect hash table lookup is inconsistent");
+
+/**
+ * @return the byte encoded by the emoji, or -1 if the code point is not part of the emoji set
+ */
+inline int EmojiToByte(uint32_t codepoint) {
+    uint32_t slot = EmojiHashSlot(codepoint, EMOJI_HASH_TABLE.displacements[EmojiHashBucket(codepoint)]);
+    return EMOJI_HASH_TABLE.keys[slot] == codepoint ? EMOJI_HASH_TABLE.values[slot] : -1;
+}
+
+// same values as FFIEmojiIdParser.Status
+constexpr jint EMOJI_ID_VALID = 0;
+constexpr jint EMOJI_ID_INVALID_EMOJI = 1;
+constexpr jint EMOJI_ID_INVALID_LENGTH = 2;
+constexpr jint EMOJI_ID_INVALID_CHECKSUM = 3;
+
+/**
+ * Decodes an UTF-16 emoji id into address bytes. Variation selectors are ignored since pasted text often carries them.
+ *
+ * @return false if the string contains anything else than emojis from the set
+ */
+inline bool DecodeEmojiId(const jchar *pChars, jsize length, std::vector<uint8_t> &bytes) {
+    bytes.clear();
+    bytes.reserve(static_cast<size_t>(length) / 2);
+    for (jsize i = 0; i < length; i++) {
+        uint32_t codepoint = pChars[i];
+        if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+            if (i + 1 >= length || pChars[i + 1] < 0xDC00 || pChars[i + 1] > 0xDFFF) {
+                return false;
+            }
+            codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (pChars[i + 1] - 0xDC00);
+            i++;
+        }
+        if (codepoint == 0xFE0F) {
+            continue;
+        }
+        int value = EmojiToByte(codepoint);
+        if (value < 0) {
+            return false;
+        }
+        bytes.push_back(static_cast<uint8_t>(value));
+    }
+    return true;
+}
+
+inline jint ValidateEmojiIdBytes(const std::vector<uint8_t> &bytes) {
+    if (bytes.size() != SINGLE_ADDRESS_SIZE && bytes.size() < DUAL_ADDRESS_SIZE) {
+        return EMOJI_ID_INVALID_LENGTH;
+    }
+    return ComputeDammSum(bytes) == 0 ? EMOJI_ID_VALID : EMOJI_ID_INVALID_CHECKSUM;
+}
+
+inline bool DecodeEmojiId(JNIEnv *jEnv, jstring jEmojiId, std::vector<uint8_t> &bytes) {
+    jsize length = jEnv->GetStringLength(jEmojiId);
+    std::vector<jchar> chars(static_cast<size_t>(length));
+    jEnv->GetStringRegion(jEmojiId, 0, length, chars.data());
+    return DecodeEmojiId(chars.data(), length, bytes);
+}
+
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_tari_android_wallet_ffi_FFIEmojiIdParser_jniValidate(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jEmojiId) {
+    JNI_ENTRY_POINT();
+    std::vector<uint8_t> bytes;
+    if (!DecodeEmojiId(jEnv, jEmojiId, bytes)) {
+        return EMOJI_ID_INVALID_EMOJI;
+    }
+    return ValidateEmojiIdBytes(bytes);
+}
+
+extern "C"
+JNIEXPORT jbyteArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIEmojiIdParser_jniDecode(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jEmojiId) {
+    JNI_ENTRY_POINT();
+    std::vector<uint8_t> bytes;
+    if (!DecodeEmojiId(jEnv, jEmojiId, bytes)) {
+        return nullptr;
+    }
+    auto size = static_cast<jsize>(bytes.size());
+    jbyteArray result = jEnv->NewByteArray(size);
+    jEnv->SetByteArrayRegion(result, 0, size, reinterpret_cast<const jbyte *>(bytes.data()));
+    return result;
+}
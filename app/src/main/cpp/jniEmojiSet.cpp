@@ -35,17 +35,20 @@
 #include <android/log.h>
 #include <wallet.h>
 #include <string>
+#include <vector>
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIEmojiSet_jniCreate(
         JNIEnv *jEnv,
         jobject jThis) {
+    JNI_ENTRY_POINT();
     EmojiSet *pEmojiSet = get_emoji_set();
-    SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pEmojiSet));
+    SetPointerField(jEnv, jThis, NewHandle(HANDLE_TYPE_EMOJI_SET, pEmojiSet));
 }
 
 extern "C"
@@ -54,6 +57,7 @@ Java_com_tari_android_wallet_ffi_FFIEmojiSet_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pEmojiSet = GetPointerField<EmojiSet *>(jEnv, jThis);
         return emoji_set_get_length(pEmojiSet, errorPointer);
@@ -67,17 +71,66 @@ Java_com_tari_android_wallet_ffi_FFIEmojiSet_jniGetAt(
         jobject jThis,
         jint index,
         jobject error) {
-    return ExecuteWithErrorAndCast<ByteVector *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<ByteVector *>(jEnv, error, HANDLE_TYPE_BYTE_VECTOR, [&](int *errorPointer) {
         auto pEmojiSet = GetPointerField<EmojiSet *>(jEnv, jThis);
         return emoji_set_get_at(pEmojiSet, static_cast<unsigned int>(index), errorPointer);
     });
 }
 
+/**
+ * Copies the whole emoji set in one call: the UTF-8 bytes of all emojis are concatenated into the returned array
+ * and emoji i occupies [offsets[i], offsets[i + 1]). The offsets array has to hold length + 1 elements.
+ */
+extern "C"
+JNIEXPORT jbyteArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIEmojiSet_jniGetAllBytes(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jintArray jOffsets,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) -> jbyteArray {
+        auto pEmojiSet = GetPointerField<EmojiSet *>(jEnv, jThis);
+        unsigned int length = emoji_set_get_length(pEmojiSet, errorPointer);
+        if (*errorPointer != 0) {
+            return nullptr;
+        }
+        if (static_cast<unsigned int>(jEnv->GetArrayLength(jOffsets)) < length + 1) {
+            *errorPointer = 1;
+            return nullptr;
+        }
+        std::vector<jbyte> bytes;
+        bytes.reserve(length * 4);
+        std::vector<jint> offsets(length + 1, 0);
+        for (unsigned int i = 0; i < length; i++) {
+            ByteVector *pEmoji = emoji_set_get_at(pEmojiSet, i, errorPointer);
+            if (*errorPointer != 0) {
+                return nullptr;
+            }
+            unsigned int emojiLength = byte_vector_get_length(pEmoji, errorPointer);
+            for (unsigned int j = 0; j < emojiLength && *errorPointer == 0; j++) {
+                bytes.push_back(static_cast<jbyte>(byte_vector_get_at(pEmoji, j, errorPointer)));
+            }
+            byte_vector_destroy(pEmoji);
+            if (*errorPointer != 0) {
+                return nullptr;
+            }
+            offsets[i + 1] = static_cast<jint>(bytes.size());
+        }
+        jEnv->SetIntArrayRegion(jOffsets, 0, static_cast<jsize>(offsets.size()), offsets.data());
+        auto size = static_cast<jsize>(bytes.size());
+        jbyteArray result = jEnv->NewByteArray(size);
+        jEnv->SetByteArrayRegion(result, 0, size, bytes.data());
+        return result;
+    });
+}
+
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIEmojiSet_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    emoji_set_destroy(GetPointerField<EmojiSet *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_EMOJI_SET);
 }
\ No newline at end of file
@@ -0,0 +1,120 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <jni.h>
+#include <wallet.h>
+#include "jniCommon.cpp"
+#include "jniHandleTypes.cpp"
+
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIHandleScope_jniOpen(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    return static_cast<jlong>(GetHandleScopes().open());
+}
+
+/**
+ * Pointers of the objects the scope destroyed, or null if it isn't the innermost open scope of the thread.
+ */
+extern "C"
+JNIEXPORT jlongArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIHandleScope_jniClose(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong scope) {
+    JNI_ENTRY_POINT();
+    std::vector<void *> released;
+    if (!GetHandleScopes().close(static_cast<uint64_t>(scope), released)) {
+        return nullptr;
+    }
+    std::vector<jlong> pointers;
+    pointers.reserve(released.size());
+    for (void *pointer : released) {
+        pointers.push_back(reinterpret_cast<jlong>(pointer));
+    }
+    auto length = static_cast<jsize>(pointers.size());
+    jlongArray result = jEnv->NewLongArray(length);
+    jEnv->SetLongArrayRegion(result, 0, length, pointers.data());
+    return result;
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_tari_android_wallet_ffi_FFIHandleScope_jniKeep(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong pointer) {
+    JNI_ENTRY_POINT();
+    return GetHandleScopes().keep(reinterpret_cast<void *>(pointer)) ? JNI_TRUE : JNI_FALSE;
+}
+
+extern "C"
+JNIEXPORT jobjectArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIHandleScope_jniGetTypeNames(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    HandleScopes &scopes = GetHandleScopes();
+    std::vector<std::string> names;
+    for (size_t type = 0; type < scopes.typeCount(); type++) {
+        names.emplace_back(scopes.typeName(type));
+    }
+    return NewStringArray(jEnv, names);
+}
+
+/**
+ * Live count, live bytes and created count of every type in the order of jniGetTypeNames, read by
+ * FFIHandleStats.fromValues.
+ */
+extern "C"
+JNIEXPORT jlongArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIHandleScope_jniGetTypeStatsValues(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    const int HANDLE_STATS_FIELDS = 3;
+    HandleScopes &scopes = GetHandleScopes();
+    std::vector<jlong> values;
+    values.reserve(scopes.typeCount() * HANDLE_STATS_FIELDS);
+    for (size_t type = 0; type < scopes.typeCount(); type++) {
+        HandleTypeStats stats = scopes.stats(type);
+        values.push_back(static_cast<jlong>(stats.liveCount));
+        values.push_back(static_cast<jlong>(stats.liveBytes));
+        values.push_back(static_cast<jlong>(stats.createdCount));
+    }
+    auto length = static_cast<jsize>(values.size());
+    jlongArray result = jEnv->NewLongArray(length);
+    jEnv->SetLongArrayRegion(result, 0, length, values.data());
+    return result;
+}
@@ -0,0 +1,221 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef JNI_HANDLE_TYPES_CPP
+#define JNI_HANDLE_TYPES_CPP
+
+#include <jni.h>
+#include <wallet.h>
+#include <vector>
+#include "jniCommon.cpp"
+#include "jniTariWalletAddressPool.cpp"
+#include "handleScope.cpp"
+#include "txColumnSnapshot.cpp"
+
+/**
+ * The libwallet objects and native snapshots handed to Java that HandleScopes tracks, indexes of HANDLE_TYPES.
+ *
+ * Objects owned by another object (payment records and fee per gram stats of their collections, TariVector items) and
+ * the objects of a single callback (liveness data, base node state) aren't handed out as handles.
+ */
+enum HandleType {
+    HANDLE_TYPE_BALANCE = 0,
+    HANDLE_TYPE_BYTE_VECTOR,
+    HANDLE_TYPE_COMMS_CONFIG,
+    HANDLE_TYPE_COMPLETED_TX,
+    HANDLE_TYPE_COMPLETED_TX_KERNEL,
+    HANDLE_TYPE_COMPLETED_TXS,
+    HANDLE_TYPE_CONTACT,
+    HANDLE_TYPE_CONTACTS,
+    HANDLE_TYPE_EMOJI_SET,
+    HANDLE_TYPE_FEE_PER_GRAM_STATS,
+    HANDLE_TYPE_OUTPUT_FEATURES,
+    HANDLE_TYPE_PAYMENT_RECORDS,
+    HANDLE_TYPE_PENDING_INBOUND_TX,
+    HANDLE_TYPE_PENDING_INBOUND_TXS,
+    HANDLE_TYPE_PENDING_OUTBOUND_TX,
+    HANDLE_TYPE_PENDING_OUTBOUND_TXS,
+    HANDLE_TYPE_PRIVATE_KEY,
+    HANDLE_TYPE_PUBLIC_KEY,
+    HANDLE_TYPE_PUBLIC_KEYS,
+    HANDLE_TYPE_SEED_WORDS,
+    HANDLE_TYPE_TRANSACTION_SEND_STATUS,
+    HANDLE_TYPE_TX_COLUMN_SNAPSHOT,
+    HANDLE_TYPE_UNBLINDED_OUTPUT,
+    HANDLE_TYPE_UNBLINDED_OUTPUTS,
+    HANDLE_TYPE_WALLET_ADDRESS,
+};
+
+/**
+ * Rough native sizes of the objects, libwallet doesn't report them. Collections and byte vectors count their items.
+ */
+constexpr size_t HANDLE_SIZE_SMALL = 64;
+constexpr size_t HANDLE_SIZE_KEY = 32 + HANDLE_SIZE_SMALL;
+constexpr size_t HANDLE_SIZE_TX = 1024;
+constexpr size_t HANDLE_SIZE_KERNEL = 256;
+constexpr size_t HANDLE_SIZE_CONTACT = 160;
+constexpr size_t HANDLE_SIZE_OUTPUT = 512;
+constexpr size_t HANDLE_SIZE_PAYMENT_RECORD = 128;
+constexpr size_t HANDLE_SIZE_SEED_WORDS = 24 * 16;
+constexpr size_t HANDLE_SIZE_EMOJI_SET = 1024 * 8;
+constexpr size_t HANDLE_SIZE_COMMS_CONFIG = 512;
+
+template <typename T, void (*Destroy)(T *)>
+inline void DestroyHandleOf(void *pointer) {
+    Destroy(static_cast<T *>(pointer));
+}
+
+template <size_t Size>
+inline size_t FixedHandleSize(void *) {
+    return Size;
+}
+
+template <typename T, unsigned int (*GetLength)(T *, int *), size_t ItemSize>
+inline size_t CollectionHandleSize(void *pointer) {
+    int error = 0;
+    unsigned int length = GetLength(static_cast<T *>(pointer), &error);
+    return HANDLE_SIZE_SMALL + (error == 0 ? length * ItemSize : 0);
+}
+
+template <typename T, unsigned int (*GetLength)(const T *, int *), size_t ItemSize>
+inline size_t ConstCollectionHandleSize(void *pointer) {
+    int error = 0;
+    unsigned int length = GetLength(static_cast<const T *>(pointer), &error);
+    return HANDLE_SIZE_SMALL + (error == 0 ? length * ItemSize : 0);
+}
+
+inline size_t TxColumnSnapshotHandleSize(void *pointer) {
+    return static_cast<TxColumnSnapshot *>(pointer)->memorySize();
+}
+
+inline void DestroyWalletAddressHandle(void *pointer) {
+    ReleaseTariWalletAddress(static_cast<TariWalletAddress *>(pointer));
+}
+
+// in HandleType order
+inline std::vector<HandleTypeInfo> NewHandleTypes() {
+    return {
+            {"Balance", DestroyHandleOf<TariBalance, balance_destroy>, FixedHandleSize<HANDLE_SIZE_SMALL>},
+            {"ByteVector", DestroyHandleOf<ByteVector, byte_vector_destroy>,
+             ConstCollectionHandleSize<ByteVector, byte_vector_get_length, 1>},
+            {"CommsConfig", DestroyHandleOf<TariCommsConfig, comms_config_destroy>, FixedHandleSize<HANDLE_SIZE_COMMS_CONFIG>},
+            {"CompletedTx", DestroyHandleOf<TariCompletedTransaction, completed_transaction_destroy>,
+             FixedHandleSize<HANDLE_SIZE_TX>},
+            {"CompletedTxKernel", DestroyHandleOf<TariTransactionKernel, transaction_kernel_destroy>,
+             FixedHandleSize<HANDLE_SIZE_KERNEL>},
+            {"CompletedTxs", DestroyHandleOf<TariCompletedTransactions, completed_transactions_destroy>,
+             CollectionHandleSize<TariCompletedTransactions, completed_transactions_get_length, HANDLE_SIZE_TX>},
+            {"Contact", DestroyHandleOf<TariContact, contact_destroy>, FixedHandleSize<HANDLE_SIZE_CONTACT>},
+            {"Contacts", DestroyHandleOf<TariContacts, contacts_destroy>,
+             CollectionHandleSize<TariContacts, contacts_get_length, HANDLE_SIZE_CONTACT>},
+            {"EmojiSet", DestroyHandleOf<EmojiSet, emoji_set_destroy>, FixedHandleSize<HANDLE_SIZE_EMOJI_SET>},
+            {"FeePerGramStats", DestroyHandleOf<TariFeePerGramStats, fee_per_gram_stats_destroy>,
+             CollectionHandleSize<TariFeePerGramStats, fee_per_gram_stats_get_length, HANDLE_SIZE_SMALL>},
+            {"OutputFeatures", DestroyHandleOf<TariOutputFeatures, output_features_destroy>, FixedHandleSize<HANDLE_SIZE_SMALL>},
+            {"PaymentRecords", DestroyHandleOf<TariPaymentRecords, payment_records_destroy>,
+             CollectionHandleSize<TariPaymentRecords, payment_records_get_length, HANDLE_SIZE_PAYMENT_RECORD>},
+            {"PendingInboundTx", DestroyHandleOf<TariPendingInboundTransaction, pending_inbound_transaction_destroy>,
+             FixedHandleSize<HANDLE_SIZE_TX>},
+            {"PendingInboundTxs", DestroyHandleOf<TariPendingInboundTransactions, pending_inbound_transactions_destroy>,
+             CollectionHandleSize<TariPendingInboundTransactions, pending_inbound_transactions_get_length, HANDLE_SIZE_TX>},
+            {"PendingOutboundTx", DestroyHandleOf<TariPendingOutboundTransaction, pending_outbound_transaction_destroy>,
+             FixedHandleSize<HANDLE_SIZE_TX>},
+            {"PendingOutboundTxs", DestroyHandleOf<TariPendingOutboundTransactions, pending_outbound_transactions_destroy>,
+             CollectionHandleSize<TariPendingOutboundTransactions, pending_outbound_transactions_get_length, HANDLE_SIZE_TX>},
+            {"PrivateKey", DestroyHandleOf<TariPrivateKey, private_key_destroy>, FixedHandleSize<HANDLE_SIZE_KEY>},
+            {"PublicKey", DestroyHandleOf<TariPublicKey, public_key_destroy>, FixedHandleSize<HANDLE_SIZE_KEY>},
+            {"PublicKeys", DestroyHandleOf<TariPublicKeys, public_keys_destroy>,
+             ConstCollectionHandleSize<TariPublicKeys, public_keys_get_length, HANDLE_SIZE_KEY>},
+            // words can be pushed after creation, a fixed size keeps the live bytes balanced
+            {"SeedWords", DestroyHandleOf<TariSeedWords, seed_words_destroy>, FixedHandleSize<HANDLE_SIZE_SEED_WORDS>},
+            {"TransactionSendStatus", DestroyHandleOf<TariTransactionSendStatus, transaction_send_status_destroy>,
+             FixedHandleSize<HANDLE_SIZE_SMALL>},
+            {"TxColumnSnapshot", DestroyHandleOf<TxColumnSnapshot, DestroyTxColumnSnapshot>, TxColumnSnapshotHandleSize},
+            {"UnblindedOutput", DestroyHandleOf<TariUnblindedOutput, tari_unblinded_output_destroy>,
+             FixedHandleSize<HANDLE_SIZE_OUTPUT>},
+            {"UnblindedOutputs", DestroyHandleOf<TariUnblindedOutputs, unblinded_outputs_destroy>,
+             CollectionHandleSize<TariUnblindedOutputs, unblinded_outputs_get_length, HANDLE_SIZE_OUTPUT>},
+            // a reference of the pooled address, counted once per reference
+            {"WalletAddress", DestroyWalletAddressHandle, FixedHandleSize<HANDLE_SIZE_KEY>},
+    };
+}
+
+inline HandleScopes &GetHandleScopes() {
+    static HandleScopes scopes(NewHandleTypes());
+    return scopes;
+}
+
+/**
+ * Hands a new libwallet object to Java: counts it and registers it in the open scope of the thread, if any.
+ */
+template <typename T>
+inline jlong NewHandle(HandleType type, T *pointer) {
+    if (pointer != nullptr) {
+        GetHandleScopes().onHandedOut(type, pointer);
+    }
+    return reinterpret_cast<jlong>(pointer);
+}
+
+/**
+ * ExecuteWithErrorAndCast for calls returning a new object of the type.
+ */
+template <typename G, typename F>
+inline jlong ExecuteWithHandle(JNIEnv *jEnv, jobject error, HandleType type, F &&fun) {
+    G result = ExecuteWithError<G>(jEnv, error, std::forward<F>(fun));
+    return NewHandle(type, result);
+}
+
+/**
+ * jniDestroy of the wrappers: destroys the object of the pointer field, if it wasn't released by its scope yet.
+ */
+inline void DestroyHandle(JNIEnv *jEnv, jobject jThis, HandleType type) {
+    void *pointer = GetPointerField<void *>(jEnv, jThis);
+    if (pointer != nullptr) {
+        GetHandleScopes().destroy(type, pointer);
+    }
+    SetNullPointerField(jEnv, jThis);
+}
+
+/**
+ * The bytes of a byte vector in one native call, instead of a JNI call per byte.
+ */
+inline std::vector<uint8_t> GetByteVectorBytes(ByteVector *pByteVector, int *errorPointer) {
+    unsigned int length = byte_vector_get_length(pByteVector, errorPointer);
+    std::vector<uint8_t> bytes;
+    bytes.reserve(length);
+    for (unsigned int i = 0; i < length && *errorPointer == 0; i++) {
+        bytes.push_back(byte_vector_get_at(pByteVector, i, errorPointer));
+    }
+    return bytes;
+}
+
+#endif // JNI_HANDLE_TYPES_CPP
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jni.h>
+#include <android/log.h>
+#include <wallet.h>
+#include <string>
+#include <vector>
+#include "jniCommon.cpp"
+#include "hexCodec.cpp"
+
+extern "C"
+JNIEXPORT jstring JNICALL
+Java_com_tari_android_wallet_ffi_FFIHex_jniEncode(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jbyteArray jBytes,
+        jboolean lowercase) {
+    JNI_ENTRY_POINT();
+    jsize length = jEnv->GetArrayLength(jBytes);
+    std::vector<uint8_t> bytes(static_cast<size_t>(length));
+    jEnv->GetByteArrayRegion(jBytes, 0, length, reinterpret_cast<jbyte *>(bytes.data()));
+    std::string hex(2 * bytes.size(), '\0');
+    HexEncode(bytes.data(), bytes.size(), &hex[0], lowercase == JNI_TRUE);
+    return jEnv->NewStringUTF(hex.c_str());
+}
+
+extern "C"
+JNIEXPORT jbyteArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIHex_jniDecode(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jHex) {
+    JNI_ENTRY_POINT();
+    jsize length = jEnv->GetStringUTFLength(jHex);
+    const char *pHex = jEnv->GetStringUTFChars(jHex, JNI_FALSE);
+    std::vector<uint8_t> bytes(static_cast<size_t>(length) / 2);
+    bool valid = HexDecode(pHex, static_cast<size_t>(length), bytes.data());
+    jEnv->ReleaseStringUTFChars(jHex, pHex);
+    if (!valid) {
+        return nullptr;
+    }
+    auto size = static_cast<jsize>(bytes.size());
+    jbyteArray result = jEnv->NewByteArray(size);
+    jEnv->SetByteArrayRegion(result, 0, size, reinterpret_cast<const jbyte *>(bytes.data()));
+    return result;
+}
+
+extern "C"
+JNIEXPORT jstring JNICALL
+Java_com_tari_android_wallet_ffi_FFIHex_jniGetImplementationName(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    return jEnv->NewStringUTF(GetHexCodec().name);
+}
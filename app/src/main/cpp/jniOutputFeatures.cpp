@@ -38,6 +38,7 @@
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT void JNICALL
@@ -48,6 +49,7 @@ Java_com_tari_android_wallet_ffi_FFIOutputFeatures_jniCreate(
         jlong maturity,
         jobject metadata,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         auto pMetadata = GetPointerField<ByteVector *>(jEnv, metadata);
 
@@ -59,7 +61,7 @@ Java_com_tari_android_wallet_ffi_FFIOutputFeatures_jniCreate(
                 0,
                 errorPointer);
 
-        SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pOutputFeatures));
+        SetPointerField(jEnv, jThis, NewHandle(HANDLE_TYPE_OUTPUT_FEATURES, pOutputFeatures));
     });
 }
 
@@ -68,6 +70,6 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIOutputFeatures_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    output_features_destroy(GetPointerField<TariOutputFeatures *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_OUTPUT_FEATURES);
 }
@@ -38,6 +38,8 @@
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniTariWalletAddressPool.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT jbyteArray JNICALL
@@ -45,6 +47,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetId(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pInboundTx = GetPointerField<TariPendingInboundTransaction *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, pending_inbound_transaction_get_transaction_id(pInboundTx, errorPointer));
@@ -57,9 +60,10 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetSourcePublicKey(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariWalletAddress *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariWalletAddress *>(jEnv, error, HANDLE_TYPE_WALLET_ADDRESS, [&](int *errorPointer) {
         auto pInboundTx = GetPointerField<TariPendingInboundTransaction *>(jEnv, jThis);
-        return pending_inbound_transaction_get_source_tari_address(pInboundTx, errorPointer);
+        return InternTariWalletAddress(pending_inbound_transaction_get_source_tari_address(pInboundTx, errorPointer), errorPointer);
     });
 }
 
@@ -69,6 +73,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetAmount(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pInboundTx = GetPointerField<TariPendingInboundTransaction *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, pending_inbound_transaction_get_amount(pInboundTx, errorPointer));
@@ -81,6 +86,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetPaymentId(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pInboundTx = GetPointerField<TariPendingInboundTransaction *>(jEnv, jThis);
         const char *pPaymentId = pending_inbound_transaction_get_payment_id(pInboundTx, errorPointer);
@@ -96,7 +102,8 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetPaymentIdBytes(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<ByteVector *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<ByteVector *>(jEnv, error, HANDLE_TYPE_BYTE_VECTOR, [&](int *errorPointer) {
         auto pInboundTx = GetPointerField<TariPendingInboundTransaction *>(jEnv, jThis);
         return pending_inbound_transaction_get_payment_id_as_bytes(pInboundTx, errorPointer);
     });
@@ -108,7 +115,8 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetPaymentIdUserBytes(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<ByteVector *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<ByteVector *>(jEnv, error, HANDLE_TYPE_BYTE_VECTOR, [&](int *errorPointer) {
         auto pInboundTx = GetPointerField<TariPendingInboundTransaction *>(jEnv, jThis);
         return pending_inbound_transaction_get_user_payment_id_as_bytes(pInboundTx, errorPointer);
     });
@@ -121,6 +129,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetTimestamp(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pInboundTx = GetPointerField<TariPendingInboundTransaction *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, pending_inbound_transaction_get_timestamp(pInboundTx, errorPointer));
@@ -133,6 +142,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniGetStatus(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pInboundTx = GetPointerField<TariPendingInboundTransaction *>(jEnv, jThis);
         return reinterpret_cast<jint>(pending_inbound_transaction_get_status(pInboundTx, errorPointer));
@@ -144,6 +154,6 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingInboundTx_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    pending_inbound_transaction_destroy(GetPointerField<TariPendingInboundTransaction *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_PENDING_INBOUND_TX);
 }
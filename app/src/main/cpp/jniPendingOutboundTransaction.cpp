@@ -38,6 +38,8 @@
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniTariWalletAddressPool.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT jbyteArray JNICALL
@@ -45,6 +47,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetId(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pOutboundTx = GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, pending_outbound_transaction_get_transaction_id(pOutboundTx, errorPointer));
@@ -57,9 +60,10 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetDestinationPublicKey
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariWalletAddress *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariWalletAddress *>(jEnv, error, HANDLE_TYPE_WALLET_ADDRESS, [&](int *errorPointer) {
         auto pOutboundTx = GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis);
-        return pending_outbound_transaction_get_destination_tari_address(pOutboundTx, errorPointer);
+        return InternTariWalletAddress(pending_outbound_transaction_get_destination_tari_address(pOutboundTx, errorPointer), errorPointer);
     });
 }
 
@@ -69,6 +73,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetAmount(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pOutboundTx = GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, pending_outbound_transaction_get_amount(pOutboundTx, errorPointer));
@@ -82,6 +87,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetFee(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pOutboundTx = GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, pending_outbound_transaction_get_fee(pOutboundTx, errorPointer));
@@ -94,6 +100,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetPaymentId(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pOutboundTx = GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis);
         const char *pPaymentId = pending_outbound_transaction_get_payment_id(pOutboundTx, errorPointer);
@@ -109,7 +116,8 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetPaymentIdBytes(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<ByteVector *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<ByteVector *>(jEnv, error, HANDLE_TYPE_BYTE_VECTOR, [&](int *errorPointer) {
         auto pOutboundTx = GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis);
         return pending_outbound_transaction_get_payment_id_as_bytes(pOutboundTx, errorPointer);
     });
@@ -121,7 +129,8 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetPaymentIdUserBytes(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<ByteVector *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<ByteVector *>(jEnv, error, HANDLE_TYPE_BYTE_VECTOR, [&](int *errorPointer) {
         auto pOutboundTx = GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis);
         return pending_outbound_transaction_get_user_payment_id_as_bytes(pOutboundTx, errorPointer);
     });
@@ -133,6 +142,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetTimestamp(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pOutboundTx = GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, pending_outbound_transaction_get_timestamp(pOutboundTx, errorPointer));
@@ -145,6 +155,7 @@ Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniGetStatus(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pOutboundTx = GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis);
         return reinterpret_cast<jint>(pending_outbound_transaction_get_status(pOutboundTx, errorPointer));
@@ -156,6 +167,6 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPendingOutboundTx_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    pending_outbound_transaction_destroy(GetPointerField<TariPendingOutboundTransaction *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_PENDING_OUTBOUND_TX);
 }
\ No newline at end of file
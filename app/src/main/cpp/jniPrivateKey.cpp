@@ -38,6 +38,7 @@
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT void JNICALL
@@ -46,9 +47,10 @@ Java_com_tari_android_wallet_ffi_FFIPrivateKey_jniCreate(
         jobject jThis,
         jobject jByteVector,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         auto pByteVector = GetPointerField<ByteVector *>(jEnv, jByteVector);
-        auto result = reinterpret_cast<jlong>(private_key_create(pByteVector, errorPointer));
+        auto result = NewHandle(HANDLE_TYPE_PRIVATE_KEY, private_key_create(pByteVector, errorPointer));
         SetPointerField(jEnv, jThis, result);
     });
 }
@@ -58,7 +60,8 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPrivateKey_jniGenerate(
         JNIEnv *jEnv,
         jobject jThis) {
-    SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(private_key_generate()));
+    JNI_ENTRY_POINT();
+    SetPointerField(jEnv, jThis, NewHandle(HANDLE_TYPE_PRIVATE_KEY, private_key_generate()));
 }
 
 extern "C"
@@ -68,11 +71,12 @@ Java_com_tari_android_wallet_ffi_FFIPrivateKey_jniFromHex(
         jobject jThis,
         jstring jHexStr,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         const char *pStr = jEnv->GetStringUTFChars(jHexStr, JNI_FALSE);
         TariPrivateKey *pPrivateKey = private_key_from_hex(pStr, errorPointer);
         jEnv->ReleaseStringUTFChars(jHexStr, pStr);
-        SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pPrivateKey));
+        SetPointerField(jEnv, jThis, NewHandle(HANDLE_TYPE_PRIVATE_KEY, pPrivateKey));
     });
 }
 
@@ -82,7 +86,8 @@ Java_com_tari_android_wallet_ffi_FFIPrivateKey_jniGetBytes(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<ByteVector *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<ByteVector *>(jEnv, error, HANDLE_TYPE_BYTE_VECTOR, [&](int *errorPointer) {
         auto pPrivateKey = GetPointerField<PrivateKey *>(jEnv, jThis);
         return private_key_get_bytes(pPrivateKey, errorPointer);
     });
@@ -93,6 +98,6 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPrivateKey_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    private_key_destroy(GetPointerField<PrivateKey *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_PRIVATE_KEY);
 }
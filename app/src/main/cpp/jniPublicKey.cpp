@@ -38,6 +38,7 @@
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT void JNICALL
@@ -46,9 +47,10 @@ Java_com_tari_android_wallet_ffi_FFIPublicKey_jniCreate(
         jobject jThis,
         jobject jByteVector,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         auto pByteVector = GetPointerField<ByteVector *>(jEnv, jByteVector);
-        auto result = reinterpret_cast<jlong>(public_key_create(pByteVector, errorPointer));
+        auto result = NewHandle(HANDLE_TYPE_PUBLIC_KEY, public_key_create(pByteVector, errorPointer));
         SetPointerField(jEnv, jThis, result);
     });
 }
@@ -60,11 +62,12 @@ Java_com_tari_android_wallet_ffi_FFIPublicKey_jniFromHex(
         jobject jThis,
         jstring jHexStr,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         const char *pStr = jEnv->GetStringUTFChars(jHexStr, JNI_FALSE);
         TariPublicKey *pPublicKey = public_key_from_hex(pStr, errorPointer);
         jEnv->ReleaseStringUTFChars(jHexStr, pStr);
-        SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pPublicKey));
+        SetPointerField(jEnv, jThis, NewHandle(HANDLE_TYPE_PUBLIC_KEY, pPublicKey));
     });
 }
 
@@ -75,9 +78,10 @@ Java_com_tari_android_wallet_ffi_FFIPublicKey_jniFromPrivateKey(
         jobject jThis,
         jobject jPrivateKey,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         auto pPrivateKey = GetPointerField<TariPrivateKey *>(jEnv, jPrivateKey);
-        auto result = reinterpret_cast<jlong>(public_key_from_private_key(pPrivateKey, errorPointer));
+        auto result = NewHandle(HANDLE_TYPE_PUBLIC_KEY, public_key_from_private_key(pPrivateKey, errorPointer));
         SetPointerField(jEnv, jThis, result);
     });
 }
@@ -88,7 +92,8 @@ Java_com_tari_android_wallet_ffi_FFIPublicKey_jniGetBytes(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<ByteVector *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<ByteVector *>(jEnv, error, HANDLE_TYPE_BYTE_VECTOR, [&](int *errorPointer) {
         auto pPublicKey = GetPointerField<TariPublicKey *>(jEnv, jThis);
         return public_key_get_bytes(pPublicKey, errorPointer);
     });
@@ -100,6 +105,7 @@ Java_com_tari_android_wallet_ffi_FFIPublicKey_jniGetEmojiId(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pPublicKey = GetPointerField<TariPublicKey *>(jEnv, jThis);
         const char *pEmojiId = public_key_get_emoji_encoding(pPublicKey, errorPointer);
@@ -114,8 +120,8 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPublicKey_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    public_key_destroy(GetPointerField<TariPublicKey *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_PUBLIC_KEY);
 }
 
 extern "C"
@@ -124,6 +130,7 @@ Java_com_tari_android_wallet_ffi_FFIPublicKeys_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<int>(jEnv, error, [&](int *errorPointer) {
         auto pPublicKeys = GetPointerField<TariPublicKeys *>(jEnv, jThis);
         return public_keys_get_length(pPublicKeys, errorPointer);
@@ -137,7 +144,8 @@ Java_com_tari_android_wallet_ffi_FFIPublicKeys_jniGetAt(
         jobject jThis,
         jint jIndex,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariPublicKey *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariPublicKey *>(jEnv, error, HANDLE_TYPE_PUBLIC_KEY, [&](int *errorPointer) {
         auto pPublicKeys = GetPointerField<TariPublicKeys *>(jEnv, jThis);
         return public_keys_get_at(pPublicKeys, static_cast<unsigned int>(jIndex), errorPointer);
     });
@@ -148,6 +156,6 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIPublicKeys_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    public_keys_destroy(GetPointerField<TariPublicKeys *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_PUBLIC_KEYS);
 }
\ No newline at end of file
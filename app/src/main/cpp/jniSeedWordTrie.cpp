@@ -0,0 +1,286 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jni.h>
+#include <android/log.h>
+#include <wallet.h>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include "jniCommon.cpp"
+
+/**
+ * Prefix trie over a mnemonic word list, used for autocompletion while the user types the recovery phrase.
+ *
+ * Nodes live in one flat array and the children of a node are stored next to each other in label order,
+ * so a lookup is a short linear scan per character and a completion is an in-order walk.
+ */
+class SeedWordTrie {
+public:
+    explicit SeedWordTrie(std::vector<std::string> words) : words(std::move(words)) {
+        std::vector<int32_t> order(this->words.size());
+        for (size_t i = 0; i < order.size(); i++) {
+            order[i] = static_cast<int32_t>(i);
+        }
+        std::sort(order.begin(), order.end(), [&](int32_t a, int32_t b) { return this->words[a] < this->words[b]; });
+        nodes.push_back(Node());
+        build(0, order, 0, order.size(), 0);
+    }
+
+    size_t wordCount() const {
+        return words.size();
+    }
+
+    bool contains(const std::string &word) const {
+        int32_t node = find(word);
+        return node >= 0 && nodes[node].word >= 0;
+    }
+
+    /**
+     * @return up to limit words starting with prefix, in alphabetical order
+     */
+    std::vector<std::string> complete(const std::string &prefix, size_t limit) const {
+        std::vector<std::string> result;
+        int32_t node = find(prefix);
+        if (node >= 0) {
+            collect(node, limit, result);
+        }
+        return result;
+    }
+
+    /**
+     * @return up to limit words within maxDistance edits of word, closest first
+     */
+    std::vector<std::string> suggest(const std::string &word, int maxDistance, size_t limit) const {
+        std::vector<std::pair<int, int32_t>> matches;
+        std::vector<int> row(word.size() + 1);
+        for (size_t i = 0; i < row.size(); i++) {
+            row[i] = static_cast<int>(i);
+        }
+        const Node &root = nodes[0];
+        for (int32_t child = root.firstChild; child < root.firstChild + root.childCount; child++) {
+            searchDistance(child, word, row, maxDistance, matches);
+        }
+        std::sort(matches.begin(), matches.end());
+        std::vector<std::string> result;
+        for (size_t i = 0; i < matches.size() && result.size() < limit; i++) {
+            result.push_back(words[matches[i].second]);
+        }
+        return result;
+    }
+
+private:
+    struct Node {
+        int32_t firstChild = 0;
+        int32_t word = -1;
+        uint16_t childCount = 0;
+        char label = 0;
+    };
+
+    std::vector<std::string> words;
+    std::vector<Node> nodes;
+
+    // words in [from, to) of the sorted order share their first depth bytes and belong below node
+    void build(int32_t node, const std::vector<int32_t> &order, size_t from, size_t to, size_t depth) {
+        if (from < to && words[order[from]].size() == depth) {
+            nodes[node].word = order[from++];
+        }
+        std::vector<std::pair<size_t, size_t>> groups;
+        for (size_t i = from; i < to;) {
+            size_t end = i + 1;
+            while (end < to && words[order[end]][depth] == words[order[i]][depth]) {
+                end++;
+            }
+            groups.emplace_back(i, end);
+            i = end;
+        }
+        auto firstChild = static_cast<int32_t>(nodes.size());
+        nodes[node].firstChild = firstChild;
+        nodes[node].childCount = static_cast<uint16_t>(groups.size());
+        for (const auto &group : groups) {
+            Node child;
+            child.label = words[order[group.first]][depth];
+            nodes.push_back(child);
+        }
+        for (size_t g = 0; g < groups.size(); g++) {
+            build(firstChild + static_cast<int32_t>(g), order, groups[g].first, groups[g].second, depth + 1);
+        }
+    }
+
+    int32_t find(const std::string &prefix) const {
+        int32_t node = 0;
+        for (char c : prefix) {
+            const Node &current = nodes[node];
+            int32_t next = -1;
+            for (int32_t child = current.firstChild; child < current.firstChild + current.childCount; child++) {
+                if (nodes[child].label == c) {
+                    next = child;
+                    break;
+                }
+            }
+            if (next < 0) {
+                return -1;
+            }
+            node = next;
+        }
+        return node;
+    }
+
+    void collect(int32_t node, size_t limit, std::vector<std::string> &result) const {
+        if (result.size() >= limit) {
+            return;
+        }
+        if (nodes[node].word >= 0) {
+            result.push_back(words[nodes[node].word]);
+        }
+        const Node &current = nodes[node];
+        for (int32_t child = current.firstChild; child < current.firstChild + current.childCount; child++) {
+            collect(child, limit, result);
+        }
+    }
+
+    // Levenshtein distance computed one trie level at a time, branches are cut once every cell exceeds maxDistance
+    void searchDistance(int32_t node, const std::string &word, const std::vector<int> &previousRow, int maxDistance,
+                        std::vector<std::pair<int, int32_t>> &matches) const {
+        std::vector<int> row(previousRow.size());
+        row[0] = previousRow[0] + 1;
+        int rowMinimum = row[0];
+        for (size_t i = 1; i < row.size(); i++) {
+            int substitution = previousRow[i - 1] + (word[i - 1] == nodes[node].label ? 0 : 1);
+            row[i] = std::min(std::min(row[i - 1] + 1, previousRow[i] + 1), substitution);
+            rowMinimum = std::min(rowMinimum, row[i]);
+        }
+        if (nodes[node].word >= 0 && row.back() <= maxDistance) {
+            matches.emplace_back(row.back(), nodes[node].word);
+        }
+        if (rowMinimum > maxDistance) {
+            return;
+        }
+        const Node &current = nodes[node];
+        for (int32_t child = current.firstChild; child < current.firstChild + current.childCount; child++) {
+            searchDistance(child, word, row, maxDistance, matches);
+        }
+    }
+};
+
+/**
+ * @return the trie for the language, built from the libwallet word list on first use
+ */
+inline std::shared_ptr<const SeedWordTrie> GetSeedWordTrie(const std::string &language, int *errorPointer) {
+    static std::mutex mutex;
+    static std::map<std::string, std::shared_ptr<const SeedWordTrie>> tries;
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = tries.find(language);
+    if (it != tries.end()) {
+        return it->second;
+    }
+    TariSeedWords *pSeedWords = seed_words_get_mnemonic_word_list_for_language(language.c_str(), errorPointer);
+    if (*errorPointer != 0) {
+        return nullptr;
+    }
+    unsigned int length = seed_words_get_length(pSeedWords, errorPointer);
+    std::vector<std::string> words;
+    words.reserve(length);
+    for (unsigned int i = 0; i < length && *errorPointer == 0; i++) {
+        char *pWord = seed_words_get_at(pSeedWords, i, errorPointer);
+        if (*errorPointer == 0) {
+            words.emplace_back(pWord);
+            string_destroy(pWord);
+        }
+    }
+    seed_words_destroy(pSeedWords);
+    if (*errorPointer != 0) {
+        return nullptr;
+    }
+    auto trie = std::make_shared<const SeedWordTrie>(std::move(words));
+    tries[language] = trie;
+    return trie;
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_tari_android_wallet_ffi_FFISeedWordTrie_jniContains(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jLanguage,
+        jstring jWord,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) -> jboolean {
+        auto trie = GetSeedWordTrie(GetStdString(jEnv, jLanguage), errorPointer);
+        return trie != nullptr && trie->contains(GetStdString(jEnv, jWord)) ? JNI_TRUE : JNI_FALSE;
+    });
+}
+
+extern "C"
+JNIEXPORT jobjectArray JNICALL
+Java_com_tari_android_wallet_ffi_FFISeedWordTrie_jniComplete(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jLanguage,
+        jstring jPrefix,
+        jint limit,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jobjectArray>(jEnv, error, [&](int *errorPointer) -> jobjectArray {
+        auto trie = GetSeedWordTrie(GetStdString(jEnv, jLanguage), errorPointer);
+        if (trie == nullptr) {
+            return nullptr;
+        }
+        return NewStringArray(jEnv, trie->complete(GetStdString(jEnv, jPrefix), static_cast<size_t>(limit)));
+    });
+}
+
+extern "C"
+JNIEXPORT jobjectArray JNICALL
+Java_com_tari_android_wallet_ffi_FFISeedWordTrie_jniSuggest(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jLanguage,
+        jstring jWord,
+        jint maxDistance,
+        jint limit,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jobjectArray>(jEnv, error, [&](int *errorPointer) -> jobjectArray {
+        auto trie = GetSeedWordTrie(GetStdString(jEnv, jLanguage), errorPointer);
+        if (trie == nullptr) {
+            return nullptr;
+        }
+        return NewStringArray(jEnv, trie->suggest(GetStdString(jEnv, jWord), maxDistance, static_cast<size_t>(limit)));
+    });
+}
@@ -35,17 +35,20 @@
 #include <android/log.h>
 #include <wallet.h>
 #include <string>
+#include <vector>
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFISeedWords_jniCreate(
         JNIEnv *jEnv,
         jobject jThis) {
+    JNI_ENTRY_POINT();
     TariSeedWords *pSeedWords = seed_words_create();
-    SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pSeedWords));
+    SetPointerField(jEnv, jThis, NewHandle(HANDLE_TYPE_SEED_WORDS, pSeedWords));
 }
 
 extern "C"
@@ -56,13 +59,14 @@ Java_com_tari_android_wallet_ffi_FFISeedWords_jniFromBase58(
         jstring jCypher,
         jstring jPassphrase,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         const char *pCypher = jEnv->GetStringUTFChars(jCypher, JNI_FALSE);
         const char *pPassphrase = jEnv->GetStringUTFChars(jPassphrase, JNI_FALSE);
         TariSeedWords *pSeedWords = seed_words_create_from_cipher(pCypher, pPassphrase, errorPointer);
         jEnv->ReleaseStringUTFChars(jCypher, pCypher);
         jEnv->ReleaseStringUTFChars(jPassphrase, pPassphrase);
-        SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pSeedWords));
+        SetPointerField(jEnv, jThis, NewHandle(HANDLE_TYPE_SEED_WORDS, pSeedWords));
     });
 }
 
@@ -73,10 +77,11 @@ Java_com_tari_android_wallet_ffi_FFISeedWords_jniGetMnemonicWordListForLanguage(
         jobject jThis,
         jstring language,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         const char *pLanguage = jEnv->GetStringUTFChars(language, JNI_FALSE);
         TariSeedWords *pSeedWords = seed_words_get_mnemonic_word_list_for_language(pLanguage, errorPointer);
-        SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pSeedWords));
+        SetPointerField(jEnv, jThis, NewHandle(HANDLE_TYPE_SEED_WORDS, pSeedWords));
     });
 }
 
@@ -87,6 +92,7 @@ Java_com_tari_android_wallet_ffi_FFISeedWords_jniPushWord(
         jobject jThis,
         jstring jWord,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pSeedWords = GetPointerField<TariSeedWords *>(jEnv, jThis);
         const char *pWord = jEnv->GetStringUTFChars(jWord, JNI_FALSE);
@@ -102,6 +108,7 @@ Java_com_tari_android_wallet_ffi_FFISeedWords_jniGetLength(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pSeedWords = GetPointerField<TariSeedWords *>(jEnv, jThis);
         return seed_words_get_length(pSeedWords, errorPointer);
@@ -115,6 +122,7 @@ Java_com_tari_android_wallet_ffi_FFISeedWords_jniGetAt(
         jobject jThis,
         jint index,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pSeedWords = GetPointerField<TariSeedWords *>(jEnv, jThis);
         const char *pWord = seed_words_get_at(pSeedWords, static_cast<unsigned int>(index), errorPointer);
@@ -124,11 +132,58 @@ Java_com_tari_android_wallet_ffi_FFISeedWords_jniGetAt(
     });
 }
 
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_tari_android_wallet_ffi_FFISeedWords_jniPushWords(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobjectArray jWords,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
+        auto pSeedWords = GetPointerField<TariSeedWords *>(jEnv, jThis);
+        const jint successfulPush = 1;
+        jint result = successfulPush;
+        jsize count = jEnv->GetArrayLength(jWords);
+        for (jsize i = 0; i < count && result == successfulPush && *errorPointer == 0; i++) {
+            auto jWord = static_cast<jstring>(jEnv->GetObjectArrayElement(jWords, i));
+            const char *pWord = jEnv->GetStringUTFChars(jWord, JNI_FALSE);
+            result = seed_words_push_word(pSeedWords, pWord, nullptr, errorPointer);
+            jEnv->ReleaseStringUTFChars(jWord, pWord);
+            jEnv->DeleteLocalRef(jWord);
+        }
+        return result;
+    });
+}
+
+extern "C"
+JNIEXPORT jobjectArray JNICALL
+Java_com_tari_android_wallet_ffi_FFISeedWords_jniGetAll(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jobjectArray>(jEnv, error, [&](int *errorPointer) -> jobjectArray {
+        auto pSeedWords = GetPointerField<TariSeedWords *>(jEnv, jThis);
+        unsigned int length = seed_words_get_length(pSeedWords, errorPointer);
+        std::vector<std::string> words;
+        words.reserve(length);
+        for (unsigned int i = 0; i < length && *errorPointer == 0; i++) {
+            char *pWord = seed_words_get_at(pSeedWords, i, errorPointer);
+            if (*errorPointer == 0) {
+                words.emplace_back(pWord);
+                string_destroy(pWord);
+            }
+        }
+        return *errorPointer == 0 ? NewStringArray(jEnv, words) : nullptr;
+    });
+}
+
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFISeedWords_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    seed_words_destroy(GetPointerField<TariSeedWords *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_SEED_WORDS);
 }
\ No newline at end of file
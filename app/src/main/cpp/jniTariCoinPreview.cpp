@@ -44,6 +44,7 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariCoinPreview_jniLoadData(
         JNIEnv *jEnv,
         jobject jThis) {
+    JNI_ENTRY_POINT();
     jclass dataClass = jEnv->GetObjectClass(jThis);
     auto outputs = GetPointerField<TariCoinPreview *>(jEnv, jThis);
 
@@ -45,6 +45,7 @@ Java_com_tari_android_wallet_ffi_FFIFeePerGramStat_jniGetOrder(
         jobject jThis,
         jobject error
 ) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pTariFeePerGramStat = GetPointerField<TariFeePerGramStat *>(jEnv, jThis);
         unsigned long long order = fee_per_gram_stat_get_order(pTariFeePerGramStat, errorPointer);
@@ -59,6 +60,7 @@ Java_com_tari_android_wallet_ffi_FFIFeePerGramStat_jniGetMin(
         jobject jThis,
         jobject error
 ) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pTariFeePerGramStat = GetPointerField<TariFeePerGramStat *>(jEnv, jThis);
         unsigned long long order = fee_per_gram_stat_get_min_fee_per_gram(pTariFeePerGramStat, errorPointer);
@@ -73,6 +75,7 @@ Java_com_tari_android_wallet_ffi_FFIFeePerGramStat_jniGetMax(
         jobject jThis,
         jobject error
 ) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pTariFeePerGramStat = GetPointerField<TariFeePerGramStat *>(jEnv, jThis);
         unsigned long long order = fee_per_gram_stat_get_max_fee_per_gram(pTariFeePerGramStat, errorPointer);
@@ -87,6 +90,7 @@ Java_com_tari_android_wallet_ffi_FFIFeePerGramStat_jniGetAverage(
         jobject jThis,
         jobject error
 ) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pTariFeePerGramStat = GetPointerField<TariFeePerGramStat *>(jEnv, jThis);
         unsigned long long order = fee_per_gram_stat_get_avg_fee_per_gram(pTariFeePerGramStat, errorPointer);
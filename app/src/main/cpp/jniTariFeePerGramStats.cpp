@@ -37,6 +37,7 @@
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT int JNICALL
@@ -45,6 +46,7 @@ Java_com_tari_android_wallet_ffi_FFIFeePerGramStats_jniFeePerGramStatsGetLength(
         jobject jThis,
         jobject error
 ) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<int>(jEnv, error, [&](int *errorPointer) {
         auto pTariFeePerGramStats = GetPointerField<TariFeePerGramStats *>(jEnv, jThis);
         return fee_per_gram_stats_get_length(pTariFeePerGramStats, errorPointer);
@@ -58,6 +60,7 @@ Java_com_tari_android_wallet_ffi_FFIFeePerGramStats_jniGetAt(
         jobject jThis,
         jint index,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithErrorAndCast<TariFeePerGramStat *>(jEnv, error, [&](int *errorPointer) {
         auto pTariFeePerGramStats = GetPointerField<TariFeePerGramStats *>(jEnv, jThis);
         return fee_per_gram_stats_get_at(pTariFeePerGramStats, static_cast<unsigned int>(index), errorPointer);
@@ -69,6 +72,6 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIFeePerGramStats_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    fee_per_gram_stats_destroy(GetPointerField<TariFeePerGramStats *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_FEE_PER_GRAM_STATS);
 }
\ No newline at end of file
@@ -7,6 +7,7 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariPaymentRecord_jniLoadData(
         JNIEnv *jEnv,
         jobject jThis) {
+    JNI_ENTRY_POINT();
     jclass dataClass = jEnv->GetObjectClass(jThis);
     auto outputs = GetPointerField<TariPaymentRecord *>(jEnv, jThis);
 
@@ -37,6 +37,7 @@
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT void JNICALL
@@ -45,11 +46,12 @@ Java_com_tari_android_wallet_ffi_FFITariUnblindedOutput_jniFromJson(
         jobject jThis,
         jstring jJson,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         const char *pJson = jEnv->GetStringUTFChars(jJson, JNI_FALSE);
         UnblindedOutput *pUnblindedOutput = create_tari_unblinded_output_from_json(pJson, errorPointer);
         jEnv->ReleaseStringUTFChars(jJson, pJson);
-        SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pUnblindedOutput));
+        SetPointerField(jEnv, jThis, NewHandle(HANDLE_TYPE_UNBLINDED_OUTPUT, pUnblindedOutput));
     });
 }
 
@@ -59,6 +61,7 @@ Java_com_tari_android_wallet_ffi_FFITariUnblindedOutput_jniToJson(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pUnblindedOutput = GetPointerField<UnblindedOutput *>(jEnv, jThis);
         const char *pJson = tari_unblinded_output_to_json(pUnblindedOutput, errorPointer);
@@ -73,6 +76,6 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariUnblindedOutput_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    tari_unblinded_output_destroy(GetPointerField<TariUnblindedOutput *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_UNBLINDED_OUTPUT);
 }
@@ -35,15 +35,19 @@
 #include <android/log.h>
 #include <wallet.h>
 #include <string>
+#include <vector>
+#include <cstring>
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "hexCodec.cpp"
 
 extern "C"
 JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariVector_jniLoadData(
         JNIEnv *jEnv,
         jobject jThis) {
+    JNI_ENTRY_POINT();
     jclass dataClass = jEnv->GetObjectClass(jThis);
     auto outputs = GetPointerField<TariVector *>(jEnv, jThis);
 
@@ -66,6 +70,7 @@ Java_com_tari_android_wallet_ffi_FFITariVector_jniGetItemAt(
         JNIEnv *jEnv,
         jobject jThis,
         jint index) {
+    JNI_ENTRY_POINT();
     auto outputs = GetPointerField<TariVector *>(jEnv, jThis);
 
     jlong pointerToItem = 0;
@@ -79,4 +84,64 @@ Java_com_tari_android_wallet_ffi_FFITariVector_jniGetItemAt(
     }
 
     return pointerToItem;
-}
\ No newline at end of file
+}
+/**
+ * Copies a UTXO vector into primitive columns with one call. Commitments are decoded from hex into one binary
+ * column where commitment i occupies [commitmentOffsets[i], commitmentOffsets[i + 1]).
+ * All arrays must hold len elements, commitmentOffsets len + 1.
+ *
+ * @return the commitment column, or null if the vector doesn't hold UTXOs or a commitment isn't valid hex
+ */
+extern "C"
+JNIEXPORT jbyteArray JNICALL
+Java_com_tari_android_wallet_ffi_FFITariVector_jniGetUtxoColumns(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlongArray jValues,
+        jlongArray jMinedHeights,
+        jlongArray jMinedTimestamps,
+        jlongArray jLockHeights,
+        jbyteArray jStatuses,
+        jintArray jCommitmentOffsets) {
+    JNI_ENTRY_POINT();
+    auto outputs = GetPointerField<TariVector *>(jEnv, jThis);
+    if (outputs->tag != Utxo) {
+        return nullptr;
+    }
+    auto items = reinterpret_cast<TariUtxo *>(outputs->ptr);
+    size_t count = outputs->len;
+
+    std::vector<jlong> values(count), minedHeights(count), minedTimestamps(count), lockHeights(count);
+    std::vector<jbyte> statuses(count);
+    std::vector<jint> commitmentOffsets(count + 1, 0);
+    std::vector<uint8_t> commitments;
+    for (size_t i = 0; i < count; i++) {
+        const TariUtxo &item = items[i];
+        values[i] = static_cast<jlong>(item.value);
+        minedHeights[i] = static_cast<jlong>(item.mined_height);
+        minedTimestamps[i] = static_cast<jlong>(item.mined_timestamp);
+        lockHeights[i] = static_cast<jlong>(item.lock_height);
+        statuses[i] = static_cast<jbyte>(item.status);
+
+        size_t hexLength = strlen(item.commitment);
+        size_t offset = commitments.size();
+        commitments.resize(offset + hexLength / 2);
+        if (!HexDecode(item.commitment, hexLength, commitments.data() + offset)) {
+            return nullptr;
+        }
+        commitmentOffsets[i + 1] = static_cast<jint>(commitments.size());
+    }
+
+    auto size = static_cast<jsize>(count);
+    jEnv->SetLongArrayRegion(jValues, 0, size, values.data());
+    jEnv->SetLongArrayRegion(jMinedHeights, 0, size, minedHeights.data());
+    jEnv->SetLongArrayRegion(jMinedTimestamps, 0, size, minedTimestamps.data());
+    jEnv->SetLongArrayRegion(jLockHeights, 0, size, lockHeights.data());
+    jEnv->SetByteArrayRegion(jStatuses, 0, size, statuses.data());
+    jEnv->SetIntArrayRegion(jCommitmentOffsets, 0, size + 1, commitmentOffsets.data());
+
+    auto commitmentsSize = static_cast<jsize>(commitments.size());
+    jbyteArray result = jEnv->NewByteArray(commitmentsSize);
+    jEnv->SetByteArrayRegion(result, 0, commitmentsSize, reinterpret_cast<const jbyte *>(commitments.data()));
+    return result;
+}
@@ -38,6 +38,8 @@
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniTariWalletAddressPool.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT void JNICALL
@@ -46,9 +48,10 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniCreate(
         jobject jThis,
         jobject jByteVector,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         auto pByteVector = GetPointerField<ByteVector *>(jEnv, jByteVector);
-        auto result = reinterpret_cast<jlong>(tari_address_create(pByteVector, errorPointer));
+        auto result = NewHandle(HANDLE_TYPE_WALLET_ADDRESS, tari_address_create(pByteVector, errorPointer));
         SetPointerField(jEnv, jThis, result);
     });
 }
@@ -60,11 +63,12 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniFromBase58(
         jobject jThis,
         jstring jBase58Str,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         const char *pBase58Str = jEnv->GetStringUTFChars(jBase58Str, JNI_FALSE);
         auto pTariWalletAddress = tari_address_from_base58(pBase58Str, errorPointer);
         jEnv->ReleaseStringUTFChars(jBase58Str, pBase58Str);
-        SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pTariWalletAddress));
+        SetPointerField(jEnv, jThis, NewHandle(HANDLE_TYPE_WALLET_ADDRESS, pTariWalletAddress));
     });
 }
 
@@ -75,9 +79,10 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniFromEmojiId(
         jobject jThis,
         jstring jpEmoji,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         const char *pStr = jEnv->GetStringUTFChars(jpEmoji, JNI_FALSE);
-        auto result = reinterpret_cast<jlong>(emoji_id_to_tari_address(pStr, errorPointer));
+        auto result = NewHandle(HANDLE_TYPE_WALLET_ADDRESS, emoji_id_to_tari_address(pStr, errorPointer));
         jEnv->ReleaseStringUTFChars(jpEmoji, pStr);
         SetPointerField(jEnv, jThis, result);
     });
@@ -89,6 +94,7 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetEmojiId(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pWalletAddress = GetPointerField<TariWalletAddress *>(jEnv, jThis);
         const char *pEmoji = tari_address_to_emoji_id(pWalletAddress, errorPointer);
@@ -104,7 +110,8 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetBytes(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<ByteVector *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<ByteVector *>(jEnv, error, HANDLE_TYPE_BYTE_VECTOR, [&](int *errorPointer) {
         auto pTariWalletAddress = GetPointerField<TariWalletAddress *>(jEnv, jThis);
         return tari_address_get_bytes(pTariWalletAddress, errorPointer);
     });
@@ -115,8 +122,58 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    tari_address_destroy(GetPointerField<TariWalletAddress *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_WALLET_ADDRESS);
+}
+
+/**
+ * Fields of FFITariWalletAddress.Metadata.
+ */
+struct MetadataFields {
+    jfieldID network;
+    jfieldID features;
+    jfieldID checksum;
+    jfieldID emojiId;
+    jfieldID bytes;
+};
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniLoadMetadata(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject jMetadata,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    ExecuteWithError(jEnv, error, [&](int *errorPointer) {
+        auto pWalletAddress = GetPointerField<TariWalletAddress *>(jEnv, jThis);
+        TariWalletAddressMetadata metadata = GetTariWalletAddressPool().metadata(pWalletAddress, errorPointer);
+        if (*errorPointer != 0) {
+            return;
+        }
+        // field ids stay valid as long as the class is loaded, Metadata is never unloaded
+        static const MetadataFields fields = [jEnv, jMetadata] {
+            jclass dataClass = jEnv->GetObjectClass(jMetadata);
+            MetadataFields ids{
+                    jEnv->GetFieldID(dataClass, "network", "I"),
+                    jEnv->GetFieldID(dataClass, "features", "I"),
+                    jEnv->GetFieldID(dataClass, "checksum", "I"),
+                    jEnv->GetFieldID(dataClass, "emojiId", "Ljava/lang/String;"),
+                    jEnv->GetFieldID(dataClass, "bytes", "[B"),
+            };
+            jEnv->DeleteLocalRef(dataClass);
+            return ids;
+        }();
+        jEnv->SetIntField(jMetadata, fields.network, metadata.network);
+        jEnv->SetIntField(jMetadata, fields.features, metadata.features);
+        jEnv->SetIntField(jMetadata, fields.checksum, metadata.checksum);
+        jEnv->SetObjectField(jMetadata, fields.emojiId, jEnv->NewStringUTF(metadata.emojiId.c_str()));
+
+        auto size = static_cast<jsize>(metadata.bytes.size());
+        jbyteArray jBytes = jEnv->NewByteArray(size);
+        jEnv->SetByteArrayRegion(jBytes, 0, size, reinterpret_cast<const jbyte *>(metadata.bytes.data()));
+        jEnv->SetObjectField(jMetadata, fields.bytes, jBytes);
+    });
 }
 
 extern "C"
@@ -125,6 +182,7 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetNetwork(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pWalletAddress = GetPointerField<TariWalletAddress *>(jEnv, jThis);
         return static_cast<jint>(tari_address_network_u8(pWalletAddress, errorPointer));
@@ -137,6 +195,7 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetFeatures(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pWalletAddress = GetPointerField<TariWalletAddress *>(jEnv, jThis);
         return static_cast<jint>(tari_address_features_u8(pWalletAddress, errorPointer));
@@ -149,7 +208,8 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetViewKey(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariPublicKey *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariPublicKey *>(jEnv, error, HANDLE_TYPE_PUBLIC_KEY, [&](int *errorPointer) {
         auto pWalletAddress = GetPointerField<TariWalletAddress *>(jEnv, jThis);
         return tari_address_view_key(pWalletAddress, errorPointer);
     });
@@ -161,7 +221,8 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetSpendKey(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariPublicKey *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariPublicKey *>(jEnv, error, HANDLE_TYPE_PUBLIC_KEY, [&](int *errorPointer) {
         auto pWalletAddress = GetPointerField<TariWalletAddress *>(jEnv, jThis);
         return tari_address_spend_key(pWalletAddress, errorPointer);
     });
@@ -172,6 +233,7 @@ Java_com_tari_android_wallet_ffi_FFITariWalletAddress_jniGetChecksum(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) {
         auto pWalletAddress = GetPointerField<TariWalletAddress *>(jEnv, jThis);
         return static_cast<jint>(tari_address_checksum_u8(pWalletAddress, errorPointer));
@@ -0,0 +1,205 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef JNI_TARI_WALLET_ADDRESS_POOL_CPP
+#define JNI_TARI_WALLET_ADDRESS_POOL_CPP
+
+#include <jni.h>
+#include <wallet.h>
+#include <string>
+#include <mutex>
+#include <unordered_map>
+#include "jniCommon.cpp"
+
+/**
+ * Metadata of a wallet address, computed once when the address enters the pool.
+ */
+struct TariWalletAddressMetadata {
+    std::string bytes;
+    std::string emojiId;
+    int network = -1;
+    int features = -1;
+    int checksum = -1;
+};
+
+/**
+ * Interning table for wallet addresses returned by libwallet.
+ *
+ * Transactions and contacts return a freshly allocated address on every getter call, so a long
+ * history ends up holding one native address per transaction. The pool keys addresses by their
+ * byte representation and hands out a single shared, reference counted handle per counterparty.
+ */
+class TariWalletAddressPool {
+public:
+    /**
+     * Takes ownership of the passed address and returns the shared handle for its bytes.
+     * The caller owns one reference of the returned handle and must give it back with release().
+     */
+    TariWalletAddress *intern(TariWalletAddress *pAddress, int *errorPointer) {
+        if (pAddress == nullptr) {
+            return nullptr;
+        }
+        std::string bytes = readBytes(pAddress, errorPointer);
+        if (*errorPointer != 0) {
+            tari_address_destroy(pAddress);
+            return nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        auto existing = byBytes.find(bytes);
+        if (existing != byBytes.end()) {
+            tari_address_destroy(pAddress);
+            entries[existing->second].references++;
+            return existing->second;
+        }
+
+        Entry entry;
+        entry.metadata = loadMetadata(pAddress, errorPointer);
+        if (*errorPointer != 0) {
+            tari_address_destroy(pAddress);
+            return nullptr;
+        }
+        entry.metadata.bytes = bytes;
+        entries[pAddress] = entry;
+        byBytes[bytes] = pAddress;
+        return pAddress;
+    }
+
+    /**
+     * Drops one reference of an address. Addresses that never went through the pool are destroyed directly.
+     */
+    void release(TariWalletAddress *pAddress) {
+        if (pAddress == nullptr) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto entry = entries.find(pAddress);
+            if (entry != entries.end()) {
+                if (--entry->second.references > 0) {
+                    return;
+                }
+                byBytes.erase(entry->second.metadata.bytes);
+                entries.erase(entry);
+            }
+        }
+        tari_address_destroy(pAddress);
+    }
+
+    /**
+     * Returns the metadata of an address, from the pool when interned, otherwise loaded from libwallet.
+     */
+    TariWalletAddressMetadata metadata(TariWalletAddress *pAddress, int *errorPointer) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto entry = entries.find(pAddress);
+            if (entry != entries.end()) {
+                return entry->second.metadata;
+            }
+        }
+        TariWalletAddressMetadata result = loadMetadata(pAddress, errorPointer);
+        if (*errorPointer == 0) {
+            result.bytes = readBytes(pAddress, errorPointer);
+        }
+        return result;
+    }
+
+    size_t size() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return entries.size();
+    }
+
+private:
+    struct Entry {
+        TariWalletAddressMetadata metadata;
+        long references = 1;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<TariWalletAddress *, Entry> entries;
+    std::unordered_map<std::string, TariWalletAddress *> byBytes;
+
+    static std::string readBytes(TariWalletAddress *pAddress, int *errorPointer) {
+        std::string result;
+        ByteVector *pBytes = tari_address_get_bytes(pAddress, errorPointer);
+        if (pBytes == nullptr || *errorPointer != 0) {
+            return result;
+        }
+        unsigned int length = byte_vector_get_length(pBytes, errorPointer);
+        result.reserve(length);
+        for (unsigned int i = 0; i < length && *errorPointer == 0; i++) {
+            result.push_back(static_cast<char>(byte_vector_get_at(pBytes, i, errorPointer)));
+        }
+        byte_vector_destroy(pBytes);
+        return result;
+    }
+
+    static TariWalletAddressMetadata loadMetadata(TariWalletAddress *pAddress, int *errorPointer) {
+        TariWalletAddressMetadata result;
+        result.network = tari_address_network_u8(pAddress, errorPointer);
+        if (*errorPointer != 0) return result;
+        result.features = tari_address_features_u8(pAddress, errorPointer);
+        if (*errorPointer != 0) return result;
+        result.checksum = tari_address_checksum_u8(pAddress, errorPointer);
+        if (*errorPointer != 0) return result;
+        char *pEmojiId = tari_address_to_emoji_id(pAddress, errorPointer);
+        if (*errorPointer != 0 || pEmojiId == nullptr) {
+            // an address without an emoji id must not be interned with an empty one
+            if (pEmojiId != nullptr) {
+                string_destroy(pEmojiId);
+            }
+            if (*errorPointer == 0) {
+                *errorPointer = NATIVE_ERROR_CHECK_FAILED;
+            }
+            return result;
+        }
+        result.emojiId = pEmojiId;
+        string_destroy(pEmojiId);
+        return result;
+    }
+};
+
+// function-local static so that every translation unit including this file shares one pool
+inline TariWalletAddressPool &GetTariWalletAddressPool() {
+    static TariWalletAddressPool pool;
+    return pool;
+}
+
+inline TariWalletAddress *InternTariWalletAddress(TariWalletAddress *pAddress, int *errorPointer) {
+    return GetTariWalletAddressPool().intern(pAddress, errorPointer);
+}
+
+inline void ReleaseTariWalletAddress(TariWalletAddress *pAddress) {
+    GetTariWalletAddressPool().release(pAddress);
+}
+
+#endif // JNI_TARI_WALLET_ADDRESS_POOL_CPP
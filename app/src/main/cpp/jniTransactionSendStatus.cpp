@@ -37,6 +37,7 @@
 #include <cmath>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "jniHandleTypes.cpp"
 
 extern "C"
 JNIEXPORT int JNICALL
@@ -45,6 +46,7 @@ Java_com_tari_android_wallet_ffi_FFITransactionSendStatus_jniTransactionSendStat
         jobject jThis,
         jobject error
 ) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<int>(jEnv, error, [&](int *errorPointer) {
         auto pTransactionSendStatus = GetPointerField<TariTransactionSendStatus *>(jEnv, jThis);
         return transaction_send_status_decode(pTransactionSendStatus, errorPointer);
@@ -56,6 +58,6 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFITransactionSendStatus_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
-    transaction_send_status_destroy(GetPointerField<TariTransactionSendStatus *>(jEnv, jThis));
-    SetNullPointerField(jEnv, jThis);
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_TRANSACTION_SEND_STATUS);
 }
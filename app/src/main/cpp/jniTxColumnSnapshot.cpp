@@ -0,0 +1,207 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <jni.h>
+#include <cstdint>
+#include <vector>
+#include "jniCommon.cpp"
+#include "jniHandleTypes.cpp"
+#include "txColumnSnapshot.cpp"
+
+/**
+ * Checks that the four total arrays hold count items each.
+ */
+bool HasTxTotalsCapacity(JNIEnv *jEnv, size_t count, jlongArray jSent, jlongArray jReceived, jlongArray jFees, jintArray jCounts) {
+    auto size = static_cast<jsize>(count);
+    return count <= static_cast<size_t>(INT32_MAX) && jEnv->GetArrayLength(jSent) >= size &&
+           jEnv->GetArrayLength(jReceived) >= size && jEnv->GetArrayLength(jFees) >= size && jEnv->GetArrayLength(jCounts) >= size;
+}
+
+void SetTxTotals(JNIEnv *jEnv, const std::vector<TxTotals> &totals, jlongArray jSent, jlongArray jReceived, jlongArray jFees,
+                 jintArray jCounts) {
+    auto size = static_cast<jsize>(totals.size());
+    std::vector<jlong> sent(totals.size()), received(totals.size()), fees(totals.size());
+    std::vector<jint> counts(totals.size());
+    for (size_t i = 0; i < totals.size(); i++) {
+        sent[i] = static_cast<jlong>(totals[i].sent);
+        received[i] = static_cast<jlong>(totals[i].received);
+        fees[i] = static_cast<jlong>(totals[i].fees);
+        counts[i] = static_cast<jint>(totals[i].count);
+    }
+    jEnv->SetLongArrayRegion(jSent, 0, size, sent.data());
+    jEnv->SetLongArrayRegion(jReceived, 0, size, received.data());
+    jEnv->SetLongArrayRegion(jFees, 0, size, fees.data());
+    jEnv->SetIntArrayRegion(jCounts, 0, size, counts.data());
+}
+
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_tari_android_wallet_ffi_FFITxColumnSnapshot_jniGetSize(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    return static_cast<jint>(GetPointerField<TxColumnSnapshot *>(jEnv, jThis)->size());
+}
+
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_tari_android_wallet_ffi_FFITxColumnSnapshot_jniGetCounterpartyCount(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    return static_cast<jint>(GetPointerField<TxColumnSnapshot *>(jEnv, jThis)->counterpartyCount());
+}
+
+/**
+ * @return the address bytes of a counterparty, null if the index is out of range
+ */
+extern "C"
+JNIEXPORT jbyteArray JNICALL
+Java_com_tari_android_wallet_ffi_FFITxColumnSnapshot_jniGetCounterparty(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jint index) {
+    JNI_ENTRY_POINT();
+    auto pSnapshot = GetPointerField<TxColumnSnapshot *>(jEnv, jThis);
+    if (index < 0 || static_cast<size_t>(index) >= pSnapshot->counterpartyCount()) {
+        return nullptr;
+    }
+    const std::vector<uint8_t> &bytes = pSnapshot->counterparty(static_cast<size_t>(index));
+    auto size = static_cast<jsize>(bytes.size());
+    jbyteArray result = jEnv->NewByteArray(size);
+    jEnv->SetByteArrayRegion(result, 0, size, reinterpret_cast<const jbyte *>(bytes.data()));
+    return result;
+}
+
+/**
+ * Sent, received, fees and tx count of every bucket of the range [from, to), the arrays must hold a bucket each.
+ *
+ * @return the number of buckets written, -1 with error 1 if the range, the bucket size or the arrays aren't valid
+ */
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_tari_android_wallet_ffi_FFITxColumnSnapshot_jniGetVolumes(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong jFrom,
+        jlong jTo,
+        jlong jBucketSize,
+        jlongArray jSent,
+        jlongArray jReceived,
+        jlongArray jFees,
+        jintArray jCounts,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) -> jint {
+        size_t buckets = TxColumnSnapshot::bucketCount(jFrom, jTo, jBucketSize);
+        if (jFrom < 0 || buckets == 0 || !HasTxTotalsCapacity(jEnv, buckets, jSent, jReceived, jFees, jCounts)) {
+            *errorPointer = 1;
+            return -1;
+        }
+        std::vector<TxTotals> totals(buckets);
+        GetPointerField<TxColumnSnapshot *>(jEnv, jThis)->volumes(jFrom, jTo, jBucketSize, totals.data());
+        SetTxTotals(jEnv, totals, jSent, jReceived, jFees, jCounts);
+        return static_cast<jint>(buckets);
+    });
+}
+
+/**
+ * The balance the completed txs add up to at the end of every bucket of the range [from, to), the array must hold a
+ * bucket each.
+ *
+ * @return the number of buckets written, -1 with error 1 if the range, the bucket size or the array isn't valid
+ */
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_tari_android_wallet_ffi_FFITxColumnSnapshot_jniGetRunningBalances(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong jFrom,
+        jlong jTo,
+        jlong jBucketSize,
+        jlongArray jBalances,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) -> jint {
+        size_t buckets = TxColumnSnapshot::bucketCount(jFrom, jTo, jBucketSize);
+        if (jFrom < 0 || buckets == 0 || buckets > static_cast<size_t>(jEnv->GetArrayLength(jBalances))) {
+            *errorPointer = 1;
+            return -1;
+        }
+        std::vector<int64_t> balances(buckets);
+        GetPointerField<TxColumnSnapshot *>(jEnv, jThis)->runningBalances(jFrom, jTo, jBucketSize, balances.data());
+        jEnv->SetLongArrayRegion(jBalances, 0, static_cast<jsize>(buckets), reinterpret_cast<const jlong *>(balances.data()));
+        return static_cast<jint>(buckets);
+    });
+}
+
+/**
+ * Sent, received, fees and tx count of every counterparty over the range [from, to), in the order of
+ * jniGetCounterparty. The arrays must hold a counterparty each.
+ *
+ * @return the number of counterparties written, -1 with error 1 if the range or the arrays aren't valid
+ */
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_tari_android_wallet_ffi_FFITxColumnSnapshot_jniGetCounterpartyTotals(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong jFrom,
+        jlong jTo,
+        jlongArray jSent,
+        jlongArray jReceived,
+        jlongArray jFees,
+        jintArray jCounts,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) -> jint {
+        auto pSnapshot = GetPointerField<TxColumnSnapshot *>(jEnv, jThis);
+        size_t count = pSnapshot->counterpartyCount();
+        if (jFrom < 0 || jTo < jFrom || !HasTxTotalsCapacity(jEnv, count, jSent, jReceived, jFees, jCounts)) {
+            *errorPointer = 1;
+            return -1;
+        }
+        std::vector<TxTotals> totals(count);
+        pSnapshot->counterpartyTotals(jFrom, jTo, totals.data());
+        SetTxTotals(jEnv, totals, jSent, jReceived, jFees, jCounts);
+        return static_cast<jint>(count);
+    });
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_tari_android_wallet_ffi_FFITxColumnSnapshot_jniDestroy(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    DestroyHandle(jEnv, jThis, HANDLE_TYPE_TX_COLUMN_SNAPSHOT);
+}
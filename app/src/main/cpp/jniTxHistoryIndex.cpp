@@ -0,0 +1,248 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <jni.h>
+#include <android/log.h>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+#include "jniCommon.cpp"
+#include "txHistoryIndex.cpp"
+
+inline std::string GetTxHistoryIndexPath(const std::string &datastorePath) {
+    return datastorePath + "/" + TX_HISTORY_INDEX_FILE_NAME;
+}
+
+/**
+ * Reads the filter, counterparty and search text of a query, the counterparty and text may be null.
+ *
+ * @return false if the filter doesn't have TX_HISTORY_FILTER_FIELD_COUNT fields
+ */
+bool ReadTxHistoryQuery(JNIEnv *jEnv, jlongArray jFilter, jbyteArray jCounterparty, jstring jText, TxHistoryQuery &query) {
+    if (jEnv->GetArrayLength(jFilter) != static_cast<jsize>(TX_HISTORY_FILTER_FIELD_COUNT)) {
+        return false;
+    }
+    jEnv->GetLongArrayRegion(jFilter, 0, TX_HISTORY_FILTER_FIELD_COUNT, reinterpret_cast<jlong *>(query.filter));
+    if (jCounterparty != nullptr) {
+        query.counterparty.resize(static_cast<size_t>(jEnv->GetArrayLength(jCounterparty)));
+        jEnv->GetByteArrayRegion(jCounterparty, 0, static_cast<jsize>(query.counterparty.size()),
+                                 reinterpret_cast<jbyte *>(query.counterparty.data()));
+    }
+    if (jText != nullptr) {
+        query.text = GetStdString(jEnv, jText);
+    }
+    return true;
+}
+
+/**
+ * A query can't return more rows than the out arrays hold, a limit above it or no limit is cut to their size.
+ */
+void LimitTxHistoryQuery(TxHistoryQuery &query, jsize capacity) {
+    int64_t &limit = query.filter[TX_HISTORY_FILTER_LIMIT];
+    limit = limit < 0 ? capacity : std::min<int64_t>(limit, capacity);
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_tari_android_wallet_ffi_FFITxHistoryIndex_jniOpen(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jDatastorePath) {
+    JNI_ENTRY_POINT();
+    TxHistoryIndex &index = GetTxHistoryIndex();
+    if (!index.open(GetTxHistoryIndexPath(GetStdString(jEnv, jDatastorePath)))) {
+        LOGE("Tx history index not opened: %s", index.lastError().c_str());
+        return JNI_FALSE;
+    }
+    return JNI_TRUE;
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_tari_android_wallet_ffi_FFITxHistoryIndex_jniClose(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    GetTxHistoryIndex().close();
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_tari_android_wallet_ffi_FFITxHistoryIndex_jniClear(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    return GetTxHistoryIndex().clear() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * Replaces the contact aliases the search text matches, jAddresses holds the address bytes of each alias.
+ */
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_tari_android_wallet_ffi_FFITxHistoryIndex_jniSetAliases(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobjectArray jAddresses,
+        jobjectArray jAliases,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) -> jboolean {
+        jsize length = jEnv->GetArrayLength(jAddresses);
+        if (jEnv->GetArrayLength(jAliases) != length) {
+            *errorPointer = 1;
+            return JNI_FALSE;
+        }
+        std::vector<std::pair<std::vector<uint8_t>, std::string>> aliases(static_cast<size_t>(length));
+        for (jsize i = 0; i < length; i++) {
+            auto jAddress = static_cast<jbyteArray>(jEnv->GetObjectArrayElement(jAddresses, i));
+            auto jAlias = static_cast<jstring>(jEnv->GetObjectArrayElement(jAliases, i));
+            std::vector<uint8_t> &address = aliases[i].first;
+            address.resize(static_cast<size_t>(jEnv->GetArrayLength(jAddress)));
+            jEnv->GetByteArrayRegion(jAddress, 0, static_cast<jsize>(address.size()), reinterpret_cast<jbyte *>(address.data()));
+            aliases[i].second = GetStdString(jEnv, jAlias);
+            jEnv->DeleteLocalRef(jAddress);
+            jEnv->DeleteLocalRef(jAlias);
+        }
+        TxHistoryIndex &index = GetTxHistoryIndex();
+        if (!index.setAliases(aliases)) {
+            LOGE("Tx history aliases not written: %s", index.lastError().c_str());
+            return JNI_FALSE;
+        }
+        return JNI_TRUE;
+    });
+}
+
+/**
+ * Writes the ids of the matching txs to jIds, as many as it holds.
+ *
+ * @return the number of ids written, -1 if the query failed, with error 1 if the filter isn't valid
+ */
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_tari_android_wallet_ffi_FFITxHistoryIndex_jniQueryIds(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlongArray jFilter,
+        jbyteArray jCounterparty,
+        jstring jText,
+        jlongArray jIds,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) -> jint {
+        TxHistoryQuery query;
+        if (!ReadTxHistoryQuery(jEnv, jFilter, jCounterparty, jText, query)) {
+            *errorPointer = 1;
+            return -1;
+        }
+        LimitTxHistoryQuery(query, jEnv->GetArrayLength(jIds));
+        TxHistoryColumns columns;
+        if (!GetTxHistoryIndex().query(query, false, columns)) {
+            return -1;
+        }
+        auto count = static_cast<jsize>(columns.ids.size());
+        jEnv->SetLongArrayRegion(jIds, 0, count, reinterpret_cast<const jlong *>(columns.ids.data()));
+        return count;
+    });
+}
+
+/**
+ * Writes the columns of the matching txs to the arrays, which must all have the same size. The flags hold the kind
+ * of the tx and TX_HISTORY_FLAG_OUTBOUND.
+ *
+ * @return the number of txs written, -1 if the query failed, with error 1 if the filter or the arrays aren't valid
+ */
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_tari_android_wallet_ffi_FFITxHistoryIndex_jniQueryColumns(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlongArray jFilter,
+        jbyteArray jCounterparty,
+        jstring jText,
+        jlongArray jIds,
+        jlongArray jAmounts,
+        jlongArray jFees,
+        jlongArray jTimestamps,
+        jintArray jStatuses,
+        jbyteArray jFlags,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) -> jint {
+        TxHistoryQuery query;
+        jsize capacity = jEnv->GetArrayLength(jIds);
+        if (!ReadTxHistoryQuery(jEnv, jFilter, jCounterparty, jText, query) ||
+            jEnv->GetArrayLength(jAmounts) != capacity || jEnv->GetArrayLength(jFees) != capacity ||
+            jEnv->GetArrayLength(jTimestamps) != capacity || jEnv->GetArrayLength(jStatuses) != capacity ||
+            jEnv->GetArrayLength(jFlags) != capacity) {
+            *errorPointer = 1;
+            return -1;
+        }
+        LimitTxHistoryQuery(query, capacity);
+        TxHistoryColumns columns;
+        if (!GetTxHistoryIndex().query(query, true, columns)) {
+            return -1;
+        }
+        auto count = static_cast<jsize>(columns.ids.size());
+        jEnv->SetLongArrayRegion(jIds, 0, count, reinterpret_cast<const jlong *>(columns.ids.data()));
+        jEnv->SetLongArrayRegion(jAmounts, 0, count, reinterpret_cast<const jlong *>(columns.amounts.data()));
+        jEnv->SetLongArrayRegion(jFees, 0, count, reinterpret_cast<const jlong *>(columns.fees.data()));
+        jEnv->SetLongArrayRegion(jTimestamps, 0, count, reinterpret_cast<const jlong *>(columns.timestamps.data()));
+        jEnv->SetIntArrayRegion(jStatuses, 0, count, columns.statuses.data());
+        jEnv->SetByteArrayRegion(jFlags, 0, count, columns.flags.data());
+        return count;
+    });
+}
+
+/**
+ * @return the number of txs the query matches regardless of its limit and offset, -1 if it failed
+ */
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFITxHistoryIndex_jniCount(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlongArray jFilter,
+        jbyteArray jCounterparty,
+        jstring jText,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
+        TxHistoryQuery query;
+        if (!ReadTxHistoryQuery(jEnv, jFilter, jCounterparty, jText, query)) {
+            *errorPointer = 1;
+            return -1;
+        }
+        return static_cast<jlong>(GetTxHistoryIndex().count(query));
+    });
+}
@@ -0,0 +1,83 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <jni.h>
+#include <android/log.h>
+#include <wallet.h>
+#include <vector>
+#include "jniCommon.cpp"
+#include "txLifecycleTracker.cpp"
+
+/**
+ * Everything in one array: the stage count and the tx count, then per tx its id, the wall clock millis it was sent at
+ * and the nanos from sending to each stage (-1 if not reached), then the call stats values of the transition into
+ * every stage after the send.
+ */
+extern "C"
+JNIEXPORT jlongArray JNICALL
+Java_com_tari_android_wallet_ffi_FFITxLifecycle_jniGetSnapshot(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    std::vector<TxLifecycle> lifecycles;
+    std::vector<int64_t> transitionValues;
+    GetTxLifecycleTracker().snapshot(lifecycles, transitionValues);
+
+    std::vector<jlong> values;
+    values.reserve(2 + lifecycles.size() * (2 + TX_STAGE_COUNT) + transitionValues.size());
+    values.push_back(TX_STAGE_COUNT);
+    values.push_back(static_cast<jlong>(lifecycles.size()));
+    for (const TxLifecycle &lifecycle : lifecycles) {
+        int64_t sentNanos = lifecycle.stageNanos[TX_STAGE_SENT];
+        values.push_back(static_cast<jlong>(lifecycle.txId));
+        values.push_back(lifecycle.sentAtMillis);
+        for (int64_t stageNanos : lifecycle.stageNanos) {
+            values.push_back(stageNanos < 0 ? -1 : std::max<int64_t>(0, stageNanos - sentNanos));
+        }
+    }
+    values.insert(values.end(), transitionValues.begin(), transitionValues.end());
+
+    auto length = static_cast<jsize>(values.size());
+    jlongArray result = jEnv->NewLongArray(length);
+    jEnv->SetLongArrayRegion(result, 0, length, values.data());
+    return result;
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_tari_android_wallet_ffi_FFITxLifecycle_jniClear(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    GetTxLifecycleTracker().clear();
+}
@@ -35,9 +35,35 @@
 #include <android/log.h>
 #include <wallet.h>
 #include <string>
+#include <vector>
+#include <algorithm>
 #include <cmath>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <thread>
+#include <unordered_map>
 #include <android/log.h>
 #include "jniCommon.cpp"
+#include "warmStartSnapshot.cpp"
+#include "workerPool.cpp"
+#include "callbackGate.cpp"
+#include "callbackDispatcher.cpp"
+#include "callbackSubscriptions.cpp"
+#include "txLifecycleTracker.cpp"
+#include "confirmationTracker.cpp"
+#include "callbackDedup.cpp"
+#include "batchSendTracker.cpp"
+#include "walletJobTracker.cpp"
+#include "txHistoryIndex.cpp"
+#include "txColumnSnapshot.cpp"
+#include "txHistoryExporter.cpp"
+#include "tariAddressCodec.cpp"
+#include "jniHandleTypes.cpp"
 
 /**
  * Java virtual machine pointer for later use in callbacks.
@@ -65,6 +91,7 @@ JNIEnv *getJNIEnv() {
             if (g_vm->AttachCurrentThread(&jniEnv, nullptr) != 0) {
                 LOGE("VM failed to attach.");
             } else {
+                g_callbackAttachCount.fetch_add(1, std::memory_order_relaxed);
                 result = jniEnv;
             }
             break;
@@ -100,213 +127,782 @@ jmethodID recoveringProcessCompleteCallbackMethodId;
 jmethodID balanceUpdatedCallbackMethodId;
 jmethodID walletScannedHeightCallbackMethodId;
 jmethodID baseNodeStatusCallbackMethodId;
+jmethodID walletCreateProgressCallbackMethodId;
+jmethodID jobCompletedCallbackMethodId;
+jmethodID confirmationsChangedCallbackMethodId;
+jmethodID batchSendCompletedCallbackMethodId;
 
-void txBroadcastCallback(void *context, TariCompletedTransaction *pCompletedTransaction) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+/**
+ * Context of the wallet the callbacks belong to, needed for the completions of pool jobs.
+ */
+void *g_walletContext = nullptr;
+
+/**
+ * Guards callbackHandler and the method ids above: they're only written by jniCreate while the gate is released,
+ * and read by the callbacks while they hold a reference.
+ */
+CallbackGate g_callbackGate;
+
+/**
+ * The FFIWallet that opened the gate, as a weak ref. Only one wallet at a time gets the callbacks, jniCreate refuses
+ * a second one and only the owner closes the gate when it's destroyed.
+ */
+jweak g_callbackGateOwner = nullptr;
+std::mutex g_callbackGateOwnerMutex;
+
+// generation of a gate left open by a creation that couldn't report its failure, closed by the next jniCreate
+uint64_t g_abandonedGateGeneration = 0;
+
+void deleteCallbackHandler(JNIEnv *jniEnv, jobject handler) {
+    if (jniEnv != nullptr) {
+        jniEnv->DeleteGlobalRef(handler);
+        return;
+    }
+    // the last reference was dropped on a thread that never got to attach
+    if (g_vm->AttachCurrentThread(&jniEnv, nullptr) == 0) {
+        jniEnv->DeleteGlobalRef(handler);
+        g_vm->DetachCurrentThread();
+    }
+}
+
+/**
+ * Call with g_callbackGateOwnerMutex held. New callbacks are dropped from here on, the ones in flight finish and the
+ * last of them deletes the handler.
+ */
+void closeCallbackGateLocked(JNIEnv *jniEnv) {
+    if (g_callbackGateOwner != nullptr) {
+        jniEnv->DeleteWeakGlobalRef(g_callbackGateOwner);
+        g_callbackGateOwner = nullptr;
+    }
+    if (g_callbackGate.close()) {
+        jniEnv->DeleteGlobalRef(callbackHandler);
+    }
+}
+
+/**
+ * Closes the gate opened for a wallet that won't be created, unless another wallet opened it since.
+ */
+void releaseCallbackGate(JNIEnv *jniEnv, uint64_t generation) {
+    std::lock_guard<std::mutex> lock(g_callbackGateOwnerMutex);
+    if (g_callbackGate.isOpen() && g_callbackGate.generation() == generation) {
+        closeCallbackGateLocked(jniEnv);
+    }
+}
+
+/**
+ * Reference to the callback handler for the duration of a callback. Release it with the callback's JNIEnv
+ * before detaching, the destructor only covers the early returns.
+ */
+class CallbackHandlerScope {
+public:
+    CallbackHandlerScope() : entered_(g_callbackGate.tryEnter()), handler_(entered_ ? callbackHandler : nullptr) {}
+
+    CallbackHandlerScope(const CallbackHandlerScope &) = delete;
+    CallbackHandlerScope &operator=(const CallbackHandlerScope &) = delete;
+
+    ~CallbackHandlerScope() {
+        release(nullptr);
+    }
+
+    explicit operator bool() const {
+        return entered_;
+    }
+
+    jobject handler() const {
+        return handler_;
+    }
+
+    void release(JNIEnv *jniEnv) {
+        if (!entered_) {
+            return;
+        }
+        entered_ = false;
+        if (g_callbackGate.leave()) {
+            deleteCallbackHandler(jniEnv, handler_);
+        }
+    }
+
+private:
+    bool entered_;
+    jobject handler_;
+};
+
+CallbackDispatcher &getCallbackDispatcher() {
+    // the delivery thread stays attached to the VM until it exits
+    static CallbackDispatcher dispatcher([] { g_vm->DetachCurrentThread(); });
+    return dispatcher;
+}
+
+/**
+ * Queues a libwallet callback into the lane of its type. The delivery runs on the dispatcher thread
+ * with a reference to the callback handler. If the wallet was destroyed in the meantime, even if another one was
+ * created since, the thread has no JNIEnv or the lane overflowed, the delivery is dropped and drop frees the
+ * libwallet objects it would have handed over.
+ */
+template <typename F, typename D>
+void postCallback(int callbackType, F &&deliver, D &&drop) {
+    std::function<void()> dropDelivery = std::forward<D>(drop);
+    uint64_t generation = g_callbackGate.generation();
+    getCallbackDispatcher().post(callbackType, [deliver = std::forward<F>(deliver), dropDelivery, generation]() {
+        CallbackHandlerScope handlerScope;
+        if (!handlerScope) {
+            dropDelivery();
+            return;
+        }
+        JNIEnv *jniEnv = getJNIEnv();
+        if (generation != g_callbackGate.generation()) {
+            // queued for a wallet destroyed since, the handler belongs to the next one
+            g_callbackGate.countDropped();
+            dropDelivery();
+            handlerScope.release(jniEnv);
+            return;
+        }
+        if (jniEnv == nullptr || jniEnv->PushLocalFrame(8) != 0) {
+            g_callbackDroppedCount.fetch_add(1, std::memory_order_relaxed);
+            dropDelivery();
+            return;
+        }
+        deliver(jniEnv, handlerScope.handler());
+        if (jniEnv->ExceptionCheck()) {
+            // a listener threw, the next delivery must not run with the exception pending
+            LOGE("Exception thrown by a wallet callback");
+            jniEnv->ExceptionClear();
+        }
+        jniEnv->PopLocalFrame(nullptr);
+        handlerScope.release(jniEnv);
+    }, dropDelivery);
+}
+
+/**
+ * For the callbacks that hand over no libwallet object.
+ */
+template <typename F>
+void postCallback(int callbackType, F &&deliver) {
+    postCallback(callbackType, std::forward<F>(deliver), [] {});
+}
+
+/**
+ * Timestamps a stage of a sent tx, txs that weren't sent by the wallet are ignored.
+ */
+void trackTxStage(int stage, TariCompletedTransaction *pCompletedTransaction) {
+    TxLifecycleTracker &tracker = GetTxLifecycleTracker();
+    if (!tracker.isTracking()) {
+        return;
+    }
+    int errorCode = 0;
+    uint64_t txId = completed_transaction_get_transaction_id(pCompletedTransaction, &errorCode);
+    if (errorCode == 0) {
+        tracker.record(txId, stage, TxLifecycleTracker::nowNanos());
+    }
+}
+
+/**
+ * Keeps the mined height of a tx that still needs confirmations, the count is then updated natively on every new tip.
+ */
+void trackConfirmations(TariCompletedTransaction *pCompletedTransaction, uint64_t confirmationCount) {
+    int errorCode = 0;
+    uint64_t txId = completed_transaction_get_transaction_id(pCompletedTransaction, &errorCode);
+    if (errorCode != 0) {
+        return;
+    }
+    uint64_t minedHeight = completed_transaction_get_mined_height(pCompletedTransaction, &errorCode);
+    if (errorCode == 0) {
+        GetConfirmationTracker().track(txId, minedHeight, confirmationCount);
+    }
+}
+
+void forgetConfirmations(TariCompletedTransaction *pCompletedTransaction) {
+    ConfirmationTracker &tracker = GetConfirmationTracker();
+    if (!tracker.isTracking()) {
+        return;
+    }
+    int errorCode = 0;
+    uint64_t txId = completed_transaction_get_transaction_id(pCompletedTransaction, &errorCode);
+    if (errorCode == 0) {
+        tracker.forget(txId);
+    }
+}
+
+WorkerPool &GetWalletWorkerPool();
+
+/**
+ * Takes a string returned by libwallet, null reads as empty.
+ */
+std::string TakeWalletString(char *pString) {
+    std::string string = pString != nullptr ? pString : "";
+    string_destroy(pString);
+    return string;
+}
+
+/**
+ * Takes an address returned by libwallet and gives back its bytes, none if there's no address.
+ */
+std::vector<uint8_t> TakeAddressBytes(TariWalletAddress *pAddress, int *errorPointer) {
+    std::vector<uint8_t> bytes;
+    if (pAddress == nullptr) {
+        return bytes;
+    }
+    ByteVector *pBytes = tari_address_get_bytes(pAddress, errorPointer);
+    if (pBytes != nullptr) {
+        bytes = GetByteVectorBytes(pBytes, errorPointer);
+        byte_vector_destroy(pBytes);
+    }
+    tari_address_destroy(pAddress);
+    return bytes;
+}
+
+bool ReadTxHistoryRow(TariCompletedTransaction *pTx, int kind, TxHistoryRow &row, int *errorPointer) {
+    row.id = completed_transaction_get_transaction_id(pTx, errorPointer);
+    row.kind = kind;
+    row.status = completed_transaction_get_status(pTx, errorPointer);
+    row.isOutbound = completed_transaction_is_outbound(pTx, errorPointer);
+    row.amount = completed_transaction_get_amount(pTx, errorPointer);
+    row.fee = completed_transaction_get_fee(pTx, errorPointer);
+    row.timestamp = completed_transaction_get_timestamp(pTx, errorPointer);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    row.counterparty = TakeAddressBytes(row.isOutbound
+                                        ? completed_transaction_get_destination_tari_address(pTx, errorPointer)
+                                        : completed_transaction_get_source_tari_address(pTx, errorPointer), errorPointer);
+    // a tx without a payment id is still searchable by alias
+    int paymentIdError = 0;
+    row.paymentId = TakeWalletString(completed_transaction_get_user_payment_id(pTx, &paymentIdError));
+    return *errorPointer == 0;
+}
+
+bool ReadTxHistoryRow(TariPendingInboundTransaction *pTx, TxHistoryRow &row, int *errorPointer) {
+    row.id = pending_inbound_transaction_get_transaction_id(pTx, errorPointer);
+    row.kind = TX_HISTORY_KIND_PENDING_INBOUND;
+    row.status = pending_inbound_transaction_get_status(pTx, errorPointer);
+    row.isOutbound = false;
+    row.amount = pending_inbound_transaction_get_amount(pTx, errorPointer);
+    row.fee = 0;
+    row.timestamp = pending_inbound_transaction_get_timestamp(pTx, errorPointer);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    row.counterparty = TakeAddressBytes(pending_inbound_transaction_get_source_tari_address(pTx, errorPointer), errorPointer);
+    int paymentIdError = 0;
+    row.paymentId = TakeWalletString(pending_inbound_transaction_get_payment_id(pTx, &paymentIdError));
+    return *errorPointer == 0;
+}
+
+bool ReadTxHistoryRow(TariPendingOutboundTransaction *pTx, TxHistoryRow &row, int *errorPointer) {
+    row.id = pending_outbound_transaction_get_transaction_id(pTx, errorPointer);
+    row.kind = TX_HISTORY_KIND_PENDING_OUTBOUND;
+    row.status = pending_outbound_transaction_get_status(pTx, errorPointer);
+    row.isOutbound = true;
+    row.amount = pending_outbound_transaction_get_amount(pTx, errorPointer);
+    row.fee = pending_outbound_transaction_get_fee(pTx, errorPointer);
+    row.timestamp = pending_outbound_transaction_get_timestamp(pTx, errorPointer);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    row.counterparty = TakeAddressBytes(pending_outbound_transaction_get_destination_tari_address(pTx, errorPointer), errorPointer);
+    int paymentIdError = 0;
+    row.paymentId = TakeWalletString(pending_outbound_transaction_get_payment_id(pTx, &paymentIdError));
+    return *errorPointer == 0;
+}
+
+/**
+ * Queues the row of a tx for the history index, the first row since the last flush schedules one on the wallet pool.
+ */
+template <typename T, typename... A>
+void indexTx(T *pTx, A... args) {
+    TxHistoryIndex &index = GetTxHistoryIndex();
+    if (!index.isOpen()) {
+        return;
+    }
+    TxHistoryRow row;
+    int errorCode = 0;
+    if (!ReadTxHistoryRow(pTx, args..., row, &errorCode)) {
+        return;
+    }
+    if (index.enqueue(std::move(row)) && GetWalletWorkerPool().submit([](uint64_t) { GetTxHistoryIndex().flush(); }) == 0) {
+        // the pool is full, the flush can't wait for it
+        index.flush();
+    }
+}
+
+/**
+ * Sent txs get no tx callback until the recipient replies, or at all if they're one-sided, so they're indexed on send.
+ */
+void indexSentTx(TariWallet *pWallet, uint64_t txId) {
+    if (!GetTxHistoryIndex().isOpen()) {
+        return;
+    }
+    int errorCode = 0;
+    TariPendingOutboundTransaction *pPendingTx = wallet_get_pending_outbound_transaction_by_id(pWallet, txId, 0, &errorCode);
+    if (pPendingTx != nullptr) {
+        indexTx(pPendingTx);
+        pending_outbound_transaction_destroy(pPendingTx);
+        return;
+    }
+    errorCode = 0;
+    TariCompletedTransaction *pCompletedTx = wallet_get_completed_transaction_by_id(pWallet, txId, &errorCode);
+    if (pCompletedTx != nullptr) {
+        indexTx(pCompletedTx, TX_HISTORY_KIND_COMPLETED);
+        completed_transaction_destroy(pCompletedTx);
+    }
+}
+
+/**
+ * Callbacks Kotlin didn't subscribe to are dropped before they cross into Java, the caller destroys their payload.
+ */
+bool isSubscribed(int callbackType) {
+    CallbackSubscriptions &subscriptions = GetCallbackSubscriptions();
+    if (subscriptions.wants(callbackType)) {
+        return true;
+    }
+    subscriptions.recordFiltered();
+    return false;
+}
+
+template <typename GetTxId>
+bool isSubscribed(int callbackType, GetTxId &&getTxId) {
+    CallbackSubscriptions &subscriptions = GetCallbackSubscriptions();
+    if (subscriptions.wants(callbackType) && (!subscriptions.filtersTxIds(callbackType) || subscriptions.containsTxId(getTxId()))) {
+        return true;
+    }
+    subscriptions.recordFiltered();
+    return false;
+}
+
+bool isSubscribed(int callbackType, TariCompletedTransaction *pCompletedTransaction) {
+    return isSubscribed(callbackType, [pCompletedTransaction] {
+        int errorCode = 0;
+        return completed_transaction_get_transaction_id(pCompletedTransaction, &errorCode);
+    });
+}
+
+bool isSubscribed(int callbackType, TariPendingInboundTransaction *pPendingInboundTransaction) {
+    return isSubscribed(callbackType, [pPendingInboundTransaction] {
+        int errorCode = 0;
+        return pending_inbound_transaction_get_transaction_id(pPendingInboundTransaction, &errorCode);
+    });
+}
+
+/**
+ * Drops a tx callback that repeats the state last delivered for the tx, e.g. a rebroadcast or a revalidation.
+ */
+bool isNewTxState(int callbackType, TariCompletedTransaction *pCompletedTransaction, uint64_t detail = 0) {
+    CallbackDedup &dedup = GetCallbackDedup();
+    if (!dedup.isEnabled()) {
+        return true;
+    }
+    int errorCode = 0;
+    uint64_t txId = completed_transaction_get_transaction_id(pCompletedTransaction, &errorCode);
+    return errorCode != 0 || dedup.isNewState(txId, callbackType, detail);
+}
+
+bool isNewTxState(int callbackType, TariPendingInboundTransaction *pPendingInboundTransaction) {
+    CallbackDedup &dedup = GetCallbackDedup();
+    if (!dedup.isEnabled()) {
+        return true;
+    }
+    int errorCode = 0;
+    uint64_t txId = pending_inbound_transaction_get_transaction_id(pPendingInboundTransaction, &errorCode);
+    return errorCode != 0 || dedup.isNewState(txId, callbackType, 0);
+}
+
+/**
+ * Drop function of a tx callback let through by isNewTxState: a delivery that never reached Java must not suppress
+ * its repeats, so its state is taken back before the tx is destroyed.
+ */
+void dropTxCallback(int callbackType, TariCompletedTransaction *pCompletedTransaction, uint64_t detail = 0) {
+    CallbackDedup &dedup = GetCallbackDedup();
+    if (dedup.isEnabled()) {
+        int errorCode = 0;
+        uint64_t txId = completed_transaction_get_transaction_id(pCompletedTransaction, &errorCode);
+        if (errorCode == 0) {
+            dedup.forget(txId, callbackType, detail);
+        }
+    }
+    completed_transaction_destroy(pCompletedTransaction);
+}
+
+void dropTxCallback(int callbackType, TariPendingInboundTransaction *pPendingInboundTransaction) {
+    CallbackDedup &dedup = GetCallbackDedup();
+    if (dedup.isEnabled()) {
+        int errorCode = 0;
+        uint64_t txId = pending_inbound_transaction_get_transaction_id(pPendingInboundTransaction, &errorCode);
+        if (errorCode == 0) {
+            dedup.forget(txId, callbackType, 0);
+        }
+    }
+    pending_inbound_transaction_destroy(pPendingInboundTransaction);
+}
+
+/**
+ * Stages reported through the progress callback while the wallet is created asynchronously.
+ * wallet_create opens the datastore, runs the migrations and starts comms in one call, so those are a single stage.
+ */
+const jint WALLET_CREATE_STAGE_CONFIG_PARSED = 0;
+const jint WALLET_CREATE_STAGE_WALLET_CREATED = 1;
+const jint WALLET_CREATE_STAGE_BASE_NODE_CONTACTED = 2;
+const jint WALLET_CREATE_STAGE_FAILED = 3;
+const jint WALLET_CREATE_STAGE_CANCELLED = 4;
+
+/**
+ * Set once an async creation has finished, the first base node status afterwards is reported as the last stage.
+ */
+std::atomic<bool> g_awaitingBaseNodeContact(false);
+
+void callWalletCreateProgress(JNIEnv *jniEnv, jobject handler, void *context, jint stage, jint errorCode) {
+    if (walletCreateProgressCallbackMethodId == nullptr) {
         return;
     }
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
     jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, txBroadcastCallbackMethodId, contextBytes, jpCompletedTransaction);
-    g_vm->DetachCurrentThread();
+    jniEnv->CallVoidMethod(handler, walletCreateProgressCallbackMethodId, contextBytes, stage, errorCode);
+    jniEnv->DeleteLocalRef(contextBytes);
+}
+
+/**
+ * @param generation of the gate opened for the wallet, the progress of a wallet cancelled or destroyed since is dropped
+ */
+void postWalletCreateProgress(JNIEnv *jniEnv, void *context, jint stage, jint errorCode, uint64_t generation) {
+    CallbackHandlerScope handlerScope;
+    if (handlerScope && generation == g_callbackGate.generation()) {
+        callWalletCreateProgress(jniEnv, handlerScope.handler(), context, stage, errorCode);
+    }
+    handlerScope.release(jniEnv);
+}
+
+void txBroadcastCallback(void *context, TariCompletedTransaction *pCompletedTransaction) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    indexTx(pCompletedTransaction, TX_HISTORY_KIND_COMPLETED);
+    trackTxStage(TX_STAGE_BROADCAST, pCompletedTransaction);
+    if (!isSubscribed(CALLBACK_TYPE_TX_BROADCAST, pCompletedTransaction) ||
+        !isNewTxState(CALLBACK_TYPE_TX_BROADCAST, pCompletedTransaction)) {
+        completed_transaction_destroy(pCompletedTransaction);
+        return;
+    }
+    postCallback(CALLBACK_TYPE_TX_BROADCAST, [=](JNIEnv *jniEnv, jobject handler) {
+        auto jpCompletedTransaction = NewHandle(HANDLE_TYPE_COMPLETED_TX, pCompletedTransaction);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, txBroadcastCallbackMethodId, contextBytes, jpCompletedTransaction);
+    }, [=] { dropTxCallback(CALLBACK_TYPE_TX_BROADCAST, pCompletedTransaction); });
 }
 
 void txMinedCallback(void *context, TariCompletedTransaction *pCompletedTransaction) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    indexTx(pCompletedTransaction, TX_HISTORY_KIND_COMPLETED);
+    trackTxStage(TX_STAGE_MINED, pCompletedTransaction);
+    forgetConfirmations(pCompletedTransaction);
+    if (!isSubscribed(CALLBACK_TYPE_TX_MINED, pCompletedTransaction) ||
+        !isNewTxState(CALLBACK_TYPE_TX_MINED, pCompletedTransaction)) {
+        completed_transaction_destroy(pCompletedTransaction);
         return;
     }
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, txMinedCallbackMethodId, contextBytes, jpCompletedTransaction);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_TX_MINED, [=](JNIEnv *jniEnv, jobject handler) {
+        auto jpCompletedTransaction = NewHandle(HANDLE_TYPE_COMPLETED_TX, pCompletedTransaction);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, txMinedCallbackMethodId, contextBytes, jpCompletedTransaction);
+    }, [=] { dropTxCallback(CALLBACK_TYPE_TX_MINED, pCompletedTransaction); });
 }
 
 void txMinedUnconfirmedCallback(void *context, TariCompletedTransaction *pCompletedTransaction, uint64_t confirmationCount) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    indexTx(pCompletedTransaction, TX_HISTORY_KIND_COMPLETED);
+    trackTxStage(TX_STAGE_MINED_UNCONFIRMED, pCompletedTransaction);
+    trackConfirmations(pCompletedTransaction, confirmationCount);
+    if (!isSubscribed(CALLBACK_TYPE_TX_MINED_UNCONFIRMED, pCompletedTransaction) ||
+        !isNewTxState(CALLBACK_TYPE_TX_MINED_UNCONFIRMED, pCompletedTransaction, confirmationCount)) {
+        completed_transaction_destroy(pCompletedTransaction);
         return;
     }
-    jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, confirmationCount);
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, txMinedUnconfirmedCallbackMethodId, contextBytes, jpCompletedTransaction, bytes);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_TX_MINED_UNCONFIRMED, [=](JNIEnv *jniEnv, jobject handler) {
+        jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, confirmationCount);
+        auto jpCompletedTransaction = NewHandle(HANDLE_TYPE_COMPLETED_TX, pCompletedTransaction);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, txMinedUnconfirmedCallbackMethodId, contextBytes, jpCompletedTransaction, bytes);
+    }, [=] { dropTxCallback(CALLBACK_TYPE_TX_MINED_UNCONFIRMED, pCompletedTransaction, confirmationCount); });
 }
 
 void txFauxConfirmedCallback(void *context, TariCompletedTransaction *pCompletedTransaction) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    indexTx(pCompletedTransaction, TX_HISTORY_KIND_COMPLETED);
+    forgetConfirmations(pCompletedTransaction);
+    if (!isSubscribed(CALLBACK_TYPE_TX_FAUX_CONFIRMED, pCompletedTransaction) ||
+        !isNewTxState(CALLBACK_TYPE_TX_FAUX_CONFIRMED, pCompletedTransaction)) {
+        completed_transaction_destroy(pCompletedTransaction);
         return;
     }
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, txFauxConfirmedCallbackMethodId, contextBytes, jpCompletedTransaction);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_TX_FAUX_CONFIRMED, [=](JNIEnv *jniEnv, jobject handler) {
+        auto jpCompletedTransaction = NewHandle(HANDLE_TYPE_COMPLETED_TX, pCompletedTransaction);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, txFauxConfirmedCallbackMethodId, contextBytes, jpCompletedTransaction);
+    }, [=] { dropTxCallback(CALLBACK_TYPE_TX_FAUX_CONFIRMED, pCompletedTransaction); });
 }
 
 void txFauxUnconfirmedCallback(void *context, TariCompletedTransaction *pCompletedTransaction, uint64_t confirmationCount) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    indexTx(pCompletedTransaction, TX_HISTORY_KIND_COMPLETED);
+    trackConfirmations(pCompletedTransaction, confirmationCount);
+    if (!isSubscribed(CALLBACK_TYPE_TX_FAUX_UNCONFIRMED, pCompletedTransaction) ||
+        !isNewTxState(CALLBACK_TYPE_TX_FAUX_UNCONFIRMED, pCompletedTransaction, confirmationCount)) {
+        completed_transaction_destroy(pCompletedTransaction);
         return;
     }
-    jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, confirmationCount);
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, txFauxUnconfirmedCallbackMethodId, contextBytes, jpCompletedTransaction, bytes);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_TX_FAUX_UNCONFIRMED, [=](JNIEnv *jniEnv, jobject handler) {
+        jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, confirmationCount);
+        auto jpCompletedTransaction = NewHandle(HANDLE_TYPE_COMPLETED_TX, pCompletedTransaction);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, txFauxUnconfirmedCallbackMethodId, contextBytes, jpCompletedTransaction, bytes);
+    }, [=] { dropTxCallback(CALLBACK_TYPE_TX_FAUX_UNCONFIRMED, pCompletedTransaction, confirmationCount); });
 }
 
 void txReceivedCallback(void *context, TariPendingInboundTransaction *pPendingInboundTransaction) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    indexTx(pPendingInboundTransaction);
+    if (!isSubscribed(CALLBACK_TYPE_TX_RECEIVED, pPendingInboundTransaction) ||
+        !isNewTxState(CALLBACK_TYPE_TX_RECEIVED, pPendingInboundTransaction)) {
+        pending_inbound_transaction_destroy(pPendingInboundTransaction);
         return;
     }
-    auto jpPendingInboundTransaction = reinterpret_cast<jlong>(pPendingInboundTransaction);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, txReceivedCallbackMethodId, contextBytes, jpPendingInboundTransaction);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_TX_RECEIVED, [=](JNIEnv *jniEnv, jobject handler) {
+        auto jpPendingInboundTransaction = NewHandle(HANDLE_TYPE_PENDING_INBOUND_TX, pPendingInboundTransaction);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, txReceivedCallbackMethodId, contextBytes, jpPendingInboundTransaction);
+    }, [=] { dropTxCallback(CALLBACK_TYPE_TX_RECEIVED, pPendingInboundTransaction); });
 }
 
 void txReplyReceivedCallback(void *context, TariCompletedTransaction *pCompletedTransaction) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    indexTx(pCompletedTransaction, TX_HISTORY_KIND_COMPLETED);
+    trackTxStage(TX_STAGE_REPLY_RECEIVED, pCompletedTransaction);
+    if (!isSubscribed(CALLBACK_TYPE_TX_REPLY_RECEIVED, pCompletedTransaction) ||
+        !isNewTxState(CALLBACK_TYPE_TX_REPLY_RECEIVED, pCompletedTransaction)) {
+        completed_transaction_destroy(pCompletedTransaction);
         return;
     }
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, txReplyReceivedCallbackMethodId, contextBytes, jpCompletedTransaction);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_TX_REPLY_RECEIVED, [=](JNIEnv *jniEnv, jobject handler) {
+        auto jpCompletedTransaction = NewHandle(HANDLE_TYPE_COMPLETED_TX, pCompletedTransaction);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, txReplyReceivedCallbackMethodId, contextBytes, jpCompletedTransaction);
+    }, [=] { dropTxCallback(CALLBACK_TYPE_TX_REPLY_RECEIVED, pCompletedTransaction); });
 }
 
 void txFinalizedCallback(void *context, TariCompletedTransaction *pCompletedTransaction) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    indexTx(pCompletedTransaction, TX_HISTORY_KIND_COMPLETED);
+    trackTxStage(TX_STAGE_FINALIZED, pCompletedTransaction);
+    if (!isSubscribed(CALLBACK_TYPE_TX_FINALIZED, pCompletedTransaction) ||
+        !isNewTxState(CALLBACK_TYPE_TX_FINALIZED, pCompletedTransaction)) {
+        completed_transaction_destroy(pCompletedTransaction);
         return;
     }
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, txFinalizedCallbackMethodId, contextBytes, jpCompletedTransaction);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_TX_FINALIZED, [=](JNIEnv *jniEnv, jobject handler) {
+        auto jpCompletedTransaction = NewHandle(HANDLE_TYPE_COMPLETED_TX, pCompletedTransaction);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, txFinalizedCallbackMethodId, contextBytes, jpCompletedTransaction);
+    }, [=] { dropTxCallback(CALLBACK_TYPE_TX_FINALIZED, pCompletedTransaction); });
+}
+
+/**
+ * One event per completed batch send with the tx id and direct send status of every item, in the order of the batch.
+ */
+void postBatchSendCompletions(void *context, const std::vector<BatchSendCompletion> &completions) {
+    if (!isSubscribed(CALLBACK_TYPE_BATCH_SEND_COMPLETED)) {
+        return;
+    }
+    for (const BatchSendCompletion &completion : completions) {
+        postCallback(CALLBACK_TYPE_BATCH_SEND_COMPLETED, [=](JNIEnv *jniEnv, jobject handler) {
+            auto length = static_cast<jsize>(completion.txIds.size());
+            jlongArray txIdArray = jniEnv->NewLongArray(length);
+            jniEnv->SetLongArrayRegion(txIdArray, 0, length, reinterpret_cast<const jlong *>(completion.txIds.data()));
+            jintArray statusArray = jniEnv->NewIntArray(length);
+            jniEnv->SetIntArrayRegion(statusArray, 0, length, completion.sendStatuses.data());
+            jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+            jniEnv->CallVoidMethod(handler, batchSendCompletedCallbackMethodId, contextBytes,
+                                   static_cast<jlong>(completion.batchId), txIdArray, statusArray);
+        });
+    }
 }
 
 void txDirectSendResultCallback(void *context, unsigned long long txId, TariTransactionSendStatus *status) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    GetTxLifecycleTracker().record(txId, TX_STAGE_DIRECT_SEND_RESULT, TxLifecycleTracker::nowNanos());
+    BatchSendTracker &batchSends = GetBatchSendTracker();
+    if (batchSends.isTracking()) {
+        int errorCode = 0;
+        auto sendStatus = static_cast<int32_t>(transaction_send_status_decode(status, &errorCode));
+        std::vector<BatchSendCompletion> completions;
+        batchSends.onDirectSendResult(txId, errorCode == 0 ? sendStatus : BATCH_SEND_NO_RESULT, completions);
+        batchSends.expire(TxLifecycleTracker::nowNanos(), completions);
+        postBatchSendCompletions(context, completions);
+    }
+    if (!isSubscribed(CALLBACK_TYPE_DIRECT_SEND_RESULT, [txId] { return static_cast<uint64_t>(txId); })) {
+        transaction_send_status_destroy(status);
         return;
     }
-    jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, txId);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, directSendResultCallbackMethodId, contextBytes, bytes, status);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_DIRECT_SEND_RESULT, [=](JNIEnv *jniEnv, jobject handler) {
+        jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, txId);
+        auto jpStatus = NewHandle(HANDLE_TYPE_TRANSACTION_SEND_STATUS, status);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, directSendResultCallbackMethodId, contextBytes, bytes, jpStatus);
+    }, [=] { transaction_send_status_destroy(status); });
 }
 
 void txCancellationCallback(void *context, TariCompletedTransaction *pCompletedTransaction, uint64_t rejectionReason) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    indexTx(pCompletedTransaction, TX_HISTORY_KIND_CANCELLED);
+    forgetConfirmations(pCompletedTransaction);
+    if (!isSubscribed(CALLBACK_TYPE_TX_CANCELLED, pCompletedTransaction) ||
+        !isNewTxState(CALLBACK_TYPE_TX_CANCELLED, pCompletedTransaction, rejectionReason)) {
+        completed_transaction_destroy(pCompletedTransaction);
         return;
     }
-    jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, rejectionReason);
-    auto jpCompletedTransaction = reinterpret_cast<jlong>(pCompletedTransaction);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, txCancellationCallbackMethodId, contextBytes, jpCompletedTransaction, bytes);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_TX_CANCELLED, [=](JNIEnv *jniEnv, jobject handler) {
+        jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, rejectionReason);
+        auto jpCompletedTransaction = NewHandle(HANDLE_TYPE_COMPLETED_TX, pCompletedTransaction);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, txCancellationCallbackMethodId, contextBytes, jpCompletedTransaction, bytes);
+    }, [=] { completed_transaction_destroy(pCompletedTransaction); });
 }
 
 void txoValidationCompleteCallback(void *context, uint64_t requestId, uint64_t status) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    if (!isSubscribed(CALLBACK_TYPE_TXO_VALIDATION_COMPLETE)) {
         return;
     }
-    jbyteArray requestIdBytes = getBytesFromUnsignedLongLong(jniEnv, requestId);
-    jbyteArray statusBytes = getBytesFromUnsignedLongLong(jniEnv, status);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, txoValidationCompleteCallbackMethodId, contextBytes, requestIdBytes, statusBytes);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_TXO_VALIDATION_COMPLETE, [=](JNIEnv *jniEnv, jobject handler) {
+        jbyteArray requestIdBytes = getBytesFromUnsignedLongLong(jniEnv, requestId);
+        jbyteArray statusBytes = getBytesFromUnsignedLongLong(jniEnv, status);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, txoValidationCompleteCallbackMethodId, contextBytes, requestIdBytes, statusBytes);
+    });
 }
 
 void contactsLivenessDataUpdatedCallback(void *context, TariContactsLivenessData *pTariContactsLivenessData) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    if (!isSubscribed(CALLBACK_TYPE_CONTACTS_LIVENESS_DATA_UPDATED)) {
+        liveness_data_destroy(pTariContactsLivenessData);
         return;
     }
-    auto jpTariContactsLivenessData = reinterpret_cast<jlong>(pTariContactsLivenessData);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, contactsLivenessDataUpdatedCallbackMethodId, contextBytes, jpTariContactsLivenessData);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_CONTACTS_LIVENESS_DATA_UPDATED, [=](JNIEnv *jniEnv, jobject handler) {
+        auto jpTariContactsLivenessData = reinterpret_cast<jlong>(pTariContactsLivenessData);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, contactsLivenessDataUpdatedCallbackMethodId, contextBytes, jpTariContactsLivenessData);
+    }, [=] { liveness_data_destroy(pTariContactsLivenessData); });
 }
 
 void transactionValidationCompleteCallback(void *context, uint64_t requestId, uint64_t status) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    if (!isSubscribed(CALLBACK_TYPE_TX_VALIDATION_COMPLETE)) {
         return;
     }
-    jbyteArray requestIdBytes = getBytesFromUnsignedLongLong(jniEnv, requestId);
-    jbyteArray statusBytes = getBytesFromUnsignedLongLong(jniEnv, status);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, transactionValidationCompleteCallbackMethodId, contextBytes, requestIdBytes, statusBytes);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_TX_VALIDATION_COMPLETE, [=](JNIEnv *jniEnv, jobject handler) {
+        jbyteArray requestIdBytes = getBytesFromUnsignedLongLong(jniEnv, requestId);
+        jbyteArray statusBytes = getBytesFromUnsignedLongLong(jniEnv, status);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, transactionValidationCompleteCallbackMethodId, contextBytes, requestIdBytes, statusBytes);
+    });
 }
 
 void connectivityStatusCallback(void *context, uint64_t status) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    if (!isSubscribed(CALLBACK_TYPE_CONNECTIVITY_STATUS)) {
         return;
     }
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jbyteArray requestIdBytes = getBytesFromUnsignedLongLong(jniEnv, status);
-    jniEnv->CallVoidMethod(callbackHandler, connectivityStatusCallbackId, contextBytes, requestIdBytes);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_CONNECTIVITY_STATUS, [=](JNIEnv *jniEnv, jobject handler) {
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jbyteArray requestIdBytes = getBytesFromUnsignedLongLong(jniEnv, status);
+        jniEnv->CallVoidMethod(handler, connectivityStatusCallbackId, contextBytes, requestIdBytes);
+    });
 }
 
 void walletScannedHeightCallback(void *context, uint64_t height) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    if (!isSubscribed(CALLBACK_TYPE_WALLET_SCANNED_HEIGHT)) {
         return;
     }
-    jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, height);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, walletScannedHeightCallbackMethodId, contextBytes, bytes);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_WALLET_SCANNED_HEIGHT, [=](JNIEnv *jniEnv, jobject handler) {
+        jbyteArray bytes = getBytesFromUnsignedLongLong(jniEnv, height);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, walletScannedHeightCallbackMethodId, contextBytes, bytes);
+    });
 }
 
 void balanceUpdatedCallback(void *context, TariBalance *pBalance) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    if (!isSubscribed(CALLBACK_TYPE_BALANCE_UPDATED)) {
+        balance_destroy(pBalance);
         return;
     }
-    auto jpBalance = reinterpret_cast<jlong>(pBalance);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, balanceUpdatedCallbackMethodId, contextBytes, jpBalance);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_BALANCE_UPDATED, [=](JNIEnv *jniEnv, jobject handler) {
+        auto jpBalance = NewHandle(HANDLE_TYPE_BALANCE, pBalance);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, balanceUpdatedCallbackMethodId, contextBytes, jpBalance);
+    }, [=] { balance_destroy(pBalance); });
 }
 
 void storeAndForwardMessagesReceivedCallback(void *context) {
     // no-op
 }
 
+/**
+ * One event with the new confirmation counts of all txs that changed with the tip.
+ */
+void postConfirmationsChanged(void *context, uint64_t tip) {
+    ConfirmationTracker &tracker = GetConfirmationTracker();
+    if (tip == 0 || !tracker.isTracking()) {
+        return;
+    }
+    std::vector<uint64_t> txIds;
+    std::vector<uint64_t> confirmations;
+    if (!tracker.onTip(tip, txIds, confirmations) || !isSubscribed(CALLBACK_TYPE_CONFIRMATIONS_CHANGED)) {
+        return;
+    }
+    postCallback(CALLBACK_TYPE_CONFIRMATIONS_CHANGED, [=](JNIEnv *jniEnv, jobject handler) {
+        auto length = static_cast<jsize>(txIds.size());
+        jlongArray txIdArray = jniEnv->NewLongArray(length);
+        jniEnv->SetLongArrayRegion(txIdArray, 0, length, reinterpret_cast<const jlong *>(txIds.data()));
+        jlongArray confirmationArray = jniEnv->NewLongArray(length);
+        jniEnv->SetLongArrayRegion(confirmationArray, 0, length, reinterpret_cast<const jlong *>(confirmations.data()));
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, confirmationsChangedCallbackMethodId, contextBytes, txIdArray, confirmationArray);
+    });
+}
+
 void baseNodeStatusCallback(void *context, TariBaseNodeState *pBaseNodeState) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    int errorCode = 0;
+    uint64_t tip = basenode_state_get_height_of_the_longest_chain(pBaseNodeState, &errorCode);
+    postConfirmationsChanged(context, errorCode == 0 ? tip : 0);
+    // batches whose txs never got a direct send result complete with the next status after their deadline
+    if (GetBatchSendTracker().isTracking()) {
+        std::vector<BatchSendCompletion> completions;
+        GetBatchSendTracker().expire(TxLifecycleTracker::nowNanos(), completions);
+        postBatchSendCompletions(context, completions);
+    }
+    if (!isSubscribed(CALLBACK_TYPE_BASE_NODE_STATUS) && !g_awaitingBaseNodeContact.load()) {
+        basenode_state_destroy(pBaseNodeState);
         return;
     }
-    auto jpBaseNodeState = reinterpret_cast<jlong>(pBaseNodeState);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, baseNodeStatusCallbackMethodId, contextBytes, jpBaseNodeState);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_BASE_NODE_STATUS, [=](JNIEnv *jniEnv, jobject handler) {
+        if (g_awaitingBaseNodeContact.exchange(false)) {
+            // the delivery already checked it's for the current wallet
+            postWalletCreateProgress(jniEnv, context, WALLET_CREATE_STAGE_BASE_NODE_CONTACTED, 0, g_callbackGate.generation());
+        }
+        auto jpBaseNodeState = reinterpret_cast<jlong>(pBaseNodeState);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, baseNodeStatusCallbackMethodId, contextBytes, jpBaseNodeState);
+    }, [=] { basenode_state_destroy(pBaseNodeState); });
 }
 
 void recoveringProcessCompleteCallback(void *context, uint8_t first, uint64_t second, uint64_t third) {
-    auto *jniEnv = getJNIEnv();
-    if (jniEnv == nullptr || callbackHandler == nullptr) {
+    TraceSpan traceSpan(__func__, TRACE_CATEGORY_CALLBACK);
+    if (!isSubscribed(CALLBACK_TYPE_RECOVERY_PROGRESS)) {
         return;
     }
-    jbyteArray bytes2 = getBytesFromUnsignedLongLong(jniEnv, second);
-    jbyteArray bytes3 = getBytesFromUnsignedLongLong(jniEnv, third);
-    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
-    jniEnv->CallVoidMethod(callbackHandler, recoveringProcessCompleteCallbackMethodId, contextBytes, static_cast<jint>(first), bytes2, bytes3);
-    g_vm->DetachCurrentThread();
+    postCallback(CALLBACK_TYPE_RECOVERY_PROGRESS, [=](JNIEnv *jniEnv, jobject handler) {
+        jbyteArray bytes2 = getBytesFromUnsignedLongLong(jniEnv, second);
+        jbyteArray bytes3 = getBytesFromUnsignedLongLong(jniEnv, third);
+        jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(context));
+        jniEnv->CallVoidMethod(handler, recoveringProcessCompleteCallbackMethodId, contextBytes, static_cast<jint>(first), bytes2, bytes3);
+    });
 }
 
 jmethodID getMethodId(JNIEnv *jniEnv, jobject object, jstring methodName, jstring methodSignature) {
@@ -319,40 +915,243 @@ jmethodID getMethodId(JNIEnv *jniEnv, jobject object, jstring methodName, jstrin
     return methodId;
 }
 
-extern "C"
-JNIEXPORT void JNICALL
-Java_com_tari_android_wallet_ffi_FFIWallet_jniCreate(
-        JNIEnv *jEnv,
-        jobject jThis,
-        jint jpContext,
-        jobject jpWalletConfig,
-        jstring jLogPath,
-        jint logVerbosity,
-        jint maxNumberOfRollingLogFiles,
-        jint rollingLogFileMaxSizeBytes,
-        jstring jPassphrase,
-        jstring jNetwork,
-        jobject jSeed_words,
-        jstring jDnsPeer,
-        jboolean isDnsSecureOn,
-        jstring jHttpBaseNode,
-        jint walletBirthdayOffset,
-        jobject jWalletCallbacks,
-        jstring callback_received_tx,
-        jstring callback_received_tx_sig,
-        jstring callback_received_tx_reply,
-        jstring callback_received_tx_reply_sig,
-        jstring callback_received_finalized_tx,
-        jstring callback_received_finalized_tx_sig,
-        jstring callback_tx_broadcast,
-        jstring callback_tx_broadcast_sig,
-        jstring callback_tx_mined,
-        jstring callback_tx_mined_sig,
-        jstring callback_tx_mined_unconfirmed,
-        jstring callback_tx_mined_unconfirmed_sig,
-        jstring callback_tx_faux_confirmed,
-        jstring callback_tx_faux_confirmed_sig,
-        jstring callback_tx_faux_unconfirmed,
+/**
+ * Arguments of wallet_create, copied out of the JNI strings so they outlive the JNI call.
+ */
+struct WalletCreateArgs {
+    int *pContext = nullptr;
+    TariCommsConfig *pWalletConfig = nullptr;
+    std::optional<std::string> logPath;
+    int logVerbosity = 0;
+    unsigned int maxNumberOfRollingLogFiles = 0;
+    unsigned int rollingLogFileMaxSizeBytes = 0;
+    std::optional<std::string> passphrase;
+    TariSeedWords *pSeedWords = nullptr;
+    std::optional<std::string> network;
+    std::optional<std::string> dnsPeer;
+    bool isDnsSecureOn = false;
+    std::optional<std::string> httpBaseNode;
+    int walletBirthdayOffset = 0;
+};
+
+std::optional<std::string> GetOptionalString(JNIEnv *jEnv, jstring jString) {
+    if (jString == nullptr) {
+        return std::nullopt;
+    }
+    return GetStdString(jEnv, jString);
+}
+
+inline const char *CStringOrNull(const std::optional<std::string> &string) {
+    return string.has_value() ? string->c_str() : nullptr;
+}
+
+TariWallet *createWallet(const WalletCreateArgs &args, int *errorCode) {
+    TraceSpan walletCreateSpan("wallet_create", TRACE_CATEGORY_STARTUP);
+    bool recoveryInProgress = false;
+    GetConfirmationTracker().clear();
+    GetCallbackDedup().clear();
+    TariWallet *pWallet = wallet_create(
+            args.pContext,
+            args.pWalletConfig,
+            CStringOrNull(args.logPath),
+            args.logVerbosity,
+            args.maxNumberOfRollingLogFiles,
+            args.rollingLogFileMaxSizeBytes,
+            CStringOrNull(args.passphrase),
+            nullptr,
+            args.pSeedWords,
+            CStringOrNull(args.network),
+            CStringOrNull(args.dnsPeer),
+            nullptr,
+            args.isDnsSecureOn,
+            CStringOrNull(args.httpBaseNode),
+            args.walletBirthdayOffset,
+            txReceivedCallback,
+            txReplyReceivedCallback,
+            txFinalizedCallback,
+            txBroadcastCallback,
+            txMinedCallback,
+            txMinedUnconfirmedCallback,
+            txFauxConfirmedCallback,
+            txFauxUnconfirmedCallback,
+            txDirectSendResultCallback,
+            txCancellationCallback,
+            txoValidationCompleteCallback,
+            contactsLivenessDataUpdatedCallback,
+            balanceUpdatedCallback,
+            transactionValidationCompleteCallback,
+            storeAndForwardMessagesReceivedCallback,
+            connectivityStatusCallback,
+            walletScannedHeightCallback,
+            baseNodeStatusCallback,
+            &recoveryInProgress,
+            errorCode);
+    if (pWallet != nullptr && *errorCode == 0) {
+        int confirmationsErrorCode = 0;
+        uint64_t required = wallet_get_num_confirmations_required(pWallet, &confirmationsErrorCode);
+        if (confirmationsErrorCode == 0) {
+            GetConfirmationTracker().setRequired(required);
+        }
+    }
+    return pWallet;
+}
+
+/**
+ * A wallet being created on a worker thread. Registered by id until the worker is done so it can be cancelled.
+ */
+struct WalletCreation {
+    jlong id = 0;
+    WalletCreateArgs args;
+    jobject walletRef = nullptr;
+    // keep the FFICommsConfig and FFISeedWords args.pWalletConfig and args.pSeedWords point into from being
+    // finalized while wallet_create reads them
+    jobject configRef = nullptr;
+    jobject seedWordsRef = nullptr;
+    // of the gate opened for the wallet
+    uint64_t gateGeneration = 0;
+    std::atomic<bool> cancelled{false};
+
+    std::vector<jobject> refs() const {
+        std::vector<jobject> result;
+        for (jobject ref : {walletRef, configRef, seedWordsRef}) {
+            if (ref != nullptr) {
+                result.push_back(ref);
+            }
+        }
+        return result;
+    }
+};
+
+std::mutex g_walletCreationsMutex;
+std::condition_variable g_cancelledCreationsDone;
+std::unordered_map<jlong, std::shared_ptr<WalletCreation>> g_walletCreations;
+jlong g_nextWalletCreationId = 1;
+// cancelled creations still in wallet_create, the next jniCreate waits for them so two wallets never open the datastore
+size_t g_cancelledCreationCount = 0;
+// global refs of creations whose thread couldn't attach to the VM, deleted by the next jniCreate
+std::vector<jobject> g_orphanedCreationRefs;
+
+/**
+ * Call with g_walletCreationsMutex held. The worker destroys the wallet once wallet_create returns, the gate is
+ * released right away by the caller.
+ */
+void cancelWalletCreationLocked(WalletCreation &creation) {
+    if (!creation.cancelled.exchange(true)) {
+        g_cancelledCreationCount++;
+    }
+}
+
+void onWalletCreationDone(const WalletCreation &creation) {
+    std::lock_guard<std::mutex> lock(g_walletCreationsMutex);
+    g_walletCreations.erase(creation.id);
+    if (creation.cancelled.load() && --g_cancelledCreationCount == 0) {
+        g_cancelledCreationsDone.notify_all();
+    }
+}
+
+/**
+ * Reports the outcome of a creation, a wallet that wasn't created gives up the callbacks.
+ */
+void finishWalletCreation(JNIEnv *jniEnv, const WalletCreation &creation, jint stage, jint errorCode) {
+    // holds on to the handler for the report, the gate may be closed by then
+    CallbackHandlerScope handlerScope;
+    bool isCurrent = handlerScope && creation.gateGeneration == g_callbackGate.generation();
+    if (isCurrent) {
+        g_awaitingBaseNodeContact.store(stage == WALLET_CREATE_STAGE_WALLET_CREATED);
+    }
+    if (stage != WALLET_CREATE_STAGE_WALLET_CREATED) {
+        // before the report, so a creation started on it isn't refused
+        releaseCallbackGate(jniEnv, creation.gateGeneration);
+    }
+    if (isCurrent) {
+        callWalletCreateProgress(jniEnv, handlerScope.handler(), creation.args.pContext, stage, errorCode);
+    }
+    handlerScope.release(jniEnv);
+    for (jobject ref : creation.refs()) {
+        jniEnv->DeleteGlobalRef(ref);
+    }
+}
+
+void runWalletCreation(const std::shared_ptr<WalletCreation> &creation) {
+    JNIEnv *jniEnv = getJNIEnv();
+    if (jniEnv == nullptr) {
+        onWalletCreationDone(*creation);
+        // nothing can be reported from a thread the VM doesn't know, the attached dispatcher thread reports the
+        // failure. It shares the lane of the base node status that reports the last stage.
+        postCallback(CALLBACK_TYPE_BASE_NODE_STATUS, [creation](JNIEnv *jniEnv, jobject) {
+            finishWalletCreation(jniEnv, *creation, WALLET_CREATE_STAGE_FAILED, NATIVE_ERROR_THREAD_NOT_ATTACHED);
+        }, [creation] {
+            {
+                std::lock_guard<std::mutex> lock(g_walletCreationsMutex);
+                std::vector<jobject> refs = creation->refs();
+                g_orphanedCreationRefs.insert(g_orphanedCreationRefs.end(), refs.begin(), refs.end());
+            }
+            std::lock_guard<std::mutex> lock(g_callbackGateOwnerMutex);
+            g_abandonedGateGeneration = creation->gateGeneration;
+        });
+        return;
+    }
+    jint stage = WALLET_CREATE_STAGE_CANCELLED;
+    int errorCode = 0;
+    TariWallet *pWallet = nullptr;
+    // wallet_create itself can't be interrupted, a cancellation during it destroys the wallet right after
+    if (!creation->cancelled.load()) {
+        pWallet = createWallet(creation->args, &errorCode);
+        if (pWallet == nullptr || errorCode != 0) {
+            stage = WALLET_CREATE_STAGE_FAILED;
+        }
+    }
+    if (stage != WALLET_CREATE_STAGE_FAILED && pWallet != nullptr) {
+        // checked with the creation registered, a cancel after this finds it gone and destroys the wallet by pointer
+        std::lock_guard<std::mutex> lock(g_walletCreationsMutex);
+        if (!creation->cancelled.load()) {
+            SetPointerField(jniEnv, creation->walletRef, reinterpret_cast<jlong>(pWallet));
+            g_walletCreations.erase(creation->id);
+            stage = WALLET_CREATE_STAGE_WALLET_CREATED;
+        }
+    }
+    if (stage == WALLET_CREATE_STAGE_CANCELLED && pWallet != nullptr) {
+        wallet_destroy(pWallet);
+    }
+    onWalletCreationDone(*creation);
+    finishWalletCreation(jniEnv, *creation, stage, errorCode);
+    g_vm->DetachCurrentThread();
+}
+
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniCreate(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jint jpContext,
+        jobject jpWalletConfig,
+        jstring jLogPath,
+        jint logVerbosity,
+        jint maxNumberOfRollingLogFiles,
+        jint rollingLogFileMaxSizeBytes,
+        jstring jPassphrase,
+        jstring jNetwork,
+        jobject jSeed_words,
+        jstring jDnsPeer,
+        jboolean isDnsSecureOn,
+        jstring jHttpBaseNode,
+        jint walletBirthdayOffset,
+        jobject jWalletCallbacks,
+        jstring callback_received_tx,
+        jstring callback_received_tx_sig,
+        jstring callback_received_tx_reply,
+        jstring callback_received_tx_reply_sig,
+        jstring callback_received_finalized_tx,
+        jstring callback_received_finalized_tx_sig,
+        jstring callback_tx_broadcast,
+        jstring callback_tx_broadcast_sig,
+        jstring callback_tx_mined,
+        jstring callback_tx_mined_sig,
+        jstring callback_tx_mined_unconfirmed,
+        jstring callback_tx_mined_unconfirmed_sig,
+        jstring callback_tx_faux_confirmed,
+        jstring callback_tx_faux_confirmed_sig,
+        jstring callback_tx_faux_unconfirmed,
         jstring callback_tx_faux_unconfirmed_sig,
         jstring callback_direct_send_result,
         jstring callback_direct_send_result_sig,
@@ -372,12 +1171,42 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniCreate(
         jstring callback_wallet_scanned_height_sig,
         jstring callback_base_node_status,
         jstring callback_base_node_status_sig,
+        jstring callback_wallet_create_progress,
+        jstring callback_wallet_create_progress_sig,
+        jstring callback_job_completed,
+        jstring callback_job_completed_sig,
+        jstring callback_confirmations_changed,
+        jstring callback_confirmations_changed_sig,
+        jstring callback_batch_send_completed,
+        jstring callback_batch_send_completed_sig,
+        jboolean createAsync,
         jobject error) {
+    JNI_ENTRY_POINT();
 
     int errorCode = 0;
-    if (callbackHandler == nullptr) {
-        callbackHandler = jEnv->NewGlobalRef(jWalletCallbacks);
+    {
+        std::unique_lock<std::mutex> lock(g_walletCreationsMutex);
+        g_cancelledCreationsDone.wait(lock, [] { return g_cancelledCreationCount == 0; });
+    }
+    std::unique_lock<std::mutex> gateOwnerLock(g_callbackGateOwnerMutex);
+    if (g_abandonedGateGeneration != 0) {
+        if (g_callbackGate.isOpen() && g_callbackGate.generation() == g_abandonedGateGeneration) {
+            closeCallbackGateLocked(jEnv);
+        }
+        g_abandonedGateGeneration = 0;
+    }
+    if (g_callbackGate.isOpen()) {
+        // the handler and the method ids are process wide, a second wallet would take them over from the running one
+        LOGE("A wallet is already running, it has to be destroyed before another one is created");
+        setErrorCode(jEnv, error, NATIVE_ERROR_WALLET_ALREADY_RUNNING);
+        SetNullPointerField(jEnv, jThis);
+        return 0;
     }
+    TraceSpan methodIdsSpan("resolve callback method ids", TRACE_CATEGORY_STARTUP);
+    // callbacks of a destroyed wallet may still be finishing with the old handler and method ids
+    g_callbackGate.waitUntilReleased();
+    callbackHandler = jEnv->NewGlobalRef(jWalletCallbacks);
+    g_callbackGateOwner = jEnv->NewWeakGlobalRef(jThis);
     jclass jClass = jEnv->GetObjectClass(jThis);
     if (jClass == nullptr) {
         SetNullPointerField(jEnv, jThis);
@@ -472,82 +1301,109 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniCreate(
         SetNullPointerField(jEnv, jThis);
     }
 
-    auto pContext = reinterpret_cast<int *>(jpContext);
-    auto pWalletConfig = GetPointerField<TariCommsConfig *>(jEnv, jpWalletConfig);
-
-    const char *pLogPath = jEnv->GetStringUTFChars(jLogPath, JNI_FALSE);
-    if (strlen(pLogPath) == 0) {
-        pLogPath = nullptr;
+    walletCreateProgressCallbackMethodId = getMethodId(jEnv, jWalletCallbacks, callback_wallet_create_progress,
+                                                       callback_wallet_create_progress_sig);
+    if (walletCreateProgressCallbackMethodId == nullptr) {
+        SetNullPointerField(jEnv, jThis);
     }
 
-    const char *pPassphrase = nullptr;
-    if (jPassphrase != nullptr) {
-        pPassphrase = jEnv->GetStringUTFChars(jPassphrase, JNI_FALSE);
+    jobCompletedCallbackMethodId = getMethodId(jEnv, jWalletCallbacks, callback_job_completed, callback_job_completed_sig);
+    if (jobCompletedCallbackMethodId == nullptr) {
+        SetNullPointerField(jEnv, jThis);
     }
 
-    const char *pNetwork = nullptr;
-    if (jNetwork != nullptr) {
-        pNetwork = jEnv->GetStringUTFChars(jNetwork, JNI_FALSE);
+    confirmationsChangedCallbackMethodId = getMethodId(jEnv, jWalletCallbacks, callback_confirmations_changed,
+                                                       callback_confirmations_changed_sig);
+    if (confirmationsChangedCallbackMethodId == nullptr) {
+        SetNullPointerField(jEnv, jThis);
     }
 
-    const char *pHttpBaseNode = nullptr;
-    if (jHttpBaseNode != nullptr) {
-        pHttpBaseNode = jEnv->GetStringUTFChars(jHttpBaseNode, JNI_FALSE);
+    batchSendCompletedCallbackMethodId = getMethodId(jEnv, jWalletCallbacks, callback_batch_send_completed,
+                                                     callback_batch_send_completed_sig);
+    if (batchSendCompletedCallbackMethodId == nullptr) {
+        SetNullPointerField(jEnv, jThis);
     }
-
-    const char *pDnsPeer = nullptr;
-    if (jDnsPeer != nullptr) {
-        pDnsPeer = jEnv->GetStringUTFChars(jDnsPeer, JNI_FALSE);
+    g_callbackGate.open();
+    const uint64_t gateGeneration = g_callbackGate.generation();
+    gateOwnerLock.unlock();
+    methodIdsSpan.end();
+
+    TraceSpan argumentsSpan("convert arguments", TRACE_CATEGORY_STARTUP);
+    auto creation = std::make_shared<WalletCreation>();
+    creation->gateGeneration = gateGeneration;
+    WalletCreateArgs &args = creation->args;
+    args.pContext = reinterpret_cast<int *>(jpContext);
+    g_walletContext = args.pContext;
+    args.pWalletConfig = GetPointerField<TariCommsConfig *>(jEnv, jpWalletConfig);
+    args.logPath = GetOptionalString(jEnv, jLogPath);
+    if (args.logPath.has_value() && args.logPath->empty()) {
+        args.logPath.reset();
     }
-
-    bool jRecoveryInProgress = false;
-    bool *pRecovery = &jRecoveryInProgress;
-
-    TariSeedWords *pSeedWords = nullptr;
+    args.logVerbosity = logVerbosity;
+    args.maxNumberOfRollingLogFiles = static_cast<unsigned int>(maxNumberOfRollingLogFiles);
+    args.rollingLogFileMaxSizeBytes = static_cast<unsigned int>(rollingLogFileMaxSizeBytes);
+    args.passphrase = GetOptionalString(jEnv, jPassphrase);
+    args.network = GetOptionalString(jEnv, jNetwork);
+    args.httpBaseNode = GetOptionalString(jEnv, jHttpBaseNode);
+    args.dnsPeer = GetOptionalString(jEnv, jDnsPeer);
+    args.isDnsSecureOn = isDnsSecureOn;
+    args.walletBirthdayOffset = walletBirthdayOffset;
     if (jSeed_words != nullptr) {
-        pSeedWords = GetPointerField<TariSeedWords *>(jEnv, jSeed_words);
+        args.pSeedWords = GetPointerField<TariSeedWords *>(jEnv, jSeed_words);
+    }
+    argumentsSpan.end();
+
+    if (createAsync == JNI_TRUE) {
+        postWalletCreateProgress(jEnv, args.pContext, WALLET_CREATE_STAGE_CONFIG_PARSED, 0, gateGeneration);
+        creation->walletRef = jEnv->NewGlobalRef(jThis);
+        creation->configRef = jEnv->NewGlobalRef(jpWalletConfig);
+        if (jSeed_words != nullptr) {
+            creation->seedWordsRef = jEnv->NewGlobalRef(jSeed_words);
+        }
+        {
+            std::lock_guard<std::mutex> lock(g_walletCreationsMutex);
+            for (jobject ref : g_orphanedCreationRefs) {
+                jEnv->DeleteGlobalRef(ref);
+            }
+            g_orphanedCreationRefs.clear();
+            creation->id = g_nextWalletCreationId++;
+            g_walletCreations[creation->id] = creation;
+        }
+        setErrorCode(jEnv, error, errorCode);
+        std::thread(runWalletCreation, creation).detach();
+        return creation->id;
     }
 
-    TariWallet *pWallet = wallet_create(
-            pContext,
-            pWalletConfig,
-            pLogPath,
-            logVerbosity,
-            static_cast<unsigned int>(maxNumberOfRollingLogFiles),
-            static_cast<unsigned int>(rollingLogFileMaxSizeBytes),
-            pPassphrase,
-            nullptr,
-            pSeedWords,
-            pNetwork,
-            pDnsPeer,
-            nullptr,
-            isDnsSecureOn,
-            pHttpBaseNode,
-            walletBirthdayOffset,
-            txReceivedCallback,
-            txReplyReceivedCallback,
-            txFinalizedCallback,
-            txBroadcastCallback,
-            txMinedCallback,
-            txMinedUnconfirmedCallback,
-            txFauxConfirmedCallback,
-            txFauxUnconfirmedCallback,
-            txDirectSendResultCallback,
-            txCancellationCallback,
-            txoValidationCompleteCallback,
-            contactsLivenessDataUpdatedCallback,
-            balanceUpdatedCallback,
-            transactionValidationCompleteCallback,
-            storeAndForwardMessagesReceivedCallback,
-            connectivityStatusCallback,
-            walletScannedHeightCallback,
-            baseNodeStatusCallback,
-            pRecovery,
-            &errorCode);
-
+    TariWallet *pWallet = createWallet(args, &errorCode);
+    if (pWallet == nullptr || errorCode != 0) {
+        // FFIWallet throws without a pointer to destroy, nothing else gives up the callbacks
+        releaseCallbackGate(jEnv, gateGeneration);
+    }
     setErrorCode(jEnv, error, errorCode);
-    jEnv->ReleaseStringUTFChars(jLogPath, pLogPath);
     SetPointerField(jEnv, jThis, reinterpret_cast<jlong>(pWallet));
+    return 0;
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniCancelCreate(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong creationId) {
+    JNI_ENTRY_POINT();
+    uint64_t gateGeneration;
+    {
+        std::lock_guard<std::mutex> lock(g_walletCreationsMutex);
+        auto it = g_walletCreations.find(creationId);
+        if (it == g_walletCreations.end()) {
+            return JNI_FALSE;
+        }
+        cancelWalletCreationLocked(*it->second);
+        gateGeneration = it->second->gateGeneration;
+    }
+    // the cancelled stage is reported by the caller, the callbacks of the wallet are dropped from here on
+    releaseCallbackGate(jEnv, gateGeneration);
+    return JNI_TRUE;
 }
 
 extern "C"
@@ -556,7 +1412,8 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetBalance(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariBalance *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariBalance *>(jEnv, error, HANDLE_TYPE_BALANCE, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return wallet_get_balance(pWallet, errorPointer);
     });
@@ -572,6 +1429,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetUtxos(
         jint jSorting,
         jlong jDustThreshold,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithErrorAndCast<TariVector *>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         auto pSorting = (TariUtxoSort) jSorting;
@@ -585,6 +1443,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetAllUtxos(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithErrorAndCast<TariVector *>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return wallet_get_all_utxos(pWallet, errorPointer);
@@ -598,6 +1457,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniLogMessage(
         jobject jThis,
         jstring jMessage,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         const char *pMessage = jEnv->GetStringUTFChars(jMessage, JNI_FALSE);
         log_debug_message(pMessage, errorPointer);
@@ -611,7 +1471,8 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetWalletAddress(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariWalletAddress *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariWalletAddress *>(jEnv, error, HANDLE_TYPE_WALLET_ADDRESS, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return wallet_get_tari_one_sided_address(pWallet, errorPointer);
     });
@@ -623,7 +1484,8 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetContacts(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariContacts *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariContacts *>(jEnv, error, HANDLE_TYPE_CONTACTS, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return wallet_get_contacts(pWallet, errorPointer);
     });
@@ -636,6 +1498,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniAddUpdateContact(
         jobject jThis,
         jobject jpContact,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         auto pContact = GetPointerField<TariContact *>(jEnv, jpContact);
@@ -650,6 +1513,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniRemoveContact(
         jobject jThis,
         jobject jpContact,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         auto pContact = GetPointerField<TariContact *>(jEnv, jpContact);
@@ -663,7 +1527,8 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCompletedTxs(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariCompletedTransactions *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariCompletedTransactions *>(jEnv, error, HANDLE_TYPE_COMPLETED_TXS, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return wallet_get_completed_transactions(pWallet, 0, errorPointer);
     });
@@ -675,7 +1540,8 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCancelledTxs(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariCompletedTransactions *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariCompletedTransactions *>(jEnv, error, HANDLE_TYPE_COMPLETED_TXS, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return wallet_get_cancelled_transactions(pWallet, 0, errorPointer);
     });
@@ -688,12 +1554,13 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCompletedTxById(
         jobject jThis,
         jstring jTxId,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         const char *nativeString = jEnv->GetStringUTFChars(jTxId, JNI_FALSE);
         char *pEnd;
         unsigned long long id = strtoull(nativeString, &pEnd, 10);
-        auto result = reinterpret_cast<jlong>(wallet_get_completed_transaction_by_id(pWallet, id, errorPointer));
+        auto result = NewHandle(HANDLE_TYPE_COMPLETED_TX, wallet_get_completed_transaction_by_id(pWallet, id, errorPointer));
         jEnv->ReleaseStringUTFChars(jTxId, nativeString);
         return result;
     });
@@ -706,12 +1573,13 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCancelledTxById(
         jobject jThis,
         jstring jTxId,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         const char *nativeString = jEnv->GetStringUTFChars(jTxId, JNI_FALSE);
         char *pEnd;
         unsigned long long id = strtoull(nativeString, &pEnd, 10);
-        auto result = reinterpret_cast<jlong>(wallet_get_cancelled_transaction_by_id(pWallet, id, errorPointer));
+        auto result = NewHandle(HANDLE_TYPE_COMPLETED_TX, wallet_get_cancelled_transaction_by_id(pWallet, id, errorPointer));
         jEnv->ReleaseStringUTFChars(jTxId, nativeString);
         return result;
     });
@@ -723,7 +1591,8 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPendingOutboundTxs(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariPendingOutboundTransactions *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariPendingOutboundTransactions *>(jEnv, error, HANDLE_TYPE_PENDING_OUTBOUND_TXS, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return wallet_get_pending_outbound_transactions(pWallet, 0, errorPointer);
     });
@@ -736,12 +1605,13 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPendingOutboundTxById(
         jobject jThis,
         jstring jTxId,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         const char *nativeString = jEnv->GetStringUTFChars(jTxId, JNI_FALSE);
         char *pEnd;
         unsigned long long id = strtoull(nativeString, &pEnd, 10);
-        auto result = reinterpret_cast<jlong>(wallet_get_pending_outbound_transaction_by_id(pWallet, id, 0, errorPointer));
+        auto result = NewHandle(HANDLE_TYPE_PENDING_OUTBOUND_TX, wallet_get_pending_outbound_transaction_by_id(pWallet, id, 0, errorPointer));
         jEnv->ReleaseStringUTFChars(jTxId, nativeString);
         return result;
     });
@@ -753,7 +1623,8 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPendingInboundTxs(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariPendingInboundTransactions *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariPendingInboundTransactions *>(jEnv, error, HANDLE_TYPE_PENDING_INBOUND_TXS, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return wallet_get_pending_inbound_transactions(pWallet, 0, errorPointer);
     });
@@ -766,12 +1637,13 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPendingInboundTxById(
         jobject jThis,
         jstring jTxId,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         const char *nativeString = jEnv->GetStringUTFChars(jTxId, JNI_FALSE);
         char *pEnd;
         unsigned long long id = strtoull(nativeString, &pEnd, 10);
-        auto result = reinterpret_cast<jlong>(wallet_get_pending_inbound_transaction_by_id(pWallet, id, 0, errorPointer));
+        auto result = NewHandle(HANDLE_TYPE_PENDING_INBOUND_TX, wallet_get_pending_inbound_transaction_by_id(pWallet, id, 0, errorPointer));
         jEnv->ReleaseStringUTFChars(jTxId, nativeString);
         return result;
     });
@@ -784,6 +1656,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniCancelPendingTx(
         jobject jThis,
         jstring jTxId,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         const char *nativeString = jEnv->GetStringUTFChars(jTxId, JNI_FALSE);
@@ -800,10 +1673,27 @@ JNIEXPORT void JNICALL
 Java_com_tari_android_wallet_ffi_FFIWallet_jniDestroy(
         JNIEnv *jEnv,
         jobject jThis) {
+    JNI_ENTRY_POINT();
     auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-    jEnv->DeleteGlobalRef(callbackHandler);
-    callbackHandler = nullptr;
+    {
+        // a wallet still being created is destroyed by its worker once wallet_create returns
+        std::lock_guard<std::mutex> lock(g_walletCreationsMutex);
+        for (auto &item : g_walletCreations) {
+            if (jEnv->IsSameObject(jThis, item.second->walletRef)) {
+                cancelWalletCreationLocked(*item.second);
+            }
+        }
+    }
+    // pool jobs capture the wallet, the queued ones are skipped and the running ones finish before it goes
+    GetWalletJobTracker().close(pWallet);
+    {
+        std::lock_guard<std::mutex> lock(g_callbackGateOwnerMutex);
+        if (g_callbackGateOwner != nullptr && jEnv->IsSameObject(jThis, g_callbackGateOwner)) {
+            closeCallbackGateLocked(jEnv);
+        }
+    }
     wallet_destroy(pWallet);
+    GetWalletJobTracker().reopen(pWallet);
     SetNullPointerField(jEnv, jThis);
 }
 
@@ -817,6 +1707,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniEstimateTxFee(
         jstring jKernelCount,
         jstring jOutputCount,
         jobject error) {
+    JNI_ENTRY_POINT();
     int errorCode = 0;
     auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
     const char *nativeAmount = jEnv->GetStringUTFChars(jAmount, JNI_FALSE);
@@ -834,7 +1725,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniEstimateTxFee(
     unsigned long long outputs = strtoull(nativeOutputs, &pOutputsEnd, 10);
 
     jbyteArray result = getBytesFromUnsignedLongLong(jEnv, wallet_get_fee_estimate(pWallet, amount, nullptr, gramFee, kernels, outputs, &errorCode));
-    setErrorCode(jEnv, error, errorCode);
+    PropagateErrorCode(jEnv, error, errorCode);
     jEnv->ReleaseStringUTFChars(jAmount, nativeAmount);
     jEnv->ReleaseStringUTFChars(jGramFee, nativeGramFee);
     jEnv->ReleaseStringUTFChars(jKernelCount, nativeKernels);
@@ -850,6 +1741,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniJoinUtxos(
         jobjectArray jCommitments,
         jstring jFeePerGram,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
 
@@ -877,6 +1769,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniSplitUtxos(
         jstring jSplitCount,
         jstring jFeePerGram,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
 
@@ -906,6 +1799,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniPreviewJoinUtxos(
         jobjectArray jCommitments,
         jstring jFeePerGram,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithErrorAndCast<TariCoinPreview *>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
 
@@ -933,6 +1827,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniPreviewSplitUtxos(
         jstring jSplitCount,
         jstring jFeePerGram,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithErrorAndCast<TariCoinPreview *>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
 
@@ -960,6 +1855,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniStartTxValidation(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, wallet_start_transaction_validation(pWallet, errorPointer));
@@ -972,6 +1868,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniRestartTxBroadcast(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, wallet_restart_transaction_broadcast(pWallet, errorPointer));
@@ -984,6 +1881,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniPowerModeNormal(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         wallet_set_normal_power_mode(pWallet, errorPointer);
@@ -996,6 +1894,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniPowerModeLow(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         wallet_set_low_power_mode(pWallet, errorPointer);
@@ -1008,7 +1907,8 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetSeedWords(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
-    return ExecuteWithErrorAndCast<TariSeedWords *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariSeedWords *>(jEnv, error, HANDLE_TYPE_SEED_WORDS, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return wallet_get_seed_words(pWallet, errorPointer);
     });
@@ -1022,6 +1922,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniSetKeyValue(
         jstring jKey,
         jstring jValue,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         const char *pKey = jEnv->GetStringUTFChars(jKey, JNI_FALSE);
@@ -1039,6 +1940,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniStartTXOValidation(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return getBytesFromUnsignedLongLong(jEnv, wallet_start_txo_validation(pWallet, errorPointer));
@@ -1052,6 +1954,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetKeyValue(
         jobject jThis,
         jstring jKey,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         const char *pKey = jEnv->GetStringUTFChars(jKey, JNI_FALSE);
@@ -1070,6 +1973,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniRemoveKeyValue(
         jobject jThis,
         jstring jKey,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         const char *pKey = jEnv->GetStringUTFChars(jKey, JNI_FALSE);
@@ -1085,9 +1989,14 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetConfirmations(
         JNIEnv *jEnv,
         jobject jThis,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
-        return getBytesFromUnsignedLongLong(jEnv, wallet_get_num_confirmations_required(pWallet, errorPointer));
+        uint64_t required = wallet_get_num_confirmations_required(pWallet, errorPointer);
+        if (*errorPointer == 0) {
+            GetConfirmationTracker().setRequired(required);
+        }
+        return getBytesFromUnsignedLongLong(jEnv, required);
     });
 }
 
@@ -1098,12 +2007,16 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniSetConfirmations(
         jobject jThis,
         jstring jNumber,
         jobject error) {
+    JNI_ENTRY_POINT();
     ExecuteWithError(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         const char *nativeString = jEnv->GetStringUTFChars(jNumber, JNI_FALSE);
         char *pEnd;
         unsigned long long number = strtoull(nativeString, &pEnd, 10);
         wallet_set_num_confirmations_required(pWallet, number, errorPointer);
+        if (*errorPointer == 0) {
+            GetConfirmationTracker().setRequired(number);
+        }
         jEnv->ReleaseStringUTFChars(jNumber, nativeString);
     });
 }
@@ -1118,6 +2031,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniSendTx(
         jstring jFeePerGram,
         jstring jPaymentId,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jbyteArray>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         auto pDestination = GetPointerField<TariWalletAddress *>(jEnv, jDestination);
@@ -1129,10 +2043,14 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniSendTx(
         unsigned long long feePerGram = strtoull(nativeFeePerGram, &pFeeEnd, 10);
         unsigned long long amount = strtoull(nativeAmount, &pAmountEnd, 10);
 
-        jbyteArray result = getBytesFromUnsignedLongLong(
-                jEnv,
-                wallet_send_transaction(pWallet, pDestination, amount, nullptr, feePerGram,
-                                        true, pPaymentId, errorPointer));
+        int64_t sentNanos = TxLifecycleTracker::nowNanos();
+        unsigned long long txId = wallet_send_transaction(pWallet, pDestination, amount, nullptr, feePerGram,
+                                                          true, pPaymentId, errorPointer);
+        if (*errorPointer == 0) {
+            GetTxLifecycleTracker().startTracking(txId, sentNanos);
+            indexSentTx(pWallet, txId);
+        }
+        jbyteArray result = getBytesFromUnsignedLongLong(jEnv, txId);
         jEnv->ReleaseStringUTFChars(jAmount, nativeAmount);
         jEnv->ReleaseStringUTFChars(jFeePerGram, nativeFeePerGram);
         jEnv->ReleaseStringUTFChars(jPaymentId, pPaymentId);
@@ -1149,6 +2067,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniStartRecovery(
         jstring callback,
         jstring callback_sig,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         recoveringProcessCompleteCallbackMethodId = getMethodId(jEnv, jWalletCallbacks, callback, callback_sig);
@@ -1166,6 +2085,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniSignMessage(
         jobject jThis,
         jstring jMessage,
         jobject error) {
+    JNI_ENTRY_POINT();
     return ExecuteWithError<jstring>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         const char *pMessage = jEnv->GetStringUTFChars(jMessage, JNI_FALSE);
@@ -1188,6 +2108,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniVerifyMessageSignature(
         jstring jMessage,
         jstring jHexSignatureNonce,
         jobject error) {
+    JNI_ENTRY_POINT();
 
     return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
@@ -1216,7 +2137,8 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniWalletGetFeePerGramStats(
         jint count,
         jobject error
 ) {
-    return ExecuteWithErrorAndCast<TariFeePerGramStat *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariFeePerGramStats *>(jEnv, error, HANDLE_TYPE_FEE_PER_GRAM_STATS, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return wallet_get_fee_per_gram_stats(pWallet, count, errorPointer);
     });
@@ -1229,7 +2151,8 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniWalletGetUnspentOutputs(
         jobject jThis,
         jobject error
 ) {
-    return ExecuteWithErrorAndCast<TariUnblindedOutputs *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariUnblindedOutputs *>(jEnv, error, HANDLE_TYPE_UNBLINDED_OUTPUTS, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return wallet_get_unspent_outputs(pWallet, errorPointer);
     });
@@ -1244,6 +2167,7 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniImportExternalUtxoAsNonRewindable(
         jobject jSourceWalletAddress,
         jstring jMessage,
         jobject error) {
+    JNI_ENTRY_POINT();
 
     auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
 
@@ -1277,7 +2201,8 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetBaseNodePeers(
         jobject jThis,
         jobject error
 ) {
-    return ExecuteWithErrorAndCast<TariPublicKeys *>(jEnv, error, [&](int *error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariPublicKeys *>(jEnv, error, HANDLE_TYPE_PUBLIC_KEYS, [&](int *error) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return wallet_get_seed_peers(pWallet, error);
     });
@@ -1290,7 +2215,8 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetPrivateViewKey(
         jobject jThis,
         jobject error
 ) {
-    return ExecuteWithErrorAndCast<TariPrivateKey *>(jEnv, error, [&](int *error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariPrivateKey *>(jEnv, error, HANDLE_TYPE_PRIVATE_KEY, [&](int *error) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         return wallet_get_private_view_key(pWallet, error);
     });
@@ -1304,11 +2230,896 @@ Java_com_tari_android_wallet_ffi_FFIWallet_jniGetTxPayRefs(
         jstring jTxId,
         jobject error
 ) {
-    return ExecuteWithErrorAndCast<TariPaymentRecords *>(jEnv, error, [&](int *errorPointer) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TariPaymentRecords *>(jEnv, error, HANDLE_TYPE_PAYMENT_RECORDS, [&](int *errorPointer) {
         auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
         const char *nativeString = jEnv->GetStringUTFChars(jTxId, JNI_FALSE);
         char *pEnd;
         unsigned long long id = strtoull(nativeString, &pEnd, 10);
         return wallet_get_transaction_payrefs(pWallet, id, errorPointer);
     });
-}
\ No newline at end of file
+}
+// The call stats entry points are left out of JNI_ENTRY_POINT on purpose, they would record themselves into the
+// stats they read or reset.
+extern "C"
+JNIEXPORT jobjectArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCallStatsNames(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    std::vector<std::string> names;
+    for (CallStats *pStats : GetCallStatsRegistry().all()) {
+        names.emplace_back(pStats->name);
+    }
+    return NewStringArray(jEnv, names);
+}
+
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetDroppedCallbackCount(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    return static_cast<jlong>(g_callbackGate.droppedCount());
+}
+
+/**
+ * Stats of the first count entry points in the order of jniGetCallStatsNames, CALL_STATS_FIELDS values each.
+ */
+extern "C"
+JNIEXPORT jlongArray JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetCallStatsValues(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jint count) {
+    std::vector<CallStats *> stats = GetCallStatsRegistry().all();
+    stats.resize(std::min(stats.size(), static_cast<size_t>(count)));
+    return NewCallStatsValues(jEnv, stats);
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniResetCallStats(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    GetCallStatsRegistry().reset();
+}
+
+// error code of the jobs skipped because their wallet was destroyed first, WalletError.UnknownError in Kotlin
+constexpr int WALLET_JOB_CANCELLED_ERROR_CODE = -1;
+
+/**
+ * Indexes of the maxCount latest txs of the list, latest first. Only the timestamps are read for this, the snapshot
+ * records are then built for the kept txs alone.
+ */
+std::vector<unsigned int> GetLatestTxIndexes(TariCompletedTransactions *pTxs, size_t maxCount, int *errorPointer) {
+    using TimestampIndex = std::pair<uint64_t, unsigned int>;
+    // min-heap, the top is the oldest tx kept so far
+    std::priority_queue<TimestampIndex, std::vector<TimestampIndex>, std::greater<TimestampIndex>> latest;
+    unsigned int length = completed_transactions_get_length(pTxs, errorPointer);
+    for (unsigned int i = 0; i < length && maxCount > 0 && *errorPointer == 0; i++) {
+        TariCompletedTransaction *pTx = completed_transactions_get_at(pTxs, i, errorPointer);
+        if (pTx == nullptr) {
+            continue;
+        }
+        uint64_t timestamp = completed_transaction_get_timestamp(pTx, errorPointer);
+        completed_transaction_destroy(pTx);
+        if (latest.size() < maxCount) {
+            latest.emplace(timestamp, i);
+        } else if (timestamp > latest.top().first) {
+            latest.pop();
+            latest.emplace(timestamp, i);
+        }
+    }
+    std::vector<unsigned int> indexes(latest.size());
+    for (size_t i = indexes.size(); i > 0; i--) {
+        indexes[i - 1] = latest.top().second;
+        latest.pop();
+    }
+    return indexes;
+}
+
+/**
+ * Reads one completed transaction into a snapshot record, the counterparty is the destination of outbound txs.
+ */
+bool ReadWarmStartSnapshotTx(TariCompletedTransaction *pTx, WarmStartSnapshotTx &record, int *errorPointer) {
+    memset(&record, 0, sizeof(record));
+    record.id = completed_transaction_get_transaction_id(pTx, errorPointer);
+    record.amount = completed_transaction_get_amount(pTx, errorPointer);
+    record.fee = completed_transaction_get_fee(pTx, errorPointer);
+    record.timestamp = completed_transaction_get_timestamp(pTx, errorPointer);
+    record.minedTimestamp = completed_transaction_get_mined_timestamp(pTx, errorPointer);
+    record.minedHeight = completed_transaction_get_mined_height(pTx, errorPointer);
+    record.status = completed_transaction_get_status(pTx, errorPointer);
+    record.isOutbound = completed_transaction_is_outbound(pTx, errorPointer) ? 1 : 0;
+    if (*errorPointer != 0) {
+        return false;
+    }
+
+    std::vector<uint8_t> address = TakeAddressBytes(record.isOutbound
+                                                    ? completed_transaction_get_destination_tari_address(pTx, errorPointer)
+                                                    : completed_transaction_get_source_tari_address(pTx, errorPointer),
+                                                    errorPointer);
+    if (address.size() <= WARM_START_ADDRESS_SIZE) {
+        memcpy(record.address, address.data(), address.size());
+        record.addressLength = static_cast<uint8_t>(address.size());
+    }
+
+    // the payment id is optional for the snapshot, a tx without one is still worth showing
+    int paymentIdError = 0;
+    const char *pPaymentId = completed_transaction_get_user_payment_id(pTx, &paymentIdError);
+    if (paymentIdError == 0 && pPaymentId != nullptr) {
+        record.paymentIdLength = static_cast<uint16_t>(CopyUtf8Truncated(pPaymentId, record.paymentId, WARM_START_PAYMENT_ID_SIZE));
+    }
+    string_destroy(const_cast<char *>(pPaymentId));
+    return *errorPointer == 0;
+}
+
+/**
+ * The balance and the maxTxCount latest completed txs of the wallet, written to path.
+ */
+bool WriteWalletWarmStartSnapshot(TariWallet *pWallet, const std::string &path, size_t maxTxCount, uint64_t scannedHeight,
+                                  int *errorPointer) {
+    WarmStartSnapshotHeader header{};
+    header.savedAtMillis = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    header.scannedHeight = scannedHeight;
+
+    TariBalance *pBalance = wallet_get_balance(pWallet, errorPointer);
+    if (pBalance == nullptr || *errorPointer != 0) {
+        return false;
+    }
+    header.availableBalance = balance_get_available(pBalance, errorPointer);
+    header.pendingIncomingBalance = balance_get_pending_incoming(pBalance, errorPointer);
+    header.pendingOutgoingBalance = balance_get_pending_outgoing(pBalance, errorPointer);
+    header.timeLockedBalance = balance_get_time_locked(pBalance, errorPointer);
+    balance_destroy(pBalance);
+
+    TariCompletedTransactions *pTxs = wallet_get_completed_transactions(pWallet, 0, errorPointer);
+    if (pTxs == nullptr || *errorPointer != 0) {
+        return false;
+    }
+    // latest first, only the ones the home screen shows
+    std::vector<unsigned int> indexes = GetLatestTxIndexes(pTxs, maxTxCount, errorPointer);
+    std::vector<WarmStartSnapshotTx> records(indexes.size());
+    size_t count = 0;
+    for (size_t i = 0; i < indexes.size() && *errorPointer == 0; i++) {
+        TariCompletedTransaction *pTx = completed_transactions_get_at(pTxs, indexes[i], errorPointer);
+        if (pTx != nullptr && ReadWarmStartSnapshotTx(pTx, records[count], errorPointer)) {
+            count++;
+        }
+        completed_transaction_destroy(pTx);
+    }
+    completed_transactions_destroy(pTxs);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    records.resize(count);
+    return WriteWarmStartSnapshot(path, header, records);
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniWriteWarmStartSnapshot(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jDatastorePath,
+        jint maxTxCount,
+        jlong scannedHeight,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) -> jboolean {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        // counts as a wallet job, so jniDestroy waits for the write to finish
+        WalletJobTracker &jobTracker = GetWalletJobTracker();
+        if (!jobTracker.begin(pWallet)) {
+            *errorPointer = WALLET_JOB_CANCELLED_ERROR_CODE;
+            return JNI_FALSE;
+        }
+        std::string path = GetWarmStartSnapshotPath(GetStdString(jEnv, jDatastorePath));
+        bool written = WriteWalletWarmStartSnapshot(pWallet, path, static_cast<size_t>(std::max(maxTxCount, 0)),
+                                                    static_cast<uint64_t>(scannedHeight), errorPointer);
+        jobTracker.end(pWallet);
+        return written ? JNI_TRUE : JNI_FALSE;
+    });
+}
+
+/**
+ * Appends a row for every tx of a wallet list and destroys the list.
+ */
+template <typename L, typename T, typename... A>
+bool AppendTxHistoryRows(L *pTxs, unsigned int (*getLength)(L *, int *), T *(*getAt)(L *, unsigned int, int *),
+                         void (*destroyTx)(T *), void (*destroyTxs)(L *), std::vector<TxHistoryRow> &rows, int *errorPointer,
+                         A... args) {
+    if (pTxs == nullptr || *errorPointer != 0) {
+        return false;
+    }
+    unsigned int length = getLength(pTxs, errorPointer);
+    rows.reserve(rows.size() + length);
+    for (unsigned int i = 0; i < length && *errorPointer == 0; i++) {
+        T *pTx = getAt(pTxs, i, errorPointer);
+        TxHistoryRow row;
+        if (pTx != nullptr && ReadTxHistoryRow(pTx, args..., row, errorPointer)) {
+            rows.push_back(std::move(row));
+        }
+        destroyTx(pTx);
+    }
+    destroyTxs(pTxs);
+    return *errorPointer == 0;
+}
+
+/**
+ * Rebuilds the tx history index from the tx lists of the wallet, after it's opened and whenever it may have missed
+ * callbacks.
+ *
+ * @return the number of txs indexed, -1 if the index isn't open or couldn't be written
+ */
+extern "C"
+JNIEXPORT jint JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniSyncTxHistoryIndex(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jint>(jEnv, error, [&](int *errorPointer) -> jint {
+        TxHistoryIndex &index = GetTxHistoryIndex();
+        // rows queued before the lists are read are older than them
+        if (!index.flush()) {
+            return -1;
+        }
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        std::vector<TxHistoryRow> rows;
+        if (!AppendTxHistoryRows(wallet_get_completed_transactions(pWallet, 0, errorPointer), completed_transactions_get_length,
+                                 completed_transactions_get_at, completed_transaction_destroy, completed_transactions_destroy,
+                                 rows, errorPointer, TX_HISTORY_KIND_COMPLETED) ||
+            !AppendTxHistoryRows(wallet_get_cancelled_transactions(pWallet, 0, errorPointer), completed_transactions_get_length,
+                                 completed_transactions_get_at, completed_transaction_destroy, completed_transactions_destroy,
+                                 rows, errorPointer, TX_HISTORY_KIND_CANCELLED) ||
+            !AppendTxHistoryRows(wallet_get_pending_inbound_transactions(pWallet, 0, errorPointer),
+                                 pending_inbound_transactions_get_length, pending_inbound_transactions_get_at,
+                                 pending_inbound_transaction_destroy, pending_inbound_transactions_destroy, rows, errorPointer) ||
+            !AppendTxHistoryRows(wallet_get_pending_outbound_transactions(pWallet, 0, errorPointer),
+                                 pending_outbound_transactions_get_length, pending_outbound_transactions_get_at,
+                                 pending_outbound_transaction_destroy, pending_outbound_transactions_destroy, rows, errorPointer)) {
+            return -1;
+        }
+        if (!index.replaceAll(rows)) {
+            LOGE("Tx history index not written: %s", index.lastError().c_str());
+            return -1;
+        }
+        return static_cast<jint>(rows.size());
+    });
+}
+
+bool ReadTxColumnRow(TariCompletedTransaction *pTx, TxColumnRow &row, int *errorPointer) {
+    row.timestamp = static_cast<int64_t>(completed_transaction_get_timestamp(pTx, errorPointer));
+    row.amount = completed_transaction_get_amount(pTx, errorPointer);
+    row.fee = completed_transaction_get_fee(pTx, errorPointer);
+    row.isOutbound = completed_transaction_is_outbound(pTx, errorPointer);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    row.counterparty = TakeAddressBytes(row.isOutbound
+                                        ? completed_transaction_get_destination_tari_address(pTx, errorPointer)
+                                        : completed_transaction_get_source_tari_address(pTx, errorPointer), errorPointer);
+    return *errorPointer == 0;
+}
+
+/**
+ * Reads the completed txs of the wallet into a column snapshot, the aggregations of FFITxColumnSnapshot then run
+ * over it without calling libwallet.
+ */
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetTxColumnSnapshot(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithHandle<TxColumnSnapshot *>(jEnv, error, HANDLE_TYPE_TX_COLUMN_SNAPSHOT, [&](int *errorPointer) -> TxColumnSnapshot * {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        TariCompletedTransactions *pTxs = wallet_get_completed_transactions(pWallet, 0, errorPointer);
+        if (pTxs == nullptr) {
+            return nullptr;
+        }
+        std::vector<TxColumnRow> rows(completed_transactions_get_length(pTxs, errorPointer));
+        for (unsigned int i = 0; i < rows.size() && *errorPointer == 0; i++) {
+            TariCompletedTransaction *pTx = completed_transactions_get_at(pTxs, i, errorPointer);
+            if (pTx != nullptr) {
+                ReadTxColumnRow(pTx, rows[i], errorPointer);
+                completed_transaction_destroy(pTx);
+            }
+        }
+        completed_transactions_destroy(pTxs);
+        if (*errorPointer != 0) {
+            return nullptr;
+        }
+        return new TxColumnSnapshot(std::move(rows));
+    });
+}
+
+constexpr unsigned int TX_EXPORT_PROGRESS_INTERVAL = 256;
+
+/**
+ * Calls FFITxHistoryExport.Listener.onProgress on the exporting thread with the kind of the list being exported and
+ * how many of its txs are written, every TX_EXPORT_PROGRESS_INTERVAL txs and once the list is done.
+ */
+class TxExportProgress {
+public:
+    TxExportProgress(JNIEnv *jEnv, jobject jListener) : jEnv_(jEnv), jListener_(jListener) {
+        if (jListener != nullptr) {
+            jclass listenerClass = jEnv->GetObjectClass(jListener);
+            onProgress_ = jEnv->GetMethodID(listenerClass, "onProgress", "(III)V");
+            jEnv->DeleteLocalRef(listenerClass);
+        }
+    }
+
+    /**
+     * @return false if the listener threw, the export stops and the exception goes to the caller
+     */
+    bool report(int kind, unsigned int exported, unsigned int total) {
+        if (onProgress_ == nullptr) {
+            return true;
+        }
+        jEnv_->CallVoidMethod(jListener_, onProgress_, static_cast<jint>(kind), static_cast<jint>(exported), static_cast<jint>(total));
+        return !jEnv_->ExceptionCheck();
+    }
+
+private:
+    JNIEnv *jEnv_;
+    jobject jListener_;
+    jmethodID onProgress_ = nullptr;
+};
+
+void TakeAddressBase58(TariWalletAddress *pAddress, std::string &out, int *errorPointer) {
+    std::vector<uint8_t> bytes = TakeAddressBytes(pAddress, errorPointer);
+    AppendTariAddressBase58(bytes.data(), bytes.size(), out);
+}
+
+void AppendWalletString(char *pString, std::string &out) {
+    if (pString != nullptr) {
+        out.append(pString);
+        string_destroy(pString);
+    }
+}
+
+/**
+ * Reads a completed or cancelled tx. The kernel and the payment references are left out when libwallet has none,
+ * only completed txs have payment references.
+ */
+bool ReadTxExportRecord(TariWallet *pWallet, TariCompletedTransaction *pTx, int kind, TxExportRecord &record, int *errorPointer) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+    record.kind = kind == TX_HISTORY_KIND_CANCELLED ? "cancelled" : "completed";
+    record.id = completed_transaction_get_transaction_id(pTx, errorPointer);
+    record.status = completed_transaction_get_status(pTx, errorPointer);
+    record.isOutbound = completed_transaction_is_outbound(pTx, errorPointer);
+    record.amount = completed_transaction_get_amount(pTx, errorPointer);
+    record.fee = completed_transaction_get_fee(pTx, errorPointer);
+    record.timestamp = completed_transaction_get_timestamp(pTx, errorPointer);
+    record.minedTimestamp = completed_transaction_get_mined_timestamp(pTx, errorPointer);
+    record.minedHeight = completed_transaction_get_mined_height(pTx, errorPointer);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    TakeAddressBase58(completed_transaction_get_source_tari_address(pTx, errorPointer), record.sourceAddress, errorPointer);
+    TakeAddressBase58(completed_transaction_get_destination_tari_address(pTx, errorPointer), record.destinationAddress, errorPointer);
+
+    int optionalError = 0;
+    AppendWalletString(completed_transaction_get_user_payment_id(pTx, &optionalError), record.paymentId);
+    optionalError = 0;
+    TariTransactionKernel *pKernel = completed_transaction_get_transaction_kernel(pTx, &optionalError);
+    if (pKernel != nullptr) {
+        AppendWalletString(transaction_kernel_get_excess_hex(pKernel, &optionalError), record.kernelExcess);
+        transaction_kernel_destroy(pKernel);
+    }
+    if (kind == TX_HISTORY_KIND_COMPLETED) {
+        optionalError = 0;
+        TariPaymentRecords *pRecords = wallet_get_transaction_payrefs(pWallet, record.id, &optionalError);
+        if (pRecords != nullptr) {
+            unsigned int length = payment_records_get_length(pRecords, &optionalError);
+            for (unsigned int i = 0; i < length && optionalError == 0; i++) {
+                TariPaymentRecord *pRecord = payment_records_get_at(pRecords, i, &optionalError);
+                for (size_t j = 0; pRecord != nullptr && j < sizeof(pRecord->payment_reference); j++) {
+                    record.paymentReferences.push_back(HEX_DIGITS[pRecord->payment_reference[j] >> 4]);
+                    record.paymentReferences.push_back(HEX_DIGITS[pRecord->payment_reference[j] & 0x0F]);
+                }
+            }
+            payment_records_destroy(pRecords);
+        }
+    }
+    return *errorPointer == 0;
+}
+
+bool ReadTxExportRecord(TariWallet *, TariPendingInboundTransaction *pTx, TxExportRecord &record, int *errorPointer) {
+    record.kind = "pending_inbound";
+    record.id = pending_inbound_transaction_get_transaction_id(pTx, errorPointer);
+    record.status = pending_inbound_transaction_get_status(pTx, errorPointer);
+    record.amount = pending_inbound_transaction_get_amount(pTx, errorPointer);
+    record.timestamp = pending_inbound_transaction_get_timestamp(pTx, errorPointer);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    TakeAddressBase58(pending_inbound_transaction_get_source_tari_address(pTx, errorPointer), record.sourceAddress, errorPointer);
+    int paymentIdError = 0;
+    AppendWalletString(pending_inbound_transaction_get_payment_id(pTx, &paymentIdError), record.paymentId);
+    return *errorPointer == 0;
+}
+
+bool ReadTxExportRecord(TariWallet *, TariPendingOutboundTransaction *pTx, TxExportRecord &record, int *errorPointer) {
+    record.kind = "pending_outbound";
+    record.id = pending_outbound_transaction_get_transaction_id(pTx, errorPointer);
+    record.status = pending_outbound_transaction_get_status(pTx, errorPointer);
+    record.isOutbound = true;
+    record.amount = pending_outbound_transaction_get_amount(pTx, errorPointer);
+    record.fee = pending_outbound_transaction_get_fee(pTx, errorPointer);
+    record.timestamp = pending_outbound_transaction_get_timestamp(pTx, errorPointer);
+    if (*errorPointer != 0) {
+        return false;
+    }
+    TakeAddressBase58(pending_outbound_transaction_get_destination_tari_address(pTx, errorPointer), record.destinationAddress,
+                      errorPointer);
+    int paymentIdError = 0;
+    AppendWalletString(pending_outbound_transaction_get_payment_id(pTx, &paymentIdError), record.paymentId);
+    return *errorPointer == 0;
+}
+
+/**
+ * Writes every tx of a list taken from libwallet and destroys it. Each tx is read into the one record and destroyed
+ * before the next, so only the list itself grows with the history.
+ */
+template <typename L, typename T, typename G, typename... A>
+bool ExportTxList(TariWallet *pWallet, L *pTxs, unsigned int (*getLength)(L *, int *), G getAt, void (*destroyTx)(T *),
+                  void (*destroyTxs)(L *), int kind, TxHistoryExportWriter &writer, TxExportProgress &progress,
+                  int *errorPointer, A... args) {
+    if (pTxs == nullptr) {
+        return false;
+    }
+    TxExportRecord record;
+    unsigned int length = getLength(pTxs, errorPointer);
+    bool exported = *errorPointer == 0;
+    for (unsigned int i = 0; i < length && exported; i++) {
+        T *pTx = getAt(pTxs, i, errorPointer);
+        if (pTx == nullptr) {
+            exported = false;
+            break;
+        }
+        record.clear();
+        exported = ReadTxExportRecord(pWallet, pTx, args..., record, errorPointer) && writer.write(record);
+        destroyTx(pTx);
+        if (exported && (i + 1) % TX_EXPORT_PROGRESS_INTERVAL == 0 && i + 1 < length) {
+            exported = progress.report(kind, i + 1, length);
+        }
+    }
+    destroyTxs(pTxs);
+    return exported && progress.report(kind, length, length);
+}
+
+/**
+ * Streams the completed, pending inbound, pending outbound and cancelled txs to a file descriptor the caller keeps
+ * owning, as TX_EXPORT_FORMAT_CSV or TX_EXPORT_FORMAT_JSON. libwallet has no paged getters, so the lists are taken
+ * one at a time and each is released before the next: memory is O(largest list), the rows go through a fixed size
+ * buffer.
+ *
+ * @return the number of txs written, -1 with error 1 if the format isn't valid, -1 if reading the wallet or
+ * writing the file failed or the listener threw
+ */
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniExportTxHistory(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jint jFd,
+        jint jFormat,
+        jobject jListener,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
+        if (jFd < 0 || !TxHistoryExportWriter::isValidFormat(jFormat)) {
+            *errorPointer = 1;
+            return -1;
+        }
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        TxHistoryExportWriter writer(jFd, jFormat);
+        TxExportProgress progress(jEnv, jListener);
+        bool exported = writer.begin() &&
+                        ExportTxList(pWallet, wallet_get_completed_transactions(pWallet, 0, errorPointer),
+                                     completed_transactions_get_length, completed_transactions_get_at,
+                                     completed_transaction_destroy, completed_transactions_destroy, TX_HISTORY_KIND_COMPLETED,
+                                     writer, progress, errorPointer, TX_HISTORY_KIND_COMPLETED) &&
+                        ExportTxList(pWallet, wallet_get_pending_inbound_transactions(pWallet, 0, errorPointer),
+                                     pending_inbound_transactions_get_length, pending_inbound_transactions_get_at,
+                                     pending_inbound_transaction_destroy, pending_inbound_transactions_destroy,
+                                     TX_HISTORY_KIND_PENDING_INBOUND, writer, progress, errorPointer) &&
+                        ExportTxList(pWallet, wallet_get_pending_outbound_transactions(pWallet, 0, errorPointer),
+                                     pending_outbound_transactions_get_length, pending_outbound_transactions_get_at,
+                                     pending_outbound_transaction_destroy, pending_outbound_transactions_destroy,
+                                     TX_HISTORY_KIND_PENDING_OUTBOUND, writer, progress, errorPointer) &&
+                        ExportTxList(pWallet, wallet_get_cancelled_transactions(pWallet, 0, errorPointer),
+                                     completed_transactions_get_length, completed_transactions_get_at,
+                                     completed_transaction_destroy, completed_transactions_destroy, TX_HISTORY_KIND_CANCELLED,
+                                     writer, progress, errorPointer, TX_HISTORY_KIND_CANCELLED) &&
+                        writer.finish();
+        if (!exported) {
+            if (writer.writeError() != 0) {
+                LOGE("Tx history export not written: %s", strerror(writer.writeError()));
+            }
+            return -1;
+        }
+        return static_cast<jlong>(writer.rowCount());
+    });
+}
+
+/**
+ * Blocking wallet operations run on a native pool as jobs. The async entry points return the job id right away,
+ * or 0 if the pool is full, and the result comes back through the job completed callback:
+ * the tx id, the result pointer or 1 for true, and the libwallet error code.
+ */
+const size_t WALLET_JOB_CAPACITY = 32;
+
+WorkerPool &GetWalletWorkerPool() {
+    // worker threads stay attached to the VM between jobs and detach when the pool goes away
+    static WorkerPool pool(
+            std::max(2u, std::min(4u, std::thread::hardware_concurrency() / 2)),
+            WALLET_JOB_CAPACITY,
+            [] { g_vm->DetachCurrentThread(); });
+    return pool;
+}
+
+void postJobCompleted(uint64_t jobId, jlong result, int errorCode) {
+    CallbackHandlerScope handlerScope;
+    if (!handlerScope || jobCompletedCallbackMethodId == nullptr) {
+        return;
+    }
+    JNIEnv *jniEnv = getJNIEnv();
+    if (jniEnv == nullptr) {
+        return;
+    }
+    jbyteArray contextBytes = getBytesFromUnsignedLongLong(jniEnv, reinterpret_cast<uint64_t>(g_walletContext));
+    jniEnv->CallVoidMethod(handlerScope.handler(), jobCompletedCallbackMethodId, contextBytes, static_cast<jlong>(jobId), result,
+                           static_cast<jint>(errorCode));
+    jniEnv->DeleteLocalRef(contextBytes);
+    handlerScope.release(jniEnv);
+}
+
+void deleteGlobalRefs(JNIEnv *jniEnv, const std::vector<jobject> &refs) {
+    if (jniEnv == nullptr) {
+        return;
+    }
+    for (jobject ref : refs) {
+        jniEnv->DeleteGlobalRef(ref);
+    }
+}
+
+/**
+ * The job gets the error pointer and returns the result, it must own everything it uses besides the wallet and the
+ * native objects of jObjects. Those are held by global refs until the job completes, so the FFI objects aren't
+ * finalized while it runs. It's counted by the WalletJobTracker until its completion is posted, so jniDestroy waits
+ * for it.
+ *
+ * @return the job id, 0 if the pool is full or the wallet is being destroyed
+ */
+template <typename F>
+jlong SubmitWalletJob(JNIEnv *jEnv, TariWallet *pWallet, std::initializer_list<jobject> jObjects, F &&job) {
+    WalletJobTracker &tracker = GetWalletJobTracker();
+    if (!tracker.begin(pWallet)) {
+        return 0;
+    }
+    std::vector<jobject> refs;
+    for (jobject jObject : jObjects) {
+        refs.push_back(jEnv->NewGlobalRef(jObject));
+    }
+    uint64_t jobId = GetWalletWorkerPool().submit([pWallet, refs, job = std::forward<F>(job)](uint64_t id) mutable {
+        TraceSpan traceSpan("wallet job", TRACE_CATEGORY_JNI);
+        WalletJobTracker &tracker = GetWalletJobTracker();
+        int errorCode = WALLET_JOB_CANCELLED_ERROR_CODE;
+        jlong result = 0;
+        if (!tracker.isClosing(pWallet)) {
+            errorCode = 0;
+            result = job(&errorCode);
+        }
+        postJobCompleted(id, result, errorCode);
+        if (!refs.empty()) {
+            deleteGlobalRefs(getJNIEnv(), refs);
+        }
+        tracker.end(pWallet);
+    });
+    if (jobId == 0) {
+        deleteGlobalRefs(jEnv, refs);
+        tracker.end(pWallet);
+    }
+    return static_cast<jlong>(jobId);
+}
+
+template <typename F>
+jlong SubmitWalletJob(TariWallet *pWallet, F &&job) {
+    return SubmitWalletJob(nullptr, pWallet, {}, std::forward<F>(job));
+}
+
+std::vector<std::string> GetStdStrings(JNIEnv *jEnv, jobjectArray jStrings) {
+    jsize size = jEnv->GetArrayLength(jStrings);
+    std::vector<std::string> result;
+    result.reserve(static_cast<size_t>(size));
+    for (jsize i = 0; i < size; i++) {
+        auto jString = static_cast<jstring>(jEnv->GetObjectArrayElement(jStrings, i));
+        result.push_back(GetStdString(jEnv, jString));
+        jEnv->DeleteLocalRef(jString);
+    }
+    return result;
+}
+
+TariVector *CreateCommitmentsVector(const std::vector<std::string> &commitments, int *errorPointer) {
+    auto *pTariVector = create_tari_vector(Text);
+    for (const auto &commitment: commitments) {
+        tari_vector_push_string(pTariVector, commitment.c_str(), errorPointer);
+    }
+    return pTariVector;
+}
+
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniJoinUtxosAsync(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobjectArray jCommitments,
+        jstring jFeePerGram) {
+    JNI_ENTRY_POINT();
+    auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+    std::vector<std::string> commitments = GetStdStrings(jEnv, jCommitments);
+    unsigned long long feePerGram = strtoull(GetStdString(jEnv, jFeePerGram).c_str(), nullptr, 10);
+    return SubmitWalletJob(pWallet, [pWallet, commitments = std::move(commitments), feePerGram](int *errorPointer) {
+        TariVector *pTariVector = CreateCommitmentsVector(commitments, errorPointer);
+        auto txId = wallet_coin_join(pWallet, pTariVector, feePerGram, errorPointer);
+        destroy_tari_vector(pTariVector);
+        return static_cast<jlong>(txId);
+    });
+}
+
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniSplitUtxosAsync(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobjectArray jCommitments,
+        jstring jSplitCount,
+        jstring jFeePerGram) {
+    JNI_ENTRY_POINT();
+    auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+    std::vector<std::string> commitments = GetStdStrings(jEnv, jCommitments);
+    auto splitCount = static_cast<uintptr_t>(strtoull(GetStdString(jEnv, jSplitCount).c_str(), nullptr, 10));
+    unsigned long long feePerGram = strtoull(GetStdString(jEnv, jFeePerGram).c_str(), nullptr, 10);
+    return SubmitWalletJob(pWallet, [pWallet, commitments = std::move(commitments), splitCount, feePerGram](int *errorPointer) {
+        TariVector *pTariVector = CreateCommitmentsVector(commitments, errorPointer);
+        auto txId = wallet_coin_split(pWallet, pTariVector, splitCount, feePerGram, errorPointer);
+        destroy_tari_vector(pTariVector);
+        return static_cast<jlong>(txId);
+    });
+}
+
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniSendTxAsync(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject jDestination,
+        jstring jAmount,
+        jstring jFeePerGram,
+        jstring jPaymentId) {
+    JNI_ENTRY_POINT();
+    auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+    auto pDestination = GetPointerField<TariWalletAddress *>(jEnv, jDestination);
+    unsigned long long amount = strtoull(GetStdString(jEnv, jAmount).c_str(), nullptr, 10);
+    unsigned long long feePerGram = strtoull(GetStdString(jEnv, jFeePerGram).c_str(), nullptr, 10);
+    std::string paymentId = GetStdString(jEnv, jPaymentId);
+    int64_t sentNanos = TxLifecycleTracker::nowNanos();
+    return SubmitWalletJob(jEnv, pWallet, {jDestination}, [pWallet, pDestination, amount, feePerGram, paymentId = std::move(paymentId), sentNanos](int *errorPointer) {
+        unsigned long long txId = wallet_send_transaction(pWallet, pDestination, amount, nullptr, feePerGram, true,
+                                                          paymentId.c_str(), errorPointer);
+        if (*errorPointer == 0) {
+            GetTxLifecycleTracker().startTracking(txId, sentNanos);
+            indexSentTx(pWallet, txId);
+        }
+        return static_cast<jlong>(txId);
+    });
+}
+
+/**
+ * The items of a batch send, shared by its senders.
+ */
+struct BatchSendItems {
+    TariWallet *pWallet;
+    uint64_t batchId;
+    unsigned long long feePerGram;
+    std::vector<TariWalletAddress *> destinations;
+    std::vector<unsigned long long> amounts;
+    std::vector<std::string> paymentIds;
+    std::vector<uint64_t> txIds;
+    std::vector<int> errorCodes;
+    std::atomic<size_t> nextIndex{0};
+    std::mutex mutex;
+    std::condition_variable allSent;
+    size_t sentCount = 0;
+
+    size_t count() const {
+        return txIds.size();
+    }
+
+    /**
+     * Sends items until there's none left. Once the wallet is being destroyed the rest fail with
+     * WALLET_JOB_CANCELLED_ERROR_CODE without being sent.
+     */
+    void send() {
+        for (size_t index = nextIndex.fetch_add(1); index < count(); index = nextIndex.fetch_add(1)) {
+            int errorCode = 0;
+            int64_t sentNanos = TxLifecycleTracker::nowNanos();
+            unsigned long long txId = 0;
+            if (GetWalletJobTracker().isClosing(pWallet)) {
+                errorCode = WALLET_JOB_CANCELLED_ERROR_CODE;
+            } else {
+                txId = wallet_send_transaction(pWallet, destinations[index], amounts[index], nullptr, feePerGram, true,
+                                               paymentIds[index].c_str(), &errorCode);
+            }
+            if (errorCode == 0) {
+                GetTxLifecycleTracker().startTracking(txId, sentNanos);
+                indexSentTx(pWallet, txId);
+            }
+            GetBatchSendTracker().onSent(batchId, index, txId, errorCode);
+            txIds[index] = errorCode == 0 ? txId : 0;
+            errorCodes[index] = errorCode;
+            bool last;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                last = ++sentCount == count();
+            }
+            if (last) {
+                allSent.notify_all();
+            }
+        }
+    }
+};
+
+/**
+ * Sends a tx to every destination, with up to maxConcurrency sends at a time: the calling thread and pool workers.
+ * The tx ids and libwallet error codes of the items are written to jTxIds and jErrorCodes, a failed item has tx id 0.
+ * Once every sent tx has its direct send result, or the wait for them timed out, the batch completed callback reports
+ * all of them under the returned batch id.
+ *
+ * @return the batch id, 0 with NATIVE_ERROR_CHECK_FAILED if the arrays don't have the same length, 0 with error -1 if
+ * the wallet is being destroyed
+ */
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniSendTxBatch(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobjectArray jDestinations,
+        jlongArray jAmounts,
+        jlong jFeePerGram,
+        jobjectArray jPaymentIds,
+        jint maxConcurrency,
+        jlongArray jTxIds,
+        jintArray jErrorCodes,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jlong>(jEnv, error, [&](int *errorPointer) -> jlong {
+        jsize length = jEnv->GetArrayLength(jDestinations);
+        if (jEnv->GetArrayLength(jAmounts) != length || jEnv->GetArrayLength(jPaymentIds) != length ||
+            jEnv->GetArrayLength(jTxIds) != length || jEnv->GetArrayLength(jErrorCodes) != length) {
+            *errorPointer = NATIVE_ERROR_CHECK_FAILED;
+            return 0;
+        }
+        auto count = static_cast<size_t>(length);
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+        // the batch and each of its helpers count as wallet jobs, jniDestroy waits for them
+        WalletJobTracker &jobTracker = GetWalletJobTracker();
+        if (!jobTracker.begin(pWallet)) {
+            *errorPointer = WALLET_JOB_CANCELLED_ERROR_CODE;
+            return 0;
+        }
+        auto items = std::make_shared<BatchSendItems>();
+        items->pWallet = pWallet;
+        items->batchId = GetBatchSendTracker().start(count);
+        items->feePerGram = static_cast<unsigned long long>(jFeePerGram);
+        items->destinations.resize(count);
+        items->amounts.resize(count);
+        items->paymentIds.resize(count);
+        items->txIds.resize(count);
+        items->errorCodes.resize(count);
+        jEnv->GetLongArrayRegion(jAmounts, 0, length, reinterpret_cast<jlong *>(items->amounts.data()));
+        for (jsize i = 0; i < length; i++) {
+            jobject jDestination = jEnv->GetObjectArrayElement(jDestinations, i);
+            auto jPaymentId = static_cast<jstring>(jEnv->GetObjectArrayElement(jPaymentIds, i));
+            items->destinations[i] = GetPointerField<TariWalletAddress *>(jEnv, jDestination);
+            items->paymentIds[i] = GetStdString(jEnv, jPaymentId);
+            jEnv->DeleteLocalRef(jDestination);
+            jEnv->DeleteLocalRef(jPaymentId);
+        }
+
+        // the calling thread is one of the senders, the pool workers help with the rest
+        size_t helperCount = std::min(static_cast<size_t>(std::max(maxConcurrency, 1)) - 1,
+                                      std::min(GetWalletWorkerPool().threadCount(), std::max(count, static_cast<size_t>(1)) - 1));
+        for (size_t i = 0; i < helperCount && jobTracker.begin(pWallet); i++) {
+            if (GetWalletWorkerPool().submit([items](uint64_t) {
+                items->send();
+                GetWalletJobTracker().end(items->pWallet);
+            }) == 0) {
+                jobTracker.end(pWallet);
+                break;
+            }
+        }
+        items->send();
+        {
+            std::unique_lock<std::mutex> lock(items->mutex);
+            items->allSent.wait(lock, [&items] { return items->sentCount == items->count(); });
+        }
+
+        jEnv->SetLongArrayRegion(jTxIds, 0, length, reinterpret_cast<const jlong *>(items->txIds.data()));
+        jEnv->SetIntArrayRegion(jErrorCodes, 0, length, items->errorCodes.data());
+        std::vector<BatchSendCompletion> completions;
+        GetBatchSendTracker().onAllSent(items->batchId, TxLifecycleTracker::nowNanos(), completions);
+        postBatchSendCompletions(g_walletContext, completions);
+        jobTracker.end(pWallet);
+        return static_cast<jlong>(items->batchId);
+    });
+}
+
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniStartRecoveryAsync(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject jWalletCallbacks,
+        jstring callback,
+        jstring callback_sig) {
+    JNI_ENTRY_POINT();
+    auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+    recoveringProcessCompleteCallbackMethodId = getMethodId(jEnv, jWalletCallbacks, callback, callback_sig);
+    if (recoveringProcessCompleteCallbackMethodId == nullptr) {
+        return 0;
+    }
+    return SubmitWalletJob(pWallet, [pWallet](int *errorPointer) {
+        return static_cast<jlong>(wallet_start_recovery(pWallet, recoveringProcessCompleteCallback, errorPointer) ? 1 : 0);
+    });
+}
+
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniImportExternalUtxoAsNonRewindableAsync(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject jOutput,
+        jobject jSourceWalletAddress,
+        jstring jMessage) {
+    JNI_ENTRY_POINT();
+    auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+    auto pOutput = GetPointerField<TariUnblindedOutput *>(jEnv, jOutput);
+    auto pSourceWalletAddress = GetPointerField<TariWalletAddress *>(jEnv, jSourceWalletAddress);
+    std::string message = GetStdString(jEnv, jMessage);
+    return SubmitWalletJob(jEnv, pWallet, {jOutput, jSourceWalletAddress}, [pWallet, pOutput, pSourceWalletAddress, message = std::move(message)](int *errorPointer) {
+        return static_cast<jlong>(wallet_import_external_utxo_as_non_rewindable(pWallet, pOutput, pSourceWalletAddress,
+                                                                                message.c_str(), errorPointer));
+    });
+}
+
+/**
+ * Destroys the TariVector of a getAllUtxos job whose result nobody awaits anymore.
+ */
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniDestroyUtxos(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jlong jpUtxos) {
+    JNI_ENTRY_POINT();
+    destroy_tari_vector(reinterpret_cast<TariVector *>(jpUtxos));
+}
+
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWallet_jniGetAllUtxosAsync(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    auto pWallet = GetPointerField<TariWallet *>(jEnv, jThis);
+    return SubmitWalletJob(pWallet, [pWallet](int *errorPointer) {
+        return reinterpret_cast<jlong>(wallet_get_all_utxos(pWallet, errorPointer));
+    });
+}
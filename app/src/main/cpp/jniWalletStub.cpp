@@ -0,0 +1,119 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <jni.h>
+#include <android/log.h>
+#include <wallet.h>
+#include <walletStub.h>
+#include "jniCommon.cpp"
+
+/**
+ * Controls of the libwallet stand-in, only built into the library when it's linked instead of libwallet
+ * (NATIVE_WALLET_STUB in CMakeLists.txt).
+ */
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_tari_android_wallet_ffi_FFIWalletStub_jniSetDataset(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jint completedTxCount,
+        jint cancelledTxCount,
+        jint pendingInboundTxCount,
+        jint pendingOutboundTxCount,
+        jint utxoCount,
+        jint contactCount) {
+    JNI_ENTRY_POINT();
+    WalletStubDataset dataset{
+            static_cast<unsigned int>(completedTxCount),
+            static_cast<unsigned int>(cancelledTxCount),
+            static_cast<unsigned int>(pendingInboundTxCount),
+            static_cast<unsigned int>(pendingOutboundTxCount),
+            static_cast<unsigned int>(utxoCount),
+            static_cast<unsigned int>(contactCount)};
+    wallet_stub_set_dataset(&dataset);
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_tari_android_wallet_ffi_FFIWalletStub_jniResetDataset(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    wallet_stub_set_dataset(nullptr);
+}
+
+extern "C"
+JNIEXPORT jboolean JNICALL
+Java_com_tari_android_wallet_ffi_FFIWalletStub_jniStartEvents(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject jWallet,
+        jint pattern,
+        jint threadCount,
+        jint eventsPerSecond,
+        jint burstSize,
+        jlong eventCount,
+        jobject error) {
+    JNI_ENTRY_POINT();
+    return ExecuteWithError<jboolean>(jEnv, error, [&](int *errorPointer) {
+        auto pWallet = GetPointerField<TariWallet *>(jEnv, jWallet);
+        WalletStubEvents events{
+                pattern,
+                static_cast<unsigned int>(threadCount),
+                static_cast<unsigned int>(eventsPerSecond),
+                static_cast<unsigned int>(burstSize),
+                static_cast<unsigned long long>(eventCount)};
+        return static_cast<jboolean>(wallet_stub_start_events(pWallet, &events, errorPointer));
+    });
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_tari_android_wallet_ffi_FFIWalletStub_jniStopEvents(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject jWallet,
+        jboolean wait) {
+    JNI_ENTRY_POINT();
+    wallet_stub_stop_events(GetPointerField<TariWallet *>(jEnv, jWallet), wait == JNI_TRUE);
+}
+
+extern "C"
+JNIEXPORT jlong JNICALL
+Java_com_tari_android_wallet_ffi_FFIWalletStub_jniGetFiredEventCount(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jobject jWallet) {
+    JNI_ENTRY_POINT();
+    return static_cast<jlong>(wallet_stub_get_fired_event_count(GetPointerField<TariWallet *>(jEnv, jWallet)));
+}
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#include <jni.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "jniCommon.cpp"
+#include "warmStartSnapshot.cpp"
+
+/**
+ * The mapping handed out to Kotlin as a direct buffer, valid until jniUnmap.
+ */
+std::mutex g_warmStartSnapshotMutex;
+std::unique_ptr<WarmStartSnapshotMapping> g_warmStartSnapshot;
+
+extern "C"
+JNIEXPORT jobject JNICALL
+Java_com_tari_android_wallet_ffi_FFIWarmStartSnapshot_jniMap(
+        JNIEnv *jEnv,
+        jobject jThis,
+        jstring jDatastorePath) {
+    JNI_ENTRY_POINT();
+    std::lock_guard<std::mutex> lock(g_warmStartSnapshotMutex);
+    auto mapping = std::make_unique<WarmStartSnapshotMapping>();
+    if (!mapping->map(GetWarmStartSnapshotPath(GetStdString(jEnv, jDatastorePath)))) {
+        g_warmStartSnapshot.reset();
+        return nullptr;
+    }
+    g_warmStartSnapshot = std::move(mapping);
+    return jEnv->NewDirectByteBuffer(const_cast<uint8_t *>(g_warmStartSnapshot->data()), static_cast<jlong>(g_warmStartSnapshot->size()));
+}
+
+extern "C"
+JNIEXPORT void JNICALL
+Java_com_tari_android_wallet_ffi_FFIWarmStartSnapshot_jniUnmap(
+        JNIEnv *jEnv,
+        jobject jThis) {
+    JNI_ENTRY_POINT();
+    std::lock_guard<std::mutex> lock(g_warmStartSnapshotMutex);
+    g_warmStartSnapshot.reset();
+}
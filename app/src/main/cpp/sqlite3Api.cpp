@@ -0,0 +1,77 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef SQLITE3_API_CPP
+#define SQLITE3_API_CPP
+
+/**
+ * The part of the SQLite C API the native library uses. libsqlite3.a comes with the libwallet download but without
+ * its header, these declarations match sqlite3.h of every 3.x release.
+ */
+extern "C" {
+
+typedef struct sqlite3 sqlite3;
+typedef struct sqlite3_stmt sqlite3_stmt;
+typedef void (*sqlite3_destructor_type)(void *);
+
+int sqlite3_open_v2(const char *filename, sqlite3 **ppDb, int flags, const char *zVfs);
+int sqlite3_close(sqlite3 *db);
+int sqlite3_exec(sqlite3 *db, const char *sql, int (*callback)(void *, int, char **, char **), void *arg, char **errmsg);
+int sqlite3_busy_timeout(sqlite3 *db, int ms);
+const char *sqlite3_errmsg(sqlite3 *db);
+int sqlite3_compileoption_used(const char *zOptName);
+
+int sqlite3_prepare_v2(sqlite3 *db, const char *zSql, int nByte, sqlite3_stmt **ppStmt, const char **pzTail);
+int sqlite3_bind_int64(sqlite3_stmt *stmt, int index, long long value);
+int sqlite3_bind_text(sqlite3_stmt *stmt, int index, const char *value, int n, sqlite3_destructor_type destructor);
+int sqlite3_bind_blob(sqlite3_stmt *stmt, int index, const void *value, int n, sqlite3_destructor_type destructor);
+int sqlite3_step(sqlite3_stmt *stmt);
+long long sqlite3_column_int64(sqlite3_stmt *stmt, int iCol);
+const unsigned char *sqlite3_column_text(sqlite3_stmt *stmt, int iCol);
+int sqlite3_reset(sqlite3_stmt *stmt);
+int sqlite3_clear_bindings(sqlite3_stmt *stmt);
+int sqlite3_finalize(sqlite3_stmt *stmt);
+
+}
+
+constexpr int SQLITE_OK = 0;
+constexpr int SQLITE_ROW = 100;
+constexpr int SQLITE_DONE = 101;
+
+constexpr int SQLITE_OPEN_READWRITE = 0x00000002;
+constexpr int SQLITE_OPEN_CREATE = 0x00000004;
+constexpr int SQLITE_OPEN_NOMUTEX = 0x00008000;
+
+// the value is copied by the bind call
+inline const sqlite3_destructor_type SQLITE_TRANSIENT = reinterpret_cast<sqlite3_destructor_type>(-1);
+
+#endif // SQLITE3_API_CPP
@@ -0,0 +1,159 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef TARI_ADDRESS_CODEC_CPP
+#define TARI_ADDRESS_CODEC_CPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * The parts of the Tari address encoding that don't need libwallet.
+ *
+ * The Tari emoji set is fixed: every byte of an address maps to one of 256 single code point emojis.
+ * The code points below are in the same order as get_emoji_set(), so the index of an emoji is the
+ * byte it encodes.
+ */
+
+constexpr int EMOJI_SET_SIZE = 256;
+
+constexpr uint32_t EMOJI_CODEPOINTS[EMOJI_SET_SIZE] = {
+        0x1F422, 0x1F4DF, 0x1F308, 0x1F30A, 0x1F3AF, 0x1F40B, 0x1F319, 0x1F914,
+        0x1F315, 0x02B50, 0x1F38B, 0x1F330, 0x1F334, 0x1F335, 0x1F332, 0x1F338,
+        0x1F339, 0x1F33B, 0x1F33D, 0x1F340, 0x1F341, 0x1F344, 0x1F951, 0x1F346,
+        0x1F347, 0x1F348, 0x1F349, 0x1F34A, 0x1F34B, 0x1F34C, 0x1F34D, 0x1F34E,
+        0x1F350, 0x1F351, 0x1F352, 0x1F353, 0x1F354, 0x1F355, 0x1F357, 0x1F35A,
+        0x1F35E, 0x1F35F, 0x1F95D, 0x1F363, 0x1F366, 0x1F369, 0x1F36A, 0x1F36B,
+        0x1F36C, 0x1F36D, 0x1F36F, 0x1F950, 0x1F373, 0x1F944, 0x1F375, 0x1F376,
+        0x1F377, 0x1F378, 0x1F37E, 0x1F37A, 0x1F37C, 0x1F380, 0x1F381, 0x1F382,
+        0x1F383, 0x1F916, 0x1F388, 0x1F389, 0x1F392, 0x1F393, 0x1F3A0, 0x1F3A1,
+        0x1F3A2, 0x1F3A3, 0x1F3A4, 0x1F3A5, 0x1F3A7, 0x1F3A8, 0x1F3A9, 0x1F3AA,
+        0x1F3AC, 0x1F3AD, 0x1F3AE, 0x1F3B0, 0x1F3B1, 0x1F3B2, 0x1F3B3, 0x1F3B5,
+        0x1F3B7, 0x1F3B8, 0x1F3B9, 0x1F3BA, 0x1F3BB, 0x1F3BC, 0x1F3BD, 0x1F3BE,
+        0x1F3BF, 0x1F3C0, 0x1F3C1, 0x1F3C6, 0x1F3C8, 0x026BD, 0x1F3E0, 0x1F3E5,
+        0x1F3E6, 0x1F3ED, 0x1F3F0, 0x1F400, 0x1F409, 0x1F40A, 0x1F40C, 0x1F40D,
+        0x1F981, 0x1F410, 0x1F411, 0x1F414, 0x1F648, 0x1F417, 0x1F418, 0x1F419,
+        0x1F41A, 0x1F41B, 0x1F41C, 0x1F41D, 0x1F41E, 0x1F98B, 0x1F423, 0x1F428,
+        0x1F980, 0x1F42A, 0x1F42C, 0x1F42D, 0x1F42E, 0x1F42F, 0x1F430, 0x1F986,
+        0x1F982, 0x1F434, 0x1F435, 0x1F436, 0x1F437, 0x1F438, 0x1F43A, 0x1F43B,
+        0x1F43C, 0x1F43D, 0x1F43E, 0x1F440, 0x1F445, 0x1F451, 0x1F452, 0x1F9E2,
+        0x1F485, 0x1F455, 0x1F456, 0x1F457, 0x1F458, 0x1F459, 0x1F483, 0x1F45B,
+        0x1F45E, 0x1F45F, 0x1F460, 0x1F94A, 0x1F462, 0x1F463, 0x1F921, 0x1F47B,
+        0x1F47D, 0x1F47E, 0x1F920, 0x1F443, 0x1F484, 0x1F488, 0x1F489, 0x1F48A,
+        0x1F48B, 0x1F442, 0x1F48D, 0x1F48E, 0x1F490, 0x1F494, 0x1F512, 0x1F9E9,
+        0x1F4A1, 0x1F4A3, 0x1F4A4, 0x1F4A6, 0x1F4A8, 0x1F4A9, 0x02795, 0x1F4AF,
+        0x1F4B0, 0x1F4B3, 0x1F4B5, 0x1F4BA, 0x1F4BB, 0x1F4BC, 0x1F4C8, 0x1F4DC,
+        0x1F4CC, 0x1F4CE, 0x1F4D6, 0x1F4FF, 0x1F4E1, 0x023F0, 0x1F4F1, 0x1F4F7,
+        0x1F50B, 0x1F50C, 0x1F6B0, 0x1F511, 0x1F514, 0x1F525, 0x1F526, 0x1F527,
+        0x1F528, 0x1F529, 0x1F52A, 0x1F52B, 0x1F52C, 0x1F52D, 0x1F52E, 0x1F531,
+        0x1F5FD, 0x1F602, 0x1F607, 0x1F608, 0x1F911, 0x1F60D, 0x1F60E, 0x1F631,
+        0x1F637, 0x1F922, 0x1F44D, 0x1F476, 0x1F680, 0x1F681, 0x1F682, 0x1F69A,
+        0x1F691, 0x1F692, 0x1F693, 0x1F6F5, 0x1F697, 0x1F69C, 0x1F6A2, 0x1F6A6,
+        0x1F6A7, 0x1F6A8, 0x1F6AA, 0x1F6AB, 0x1F6B2, 0x1F6BD, 0x1F6BF, 0x1F9F2,
+};
+
+// Tari address sizes: network + features + spend key + checksum, optionally with a view key and a payment id
+constexpr size_t SINGLE_ADDRESS_SIZE = 35;
+constexpr size_t DUAL_ADDRESS_SIZE = 67;
+
+/**
+ * DammSum over GF(2^8) as used by Tari addresses: the checksum of a valid address including its checksum byte is zero.
+ */
+inline uint8_t ComputeDammSum(const std::vector<uint8_t> &bytes) {
+    const uint8_t mask = 0x1B;
+    uint8_t result = 0;
+    for (uint8_t digit : bytes) {
+        result ^= digit;
+        bool overflow = (result & 0x80) != 0;
+        result = static_cast<uint8_t>(result << 1);
+        if (overflow) {
+            result ^= mask;
+        }
+    }
+    return result;
+}
+
+constexpr char BASE58_ALPHABET[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+
+/**
+ * Appends the base58 encoding of the bytes to out, with a leading '1' per leading zero byte like Base58String.kt.
+ */
+inline void AppendBase58(const uint8_t *pBytes, size_t length, std::string &out) {
+    size_t zeros = 0;
+    while (zeros < length && pBytes[zeros] == 0) {
+        zeros++;
+    }
+    // log(256) / log(58) < 1.37, addresses without a long payment id fit on the stack
+    size_t capacity = (length - zeros) * 137 / 100 + 1;
+    uint8_t stackDigits[256];
+    std::vector<uint8_t> heapDigits;
+    uint8_t *digits = stackDigits;
+    if (capacity > sizeof(stackDigits)) {
+        heapDigits.resize(capacity);
+        digits = heapDigits.data();
+    }
+    size_t digitCount = 0;
+    for (size_t i = zeros; i < length; i++) {
+        uint32_t carry = pBytes[i];
+        for (size_t j = 0; j < digitCount; j++) {
+            carry += static_cast<uint32_t>(digits[j]) << 8;
+            digits[j] = static_cast<uint8_t>(carry % 58);
+            carry /= 58;
+        }
+        while (carry > 0) {
+            digits[digitCount++] = static_cast<uint8_t>(carry % 58);
+            carry /= 58;
+        }
+    }
+    out.append(zeros, BASE58_ALPHABET[0]);
+    for (size_t i = digitCount; i > 0; i--) {
+        out.push_back(BASE58_ALPHABET[digits[i - 1]]);
+    }
+}
+
+/**
+ * Appends the full base58 form of an address to out: its network and features bytes are encoded on their own and
+ * followed by the rest, like TariWalletAddress.fullBase58.
+ */
+inline void AppendTariAddressBase58(const uint8_t *pBytes, size_t length, std::string &out) {
+    if (length < 2) {
+        AppendBase58(pBytes, length, out);
+        return;
+    }
+    AppendBase58(pBytes, 1, out);
+    AppendBase58(pBytes + 1, 1, out);
+    AppendBase58(pBytes + 2, length - 2, out);
+}
+
+#endif // TARI_ADDRESS_CODEC_CPP
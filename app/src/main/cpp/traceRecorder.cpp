@@ -0,0 +1,259 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TRACE_RECORDER_CPP
+#define TRACE_RECORDER_CPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+/**
+ * Trace event recorder for the native layer.
+ *
+ * Spans are recorded as complete events into a ring buffer owned by the recording thread, so threads never
+ * contend with each other. When recording is disabled a span costs one relaxed atomic load. The buffers can be
+ * written out as Chrome trace event JSON, which chrome://tracing, Perfetto and Android Studio open directly.
+ *
+ * Names and categories must be string literals or otherwise outlive the recorder, only the pointer is stored.
+ */
+
+constexpr size_t TRACE_BUFFER_CAPACITY = 8192;
+constexpr size_t TRACE_MAX_THREADS = 128;
+
+constexpr const char *TRACE_CATEGORY_JNI = "jni";
+constexpr const char *TRACE_CATEGORY_CALLBACK = "callback";
+constexpr const char *TRACE_CATEGORY_STARTUP = "startup";
+
+inline std::atomic<bool> g_traceEnabled{false};
+
+struct TraceEvent {
+    const char *name;
+    const char *category;
+    int64_t startNanos;
+    int64_t durationNanos;
+};
+
+class TraceBuffer {
+public:
+    explicit TraceBuffer(int64_t threadId) : threadId(threadId), events(TRACE_BUFFER_CAPACITY) {}
+
+    void add(const TraceEvent &event) {
+        std::lock_guard<std::mutex> lock(mutex);
+        events[count % TRACE_BUFFER_CAPACITY] = event;
+        count++;
+    }
+
+    // oldest first
+    std::vector<TraceEvent> snapshot() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<TraceEvent> result;
+        size_t size = count < TRACE_BUFFER_CAPACITY ? count : TRACE_BUFFER_CAPACITY;
+        result.reserve(size);
+        for (size_t i = count - size; i < count; i++) {
+            result.push_back(events[i % TRACE_BUFFER_CAPACITY]);
+        }
+        return result;
+    }
+
+    size_t dropped() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return count > TRACE_BUFFER_CAPACITY ? count - TRACE_BUFFER_CAPACITY : 0;
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex);
+        count = 0;
+    }
+
+    const int64_t threadId;
+
+private:
+    std::mutex mutex;
+    std::vector<TraceEvent> events;
+    size_t count = 0;
+};
+
+/**
+ * Owns the buffers of all threads that recorded something. Buffers outlive their threads so that callbacks from
+ * short lived libwallet threads still show up in the trace; the oldest buffer is recycled once the limit is reached.
+ */
+class TraceRegistry {
+public:
+    std::shared_ptr<TraceBuffer> create(int64_t threadId) {
+        auto buffer = std::make_shared<TraceBuffer>(threadId);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (buffers.size() >= TRACE_MAX_THREADS) {
+            buffers.erase(buffers.begin());
+        }
+        buffers.push_back(buffer);
+        return buffer;
+    }
+
+    std::vector<std::shared_ptr<TraceBuffer>> all() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return buffers;
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+};
+
+inline TraceRegistry &GetTraceRegistry() {
+    static TraceRegistry registry;
+    return registry;
+}
+
+inline int64_t TraceNowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline int64_t TraceThreadId() {
+#ifdef SYS_gettid
+    return static_cast<int64_t>(syscall(SYS_gettid));
+#else
+    return static_cast<int64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+}
+
+inline TraceBuffer &GetThreadTraceBuffer() {
+    thread_local std::shared_ptr<TraceBuffer> buffer = GetTraceRegistry().create(TraceThreadId());
+    return *buffer;
+}
+
+inline bool IsTraceEnabled() {
+    return g_traceEnabled.load(std::memory_order_relaxed);
+}
+
+inline void SetTraceEnabled(bool enabled) {
+    g_traceEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * Records the time between construction and end() or destruction, whichever comes first.
+ */
+class TraceSpan {
+public:
+    TraceSpan(const char *name, const char *category) : name(name), category(category),
+                                                         startNanos(IsTraceEnabled() ? TraceNowNanos() : 0) {}
+
+    ~TraceSpan() {
+        end();
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+    void end() {
+        if (startNanos != 0) {
+            GetThreadTraceBuffer().add({name, category, startNanos, TraceNowNanos() - startNanos});
+            startNanos = 0;
+        }
+    }
+
+private:
+    const char *name;
+    const char *category;
+    int64_t startNanos;
+};
+
+/**
+ * Put at the top of every JNI entry point.
+ */
+#define TRACE_JNI_ENTRY() TraceSpan jniTraceSpan(__func__, TRACE_CATEGORY_JNI)
+
+inline void ClearTrace() {
+    for (auto &buffer : GetTraceRegistry().all()) {
+        buffer->clear();
+    }
+}
+
+inline void WriteTraceJsonString(FILE *pFile, const char *pString) {
+    static const char JNI_PREFIX[] = "Java_com_tari_android_wallet_ffi_";
+    if (strncmp(pString, JNI_PREFIX, sizeof(JNI_PREFIX) - 1) == 0) {
+        pString += sizeof(JNI_PREFIX) - 1;
+    }
+    fputc('"', pFile);
+    for (; *pString != '\0'; pString++) {
+        if (*pString == '"' || *pString == '\\') {
+            fputc('\\', pFile);
+        }
+        fputc(*pString, pFile);
+    }
+    fputc('"', pFile);
+}
+
+/**
+ * Writes all recorded events in Chrome trace event format. Recording may continue while writing.
+ *
+ * @return false if the file couldn't be written
+ */
+inline bool WriteTraceJson(const char *pPath) {
+    FILE *pFile = fopen(pPath, "w");
+    if (pFile == nullptr) {
+        return false;
+    }
+    const long processId = static_cast<long>(getpid());
+    size_t dropped = 0;
+    bool first = true;
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", pFile);
+    for (auto &buffer : GetTraceRegistry().all()) {
+        dropped += buffer->dropped();
+        for (const TraceEvent &event : buffer->snapshot()) {
+            fputs(first ? "\n" : ",\n", pFile);
+            first = false;
+            fputs("{\"ph\":\"X\",\"name\":", pFile);
+            WriteTraceJsonString(pFile, event.name);
+            fputs(",\"cat\":", pFile);
+            WriteTraceJsonString(pFile, event.category);
+            fprintf(pFile, ",\"pid\":%ld,\"tid\":%lld,\"ts\":%.3f,\"dur\":%.3f}",
+                    processId, static_cast<long long>(buffer->threadId),
+                    static_cast<double>(event.startNanos) / 1000.0, static_cast<double>(event.durationNanos) / 1000.0);
+        }
+    }
+    fprintf(pFile, "\n],\"otherData\":{\"droppedEvents\":%zu}}\n", dropped);
+    return fclose(pFile) == 0;
+}
+
+#endif // TRACE_RECORDER_CPP
@@ -0,0 +1,211 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef TX_COLUMN_SNAPSHOT_CPP
+#define TX_COLUMN_SNAPSHOT_CPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * A completed tx as read from the wallet, before it's split into the columns of a snapshot.
+ */
+struct TxColumnRow {
+    int64_t timestamp = 0;
+    uint64_t amount = 0;
+    uint64_t fee = 0;
+    bool isOutbound = false;
+    std::vector<uint8_t> counterparty;
+};
+
+/**
+ * Sums of the txs of a time bucket or of a counterparty. Fees are those of the sent txs, the received ones are paid
+ * by the sender.
+ */
+struct TxTotals {
+    uint64_t sent = 0;
+    uint64_t received = 0;
+    uint64_t fees = 0;
+    uint32_t count = 0;
+
+    void add(uint64_t amount, uint64_t fee, bool isOutbound) {
+        if (isOutbound) {
+            sent += amount;
+            fees += fee;
+        } else {
+            received += amount;
+        }
+        count++;
+    }
+};
+
+/**
+ * The completed txs of a wallet as columns sorted by timestamp, taken once and aggregated any number of times.
+ *
+ * Every aggregation runs over the txs of a time range [from, to) only, which a binary search finds, in one pass over
+ * the columns it needs. Time series split the range into buckets of bucketSize seconds starting at from, the last one
+ * may be cut short by to. Buckets are fixed size, a caller that wants calendar days across a DST change asks for
+ * each side of it separately.
+ */
+class TxColumnSnapshot {
+public:
+    explicit TxColumnSnapshot(std::vector<TxColumnRow> rows) {
+        std::vector<uint32_t> order(rows.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return rows[a].timestamp < rows[b].timestamp; });
+
+        timestamps_.reserve(rows.size());
+        amounts_.reserve(rows.size());
+        fees_.reserve(rows.size());
+        outbound_.reserve(rows.size());
+        counterparties_.reserve(rows.size());
+        balances_.reserve(rows.size());
+        std::unordered_map<std::string, uint32_t> counterpartyIndexes;
+        int64_t balance = 0;
+        for (uint32_t i : order) {
+            TxColumnRow &row = rows[i];
+            timestamps_.push_back(row.timestamp);
+            amounts_.push_back(row.amount);
+            fees_.push_back(row.fee);
+            outbound_.push_back(row.isOutbound ? 1 : 0);
+            std::string key(row.counterparty.begin(), row.counterparty.end());
+            auto inserted = counterpartyIndexes.emplace(std::move(key), static_cast<uint32_t>(counterpartyBytes_.size()));
+            if (inserted.second) {
+                counterpartyBytes_.push_back(std::move(row.counterparty));
+            }
+            counterparties_.push_back(inserted.first->second);
+            balance += row.isOutbound ? -static_cast<int64_t>(row.amount + row.fee) : static_cast<int64_t>(row.amount);
+            balances_.push_back(balance);
+        }
+    }
+
+    size_t size() const {
+        return timestamps_.size();
+    }
+
+    size_t counterpartyCount() const {
+        return counterpartyBytes_.size();
+    }
+
+    /**
+     * The address bytes of counterparty index, the order of counterpartyTotals.
+     */
+    const std::vector<uint8_t> &counterparty(size_t index) const {
+        return counterpartyBytes_[index];
+    }
+
+    size_t memorySize() const {
+        size_t size = sizeof(*this) + timestamps_.size() * ROW_SIZE;
+        for (const auto &bytes : counterpartyBytes_) {
+            size += sizeof(bytes) + bytes.size();
+        }
+        return size;
+    }
+
+    /**
+     * @return the number of buckets of the range, 0 if the range or the bucket size isn't valid
+     */
+    static size_t bucketCount(int64_t from, int64_t to, int64_t bucketSize) {
+        if (bucketSize <= 0 || to <= from) {
+            return 0;
+        }
+        uint64_t span = static_cast<uint64_t>(to) - static_cast<uint64_t>(from);
+        return static_cast<size_t>((span - 1) / static_cast<uint64_t>(bucketSize) + 1);
+    }
+
+    /**
+     * Sent, received, fees and count of every bucket, out must hold bucketCount totals.
+     */
+    void volumes(int64_t from, int64_t to, int64_t bucketSize, TxTotals *out) const {
+        std::fill(out, out + bucketCount(from, to, bucketSize), TxTotals());
+        for (size_t i = lowerBound(from), end = lowerBound(to); i < end; i++) {
+            out[(timestamps_[i] - from) / bucketSize].add(amounts_[i], fees_[i], outbound_[i] != 0);
+        }
+    }
+
+    /**
+     * The balance the completed txs add up to at the end of every bucket, counting every tx before from as well.
+     * out must hold bucketCount balances.
+     */
+    void runningBalances(int64_t from, int64_t to, int64_t bucketSize, int64_t *out) const {
+        size_t buckets = bucketCount(from, to, bucketSize);
+        size_t i = lowerBound(from);
+        size_t end = lowerBound(to);
+        int64_t balance = i > 0 ? balances_[i - 1] : 0;
+        int64_t bucketEnd = from;
+        for (size_t bucket = 0; bucket < buckets; bucket++) {
+            // the last bucket ends at to, earlier ones can't overflow past it
+            bucketEnd = bucket + 1 < buckets ? bucketEnd + bucketSize : to;
+            for (; i < end && timestamps_[i] < bucketEnd; i++) {
+                balance = balances_[i];
+            }
+            out[bucket] = balance;
+        }
+    }
+
+    /**
+     * Sent, received, fees and count per counterparty over the range, out must hold counterpartyCount totals.
+     */
+    void counterpartyTotals(int64_t from, int64_t to, TxTotals *out) const {
+        std::fill(out, out + counterpartyBytes_.size(), TxTotals());
+        for (size_t i = lowerBound(from), end = lowerBound(to); i < end; i++) {
+            out[counterparties_[i]].add(amounts_[i], fees_[i], outbound_[i] != 0);
+        }
+    }
+
+private:
+    static constexpr size_t ROW_SIZE = sizeof(int64_t) * 2 + sizeof(uint64_t) * 2 + sizeof(uint8_t) + sizeof(uint32_t);
+
+    std::vector<int64_t> timestamps_;
+    std::vector<uint64_t> amounts_;
+    std::vector<uint64_t> fees_;
+    std::vector<uint8_t> outbound_;
+    std::vector<uint32_t> counterparties_;
+    // the balance after each tx, so a range needs none of the txs before it
+    std::vector<int64_t> balances_;
+    std::vector<std::vector<uint8_t>> counterpartyBytes_;
+
+    size_t lowerBound(int64_t timestamp) const {
+        return static_cast<size_t>(std::lower_bound(timestamps_.begin(), timestamps_.end(), timestamp) - timestamps_.begin());
+    }
+};
+
+inline void DestroyTxColumnSnapshot(TxColumnSnapshot *pSnapshot) {
+    delete pSnapshot;
+}
+
+#endif // TX_COLUMN_SNAPSHOT_CPP
@@ -0,0 +1,354 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef TX_HISTORY_EXPORTER_CPP
+#define TX_HISTORY_EXPORTER_CPP
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+
+/**
+ * Streaming export of the tx history for accounting, as CSV or as a JSON array of objects with the same fields.
+ *
+ * Rows are formatted into one fixed size buffer that's written to the file descriptor whenever it fills up, so an
+ * export takes the same memory whatever the size of the history. Ids are strings in JSON since they don't fit a
+ * double, timestamps are ISO 8601 in UTC.
+ */
+constexpr int TX_EXPORT_FORMAT_CSV = 0;
+constexpr int TX_EXPORT_FORMAT_JSON = 1;
+constexpr size_t TX_EXPORT_BUFFER_SIZE = 64 * 1024;
+constexpr size_t TX_EXPORT_PAYMENT_REFERENCE_HEX_SIZE = 64;
+
+constexpr const char *TX_EXPORT_FIELDS[] = {"kind", "id", "status", "direction", "amount", "fee", "timestamp",
+                                            "mined_timestamp", "mined_height", "source_address", "destination_address",
+                                            "payment_id", "kernel_excess", "payment_references"};
+
+// by libwallet status code, from -1
+constexpr const char *TX_EXPORT_STATUS_NAMES[] = {
+        "null_error", "completed", "broadcast", "mined_unconfirmed", "imported", "pending", "coinbase",
+        "mined_confirmed", "rejected", "one_sided_unconfirmed", "one_sided_confirmed", "queued", "coinbase_unconfirmed",
+        "coinbase_confirmed", "coinbase_not_in_blockchain", "unknown"};
+
+/**
+ * One tx of an export. It's reused from row to row, the strings keep their capacity.
+ */
+struct TxExportRecord {
+    const char *kind = "";
+    uint64_t id = 0;
+    int status = -1;
+    bool isOutbound = false;
+    uint64_t amount = 0;
+    uint64_t fee = 0;
+    uint64_t timestamp = 0;
+    // 0 if not mined
+    uint64_t minedTimestamp = 0;
+    uint64_t minedHeight = 0;
+    // base58
+    std::string sourceAddress;
+    std::string destinationAddress;
+    std::string paymentId;
+    // hex
+    std::string kernelExcess;
+    // TX_EXPORT_PAYMENT_REFERENCE_HEX_SIZE hex digits each, back to back
+    std::string paymentReferences;
+
+    void clear() {
+        kind = "";
+        id = 0;
+        status = -1;
+        isOutbound = false;
+        amount = 0;
+        fee = 0;
+        timestamp = 0;
+        minedTimestamp = 0;
+        minedHeight = 0;
+        sourceAddress.clear();
+        destinationAddress.clear();
+        paymentId.clear();
+        kernelExcess.clear();
+        paymentReferences.clear();
+    }
+};
+
+class TxHistoryExportWriter {
+public:
+    /**
+     * The file descriptor stays open, it belongs to the caller.
+     */
+    TxHistoryExportWriter(int fd, int format) : fd_(fd), format_(format) {
+        buffer_.reserve(TX_EXPORT_BUFFER_SIZE * 2);
+    }
+
+    static bool isValidFormat(int format) {
+        return format == TX_EXPORT_FORMAT_CSV || format == TX_EXPORT_FORMAT_JSON;
+    }
+
+    bool begin() {
+        if (format_ == TX_EXPORT_FORMAT_JSON) {
+            buffer_.append("[");
+            return true;
+        }
+        for (size_t i = 0; i < std::size(TX_EXPORT_FIELDS); i++) {
+            buffer_.append(i > 0 ? "," : "").append(TX_EXPORT_FIELDS[i]);
+        }
+        buffer_.append("\r\n");
+        return true;
+    }
+
+    bool write(const TxExportRecord &record) {
+        if (format_ == TX_EXPORT_FORMAT_JSON) {
+            appendJsonRecord(record);
+        } else {
+            appendCsvRecord(record);
+        }
+        rowCount_++;
+        return buffer_.size() < TX_EXPORT_BUFFER_SIZE || flush();
+    }
+
+    /**
+     * Closes the JSON array and writes what's left in the buffer.
+     */
+    bool finish() {
+        if (format_ == TX_EXPORT_FORMAT_JSON) {
+            buffer_.append(rowCount_ > 0 ? "\n]\n" : "]\n");
+        }
+        return flush();
+    }
+
+    size_t rowCount() const {
+        return rowCount_;
+    }
+
+    /**
+     * @return the errno of the write that failed, 0 if none did
+     */
+    int writeError() const {
+        return writeError_;
+    }
+
+private:
+    int fd_;
+    int format_;
+    std::string buffer_;
+    size_t rowCount_ = 0;
+    int writeError_ = 0;
+
+    bool flush() {
+        size_t written = 0;
+        while (written < buffer_.size()) {
+            ssize_t result = ::write(fd_, buffer_.data() + written, buffer_.size() - written);
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                writeError_ = errno;
+                return false;
+            }
+            written += static_cast<size_t>(result);
+        }
+        buffer_.clear();
+        return true;
+    }
+
+    static const char *statusName(int status) {
+        size_t index = static_cast<size_t>(status + 1);
+        return status >= -1 && index < std::size(TX_EXPORT_STATUS_NAMES) ? TX_EXPORT_STATUS_NAMES[index] : "unknown";
+    }
+
+    void appendUnsigned(uint64_t value) {
+        char digits[20];
+        size_t length = 0;
+        do {
+            digits[length++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (length > 0) {
+            buffer_.push_back(digits[--length]);
+        }
+    }
+
+    void appendTimestamp(uint64_t seconds) {
+        if (seconds == 0) {
+            return;
+        }
+        auto time = static_cast<time_t>(seconds);
+        struct tm utc{};
+        char text[32];
+        if (gmtime_r(&time, &utc) != nullptr && strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", &utc) > 0) {
+            buffer_.append(text);
+        }
+    }
+
+    /**
+     * RFC 4180 quoting. Text from the counterparty that a spreadsheet would run as a formula gets a leading quote.
+     */
+    void appendCsvText(const char *pText, size_t length) {
+        bool formula = length > 0 && pText[0] != '\0' && strchr("=+-@\t\r", pText[0]) != nullptr;
+        bool quoted = formula;
+        for (size_t i = 0; i < length && !quoted; i++) {
+            quoted = pText[i] == ',' || pText[i] == '"' || pText[i] == '\r' || pText[i] == '\n';
+        }
+        if (!quoted) {
+            buffer_.append(pText, length);
+            return;
+        }
+        buffer_.push_back('"');
+        if (formula) {
+            buffer_.push_back('\'');
+        }
+        for (size_t i = 0; i < length; i++) {
+            if (pText[i] == '"') {
+                buffer_.push_back('"');
+            }
+            buffer_.push_back(pText[i]);
+        }
+        buffer_.push_back('"');
+    }
+
+    void appendCsvRecord(const TxExportRecord &record) {
+        buffer_.append(record.kind).push_back(',');
+        appendUnsigned(record.id);
+        buffer_.push_back(',');
+        buffer_.append(statusName(record.status)).push_back(',');
+        buffer_.append(record.isOutbound ? "outbound" : "inbound").push_back(',');
+        appendUnsigned(record.amount);
+        buffer_.push_back(',');
+        appendUnsigned(record.fee);
+        buffer_.push_back(',');
+        appendTimestamp(record.timestamp);
+        buffer_.push_back(',');
+        appendTimestamp(record.minedTimestamp);
+        buffer_.push_back(',');
+        if (record.minedTimestamp != 0) {
+            appendUnsigned(record.minedHeight);
+        }
+        buffer_.push_back(',');
+        buffer_.append(record.sourceAddress).push_back(',');
+        buffer_.append(record.destinationAddress).push_back(',');
+        appendCsvText(record.paymentId.data(), record.paymentId.size());
+        buffer_.push_back(',');
+        buffer_.append(record.kernelExcess).push_back(',');
+        // hex only, separated by spaces in the one field
+        for (size_t i = 0; i < record.paymentReferences.size(); i += TX_EXPORT_PAYMENT_REFERENCE_HEX_SIZE) {
+            buffer_.append(i > 0 ? " " : "").append(record.paymentReferences, i, TX_EXPORT_PAYMENT_REFERENCE_HEX_SIZE);
+        }
+        buffer_.append("\r\n");
+    }
+
+    void appendJsonString(const char *pText, size_t length) {
+        static const char HEX_DIGITS[] = "0123456789abcdef";
+        buffer_.push_back('"');
+        for (size_t i = 0; i < length; i++) {
+            auto c = static_cast<unsigned char>(pText[i]);
+            if (c == '"' || c == '\\') {
+                buffer_.push_back('\\');
+                buffer_.push_back(static_cast<char>(c));
+            } else if (c < 0x20) {
+                buffer_.append("\\u00");
+                buffer_.push_back(HEX_DIGITS[c >> 4]);
+                buffer_.push_back(HEX_DIGITS[c & 0x0F]);
+            } else {
+                buffer_.push_back(static_cast<char>(c));
+            }
+        }
+        buffer_.push_back('"');
+    }
+
+    void appendJsonString(const std::string &text) {
+        appendJsonString(text.data(), text.size());
+    }
+
+    void appendJsonKey(size_t field) {
+        buffer_.append(field > 0 ? ",\"" : "\"").append(TX_EXPORT_FIELDS[field]).append("\":");
+    }
+
+    void appendJsonTimestamp(uint64_t seconds) {
+        if (seconds == 0) {
+            buffer_.append("null");
+            return;
+        }
+        buffer_.push_back('"');
+        appendTimestamp(seconds);
+        buffer_.push_back('"');
+    }
+
+    void appendJsonRecord(const TxExportRecord &record) {
+        buffer_.append(rowCount_ > 0 ? ",\n{" : "\n{");
+        size_t field = 0;
+        appendJsonKey(field++);
+        appendJsonString(record.kind, strlen(record.kind));
+        appendJsonKey(field++);
+        buffer_.push_back('"');
+        appendUnsigned(record.id);
+        buffer_.push_back('"');
+        appendJsonKey(field++);
+        buffer_.append("\"").append(statusName(record.status)).append("\"");
+        appendJsonKey(field++);
+        buffer_.append(record.isOutbound ? "\"outbound\"" : "\"inbound\"");
+        appendJsonKey(field++);
+        appendUnsigned(record.amount);
+        appendJsonKey(field++);
+        appendUnsigned(record.fee);
+        appendJsonKey(field++);
+        appendJsonTimestamp(record.timestamp);
+        appendJsonKey(field++);
+        appendJsonTimestamp(record.minedTimestamp);
+        appendJsonKey(field++);
+        if (record.minedTimestamp != 0) {
+            appendUnsigned(record.minedHeight);
+        } else {
+            buffer_.append("null");
+        }
+        appendJsonKey(field++);
+        appendJsonString(record.sourceAddress);
+        appendJsonKey(field++);
+        appendJsonString(record.destinationAddress);
+        appendJsonKey(field++);
+        appendJsonString(record.paymentId);
+        appendJsonKey(field++);
+        appendJsonString(record.kernelExcess);
+        appendJsonKey(field++);
+        buffer_.push_back('[');
+        for (size_t i = 0; i < record.paymentReferences.size(); i += TX_EXPORT_PAYMENT_REFERENCE_HEX_SIZE) {
+            buffer_.append(i > 0 ? ",\"" : "\"").append(record.paymentReferences, i, TX_EXPORT_PAYMENT_REFERENCE_HEX_SIZE).push_back('"');
+        }
+        buffer_.append("]}");
+    }
+};
+
+#endif // TX_HISTORY_EXPORTER_CPP
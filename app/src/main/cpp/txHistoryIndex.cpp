@@ -0,0 +1,729 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef TX_HISTORY_INDEX_CPP
+#define TX_HISTORY_INDEX_CPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "sqlite3Api.cpp"
+
+/**
+ * Query cache of the tx history: a SQLite database of its own next to the wallet datastore, with a row per tx of the
+ * completed, cancelled and pending lists of the wallet. History screens filter and sort in SQL and read back only
+ * the ids or columns of the matching txs, the wallet lists are only read in full when the index is rebuilt.
+ *
+ * It's a cache, a database of another schema version is dropped and rebuilt from the wallet.
+ */
+constexpr int TX_HISTORY_INDEX_SCHEMA_VERSION = 1;
+const char *const TX_HISTORY_INDEX_FILE_NAME = "tx_history_index.sqlite";
+
+// the wallet list a tx is in
+constexpr int TX_HISTORY_KIND_COMPLETED = 0;
+constexpr int TX_HISTORY_KIND_CANCELLED = 1;
+constexpr int TX_HISTORY_KIND_PENDING_INBOUND = 2;
+constexpr int TX_HISTORY_KIND_PENDING_OUTBOUND = 3;
+
+/**
+ * Fields of a query in the filter array, mirrored by FFITxHistoryQuery.kt.
+ */
+// bit 1 << kind for every kind to match, 0 matches all
+constexpr size_t TX_HISTORY_FILTER_KINDS = 0;
+// bit 1 << status for every libwallet tx status to match, 0 matches all
+constexpr size_t TX_HISTORY_FILTER_STATUSES = 1;
+// one of TX_HISTORY_DIRECTION_*
+constexpr size_t TX_HISTORY_FILTER_DIRECTION = 2;
+// inclusive bounds, -1 for none
+constexpr size_t TX_HISTORY_FILTER_MIN_AMOUNT = 3;
+constexpr size_t TX_HISTORY_FILTER_MAX_AMOUNT = 4;
+// from inclusive, to exclusive, -1 for none
+constexpr size_t TX_HISTORY_FILTER_FROM_TIMESTAMP = 5;
+constexpr size_t TX_HISTORY_FILTER_TO_TIMESTAMP = 6;
+// one of TX_HISTORY_ORDER_*
+constexpr size_t TX_HISTORY_FILTER_ORDER = 7;
+// -1 for no limit
+constexpr size_t TX_HISTORY_FILTER_LIMIT = 8;
+constexpr size_t TX_HISTORY_FILTER_OFFSET = 9;
+constexpr size_t TX_HISTORY_FILTER_FIELD_COUNT = 10;
+
+constexpr int64_t TX_HISTORY_DIRECTION_ANY = 0;
+constexpr int64_t TX_HISTORY_DIRECTION_INBOUND = 1;
+constexpr int64_t TX_HISTORY_DIRECTION_OUTBOUND = 2;
+
+constexpr int64_t TX_HISTORY_ORDER_NEWEST_FIRST = 0;
+constexpr int64_t TX_HISTORY_ORDER_OLDEST_FIRST = 1;
+constexpr int64_t TX_HISTORY_ORDER_LARGEST_FIRST = 2;
+constexpr int64_t TX_HISTORY_ORDER_SMALLEST_FIRST = 3;
+
+// a query shape is prepared once, every filter combination is a shape of its own
+constexpr size_t TX_HISTORY_MAX_CACHED_STATEMENTS = 64;
+
+struct TxHistoryRow {
+    uint64_t id = 0;
+    int kind = TX_HISTORY_KIND_COMPLETED;
+    int status = 0;
+    bool isOutbound = false;
+    uint64_t amount = 0;
+    uint64_t fee = 0;
+    uint64_t timestamp = 0;
+    // address bytes of the other side of the tx
+    std::vector<uint8_t> counterparty;
+    std::string paymentId;
+};
+
+struct TxHistoryQuery {
+    int64_t filter[TX_HISTORY_FILTER_FIELD_COUNT] = {0, 0, TX_HISTORY_DIRECTION_ANY, -1, -1, -1, -1, TX_HISTORY_ORDER_NEWEST_FIRST, -1, 0};
+    // address bytes, empty matches every counterparty
+    std::vector<uint8_t> counterparty;
+    // words matched as prefixes against the payment id and the contact alias, empty matches all
+    std::string text;
+};
+
+/**
+ * The matches of a query, only ids is filled for a query of ids.
+ */
+struct TxHistoryColumns {
+    std::vector<int64_t> ids;
+    std::vector<int64_t> amounts;
+    std::vector<int64_t> fees;
+    std::vector<int64_t> timestamps;
+    std::vector<int32_t> statuses;
+    // kind in the low bits, TX_HISTORY_FLAG_OUTBOUND for outbound txs
+    std::vector<int8_t> flags;
+};
+
+constexpr int8_t TX_HISTORY_FLAG_OUTBOUND = 0x10;
+
+// the search text split at whitespace
+inline std::vector<std::string> SplitTxHistoryWords(const std::string &text) {
+    std::vector<std::string> words;
+    auto isSpace = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+    size_t i = 0;
+    while (i < text.size()) {
+        while (i < text.size() && isSpace(text[i])) {
+            i++;
+        }
+        size_t start = i;
+        while (i < text.size() && !isSpace(text[i])) {
+            i++;
+        }
+        if (i > start) {
+            words.push_back(text.substr(start, i - start));
+        }
+    }
+    return words;
+}
+
+/**
+ * Words of the search text as an FTS5 query: each word quoted, so punctuation doesn't read as query syntax, and
+ * matched as a prefix so results show up while the word is typed.
+ */
+inline std::string BuildTxHistoryMatch(const std::string &text) {
+    std::string match;
+    for (const std::string &word : SplitTxHistoryWords(text)) {
+        if (!match.empty()) {
+            match += ' ';
+        }
+        match += '"';
+        for (char c : word) {
+            if (c == '"') {
+                match += '"';
+            }
+            match += c;
+        }
+        match += "\"*";
+    }
+    return match;
+}
+
+/**
+ * LIKE pattern of a search word for a SQLite built without FTS5, matching the word anywhere in the text.
+ */
+inline std::string BuildTxHistoryLikePattern(const std::string &word) {
+    std::string pattern = "%";
+    for (char c : word) {
+        if (c == '%' || c == '_' || c == '\\') {
+            pattern += '\\';
+        }
+        pattern += c;
+    }
+    pattern += '%';
+    return pattern;
+}
+
+/**
+ * The tx callbacks queue their rows with enqueue and the owner of the index flushes them in one transaction, off the
+ * callback thread. Queries flush first, so they see every row queued before them. All database access is serialized.
+ */
+class TxHistoryIndex {
+public:
+    TxHistoryIndex() = default;
+    TxHistoryIndex(const TxHistoryIndex &) = delete;
+    TxHistoryIndex &operator=(const TxHistoryIndex &) = delete;
+
+    ~TxHistoryIndex() {
+        close();
+    }
+
+    bool isOpen() const {
+        return open_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Opens or creates the database at path, closing the one open before.
+     */
+    bool open(const std::string &path) {
+        std::lock_guard<std::mutex> lock(dbMutex_);
+        closeLocked();
+        if (sqlite3_open_v2(path.c_str(), &pDb_, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, nullptr) != SQLITE_OK) {
+            setError();
+            closeLocked();
+            return false;
+        }
+        sqlite3_busy_timeout(pDb_, 1000);
+        // a lost write is rebuilt from the wallet, no need to sync on every commit
+        if (!exec("PRAGMA journal_mode = WAL; PRAGMA synchronous = NORMAL;") || !migrate()) {
+            closeLocked();
+            return false;
+        }
+        open_.store(true, std::memory_order_relaxed);
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(dbMutex_);
+        closeLocked();
+    }
+
+    /**
+     * Queues the row of a new or changed tx.
+     *
+     * @return true if no flush is pending yet, the caller has to make sure flush runs
+     */
+    bool enqueue(TxHistoryRow row) {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        queued_.push_back(std::move(row));
+        if (flushPending_) {
+            return false;
+        }
+        flushPending_ = true;
+        return true;
+    }
+
+    bool flush() {
+        std::lock_guard<std::mutex> lock(dbMutex_);
+        return flushLocked();
+    }
+
+    /**
+     * Replaces every tx with the rows read from the wallet. Rows queued before the wallet was read should be flushed
+     * first, the ones queued since are written after the rows, they're at least as recent.
+     */
+    bool replaceAll(const std::vector<TxHistoryRow> &rows) {
+        std::lock_guard<std::mutex> lock(dbMutex_);
+        if (pDb_ == nullptr) {
+            return false;
+        }
+        if (!exec("BEGIN; DELETE FROM txs; DELETE FROM tx_search;")) {
+            return false;
+        }
+        for (const TxHistoryRow &row : rows) {
+            if (!writeRow(row)) {
+                exec("ROLLBACK;");
+                return false;
+            }
+        }
+        std::vector<TxHistoryRow> queued = takeQueued();
+        for (const TxHistoryRow &row : queued) {
+            if (!writeRow(row)) {
+                exec("ROLLBACK;");
+                requeue(std::move(queued));
+                return false;
+            }
+        }
+        if (!exec("COMMIT;")) {
+            exec("ROLLBACK;");
+            requeue(std::move(queued));
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Replaces the contact aliases the search matches, given as pairs of address bytes and alias.
+     */
+    bool setAliases(const std::vector<std::pair<std::vector<uint8_t>, std::string>> &aliases) {
+        std::lock_guard<std::mutex> lock(dbMutex_);
+        if (pDb_ == nullptr || !flushLocked() || !exec("BEGIN; DELETE FROM aliases;")) {
+            return false;
+        }
+        for (const auto &alias : aliases) {
+            sqlite3_stmt *pStatement = statement("INSERT OR REPLACE INTO aliases(counterparty, alias) VALUES(?, ?)");
+            if (pStatement == nullptr) {
+                exec("ROLLBACK;");
+                return false;
+            }
+            bindBlob(pStatement, 1, alias.first);
+            sqlite3_bind_text(pStatement, 2, alias.second.c_str(), static_cast<int>(alias.second.size()), SQLITE_TRANSIENT);
+            if (!stepDone(pStatement)) {
+                exec("ROLLBACK;");
+                return false;
+            }
+        }
+        // the alias is part of the search row of every tx with the contact
+        if (!exec("DELETE FROM tx_search;"
+                  "INSERT INTO tx_search(rowid, payment_id, alias)"
+                  " SELECT t.id, t.payment_id, COALESCE(a.alias, '') FROM txs t LEFT JOIN aliases a ON a.counterparty = t.counterparty;")) {
+            exec("ROLLBACK;");
+            return false;
+        }
+        return exec("COMMIT;");
+    }
+
+    /**
+     * Drops every tx and alias, e.g. when the wallet is removed.
+     */
+    bool clear() {
+        std::lock_guard<std::mutex> lock(dbMutex_);
+        takeQueued();
+        return pDb_ != nullptr && exec("BEGIN; DELETE FROM txs; DELETE FROM tx_search; DELETE FROM aliases; COMMIT;");
+    }
+
+    /**
+     * @param withColumns false to read only the ids
+     */
+    bool query(const TxHistoryQuery &query, bool withColumns, TxHistoryColumns &out) {
+        std::lock_guard<std::mutex> lock(dbMutex_);
+        if (pDb_ == nullptr || !flushLocked()) {
+            return false;
+        }
+        std::string sql = withColumns ? "SELECT id, amount, fee, timestamp, status, kind, is_outbound FROM txs" : "SELECT id FROM txs";
+        std::vector<Binding> bindings;
+        std::vector<std::string> texts = appendWhere(query, sql, bindings);
+        switch (query.filter[TX_HISTORY_FILTER_ORDER]) {
+            case TX_HISTORY_ORDER_OLDEST_FIRST:
+                sql += " ORDER BY timestamp, id";
+                break;
+            case TX_HISTORY_ORDER_LARGEST_FIRST:
+                sql += " ORDER BY amount DESC, id DESC";
+                break;
+            case TX_HISTORY_ORDER_SMALLEST_FIRST:
+                sql += " ORDER BY amount, id";
+                break;
+            default:
+                sql += " ORDER BY timestamp DESC, id DESC";
+        }
+        sql += " LIMIT ? OFFSET ?";
+        bindings.push_back(Binding{query.filter[TX_HISTORY_FILTER_LIMIT]});
+        bindings.push_back(Binding{std::max<int64_t>(query.filter[TX_HISTORY_FILTER_OFFSET], 0)});
+
+        sqlite3_stmt *pStatement = prepare(sql, bindings, query, texts);
+        if (pStatement == nullptr) {
+            return false;
+        }
+        int result;
+        while ((result = sqlite3_step(pStatement)) == SQLITE_ROW) {
+            out.ids.push_back(sqlite3_column_int64(pStatement, 0));
+            if (withColumns) {
+                out.amounts.push_back(sqlite3_column_int64(pStatement, 1));
+                out.fees.push_back(sqlite3_column_int64(pStatement, 2));
+                out.timestamps.push_back(sqlite3_column_int64(pStatement, 3));
+                out.statuses.push_back(static_cast<int32_t>(sqlite3_column_int64(pStatement, 4)));
+                out.flags.push_back(static_cast<int8_t>(sqlite3_column_int64(pStatement, 5) |
+                                                        (sqlite3_column_int64(pStatement, 6) != 0 ? TX_HISTORY_FLAG_OUTBOUND : 0)));
+            }
+        }
+        sqlite3_reset(pStatement);
+        if (result != SQLITE_DONE) {
+            setError();
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Number of txs the query matches without its limit and offset, -1 if it failed.
+     */
+    int64_t count(const TxHistoryQuery &query) {
+        std::lock_guard<std::mutex> lock(dbMutex_);
+        if (pDb_ == nullptr || !flushLocked()) {
+            return -1;
+        }
+        std::string sql = "SELECT COUNT(*) FROM txs";
+        std::vector<Binding> bindings;
+        std::vector<std::string> texts = appendWhere(query, sql, bindings);
+        sqlite3_stmt *pStatement = prepare(sql, bindings, query, texts);
+        if (pStatement == nullptr) {
+            return -1;
+        }
+        int64_t count = sqlite3_step(pStatement) == SQLITE_ROW ? sqlite3_column_int64(pStatement, 0) : -1;
+        sqlite3_reset(pStatement);
+        if (count < 0) {
+            setError();
+        }
+        return count;
+    }
+
+    std::string lastError() {
+        std::lock_guard<std::mutex> lock(dbMutex_);
+        return lastError_;
+    }
+
+private:
+    /**
+     * A parameter of a query: a number, the counterparty of the query, or the search text at index value.
+     */
+    struct Binding {
+        int64_t value;
+        int source = BINDING_VALUE;
+    };
+
+    static constexpr int BINDING_VALUE = 0;
+    static constexpr int BINDING_COUNTERPARTY = 1;
+    static constexpr int BINDING_TEXT = 2;
+
+    std::mutex dbMutex_;
+    sqlite3 *pDb_ = nullptr;
+    std::atomic<bool> open_{false};
+    // false if the SQLite library was built without FTS5, tx_search is a plain table searched with LIKE then
+    bool hasFts_ = false;
+    std::unordered_map<std::string, sqlite3_stmt *> statements_;
+    std::string lastError_;
+
+    std::mutex queueMutex_;
+    std::vector<TxHistoryRow> queued_;
+    bool flushPending_ = false;
+
+    void closeLocked() {
+        open_.store(false, std::memory_order_relaxed);
+        for (auto &statement : statements_) {
+            sqlite3_finalize(statement.second);
+        }
+        statements_.clear();
+        if (pDb_ != nullptr) {
+            sqlite3_close(pDb_);
+            pDb_ = nullptr;
+        }
+        takeQueued();
+    }
+
+    /**
+     * Puts back the rows of a failed write ahead of the ones queued since, the next flush retries them.
+     */
+    void requeue(std::vector<TxHistoryRow> rows) {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        rows.insert(rows.end(), std::make_move_iterator(queued_.begin()), std::make_move_iterator(queued_.end()));
+        queued_.swap(rows);
+        // no flush is scheduled for them anymore, the next enqueue schedules one
+        flushPending_ = false;
+    }
+
+    std::vector<TxHistoryRow> takeQueued() {
+        std::lock_guard<std::mutex> lock(queueMutex_);
+        std::vector<TxHistoryRow> queued;
+        queued.swap(queued_);
+        flushPending_ = false;
+        return queued;
+    }
+
+    bool flushLocked() {
+        std::vector<TxHistoryRow> queued = takeQueued();
+        if (queued.empty() || pDb_ == nullptr) {
+            return pDb_ != nullptr;
+        }
+        if (!exec("BEGIN;")) {
+            return false;
+        }
+        for (const TxHistoryRow &row : queued) {
+            if (!writeRow(row)) {
+                exec("ROLLBACK;");
+                requeue(std::move(queued));
+                return false;
+            }
+        }
+        if (!exec("COMMIT;")) {
+            exec("ROLLBACK;");
+            requeue(std::move(queued));
+            return false;
+        }
+        return true;
+    }
+
+    bool migrate() {
+        hasFts_ = sqlite3_compileoption_used("ENABLE_FTS5") != 0;
+        sqlite3_stmt *pStatement = statement("PRAGMA user_version");
+        int version = pStatement != nullptr && sqlite3_step(pStatement) == SQLITE_ROW
+                      ? static_cast<int>(sqlite3_column_int64(pStatement, 0)) : -1;
+        if (pStatement != nullptr) {
+            sqlite3_reset(pStatement);
+        }
+        // a library update can add or drop FTS5, the search table has to match it
+        if (version == TX_HISTORY_INDEX_SCHEMA_VERSION && isFtsSearchTable() == hasFts_) {
+            return true;
+        }
+        std::string schema = "BEGIN;"
+                             "DROP TABLE IF EXISTS txs;"
+                             "DROP TABLE IF EXISTS aliases;"
+                             "DROP TABLE IF EXISTS tx_search;"
+                             "CREATE TABLE txs(id INTEGER PRIMARY KEY, kind INTEGER NOT NULL, status INTEGER NOT NULL,"
+                             " is_outbound INTEGER NOT NULL, amount INTEGER NOT NULL, fee INTEGER NOT NULL, timestamp INTEGER NOT NULL,"
+                             " counterparty BLOB NOT NULL, payment_id TEXT NOT NULL);"
+                             "CREATE INDEX txs_timestamp ON txs(timestamp);"
+                             "CREATE INDEX txs_status ON txs(status, timestamp);"
+                             "CREATE INDEX txs_amount ON txs(amount);"
+                             "CREATE INDEX txs_counterparty ON txs(counterparty, timestamp);"
+                             "CREATE TABLE aliases(counterparty BLOB PRIMARY KEY, alias TEXT NOT NULL) WITHOUT ROWID;"
+                             + std::string(hasFts_
+                                           // rowid is the tx id, prefix indexes keep the first letters typed fast
+                                           ? "CREATE VIRTUAL TABLE tx_search USING fts5(payment_id, alias,"
+                                             " tokenize = 'unicode61 remove_diacritics 2', prefix = '2 3');"
+                                           : "CREATE TABLE tx_search(id INTEGER PRIMARY KEY, payment_id TEXT NOT NULL, alias TEXT NOT NULL);") +
+                             "PRAGMA user_version = " + std::to_string(TX_HISTORY_INDEX_SCHEMA_VERSION) + ";"
+                             "COMMIT;";
+        return exec(schema.c_str());
+    }
+
+    bool isFtsSearchTable() {
+        sqlite3_stmt *pStatement = statement("SELECT sql FROM sqlite_master WHERE name = 'tx_search'");
+        if (pStatement == nullptr) {
+            return false;
+        }
+        bool isFts = false;
+        if (sqlite3_step(pStatement) == SQLITE_ROW) {
+            const unsigned char *sql = sqlite3_column_text(pStatement, 0);
+            isFts = sql != nullptr && std::string(reinterpret_cast<const char *>(sql)).find("fts5") != std::string::npos;
+        }
+        sqlite3_reset(pStatement);
+        return isFts;
+    }
+
+    bool writeRow(const TxHistoryRow &row) {
+        auto id = static_cast<int64_t>(row.id);
+        sqlite3_stmt *pInsert = statement("INSERT OR REPLACE INTO txs(id, kind, status, is_outbound, amount, fee, timestamp,"
+                                          " counterparty, payment_id) VALUES(?, ?, ?, ?, ?, ?, ?, ?, ?)");
+        if (pInsert == nullptr) {
+            return false;
+        }
+        sqlite3_bind_int64(pInsert, 1, id);
+        sqlite3_bind_int64(pInsert, 2, row.kind);
+        sqlite3_bind_int64(pInsert, 3, row.status);
+        sqlite3_bind_int64(pInsert, 4, row.isOutbound ? 1 : 0);
+        sqlite3_bind_int64(pInsert, 5, static_cast<int64_t>(row.amount));
+        sqlite3_bind_int64(pInsert, 6, static_cast<int64_t>(row.fee));
+        sqlite3_bind_int64(pInsert, 7, static_cast<int64_t>(row.timestamp));
+        bindBlob(pInsert, 8, row.counterparty);
+        sqlite3_bind_text(pInsert, 9, row.paymentId.c_str(), static_cast<int>(row.paymentId.size()), SQLITE_TRANSIENT);
+        if (!stepDone(pInsert)) {
+            return false;
+        }
+
+        sqlite3_stmt *pDelete = statement("DELETE FROM tx_search WHERE rowid = ?");
+        if (pDelete == nullptr) {
+            return false;
+        }
+        sqlite3_bind_int64(pDelete, 1, id);
+        if (!stepDone(pDelete)) {
+            return false;
+        }
+        sqlite3_stmt *pSearch = statement("INSERT INTO tx_search(rowid, payment_id, alias)"
+                                          " VALUES(?, ?, COALESCE((SELECT alias FROM aliases WHERE counterparty = ?), ''))");
+        if (pSearch == nullptr) {
+            return false;
+        }
+        sqlite3_bind_int64(pSearch, 1, id);
+        sqlite3_bind_text(pSearch, 2, row.paymentId.c_str(), static_cast<int>(row.paymentId.size()), SQLITE_TRANSIENT);
+        bindBlob(pSearch, 3, row.counterparty);
+        return stepDone(pSearch);
+    }
+
+    /**
+     * Appends the WHERE clause of the query to sql.
+     *
+     * @return the search texts the BINDING_TEXT bindings refer to
+     */
+    std::vector<std::string> appendWhere(const TxHistoryQuery &query, std::string &sql, std::vector<Binding> &bindings) const {
+        const int64_t *filter = query.filter;
+        std::string where;
+        auto add = [&where](const char *condition) {
+            where += where.empty() ? " WHERE " : " AND ";
+            where += condition;
+        };
+        auto addIn = [&add, &where, &bindings](const char *column, int64_t mask) {
+            // a parameter per bit, so the condition can use the index of the column
+            add(column);
+            where += " IN (";
+            for (int64_t bit = 0; bit < 63; bit++) {
+                if ((mask & (int64_t{1} << bit)) != 0) {
+                    where += where.back() == '(' ? "?" : ", ?";
+                    bindings.push_back(Binding{bit});
+                }
+            }
+            where += ")";
+        };
+        if (filter[TX_HISTORY_FILTER_KINDS] > 0) {
+            addIn("kind", filter[TX_HISTORY_FILTER_KINDS]);
+        }
+        if (filter[TX_HISTORY_FILTER_STATUSES] > 0) {
+            addIn("status", filter[TX_HISTORY_FILTER_STATUSES]);
+        }
+        if (filter[TX_HISTORY_FILTER_DIRECTION] != TX_HISTORY_DIRECTION_ANY) {
+            add("is_outbound = ?");
+            bindings.push_back(Binding{filter[TX_HISTORY_FILTER_DIRECTION] == TX_HISTORY_DIRECTION_OUTBOUND ? 1 : 0});
+        }
+        const std::pair<size_t, const char *> bounds[] = {
+                {TX_HISTORY_FILTER_MIN_AMOUNT,     "amount >= ?"},
+                {TX_HISTORY_FILTER_MAX_AMOUNT,     "amount <= ?"},
+                {TX_HISTORY_FILTER_FROM_TIMESTAMP, "timestamp >= ?"},
+                {TX_HISTORY_FILTER_TO_TIMESTAMP,   "timestamp < ?"},
+        };
+        for (const auto &bound : bounds) {
+            if (filter[bound.first] >= 0) {
+                add(bound.second);
+                bindings.push_back(Binding{filter[bound.first]});
+            }
+        }
+        if (!query.counterparty.empty()) {
+            add("counterparty = ?");
+            bindings.push_back(Binding{0, BINDING_COUNTERPARTY});
+        }
+        std::vector<std::string> texts;
+        if (hasFts_) {
+            std::string match = BuildTxHistoryMatch(query.text);
+            if (!match.empty()) {
+                add("id IN (SELECT rowid FROM tx_search WHERE tx_search MATCH ?)");
+                bindings.push_back(Binding{0, BINDING_TEXT});
+                texts.push_back(std::move(match));
+            }
+        } else {
+            // every word has to be in the payment id or the alias, like the FTS5 query
+            for (const std::string &word : SplitTxHistoryWords(query.text)) {
+                add("id IN (SELECT rowid FROM tx_search WHERE payment_id LIKE ? ESCAPE '\\' OR alias LIKE ? ESCAPE '\\')");
+                bindings.push_back(Binding{static_cast<int64_t>(texts.size()), BINDING_TEXT});
+                bindings.push_back(Binding{static_cast<int64_t>(texts.size()), BINDING_TEXT});
+                texts.push_back(BuildTxHistoryLikePattern(word));
+            }
+        }
+        sql += where;
+        return texts;
+    }
+
+    sqlite3_stmt *prepare(const std::string &sql, const std::vector<Binding> &bindings, const TxHistoryQuery &query,
+                          const std::vector<std::string> &texts) {
+        sqlite3_stmt *pStatement = statement(sql);
+        if (pStatement == nullptr) {
+            return nullptr;
+        }
+        for (size_t i = 0; i < bindings.size(); i++) {
+            int index = static_cast<int>(i) + 1;
+            switch (bindings[i].source) {
+                case BINDING_COUNTERPARTY:
+                    bindBlob(pStatement, index, query.counterparty);
+                    break;
+                case BINDING_TEXT: {
+                    const std::string &text = texts[bindings[i].value];
+                    sqlite3_bind_text(pStatement, index, text.c_str(), static_cast<int>(text.size()), SQLITE_TRANSIENT);
+                    break;
+                }
+                default:
+                    sqlite3_bind_int64(pStatement, index, bindings[i].value);
+            }
+        }
+        return pStatement;
+    }
+
+    /**
+     * The prepared statement of sql, reset and without bindings.
+     */
+    sqlite3_stmt *statement(const std::string &sql) {
+        auto cached = statements_.find(sql);
+        if (cached != statements_.end()) {
+            sqlite3_clear_bindings(cached->second);
+            return cached->second;
+        }
+        if (statements_.size() >= TX_HISTORY_MAX_CACHED_STATEMENTS) {
+            for (auto &statement : statements_) {
+                sqlite3_finalize(statement.second);
+            }
+            statements_.clear();
+        }
+        sqlite3_stmt *pStatement = nullptr;
+        if (sqlite3_prepare_v2(pDb_, sql.c_str(), static_cast<int>(sql.size()), &pStatement, nullptr) != SQLITE_OK) {
+            setError();
+            return nullptr;
+        }
+        statements_.emplace(sql, pStatement);
+        return pStatement;
+    }
+
+    static void bindBlob(sqlite3_stmt *pStatement, int index, const std::vector<uint8_t> &bytes) {
+        // a zero length blob, not null, so an empty counterparty still compares
+        static const uint8_t EMPTY = 0;
+        sqlite3_bind_blob(pStatement, index, bytes.empty() ? &EMPTY : bytes.data(), static_cast<int>(bytes.size()), SQLITE_TRANSIENT);
+    }
+
+    bool stepDone(sqlite3_stmt *pStatement) {
+        int result = sqlite3_step(pStatement);
+        sqlite3_reset(pStatement);
+        if (result != SQLITE_DONE) {
+            setError();
+            return false;
+        }
+        return true;
+    }
+
+    bool exec(const char *sql) {
+        if (sqlite3_exec(pDb_, sql, nullptr, nullptr, nullptr) != SQLITE_OK) {
+            setError();
+            return false;
+        }
+        return true;
+    }
+
+    void setError() {
+        lastError_ = pDb_ != nullptr ? sqlite3_errmsg(pDb_) : "out of memory";
+    }
+};
+
+inline TxHistoryIndex &GetTxHistoryIndex() {
+    static TxHistoryIndex index;
+    return index;
+}
+
+#endif // TX_HISTORY_INDEX_CPP
@@ -0,0 +1,254 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef TX_LIFECYCLE_TRACKER_CPP
+#define TX_LIFECYCLE_TRACKER_CPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Stages of a sent tx, in the order they normally happen.
+ */
+constexpr int TX_STAGE_SENT = 0;
+constexpr int TX_STAGE_DIRECT_SEND_RESULT = 1;
+constexpr int TX_STAGE_REPLY_RECEIVED = 2;
+constexpr int TX_STAGE_FINALIZED = 3;
+constexpr int TX_STAGE_BROADCAST = 4;
+constexpr int TX_STAGE_MINED_UNCONFIRMED = 5;
+constexpr int TX_STAGE_MINED = 6;
+constexpr int TX_STAGE_COUNT = 7;
+
+constexpr size_t TX_LIFECYCLE_CAPACITY = 256;
+constexpr int64_t TX_LIFECYCLE_MAX_AGE_NANOS = int64_t(6) * 3600 * 1000000000;
+// durations kept per stage transition for the percentiles
+constexpr size_t TX_LIFECYCLE_WINDOW = 256;
+
+/**
+ * Timeline of a tx, stage times are steady clock nanos and -1 until the stage is reached.
+ */
+struct TxLifecycle {
+    uint64_t txId = 0;
+    int64_t sentAtMillis = 0;
+    int64_t stageNanos[TX_STAGE_COUNT];
+};
+
+/**
+ * Durations of the last TX_LIFECYCLE_WINDOW transitions into a stage.
+ */
+class TxStageWindow {
+public:
+    void record(int64_t nanos) {
+        samples_[next_ % TX_LIFECYCLE_WINDOW] = nanos;
+        next_++;
+    }
+
+    /**
+     * Count, total, max, p50, p90, p99 and p99.9 of the window, the layout of the call stats values.
+     */
+    void appendValues(std::vector<int64_t> &values) const {
+        std::vector<int64_t> sorted(samples_, samples_ + std::min<uint64_t>(next_, TX_LIFECYCLE_WINDOW));
+        std::sort(sorted.begin(), sorted.end());
+        int64_t total = 0;
+        for (int64_t sample : sorted) {
+            total += sample;
+        }
+        values.push_back(static_cast<int64_t>(sorted.size()));
+        values.push_back(total);
+        values.push_back(sorted.empty() ? 0 : sorted.back());
+        for (double percentile : {50.0, 90.0, 99.0, 99.9}) {
+            if (sorted.empty()) {
+                values.push_back(0);
+            } else {
+                auto index = static_cast<size_t>(percentile / 100.0 * static_cast<double>(sorted.size() - 1) + 0.5);
+                values.push_back(sorted[index]);
+            }
+        }
+    }
+
+private:
+    int64_t samples_[TX_LIFECYCLE_WINDOW] = {};
+    uint64_t next_ = 0;
+};
+
+/**
+ * Timestamps the stages of sent txs by tx id. Only txs that were sent through the wallet are tracked, the callbacks
+ * of other txs pass without a lookup while nothing is tracked. The oldest tx is evicted when the table is full
+ * and txs expire TX_LIFECYCLE_MAX_AGE_NANOS after they were sent.
+ */
+class TxLifecycleTracker {
+public:
+    static int64_t nowNanos() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    bool isTracking() const {
+        return trackedCount_.load(std::memory_order_relaxed) > 0;
+    }
+
+    /**
+     * @param sentNanos when the send was started, the direct send result can come in before the send returns
+     */
+    void startTracking(uint64_t txId, int64_t sentNanos) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        expire(sentNanos);
+        auto found = txs_.find(txId);
+        if (found == txs_.end()) {
+            if (txs_.size() >= TX_LIFECYCLE_CAPACITY) {
+                evictOldest();
+            }
+            found = txs_.emplace(txId, newLifecycle(txId)).first;
+        }
+        found->second.sentAtMillis = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+        found->second.stageNanos[TX_STAGE_SENT] = sentNanos;
+        for (int stage = TX_STAGE_SENT + 1; stage < TX_STAGE_COUNT; stage++) {
+            if (found->second.stageNanos[stage] >= 0) {
+                recordTransition(found->second, stage);
+            }
+        }
+        trackedCount_.store(txs_.size(), std::memory_order_relaxed);
+    }
+
+    /**
+     * Only the first time a tx reaches a stage counts.
+     */
+    void record(uint64_t txId, int stage, int64_t nanos) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto found = txs_.find(txId);
+        if (found == txs_.end()) {
+            // the result of a direct send may be reported before the send returned the tx id
+            if (stage != TX_STAGE_DIRECT_SEND_RESULT || txs_.size() >= TX_LIFECYCLE_CAPACITY) {
+                return;
+            }
+            found = txs_.emplace(txId, newLifecycle(txId)).first;
+            trackedCount_.store(txs_.size(), std::memory_order_relaxed);
+        }
+        TxLifecycle &lifecycle = found->second;
+        if (lifecycle.stageNanos[stage] >= 0) {
+            return;
+        }
+        lifecycle.stageNanos[stage] = nanos;
+        if (lifecycle.stageNanos[TX_STAGE_SENT] >= 0) {
+            recordTransition(lifecycle, stage);
+        }
+    }
+
+    /**
+     * Timelines of the sent txs, oldest first, and the transition windows indexed by the stage they lead to.
+     */
+    void snapshot(std::vector<TxLifecycle> &lifecycles, std::vector<int64_t> &transitionValues) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        expire(nowNanos());
+        for (auto &item : txs_) {
+            if (item.second.stageNanos[TX_STAGE_SENT] >= 0) {
+                lifecycles.push_back(item.second);
+            }
+        }
+        std::sort(lifecycles.begin(), lifecycles.end(), [](const TxLifecycle &a, const TxLifecycle &b) {
+            return a.stageNanos[TX_STAGE_SENT] < b.stageNanos[TX_STAGE_SENT];
+        });
+        for (int stage = TX_STAGE_SENT + 1; stage < TX_STAGE_COUNT; stage++) {
+            windows_[stage].appendValues(transitionValues);
+        }
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        txs_.clear();
+        for (auto &window : windows_) {
+            window = TxStageWindow();
+        }
+        trackedCount_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<uint64_t, TxLifecycle> txs_;
+    TxStageWindow windows_[TX_STAGE_COUNT];
+    std::atomic<size_t> trackedCount_{0};
+
+    static TxLifecycle newLifecycle(uint64_t txId) {
+        TxLifecycle lifecycle;
+        lifecycle.txId = txId;
+        std::fill(std::begin(lifecycle.stageNanos), std::end(lifecycle.stageNanos), -1);
+        return lifecycle;
+    }
+
+    // time from the latest earlier stage that was reached
+    void recordTransition(const TxLifecycle &lifecycle, int stage) {
+        int64_t from = -1;
+        for (int previous = stage - 1; previous >= TX_STAGE_SENT && from < 0; previous--) {
+            from = lifecycle.stageNanos[previous];
+        }
+        windows_[stage].record(std::max<int64_t>(0, lifecycle.stageNanos[stage] - from));
+    }
+
+    static int64_t firstSeenNanos(const TxLifecycle &lifecycle) {
+        for (int64_t nanos : lifecycle.stageNanos) {
+            if (nanos >= 0) {
+                return nanos;
+            }
+        }
+        return 0;
+    }
+
+    void evictOldest() {
+        auto oldest = std::min_element(txs_.begin(), txs_.end(), [](const auto &a, const auto &b) {
+            return firstSeenNanos(a.second) < firstSeenNanos(b.second);
+        });
+        txs_.erase(oldest);
+    }
+
+    void expire(int64_t now) {
+        for (auto it = txs_.begin(); it != txs_.end();) {
+            if (now - firstSeenNanos(it->second) > TX_LIFECYCLE_MAX_AGE_NANOS) {
+                it = txs_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+        trackedCount_.store(txs_.size(), std::memory_order_relaxed);
+    }
+};
+
+inline TxLifecycleTracker &GetTxLifecycleTracker() {
+    static TxLifecycleTracker tracker;
+    return tracker;
+}
+
+#endif // TX_LIFECYCLE_TRACKER_CPP
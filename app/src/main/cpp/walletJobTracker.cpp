@@ -0,0 +1,118 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef WALLET_JOB_TRACKER_CPP
+#define WALLET_JOB_TRACKER_CPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+/**
+ * Counts the worker pool jobs of each wallet, so a wallet is only destroyed once none of them can still use it.
+ *
+ * A job is counted from its submission until it's done. Once the teardown of its wallet started, no more jobs of
+ * it are accepted, the queued ones skip their work and the teardown waits for the running ones.
+ */
+class WalletJobTracker {
+public:
+    /**
+     * Called when a job of the wallet is submitted.
+     * @return false if the wallet is being destroyed, the job must not be submitted
+     */
+    bool begin(const void *wallet) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (closing_.count(wallet) != 0) {
+            return false;
+        }
+        jobCounts_[wallet]++;
+        return true;
+    }
+
+    /**
+     * Called once a job that began is done, or won't run.
+     */
+    void end(const void *wallet) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = jobCounts_.find(wallet);
+        if (it != jobCounts_.end() && --it->second == 0) {
+            jobCounts_.erase(it);
+            drained_.notify_all();
+        }
+    }
+
+    /**
+     * Queued jobs check this before they start, a job of a wallet being destroyed ends without running.
+     */
+    bool isClosing(const void *wallet) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return closing_.count(wallet) != 0;
+    }
+
+    /**
+     * Starts the teardown of the wallet and waits until none of its jobs is queued or running.
+     */
+    void close(const void *wallet) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        closing_.insert(wallet);
+        drained_.wait(lock, [this, wallet] { return jobCounts_.count(wallet) == 0; });
+    }
+
+    /**
+     * Ends the teardown once the wallet is destroyed, its address may be reused by the next wallet.
+     */
+    void reopen(const void *wallet) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closing_.erase(wallet);
+    }
+
+    size_t jobCount(const void *wallet) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = jobCounts_.find(wallet);
+        return it != jobCounts_.end() ? it->second : 0;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable drained_;
+    std::unordered_map<const void *, size_t> jobCounts_;
+    std::unordered_set<const void *> closing_;
+};
+
+inline WalletJobTracker &GetWalletJobTracker() {
+    static WalletJobTracker tracker;
+    return tracker;
+}
+
+#endif // WALLET_JOB_TRACKER_CPP
@@ -0,0 +1,242 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef WARM_START_SNAPSHOT_CPP
+#define WARM_START_SNAPSHOT_CPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <type_traits>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/**
+ * Warm-start snapshot: the last balance, the latest completed transactions and the scanned height,
+ * written next to the wallet datastore so the home screen has data before the wallet is created.
+ *
+ * The file is a header followed by txCount fixed size records, both in native byte order.
+ * Readers map the file and read the fields at fixed offsets, nothing is parsed.
+ * The layout is mirrored by FFIWarmStartSnapshot.kt, bump the version on every change.
+ */
+const uint32_t WARM_START_SNAPSHOT_MAGIC = 0x53535754; // "TWSS"
+const uint32_t WARM_START_SNAPSHOT_VERSION = 1;
+const char *const WARM_START_SNAPSHOT_FILE_NAME = "warm_start.snapshot";
+const size_t WARM_START_ADDRESS_SIZE = 128;
+const size_t WARM_START_PAYMENT_ID_SIZE = 256;
+
+struct WarmStartSnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t checksum;
+    uint64_t savedAtMillis;
+    uint64_t scannedHeight;
+    uint64_t availableBalance;
+    uint64_t pendingIncomingBalance;
+    uint64_t pendingOutgoingBalance;
+    uint64_t timeLockedBalance;
+    uint32_t txCount;
+    uint32_t txSize;
+};
+
+struct WarmStartSnapshotTx {
+    uint64_t id;
+    uint64_t amount;
+    uint64_t fee;
+    uint64_t timestamp;
+    uint64_t minedTimestamp;
+    uint64_t minedHeight;
+    int32_t status;
+    uint8_t isOutbound;
+    uint8_t addressLength;
+    uint16_t paymentIdLength;
+    uint8_t address[WARM_START_ADDRESS_SIZE];
+    uint8_t paymentId[WARM_START_PAYMENT_ID_SIZE];
+};
+
+static_assert(std::is_standard_layout<WarmStartSnapshotHeader>::value, "header is read at fixed offsets");
+static_assert(std::is_standard_layout<WarmStartSnapshotTx>::value, "records are read at fixed offsets");
+static_assert(sizeof(WarmStartSnapshotHeader) == 72, "header layout changed, bump the version");
+static_assert(sizeof(WarmStartSnapshotTx) == 440, "record layout changed, bump the version");
+
+inline std::string GetWarmStartSnapshotPath(const std::string &datastorePath) {
+    return datastorePath + "/" + WARM_START_SNAPSHOT_FILE_NAME;
+}
+
+/**
+ * FNV-1a over the whole file with the checksum field taken as zero.
+ */
+inline uint64_t WarmStartSnapshotChecksum(const uint8_t *pData, size_t size) {
+    const size_t checksumOffset = offsetof(WarmStartSnapshotHeader, checksum);
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++) {
+        uint8_t byte = (i >= checksumOffset && i < checksumOffset + sizeof(uint64_t)) ? 0 : pData[i];
+        hash = (hash ^ byte) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+/**
+ * Copies a string into a fixed size field, cut at a UTF-8 character boundary if it doesn't fit.
+ */
+inline size_t CopyUtf8Truncated(const char *pString, uint8_t *pOut, size_t capacity) {
+    size_t length = pString != nullptr ? strlen(pString) : 0;
+    if (length > capacity) {
+        length = capacity;
+        while (length > 0 && (static_cast<uint8_t>(pString[length]) & 0xC0) == 0x80) {
+            length--;
+        }
+    }
+    if (length > 0) {
+        memcpy(pOut, pString, length);
+    }
+    return length;
+}
+
+/**
+ * Writes to a temporary file and renames it over the old snapshot, so readers never see a partial file.
+ */
+inline bool WriteWarmStartSnapshot(const std::string &path, WarmStartSnapshotHeader header, const std::vector<WarmStartSnapshotTx> &txs) {
+    header.magic = WARM_START_SNAPSHOT_MAGIC;
+    header.version = WARM_START_SNAPSHOT_VERSION;
+    header.checksum = 0;
+    header.txCount = static_cast<uint32_t>(txs.size());
+    header.txSize = sizeof(WarmStartSnapshotTx);
+
+    std::vector<uint8_t> data(sizeof(header) + txs.size() * sizeof(WarmStartSnapshotTx));
+    memcpy(data.data(), &header, sizeof(header));
+    if (!txs.empty()) {
+        memcpy(data.data() + sizeof(header), txs.data(), txs.size() * sizeof(WarmStartSnapshotTx));
+    }
+    header.checksum = WarmStartSnapshotChecksum(data.data(), data.size());
+    memcpy(data.data() + offsetof(WarmStartSnapshotHeader, checksum), &header.checksum, sizeof(header.checksum));
+
+    std::string tempPath = path + ".tmp";
+    int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if (fd < 0) {
+        return false;
+    }
+    size_t written = 0;
+    while (written < data.size()) {
+        ssize_t result = write(fd, data.data() + written, data.size() - written);
+        if (result <= 0) {
+            close(fd);
+            unlink(tempPath.c_str());
+            return false;
+        }
+        written += static_cast<size_t>(result);
+    }
+    bool synced = fsync(fd) == 0;
+    close(fd);
+    if (!synced || rename(tempPath.c_str(), path.c_str()) != 0) {
+        unlink(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Read-only mapping of a snapshot file, only kept if the file is complete and the checksum matches.
+ */
+class WarmStartSnapshotMapping {
+public:
+    WarmStartSnapshotMapping() = default;
+    WarmStartSnapshotMapping(const WarmStartSnapshotMapping &) = delete;
+    WarmStartSnapshotMapping &operator=(const WarmStartSnapshotMapping &) = delete;
+
+    ~WarmStartSnapshotMapping() {
+        unmap();
+    }
+
+    bool map(const std::string &path) {
+        unmap();
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat fileStat{};
+        if (fstat(fd, &fileStat) != 0 || fileStat.st_size < static_cast<off_t>(sizeof(WarmStartSnapshotHeader))) {
+            close(fd);
+            return false;
+        }
+        size_t size = static_cast<size_t>(fileStat.st_size);
+        void *pData = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (pData == MAP_FAILED) {
+            return false;
+        }
+        pData_ = static_cast<const uint8_t *>(pData);
+        size_ = size;
+        if (!isValid()) {
+            unmap();
+            return false;
+        }
+        return true;
+    }
+
+    void unmap() {
+        if (pData_ != nullptr) {
+            munmap(const_cast<uint8_t *>(pData_), size_);
+            pData_ = nullptr;
+            size_ = 0;
+        }
+    }
+
+    const uint8_t *data() const {
+        return pData_;
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+private:
+    const uint8_t *pData_ = nullptr;
+    size_t size_ = 0;
+
+    bool isValid() const {
+        WarmStartSnapshotHeader header{};
+        memcpy(&header, pData_, sizeof(header));
+        return header.magic == WARM_START_SNAPSHOT_MAGIC
+               && header.version == WARM_START_SNAPSHOT_VERSION
+               && header.txSize == sizeof(WarmStartSnapshotTx)
+               && size_ == sizeof(header) + static_cast<size_t>(header.txCount) * sizeof(WarmStartSnapshotTx)
+               && header.checksum == WarmStartSnapshotChecksum(pData_, size_);
+    }
+};
+
+#endif // WARM_START_SNAPSHOT_CPP
@@ -0,0 +1,193 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef WORKER_POOL_CPP
+#define WORKER_POOL_CPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Bounded pool for the blocking wallet operations, so Java threads don't sit parked in libwallet.
+ *
+ * Every worker owns a queue, submissions are spread over the queues round robin and a worker that runs dry
+ * steals from the back of the other queues. A job gets an id on submission, which is passed to the job so it
+ * can report its completion. The pool refuses jobs once `capacity` of them are queued or running.
+ */
+class WorkerPool {
+public:
+    using Task = std::function<void(uint64_t jobId)>;
+
+    WorkerPool(size_t threadCount, size_t capacity, std::function<void()> onWorkerExit = nullptr)
+            : capacity_(capacity), onWorkerExit_(std::move(onWorkerExit)) {
+        for (size_t i = 0; i < threadCount; i++) {
+            queues_.push_back(std::make_unique<Queue>());
+        }
+        for (size_t i = 0; i < threadCount; i++) {
+            threads_.emplace_back(&WorkerPool::run, this, i);
+        }
+    }
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stopping_ = true;
+        }
+        wakeUp_.notify_all();
+        for (auto &thread: threads_) {
+            thread.join();
+        }
+    }
+
+    /**
+     * @return the id of the job, 0 if the pool is at capacity
+     */
+    uint64_t submit(Task task) {
+        size_t pending = pending_.load();
+        do {
+            if (pending >= capacity_) {
+                return 0;
+            }
+        } while (!pending_.compare_exchange_weak(pending, pending + 1));
+
+        uint64_t jobId = nextJobId_.fetch_add(1);
+        Queue &queue = *queues_[nextQueue_.fetch_add(1) % queues_.size()];
+        {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.jobs.push_back(Job{jobId, std::move(task)});
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            queued_++;
+        }
+        wakeUp_.notify_one();
+        return jobId;
+    }
+
+    /**
+     * Jobs queued or running.
+     */
+    size_t pendingCount() const {
+        return pending_.load();
+    }
+
+    size_t threadCount() const {
+        return threads_.size();
+    }
+
+private:
+    struct Job {
+        uint64_t id;
+        Task task;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> threads_;
+    const size_t capacity_;
+    std::function<void()> onWorkerExit_;
+    std::atomic<uint64_t> nextJobId_{1};
+    std::atomic<size_t> nextQueue_{0};
+    std::atomic<size_t> pending_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable wakeUp_;
+    size_t queued_ = 0;
+    bool stopping_ = false;
+
+    bool popOwn(size_t index, Job &job) {
+        Queue &queue = *queues_[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty()) {
+            return false;
+        }
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        return true;
+    }
+
+    bool steal(size_t thief, Job &job) {
+        for (size_t offset = 1; offset < queues_.size(); offset++) {
+            Queue &queue = *queues_[(thief + offset) % queues_.size()];
+            std::unique_lock<std::mutex> lock(queue.mutex, std::try_to_lock);
+            if (!lock.owns_lock() || queue.jobs.empty()) {
+                continue;
+            }
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            return true;
+        }
+        return false;
+    }
+
+    void run(size_t index) {
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(sleepMutex_);
+                wakeUp_.wait(lock, [this] { return queued_ > 0 || stopping_; });
+                if (stopping_) {
+                    break;
+                }
+            }
+            Job job;
+            if (!popOwn(index, job) && !steal(index, job)) {
+                // another worker got it first, or a queue was busy, look again
+                std::this_thread::yield();
+                continue;
+            }
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex_);
+                queued_--;
+            }
+            job.task(job.id);
+            pending_.fetch_sub(1);
+        }
+        if (onWorkerExit_) {
+            onWorkerExit_();
+        }
+    }
+};
+
+#endif // WORKER_POOL_CPP
@@ -43,6 +43,7 @@ import com.tari.android.wallet.data.network.NetworkConnectionStateReceiver
 import com.tari.android.wallet.data.sharedPrefs.security.SecurityPrefRepository
 import com.tari.android.wallet.di.ApplicationScope
 import com.tari.android.wallet.di.DiContainer
+import com.tari.android.wallet.ffi.FFITrace
 import com.tari.android.wallet.infrastructure.logging.LoggerAdapter
 import com.tari.android.wallet.notification.NotificationHelper
 import com.tari.android.wallet.util.DebugConfig
@@ -88,6 +89,7 @@ class TariWalletApplication : Application() {
 
     init {
         System.loadLibrary("native-lib")
+        FFITrace.setEnabled(DebugConfig.nativeTraceEnabled)
     }
 
     override fun onCreate() {
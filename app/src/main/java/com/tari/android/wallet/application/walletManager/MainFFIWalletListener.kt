@@ -5,11 +5,14 @@ import com.tari.android.wallet.data.BalanceStateHandler
 import com.tari.android.wallet.data.baseNode.BaseNodeStateHandler
 import com.tari.android.wallet.data.recovery.WalletRestorationState
 import com.tari.android.wallet.data.recovery.WalletRestorationStateHandler
+import com.tari.android.wallet.ffi.FFIBatchSendCompletion
+import com.tari.android.wallet.ffi.FFIWalletCreateStage
 import com.tari.android.wallet.ffi.runWithDestroy
 import com.tari.android.wallet.model.BalanceInfo
 import com.tari.android.wallet.model.TariBaseNodeState
 import com.tari.android.wallet.model.TariContact
 import com.tari.android.wallet.model.TariWalletAddress
+import com.tari.android.wallet.model.TxId
 import com.tari.android.wallet.model.tx.CancelledTx
 import com.tari.android.wallet.model.tx.CompletedTx
 import com.tari.android.wallet.model.tx.PendingInboundTx
@@ -132,6 +135,19 @@ class MainFFIWalletListener(
         baseNodeStateHandler.saveBaseNodeState(baseNodeState)
     }
 
+    override fun onConfirmationsChanged(confirmations: Map<TxId, Int>) = runOnMain {
+        walletManager.sendWalletEvent(WalletEvent.Tx.ConfirmationsChanged(confirmations))
+    }
+
+    override fun onBatchSendCompleted(completion: FFIBatchSendCompletion) = runOnMain {
+        walletManager.sendWalletEvent(WalletEvent.TxSend.BatchSendCompleted(completion))
+    }
+
+    // not switched to main, the wallet manager is waiting for it on the creating coroutine
+    override fun onWalletCreateProgress(stage: FFIWalletCreateStage, errorCode: Int) {
+        walletManager.onWalletCreateProgress(stage, errorCode)
+    }
+
     private fun getUserByWalletAddress(address: TariWalletAddress): TariContact =
         walletManager.requireWalletInstance.findContactByWalletAddress(address)?.runWithDestroy { TariContact(it) } ?: TariContact(address)
 
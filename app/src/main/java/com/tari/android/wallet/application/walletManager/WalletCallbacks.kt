@@ -3,19 +3,25 @@ package com.tari.android.wallet.application.walletManager
 import com.orhanobut.logger.Logger
 import com.tari.android.wallet.data.recovery.WalletRestorationState
 import com.tari.android.wallet.ffi.FFIBalance
+import com.tari.android.wallet.ffi.FFIBatchSendCompletion
 import com.tari.android.wallet.ffi.FFICompletedTx
+import com.tari.android.wallet.ffi.FFIJobs
 import com.tari.android.wallet.ffi.FFIPendingInboundTx
 import com.tari.android.wallet.ffi.FFIPointer
 import com.tari.android.wallet.ffi.FFITariBaseNodeState
+import com.tari.android.wallet.ffi.FFITransactionSendStatus
+import com.tari.android.wallet.ffi.FFIWalletCreateStage
 import com.tari.android.wallet.ffi.runWithDestroy
 import com.tari.android.wallet.model.BalanceInfo
 import com.tari.android.wallet.model.TariBaseNodeState
+import com.tari.android.wallet.model.TxId
 import com.tari.android.wallet.model.tx.CancelledTx
 import com.tari.android.wallet.model.tx.CompletedTx
 import com.tari.android.wallet.model.tx.PendingInboundTx
 import com.tari.android.wallet.model.tx.PendingOutboundTx
 import com.tari.android.wallet.model.tx.Tx
 import java.math.BigInteger
+import java.util.concurrent.ConcurrentHashMap
 import javax.inject.Inject
 import javax.inject.Singleton
 
@@ -31,7 +37,7 @@ class WalletCallbacks @Inject constructor() {
     private val logger
         get() = Logger.t(WalletCallbacks::class.simpleName)
 
-    private val listeners = mutableMapOf<Int, FFIWalletListener>()
+    private val listeners = ConcurrentHashMap<Int, FFIWalletListener>()
 
     fun addListener(walletContextId: Int, listener: FFIWalletListener) {
         listeners[walletContextId] = listener
@@ -118,7 +124,8 @@ class WalletCallbacks @Inject constructor() {
     }
 
     fun onDirectSendResult(contextPtr: ByteArray, bytes: ByteArray, pointer: FFIPointer) {
-        // FIXME: not used anymore, should be removed once FFI is updated
+        // FIXME: not used anymore, should be removed once FFI is updated. Batch sends get theirs in onBatchSendCompleted.
+        FFITransactionSendStatus(pointer).destroy()
     }
 
     fun onTxCancelled(contextPtr: ByteArray, completedTx: FFIPointer, rejectionReason: ByteArray) {
@@ -198,6 +205,44 @@ class WalletCallbacks @Inject constructor() {
         listeners[walletContextId]?.onWalletRestoration(state)
     }
 
+    fun onWalletCreateProgress(contextPtr: ByteArray, stage: Int, errorCode: Int) {
+        val walletContextId = BigInteger(1, contextPtr).toInt()
+        val createStage = FFIWalletCreateStage.fromInt(stage)
+        log(walletContextId, "Wallet creation: $createStage${if (createStage == FFIWalletCreateStage.Failed) " ($errorCode)" else ""}")
+        listeners[walletContextId]?.onWalletCreateProgress(createStage, errorCode)
+    }
+
+    fun onJobCompleted(contextPtr: ByteArray, jobId: Long, result: Long, errorCode: Int) {
+        FFIJobs.onCompleted(jobId, result, errorCode)
+    }
+
+    /**
+     * Confirmation counts of the mined txs that changed with a new tip, counted natively. Txs that reached the required
+     * confirmations are reported once more and then dropped.
+     */
+    fun onConfirmationsChanged(contextPtr: ByteArray, txIds: LongArray, confirmationCounts: LongArray) {
+        val walletContextId = BigInteger(1, contextPtr).toInt()
+        val confirmations = txIds.indices.associate { index ->
+            txIds[index].toULong().toString().toBigInteger() to confirmationCounts[index].toInt()
+        }
+        log(walletContextId, "Confirmations changed for ${confirmations.size} txs")
+        listeners[walletContextId]?.onConfirmationsChanged(confirmations)
+    }
+
+    /**
+     * The direct send statuses of the txs of a batch send, correlated natively, see [FFIBatchSendCompletion].
+     */
+    fun onBatchSendCompleted(contextPtr: ByteArray, batchId: Long, txIds: LongArray, sendStatuses: IntArray) {
+        val walletContextId = BigInteger(1, contextPtr).toInt()
+        val completion = FFIBatchSendCompletion(
+            batchId = batchId,
+            txIds = txIds.map { if (it == 0L) null else it.toULong().toString().toBigInteger() },
+            sendStatuses = sendStatuses.toList(),
+        )
+        log(walletContextId, "Batch send $batchId completed with ${txIds.size} txs")
+        listeners[walletContextId]?.onBatchSendCompleted(completion)
+    }
+
     private fun log(walletContextId: Int, message: String, oldMessage: String = "") {
         if (message == oldMessage) return
         logger.i("${if (walletContextId == PAPER_WALLET_CONTEXT_ID) "(Paper wallet) " else ""}$message")
@@ -225,4 +270,7 @@ interface FFIWalletListener {
     fun onWalletRestoration(state: WalletRestorationState) = Unit
     fun onWalletScannedHeight(height: Int) = Unit
     fun onBaseNodeStateChanged(baseNodeState: TariBaseNodeState) = Unit
+    fun onWalletCreateProgress(stage: FFIWalletCreateStage, errorCode: Int) = Unit
+    fun onConfirmationsChanged(confirmations: Map<TxId, Int>) = Unit
+    fun onBatchSendCompleted(completion: FFIBatchSendCompletion) = Unit
 }
\ No newline at end of file
@@ -45,11 +45,20 @@ import com.tari.android.wallet.data.sharedPrefs.security.SecurityPrefRepository
 import com.tari.android.wallet.data.sharedPrefs.tariSettings.TariSettingsPrefRepository
 import com.tari.android.wallet.di.ApplicationScope
 import com.tari.android.wallet.ffi.Base58String
+import com.tari.android.wallet.ffi.FFIBatchSendCompletion
+import com.tari.android.wallet.ffi.FFICallbackDedup
+import com.tari.android.wallet.ffi.FFICallbackSubscriptions
+import com.tari.android.wallet.ffi.FFICallbackType
 import com.tari.android.wallet.ffi.FFICommsConfig
+import com.tari.android.wallet.ffi.FFIError
 import com.tari.android.wallet.ffi.FFIException
 import com.tari.android.wallet.ffi.FFISeedWords
 import com.tari.android.wallet.ffi.FFITariWalletAddress
+import com.tari.android.wallet.ffi.FFITxHistoryIndex
 import com.tari.android.wallet.ffi.FFIWallet
+import com.tari.android.wallet.ffi.FFIWalletCreateStage
+import com.tari.android.wallet.ffi.FFIWarmStartSnapshot
+import com.tari.android.wallet.ffi.WarmStartSnapshot
 import com.tari.android.wallet.ffi.runWithDestroy
 import com.tari.android.wallet.model.MicroTari
 import com.tari.android.wallet.model.TariContact
@@ -64,15 +73,20 @@ import com.tari.android.wallet.notification.FcmHelper
 import com.tari.android.wallet.ui.common.DialogManager
 import com.tari.android.wallet.ui.screen.send.obsolete.finalize.FinalizeSendTxModel
 import com.tari.android.wallet.util.BroadcastEffectFlow
+import com.tari.android.wallet.util.DebugConfig
 import com.tari.android.wallet.util.extension.collectFlow
 import com.tari.android.wallet.util.extension.safeCastTo
+import kotlinx.coroutines.CancellationException
 import kotlinx.coroutines.CoroutineScope
 import kotlinx.coroutines.Dispatchers
 import kotlinx.coroutines.flow.Flow
 import kotlinx.coroutines.flow.MutableStateFlow
 import kotlinx.coroutines.flow.asStateFlow
+import kotlinx.coroutines.flow.filterNotNull
+import kotlinx.coroutines.flow.first
 import kotlinx.coroutines.flow.update
 import kotlinx.coroutines.launch
+import kotlinx.coroutines.withContext
 import java.util.concurrent.atomic.AtomicReference
 import javax.inject.Inject
 import javax.inject.Singleton
@@ -111,6 +125,22 @@ class WalletManager @Inject constructor(
     private val _walletState = MutableStateFlow<WalletState>(WalletState.NotReady)
     val walletState = _walletState.asStateFlow()
 
+    /**
+     * The wallet being created on the native worker thread, the UI can show cached data meanwhile.
+     */
+    private val pendingWallet = AtomicReference<FFIWallet>()
+    private val _walletCreateStage = MutableStateFlow<FFIWalletCreateStage?>(null)
+    val walletCreateStage = _walletCreateStage.asStateFlow()
+
+    @Volatile
+    private var walletCreateErrorCode = 0
+
+    /**
+     * Balance and latest txs saved when the app went to background, shown until the live data arrives.
+     */
+    private val _warmStartSnapshot = MutableStateFlow<WarmStartSnapshot?>(null)
+    val warmStartSnapshot = _warmStartSnapshot.asStateFlow()
+
     private val _walletEvent = BroadcastEffectFlow<WalletEvent>()
     val walletEvent: Flow<WalletEvent> = _walletEvent.flow
 
@@ -124,6 +154,9 @@ class WalletManager @Inject constructor(
                 is AppStateHandler.AppEvent.AppForegrounded,
                 is AppStateHandler.AppEvent.AppDestroyed -> walletConfig.removeUnnecessaryLogs()
             }
+            if (event is AppStateHandler.AppEvent.AppBackgrounded) {
+                withContext(Dispatchers.IO) { writeWarmStartSnapshot() }
+            }
         }
 
         applicationScope.collectFlow(airdropRepository.airdropToken) { airdropToken ->
@@ -149,6 +182,10 @@ class WalletManager @Inject constructor(
                 walletRestorationStateHandler = walletRestorationStateHandler,
             ),
         )
+        // contact liveness updates aren't shown anywhere, don't let them cross into Java. Nothing reads the batched
+        // confirmations yet either, the mined unconfirmed callbacks carry the same counts.
+        FFICallbackSubscriptions.subscribeAllExcept(FFICallbackType.ContactsLivenessDataUpdated, FFICallbackType.ConfirmationsChanged)
+        FFICallbackDedup.setEnabled(!DebugConfig.bypassCallbackDedup)
 
         startWallet(ffiSeedWords, createWallet)
     }
@@ -160,10 +197,13 @@ class WalletManager @Inject constructor(
             applicationScope.launch {
                 try {
                     if (walletInstance == null) {
+                        loadWarmStartSnapshot()
                         walletInstance = initWallet(ffiSeedWords, createWallet)
                     }
                     _walletState.update { WalletState.Running }
                     logger.i("Start wallet: Wallet was started")
+                } catch (e: CancellationException) {
+                    logger.i("Start wallet: Wallet creation was cancelled")
                 } catch (e: Exception) {
                     val oldCode = walletState.value.errorCode
                     val newCode = e.safeCastTo<FFIException>()?.error?.code
@@ -177,10 +217,11 @@ class WalletManager @Inject constructor(
         }
     }
 
-    private fun initWallet(ffiSeedWords: FFISeedWords?, createWallet: Boolean): FFIWallet {
+    private suspend fun initWallet(ffiSeedWords: FFISeedWords?, createWallet: Boolean): FFIWallet {
         val passphrase = securityPrefRepository.databasePassphrase.takeIf { !it.isNullOrEmpty() }
             ?: corePrefRepository.generateDatabasePassphrase().also { securityPrefRepository.databasePassphrase = it }
 
+        _walletCreateStage.update { null }
         val wallet = FFIWallet(
             walletContextId = MAIN_WALLET_CONTEXT_ID,
             tariNetwork = networkPrefRepository.currentNetwork,
@@ -190,12 +231,24 @@ class WalletManager @Inject constructor(
             seedWords = ffiSeedWords,
             walletCallbacks = walletCallbacks,
             createWallet = createWallet,
+            createAsync = true,
         )
+        pendingWallet.set(wallet)
+
+        val stage = walletCreateStage.filterNotNull().first { it.isCreationFinished }
+        if (!pendingWallet.compareAndSet(wallet, null) || stage == FFIWalletCreateStage.Cancelled) {
+            throw CancellationException("Wallet creation was cancelled")
+        }
+        if (stage == FFIWalletCreateStage.Failed) {
+            throw FFIException(FFIError(walletCreateErrorCode))
+        }
 
         // Need to update the balance state after the wallet is initialized,
         // because the first balance callback is called after the wallet is connected to the base node and validated
         balanceStateHandler.updateBalanceState(wallet.getBalance())
 
+        openTxHistoryIndex(wallet)
+
         saveWalletAddressToSharedPrefs(wallet)
 
         // register wallet for push notifications
@@ -204,6 +257,63 @@ class WalletManager @Inject constructor(
         return wallet
     }
 
+    fun onWalletCreateProgress(stage: FFIWalletCreateStage, errorCode: Int) {
+        walletCreateErrorCode = errorCode
+        _walletCreateStage.update { stage }
+    }
+
+    /**
+     * If the native creation has already finished the wallet pointer is set, so it's destroyed instead.
+     * The listener is removed right after, so the cancelled stage is reported from here.
+     */
+    private fun cancelWalletCreation() {
+        val wallet = pendingWallet.getAndSet(null) ?: return
+        if (!wallet.cancelCreation()) {
+            wallet.destroy()
+        }
+        _walletCreateStage.update { FFIWalletCreateStage.Cancelled }
+    }
+
+    private fun loadWarmStartSnapshot() {
+        val snapshot = runCatching { FFIWarmStartSnapshot.read(walletConfig.getWalletFilesDirPath()) }
+            .onFailure { logger.i("Start wallet: Couldn't read the warm start snapshot: ${it.message}") }
+            .getOrNull() ?: return
+        logger.i("Start wallet: Warm start snapshot with ${snapshot.txs.size} txs")
+        balanceStateHandler.updateBalanceState(snapshot.balance)
+        baseNodeStateHandler.saveWalletScannedHeight(snapshot.scannedHeight.toInt())
+        _warmStartSnapshot.update { snapshot }
+    }
+
+    /**
+     * Synchronized with [stop], so the wallet isn't destroyed between the state check and the write.
+     */
+    @Synchronized
+    private fun writeWarmStartSnapshot() {
+        val wallet = walletInstance?.takeIf { walletState.value is WalletState.Running } ?: return
+        runCatching {
+            wallet.writeWarmStartSnapshot(
+                datastorePath = walletConfig.getWalletFilesDirPath(),
+                maxTxCount = WARM_START_TX_COUNT,
+                scannedHeight = baseNodeStateHandler.walletScannedHeight.value.toLong(),
+            )
+        }.onFailure { logger.i("Couldn't write the warm start snapshot: ${it.message}") }
+    }
+
+    /**
+     * The callbacks keep the index in sync from here on, the rebuild covers what happened while it was closed.
+     */
+    private fun openTxHistoryIndex(wallet: FFIWallet) {
+        if (!FFITxHistoryIndex.open(walletConfig.getWalletFilesDirPath())) {
+            logger.i("Start wallet: Couldn't open the tx history index")
+            return
+        }
+        applicationScope.launch(Dispatchers.IO) {
+            runCatching { wallet.syncTxHistoryIndex() }
+                .onSuccess { logger.i("Start wallet: Tx history index rebuilt with $it txs") }
+                .onFailure { logger.i("Start wallet: Couldn't rebuild the tx history index: ${it.message}") }
+        }
+    }
+
     private fun createCommsConfig(): FFICommsConfig = FFICommsConfig(
         databaseName = WalletConfig.WALLET_DB_NAME,
         datastorePath = walletConfig.getWalletFilesDirPath(),
@@ -244,22 +354,34 @@ class WalletManager @Inject constructor(
 
     @Synchronized
     fun stop() {
-        walletInstance?.destroy()
+        // callbacks still in flight are dropped by the listener removal, so destroying doesn't wait on them
+        walletCallbacks.removeListener(MAIN_WALLET_CONTEXT_ID)
+        cancelWalletCreation()
+        walletInstance?.let { wallet ->
+            wallet.destroy()
+            logger.i(
+                "Wallet destroyed, ${wallet.getDroppedCallbackCount()} callbacks dropped and " +
+                        "${FFICallbackDedup.getSuppressedCount()} duplicates suppressed in total"
+            )
+        }
         walletInstance = null
+        FFITxHistoryIndex.close()
         _walletState.update { WalletState.NotReady }
-        walletCallbacks.removeListener(MAIN_WALLET_CONTEXT_ID)
     }
 
     fun deleteWallet() {
         logger.i("Deleting wallet: ${walletInstance?.getWalletAddress()?.fullBase58() ?: "wallet is already null!"}")
+        cancelWalletCreation()
         walletInstance?.destroy()
         walletInstance = null
+        FFITxHistoryIndex.close()
         _walletState.update { WalletState.NotReady }
         applicationScope.launch(Dispatchers.Main) {
             _walletEvent.send(WalletEvent.OnWalletRemove)
             dialogManager.dismissAll()
         }
         walletConfig.clearWalletFiles()
+        _warmStartSnapshot.update { null }
         corePrefRepository.clear()
         walletCallbacks.removeAllListeners()
         airdropRepository.clear()
@@ -277,24 +399,28 @@ class WalletManager @Inject constructor(
     }
 
     @Throws(FFIException::class)
-    fun sendTari(
+    suspend fun sendTari(
         tariContact: TariContact,
         amount: MicroTari,
         feePerGram: MicroTari,
         message: String,
     ): TxId {
         val recipientAddress = FFITariWalletAddress(Base58String(tariContact.walletAddress.fullBase58))
-
-        val txId = requireWalletInstance.sendTx(recipientAddress, amount.value, feePerGram.value, message)
-
-        recipientAddress.destroy()
-        return txId
+        try {
+            return requireWalletInstance.sendTxAwait(recipientAddress, amount.value, feePerGram.value, message)
+        } finally {
+            recipientAddress.destroy()
+        }
     }
 
     fun getLastAccessedToDbVersion(): String {
         return createCommsConfig().runWithDestroy { it.getLastVersion() }
     }
 
+    companion object {
+        private const val WARM_START_TX_COUNT = 20
+    }
+
     sealed class WalletEvent {
         object Tx {
             data class TxReceived(val tx: PendingInboundTx) : WalletEvent()
@@ -307,11 +433,13 @@ class WalletManager @Inject constructor(
             data class TxFauxConfirmed(val tx: CompletedTx) : WalletEvent()
             data class TxFauxMinedUnconfirmed(val tx: CompletedTx, val confirmationCount: Int) : WalletEvent()
             data class TxCancelled(val tx: CancelledTx) : WalletEvent()
+            data class ConfirmationsChanged(val confirmations: Map<TxId, Int>) : WalletEvent()
         }
 
         object TxSend {
             data class TxSendSuccessful(val txId: TxId) : WalletEvent()
             data class TxSendFailed(val failureReason: FinalizeSendTxModel.TxFailureReason) : WalletEvent()
+            data class BatchSendCompleted(val completion: FFIBatchSendCompletion) : WalletEvent()
         }
 
         data object OnWalletRemove : WalletEvent()
@@ -4,8 +4,13 @@ import com.orhanobut.logger.Logger
 import com.tari.android.wallet.application.walletManager.WalletManager
 import com.tari.android.wallet.application.walletManager.WalletManager.WalletEvent
 import com.tari.android.wallet.application.walletManager.doOnWalletRunning
+import com.tari.android.wallet.data.contacts.Contact
 import com.tari.android.wallet.data.contacts.ContactsRepository
 import com.tari.android.wallet.di.ApplicationScope
+import com.tari.android.wallet.ffi.Base58String
+import com.tari.android.wallet.ffi.FFITariWalletAddress
+import com.tari.android.wallet.ffi.FFITxHistoryIndex
+import com.tari.android.wallet.ffi.runWithDestroy
 import com.tari.android.wallet.model.TxId
 import com.tari.android.wallet.model.tx.Tx
 import kotlinx.coroutines.CoroutineScope
@@ -36,6 +41,16 @@ class TxRepository @Inject constructor(
             contactsRepository.contactList.collect {
                 // need to refresh tx list to update contact info
                 refreshTxList()
+                updateTxHistoryAliases(it)
+            }
+        }
+
+        applicationScope.launch(Dispatchers.IO) {
+            walletManager.warmStartSnapshot.collect { snapshot ->
+                // shown until the first refresh from the wallet replaces it
+                if (snapshot != null && !_txsInitialized.value) {
+                    _txs.value = TxListData(completedTxs = snapshot.txs.map { it.toDto() })
+                }
             }
         }
 
@@ -57,6 +72,9 @@ class TxRepository @Inject constructor(
 
                     is WalletEvent.OnWalletRemove -> clear()
 
+                    // not subscribed to, the mined unconfirmed callbacks of the same txs refresh the list
+                    is WalletEvent.Tx.ConfirmationsChanged -> Unit
+
                     else -> Unit
                 }
             }
@@ -93,6 +111,21 @@ class TxRepository @Inject constructor(
         }
     }
 
+    /**
+     * The tx history index searches txs by the alias of their contact as well.
+     */
+    private fun updateTxHistoryAliases(contacts: List<Contact>) {
+        runCatching {
+            FFITxHistoryIndex.setAliases(
+                contacts.mapNotNull { contact ->
+                    val alias = contact.alias?.takeIf { it.isNotBlank() && !contact.walletAddress.unknownAddress } ?: return@mapNotNull null
+                    val address = FFITariWalletAddress(Base58String(contact.walletAddress.fullBase58)).runWithDestroy { it.getByteVector() }
+                    address.runWithDestroy { it.byteArray() } to alias
+                }
+            )
+        }.onFailure { logger.i("Couldn't update the tx history aliases: ${it.message}") }
+    }
+
     private fun Tx.toDto() = TxDto(
         tx = this,
         contact = contactsRepository.findOrCreateContact(this.tariContact.walletAddress),
@@ -47,8 +47,19 @@ abstract class FFIBase {
     var pointer = nullptr
         protected set
 
+    init {
+        FFIHandleScope.onWrapperCreated(this)
+    }
+
     abstract fun destroy()
 
+    /**
+     * Called by [FFIHandleScope] once the scope the native object was created in has destroyed it.
+     */
+    internal fun onReleasedByScope() {
+        pointer = nullptr
+    }
+
     protected fun finalize() {
         if (pointer != nullptr) {
             destroy()
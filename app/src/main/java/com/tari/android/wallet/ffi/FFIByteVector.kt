@@ -45,6 +45,8 @@ class FFIByteVector() : FFIBase() {
     private external fun jniGetAt(index: Int, error: FFIError): Int
     private external fun jniDestroy()
     private external fun jniCreate(byteArray: ByteArray, error: FFIError)
+    private external fun jniGetBytes(error: FFIError): ByteArray
+    private external fun jniGetHex(error: FFIError): String
 
     constructor(pointer: FFIPointer) : this() {
         if (pointer.isNull()) error("Pointer must not be null")
@@ -59,20 +61,16 @@ class FFIByteVector() : FFIBase() {
 
     fun getLength(): Int = runWithError { jniGetLength(it) }
 
-    fun byteArray(): ByteArray {
-        val length = getLength()
-        val byteArray = ByteArray(length)
-        for (i in byteArray.indices) {
-            byteArray[i] = getAt(i).toByte()
-        }
-        return byteArray
-    }
+    fun byteArray(): ByteArray = runWithError { jniGetBytes(it) }
 
     fun base58(): Base58 = Base58String(this).base58
 
-    fun hex(): String = HexString(this).hex
+    /**
+     * Upper case hex encoding of the bytes, done natively without copying the bytes to the JVM first.
+     */
+    fun hex(): String = runWithError { jniGetHex(it) }
 
-    override fun toString(): String = HexString(this).hex
+    override fun toString(): String = hex()
 
     override fun destroy() = jniDestroy()
 }
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+/**
+ * Latency stats of a single native entry point, see [FFIWallet.getCallStats].
+ * Percentiles come from a histogram with 12.5% precision.
+ *
+ * @author The Tari Development Team
+ */
+data class FFICallStats(
+    val name: String,
+    val count: Long,
+    val totalNanos: Long,
+    val maxNanos: Long,
+    val p50Nanos: Long,
+    val p90Nanos: Long,
+    val p99Nanos: Long,
+    val p999Nanos: Long,
+) {
+
+    val meanNanos: Long
+        get() = if (count == 0L) 0 else totalNanos / count
+
+    companion object {
+        private const val JNI_PREFIX = "Java_com_tari_android_wallet_ffi_"
+
+        // must match the layout written by jniGetCallStatsValues
+        private const val FIELD_COUNT = 7
+
+        fun fromValues(name: String, values: LongArray, index: Int): FFICallStats {
+            val offset = index * FIELD_COUNT
+            return FFICallStats(
+                name = name.removePrefix(JNI_PREFIX),
+                count = values[offset],
+                totalNanos = values[offset + 1],
+                maxNanos = values[offset + 2],
+                p50Nanos = values[offset + 3],
+                p90Nanos = values[offset + 4],
+                p99Nanos = values[offset + 5],
+                p999Nanos = values[offset + 6],
+            )
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+/**
+ * Suppresses repeated tx callbacks natively. A tx callback whose tx, type and confirmation count (or rejection reason)
+ * match what was last delivered for the tx doesn't cross into Java. Enabled by default.
+ *
+ * @author The Tari Development Team
+ */
+object FFICallbackDedup {
+
+    private external fun jniSetEnabled(enabled: Boolean)
+    private external fun jniIsEnabled(): Boolean
+    private external fun jniClear()
+    private external fun jniGetSuppressedCount(): Long
+
+    /**
+     * Disabling it delivers every callback again and forgets the delivered states.
+     */
+    fun setEnabled(enabled: Boolean) = jniSetEnabled(enabled)
+
+    fun isEnabled(): Boolean = jniIsEnabled()
+
+    /**
+     * Forgets the delivered states, the next callback of every tx is delivered.
+     */
+    fun clear() = jniClear()
+
+    /**
+     * Duplicate callbacks suppressed since the app started.
+     */
+    fun getSuppressedCount(): Long = jniGetSuppressedCount()
+}
@@ -0,0 +1,80 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+/**
+ * Priority lanes of the native wallet callback delivery. Callbacks are delivered from one thread, always from the
+ * highest lane with something queued, so a received tx never waits behind a flood of liveness or scan height updates.
+ *
+ * @author The Tari Development Team
+ */
+object FFICallbackLanes {
+
+    enum class Lane(val value: Int) {
+        High(0),
+        Normal(1),
+        Low(2),
+    }
+
+    private external fun jniSetLane(callbackType: Int, lane: Int): Boolean
+    private external fun jniGetLaneStatsValues(): LongArray
+    private external fun jniResetLaneStats()
+    private external fun jniGetDeliveryCounters(): LongArray
+
+    /**
+     * @param attachCount threads attached to the VM to deliver a callback
+     * @param droppedCount deliveries dropped because no JNIEnv was available or their lane was full, see
+     * [FFIWallet.getDroppedCallbackCount] for those dropped because the wallet was destroyed before they ran
+     */
+    data class DeliveryCounters(val attachCount: Long, val droppedCount: Long)
+
+    /**
+     * The tx callbacks share the high lane by default. Moving only some of them elsewhere can reorder the status updates of a tx.
+     */
+    fun setLane(callbackType: FFICallbackType, lane: Lane): Boolean = jniSetLane(callbackType.value, lane.value)
+
+    /**
+     * Time from queueing a callback until its delivery returned, one entry per lane.
+     */
+    fun getLaneStats(): List<FFICallStats> {
+        val values = jniGetLaneStatsValues()
+        return Lane.entries.map { FFICallStats.fromValues(it.name, values, it.value) }
+    }
+
+    fun resetLaneStats() = jniResetLaneStats()
+
+    /**
+     * Totals since the library was loaded.
+     */
+    fun getDeliveryCounters(): DeliveryCounters = jniGetDeliveryCounters().let { DeliveryCounters(it[0], it[1]) }
+}
@@ -0,0 +1,69 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+import com.tari.android.wallet.model.TxId
+
+/**
+ * Wallet callbacks Kotlin wants to receive. The others are dropped natively before they cross into Java,
+ * together with their payload. Everything is subscribed until the first [subscribe] call.
+ *
+ * @author The Tari Development Team
+ */
+object FFICallbackSubscriptions {
+
+    private external fun jniSubscribe(typeMask: Int, txIds: LongArray?, txIdTypeMask: Int)
+    private external fun jniGetFilteredCount(): Long
+
+    /**
+     * Replaces the current subscription.
+     *
+     * @param txIdFilteredTypes of the subscribed types, those only delivered for the txs in [txIds]
+     */
+    fun subscribe(
+        types: Set<FFICallbackType>,
+        txIds: Collection<TxId> = emptyList(),
+        txIdFilteredTypes: Set<FFICallbackType> = emptySet(),
+    ) = jniSubscribe(
+        typeMask = types.fold(0) { mask, type -> mask or type.mask },
+        txIds = txIds.map { it.toLong() }.toLongArray(), // u64 bits
+        txIdTypeMask = txIdFilteredTypes.fold(0) { mask, type -> mask or type.mask },
+    )
+
+    fun subscribeAllExcept(vararg types: FFICallbackType) = subscribe(FFICallbackType.entries.toSet() - types.toSet())
+
+    /**
+     * Callbacks dropped since the app started because nothing was subscribed to them.
+     */
+    fun getFilteredCount(): Long = jniGetFilteredCount()
+}
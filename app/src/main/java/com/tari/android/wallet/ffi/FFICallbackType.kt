@@ -0,0 +1,63 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+/**
+ * Wallet callback types as the native callback dispatch knows them, values match the CALLBACK_TYPE_* constants
+ * in callbackDispatcher.cpp.
+ */
+enum class FFICallbackType(val value: Int) {
+    TxReceived(0),
+    TxReplyReceived(1),
+    TxFinalized(2),
+    TxBroadcast(3),
+    TxMined(4),
+    TxMinedUnconfirmed(5),
+    TxFauxConfirmed(6),
+    TxFauxUnconfirmed(7),
+    DirectSendResult(8),
+    TxCancelled(9),
+    TxoValidationComplete(10),
+    ContactsLivenessDataUpdated(11),
+    BalanceUpdated(12),
+    TxValidationComplete(13),
+    ConnectivityStatus(14),
+    WalletScannedHeight(15),
+    BaseNodeStatus(16),
+    RecoveryProgress(17),
+    ConfirmationsChanged(18),
+    BatchSendCompleted(19);
+
+    val mask: Int
+        get() = 1 shl value
+}
@@ -0,0 +1,65 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+import com.tari.android.wallet.model.EmojiId
+
+/**
+ * Native emoji id parser. Unlike going through [FFITariWalletAddress] it does not allocate any native
+ * object, so it is cheap enough to run on every keystroke.
+ *
+ * @author The Tari Development Team
+ */
+object FFIEmojiIdParser {
+
+    private external fun jniValidate(emojiId: String): Int
+    private external fun jniDecode(emojiId: String): ByteArray?
+
+    fun validate(emojiId: EmojiId): Status = Status.fromInt(jniValidate(emojiId))
+
+    /**
+     * @return the address bytes encoded by the emoji id, or null if it contains characters outside the emoji set
+     */
+    fun decode(emojiId: EmojiId): ByteArray? = jniDecode(emojiId)
+
+    enum class Status(val value: Int) {
+        Valid(0),
+        InvalidEmoji(1),
+        InvalidLength(2),
+        InvalidChecksum(3);
+
+        companion object {
+            fun fromInt(value: Int): Status = entries.first { it.value == value }
+        }
+    }
+}
@@ -32,6 +32,8 @@
  */
 package com.tari.android.wallet.ffi
 
+import com.tari.android.wallet.model.EmojiId
+
 /**
  * Wrapper for native private key type.
  *
@@ -43,6 +45,7 @@ class FFIEmojiSet : FFIBase() {
     private external fun jniCreate()
     private external fun jniGetLength(libError: FFIError): Int
     private external fun jniGetAt(index: Int, libError: FFIError): FFIPointer
+    private external fun jniGetAllBytes(offsets: IntArray, libError: FFIError): ByteArray
 
     init {
         jniCreate()
@@ -52,5 +55,14 @@ class FFIEmojiSet : FFIBase() {
 
     fun getAt(index: Int): FFIByteVector = runWithError { FFIByteVector(jniGetAt(index, it)) }
 
+    /**
+     * Reads the whole emoji set with a single native call, in the same order as [getAt].
+     */
+    fun getAll(): List<EmojiId> = runWithError { error ->
+        val offsets = IntArray(jniGetLength(error) + 1)
+        val bytes = jniGetAllBytes(offsets, error)
+        (0 until offsets.size - 1).map { String(bytes, offsets[it], offsets[it + 1] - offsets[it], Charsets.UTF_8) }
+    }
+
     override fun destroy() = jniDestroy()
 }
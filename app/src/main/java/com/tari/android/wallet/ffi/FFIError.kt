@@ -32,9 +32,25 @@
  */
 package com.tari.android.wallet.ffi
 
-class FFIError {
-
-    var code: Int = -1
+class FFIError(var code: Int = -1) {
 
     override fun toString(): String = code.toString()
+
+    companion object {
+        /**
+         * Codes of the failures the bindings detect themselves, libwallet's are positive.
+         * Mirrors the NATIVE_ERROR_* codes of jniCommon.cpp.
+         */
+        const val WALLET_ALREADY_RUNNING = -1000
+        const val THREAD_NOT_ATTACHED = -1001
+        const val CHECK_FAILED = -1002
+
+        /**
+         * Error code of the last native call made with an FFIError on the current thread.
+         */
+        fun lastCode(): Int = jniGetLastCode()
+
+        @JvmStatic
+        private external fun jniGetLastCode(): Int
+    }
 }
\ No newline at end of file
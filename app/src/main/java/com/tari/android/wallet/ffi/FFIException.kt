@@ -39,16 +39,30 @@ import com.tari.android.wallet.model.WalletError
  */
 fun throwIf(error: FFIError) {
     if (error.code != WalletError.NoError.code) {
-        throw FFIException(error)
+        // the error object is reused by runWithError, so the exception gets its own copy
+        throw FFIException(FFIError(error.code))
     }
 }
 
+/**
+ * Error objects are reused per thread, native code only writes into them when a call fails.
+ * It's a stack since calls can be nested, e.g. when a result is wrapped inside another runWithError.
+ */
+@PublishedApi
+internal val reusableErrors: ThreadLocal<ArrayDeque<FFIError>> = ThreadLocal.withInitial { ArrayDeque() }
+
 @Throws(FFIException::class)
-fun <T> runWithError(action: (error: FFIError) -> T): T {
-    val error = FFIError()
-    val result = action(error)
-    throwIf(error)
-    return result
+inline fun <T> runWithError(action: (error: FFIError) -> T): T {
+    val errors = reusableErrors.get()!!
+    val error = errors.removeLastOrNull() ?: FFIError()
+    error.code = WalletError.NoError.code
+    try {
+        val result = action(error)
+        throwIf(error)
+        return result
+    } finally {
+        errors.addLast(error)
+    }
 }
 
 class FFIException(val error: FFIError? = null, override val message: String? = "Error code: $error") : RuntimeException() {
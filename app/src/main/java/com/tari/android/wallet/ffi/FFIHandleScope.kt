@@ -0,0 +1,111 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+/**
+ * Native handle scopes. The native objects created through JNI on a thread while a scope is open on it are destroyed
+ * together when the scope closes, instead of one by one by the finalizers of their wrappers:
+ *
+ * ```
+ * FFIHandleScope.use {
+ *     val txs = wallet.getCompletedTxs()
+ *     (0 until txs.getLength()).map { txs.getAt(it).getId() }
+ * }
+ * ```
+ *
+ * The wrappers created in the scope are nulled when it closes, don't let them escape it unless passed to [keep].
+ * Scopes nest and are closed innermost first on the thread that opened them.
+ *
+ * The per type counters of [getTypeStats] count every native object handed to Java, in a scope or not.
+ *
+ * @author The Tari Development Team
+ */
+object FFIHandleScope {
+
+    private external fun jniOpen(): Long
+    private external fun jniClose(scope: Long): LongArray?
+    private external fun jniKeep(pointer: FFIPointer): Boolean
+    private external fun jniGetTypeNames(): Array<String>
+    private external fun jniGetTypeStatsValues(): LongArray
+
+    private class Scope(val id: Long) {
+        val wrappers = mutableListOf<FFIBase>()
+    }
+
+    private val openScopes = ThreadLocal.withInitial { ArrayDeque<Scope>() }
+
+    /**
+     * Runs the block in a new scope, closed when the block returns or throws.
+     */
+    fun <T> use(block: () -> T): T {
+        val scope = Scope(jniOpen())
+        openScopes.get().addLast(scope)
+        try {
+            return block()
+        } finally {
+            close(scope)
+        }
+    }
+
+    /**
+     * Takes the wrapper out of its scope, it's destroyed by [FFIBase.destroy] or its finalizer again.
+     *
+     * @return false if the wrapper isn't in a scope
+     */
+    fun keep(wrapper: FFIBase): Boolean {
+        openScopes.get().forEach { it.wrappers.remove(wrapper) }
+        return wrapper.pointer != nullptr && jniKeep(wrapper.pointer)
+    }
+
+    fun getTypeStats(): List<FFIHandleStats> {
+        val names = jniGetTypeNames()
+        val values = jniGetTypeStatsValues()
+        return names.mapIndexed { index, name -> FFIHandleStats.fromValues(name, values, index) }
+    }
+
+    internal fun onWrapperCreated(wrapper: FFIBase) {
+        openScopes.get().lastOrNull()?.wrappers?.add(wrapper)
+    }
+
+    private fun close(scope: Scope) {
+        openScopes.get().removeLast()
+        val released = jniClose(scope.id) ?: error("Scope ${scope.id} isn't the innermost open scope of the thread")
+        if (released.isEmpty()) return
+        val releasedPointers = released.toHashSet()
+        scope.wrappers.forEach {
+            if (it.pointer in releasedPointers) {
+                it.onReleasedByScope()
+            }
+        }
+    }
+}
@@ -0,0 +1,94 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+import com.tari.android.wallet.model.WalletError
+import kotlinx.coroutines.CompletableDeferred
+import kotlinx.coroutines.ExperimentalCoroutinesApi
+
+/**
+ * Completions of the wallet operations that run on the native worker pool. A job can complete before its id is
+ * awaited, so whichever side comes first creates the deferred.
+ */
+object FFIJobs {
+
+    // a completion and the cancellation of its await race, both sides take the lock to agree on who gets the result
+    private val lock = Any()
+
+    private val jobs = HashMap<Long, CompletableDeferred<Long>>()
+
+    // jobs whose awaiting coroutine was cancelled, their completions are dropped after releasing the result
+    private val abandonedJobs = HashMap<Long, (Long) -> Unit>()
+
+    /**
+     * @param releaseResult frees the result of a job that completes after the await was cancelled, for the
+     * operations whose result is a native pointer
+     * @return the job result: a pointer, a tx id or 1 for true, depending on the operation
+     * @throws FFIException with the libwallet error code if the job failed
+     */
+    @OptIn(ExperimentalCoroutinesApi::class)
+    suspend fun await(jobId: Long, releaseResult: (Long) -> Unit = {}): Long {
+        val job = synchronized(lock) { deferredFor(jobId) }
+        var delivered = false
+        try {
+            return job.await().also { delivered = true }
+        } finally {
+            synchronized(lock) {
+                jobs.remove(jobId)
+                when {
+                    delivered -> Unit
+                    !job.isCompleted -> abandonedJobs[jobId] = releaseResult
+                    // completed while the cancelled await was resuming
+                    !job.isCancelled -> releaseResult(job.getCompleted())
+                }
+            }
+        }
+    }
+
+    fun onCompleted(jobId: Long, result: Long, errorCode: Int) {
+        val job = synchronized(lock) {
+            abandonedJobs.remove(jobId)?.let { releaseResult ->
+                if (errorCode == WalletError.NoError.code) releaseResult(result)
+                return
+            }
+            deferredFor(jobId)
+        }
+        if (errorCode == WalletError.NoError.code) {
+            job.complete(result)
+        } else {
+            job.completeExceptionally(FFIException(FFIError(errorCode)))
+        }
+    }
+
+    private fun deferredFor(jobId: Long): CompletableDeferred<Long> = jobs.getOrPut(jobId) { CompletableDeferred() }
+}
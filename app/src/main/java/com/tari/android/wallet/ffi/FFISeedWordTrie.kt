@@ -0,0 +1,61 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+/**
+ * Native prefix trie over the mnemonic word list of a language. The trie is built on first use and kept for the process lifetime.
+ *
+ * @author The Tari Development Team
+ */
+object FFISeedWordTrie {
+
+    private const val DEFAULT_LIMIT = 2048
+
+    private external fun jniContains(language: String, word: String, libError: FFIError): Boolean
+    private external fun jniComplete(language: String, prefix: String, limit: Int, libError: FFIError): Array<String>
+    private external fun jniSuggest(language: String, word: String, maxDistance: Int, limit: Int, libError: FFIError): Array<String>
+
+    fun contains(language: FFISeedWords.Language, word: String): Boolean = runWithError { jniContains(language.name, word, it) }
+
+    /**
+     * @return words starting with the prefix, in alphabetical order
+     */
+    fun complete(language: FFISeedWords.Language, prefix: String, limit: Int = DEFAULT_LIMIT): List<String> =
+        runWithError { jniComplete(language.name, prefix, limit, it).toList() }
+
+    /**
+     * @return words within [maxDistance] edits (insertions, deletions, substitutions) of the word, closest first
+     */
+    fun suggest(language: FFISeedWords.Language, word: String, maxDistance: Int = 1, limit: Int = DEFAULT_LIMIT): List<String> =
+        runWithError { jniSuggest(language.name, word, maxDistance, limit, it).toList() }
+}
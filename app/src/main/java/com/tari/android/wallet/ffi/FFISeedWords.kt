@@ -45,6 +45,8 @@ class FFISeedWords() : FFIBase() {
     private external fun jniCreate()
     private external fun jniFromBase58(cypher: String, passphrase: String, libError: FFIError)
     private external fun jniPushWord(word: String, libError: FFIError): Int
+    private external fun jniPushWords(words: Array<String>, libError: FFIError): Int
+    private external fun jniGetAll(libError: FFIError): Array<String>
     private external fun jniGetLength(libError: FFIError): Int
     private external fun jniGetAt(index: Int, libError: FFIError): String
     private external fun jniDestroy()
@@ -70,6 +72,18 @@ class FFISeedWords() : FFIBase() {
 
     fun pushWord(word: String): SeedWordsWordPushResult = runWithError { SeedWordsWordPushResult.fromInt(jniPushWord(word, it)) }
 
+    /**
+     * Pushes the words in a single native call. Stops at the first word that doesn't result in [SeedWordsWordPushResult.SuccessfulPush]
+     * and returns that result, so the outcome is the same as calling [pushWord] for each word until it fails or completes.
+     */
+    fun pushWords(words: List<String>): SeedWordsWordPushResult =
+        runWithError { SeedWordsWordPushResult.fromInt(jniPushWords(words.toTypedArray(), it)) }
+
+    /**
+     * Reads all the words with a single native call.
+     */
+    fun getAll(): List<String> = runWithError { jniGetAll(it).toList() }
+
     override fun destroy() = jniDestroy()
 
     companion object {
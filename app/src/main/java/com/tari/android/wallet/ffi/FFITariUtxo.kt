@@ -1,8 +1,20 @@
 package com.tari.android.wallet.ffi
 
-class FFITariUtxo(pointer: FFIPointer) : FFIBase() {
+class FFITariUtxo() : FFIBase() {
 
+    private var commitmentBytes: ByteArray? = null
+
+    /**
+     * Lower case hex, same as libwallet. UTXOs read from binary columns are only encoded when this is first read.
+     */
     var commitment: String = ""
+        get() {
+            commitmentBytes?.let {
+                field = FFIHex.encode(it, lowercase = true)
+                commitmentBytes = null
+            }
+            return field
+        }
     var value: Long = -1
     var minedHeight: Long = -1
     var minedTimestamp: Long = -1
@@ -11,10 +23,19 @@ class FFITariUtxo(pointer: FFIPointer) : FFIBase() {
 
     private external fun jniLoadData()
 
-    init {
+    constructor(pointer: FFIPointer) : this() {
         this.pointer = pointer
         jniLoadData()
     }
 
+    constructor(commitmentBytes: ByteArray, value: Long, minedHeight: Long, minedTimestamp: Long, lockHeight: Long, status: Byte) : this() {
+        this.commitmentBytes = commitmentBytes
+        this.value = value
+        this.minedHeight = minedHeight
+        this.minedTimestamp = minedTimestamp
+        this.lockHeight = lockHeight
+        this.status = status
+    }
+
     override fun destroy() = Unit
-}
\ No newline at end of file
+}
@@ -10,11 +10,25 @@ class FFITariVector(pointer: FFIPointer) : FFIBase() {
 
     private external fun jniLoadData()
     private external fun jniGetItemAt(index: Int): FFIPointer
+    private external fun jniGetUtxoColumns(
+        values: LongArray,
+        minedHeights: LongArray,
+        minedTimestamps: LongArray,
+        lockHeights: LongArray,
+        statuses: ByteArray,
+        commitmentOffsets: IntArray,
+    ): ByteArray?
 
     init {
         this.pointer = pointer
         jniLoadData()
         val vectorTag = TariVectorTag.entries.firstOrNull { it.value == tag }
+        if (vectorTag != TariVectorTag.Utxo || !loadUtxoColumns()) {
+            loadItems(vectorTag)
+        }
+    }
+
+    private fun loadItems(vectorTag: TariVectorTag?) {
         for (i in 0 until len) {
             val newItemPointer = jniGetItemAt(i.toInt())
             when (vectorTag) {
@@ -25,6 +39,35 @@ class FFITariVector(pointer: FFIPointer) : FFIBase() {
         }
     }
 
+    /**
+     * Reads all UTXOs with a single native call instead of one call per item.
+     *
+     * @return false if the commitments couldn't be read as binary, the items have to be loaded one by one then
+     */
+    private fun loadUtxoColumns(): Boolean {
+        val size = len.toInt()
+        val values = LongArray(size)
+        val minedHeights = LongArray(size)
+        val minedTimestamps = LongArray(size)
+        val lockHeights = LongArray(size)
+        val statuses = ByteArray(size)
+        val commitmentOffsets = IntArray(size + 1)
+        val commitments = jniGetUtxoColumns(values, minedHeights, minedTimestamps, lockHeights, statuses, commitmentOffsets) ?: return false
+        for (i in 0 until size) {
+            itemsList.add(
+                FFITariUtxo(
+                    commitmentBytes = commitments.copyOfRange(commitmentOffsets[i], commitmentOffsets[i + 1]),
+                    value = values[i],
+                    minedHeight = minedHeights[i],
+                    minedTimestamp = minedTimestamps[i],
+                    lockHeight = lockHeights[i],
+                    status = statuses[i],
+                )
+            )
+        }
+        return true
+    }
+
     override fun destroy() = Unit
 
     enum class TariVectorTag(val value: Int) {
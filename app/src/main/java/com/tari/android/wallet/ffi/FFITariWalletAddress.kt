@@ -53,6 +53,7 @@ class FFITariWalletAddress() : FFIBase() {
     private external fun jniGetViewKey(libError: FFIError): FFIPointer
     private external fun jniGetSpendKey(libError: FFIError): FFIPointer
     private external fun jniGetChecksum(libError: FFIError): Int
+    private external fun jniLoadMetadata(metadata: Metadata, libError: FFIError)
 
     constructor(pointer: FFIPointer) : this() {
         if (pointer.isNull()) error("Pointer must not be null")
@@ -85,7 +86,21 @@ class FFITariWalletAddress() : FFIBase() {
 
     fun getChecksum(): Int = runWithError { jniGetChecksum(it) }
 
+    /**
+     * Loads network, features, checksum, emoji id and bytes in a single call.
+     * Addresses returned by transactions and contacts are interned natively, so this is served from the pool.
+     */
+    fun getMetadata(): Metadata = runWithError { error -> Metadata().also { jniLoadMetadata(it, error) } }
+
     override fun toString(): String = getEmojiId()
 
     override fun destroy() = jniDestroy()
+
+    class Metadata {
+        var network: Int = -1
+        var features: Int = -1
+        var checksum: Int = -1
+        var emojiId: EmojiId = ""
+        var bytes: ByteArray = ByteArray(0)
+    }
 }
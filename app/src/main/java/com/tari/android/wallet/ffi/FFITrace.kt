@@ -0,0 +1,65 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+/**
+ * Native trace event recorder. Spans are recorded around every JNI entry point, every wallet callback and the
+ * phases of wallet creation. Recording costs next to nothing while disabled.
+ *
+ * The output of [writeJson] is Chrome trace event JSON and opens in Perfetto (ui.perfetto.dev) or chrome://tracing.
+ *
+ * @author The Tari Development Team
+ */
+object FFITrace {
+
+    private external fun jniSetEnabled(enabled: Boolean)
+    private external fun jniIsEnabled(): Boolean
+    private external fun jniClear()
+    private external fun jniWriteJson(path: String): Boolean
+
+    fun setEnabled(enabled: Boolean) = jniSetEnabled(enabled)
+
+    fun isEnabled(): Boolean = jniIsEnabled()
+
+    /**
+     * Drops all recorded events.
+     */
+    fun clear() = jniClear()
+
+    /**
+     * Writes the recorded events of all threads to the file. Each thread keeps its most recent events only.
+     *
+     * @return false if the file couldn't be written
+     */
+    fun writeJson(path: String): Boolean = jniWriteJson(path)
+}
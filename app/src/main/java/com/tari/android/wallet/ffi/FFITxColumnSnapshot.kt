@@ -0,0 +1,134 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+/**
+ * The completed txs of the wallet as native columns sorted by timestamp, taken by [FFIWallet.getTxColumnSnapshot].
+ * The aggregations of the analytics and statement screens run over it natively, each in one pass over the txs of its
+ * time range, and come back as primitive arrays.
+ *
+ * Timestamps are in seconds like those of the txs. Ranges are [from, to), time series split them into buckets of
+ * bucketSize seconds starting at from, the last one cut short by to.
+ *
+ * @author The Tari Development Team
+ */
+class FFITxColumnSnapshot() : FFIBase() {
+
+    private external fun jniGetSize(): Int
+    private external fun jniGetCounterpartyCount(): Int
+    private external fun jniGetCounterparty(index: Int): ByteArray?
+    private external fun jniGetVolumes(
+        from: Long,
+        to: Long,
+        bucketSize: Long,
+        sent: LongArray,
+        received: LongArray,
+        fees: LongArray,
+        counts: IntArray,
+        libError: FFIError,
+    ): Int
+
+    private external fun jniGetRunningBalances(from: Long, to: Long, bucketSize: Long, balances: LongArray, libError: FFIError): Int
+    private external fun jniGetCounterpartyTotals(
+        from: Long,
+        to: Long,
+        sent: LongArray,
+        received: LongArray,
+        fees: LongArray,
+        counts: IntArray,
+        libError: FFIError,
+    ): Int
+
+    private external fun jniDestroy()
+
+    constructor(pointer: FFIPointer) : this() {
+        if (pointer.isNull()) error("Pointer must not be null")
+        this.pointer = pointer
+    }
+
+    fun getSize(): Int = jniGetSize()
+
+    fun getCounterpartyCount(): Int = jniGetCounterpartyCount()
+
+    /**
+     * @return the address bytes of a counterparty, in the order of [getCounterpartyTotals]
+     */
+    fun getCounterparty(index: Int): ByteArray = jniGetCounterparty(index) ?: throw IndexOutOfBoundsException("Counterparty $index")
+
+    /**
+     * Sent and received volume, fees and tx count of every bucket.
+     */
+    fun getVolumes(from: Long, to: Long, bucketSize: Long): FFITxTotals {
+        val totals = FFITxTotals(bucketCount(from, to, bucketSize))
+        runWithError { jniGetVolumes(from, to, bucketSize, totals.sent, totals.received, totals.fees, totals.counts, it) }
+        return totals
+    }
+
+    /**
+     * The balance the completed txs add up to at the end of every bucket, the txs before the range included.
+     */
+    fun getRunningBalances(from: Long, to: Long, bucketSize: Long): LongArray {
+        val balances = LongArray(bucketCount(from, to, bucketSize))
+        runWithError { jniGetRunningBalances(from, to, bucketSize, balances, it) }
+        return balances
+    }
+
+    /**
+     * Sent and received volume, fees and tx count per counterparty over the range, indexed like [getCounterparty].
+     */
+    fun getCounterpartyTotals(from: Long, to: Long): FFITxTotals {
+        val totals = FFITxTotals(getCounterpartyCount())
+        runWithError { jniGetCounterpartyTotals(from, to, totals.sent, totals.received, totals.fees, totals.counts, it) }
+        return totals
+    }
+
+    override fun destroy() = jniDestroy()
+
+    companion object {
+        // an invalid range gets no arrays, the native side reports it
+        fun bucketCount(from: Long, to: Long, bucketSize: Long): Int =
+            if (bucketSize <= 0 || to <= from) 0 else ((to - from - 1) / bucketSize + 1).coerceAtMost(Int.MAX_VALUE.toLong()).toInt()
+    }
+}
+
+/**
+ * Totals of a time bucket or a counterparty, amounts in MicroTari. Fees are those of the sent txs.
+ */
+class FFITxTotals(size: Int) {
+    val sent = LongArray(size)
+    val received = LongArray(size)
+    val fees = LongArray(size)
+    val counts = IntArray(size)
+
+    val size: Int get() = counts.size
+}
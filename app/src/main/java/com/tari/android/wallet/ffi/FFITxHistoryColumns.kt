@@ -0,0 +1,66 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+import com.tari.android.wallet.model.TxId
+
+/**
+ * The columns of the txs a [FFITxHistoryIndex.queryColumns] matched, in the order of the query.
+ *
+ * @author The Tari Development Team
+ */
+class FFITxHistoryColumns(
+    val count: Int,
+    val ids: LongArray,
+    val amounts: LongArray,
+    val fees: LongArray,
+    val timestamps: LongArray,
+    val statuses: IntArray,
+    private val flags: ByteArray,
+) {
+
+    // tx ids are u64, the column carries their bits
+    fun txId(index: Int): TxId = ids[index].toULong().toString().toBigInteger()
+
+    fun status(index: Int): FFITxStatus = FFITxStatus.map(statuses[index])
+
+    fun kind(index: Int): FFITxHistoryQuery.Kind = FFITxHistoryQuery.Kind.entries[flags[index].toInt() and KIND_MASK]
+
+    fun isOutbound(index: Int): Boolean = (flags[index].toInt() and FLAG_OUTBOUND) != 0
+
+    companion object {
+        // must match TX_HISTORY_FLAG_OUTBOUND of txHistoryIndex.cpp
+        private const val FLAG_OUTBOUND = 0x10
+        private const val KIND_MASK = 0x0F
+    }
+}
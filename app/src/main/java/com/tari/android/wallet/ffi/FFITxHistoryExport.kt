@@ -0,0 +1,63 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+/**
+ * Options of [FFIWallet.exportTxHistory], which streams the whole tx history natively to a file descriptor: the
+ * completed, pending inbound, pending outbound and cancelled txs in that order, one row or object per tx.
+ *
+ * CSV has a header row with the field names, JSON is one array of objects with the same fields, tx ids as strings and
+ * timestamps in ISO 8601 UTC. Addresses are base58, payment references hex. The wallet's own address of a pending tx
+ * is left empty, libwallet only has the counterparty of those.
+ *
+ * @author The Tari Development Team
+ */
+object FFITxHistoryExport {
+
+    // must match the TX_EXPORT_FORMAT_* constants of txHistoryExporter.cpp
+    enum class Format { CSV, JSON }
+
+    /**
+     * Called on the exporting thread every few hundred txs and once each list is written. [exported] counts the txs
+     * of [kind] written so far out of [total]. Throwing stops the export.
+     */
+    fun interface Listener {
+        fun onProgress(kind: FFITxHistoryQuery.Kind, exported: Int, total: Int)
+    }
+
+    // the native side calls onProgress(III)V, the kinds are in the order of the TX_HISTORY_KIND_* constants
+    internal class NativeListener(private val listener: Listener) {
+        @Suppress("unused")
+        fun onProgress(kind: Int, exported: Int, total: Int) = listener.onProgress(FFITxHistoryQuery.Kind.entries[kind], exported, total)
+    }
+}
@@ -0,0 +1,118 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+import com.tari.android.wallet.model.TxId
+
+/**
+ * Native query cache of the tx history: a SQLite database next to the wallet datastore with a row per completed,
+ * cancelled and pending tx, indexed on timestamp, status, amount and counterparty, and searchable by payment id and
+ * contact alias. The tx callbacks keep it in sync once it's open, [FFIWallet.syncTxHistoryIndex] rebuilds it from the
+ * wallet. Queries return only the ids or columns of the matching txs.
+ *
+ * @author The Tari Development Team
+ */
+object FFITxHistoryIndex {
+
+    private const val DEFAULT_LIMIT = 256
+
+    private external fun jniOpen(datastorePath: String): Boolean
+    private external fun jniClose()
+    private external fun jniClear(): Boolean
+    private external fun jniSetAliases(addresses: Array<ByteArray>, aliases: Array<String>, libError: FFIError): Boolean
+    private external fun jniQueryIds(filter: LongArray, counterparty: ByteArray?, text: String?, ids: LongArray, libError: FFIError): Int
+    private external fun jniQueryColumns(
+        filter: LongArray,
+        counterparty: ByteArray?,
+        text: String?,
+        ids: LongArray,
+        amounts: LongArray,
+        fees: LongArray,
+        timestamps: LongArray,
+        statuses: IntArray,
+        flags: ByteArray,
+        libError: FFIError,
+    ): Int
+
+    private external fun jniCount(filter: LongArray, counterparty: ByteArray?, text: String?, libError: FFIError): Long
+
+    /**
+     * Opens or creates the index next to the datastore, a database of an older schema is emptied for a rebuild.
+     */
+    fun open(datastorePath: String): Boolean = jniOpen(datastorePath)
+
+    fun close() = jniClose()
+
+    /**
+     * Drops every tx and alias, e.g. when the wallet is removed.
+     */
+    fun clear(): Boolean = jniClear()
+
+    /**
+     * Replaces the contact aliases the search text matches, given as address bytes and alias.
+     */
+    fun setAliases(aliases: List<Pair<ByteArray, String>>): Boolean = runWithError { error ->
+        jniSetAliases(aliases.map { it.first }.toTypedArray(), aliases.map { it.second }.toTypedArray(), error)
+    }
+
+    /**
+     * @return the ids of the matching txs, at most [FFITxHistoryQuery.limit] or [DEFAULT_LIMIT] of them
+     */
+    fun queryIds(query: FFITxHistoryQuery): List<TxId> {
+        val ids = LongArray(query.limit ?: DEFAULT_LIMIT)
+        val count = runWithError { jniQueryIds(query.toFilter(), query.counterparty, query.text, ids, it) }
+        return (0 until count.coerceAtLeast(0)).map { ids[it].toULong().toString().toBigInteger() }
+    }
+
+    /**
+     * @return the columns of the matching txs, at most [FFITxHistoryQuery.limit] or [DEFAULT_LIMIT] of them
+     */
+    fun queryColumns(query: FFITxHistoryQuery): FFITxHistoryColumns {
+        val capacity = query.limit ?: DEFAULT_LIMIT
+        val ids = LongArray(capacity)
+        val amounts = LongArray(capacity)
+        val fees = LongArray(capacity)
+        val timestamps = LongArray(capacity)
+        val statuses = IntArray(capacity)
+        val flags = ByteArray(capacity)
+        val count = runWithError {
+            jniQueryColumns(query.toFilter(), query.counterparty, query.text, ids, amounts, fees, timestamps, statuses, flags, it)
+        }
+        return FFITxHistoryColumns(count.coerceAtLeast(0), ids, amounts, fees, timestamps, statuses, flags)
+    }
+
+    /**
+     * @return the number of txs the query matches regardless of its limit and offset, -1 if the index isn't open
+     */
+    fun count(query: FFITxHistoryQuery): Long = runWithError { jniCount(query.toFilter(), query.counterparty, query.text, it) }
+}
@@ -0,0 +1,85 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+/**
+ * Filter, search text and order of a [FFITxHistoryIndex] query. Empty sets and null bounds match every tx, amounts are
+ * in µT and timestamps in seconds like libwallet's.
+ *
+ * @param counterparty address bytes of the other side of the txs, see [FFITariWalletAddress.getByteVector]
+ * @param text words matched as prefixes against the payment id and the contact alias of the txs
+ * @param toTimestamp exclusive
+ *
+ * @author The Tari Development Team
+ */
+data class FFITxHistoryQuery(
+    val kinds: Set<Kind> = emptySet(),
+    val statuses: Set<FFITxStatus> = emptySet(),
+    val direction: Direction = Direction.ANY,
+    val minAmount: Long? = null,
+    val maxAmount: Long? = null,
+    val fromTimestamp: Long? = null,
+    val toTimestamp: Long? = null,
+    val counterparty: ByteArray? = null,
+    val text: String? = null,
+    val order: Order = Order.NEWEST_FIRST,
+    val limit: Int? = null,
+    val offset: Int = 0,
+) {
+
+    /**
+     * The wallet list a tx is in.
+     */
+    enum class Kind { COMPLETED, CANCELLED, PENDING_INBOUND, PENDING_OUTBOUND }
+
+    enum class Direction { ANY, INBOUND, OUTBOUND }
+
+    enum class Order { NEWEST_FIRST, OLDEST_FIRST, LARGEST_FIRST, SMALLEST_FIRST }
+
+    // must match the TX_HISTORY_FILTER_* layout of txHistoryIndex.cpp, the enums are in the order of its constants
+    internal fun toFilter(): LongArray = longArrayOf(
+        kinds.fold(0L) { mask, kind -> mask or (1L shl kind.ordinal) },
+        statuses.fold(0L) { mask, status -> status.code().let { if (it >= 0) mask or (1L shl it) else mask } },
+        direction.ordinal.toLong(),
+        minAmount ?: -1L,
+        maxAmount ?: -1L,
+        fromTimestamp ?: -1L,
+        toTimestamp ?: -1L,
+        order.ordinal.toLong(),
+        limit?.toLong() ?: -1L,
+        offset.toLong(),
+    )
+
+    // FFITxStatus is declared in the order of the libwallet codes, starting with TX_NULL_ERROR at -1
+    private fun FFITxStatus.code(): Int = ordinal - 1
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+import com.tari.android.wallet.model.TxId
+
+/**
+ * Native latency tracker of sent txs. Every stage a sent tx passes is timestamped as its callback comes in,
+ * the durations between stages are kept for the last 256 txs. Txs expire 6 hours after they were sent.
+ *
+ * @author The Tari Development Team
+ */
+object FFITxLifecycle {
+
+    enum class Stage(val value: Int) {
+        Sent(0),
+        DirectSendResult(1),
+        ReplyReceived(2),
+        Finalized(3),
+        Broadcast(4),
+        MinedUnconfirmed(5),
+        Mined(6),
+    }
+
+    /**
+     * @param stageNanos nanos from sending to each reached stage
+     */
+    data class Timeline(
+        val txId: TxId,
+        val sentAtMillis: Long,
+        val stageNanos: Map<Stage, Long>,
+    )
+
+    /**
+     * @param transitions durations of reaching each stage from the stage before it, over the recent txs
+     */
+    data class Snapshot(
+        val timelines: List<Timeline>,
+        val transitions: Map<Stage, FFICallStats>,
+    )
+
+    private external fun jniGetSnapshot(): LongArray
+    private external fun jniClear()
+
+    fun getSnapshot(): Snapshot {
+        val values = jniGetSnapshot()
+        val stageCount = values[0].toInt()
+        val txCount = values[1].toInt()
+        var offset = 2
+        val timelines = List(txCount) {
+            val txId = values[offset].toULong().toString().toBigInteger()
+            val sentAtMillis = values[offset + 1]
+            val stageNanos = Stage.entries
+                .filter { stage -> values[offset + 2 + stage.value] >= 0 }
+                .associateWith { stage -> values[offset + 2 + stage.value] }
+            offset += 2 + stageCount
+            Timeline(txId, sentAtMillis, stageNanos)
+        }
+        val transitionValues = values.copyOfRange(offset, values.size)
+        val transitions = Stage.entries.drop(1).withIndex().associate { (index, stage) ->
+            stage to FFICallStats.fromValues(stage.name, transitionValues, index)
+        }
+        return Snapshot(timelines, transitions)
+    }
+
+    fun clear() = jniClear()
+}
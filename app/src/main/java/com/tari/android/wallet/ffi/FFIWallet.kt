@@ -55,6 +55,8 @@ import com.tari.android.wallet.model.tx.Tx
 import com.tari.android.wallet.util.Constants
 import com.tari.android.wallet.util.DebugConfig
 import com.tari.android.wallet.util.extension.toMicroTari
+import kotlinx.coroutines.NonCancellable
+import kotlinx.coroutines.withContext
 import java.math.BigInteger
 
 /**
@@ -69,12 +71,21 @@ class FFIWallet(
     private val logger
         get() = Logger.t(FFIWallet::class.simpleName)
 
+    /**
+     * Id of the native async creation, 0 when the wallet was created synchronously.
+     * The pointer is set from the worker thread before the WalletCreated stage is reported.
+     */
+    private var creationId: Long = 0
+
     companion object {
         // values for the wallet initialization
         private val LOG_VERBOSITY: Int = if (DebugConfig.isDebug()) 11 else 4
         private const val IS_DNS_SECURE_ON = false
         private val MAX_NUMBER_OF_ROLLING_LOG_FILES = if (DebugConfig.isDebug()) 10 else 2
         private val ROLLING_LOG_FILE_MAX_SIZE_BYTES = (if (DebugConfig.isDebug()) 4 else 10) * 1024 * 1024
+
+        // the calling thread and 3 pool workers
+        const val BATCH_SEND_DEFAULT_CONCURRENCY = 4
     }
 
     private external fun jniCreate(
@@ -126,8 +137,24 @@ class FFIWallet(
         callbackWalletScannedHeightSig: String,
         callbackBaseNodeStatusStatus: String,
         callbackBaseNodeStatusSig: String,
+        callbackWalletCreateProgress: String,
+        callbackWalletCreateProgressSig: String,
+        callbackJobCompleted: String,
+        callbackJobCompletedSig: String,
+        callbackConfirmationsChanged: String,
+        callbackConfirmationsChangedSig: String,
+        callbackBatchSendCompleted: String,
+        callbackBatchSendCompletedSig: String,
+        createAsync: Boolean,
         libError: FFIError
-    )
+    ): Long
+
+    private external fun jniCancelCreate(creationId: Long): Boolean
+
+    private external fun jniWriteWarmStartSnapshot(datastorePath: String, maxTxCount: Int, scannedHeight: Long, libError: FFIError): Boolean
+    private external fun jniSyncTxHistoryIndex(libError: FFIError): Int
+    private external fun jniGetTxColumnSnapshot(libError: FFIError): FFIPointer
+    private external fun jniExportTxHistory(fd: Int, format: Int, listener: FFITxHistoryExport.NativeListener?, libError: FFIError): Long
 
     private external fun jniGetBalance(libError: FFIError): FFIPointer
     private external fun jniLogMessage(message: String, libError: FFIError)
@@ -152,6 +179,17 @@ class FFIWallet(
         libError: FFIError
     ): ByteArray
 
+    private external fun jniSendTxBatch(
+        destinations: Array<FFITariWalletAddress>,
+        amounts: LongArray,
+        feePerGram: Long,
+        paymentIds: Array<String>,
+        maxConcurrency: Int,
+        txIds: LongArray,
+        errorCodes: IntArray,
+        libError: FFIError
+    ): Long
+
     private external fun jniSignMessage(message: String, libError: FFIError): String
     private external fun jniVerifyMessageSignature(publicKeyPtr: FFIPublicKey, message: String, signature: String, libError: FFIError): Boolean
     private external fun jniGetBaseNodePeers(libError: FFIError): FFIPointer
@@ -190,8 +228,26 @@ class FFIWallet(
         libError: FFIError
     ): ByteArray
 
+    // the async variants return the id of the job on the native worker pool, or 0 if the pool is full
+    private external fun jniSendTxAsync(publicKeyPtr: FFITariWalletAddress, amount: String, feePerGram: String, message: String): Long
+    private external fun jniStartRecoveryAsync(walletCallbacks: WalletCallbacks, callback: String, callbackSig: String): Long
+    private external fun jniGetAllUtxosAsync(): Long
+    private external fun jniDestroyUtxos(pointer: FFIPointer)
+    private external fun jniJoinUtxosAsync(commitments: Array<String>, feePerGram: String): Long
+    private external fun jniSplitUtxosAsync(commitments: Array<String>, splitCount: String, feePerGram: String): Long
+    private external fun jniImportExternalUtxoAsNonRewindableAsync(
+        output: FFITariUnblindedOutput,
+        sourceAddress: FFITariWalletAddress,
+        message: String,
+    ): Long
+
     private external fun jniGetTxPayRefs(txId: String, libError: FFIError): FFIPointer
 
+    private external fun jniGetCallStatsNames(): Array<String>
+    private external fun jniGetCallStatsValues(count: Int): LongArray
+    private external fun jniResetCallStats()
+    private external fun jniGetDroppedCallbackCount(): Long
+
     private external fun jniDestroy()
 
     constructor(
@@ -203,6 +259,7 @@ class FFIWallet(
         seedWords: FFISeedWords?,
         walletCallbacks: WalletCallbacks,
         createWallet: Boolean,
+        createAsync: Boolean = false,
     ) : this(walletCallbacks) {
         val error = FFIError()
         logger.i("Pre jniCreate")
@@ -212,7 +269,7 @@ class FFIWallet(
         val walletBirthdayOffset = if (createWallet) 0 else 2
 
         try {
-            jniCreate(
+            creationId = jniCreate(
                 walletContextId = walletContextId,
                 commsConfig = commsConfig,
                 logPath = logPath,
@@ -244,6 +301,11 @@ class FFIWallet(
                 WalletCallbacks::onConnectivityStatus.name, "([B[B)V",
                 WalletCallbacks::onWalletScannedHeight.name, "([B[B)V",
                 WalletCallbacks::onBaseNodeStatus.name, "([BJ)V",
+                WalletCallbacks::onWalletCreateProgress.name, "([BII)V",
+                WalletCallbacks::onJobCompleted.name, "([BJJI)V",
+                WalletCallbacks::onConfirmationsChanged.name, "([B[J[J)V",
+                WalletCallbacks::onBatchSendCompleted.name, "([BJ[J[I)V",
+                createAsync = createAsync,
                 libError = error,
             )
         } catch (e: Throwable) {
@@ -255,6 +317,44 @@ class FFIWallet(
         throwIf(error)
     }
 
+    /**
+     * Cancels an async creation. The wallet can't be used afterwards and its callbacks stop right away, so the
+     * cancellation isn't reported through the progress callback. The next wallet can be created straight after, its
+     * creation waits for the cancelled one to leave the datastore.
+     * @return false if the creation has already finished, destroy the wallet instead
+     */
+    fun cancelCreation(): Boolean = creationId != 0L && jniCancelCreate(creationId)
+
+    /**
+     * Persists the balance, the latest completed txs and the scanned height next to the datastore, see [FFIWarmStartSnapshot].
+     */
+    fun writeWarmStartSnapshot(datastorePath: String, maxTxCount: Int, scannedHeight: Long): Boolean =
+        runWithError { jniWriteWarmStartSnapshot(datastorePath, maxTxCount, scannedHeight, it) }
+
+    /**
+     * Rebuilds the open [FFITxHistoryIndex] from the tx lists of the wallet.
+     *
+     * @return the number of txs indexed, -1 if the index isn't open or couldn't be written
+     */
+    fun syncTxHistoryIndex(): Int = runWithError { jniSyncTxHistoryIndex(it) }
+
+    /**
+     * Reads the completed txs into a [FFITxColumnSnapshot] for the history aggregations, destroy it once done.
+     */
+    fun getTxColumnSnapshot(): FFITxColumnSnapshot = FFITxColumnSnapshot(runWithError { jniGetTxColumnSnapshot(it) })
+
+    /**
+     * Writes the tx history to [fd] as [format], see [FFITxHistoryExport]. Blocks until done, the caller keeps owning
+     * the descriptor and closes it.
+     *
+     * libwallet hands out each tx list whole, so the export takes O(largest list) native memory: one list is held at a
+     * time and released before the next is taken.
+     *
+     * @return the number of txs written, -1 if writing to the descriptor failed
+     */
+    fun exportTxHistory(fd: Int, format: FFITxHistoryExport.Format, listener: FFITxHistoryExport.Listener? = null): Long =
+        runWithError { jniExportTxHistory(fd, format.ordinal, listener?.let { FFITxHistoryExport.NativeListener(it) }, it) }
+
     fun getBalance(): BalanceInfo = FFIBalance(runWithError { jniGetBalance(it) }).runWithDestroy {
         BalanceInfo(it.getAvailable(), it.getIncoming(), it.getOutgoing(), it.getTimeLocked())
     }
@@ -265,6 +365,9 @@ class FFIWallet(
 
     fun getAllUtxos(): TariVector = runWithError { TariVector(FFITariVector(jniGetAllUtxos(it))) }
 
+    suspend fun getAllUtxosAwait(): TariVector =
+        awaitJob(jniGetAllUtxosAsync(), ::getAllUtxos, releaseResult = ::jniDestroyUtxos) { TariVector(FFITariVector(it)) }
+
     fun getWalletAddress(): FFITariWalletAddress = runWithError { FFITariWalletAddress(jniGetWalletAddress(it)) }
 
     fun getContacts(): FFIContacts = runWithError { FFIContacts(jniGetContacts(it)) }
@@ -350,6 +453,70 @@ class FFIWallet(
         return BigInteger(1, txIdBytes)
     }
 
+    /**
+     * Sends a tx to every destination, up to [maxConcurrency] at a time on the calling thread and the native worker
+     * pool, and returns once all of them were sent. The items are independent, a failed one doesn't stop the others.
+     * The direct send results of the batch come back in one [WalletCallbacks.onBatchSendCompleted].
+     */
+    fun sendTxBatch(
+        destinations: List<FFITariWalletAddress>,
+        amounts: List<BigInteger>,
+        feePerGram: BigInteger,
+        paymentIds: List<String>,
+        maxConcurrency: Int = BATCH_SEND_DEFAULT_CONCURRENCY,
+    ): FFIBatchSendResult {
+        if (amounts.size != destinations.size || paymentIds.size != destinations.size) {
+            throw FFIException(message = "Destinations, amounts and payment ids don't have the same size.")
+        }
+        if (amounts.any { it < BigInteger.ZERO || it.bitLength() > Long.SIZE_BITS }) {
+            throw FFIException(message = "Amount is less than 0 or too large.")
+        }
+        val walletAddress = getWalletAddress()
+        if (destinations.any { it == walletAddress }) {
+            throw FFIException(message = "Tx source and destination are the same.")
+        }
+        val txIds = LongArray(destinations.size)
+        val errorCodes = IntArray(destinations.size)
+        val batchId = runWithError { error ->
+            jniSendTxBatch(
+                destinations = destinations.toTypedArray(),
+                amounts = LongArray(amounts.size) { amounts[it].toLong() },
+                feePerGram = feePerGram.toLong(),
+                paymentIds = paymentIds.toTypedArray(),
+                maxConcurrency = maxConcurrency,
+                txIds = txIds,
+                errorCodes = errorCodes,
+                libError = error,
+            )
+        }
+        return FFIBatchSendResult(
+            batchId = batchId,
+            txIds = txIds.indices.map { if (errorCodes[it] == 0) txIds[it].toTxId() else null },
+            errorCodes = errorCodes.toList(),
+        )
+    }
+
+    /**
+     * Sends the tx on the native worker pool. The destination is used by the job, so the wait can't be cancelled.
+     */
+    suspend fun sendTxAwait(
+        destination: FFITariWalletAddress,
+        amount: BigInteger,
+        feePerGram: BigInteger,
+        message: String,
+    ): TxId = withContext(NonCancellable) {
+        if (amount < BigInteger.valueOf(0L)) {
+            throw FFIException(message = "Amount is less than 0.")
+        }
+        if (destination == getWalletAddress()) {
+            throw FFIException(message = "Tx source and destination are the same.")
+        }
+        awaitJob(
+            jobId = jniSendTxAsync(destination, amount.toString(), feePerGram.toString(), message),
+            fallback = { sendTx(destination, amount, feePerGram, message) },
+        ) { it.toTxId() }
+    }
+
     fun joinUtxos(utxos: List<TariUtxo>) = runWithError { error ->
         jniJoinUtxos(
             commitments = utxos.map { it.commitment }.toTypedArray(),
@@ -367,6 +534,25 @@ class FFIWallet(
         )
     }
 
+    suspend fun joinUtxosAwait(utxos: List<TariUtxo>): Long =
+        awaitJob(
+            jobId = jniJoinUtxosAsync(
+                commitments = utxos.map { it.commitment }.toTypedArray(),
+                feePerGram = Constants.Wallet.DEFAULT_FEE_PER_GRAM.value.toString(),
+            ),
+            fallback = { joinUtxos(utxos) },
+        ) { it }
+
+    suspend fun splitUtxosAwait(utxos: List<TariUtxo>, splitCount: Int): Long =
+        awaitJob(
+            jobId = jniSplitUtxosAsync(
+                commitments = utxos.map { it.commitment }.toTypedArray(),
+                splitCount = splitCount.toString(),
+                feePerGram = Constants.Wallet.DEFAULT_FEE_PER_GRAM.value.toString(),
+            ),
+            fallback = { splitUtxos(utxos, splitCount) },
+        ) { it }
+
     fun joinPreviewUtxos(utxos: List<TariUtxo>): TariCoinPreview = runWithError { error ->
         FFITariCoinPreview(
             jniPreviewJoinUtxos(
@@ -437,6 +623,15 @@ class FFIWallet(
             )
         }
 
+    suspend fun startRecoveryAwait(): Boolean = awaitJob(
+        jobId = jniStartRecoveryAsync(
+            walletCallbacks = walletCallbacks,
+            callback = walletCallbacks::onWalletRecovery.name,
+            callbackSig = "([BI[B[B)V",
+        ),
+        fallback = ::startRecovery,
+    ) { it != 0L }
+
     fun getLowestFeePerGram(): MicroTari = runWithError { error ->
         FFIFeePerGramStat(jniWalletGetFeePerGramStats(3, error)).runWithDestroy { stats ->
             stats.getMin().toMicroTari().takeIf { it > 0.toMicroTari() }
@@ -458,6 +653,35 @@ class FFIWallet(
         }
     }
 
+    /**
+     * Imports the outputs one at a time on the native worker pool, the native objects are kept alive until each job completes.
+     */
+    suspend fun restoreWithUnbindedOutputsAwait(jsons: List<String>, address: TariWalletAddress, message: String) = withContext(NonCancellable) {
+        for (json in jsons) {
+            val output = FFITariUnblindedOutput(json)
+            val sourceAddress = FFITariWalletAddress(emojiId = address.fullEmojiId)
+            try {
+                awaitJob(
+                    jobId = jniImportExternalUtxoAsNonRewindableAsync(output, sourceAddress, message),
+                    fallback = { BigInteger(1, runWithError { error -> jniImportExternalUtxoAsNonRewindable(output, sourceAddress, message, error) }) },
+                ) { it.toTxId() }
+            } finally {
+                sourceAddress.destroy()
+                output.destroy()
+            }
+        }
+    }
+
+    private suspend inline fun <T> awaitJob(
+        jobId: Long,
+        fallback: () -> T,
+        noinline releaseResult: (Long) -> Unit = {},
+        mapResult: (Long) -> T,
+    ): T = if (jobId == 0L) fallback() else mapResult(FFIJobs.await(jobId, releaseResult))
+
+    // tx ids are u64, the job result carries their bits
+    private fun Long.toTxId(): TxId = toULong().toString().toBigInteger()
+
     fun getTxPaymentReference(tx: Tx): TariPaymentRecord? = runWithError { error ->
         FFITariPaymentRecords(jniGetTxPayRefs(tx.id.toString(), error))
             .iterateWithDestroy { TariPaymentRecord(it) }
@@ -468,6 +692,24 @@ class FFIWallet(
             }
     }
 
+    /**
+     * Latency stats of every native entry point called since start or the last [resetCallStats], slowest total first.
+     * The stats are process wide and include calls made through other FFI wrappers.
+     */
+    fun getCallStats(): List<FFICallStats> {
+        val names = jniGetCallStatsNames()
+        val values = jniGetCallStatsValues(names.size)
+        return names.indices.map { FFICallStats.fromValues(names[it], values, it) }.sortedByDescending { it.totalNanos }
+    }
+
+    fun resetCallStats() = jniResetCallStats()
+
+    /**
+     * Callbacks libwallet fired after the wallet started to be destroyed, or queued before a destroy and delivered after it,
+     * they're dropped without reaching Kotlin.
+     */
+    fun getDroppedCallbackCount(): Long = jniGetDroppedCallbackCount()
+
     override fun destroy() {
         jniDestroy()
     }
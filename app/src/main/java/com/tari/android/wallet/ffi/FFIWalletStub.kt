@@ -0,0 +1,113 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+/**
+ * Controls of the simulated libwallet, for instrumented tests built with -PwalletStub. The stand-in fills every new
+ * wallet with a dataset of the given size and fires the wallet callbacks from native threads, so the callback path
+ * can be loaded without a network. The native functions don't exist in regular builds.
+ *
+ * @author The Tari Development Team
+ */
+object FFIWalletStub {
+
+    enum class EventPattern(val value: Int) {
+        // txs through their lifecycle, then balance and base node status updates
+        SteadyTrickle(0),
+        // mined, faux confirmed and cancelled callbacks for the dataset in bursts, each ending with the validation results
+        ValidationBurst(1),
+        // recovery progress, scanned height and imported txs, meant to run without a rate limit
+        RecoveryStorm(2),
+        // every callback in turn, keyed by its sequence number for the host's CallbackStorm benchmarks,
+        // the values it reports (statuses, heights, balances) mean nothing to the app
+        CallbackStorm(3),
+    }
+
+    private external fun jniSetDataset(
+        completedTxCount: Int,
+        cancelledTxCount: Int,
+        pendingInboundTxCount: Int,
+        pendingOutboundTxCount: Int,
+        utxoCount: Int,
+        contactCount: Int,
+    )
+
+    private external fun jniResetDataset()
+    private external fun jniStartEvents(
+        wallet: FFIWallet,
+        pattern: Int,
+        threadCount: Int,
+        eventsPerSecond: Int,
+        burstSize: Int,
+        eventCount: Long,
+        libError: FFIError,
+    ): Boolean
+
+    private external fun jniStopEvents(wallet: FFIWallet, wait: Boolean)
+    private external fun jniGetFiredEventCount(wallet: FFIWallet): Long
+
+    /**
+     * Size of the wallets created from now on.
+     */
+    fun setDataset(
+        completedTxCount: Int,
+        cancelledTxCount: Int,
+        pendingInboundTxCount: Int,
+        pendingOutboundTxCount: Int,
+        utxoCount: Int,
+        contactCount: Int,
+    ) = jniSetDataset(completedTxCount, cancelledTxCount, pendingInboundTxCount, pendingOutboundTxCount, utxoCount, contactCount)
+
+    fun resetDataset() = jniResetDataset()
+
+    /**
+     * @param eventsPerSecond over all the threads, 0 fires as fast as the callbacks return
+     * @param burstSize events fired back to back before the rate applies, [EventPattern.ValidationBurst] only, 0 is 64
+     * @param eventCount over all the threads, 0 fires until [stopEvents]
+     */
+    fun startEvents(
+        wallet: FFIWallet,
+        pattern: EventPattern,
+        threadCount: Int = 1,
+        eventsPerSecond: Int = 0,
+        burstSize: Int = 0,
+        eventCount: Long = 0,
+    ): Boolean = runWithError { jniStartEvents(wallet, pattern.value, threadCount, eventsPerSecond, burstSize, eventCount, it) }
+
+    /**
+     * @param wait let the threads fire the whole event count first
+     */
+    fun stopEvents(wallet: FFIWallet, wait: Boolean = false) = jniStopEvents(wallet, wait)
+
+    fun getFiredEventCount(wallet: FFIWallet): Long = jniGetFiredEventCount(wallet)
+}
@@ -0,0 +1,144 @@
+/**
+ * Copyright 2020 The Tari Project
+ *
+ * Redistribution and use in source and binary forms, with or
+ * without modification, are permitted provided that the
+ * following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above
+ * copyright notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of
+ * its contributors may be used to endorse or promote products
+ * derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+ * CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ * INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+ * OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+ * NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+ * OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+package com.tari.android.wallet.ffi
+
+import com.tari.android.wallet.model.BalanceInfo
+import com.tari.android.wallet.model.MicroTari
+import com.tari.android.wallet.model.TariContact
+import com.tari.android.wallet.model.TariWalletAddress
+import com.tari.android.wallet.model.TxStatus
+import com.tari.android.wallet.model.tx.CompletedTx
+import com.tari.android.wallet.model.tx.Tx
+import java.math.BigInteger
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
+
+/**
+ * Reader of the warm-start snapshot written by [FFIWallet.writeWarmStartSnapshot]: the last balance, the latest
+ * completed txs and the scanned height, available before the wallet is created.
+ *
+ * The file is mapped natively and read here at fixed offsets, which mirror the structs in warmStartSnapshot.cpp.
+ * The native side only hands out the buffer if the version and the checksum match.
+ *
+ * @author The Tari Development Team
+ */
+object FFIWarmStartSnapshot {
+
+    // WarmStartSnapshotHeader
+    private const val HEADER_SIZE = 72
+    private const val HEADER_SAVED_AT = 16
+    private const val HEADER_SCANNED_HEIGHT = 24
+    private const val HEADER_AVAILABLE = 32
+    private const val HEADER_PENDING_INCOMING = 40
+    private const val HEADER_PENDING_OUTGOING = 48
+    private const val HEADER_TIME_LOCKED = 56
+    private const val HEADER_TX_COUNT = 64
+
+    // WarmStartSnapshotTx
+    private const val TX_SIZE = 440
+    private const val TX_ID = 0
+    private const val TX_AMOUNT = 8
+    private const val TX_FEE = 16
+    private const val TX_TIMESTAMP = 24
+    private const val TX_MINED_TIMESTAMP = 32
+    private const val TX_MINED_HEIGHT = 40
+    private const val TX_STATUS = 48
+    private const val TX_IS_OUTBOUND = 52
+    private const val TX_ADDRESS_LENGTH = 53
+    private const val TX_PAYMENT_ID_LENGTH = 54
+    private const val TX_ADDRESS = 56
+    private const val TX_PAYMENT_ID = 184
+
+    private external fun jniMap(datastorePath: String): ByteBuffer?
+    private external fun jniUnmap()
+
+    /**
+     * @return null if there's no snapshot next to the datastore or it doesn't match the current layout
+     */
+    @Synchronized
+    fun read(datastorePath: String): WarmStartSnapshot? {
+        val buffer = jniMap(datastorePath)?.order(ByteOrder.nativeOrder()) ?: return null
+        try {
+            val txCount = buffer.getInt(HEADER_TX_COUNT)
+            return WarmStartSnapshot(
+                savedAtMillis = buffer.getLong(HEADER_SAVED_AT),
+                scannedHeight = buffer.getLong(HEADER_SCANNED_HEIGHT),
+                balance = BalanceInfo(
+                    availableBalance = MicroTari(buffer.getUnsignedLong(HEADER_AVAILABLE)),
+                    pendingIncomingBalance = MicroTari(buffer.getUnsignedLong(HEADER_PENDING_INCOMING)),
+                    pendingOutgoingBalance = MicroTari(buffer.getUnsignedLong(HEADER_PENDING_OUTGOING)),
+                    timeLockedBalance = MicroTari(buffer.getUnsignedLong(HEADER_TIME_LOCKED)),
+                ),
+                txs = (0 until txCount).mapNotNull { buffer.readTx(HEADER_SIZE + it * TX_SIZE) },
+            )
+        } finally {
+            jniUnmap()
+        }
+    }
+
+    private fun ByteBuffer.readTx(offset: Int): CompletedTx? {
+        val addressBytes = getBytes(offset + TX_ADDRESS, get(offset + TX_ADDRESS_LENGTH).toInt() and 0xFF)
+        val address = runCatching {
+            FFIByteVector(addressBytes).runWithDestroy { byteVector ->
+                FFITariWalletAddress(byteVector).runWithDestroy { TariWalletAddress(it) }
+            }
+        }.getOrNull() ?: return null
+        val paymentIdBytes = getBytes(offset + TX_PAYMENT_ID, getShort(offset + TX_PAYMENT_ID_LENGTH).toInt() and 0xFFFF)
+
+        return CompletedTx(
+            id = getUnsignedLong(offset + TX_ID),
+            direction = if (get(offset + TX_IS_OUTBOUND).toInt() != 0) Tx.Direction.OUTBOUND else Tx.Direction.INBOUND,
+            amount = MicroTari(getUnsignedLong(offset + TX_AMOUNT)),
+            timestamp = getUnsignedLong(offset + TX_TIMESTAMP),
+            paymentId = paymentIdBytes.takeIf { it.isNotEmpty() }?.toString(Charsets.UTF_8),
+            status = TxStatus.map(FFITxStatus.map(getInt(offset + TX_STATUS))),
+            tariContact = TariContact(address),
+            fee = MicroTari(getUnsignedLong(offset + TX_FEE)),
+            txKernel = null,
+            minedTimestamp = getUnsignedLong(offset + TX_MINED_TIMESTAMP),
+            minedHeight = getUnsignedLong(offset + TX_MINED_HEIGHT),
+        )
+    }
+
+    private fun ByteBuffer.getBytes(offset: Int, length: Int): ByteArray =
+        ByteArray(length).also { duplicate().apply { position(offset) }.get(it) }
+
+    private fun ByteBuffer.getUnsignedLong(offset: Int): BigInteger = getLong(offset).toULong().toString().toBigInteger()
+}
+
+data class WarmStartSnapshot(
+    val savedAtMillis: Long,
+    val scannedHeight: Long,
+    val balance: BalanceInfo,
+    val txs: List<CompletedTx>,
+)
@@ -37,17 +37,7 @@ package com.tari.android.wallet.ffi
  */
 data class HexString(val hex: String) {
 
-    constructor(byteVector: FFIByteVector) : this(
-        hex = if (byteVector.getLength() > 0) {
-            val byteArray = ByteArray(byteVector.getLength())
-            for (i in byteArray.indices) {
-                byteArray[i] = byteVector.getAt(i).toByte()
-            }
-            byteArray.joinToString("") { "%02X".format(it) }
-        } else {
-            String()
-        }
-    )
+    constructor(byteVector: FFIByteVector) : this(hex = byteVector.hex())
 }
 
 fun ByteArray.toHex(): String {
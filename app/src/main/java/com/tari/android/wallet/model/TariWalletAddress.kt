@@ -34,6 +34,7 @@ package com.tari.android.wallet.model
 
 import android.os.Parcelable
 import com.tari.android.wallet.ffi.Base58String
+import com.tari.android.wallet.ffi.FFIEmojiIdParser
 import com.tari.android.wallet.ffi.FFIException
 import com.tari.android.wallet.ffi.FFITariWalletAddress
 import com.tari.android.wallet.ffi.runWithDestroy
@@ -59,16 +60,18 @@ data class TariWalletAddress(
     val unknownAddress: Boolean, // true for one-sided payment or phone contact
 ) : Parcelable {
 
-    constructor(ffiWalletAddress: FFITariWalletAddress) : this(
-        network = Network.get(ffiWalletAddress.getNetwork()),
-        features = Feature.get(ffiWalletAddress.getFeatures()),
-        networkEmoji = ffiWalletAddress.getNetwork().tariEmoji(),
-        featuresEmoji = ffiWalletAddress.getFeatures().tariEmoji(),
+    constructor(ffiWalletAddress: FFITariWalletAddress) : this(ffiWalletAddress, ffiWalletAddress.getMetadata())
+
+    private constructor(ffiWalletAddress: FFITariWalletAddress, metadata: FFITariWalletAddress.Metadata) : this(
+        network = Network.get(metadata.network),
+        features = Feature.get(metadata.features),
+        networkEmoji = metadata.network.tariEmoji(),
+        featuresEmoji = metadata.features.tariEmoji(),
         viewKeyEmojis = ffiWalletAddress.getViewKey()?.getEmojiId(),
         spendKeyEmojis = ffiWalletAddress.getSpendKey().getEmojiId(),
-        checksumEmoji = ffiWalletAddress.getChecksum().tariEmoji(),
-        fullBase58 = ffiWalletAddress.fullBase58(),
-        fullEmojiId = ffiWalletAddress.getEmojiId(),
+        checksumEmoji = metadata.checksum.tariEmoji(),
+        fullBase58 = metadata.fullBase58(),
+        fullEmojiId = metadata.emojiId,
         unknownAddress = ffiWalletAddress.getSpendKey().getByteVector().byteArray().all { it == 0.toByte() },
     )
 
@@ -120,8 +123,18 @@ data class TariWalletAddress(
         @Throws(FFIException::class)
         fun fromBase58(base58: Base58) = FFITariWalletAddress(base58 = Base58String(base58)).runWithDestroy { TariWalletAddress(it) }
 
+        /**
+         * Malformed emoji ids are rejected by the native parser before a wallet address object is created.
+         * The checksum is left to libwallet, which reports the actual error code for it.
+         */
         @Throws(FFIException::class)
-        fun fromEmojiId(emojiId: EmojiId) = FFITariWalletAddress(emojiId = emojiId).runWithDestroy { TariWalletAddress(it) }
+        fun fromEmojiId(emojiId: EmojiId): TariWalletAddress {
+            val status = FFIEmojiIdParser.validate(emojiId)
+            if (status == FFIEmojiIdParser.Status.InvalidEmoji || status == FFIEmojiIdParser.Status.InvalidLength) {
+                throw FFIException(message = "Malformed emoji id: $status")
+            }
+            return FFITariWalletAddress(emojiId = emojiId).runWithDestroy { TariWalletAddress(it) }
+        }
 
         fun fromBase58OrNull(base58: Base58): TariWalletAddress? = runCatching { fromBase58(base58) }.getOrNull()
 
@@ -167,6 +180,12 @@ data class TariWalletAddress(
     }
 }
 
+fun FFITariWalletAddress.Metadata.fullBase58(): Base58 = listOf(
+    Base58String(this.network.toByte()).base58,
+    Base58String(this.features.toByte()).base58,
+    Base58String(this.bytes.drop(2)).base58,
+).joinToString(separator = "")
+
 fun FFITariWalletAddress.fullBase58(): Base58 = listOf(
     Base58String(this.getNetwork().toByte()).base58,
     Base58String(this.getFeatures().toByte()).base58,
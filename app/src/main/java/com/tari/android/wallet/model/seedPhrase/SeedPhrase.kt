@@ -23,19 +23,15 @@ class SeedPhrase {
             val ffiSeedWords = FFISeedWords()
 
             try {
-                for (seedWord in words) {
-                    return when (ffiSeedWords.pushWord(seedWord)) {
-                        SeedWordsWordPushResult.InvalidSeedWord -> SeedPhraseCreationResult.InvalidSeedWord
-                        SeedWordsWordPushResult.SuccessfulPush -> continue
-                        SeedWordsWordPushResult.SeedPhraseComplete -> SeedPhraseCreationResult.Success(ffiSeedWords)
-                        SeedWordsWordPushResult.InvalidSeedPhrase -> SeedPhraseCreationResult.InvalidSeedPhrase
-                    }
+                return when (ffiSeedWords.pushWords(words)) {
+                    SeedWordsWordPushResult.InvalidSeedWord -> SeedPhraseCreationResult.InvalidSeedWord
+                    SeedWordsWordPushResult.SuccessfulPush -> SeedPhraseCreationResult.SeedPhraseNotCompleted
+                    SeedWordsWordPushResult.SeedPhraseComplete -> SeedPhraseCreationResult.Success(ffiSeedWords)
+                    SeedWordsWordPushResult.InvalidSeedPhrase -> SeedPhraseCreationResult.InvalidSeedPhrase
                 }
             } catch (e: Throwable) {
                 return SeedPhraseCreationResult.Failed(e)
             }
-
-            return SeedPhraseCreationResult.SeedPhraseNotCompleted
         }
 
         fun createOrNull(words: List<String>?): FFISeedWords? {
@@ -7,7 +7,9 @@ import androidx.lifecycle.map
 import com.tari.android.wallet.R
 import com.tari.android.wallet.application.Navigation
 import com.tari.android.wallet.application.walletManager.doOnWalletRunning
+import com.tari.android.wallet.ffi.FFISeedWordTrie
 import com.tari.android.wallet.ffi.FFISeedWords
+import com.tari.android.wallet.ffi.runWithDestroy
 import com.tari.android.wallet.model.seedPhrase.SeedPhrase
 import com.tari.android.wallet.ui.common.CommonViewModel
 import com.tari.android.wallet.ui.common.SingleLiveEvent
@@ -86,11 +88,9 @@ class InputSeedWordsViewModel : CommonViewModel() {
 
     private fun loadSuggestions() {
         launchOnIo {
-            val mnemonic = FFISeedWords.getMnemonicWordList(FFISeedWords.Language.English)
-            val size = mnemonic.getLength()
-            for (i in 0 until size) {
-                mnemonicList.add(mnemonic.getAt(i))
-            }
+            mnemonicList.addAll(FFISeedWords.getMnemonicWordList(MNEMONIC_LANGUAGE).runWithDestroy { it.getAll() })
+            // builds the native trie off the main thread, suggestions are looked up on every keystroke
+            FFISeedWordTrie.contains(MNEMONIC_LANGUAGE, "")
         }
     }
 
@@ -244,7 +244,9 @@ class InputSeedWordsViewModel : CommonViewModel() {
         val state = if (text.isEmpty()) {
             SuggestionState.NotStarted
         } else {
-            val suggested = mnemonicList.filter { it.startsWith(text) }.toMutableList()
+            val suggested = FFISeedWordTrie.complete(MNEMONIC_LANGUAGE, text)
+                .ifEmpty { FFISeedWordTrie.suggest(MNEMONIC_LANGUAGE, text, maxDistance = 1, limit = MAX_FUZZY_SUGGESTIONS) }
+                .toMutableList()
             if (suggested.isEmpty()) {
                 SuggestionState.Empty
             } else {
@@ -254,6 +256,11 @@ class InputSeedWordsViewModel : CommonViewModel() {
         _suggestions.postValue(state)
     }
 
+    companion object {
+        private val MNEMONIC_LANGUAGE = FFISeedWords.Language.English
+        private const val MAX_FUZZY_SUGGESTIONS = 5
+    }
+
     sealed class RestorationError(title: String, message: String) {
 
         val args = SimpleDialogArgs(title = title, description = message)
@@ -28,6 +28,7 @@ import com.tari.android.wallet.ui.screen.utxos.list.module.UtxoAmountModule
 import com.tari.android.wallet.ui.screen.utxos.list.module.UtxoSplitModule
 import com.tari.android.wallet.util.DebugConfig
 import com.tari.android.wallet.util.MockDataStub
+import com.tari.android.wallet.util.extension.launchOnMain
 import javax.inject.Inject
 
 class UtxosListViewModel : CommonViewModel() {
@@ -143,9 +144,9 @@ class UtxosListViewModel : CommonViewModel() {
         )
     }
 
-    private fun joinUtxos(selectedUtxos: List<TariUtxo>) {
+    private fun joinUtxos(selectedUtxos: List<TariUtxo>) = launchOnMain {
         try {
-            walletManager.requireWalletInstance.joinUtxos(selectedUtxos)
+            walletManager.requireWalletInstance.joinUtxosAwait(selectedUtxos)
             hideDialog()
             loadUtxosFromFFI()
             walletManager.sendWalletEvent(WalletManager.WalletEvent.UtxosSplit)
@@ -160,9 +161,9 @@ class UtxosListViewModel : CommonViewModel() {
     private fun previewSplitUtxos(count: Int, items: List<TariUtxo>): TariCoinPreview =
         walletManager.requireWalletInstance.splitPreviewUtxos(items, count)
 
-    private fun splitUtxos(selectedUtxos: List<TariUtxo>, count: Int) {
+    private fun splitUtxos(selectedUtxos: List<TariUtxo>, count: Int) = launchOnMain {
         try {
-            walletManager.requireWalletInstance.splitUtxos(selectedUtxos, count)
+            walletManager.requireWalletInstance.splitUtxosAwait(selectedUtxos, count)
             hideDialog()
             loadUtxosFromFFI()
             walletManager.sendWalletEvent(WalletManager.WalletEvent.UtxosSplit)
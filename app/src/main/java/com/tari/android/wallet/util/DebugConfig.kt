@@ -81,6 +81,16 @@ object DebugConfig {
 
     const val showTtlStoreMenu = false
 
+    /**
+     * Records native trace events from app start, write them out with FFITrace.writeJson().
+     */
+    val nativeTraceEnabled = valueIfDebug(false)
+
+    /**
+     * Delivers repeated tx callbacks too instead of suppressing them natively.
+     */
+    val bypassCallbackDedup = valueIfDebug(false)
+
     fun isDebug() = BuildConfig.BUILD_TYPE == "debug"
 
     private fun valueIfDebug(value: Boolean) = isDebug() && value
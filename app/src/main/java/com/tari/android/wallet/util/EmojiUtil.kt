@@ -35,6 +35,7 @@ package com.tari.android.wallet.util
 import android.icu.text.BreakIterator
 import android.text.SpannableString
 import com.tari.android.wallet.ffi.FFIEmojiSet
+import com.tari.android.wallet.ffi.runWithDestroy
 import com.tari.android.wallet.model.EmojiId
 import com.tari.android.wallet.model.TariWalletAddress
 import com.tari.android.wallet.util.extension.applyColorStyle
@@ -98,17 +99,7 @@ class EmojiUtil {
         const val SMALL_EMOJI_ID_SIZE = 6
 
         val FFI_EMOJI_SET: Set<EmojiId> by lazy {
-            val emojis = mutableSetOf<EmojiId>()
-            val emojiSetFFI = FFIEmojiSet()
-            for (i in 0 until emojiSetFFI.getLength()) {
-                val emojiFFI = emojiSetFFI.getAt(i)
-                val emojiBytes = emojiFFI.byteArray()
-                val emoji = String(emojiBytes)
-                emojis.add(emoji)
-                emojiFFI.destroy()
-            }
-            emojiSetFFI.destroy()
-            emojis
+            FFIEmojiSet().runWithDestroy { it.getAll() }.toCollection(LinkedHashSet())
         }
 
         /**